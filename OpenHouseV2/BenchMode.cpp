@@ -0,0 +1,448 @@
+#include "BenchMode.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+#include "GLStats.h"
+#include "GraphicsEngine.h"
+#include "OffscreenContext.h"
+#include "Profiler.h"
+#include "ShaderCache.h"
+#include "ShadowMaps.h"
+
+/**
+\file BenchMode.cpp
+\brief Offscreen benchmark of the whole game, for machines with no display.
+
+Makes an OpenGL context with no window, plays a scripted match in each arena for a
+fixed number of frames and writes the frame times, OpenGL call counts and memory use
+to a JSON file.  The game logic ticks once a frame instead of on its own thread, so
+every run draws the same frames.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Results of one arena.
+
+*/
+
+struct BenchArenaResult
+{
+    int arena;                      ///< Arena number.
+    std::vector<double> frameMs;    ///< Wall time of each timed frame, finished on the GPU.
+    std::vector<double> gpuMs;      ///< GPU time of the frames the timestamps came back for.
+    std::vector<double> overdraw;   ///< Shaded samples per sample of the frames the counts came back for.
+    GLCallCounts calls;             ///< OpenGL calls of all the timed frames.
+    long long drawn;                ///< Models drawn over all the timed frames.
+    long long culled;               ///< Models culled over all the timed frames.
+};
+
+/**
+\brief Scripted players, both walk in and throw random attacks, as in bench_fight.
+
+*/
+
+struct BenchPlayers
+{
+    unsigned int seed;   ///< State of the random sequence.
+
+    /**
+    \brief Returns the next pseudo random number, 0 to 65535.
+    */
+    unsigned int next()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 16;
+    }
+
+    /**
+    \brief Sends this frame's input for both players, or slides the menu.
+
+    \param ge --- Engine to send the input to.
+    \param frame --- Frame number in the arena.
+    */
+    void play(GraphicsEngine& ge, int frame)
+    {
+        if (ge.getArenaNum() == 3)
+        {
+            if (frame % 120 == 60)
+                ge.sendInput(next() % 2 ? SIM_MENU_RIGHT : SIM_MENU_LEFT);
+            return;
+        }
+
+        for (int p = 0; p < 2; p++)
+        {
+            ge.sendInput(SIM_MOVE, p, 1, 0);
+
+            unsigned int r = next() % 100;
+            if (r < 3)
+                ge.sendInput(SIM_PUNCH, p);
+            else if (r < 5)
+                ge.sendInput(SIM_KICK, p);
+            else if (r < 6)
+                ge.sendInput(SIM_TORNADO, p);
+            else if (r < 7)
+                ge.sendInput(SIM_JUMP, p);
+        }
+
+        // A knock out restarts the match so the whole run is fighting.
+        if (ge.getGameOver())
+            ge.sendInput(SIM_RESTART);
+    }
+};
+
+/**
+\brief Returns a percentile of a list of times, nearest rank.
+
+\param times --- Times, in any order.
+\param p --- Percentile, 0 to 100.
+
+*/
+
+static double percentile(std::vector<double> times, double p)
+{
+    if (times.empty())
+        return 0;
+
+    std::sort(times.begin(), times.end());
+    size_t k = (size_t)(p / 100 * (times.size() - 1) + 0.5);
+    return times[k];
+}
+
+/**
+\brief Returns the mean of a list of times.
+
+\param times --- Times.
+
+*/
+
+static double mean(const std::vector<double>& times)
+{
+    if (times.empty())
+        return 0;
+
+    double sum = 0;
+    for (size_t i = 0; i < times.size(); i++)
+        sum += times[i];
+    return sum / times.size();
+}
+
+/**
+\brief Reads a memory figure of this process in kilobytes, from /proc/self/status.
+
+\param field --- Field name, VmRSS for the resident size or VmHWM for its peak.
+
+\return Kilobytes, or -1 where there is no /proc.
+
+*/
+
+static long memoryKB(const char* field)
+{
+    FILE* f = fopen("/proc/self/status", "r");
+    if (!f)
+        return -1;
+
+    char line[256];
+    long kb = -1;
+    size_t n = strlen(field);
+    while (fgets(line, sizeof(line), f))
+        if (strncmp(line, field, n) == 0 && line[n] == ':')
+        {
+            kb = atol(line + n + 1);
+            break;
+        }
+
+    fclose(f);
+    return kb;
+}
+
+/**
+\brief Returns the name of an arena for the results.
+
+\param arena --- Arena number.
+
+*/
+
+static const char* arenaName(int arena)
+{
+    switch (arena)
+    {
+        case 0:
+            return "bath house";
+        case 1:
+            return "alley way";
+        case 3:
+            return "menu";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+\brief Draws one frame and adds its times and counts to the results.
+
+\param ge --- Engine to draw.
+\param players --- Scripted players.
+\param frame --- Frame number in the arena.
+\param result --- Results of the arena, NULL during the warm up.
+
+*/
+
+static void benchFrame(GraphicsEngine& ge, BenchPlayers& players, int frame, BenchArenaResult* result)
+{
+    Profiler& profiler = Profiler::get();
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    GLStats::reset();
+    profiler.beginFrame();
+
+    players.play(ge, frame);
+    ge.benchTick();
+    ge.display();
+    glFinish();
+
+    profiler.endFrame();
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    if (!result)
+        return;
+
+    result->frameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    if (profiler.getFrameCount() > PROFILER_GPU_FRAMES && profiler.getFrame(PROFILER_GPU_FRAMES).gpuMs >= 0)
+        result->gpuMs.push_back(profiler.getFrame(PROFILER_GPU_FRAMES).gpuMs);
+    if (ge.getOverdraw() >= 0)
+        result->overdraw.push_back(ge.getOverdraw());
+
+    const GLCallCounts& c = GLStats::get();
+    result->calls.drawCalls += c.drawCalls;
+    result->calls.stateChanges += c.stateChanges;
+    result->calls.uniformCalls += c.uniformCalls;
+    result->calls.uniformLookups += c.uniformLookups;
+    result->calls.uploadBytes += c.uploadBytes;
+    result->drawn += ge.getDrawnCount();
+    result->culled += ge.getCulledCount();
+}
+
+/**
+\brief Writes the results as JSON.
+
+\param opt --- Settings of the run.
+\param renderer --- OpenGL renderer string.
+\param setupMs --- Time to make the engine, loading every model and texture.
+\param setupUpload --- Bytes given to the GPU while making the engine.
+\param shaders --- Where the engine's shader programs came from and the time they took.
+\param results --- Results of each arena.
+
+\return True if the file was written.
+
+*/
+
+static bool writeResults(const BenchOptions& opt, const std::string& renderer, double setupMs, long long setupUpload,
+                         const ShaderCacheStats& shaders, const std::vector<BenchArenaResult>& results)
+{
+    FILE* f = fopen(opt.outFile.c_str(), "w");
+    if (!f)
+    {
+        std::cerr << "Could not open " << opt.outFile << " for writing." << std::endl;
+        return false;
+    }
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"renderer\": \"%s\",\n", renderer.c_str());
+    fprintf(f, "  \"width\": %d,\n  \"height\": %d,\n", opt.width, opt.height);
+    fprintf(f, "  \"fighters\": [%d, %d],\n  \"seed\": %u,\n", opt.fighters[0], opt.fighters[1], opt.seed);
+    fprintf(f, "  \"lights\": %d,\n", opt.lights);
+    fprintf(f, "  \"shadowSize\": %d,\n", ShadowMaps::isEnabled() ? ShadowMaps::getDefaultSize() : 0);
+    fprintf(f, "  \"depthPrepass\": %s,\n  \"frontToBack\": %s,\n",
+            DrawOrder::isDepthPrepass() ? "true" : "false", DrawOrder::isSorted() ? "true" : "false");
+    fprintf(f, "  \"setupMs\": %.3f,\n", setupMs);
+    fprintf(f, "  \"shaders\": {\"ms\": %.3f, \"programs\": %d, \"memoryHits\": %d, \"diskHits\": %d, \"compiled\": %d},\n",
+            shaders.ms, shaders.programs, shaders.memoryHits, shaders.diskHits, shaders.compiled);
+    fprintf(f, "  \"memory\": {\"rssKB\": %ld, \"peakRssKB\": %ld, \"setupUploadBytes\": %lld},\n",
+            memoryKB("VmRSS"), memoryKB("VmHWM"), setupUpload);
+    fprintf(f, "  \"arenas\": [\n");
+
+    for (size_t i = 0; i < results.size(); i++)
+    {
+        const BenchArenaResult& r = results[i];
+        double n = r.frameMs.empty() ? 1 : r.frameMs.size();
+
+        fprintf(f, "    {\n");
+        fprintf(f, "      \"arena\": %d,\n      \"name\": \"%s\",\n      \"frames\": %d,\n",
+                r.arena, arenaName(r.arena), (int)r.frameMs.size());
+        fprintf(f, "      \"frameMs\": {\"p50\": %.3f, \"p95\": %.3f, \"p99\": %.3f, \"max\": %.3f, \"mean\": %.3f},\n",
+                percentile(r.frameMs, 50), percentile(r.frameMs, 95), percentile(r.frameMs, 99),
+                percentile(r.frameMs, 100), mean(r.frameMs));
+        fprintf(f, "      \"gpuMs\": {\"frames\": %d, \"p50\": %.3f, \"p95\": %.3f, \"mean\": %.3f},\n",
+                (int)r.gpuMs.size(), percentile(r.gpuMs, 50), percentile(r.gpuMs, 95), mean(r.gpuMs));
+        fprintf(f, "      \"overdraw\": {\"frames\": %d, \"mean\": %.3f, \"max\": %.3f},\n",
+                (int)r.overdraw.size(), mean(r.overdraw), percentile(r.overdraw, 100));
+        fprintf(f, "      \"perFrame\": {\"drawCalls\": %.1f, \"stateChanges\": %.1f, \"uniformCalls\": %.1f, "
+                   "\"uniformLookups\": %.1f, \"uploadBytes\": %.1f, \"drawn\": %.1f, \"culled\": %.1f}\n",
+                r.calls.drawCalls / n, r.calls.stateChanges / n, r.calls.uniformCalls / n,
+                r.calls.uniformLookups / n, r.calls.uploadBytes / n, r.drawn / n, r.culled / n);
+        fprintf(f, "    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
+
+/**
+\brief Sets the default benchmark settings, 600 frames in each arena at 1280x720.
+
+\param opt --- Settings to fill.
+
+*/
+
+void defaultBenchOptions(BenchOptions& opt)
+{
+    opt.frames = 600;
+    opt.warmup = 30;
+    opt.width = 1280;
+    opt.height = 720;
+    opt.fighters[0] = 3;
+    opt.fighters[1] = 1;
+    opt.seed = 1;
+    opt.arenas.clear();
+    opt.arenas.push_back(0);
+    opt.arenas.push_back(1);
+    opt.arenas.push_back(3);
+    opt.lights = 0;
+    opt.outFile = "bench.json";
+}
+
+/**
+\brief Reads a benchmark setting from the command line.
+
+\param opt --- Settings to change.
+\param argc --- Number of command line arguments.
+\param argv --- Command line arguments.
+\param i --- Index of the option, moved past its value.
+
+\return True if the option was a benchmark setting.
+
+*/
+
+bool parseBenchOption(BenchOptions& opt, int argc, char** argv, int& i)
+{
+    if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        opt.frames = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--warmup") == 0 && i + 1 < argc)
+        opt.warmup = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--out") == 0 && i + 1 < argc)
+        opt.outFile = argv[++i];
+    else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+    {
+        if (sscanf(argv[++i], "%dx%d", &opt.width, &opt.height) != 2)
+            std::cerr << "Size " << argv[i] << " not WIDTHxHEIGHT, ignored." << std::endl;
+    }
+    else if (strcmp(argv[i], "--fighters") == 0 && i + 2 < argc)
+    {
+        opt.fighters[0] = atoi(argv[++i]);
+        opt.fighters[1] = atoi(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        opt.seed = (unsigned int)atoi(argv[++i]);
+    else if (strcmp(argv[i], "--lights") == 0 && i + 1 < argc)
+        opt.lights = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--arenas") == 0 && i + 1 < argc)
+    {
+        opt.arenas.clear();
+        for (const char* c = argv[++i]; *c; c++)
+            if (*c >= '0' && *c <= '9')
+                opt.arenas.push_back(*c - '0');
+    }
+    else
+        return false;
+
+    return true;
+}
+
+/**
+\brief Runs the benchmark.
+
+\param opt --- Settings of the run.
+
+\return EXIT_SUCCESS, or EXIT_FAILURE if there is no context or the results could not
+be written.
+
+*/
+
+int runBench(const BenchOptions& opt)
+{
+    OffscreenContext context;
+    if (!context.create(opt.width, opt.height, 3, 3))
+        return EXIT_FAILURE;
+
+#ifndef __APPLE__
+    glewExperimental = true;
+    GLenum glewErr = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW built for GLX finds no X display under EGL but still loads the core functions.
+    if (glewErr == GLEW_ERROR_NO_GLX_DISPLAY)
+        glewErr = GLEW_OK;
+#endif // GLEW_ERROR_NO_GLX_DISPLAY
+    if (glewErr != GLEW_OK)
+    {
+        std::cerr << "\nUnable to initialize GLEW ... exiting. \n";
+        return EXIT_FAILURE;
+    }
+#endif // __APPLE__
+
+    GLStats::install();
+    GLStats::reset();
+
+    std::string renderer = (const char*)glGetString(GL_RENDERER);
+    std::cout << "Benchmarking on " << renderer << ", " << opt.width << "x" << opt.height << std::endl;
+
+    std::chrono::steady_clock::time_point setupStart = std::chrono::steady_clock::now();
+    GraphicsEngine ge("OpenHouse bench", 3, 3, opt.width, opt.height, NULL, true);
+    double setupMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - setupStart).count();
+    long long setupUpload = GLStats::get().uploadBytes;
+    ge.setBenchLights(opt.lights, opt.seed);
+
+    std::vector<BenchArenaResult> results;
+    for (size_t a = 0; a < opt.arenas.size(); a++)
+    {
+        BenchArenaResult r;
+        r.arena = opt.arenas[a];
+        r.calls.drawCalls = r.calls.stateChanges = r.calls.uniformCalls = r.calls.uniformLookups = r.calls.uploadBytes = 0;
+        r.drawn = r.culled = 0;
+
+        BenchPlayers players = {opt.seed};
+        ge.startBenchMatch(r.arena, opt.fighters[0], opt.fighters[1]);
+
+        for (int i = 0; i < opt.warmup; i++)
+            benchFrame(ge, players, i, NULL);
+        for (int i = 0; i < opt.frames; i++)
+            benchFrame(ge, players, opt.warmup + i, &r);
+
+        printf("%-10s  frame p50 %7.2f  p95 %7.2f  p99 %7.2f ms   gpu %7.2f ms   draws %7.1f   state %7.1f\n",
+               arenaName(r.arena), percentile(r.frameMs, 50), percentile(r.frameMs, 95), percentile(r.frameMs, 99),
+               mean(r.gpuMs), r.calls.drawCalls / (double)std::max(opt.frames, 1),
+               r.calls.stateChanges / (double)std::max(opt.frames, 1));
+        results.push_back(r);
+    }
+
+    const ShaderCacheStats& shaders = ShaderCache::getStats();
+    printf("Setup %.0f ms, %lld bytes uploaded, peak resident %ld KB\n", setupMs, setupUpload, memoryKB("VmHWM"));
+    printf("Shaders %.0f ms, %d programs, %d from memory, %d from disk, %d compiled\n",
+           shaders.ms, shaders.programs, shaders.memoryHits, shaders.diskHits, shaders.compiled);
+
+    if (!writeResults(opt, renderer, setupMs, setupUpload, shaders, results))
+        return EXIT_FAILURE;
+
+    std::cout << "Saved " << opt.outFile << std::endl;
+    return EXIT_SUCCESS;
+}
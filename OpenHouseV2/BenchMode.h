@@ -0,0 +1,40 @@
+#ifndef BENCHMODE_H_INCLUDED
+#define BENCHMODE_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+/**
+\file BenchMode.h
+
+\brief Header file for BenchMode.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Settings of a benchmark run, from the command line.
+
+*/
+
+struct BenchOptions
+{
+    int frames;                 ///< Frames timed in each arena.
+    int warmup;                 ///< Frames drawn in each arena before timing starts.
+    int width;                  ///< Width drawn at.
+    int height;                 ///< Height drawn at.
+    int fighters[2];            ///< Fighter ID of each player.
+    unsigned int seed;          ///< Seed of the scripted players.
+    std::vector<int> arenas;    ///< Arenas played, 0 bath house, 1 alley way, 3 menu.
+    int lights;                 ///< Extra point lights scattered over the arenas.
+    std::string outFile;        ///< JSON results file.
+};
+
+void defaultBenchOptions(BenchOptions& opt);
+bool parseBenchOption(BenchOptions& opt, int argc, char** argv, int& i);
+int runBench(const BenchOptions& opt);
+
+#endif // BENCHMODE_H_INCLUDED
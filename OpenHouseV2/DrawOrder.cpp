@@ -0,0 +1,167 @@
+#include "DrawOrder.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+/**
+\file DrawOrder.cpp
+\brief Front to back ordering of the opaque objects of a frame.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+bool DrawOrder::sorted = true;
+bool DrawOrder::prepass = false;
+
+/**
+\brief Orders two items nearest first.
+
+*/
+
+static bool nearer(const DrawItem& a, const DrawItem& b)
+{
+    return a.distance < b.distance;
+}
+
+/**
+\brief Constructor, an empty list.
+
+*/
+
+DrawOrder::DrawOrder()
+{
+    eye = glm::vec3(0.0f);
+}
+
+/**
+\brief Empties the list for a new frame.
+
+\param Eye --- Camera position the items are ordered from.
+
+*/
+
+void DrawOrder::clear(const glm::vec3& Eye)
+{
+    items.clear();
+    eye = Eye;
+}
+
+/**
+\brief Adds an object to be drawn.
+
+The distance is measured to the world box around the object space box, the same box
+ViewFrustum::isVisible tests.  An object with no bounds is put at the eye.
+
+\param object --- What to draw, given back in the DrawItem.
+\param variant --- Which one of them, given back in the DrawItem.
+\param b --- Object space bounds of its mesh.
+\param model --- Model matrix it is drawn with.
+
+*/
+
+void DrawOrder::add(int object, int variant, const BoundingVolume& b, const glm::mat4& model)
+{
+    DrawItem item;
+    item.object = object;
+    item.variant = variant;
+    item.model = model;
+    item.distance = 0;
+
+    if (b.valid)
+    {
+        glm::vec4 c4 = model * glm::vec4(b.center, 1.0f);
+        glm::vec3 half = (b.boxMax - b.boxMin) * 0.5f;
+
+        glm::vec3 gap;
+        for (int i = 0; i < 3; i++)
+        {
+            float ext = fabs(model[0][i]) * half.x + fabs(model[1][i]) * half.y + fabs(model[2][i]) * half.z;
+            gap[i] = std::max((float)fabs(eye[i] - c4[i]) - ext, 0.0f);
+        }
+        item.distance = glm::length(gap);
+    }
+
+    items.push_back(item);
+}
+
+/**
+\brief Puts the items nearest first, when sorting is on.  Items at the same distance
+keep the order they were added in.
+
+*/
+
+void DrawOrder::sort()
+{
+    if (sorted)
+        std::stable_sort(items.begin(), items.end(), nearer);
+}
+
+/**
+\brief Returns the number of items added since clear.
+
+*/
+
+int DrawOrder::getCount()
+{
+    return items.size();
+}
+
+/**
+\brief Returns an item, in drawing order once sorted.
+
+\param i --- Index of the item.
+
+*/
+
+const DrawItem& DrawOrder::getItem(int i)
+{
+    return items[i];
+}
+
+/**
+\brief Turns the front to back sort on or off for every list.
+
+\param on --- Sort the items, else draw them in the order they were added.
+
+*/
+
+void DrawOrder::setSorted(bool on)
+{
+    sorted = on;
+}
+
+/**
+\brief Returns true if the lists are sorted front to back.
+
+*/
+
+bool DrawOrder::isSorted()
+{
+    return sorted;
+}
+
+/**
+\brief Turns the depth pre-pass on or off for every list.
+
+\param on --- Draw the items into the depth buffer before shading them.
+
+*/
+
+void DrawOrder::setDepthPrepass(bool on)
+{
+    prepass = on;
+}
+
+/**
+\brief Returns true if the items are drawn into the depth buffer before they are shaded.
+
+*/
+
+bool DrawOrder::isDepthPrepass()
+{
+    return prepass;
+}
@@ -0,0 +1,77 @@
+#ifndef DRAWORDER_H_INCLUDED
+#define DRAWORDER_H_INCLUDED
+
+#include <glm/glm.hpp>
+
+#include <vector>
+
+#include "ViewFrustum.h"
+
+/**
+\file DrawOrder.h
+
+\brief Header file for DrawOrder.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief An opaque object waiting to be drawn.
+
+*/
+
+struct DrawItem
+{
+    int object;         ///< What to draw, a number the caller gives meaning to.
+    int variant;        ///< Which one of them, its texture for instance.
+    glm::mat4 model;    ///< Model matrix it is drawn with.
+    float distance;     ///< Distance from the eye to its world box, 0 with the eye inside.
+};
+
+/**
+\class DrawOrder
+
+\brief Orders the opaque objects of a frame front to back so the depth test throws away
+the hidden pixels of the far ones before their fragment shader runs.
+
+The objects that pass the culling are added with the box they were culled with, and
+sort puts the nearest first, measured from the eye to the closest point of the box so
+a floor or wall the camera stands over comes before what stands on it.  The caller
+then draws the items in order.  With the depth pre-pass on the caller first draws the
+items into the depth buffer alone, slightly pushed back with a polygon offset, and
+then shades them with GL_LEQUAL, so each pixel is shaded once whatever the order.
+
+Sorting and the pre-pass are both settings for every list, switched from the command
+line or the keyboard to measure them against each other.
+
+*/
+
+class DrawOrder
+{
+private:
+    static bool sorted;         ///< Items are sorted front to back, else drawn as added.
+    static bool prepass;        ///< Items are drawn into the depth buffer before they are shaded.
+
+    std::vector<DrawItem> items;    ///< Items added since clear.
+    glm::vec3 eye;                  ///< Camera position distances are measured from.
+
+public:
+    DrawOrder();
+
+    void clear(const glm::vec3& Eye);
+    void add(int object, int variant, const BoundingVolume& b, const glm::mat4& model);
+    void sort();
+
+    int getCount();
+    const DrawItem& getItem(int i);
+
+    static void setSorted(bool on);
+    static bool isSorted();
+    static void setDepthPrepass(bool on);
+    static bool isDepthPrepass();
+};
+
+#endif // DRAWORDER_H_INCLUDED
@@ -0,0 +1,270 @@
+#include "EntityWorld.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+/**
+\file EntityWorld.cpp
+\brief Component arrays and systems for the animated characters in the scene.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor, no entities.
+
+*/
+
+EntityWorld::EntityWorld()
+{
+    clear();
+}
+
+/**
+\brief Removes every entity.
+
+*/
+
+void EntityWorld::clear()
+{
+    count = 0;
+}
+
+/**
+\brief Adds an entity at the origin playing clip 0, active and facing +x.
+
+\param entityKind --- One of EntityKind.
+\param entityMesh --- Mesh drawn, may be NULL and set later.
+\param fighter --- Fighter the entity looks like.
+\param playerNum --- Player of a fighter, -1 for the crowd.
+
+\return The entity, or -1 if the world is full.
+
+*/
+
+int EntityWorld::spawn(int entityKind, SkinnedMesh* entityMesh, int fighter, int playerNum)
+{
+    if (count >= ENTITY_MAX)
+        return -1;
+
+    int e = count++;
+    posX[e] = 0;
+    posY[e] = 0;
+    posZ[e] = 0;
+    scale[e] = 1;
+    facing[e] = 1;
+    model[e] = glm::mat4(1.0);
+    clip[e] = 0;
+    clipStart[e] = 0;
+    kind[e] = entityKind;
+    player[e] = playerNum;
+    fighterID[e] = fighter;
+    active[e] = true;
+    visible[e] = false;
+    casting[e] = false;
+    palette[e] = 0;
+    mesh[e] = NULL;
+    setMesh(e, entityMesh);
+    return e;
+}
+
+/**
+\brief Changes the mesh of an entity.
+
+\param e --- The entity.
+\param entityMesh --- Mesh drawn, NULL for none.
+
+*/
+
+void EntityWorld::setMesh(int e, SkinnedMesh* entityMesh)
+{
+    mesh[e] = entityMesh;
+    boneCount[e] = entityMesh ? (int)entityMesh->NumBones() : 0;
+}
+
+/**
+\brief Plays a clip on an entity, restarting its clock only if the clip changed.
+
+\param e --- The entity.
+\param entityClip --- Animation of the mesh.
+\param now --- Current time in seconds.
+
+*/
+
+void EntityWorld::setClip(int e, int entityClip, double now)
+{
+    if (clip[e] == entityClip)
+        return;
+
+    clip[e] = entityClip;
+    clipStart[e] = now;
+}
+
+/**
+\brief Shows or hides every entity of a kind.
+
+\param entityKind --- One of EntityKind.
+\param on --- True to show them.
+
+*/
+
+void EntityWorld::setActive(int entityKind, bool on)
+{
+    for (int e = 0; e < count; e++)
+    {
+        if (kind[e] == entityKind)
+            active[e] = on;
+    }
+}
+
+/**
+\brief Cull system, builds the model matrices and marks the active entities inside
+the view.  Clears the shadow casters, cullShadows marks them after this.
+
+\param frustum --- View of this frame, already updated.
+
+\return The number of entities visible.
+
+*/
+
+int EntityWorld::cull(ViewFrustum& frustum)
+{
+    int shown = 0;
+    for (int e = 0; e < count; e++)
+    {
+        visible[e] = false;
+        casting[e] = false;
+        if (!active[e] || !mesh[e])
+            continue;
+
+        glm::mat4 m = glm::translate(glm::mat4(1.0), glm::vec3(posX[e], posY[e], posZ[e]));
+        model[e] = glm::scale(m, glm::vec3(facing[e]*scale[e], scale[e], scale[e]));
+
+        visible[e] = frustum.isVisible(mesh[e]->getBounds(), model[e]);
+        if (visible[e])
+            shown++;
+    }
+    return shown;
+}
+
+/**
+\brief Cull system for a shadow map, marks the active entities inside a light's frustum
+as casters, called for each map after cull.  An entity just outside the view can still
+cast a shadow into it.
+
+\param frustum --- The light's frustum.
+
+\return The number of entities inside the frustum.
+
+*/
+
+int EntityWorld::cullShadows(ViewFrustum& frustum)
+{
+    int inside = 0;
+    for (int e = 0; e < count; e++)
+    {
+        if (!active[e] || !mesh[e] || !frustum.isVisible(mesh[e]->getBounds(), model[e]))
+            continue;
+
+        casting[e] = true;
+        inside++;
+    }
+    return inside;
+}
+
+/**
+\brief Animation system, works out the bones of every entity visible or casting a
+shadow into one palette.
+
+The clocks of the others still run since they are only start times.
+
+\param now --- Current time in seconds.
+
+*/
+
+void EntityWorld::animate(double now)
+{
+    int used = 0;
+    for (int e = 0; e < count; e++)
+    {
+        if (visible[e] || casting[e])
+        {
+            palette[e] = used;
+            used += boneCount[e];
+        }
+    }
+    if ((int)palettes.size() < used)
+        palettes.resize(used);
+
+    for (int e = 0; e < count; e++)
+    {
+        if (!visible[e] && !casting[e])
+            continue;
+
+        mesh[e]->setAnimationIndex(clip[e]);
+        mesh[e]->GetBoneTransforms((float)(now - clipStart[e]), bones);
+
+        int n = (int)bones.size() < boneCount[e] ? (int)bones.size() : boneCount[e];
+        for (int b = 0; b < n; b++)
+            palettes[palette[e] + b] = bones[b];
+    }
+}
+
+/**
+\brief Draw system, renders every visible entity with its bones.
+
+\param tech --- Skinning shader.
+\param projView --- Projection times view matrix.
+\param PVMLoc --- Location of the PVM matrix in the main shader.
+
+*/
+
+void EntityWorld::draw(SkinningTechnique* tech, const glm::mat4& projView, GLuint PVMLoc)
+{
+    for (int e = 0; e < count; e++)
+    {
+        if (!visible[e])
+            continue;
+
+        glm::mat4 WVP = projView*model[e];
+        glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(WVP));
+        tech->SetWVP(WVP);
+        tech->SetMaterial(mesh[e]->GetMaterial());
+
+        for (int b = 0; b < boneCount[e]; b++)
+            tech->SetBoneTransform(b, palettes[palette[e] + b]);
+
+        mesh[e]->Render();
+    }
+}
+
+/**
+\brief Shadow pass of the draw system, renders the casters inside a light's frustum with the depth program in use and the palette animate worked out for them.
+
+\param projView --- Light projection times light view matrix.
+\param PVMLoc --- Location of the PVM matrix in the depth shader.
+\param bonesLoc --- Location of the gBones array in the depth shader.
+\param frustum --- The light's frustum.
+
+*/
+
+void EntityWorld::drawDepth(const glm::mat4& projView, GLint PVMLoc, GLint bonesLoc, ViewFrustum& frustum)
+{
+    for (int e = 0; e < count; e++)
+    {
+        if (!casting[e] || !frustum.isVisible(mesh[e]->getBounds(), model[e]))
+            continue;
+
+        glm::mat4 WVP = projView*model[e];
+        glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(WVP));
+
+        // Matrix4f is row major.
+        if (boneCount[e] > 0)
+            glUniformMatrix4fv(bonesLoc, boneCount[e], GL_TRUE, (const GLfloat*)&palettes[palette[e]]);
+
+        mesh[e]->RenderDepth();
+    }
+}
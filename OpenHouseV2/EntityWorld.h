@@ -0,0 +1,106 @@
+#ifndef ENTITYWORLD_H_INCLUDED
+#define ENTITYWORLD_H_INCLUDED
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "skinned_mesh.h"
+#include "skinning_technique.h"
+#include "ViewFrustum.h"
+
+/**
+\file EntityWorld.h
+
+\brief Header file for EntityWorld.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define ENTITY_MAX 128   ///< Most entities a world holds, fighters and crowd together.
+
+/**
+\brief What an entity is, so a group can be shown, hidden or removed together.
+
+*/
+
+enum EntityKind
+{
+    ENTITY_FIGHTER,   ///< A player's fighter.
+    ENTITY_CROWD      ///< A background character.
+};
+
+/**
+\class EntityWorld
+
+\brief Every animated skinned character in the scene, the players' fighters and the
+crowd, stored as arrays of one component each instead of one object per character.
+
+The components are the transform (position, scale and facing), the animation (mesh,
+clip and clock), the combat link (which player, if any, and which fighter) and the
+render state (active, visible, casting a shadow and where its bones are in the
+palette).  Each system walks the entities from first to last reading only the arrays it
+needs: cull reads the transforms, animate the clips and clocks of the ones in view or
+casting a shadow into it and draw the matrices and palettes.  Entities are kept in the
+order they were spawned, so spawning a group that shares a mesh together keeps that
+mesh's animation data hot while it is worked on.
+
+A mesh is not owned and may be shared by any number of entities.  Each entity has its
+own clip and clock, so a mesh's current animation is only set for the moment its bones
+are worked out.  The world is owned by the render thread.
+
+*/
+
+class EntityWorld
+{
+private:
+    std::vector<Matrix4f> palettes;   ///< Bone matrices of every entity, one block each.
+    std::vector<Matrix4f> bones;      ///< Scratch space for one entity's bones.
+
+public:
+    int count;                          ///< Number of entities.
+
+    //Transform
+    float posX[ENTITY_MAX];             ///< World position x.
+    float posY[ENTITY_MAX];             ///< World position y.
+    float posZ[ENTITY_MAX];             ///< World position z.
+    float scale[ENTITY_MAX];            ///< Uniform scale.
+    int facing[ENTITY_MAX];             ///< 1, or -1 to mirror across x.
+    glm::mat4 model[ENTITY_MAX];        ///< Model matrix built by cull.
+
+    //Animation
+    SkinnedMesh* mesh[ENTITY_MAX];      ///< Mesh drawn, not owned, NULL for none.
+    int clip[ENTITY_MAX];               ///< Animation of the mesh being played.
+    double clipStart[ENTITY_MAX];       ///< Time the clip started, seconds.
+
+    //Combat
+    int kind[ENTITY_MAX];               ///< One of EntityKind.
+    int player[ENTITY_MAX];             ///< Player of a fighter, -1 for the crowd.
+    int fighterID[ENTITY_MAX];          ///< Fighter the entity looks like.
+
+    //Render
+    bool active[ENTITY_MAX];            ///< In the scene this frame.
+    bool visible[ENTITY_MAX];           ///< Active and inside the view, set by cull.
+    bool casting[ENTITY_MAX];           ///< Active and inside a shadow map's frustum, set by cullShadows.
+    int palette[ENTITY_MAX];            ///< First matrix of the entity's bones in palettes.
+    int boneCount[ENTITY_MAX];          ///< Number of bone matrices, from the mesh.
+
+    EntityWorld();
+
+    void clear();
+    int spawn(int entityKind, SkinnedMesh* entityMesh, int fighter, int playerNum);
+    void setMesh(int e, SkinnedMesh* entityMesh);
+    void setClip(int e, int entityClip, double now);
+    void setActive(int entityKind, bool on);
+
+    int cull(ViewFrustum& frustum);
+    int cullShadows(ViewFrustum& frustum);
+    void animate(double now);
+    void draw(SkinningTechnique* tech, const glm::mat4& projView, GLuint PVMLoc);
+    void drawDepth(const glm::mat4& projView, GLint PVMLoc, GLint bonesLoc, ViewFrustum& frustum);
+};
+
+#endif // ENTITYWORLD_H_INCLUDED
@@ -0,0 +1,822 @@
+#include "FighterCore.h"
+
+/**
+\file FighterCore.cpp
+\brief File that does the stuff defined in "FighterCore.h", moved out of Fighter.cpp so
+the fight can be simulated without a window or audio device.
+
+\author     Brian Bowers
+\version    1.0
+\date       10/19/2026
+
+*/
+
+/**
+\brief Constructor
+
+*/
+
+FighterCore::FighterCore()
+{
+    table = NULL;
+    quiet = false;
+}
+
+/**
+\brief Pretty much does normal constructor stuff but sets fighterNum to fiNum also
+
+*/
+void FighterCore::newFighter(int fiNum, int fiId)
+{
+    fighterNum = fiNum;
+    rivalNum = 1 - fiNum;
+    fighterID[fighterNum] = fiId;
+    scales[0] = 0.4;
+    scales[1] = 0.235;
+    scales[2] = 0.21;
+    scales[3] = 0.265;
+    scales[4] = 0.232;
+    scales[5] = 0.1;
+
+    for (int i = 0; i < FIGHTER_LIMBS; i++)
+    {
+        for (int x = 0; x < 3; x++)
+            rotations[i][x] = 0;
+    }
+    //Need to rewrite ready stance
+    readyStance(fighterNum);
+    resetCounters();
+}
+/**
+\brief De-constructor
+
+*/
+FighterCore::~FighterCore()
+{
+
+}
+
+/**
+\brief Puts the attack counters back to the rest values of the current fighter.
+
+Used to be static locals of preformActions, which were shared by every fighter and
+never reset between matches.
+
+*/
+void FighterCore::resetCounters()
+{
+    g = table->frames[FRAMES_KICK][fighterID[fighterNum]];
+    punchCounter = table->frames[FRAMES_PUNCH][fighterID[fighterNum]];
+    tornadoCounter = table->frames[FRAMES_TORNADO][fighterID[fighterNum]];
+    jumpFactor = 10;
+}
+
+/**
+\brief Called when an attack lands, the core does nothing.  Fighter plays the sounds.
+
+\param hitType --- One of FightHit.
+
+*/
+void FighterCore::onHit(int /*hitType*/)
+{
+
+}
+
+void FighterCore::oppTracker(int oppNum, int oppId, float oppX, float oppY, bool oppAttacking, bool oppKick, bool oppPunch, bool oppPunch2, bool oppTor, bool oppStun)
+{
+    fighterX[oppNum] = oppX;
+    fighterY[oppNum] = oppY;
+    fighterID[oppNum] = oppId;
+    if (centerDist == -1) {
+        if (table->body[fighterID[rivalNum]] >= table->body[fighterID[fighterNum]])
+            centerDist = table->body[fighterID[rivalNum]];
+        else
+            centerDist = table->body[fighterID[fighterNum]];
+    }
+    attacking[oppNum] = oppAttacking;
+    kick[oppNum] = oppKick;
+    punch[oppNum] = oppPunch;
+    punch2[oppNum] = oppPunch2;
+    tornado[oppNum] = oppTor;
+    fighterStun[fighterNum] = oppStun;
+    if (fighterStun[oppNum])
+        fighterStun[oppNum] = false;
+    //std::cout<<fighterStun[fighterNum]<<std::endl;
+    rivalNum = oppNum;
+}
+/**
+\brief This function adds the given amount to the rotation in the given index. From Dr. Spickler
+
+The second player's limbs are numbered from 12, as they are drawn, and kept in the same
+rows as the first player's, a fighter only has its own.
+
+*/
+void FighterCore::addRotations(int limb, int axis, float val) {
+    rotations[limb % FIGHTER_LIMBS][axis] += val;
+}
+/**
+\brief This function sets the given amount to the rotation in the given index.
+
+*/
+void FighterCore::setRotations(int limb, int axis, float val)
+{
+    rotations[limb % FIGHTER_LIMBS][axis] = val;
+}
+/**
+\brief This function adds the given amount to the scales in the given index. From Dr. Spickler
+
+*/
+void FighterCore::addScales(int i, float val) {
+    scales[i] += val;
+}
+/**
+\brief This function moves a fighter left and right
+
+\param fighterNum --- Integer id value of the current fighter being moved on the x axis (0 or 1)
+
+\param forw --- Setting forward to true or false
+
+\param eye --- Setting backwards to true or False
+*/
+void FighterCore::fighterMoveX(int fighterNum, bool forw, bool backw) {
+    //std::cout << "function is called" << fighterNum << forw << backw << std::endl;
+    if (forw)
+    {
+       moveForwards[fighterNum] = true;
+       moveBackwards[fighterNum] = false;
+    }
+    else if (backw)
+    {
+        moveForwards[fighterNum] = false;
+        moveBackwards[fighterNum] = true;
+    }
+    else if (!forw || !backw)
+    {
+        moveForwards[fighterNum] = false;
+        moveBackwards[fighterNum] = false;
+    }
+}
+/**
+\brief This function makes the fighter jump but is currently not implemented due to dissatisifcation on the animation
+
+\param fighterNum --- Integer Id value of the current fighter being altered
+*/
+void FighterCore::fighterJump(int fighterNum) {
+    //fighterY[fighterNum] = fighterY[fighterNum];
+    //Under construction
+    if (!(jump[fighterNum] || jumpStop[fighterNum])){
+        jump[fighterNum] = true;
+        //std::cout<<"Jumped???"<<std::endl;
+    }
+}
+/**
+\brief Puts out the boxes of a move whose window the move's counter is in, called each
+step the move runs.
+
+\param move --- One of FightHit.
+
+\param counter --- The move's counter this step, see FighterTable for which it is
+*/
+void FighterCore::markBoxes(int move, float counter)
+{
+    int id = fighterID[fighterNum];
+    for (int b = 0; b < table->boxCount[id]; b++)
+    {
+        if (table->boxMove[b][id] == move && counter >= table->boxFrom[b][id] && counter <= table->boxTo[b][id])
+            boxActive |= 1 << b;
+    }
+}
+/**
+\brief Adds this fighter's boxes for this step to the hit world, flipped to face the
+way the fighter does and moved to where it stands.  Hitboxes of a move that already
+landed are left out.
+
+\param world --- World to add them to.
+*/
+void FighterCore::addBoxes(HitWorld& world) const
+{
+    int id = fighterID[fighterNum];
+    float x = fighterX[fighterNum];
+    float y = fighterHeight[fighterNum];
+    int dir = fighterDir[fighterNum];
+
+    for (int b = 0; b < table->boxCount[id]; b++)
+    {
+        int move = table->boxMove[b][id];
+        bool hits = table->boxHits[b][id];
+        if (move >= 0 && !(boxActive & (1 << b)))
+            continue;
+        if (hits && (hitLanded & (1 << move)))
+            continue;
+
+        float x0 = x + dir*table->boxMin[0][b][id];
+        float x1 = x + dir*table->boxMax[0][b][id];
+        HitBox box;
+        box.minX = x0 < x1 ? x0 : x1;
+        box.maxX = x0 < x1 ? x1 : x0;
+        box.minY = y + table->boxMin[1][b][id];
+        box.maxY = y + table->boxMax[1][b][id];
+        box.owner = fighterNum;
+        box.move = hits ? move : -1;
+        world.add(box);
+    }
+}
+/**
+\brief Lands a move on the rival, which is stunned and loses the move's damage
+
+\param move --- One of FightHit, knee and double punch do the bonus damage
+*/
+void FighterCore::landHit(int move)
+{
+    static const int attack[FIGHT_HIT_MOVES] = {ATTACK_PUNCH, ATTACK_BONUS, ATTACK_KICK, ATTACK_BONUS, ATTACK_SPECIAL};
+
+    hitLanded |= 1 << move;
+    if (!fighterStun[rivalNum])
+        fighterStun[rivalNum] = true;
+    fighterHP[rivalNum] -= table->damage[attack[move]][fighterID[fighterNum]];
+    onHit(move);
+}
+/**
+\brief Updates a provided fighter's health (A.K.A. Hit Points)
+
+\param fighterNum --- Integer id value of the fighter whose HP is being Updated
+
+\param value --- Float value that is being applied to the existed HP for the fighter
+*/
+void FighterCore::updateHP(int fighterNum, float value)
+{
+    fighterHP[fighterNum] += value;
+}
+/**
+\brief Sets the "punch" and "double punch" animation to begin after checking if the fighter is stunned or already attacking
+
+\param fighterNum --- Integer Id value of the fighter attempting to throw the punch
+*/
+void FighterCore::punchNow(int fighterNum)
+{
+    if (!(attacking[fighterNum] || punch[fighterNum] || punchStop[fighterNum] || fighterStun[fighterNum] || stunCounter[fighterNum] < 15 || fighterDown[fighterNum]))
+    {
+        //Do animation thing
+        punch[fighterNum] = true;
+        attacking[fighterNum] = true;
+    }
+    else if (attacking[fighterNum] && (punch[fighterNum] || punchStop[fighterNum]) && !(fighterStun[fighterNum] || stunCounter[fighterNum] < 15 ||fighterDown[fighterNum] || punch2[fighterNum]) && table->doublePunch[fighterID[fighterNum]])
+    {
+        punch2[fighterNum] = true;
+    }
+}
+/**
+\brief Sets the "kick" animation to begin after checking if the fighter is stunned or already attacking
+
+\param fighterNum --- Integer Id value of the fighter attempting to throw the punch
+*/
+void FighterCore::kickNow(int fighterNum)
+{
+    if (!(attacking[fighterNum] || kick[fighterNum] || kickStop[fighterNum] || fighterStun[fighterNum] ||  stunCounter[fighterNum] < 15 || fighterDown[fighterNum]))
+    {
+        kick[fighterNum] = true;
+        attacking[fighterNum] = true;
+    }
+
+    //Do the check hit in separate function?
+}
+/**
+\brief Sets the "tornado attcack!" animation to begin after checking if the fighter is stunned or already attacking
+
+\param fighterNum --- Integer Id value of the fighter attempting to throw the punch
+*/
+void FighterCore::tornadoNow(int fighterNum)
+{
+    if (!(attacking[fighterNum] || tornado[fighterNum] || tornadoStop[fighterNum] || fighterStun[fighterNum] || stunCounter[fighterNum] < 15 || fighterDown[fighterNum]))
+    {
+        tornado[fighterNum] = true;
+        attacking[fighterNum] = true;
+        tposeStance(fighterNum);
+    }
+}
+/**
+\brief This function is where the meat of the "animations" occurs. It applies rotations to the fighter's limbs
+
+\param fighterNum --- Integer Id value of the fighter attempting to throw the punch
+*/
+void FighterCore::preformActions()
+{
+
+    //Counters are members now, see resetCounters
+    //If not fighter "0" then added 12 to rotations to access correct data
+    int numAdder = 0;
+    int rivalNum = 1;
+    if (fighterNum == 1)
+    {
+        numAdder = 12;
+        rivalNum = 0;
+    }
+
+    //printf("FighterID= %d\n", fighterID[fighterNum]);
+    boxActive = 0;
+//Stun
+    if (fighterStun[fighterNum])
+    {
+        //Cancel any ongoing animation
+        readyStance(fighterNum);
+        fighterAnimation = table->anim[ANIM_STUN][fighterID[fighterNum]];//Loads Stun animation if bone animated
+        g = 22;
+        punchCounter = 50;
+        tornadoCounter = fighterDir[fighterNum]*30;
+        stunCounter[fighterNum]--;
+        fighterStun[fighterNum] = false;
+    }
+    else if (stunCounter[fighterNum] < 15)
+    {
+        if ((!(fighterX[fighterNum] < -28) && fighterNum == 0) || (!(fighterX[fighterNum] > 28) && fighterNum == 1))
+            fighterX[fighterNum] += -fighterDir[fighterNum]*0.1;
+        addRotations(0+numAdder, 0, -fighterDir[fighterNum]*0.3*stunCounter[fighterNum]);
+        stunCounter[fighterNum]--;
+
+        if (stunCounter[fighterNum] <= 0)
+        {
+            fighterStun[fighterNum] = false;
+            stunCounter[fighterNum] = 15;
+            setRotations(0+numAdder, 0, 0);
+            fighterAnimation = table->anim[ANIM_STANCE][fighterID[fighterNum]];
+        }
+    }
+        //std::cout << moveForwards[0] << " " << moveBackwards[0] << std::endl;
+//Walking
+    if (moveForwards[fighterNum] && !kick[fighterNum] && !kickStop[fighterNum] && !punch2Stop[fighterNum])
+    {
+        //Chooses the greater of the distances for spacing
+        //float centerDist = 0;
+        if (table->body[fighterID[rivalNum]] >= table->body[fighterID[fighterNum]])
+            centerDist = table->body[fighterID[rivalNum]];
+        else
+            centerDist = table->body[fighterID[fighterNum]];
+
+        //printf("FighterNum: %d, C.D. %f, rival%f, curr%f \n", fighterNum, centerDist, table->body[fighterID[rivalNum]], table->body[fighterID[fighterNum]]);
+
+        if ((!(fighterX[fighterNum] > fighterX[rivalNum]-centerDist) && fighterNum == 0) || (!(fighterX[fighterNum] < fighterX[rivalNum]+centerDist) && fighterNum == 1))
+        {
+            fighterX[fighterNum] += fighterDir[fighterNum]*0.3;
+            fighterAnimation = table->anim[ANIM_WALK][fighterID[fighterNum]];//Sets animation to walking animation
+        }
+    }
+    else if (moveBackwards[fighterNum] && !kick[fighterNum] && !kickStop[fighterNum] && !punch2Stop[fighterNum])
+    {
+        if ((!(fighterX[fighterNum] < -28) && fighterNum == 0) || (!(fighterX[fighterNum] > 28) && fighterNum == 1))
+        {
+            fighterX[fighterNum] += -fighterDir[fighterNum]*0.3;
+            fighterAnimation = table->anim[ANIM_WALK][fighterID[fighterNum]];//Sets animation to walking animation
+        }
+        //Add Animation
+    }
+    else if (!(moveBackwards[fighterNum] || moveForwards[fighterNum]) && !(attacking[fighterNum] || stunCounter[fighterNum] < 15))
+    {
+        //Return to rest rotations
+        fighterAnimation = table->anim[ANIM_STANCE][fighterID[fighterNum]];
+        //readyStance(fighterNum);
+    }
+
+//Jump
+
+    if (jump[fighterNum])
+    {
+        //jumpFactor = 0.5*(jumpFactor);
+        fighterHeight[fighterNum] += (0.5*(jumpFactor));
+        if (fighterHeight[fighterNum] >= 14)
+        {
+            jump[fighterNum] = false;
+            jumpStop[fighterNum] = true;
+        }
+    }
+
+    if (jumpStop[fighterNum])
+    {
+        //jumpFactor *= 2;
+        fighterHeight[fighterNum] -= (0.5*(jumpFactor));
+        if (fighterHeight[fighterNum] <= 0)
+        {
+            fighterHeight[fighterNum] = 0;
+            jumpStop[fighterNum] = false;
+            jumpFactor = 5;
+        }
+    }
+
+
+//Kick
+    if (kick[fighterNum])
+    {
+        int id = fighterID[fighterNum];
+        g += table->kickStep[id];
+        //printf("%f\n", g);
+        fighterAnimation = table->anim[ANIM_KICK][id];
+        markBoxes(FIGHT_HIT_KICK, g);
+        markBoxes(FIGHT_HIT_KNEE, g);
+
+        //End animation
+        if (g >= 100)
+        {
+            kick[fighterNum] = false;
+            kickStop[fighterNum] = true;
+        }
+        if (fighterNum == 0)
+            setRotations(8 + numAdder, 0, g);
+        else if (fighterNum == 1)
+            setRotations(10+numAdder, 0, g);
+    }
+    else if (kickStop[fighterNum])
+    {
+        g -= 4;
+        fighterAnimation = table->anim[ANIM_KICK][fighterID[fighterNum]];
+
+        if (fighterNum == 0)
+            setRotations(8 + numAdder, 0, g);
+        else if (fighterNum == 1)
+            setRotations(10+numAdder, 0, g);
+
+        if (g <= table->frames[FRAMES_KICK][fighterID[fighterNum]])
+        {
+            kickStop[fighterNum] = false;
+            attacking[fighterNum] = false;
+            //g = fighterDir[fighterNum]*22;
+            g = table->frames[FRAMES_KICK][fighterID[fighterNum]];
+            readyStance(fighterNum);
+            fighterAnimation = table->anim[ANIM_STANCE][fighterID[fighterNum]];
+        }
+    }
+
+//Punch And Double Punch
+    if (punch[fighterNum])
+    {
+        punchCounter -= 5;
+        fighterAnimation = table->anim[ANIM_PUNCH][fighterID[fighterNum]];
+        markBoxes(FIGHT_HIT_PUNCH, punchCounter);
+
+        if (punchCounter <= 0)
+            {
+                punch[fighterNum] = false;
+                punchStop[fighterNum] = true;
+                fighterAnimation = table->anim[ANIM_STANCE][fighterID[fighterNum]];
+            }
+
+        if (fighterNum == 0)
+        {
+            setRotations(2 + numAdder, 2, 33); //Constant 33
+            setRotations(2 + numAdder, 1, punchCounter); //0 to 90
+            setRotations(3 + numAdder, 1, -2*punchCounter); //0 to 90
+            setRotations(3 + numAdder, 2, 0);
+        }
+        else if (fighterNum == 1)
+        {
+            setRotations(5 + numAdder, 2, -33); //Constant 33
+            setRotations(5 + numAdder, 1, -punchCounter); //0 to 90
+            setRotations(6 + numAdder, 1, 2*punchCounter); //0 to 90
+            setRotations(6 + numAdder, 2, 0);
+        }
+
+    }
+    else if (punchStop[fighterNum])
+    {
+        punchCounter += 5;
+        if (fighterNum == 0)
+        {
+            setRotations(2 + numAdder, 1, punchCounter); //0 to 90
+            setRotations(3 + numAdder, 1, -2*punchCounter); //0 to 90
+        }
+        else if (fighterNum == 1)
+        {
+            setRotations(5 + numAdder, 1, -punchCounter); //0 to 90
+            setRotations(6 + numAdder, 1, 2*punchCounter); //0 to 90
+        }
+
+        if (punchCounter >= table->frames[FRAMES_PUNCH][fighterID[fighterNum]]) //Originally 50
+        {
+            punchStop[fighterNum] = false;
+            if (!punch2[fighterNum])
+                attacking[fighterNum] = false;
+            //punchCounter = 50;
+            punchCounter = table->frames[FRAMES_PUNCH][fighterID[fighterNum]];
+            if (fighterNum == 0)
+            {
+                setRotations(2 + numAdder, 1, 60);
+                setRotations(3 + numAdder, 1, 0);
+                setRotations(2 + numAdder, 2, 0);
+                setRotations(3 + numAdder, 2, 120);
+            }
+            else if (fighterNum == 1)
+            {
+                setRotations(5 + numAdder, 1, -60);
+                setRotations(6 + numAdder, 1, 0);
+                setRotations(5 + numAdder, 2, 0);
+                setRotations(6 + numAdder, 2, -120);
+            }
+        }
+    }
+    else if (punch2[fighterNum] && !(punch[fighterNum] || punchStop[fighterNum]))
+    {
+        //Subtract the counter (change to multiply by direction constant)
+        punchCounter -= 5;
+        if (fighterNum == 0)
+        {
+            //Head turn forward
+            setRotations(1 + numAdder, 2, -punchCounter);// -50 to 0
+            //Body Turn to Rival
+            addRotations(0 + numAdder, 2, -10); //-33 to over -90
+            //Left arm second punch
+            setRotations(5 + numAdder, 2, 33); //0 to 90
+            setRotations(5 + numAdder, 1, punchCounter); //0 to 90
+            setRotations(6 + numAdder, 1, -2*punchCounter); //0 to 90
+            setRotations(6 + numAdder, 2, 0);
+        }
+        else if (fighterNum == 1)
+        {
+            //Head turn forward
+            setRotations(1 + numAdder, 2, punchCounter);// -50 to 0
+            //Body Turn to Rival
+            addRotations(0 + numAdder, 2, 10); //-33 to over -90
+            //Left arm second punch
+            setRotations(2 + numAdder, 2, 33); //0 to 90
+            setRotations(2 + numAdder, 1, -punchCounter); //0 to 90
+            setRotations(3 + numAdder, 1, 2*punchCounter); //0 to 90
+            setRotations(3 + numAdder, 2, 0);
+        }
+
+
+        markBoxes(FIGHT_HIT_DOUBLE_PUNCH, punchCounter);
+        if (punchCounter <= 0)
+        {
+            punch2[fighterNum] = false;
+            punch2Stop[fighterNum] = true;
+            punchCounter = 0;
+        }
+    }
+    else if (punch2Stop[fighterNum] && !(punch[fighterNum] || punchStop[fighterNum]))
+    {
+        //Add the counter (Change to multiply by direction constant later)
+        punchCounter += 5;
+
+        if (fighterNum == 0)
+        {
+            //Head turn forward
+            setRotations(1 + numAdder, 2, -punchCounter);// -50 to 0
+            //Body Turn to Rival
+            addRotations(0 + numAdder, 2, 10); //-33 to over -90
+            //Left arm second punch
+            setRotations(5 + numAdder, 2, 33); //0 to 90
+            setRotations(5 + numAdder, 1, punchCounter); //0 to 90
+            setRotations(6 + numAdder, 1, -2*punchCounter); //0 to 90
+            setRotations(6 + numAdder, 2, 0);
+        }
+        else if (fighterNum == 1)
+        {
+            //Head turn forward
+            setRotations(1 + numAdder, 2, punchCounter);// -50 to 0
+            //Body Turn to Rival
+            addRotations(0 + numAdder, 2, -10); //-33 to over -90
+            //Left arm second punch
+            setRotations(2 + numAdder, 2, 33); //0 to 90
+            setRotations(2 + numAdder, 1, -punchCounter); //0 to 90
+            setRotations(3 + numAdder, 1, 2*punchCounter); //0 to 90
+            setRotations(3 + numAdder, 2, 0);
+        }
+
+        if (punchCounter >= table->frames[FRAMES_PUNCH][fighterID[fighterNum]]) //Originally 50
+        {
+            punch2Stop[fighterNum] = false;
+            attacking[fighterNum] = false;
+            //punchCounter = 50;
+            punchCounter = table->frames[FRAMES_PUNCH][fighterID[fighterNum]];
+            if (fighterNum == 0)
+                setRotations(6 + numAdder, 1, 0);
+            else if (fighterNum == 1)
+                setRotations(3 + numAdder, 1, 0);
+            readyStance(fighterNum);
+        }
+    }
+
+    if (tornado[fighterNum])
+    {
+        if (table->spin[fighterID[fighterNum]])
+        {
+            tornadoCounter += fighterDir[fighterNum]*15;
+
+                    //Spin
+            setRotations(0 + numAdder, 2, tornadoCounter);
+            markBoxes(FIGHT_HIT_TORNADO, fighterDir[fighterNum]*tornadoCounter);
+            if (tornadoCounter == fighterDir[fighterNum]*540)
+            {
+                tornado[fighterNum] = false;
+                tornadoStop[fighterNum] = true;
+            }
+        }
+        else
+        {
+            int id = fighterID[fighterNum];
+            tornadoCounter += table->specialStep[id];
+            //printf("%f\n", tornadoCounter);
+            fighterAnimation = table->anim[ANIM_SPECIAL][id];
+            markBoxes(FIGHT_HIT_TORNADO, tornadoCounter);
+            if (tornadoCounter >= table->specialEnd[id])
+            {
+                tornado[fighterNum] = false;
+                tornadoStop[fighterNum] = true;
+            }
+        }
+
+
+    }
+    else if (tornadoStop[fighterNum])
+    {
+        if (table->spin[fighterID[fighterNum]])
+        {
+            tornadoCounter -= fighterDir[fighterNum]*5;
+            setRotations(0 + numAdder, 2, tornadoCounter);
+            if (tornadoCounter == fighterDir[fighterNum]*390)
+            {
+                tornadoCounter = fighterDir[fighterNum]*30;
+                tornadoStop[fighterNum] = false;
+                readyStance(fighterNum);
+            }
+        }
+        else
+        {
+            tornadoCounter -= 10;
+            if (tornadoCounter <= table->frames[FRAMES_TORNADO][fighterID[fighterNum]]){
+                tornadoCounter = table->frames[FRAMES_TORNADO][fighterID[fighterNum]];
+                tornadoStop[fighterNum] = false;
+                readyStance(fighterNum);
+                fighterAnimation = table->anim[ANIM_STANCE][fighterID[fighterNum]];
+            }
+        }
+    }
+
+    //A move can land again once its hitboxes have all gone back in
+    int id = fighterID[fighterNum];
+    int out = 0;
+    for (int b = 0; b < table->boxCount[id]; b++)
+    {
+        if ((boxActive & (1 << b)) && table->boxHits[b][id])
+            out |= 1 << table->boxMove[b][id];
+    }
+    hitLanded &= out;
+}
+
+void FighterCore::readyStance(int fighterNum)
+{
+    //Cancels any current animations
+    punch[fighterNum] = false;
+    punchStop[fighterNum] = false;
+    punch2[fighterNum] = false;
+    punch2Stop[fighterNum] = false;
+    kick[fighterNum] = false;
+    kickStop[fighterNum] = false;
+    tornado[fighterNum] = false;
+    tornadoStop[fighterNum] = false;
+    moveForwards[fighterNum] = false;
+    moveBackwards[fighterNum] = false;
+    attacking[fighterNum] = false;
+    //Return to "Ready Stance" Rotations
+    setRotations(0 + addNum[fighterNum], 2 , -fighterDir[fighterNum]*33);
+    setRotations(1 + addNum[fighterNum], 2, -fighterDir[fighterNum]*50);
+
+
+    if (fighterNum == 0)
+    {
+        //Right Arm (Screen Perspective)
+        setRotations(2 + addNum[fighterNum], 1, fighterDir[fighterNum]*60);
+        setRotations(3 + addNum[fighterNum], 2, fighterDir[fighterNum]*120);
+        //Left Arm (Screen Perspective)
+        setRotations(5 + addNum[fighterNum], 1, -fighterDir[fighterNum]*60);
+        setRotations(6 + addNum[fighterNum], 2, -fighterDir[fighterNum]*120);
+        //Right Leg
+        setRotations(8 + addNum[fighterNum], 2, -fighterDir[fighterNum]*64);
+        setRotations(8 + addNum[fighterNum], 0, fighterDir[fighterNum]*22);
+        setRotations(9 + addNum[fighterNum], 0, -fighterDir[fighterNum]*22);
+        //Left Leg
+        setRotations(10 + addNum[fighterNum], 0, 0);
+        setRotations(11 + addNum[fighterNum], 0, 0);
+    }
+    else if (fighterNum == 1)
+    {
+        //Right Arm (Screen Perspective)
+        setRotations(2 + addNum[fighterNum], 1, 60);
+        setRotations(3 + addNum[fighterNum], 2, 120);
+        //Left Arm (Screen Perspective)
+        setRotations(5 + addNum[fighterNum], 1, -60);
+        setRotations(6 + addNum[fighterNum], 2, -120);
+        //Right Leg (Screen Perspective)
+        //Far Leg (Away from other fighter)
+        setRotations(8 + addNum[fighterNum], 0, 0);
+        setRotations(9 + addNum[fighterNum], 0, 0);
+
+        setRotations(10 + addNum[fighterNum], 2, -fighterDir[fighterNum]*64);
+        setRotations(10 + addNum[fighterNum], 0, -fighterDir[fighterNum]*22);
+        setRotations(11 + addNum[fighterNum], 0, fighterDir[fighterNum]*22);
+    }
+
+}
+
+/**
+\brief Sets the provided fighter into its constructed form by setting all rotations to 0. Used for "tornado attack!"
+
+\param fighterNum --- Integer Id value of the fighter attempting to throw the punch
+*/
+void FighterCore::tposeStance(int fighterNum)
+{
+    int num = 0;
+    if (fighterNum == 1)
+    {
+        num = 12;
+    }
+    for(int i = num; i < 12 + num; i++)
+    {
+        for (int x = 0; x < 3; x++)
+            setRotations(i, x, 0);
+    }
+}
+
+void FighterCore::swapAnimation(int index)
+{
+    fighterAnimation = index;
+    //gMesh->setAnimationIndex(index);
+    //printf("Animation Index swapped to %d\n", gMesh->getAnimationIndex());
+}
+
+int FighterCore::getFighterAnimation()
+{
+    return fighterAnimation;
+}
+
+void FighterCore::setFighterID(int fiID, int rivID)
+{
+    fighterID[fighterNum] = fiID;
+    fighterID[rivalNum] = rivID;
+    resetCounters();
+}
+
+/**
+\brief Sets the fighter definitions the rules read, which must outlive the fighter.
+
+\param t --- The table, every fighter ID used must be in it.
+
+*/
+void FighterCore::setTable(const FighterTable* t)
+{
+    table = t;
+}
+
+/**
+\brief Copies everything that changes during a fight into a FighterState.
+
+\param st --- State to fill.
+
+*/
+void FighterCore::saveState(FighterState& st) const
+{
+    st = *this;
+}
+
+/**
+\brief Puts back a state saved by saveState.
+
+\param st --- State to restore.
+
+*/
+void FighterCore::loadState(const FighterState& st)
+{
+    FighterState::operator=(st);
+}
+
+/**
+\brief Runs one step of a fight between two fighters, each tells the other where it
+is and what it is doing and then carries out its actions.  Once both have moved their
+boxes are collided and the hits land, to be taken up by the one hit next step.
+
+\param f0 --- Player one's fighter.
+\param f1 --- Player two's fighter.
+\param fiIndex --- Selected fighter of each player.
+\param world --- Scratch space for the collision, kept between steps so it does not
+allocate.
+
+*/
+void FighterCore::stepPair(FighterCore& f0, FighterCore& f1, const int fiIndex[2], HitWorld& world)
+{
+    FighterCore* f[2] = {&f0, &f1};
+
+    //Hits landed last step, read before player one's tracker clears its own
+    bool stunned[2] = {f1.fighterStun[0], f0.fighterStun[1]};
+
+    for (int i = 0; i < 2; i++)
+    {
+        int r = 1 - i;
+        f[i]->oppTracker(r, fiIndex[i], f[r]->fighterX[r], f[r]->fighterY[r], f[r]->attacking[r], f[r]->kick[r], f[r]->punch[r], f[r]->punch2[r], f[r]->tornado[r], stunned[i]);
+        f[i]->preformActions();
+    }
+
+    world.clear();
+    f0.addBoxes(world);
+    f1.addBoxes(world);
+
+    const std::vector<HitContact>& contacts = world.collide();
+    for (size_t c = 0; c < contacts.size(); c++)
+        f[contacts[c].attacker]->landHit(contacts[c].move);
+}
@@ -0,0 +1,158 @@
+#ifndef FIGHTERCORE_H_INCLUDED
+#define FIGHTERCORE_H_INCLUDED
+
+#include <stdlib.h>
+#include <type_traits>
+
+#include "FighterTable.h"
+#include "HitWorld.h"
+
+/***
+\file FighterCore.h
+
+\brief Header file for FighterCore.cpp
+
+\author     Brian Bowers
+\version    1.0
+\date       10/19/2026
+
+*/
+
+#define FIGHTER_LIMBS 12    ///< Limbs of one fighter, drawn as 0 to 11 for the first player and 12 to 23 for the second.
+
+/**
+\brief Everything about a fighter that changes while a fight runs.
+
+Kept as one trivially copyable struct so the whole state can be saved and restored
+with a plain copy, which is what rollback needs.  The fighter definitions are not in
+here, they live in a FighterTable that does not change during a match.  Only this
+fighter's limbs and attack counters are kept, and the struct is aligned to 16 bytes so
+both fighters of a MatchSnapshot copy from aligned addresses.
+
+*/
+
+struct alignas(16) FighterState
+{
+    int fighterNum; ///< aka playerNum, will probably change for clarity sake
+    int fighterID[2];  ///< aka the ID of what fighter are you using (hand fighter, og fighter, ect.)
+    int rivalNum;   ///< aka playerNum of opponent, used for easy array access
+
+    float centerDist = -1; //picks largest body spacing loaded
+    int fighterAnimation = 3; ///< Stance animation of the hand fighter
+
+    //Attack counters of this fighter
+    float jumpFactor = 10;      ///< Height gained or lost per step of a jump
+    float g;                    ///< Kick counter
+    float punchCounter;         ///< Punch and double punch counter
+    float tornadoCounter;       ///< Tornado counter
+
+    bool punchStop[2] = {false, false};
+    bool punch2Stop[2] = {false,false};
+    bool kickStop[2]= {false, false};
+    bool tornadoStop[2] = {false, false};
+    bool step[2] = {false, false};
+    bool moveForwards[2] = {false, false};
+    bool moveBackwards[2] = {false, false};
+    bool jump[2] = {false, false};
+    bool jumpStop[2] = {false, false};
+    int boxActive = 0;  ///< Bit per box of this fighter's moves that is out this step
+    int hitLanded = 0;  ///< Bit per move that has landed since its boxes came out
+
+    float fighterX[2] = {-18, 18};
+    float fighterY[2] = {9.5, 9.5};//Legacy from original stupid non animated fighter, never got the jump function to work though
+    float fighterHeight[2] = {0, 0};//Hopefully will help keep track of the animated fighter's hight for jumping animations
+    float fighterHP[2] = {75.0, 75.0};
+    int fighterDir[2] = {1, -1};
+    float rotations[FIGHTER_LIMBS][3]; ///< Value of the rotations made by this fighter's limbs, see setRotations
+    bool attacking[2] = {false, false};
+    bool punch[2] = {false, false};
+    bool punch2[2] = {false, false};
+    bool kick[2] = {false, false};
+    bool tornado[2] = {false, false};
+    bool fighterStun[2] = {false,false};
+    bool fighterDown[2] = {false,false};
+    float stunCounter[2] = {15, 15};
+};
+
+static_assert(std::is_trivially_copyable<FighterState>::value, "FighterState must stay a plain copyable struct");
+
+/**
+\class FighterCore
+
+\brief The combat rules of a fighter with no graphics or sound, movement, attacks,
+hit checks, stun and HP.
+
+Everything the game needs to simulate a fight lives here so it can run headless, for
+the simulation thread and for benchmarks and balance sweeps.  Fighter adds the sound
+effects on top by overriding onHit.
+
+*/
+
+class FighterCore : protected FighterState
+{
+private:
+    const FighterTable* table;   ///< Fighter definitions, not owned.
+
+    int addNum[2] = {0, 12};
+
+    void resetCounters();
+
+protected:
+    virtual void onHit(int hitType);
+
+public:
+    FighterCore();
+    virtual ~FighterCore();
+
+    //Public vars (needs access in GE)
+    using FighterState::fighterX;
+    using FighterState::fighterY;
+    using FighterState::fighterHeight;
+    using FighterState::fighterHP;
+    using FighterState::fighterDir;
+    using FighterState::rotations;
+    using FighterState::attacking;
+    using FighterState::punch;
+    using FighterState::punch2;
+    using FighterState::kick;
+    using FighterState::tornado;
+    using FighterState::fighterStun;
+    using FighterState::fighterDown;
+    using FighterState::stunCounter;
+    float scales[12];    ///< Not intending on keeping
+    bool quiet;          ///< Set while ticks are simulated again in a rollback, so hits that already played are not heard twice
+
+    //Fighter Functions
+    void newFighter(int fiNum, int fiId);   ///< Sets what player is using this fighter, and what fighter they are using
+    void oppTracker(int oppNum, int oppID, float oppX, float oppY, bool oppAttacking, bool oppKick, bool oppPunch, bool oppPunch2, bool oppTor, bool oppStun);
+    void fighterMoveX(int fighterNum, bool forw, bool backw);
+    void fighterJump(int fighterNum);
+    void markBoxes(int move, float counter);
+    void addBoxes(HitWorld& world) const;
+    void landHit(int move);
+    void punchNow(int fighterNum);
+    void kickNow(int fighterNum);
+    void tornadoNow(int fighterNum);
+    void readyStance(int fighterNum);
+    void updateHP(int fighterNum, float value);
+    void preformActions();
+    void tposeStance(int fighterNum);
+    //Animation Modifiers
+    void addRotations(int limb, int axis, float val);
+    void setRotations(int limb, int axis, float val);
+    void addScales(int, float);
+
+    //Swaps the animation for a specific mesh, will update more
+    void swapAnimation(int index);
+    int getFighterAnimation();
+    void setFighterID(int fiID, int rivID);
+
+    void setTable(const FighterTable* t);
+
+    //Rollback
+    void saveState(FighterState& st) const;
+    void loadState(const FighterState& st);
+
+    static void stepPair(FighterCore& f0, FighterCore& f1, const int fiIndex[2], HitWorld& world);
+};
+#endif // FIGHTERCORE_H_INCLUDED
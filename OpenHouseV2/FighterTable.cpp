@@ -0,0 +1,527 @@
+#include "FighterTable.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <iostream>
+
+/**
+\file FighterTable.cpp
+\brief Loading and reloading of the fighter definition files.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+static const char* animNames[ANIM_SLOTS] = {"stance", "walk", "stun", "punch", "kick", "special", "block", "jump"};
+static const char* moveNames[FIGHT_HIT_MOVES] = {"punch", "double", "kick", "knee", "special"};
+
+/**
+\brief Returns the change time of a file, 0 if it can not be read.
+
+\param path --- The file.
+
+*/
+
+static time_t fileChangeTime(const std::string& path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+        return 0;
+    return st.st_mtime;
+}
+
+/**
+\brief Reads the numbers left on a line being split by strtok.
+
+\param values --- Array to fill.
+\param n --- Numbers wanted, exactly this many must be there.
+
+\return False if there are too few or too many or one is not a number.
+
+*/
+
+static bool readNumbers(float* values, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        char* tok = strtok(NULL, " \t\r\n");
+        if (!tok)
+            return false;
+
+        char* end;
+        values[i] = strtof(tok, &end);
+        if (*end != '\0')
+            return false;
+    }
+    return strtok(NULL, " \t\r\n") == NULL;
+}
+
+/**
+\brief Returns the move with a name, for hitboxes and hurtboxes.
+
+\param tok --- The name, may be NULL.
+
+\return One of FightHit, or -1 if it is not a move.
+
+*/
+
+static int findMove(const char* tok)
+{
+    for (int m = 0; tok && m < FIGHT_HIT_MOVES; m++)
+    {
+        if (strcmp(tok, moveNames[m]) == 0)
+            return m;
+    }
+    return -1;
+}
+
+/**
+\brief Constructor, an empty table.
+
+*/
+
+FighterTable::FighterTable()
+{
+    clear();
+}
+
+/**
+\brief Empties the table, every fighter is set to the defaults of a file that leaves
+settings out.
+
+*/
+
+void FighterTable::clear()
+{
+    count = 0;
+    listTime = 0;
+    for (int id = 0; id < FIGHTER_MAX; id++)
+    {
+        files[id] = "";
+        fileTime[id] = 0;
+        body[id] = 0;
+        for (int a = 0; a < ATTACK_COUNT; a++)
+            damage[a][id] = 0;
+        for (int c = 0; c < FRAMES_COUNT; c++)
+            frames[c][id] = 0;
+        kickStep[id] = 0;
+        specialStep[id] = 0;
+        specialEnd[id] = 0;
+        spin[id] = false;
+        doublePunch[id] = false;
+        boxCount[id] = 0;
+        for (int b = 0; b < FIGHTER_BOXES; b++)
+        {
+            boxMove[b][id] = -1;
+            boxHits[b][id] = false;
+            boxFrom[b][id] = 0;
+            boxTo[b][id] = 0;
+            for (int a = 0; a < 2; a++)
+            {
+                boxMin[a][b][id] = 0;
+                boxMax[a][b][id] = 0;
+            }
+        }
+        for (int s = 0; s < ANIM_SLOTS; s++)
+            anim[s][id] = 0;
+        selectable[id] = false;
+
+        look[id] = LOOK_NONE;
+        scale[id] = 1;
+        base[id] = 0;
+        followJump[id] = false;
+        name[id] = "";
+        mesh[id] = "";
+    }
+}
+
+/**
+\brief Loads the fighter list and every fighter in it, replacing the table.
+
+Fighter files are found relative to the list.  On any error the file and line are
+printed and the table is left empty.
+
+\param list --- Path of the list file.
+
+\return False if a file could not be read or had an error.
+
+*/
+
+bool FighterTable::load(const std::string& list)
+{
+    clear();
+    listPath = list;
+    listTime = fileChangeTime(list);
+
+    FILE* fp = fopen(list.c_str(), "r");
+    if (!fp)
+    {
+        std::cerr << "Could not open fighter list " << list << std::endl;
+        return false;
+    }
+
+    std::string dir;
+    size_t slash = list.find_last_of("/\\");
+    if (slash != std::string::npos)
+        dir = list.substr(0, slash + 1);
+
+    char line[512];
+    int lineNum = 0;
+    bool ok = true;
+    while (ok && fgets(line, sizeof(line), fp))
+    {
+        lineNum++;
+        char* hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+
+        char* tok = strtok(line, " \t\r\n");
+        if (!tok)
+            continue;
+
+        if (count >= FIGHTER_MAX)
+        {
+            std::cerr << list << ":" << lineNum << ": more than " << FIGHTER_MAX << " fighters" << std::endl;
+            ok = false;
+        }
+        else
+        {
+            files[count] = dir + tok;
+            fileTime[count] = fileChangeTime(files[count]);
+            ok = loadFighter(count, files[count]);
+            count++;
+        }
+    }
+    fclose(fp);
+
+    if (ok && count == 0)
+    {
+        std::cerr << list << ": no fighters" << std::endl;
+        ok = false;
+    }
+    if (!ok)
+    {
+        clear();
+        listPath = list;
+    }
+    return ok;
+}
+
+/**
+\brief Reads one fighter file into a column of the table.
+
+\param id --- Fighter ID to fill.
+\param path --- The fighter file.
+
+\return False on an error, which is printed with its line.
+
+*/
+
+bool FighterTable::loadFighter(int id, const std::string& path)
+{
+    FILE* fp = fopen(path.c_str(), "r");
+    if (!fp)
+    {
+        std::cerr << "Could not open fighter file " << path << std::endl;
+        return false;
+    }
+
+    // Everything the fight rules need must be given, drawing has defaults.
+    bool haveBody = false;
+    bool haveHurt = false;
+    bool haveDamage = false;
+    bool haveFrames = false;
+    bool haveKick = false;
+    bool haveSpecial = false;
+
+    char line[512];
+    int lineNum = 0;
+    const char* error = NULL;
+    while (!error && fgets(line, sizeof(line), fp))
+    {
+        lineNum++;
+        char* hash = strchr(line, '#');
+        if (hash)
+            *hash = '\0';
+
+        char* key = strtok(line, " \t\r\n");
+        if (!key)
+            continue;
+
+        float v[ATTACK_COUNT];
+        if (strcmp(key, "name") == 0)
+        {
+            char* rest = strtok(NULL, "\r\n");
+            std::string text = rest ? rest : "";
+            size_t first = text.find_first_not_of(" \t");
+            if (first == std::string::npos)
+                error = "name is empty";
+            else
+                name[id] = text.substr(first, text.find_last_not_of(" \t") - first + 1);
+        }
+        else if (strcmp(key, "look") == 0)
+        {
+            char* kind = strtok(NULL, " \t\r\n");
+            char* file = strtok(NULL, " \t\r\n");
+            if (kind && strcmp(kind, "none") == 0 && !file)
+                look[id] = LOOK_NONE;
+            else if (kind && strcmp(kind, "limbs") == 0 && !file)
+                look[id] = LOOK_LIMBS;
+            else if (kind && strcmp(kind, "skinned") == 0 && file)
+            {
+                look[id] = LOOK_SKINNED;
+                mesh[id] = file;
+            }
+            else
+                error = "look must be none, limbs or skinned <mesh file>";
+        }
+        else if (strcmp(key, "scale") == 0)
+        {
+            if (!readNumbers(v, 1) || v[0] <= 0)
+                error = "scale needs one number above 0";
+            else
+                scale[id] = v[0];
+        }
+        else if (strcmp(key, "base") == 0)
+        {
+            if (!readNumbers(v, 1))
+                error = "base needs one number";
+            else
+                base[id] = v[0];
+        }
+        else if (strcmp(key, "jump") == 0 || strcmp(key, "select") == 0 || strcmp(key, "double") == 0)
+        {
+            if (!readNumbers(v, 1) || (v[0] != 0 && v[0] != 1))
+                error = "jump, select and double need 0 or 1";
+            else if (key[0] == 'j')
+                followJump[id] = v[0] == 1;
+            else if (key[0] == 's')
+                selectable[id] = v[0] == 1;
+            else
+                doublePunch[id] = v[0] == 1;
+        }
+        else if (strcmp(key, "body") == 0)
+        {
+            if (!readNumbers(v, 1) || v[0] < 0)
+                error = "body needs one number, 0 or more";
+            else
+            {
+                body[id] = v[0];
+                haveBody = true;
+            }
+        }
+        else if (strcmp(key, "damage") == 0)
+        {
+            if (!readNumbers(v, ATTACK_COUNT))
+                error = "damage needs punch, kick, special and bonus";
+            else
+            {
+                for (int a = 0; a < ATTACK_COUNT; a++)
+                    damage[a][id] = v[a];
+                haveDamage = true;
+            }
+        }
+        else if (strcmp(key, "frames") == 0)
+        {
+            if (!readNumbers(v, FRAMES_COUNT))
+                error = "frames needs punch, tornado and kick";
+            else
+            {
+                for (int c = 0; c < FRAMES_COUNT; c++)
+                    frames[c][id] = (int)v[c];
+                haveFrames = true;
+            }
+        }
+        else if (strcmp(key, "kick") == 0)
+        {
+            if (!readNumbers(v, 1) || v[0] <= 0)
+                error = "kick needs a step above 0";
+            else
+            {
+                kickStep[id] = v[0];
+                haveKick = true;
+            }
+        }
+        else if (strcmp(key, "special") == 0)
+        {
+            char* first = strtok(NULL, " \t\r\n");
+            if (first && strcmp(first, "spin") == 0)
+            {
+                spin[id] = strtok(NULL, " \t\r\n") == NULL;
+                haveSpecial = spin[id];
+            }
+            else if (first)
+            {
+                char* end;
+                v[0] = strtof(first, &end);
+                haveSpecial = *end == '\0' && v[0] > 0 && readNumbers(v + 1, 1);
+                if (haveSpecial)
+                {
+                    specialStep[id] = v[0];
+                    specialEnd[id] = v[1];
+                }
+            }
+
+            if (!haveSpecial)
+                error = "special needs spin, or a step above 0 and the value it ends on";
+        }
+        else if (strcmp(key, "hurt") == 0 || strcmp(key, "hit") == 0)
+        {
+            bool hits = key[1] == 'i';
+            char* first = strtok(NULL, " \t\r\n");
+            int move = findMove(first);
+
+            // from to x0 y0 x1 y1, with no move the token already split off is x0.
+            float box[6] = {0, 0, 0, 0, 0, 0};
+            float* corners = box + 2;
+            bool ok = false;
+            if (move >= 0)
+                ok = readNumbers(box, 6) && box[0] <= box[1];
+            else if (!hits && first)
+            {
+                char* end;
+                corners[0] = strtof(first, &end);
+                ok = *end == '\0' && readNumbers(corners + 1, 3);
+            }
+
+            if (!ok || corners[0] > corners[2] || corners[1] > corners[3])
+                error = hits ? "hit needs a move, from and to, then x0 y0 x1 y1 with x0 <= x1 and y0 <= y1"
+                             : "hurt needs x0 y0 x1 y1 with x0 <= x1 and y0 <= y1, a move, from and to may go first";
+            else if (boxCount[id] >= FIGHTER_BOXES)
+                error = "too many hit and hurt boxes";
+            else
+            {
+                int b = boxCount[id]++;
+                boxMove[b][id] = move;
+                boxHits[b][id] = hits;
+                boxFrom[b][id] = box[0];
+                boxTo[b][id] = box[1];
+                boxMin[0][b][id] = corners[0];
+                boxMin[1][b][id] = corners[1];
+                boxMax[0][b][id] = corners[2];
+                boxMax[1][b][id] = corners[3];
+                haveHurt = haveHurt || !hits;
+            }
+        }
+        else if (strcmp(key, "anim") == 0)
+        {
+            char* slotName = strtok(NULL, " \t\r\n");
+            int slot = 0;
+            while (slot < ANIM_SLOTS && (!slotName || strcmp(slotName, animNames[slot]) != 0))
+                slot++;
+
+            if (slot == ANIM_SLOTS)
+                error = "anim needs a slot, stance walk stun punch kick special block or jump";
+            else if (!readNumbers(v, 1) || v[0] < 0)
+                error = "anim needs a clip number, 0 or more";
+            else
+                anim[slot][id] = (int)v[0];
+        }
+        else
+            error = "unknown setting";
+    }
+    fclose(fp);
+
+    if (error)
+    {
+        std::cerr << path << ":" << lineNum << ": " << error << std::endl;
+        return false;
+    }
+    if (!haveBody || !haveHurt || !haveDamage || !haveFrames || !haveKick || !haveSpecial)
+    {
+        std::cerr << path << ": body, damage, frames, kick, special and a hurt box must all be given" << std::endl;
+        return false;
+    }
+    if (name[id].empty())
+        name[id] = path;
+    return true;
+}
+
+/**
+\brief Returns true if the list or one of the fighter files has changed since the
+table was loaded.
+
+Only looks at file times, cheap enough to call about once a second.
+
+*/
+
+bool FighterTable::changed()
+{
+    if (listPath.empty())
+        return false;
+    if (fileChangeTime(listPath) != listTime)
+        return true;
+    for (int id = 0; id < count; id++)
+    {
+        if (fileChangeTime(files[id]) != fileTime[id])
+            return true;
+    }
+    return false;
+}
+
+/**
+\brief Loads the files again if they changed, for tuning fighters while the game runs.
+
+If the new files have an error, or have fewer fighters than before, which could leave
+a fighter in use without a definition, the table is kept as it was.  Fighters may be
+added.
+
+\return True if the table was replaced.
+
+*/
+
+bool FighterTable::reloadIfChanged()
+{
+    if (!changed())
+        return false;
+
+    FighterTable fresh;
+    bool ok = fresh.load(listPath);
+    if (ok && fresh.count < count)
+    {
+        std::cerr << listPath << ": fighters can not be removed while the game runs" << std::endl;
+        ok = false;
+    }
+
+    if (!ok)
+    {
+        // Not tried again until the files change once more.
+        listTime = fileChangeTime(listPath);
+        for (int id = 0; id < count; id++)
+            fileTime[id] = fileChangeTime(files[id]);
+        return false;
+    }
+
+    *this = fresh;
+    std::cout << "Reloaded " << count << " fighters from " << listPath << std::endl;
+    return true;
+}
+
+/**
+\brief Returns the next fighter that can be picked on the menu, wrapping around.
+
+\param id --- Fighter to start from.
+\param dir --- 1 for the next, -1 for the one before.
+
+\return The fighter, or id if no other can be picked.
+
+*/
+
+int FighterTable::nextSelectable(int id, int dir) const
+{
+    if (count <= 0)
+        return id;
+
+    int next = id;
+    for (int i = 0; i < count; i++)
+    {
+        next = ((next + dir) % count + count) % count;
+        if (selectable[next])
+            return next;
+    }
+    return id;
+}
@@ -0,0 +1,191 @@
+#ifndef FIGHTERTABLE_H_INCLUDED
+#define FIGHTERTABLE_H_INCLUDED
+
+#include <string>
+#include <time.h>
+
+/**
+\file FighterTable.h
+
+\brief Header file for FighterTable.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define FIGHTER_MAX 16                         ///< Most fighters a table holds.
+#define FIGHTER_LIST "Fighters/fighters.txt"   ///< List of fighter files the game loads, relative to the program.
+#define FIGHTER_BOXES 16                       ///< Most hitboxes and hurtboxes of one fighter.
+
+/**
+\brief Animation slots, what each fighter maps to a clip of its mesh.
+
+*/
+
+enum FighterAnim
+{
+    ANIM_STANCE,
+    ANIM_WALK,
+    ANIM_STUN,
+    ANIM_PUNCH,
+    ANIM_KICK,
+    ANIM_SPECIAL,
+    ANIM_BLOCK,
+    ANIM_JUMP,
+    ANIM_SLOTS
+};
+
+/**
+\brief Attacks, the columns of the damage table.  The bonus is the extra hit of a knee
+or double punch.
+
+*/
+
+enum FighterAttack
+{
+    ATTACK_PUNCH,
+    ATTACK_KICK,
+    ATTACK_SPECIAL,
+    ATTACK_BONUS,
+    ATTACK_COUNT
+};
+
+/**
+\brief Attack counters, the frame data of a fighter.  Each is where its counter rests
+between attacks and how far the attack runs.
+
+*/
+
+enum FighterFrames
+{
+    FRAMES_PUNCH,
+    FRAMES_TORNADO,
+    FRAMES_KICK,
+    FRAMES_COUNT
+};
+
+/**
+\brief Moves that can land a hit, what a hitbox belongs to and what FighterCore::onHit
+reports.
+
+*/
+
+enum FightHit
+{
+    FIGHT_HIT_PUNCH,
+    FIGHT_HIT_DOUBLE_PUNCH,
+    FIGHT_HIT_KICK,
+    FIGHT_HIT_KNEE,
+    FIGHT_HIT_TORNADO,
+    FIGHT_HIT_MOVES
+};
+
+/**
+\brief How the renderer draws a fighter.
+
+*/
+
+enum FighterLook
+{
+    LOOK_NONE,      ///< Not drawn.
+    LOOK_LIMBS,     ///< The original fighter made of obj limbs.
+    LOOK_SKINNED    ///< A skinned, animated mesh.
+};
+
+/**
+\class FighterTable
+
+\brief Every fighter's definition, read from text files so a fighter can be added or
+rebalanced without building the game again.
+
+FIGHTER_LIST names one file per fighter, in ID order.  A fighter file is one setting
+per line, # starts a comment:
+
+    name     Monday Memo
+    look     skinned Models/animTest/mondayMemo.fbx
+    scale    0.0008
+    base     0           # height the model stands at
+    jump     1           # 1 to follow the jump height in a fight
+    select   1           # 1 to be picked on the menu
+    body     6           # closest the fighters get, the larger of the two is used
+    damage   5 2.5 3.5 1.5   # punch kick special bonus
+    frames   225 0 0     # punch tornado kick counter rest values
+    kick     1           # kick counter step
+    special  1 75        # special counter step, and the counter value it ends on
+    double   0           # 1 if a punch can be followed by a second
+    anim     stance 5    # clip of the mesh for a slot, see FighterAnim
+    hurt     -3 0 3 10   # a box that can be hit, x0 y0 x1 y1
+    hit      kick 50 50  2 1 10 6   # a box that hits while the kick counter is 50 to 50
+
+The kick runs until its counter reaches 100.  "special spin" is the spin of the
+original fighter, which turns its limbs instead of playing a clip.
+
+Boxes are in fighter space, x forward from the middle of the fighter and y up from its
+feet, and are flipped and moved with the fighter each tick.  A hurtbox with no move is
+always there, "hurt move from to x0 y0 x1 y1" is one only out during part of a move.
+A hitbox belongs to a move, punch, double, kick, knee or special, and is out while
+that move runs and its counter is from to to: the punch counter counting down to 0
+for punch and double, the kick counter counting up to 100 for kick and knee, and the
+special counter, degrees turned for a spin, for special.  A move lands at most once
+each time its boxes come out, for the damage of its attack, knee and double for the
+bonus.
+
+Everything is parsed once into arrays of one field for every fighter, which is all the
+fight rules read each tick.  A table is only ever used by one thread, the game and the
+renderer each load their own.
+
+*/
+
+class FighterTable
+{
+private:
+    std::string listPath;                 ///< List file the table was loaded from.
+    std::string files[FIGHTER_MAX];       ///< Fighter files, for the change check.
+    time_t listTime;                      ///< Change time of the list file when loaded.
+    time_t fileTime[FIGHTER_MAX];         ///< Change times of the fighter files when loaded.
+
+    void clear();
+    bool loadFighter(int id, const std::string& path);
+
+public:
+    int count;                                  ///< Number of fighters, IDs are 0 to count - 1.
+
+    //Fight rules, read every tick
+    float body[FIGHTER_MAX];                    ///< Closest spacing to the rival.
+    float damage[ATTACK_COUNT][FIGHTER_MAX];    ///< HP each attack takes.
+    int frames[FRAMES_COUNT][FIGHTER_MAX];      ///< Attack counter rest values.
+    float kickStep[FIGHTER_MAX];                ///< Kick counter step per tick.
+    bool spin[FIGHTER_MAX];                     ///< The special is the limb spin.
+    float specialStep[FIGHTER_MAX];             ///< Special counter step per tick.
+    float specialEnd[FIGHTER_MAX];              ///< Special counter value the special ends on.
+    bool doublePunch[FIGHTER_MAX];              ///< A punch can be followed by a second.
+    int boxCount[FIGHTER_MAX];                  ///< Number of boxes.
+    int boxMove[FIGHTER_BOXES][FIGHTER_MAX];    ///< Move the box is out during, one of FightHit, -1 for always.
+    bool boxHits[FIGHTER_BOXES][FIGHTER_MAX];   ///< True for a hitbox, false for a hurtbox.
+    float boxFrom[FIGHTER_BOXES][FIGHTER_MAX];  ///< First move counter value the box is out on.
+    float boxTo[FIGHTER_BOXES][FIGHTER_MAX];    ///< Last move counter value the box is out on.
+    float boxMin[2][FIGHTER_BOXES][FIGHTER_MAX];///< Back bottom corner in fighter space, x and y.
+    float boxMax[2][FIGHTER_BOXES][FIGHTER_MAX];///< Front top corner in fighter space, x and y.
+    int anim[ANIM_SLOTS][FIGHTER_MAX];          ///< Mesh clip of each animation slot.
+    bool selectable[FIGHTER_MAX];               ///< Can be picked on the menu.
+
+    //Drawing
+    int look[FIGHTER_MAX];                      ///< One of FighterLook.
+    float scale[FIGHTER_MAX];                   ///< Scale of the mesh.
+    float base[FIGHTER_MAX];                    ///< Height the mesh stands at.
+    bool followJump[FIGHTER_MAX];               ///< Mesh rises with the jump height in a fight.
+    std::string name[FIGHTER_MAX];              ///< Display name.
+    std::string mesh[FIGHTER_MAX];              ///< Mesh file of a skinned fighter.
+
+    FighterTable();
+
+    bool load(const std::string& list);
+    bool changed();
+    bool reloadIfChanged();
+
+    int nextSelectable(int id, int dir) const;
+};
+
+#endif // FIGHTERTABLE_H_INCLUDED
@@ -0,0 +1,567 @@
+#include "FrameGrabber.h"
+#include "Profiler.h"
+
+#include "stb_image_write.h"
+
+#include <string.h>
+
+#include <iostream>
+
+/**
+\file FrameGrabber.cpp
+\brief Asynchronous screenshots and video recording through pixel pack buffers.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor, nothing is made until the first grab.
+
+*/
+
+FrameGrabber::FrameGrabber() : encoder(&FrameGrabber::encodeLoop, this)
+{
+    for (int i = 0; i < FG_PBO_COUNT; i++)
+    {
+        pbos[i] = 0;
+        fences[i] = NULL;
+        pboSize[i] = 0;
+        slotWidth[i] = 0;
+        slotHeight[i] = 0;
+        slotVideo[i] = false;
+    }
+    next = 0;
+    created = false;
+
+    recording = false;
+    videoWidth = 0;
+    videoHeight = 0;
+    videoFrames = 0;
+    dropped = 0;
+    stalls = 0;
+
+    launched = false;
+    quit = false;
+
+    video = NULL;
+    videoY4M = true;
+    videoRate = 60;
+    videoWritten = 0;
+    headerWritten = false;
+}
+
+/**
+\brief Destructor, finishes the encoding queue.  The OpenGL objects must already have
+been freed by release while the context was current.
+
+*/
+
+FrameGrabber::~FrameGrabber()
+{
+    if (launched)
+    {
+        {
+            std::lock_guard<std::mutex> guard(lock);
+            quit = true;
+        }
+        wake.notify_one();
+        encoder.wait();
+    }
+
+    for (size_t i = 0; i < queue.size(); i++)
+        delete queue[i];
+    for (size_t i = 0; i < pool.size(); i++)
+        delete pool[i];
+}
+
+/**
+\brief Saves the next frame grabbed to a png file.
+
+\param filename --- The png file.
+
+*/
+
+void FrameGrabber::screenshot(const std::string& filename)
+{
+    pendingShot = filename;
+}
+
+/**
+\brief Starts sending every frame grabbed to a video file.  A .y4m file is YUV4MPEG2
+4:2:0, anything else raw RGB24 frames top row first.  The size is the first frame's.
+
+\param filename --- The video file.
+\param fps --- Frame rate written to a YUV4MPEG2 header.
+
+\return False if already recording.
+
+*/
+
+bool FrameGrabber::startRecording(const std::string& filename, int fps)
+{
+    if (recording)
+        return false;
+
+    FrameGrabJob* job = takeJob();
+    job->kind = FG_VIDEO_START;
+    job->filename = filename;
+    job->width = fps;
+    job->height = 0;
+    submit(job, false);
+
+    recording = true;
+    videoWidth = 0;
+    videoHeight = 0;
+    videoFrames = 0;
+    dropped = 0;
+    stalls = 0;
+    return true;
+}
+
+/**
+\brief Stops recording once the frames already grabbed are written.
+
+*/
+
+void FrameGrabber::stopRecording()
+{
+    if (!recording)
+        return;
+
+    // Frames still reading back belong to the video, wait for them.
+    for (int i = 0; i < FG_PBO_COUNT; i++)
+        finish((next + i) % FG_PBO_COUNT, true);
+
+    recording = false;
+    FrameGrabJob* job = takeJob();
+    job->kind = FG_VIDEO_STOP;
+    job->width = (int)dropped;
+    job->height = (int)stalls;
+    submit(job, false);
+}
+
+/**
+\brief Returns true while frames are going to a video.
+
+*/
+
+bool FrameGrabber::isRecording()
+{
+    return recording;
+}
+
+/**
+\brief Takes a job from the pool, or makes one.
+
+*/
+
+FrameGrabJob* FrameGrabber::takeJob()
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!pool.empty())
+        {
+            FrameGrabJob* job = pool.back();
+            pool.pop_back();
+            return job;
+        }
+    }
+    return new FrameGrabJob();
+}
+
+/**
+\brief Queues a job for the encoding thread, starting the thread the first time.
+
+\param job --- The job, the encoding thread returns it to the pool.
+\param mayDrop --- The job is a video frame that may be dropped if the queue is full.
+
+*/
+
+void FrameGrabber::submit(FrameGrabJob* job, bool mayDrop)
+{
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        if (mayDrop && queue.size() >= FG_QUEUE_LIMIT)
+        {
+            dropped++;
+            pool.push_back(job);
+            return;
+        }
+        queue.push_back(job);
+    }
+
+    if (!launched)
+    {
+        launched = true;
+        encoder.launch();
+    }
+    wake.notify_one();
+}
+
+/**
+\brief Reads one frame that was grabbed from its buffer and hands it to the encoder.
+
+\param slot --- The buffer.
+\param wait --- Wait for the GPU if the read has not finished.
+
+\return True if the buffer is free now.
+
+*/
+
+bool FrameGrabber::finish(int slot, bool wait)
+{
+    if (!fences[slot])
+        return true;
+
+    GLenum status = glClientWaitSync(fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, wait ? 1000000000 : 0);
+    if (status == GL_TIMEOUT_EXPIRED && !wait)
+        return false;
+    glDeleteSync(fences[slot]);
+    fences[slot] = NULL;
+
+    int w = slotWidth[slot];
+    int h = slotHeight[slot];
+    size_t bytes = (size_t)w * h * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[slot]);
+    const unsigned char* data = (const unsigned char*)glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+    if (data)
+    {
+        if (!slotShot[slot].empty())
+        {
+            FrameGrabJob* job = takeJob();
+            job->kind = FG_PNG;
+            job->filename = slotShot[slot];
+            job->width = w;
+            job->height = h;
+            job->pixels.assign(data, data + bytes);
+            submit(job, false);
+        }
+        if (slotVideo[slot])
+        {
+            FrameGrabJob* job = takeJob();
+            job->kind = FG_VIDEO_FRAME;
+            job->width = w;
+            job->height = h;
+            job->pixels.assign(data, data + bytes);
+            submit(job, true);
+        }
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slotShot[slot].clear();
+    slotVideo[slot] = false;
+    return true;
+}
+
+/**
+\brief Hands every grabbed frame the GPU has finished reading to the encoder, oldest
+first so video frames stay in order.
+
+*/
+
+void FrameGrabber::collect()
+{
+    for (int i = 0; i < FG_PBO_COUNT; i++)
+        if (!finish((next + i) % FG_PBO_COUNT, false))
+            return;
+}
+
+/**
+\brief Starts reading the window if a screenshot is wanted or a video is recording, and
+passes on the frames whose reads have finished.  Call after the frame is drawn to the
+window and before it is displayed.
+
+\param width --- Width of the window.
+\param height --- Height of the window.
+
+*/
+
+void FrameGrabber::grab(int width, int height)
+{
+    PROFILE_SCOPE("frame grab");
+
+    if (created)
+        collect();
+
+    bool video = recording;
+    if (video && videoWidth == 0)
+    {
+        videoWidth = width;
+        videoHeight = height;
+    }
+    else if (video && (width != videoWidth || height != videoHeight))
+    {
+        std::cerr << "The window changed size, recording stopped." << std::endl;
+        stopRecording();
+        video = false;
+    }
+
+    if (pendingShot.empty() && !video)
+        return;
+    if (width <= 0 || height <= 0)
+        return;
+
+    if (!created)
+    {
+        glGenBuffers(FG_PBO_COUNT, pbos);
+        created = true;
+    }
+
+    // Every buffer is still reading, wait for the oldest.
+    int slot = next;
+    if (fences[slot])
+    {
+        stalls++;
+        finish(slot, true);
+    }
+
+    GLuint bytes = (GLuint)width * height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, pbos[slot]);
+    if (pboSize[slot] != bytes)
+    {
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, NULL, GL_STREAM_READ);
+        pboSize[slot] = bytes;
+    }
+
+    GLint readFbo = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFbo);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, 0);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, readFbo);
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    slotWidth[slot] = width;
+    slotHeight[slot] = height;
+    slotShot[slot] = pendingShot;
+    slotVideo[slot] = video;
+    if (video)
+        videoFrames++;
+    pendingShot.clear();
+    next = (next + 1) % FG_PBO_COUNT;
+}
+
+/**
+\brief Finishes the frames still reading, stops any recording and frees the buffers.
+Call while the context is current, before it is destroyed.
+
+*/
+
+void FrameGrabber::release()
+{
+    if (!created)
+        return;
+
+    if (recording)
+        stopRecording();
+    for (int i = 0; i < FG_PBO_COUNT; i++)
+        finish((next + i) % FG_PBO_COUNT, true);
+
+    glDeleteBuffers(FG_PBO_COUNT, pbos);
+    created = false;
+}
+
+/**
+\brief Returns the video frames of the current or last recording that were dropped.
+
+*/
+
+long long FrameGrabber::getDropped()
+{
+    return dropped;
+}
+
+/**
+\brief Returns the grabs of the current or last recording that waited for the GPU.
+
+*/
+
+long long FrameGrabber::getStalls()
+{
+    return stalls;
+}
+
+/**
+\brief Body of the encoding thread, runs the queued jobs in order until quit, then
+closes any video left open.
+
+*/
+
+void FrameGrabber::encodeLoop()
+{
+    while (true)
+    {
+        FrameGrabJob* job = NULL;
+        {
+            std::unique_lock<std::mutex> guard(lock);
+            wake.wait(guard, [this] { return !queue.empty() || quit; });
+            if (queue.empty())
+                break;
+            job = queue.front();
+            queue.pop_front();
+        }
+
+        encode(job);
+
+        std::lock_guard<std::mutex> guard(lock);
+        pool.push_back(job);
+    }
+
+    if (video)
+    {
+        fclose(video);
+        video = NULL;
+    }
+}
+
+/**
+\brief Runs one job on the encoding thread.
+
+\param job --- The job.
+
+*/
+
+void FrameGrabber::encode(FrameGrabJob* job)
+{
+    switch (job->kind)
+    {
+        case FG_PNG:
+            writePNG(job);
+            break;
+
+        case FG_VIDEO_START:
+            if (video)
+                fclose(video);
+            video = fopen(job->filename.c_str(), "wb");
+            if (!video)
+                std::cerr << "Could not open " << job->filename << " for writing." << std::endl;
+            videoY4M = job->filename.size() >= 4 && job->filename.compare(job->filename.size() - 4, 4, ".y4m") == 0;
+            videoName = job->filename;
+            videoRate = job->width > 0 ? job->width : 60;
+            videoWritten = 0;
+            headerWritten = false;
+            break;
+
+        case FG_VIDEO_FRAME:
+            writeVideoFrame(job);
+            break;
+
+        case FG_VIDEO_STOP:
+            if (video)
+            {
+                fclose(video);
+                video = NULL;
+                std::cout << "Saved " << videoName << ", " << videoWritten << " frames, " << job->width << " dropped, " << job->height
+                          << " waits for the GPU" << std::endl;
+            }
+            break;
+    }
+}
+
+/**
+\brief Saves a frame to a png file, flipped so the top row is first.
+
+\param job --- The frame.
+
+*/
+
+void FrameGrabber::writePNG(FrameGrabJob* job)
+{
+    int stride = job->width * 4;
+    scratch.resize((size_t)stride * job->height);
+    for (int y = 0; y < job->height; y++)
+        memcpy(&scratch[(size_t)y * stride], &job->pixels[(size_t)(job->height - 1 - y) * stride], stride);
+
+    if (stbi_write_png(job->filename.c_str(), job->width, job->height, 4, &scratch[0], stride))
+        std::cout << "Saved " << job->filename << std::endl;
+    else
+        std::cerr << "Could not save " << job->filename << std::endl;
+}
+
+/**
+\brief Appends a frame to the video, as YUV4MPEG2 4:2:0 in BT.601 studio range, or
+raw RGB24.  YUV4MPEG2 frames are cropped to even sizes.
+
+\param job --- The frame.
+
+*/
+
+void FrameGrabber::writeVideoFrame(FrameGrabJob* job)
+{
+    if (!video)
+        return;
+
+    int w = job->width;
+    int h = job->height;
+    const unsigned char* rgba = &job->pixels[0];
+
+    if (!videoY4M)
+    {
+        scratch.resize((size_t)w * h * 3);
+        unsigned char* out = &scratch[0];
+        for (int y = h - 1; y >= 0; y--)
+        {
+            const unsigned char* row = rgba + (size_t)y * w * 4;
+            for (int x = 0; x < w; x++)
+            {
+                *out++ = row[x * 4];
+                *out++ = row[x * 4 + 1];
+                *out++ = row[x * 4 + 2];
+            }
+        }
+        fwrite(&scratch[0], 1, scratch.size(), video);
+        videoWritten++;
+        return;
+    }
+
+    w &= ~1;
+    h &= ~1;
+    if (!headerWritten)
+    {
+        fprintf(video, "YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n", w, h, videoRate);
+        headerWritten = true;
+    }
+
+    size_t lumaSize = (size_t)w * h;
+    size_t chromaSize = lumaSize / 4;
+    scratch.resize(lumaSize + chromaSize * 2);
+    unsigned char* luma = &scratch[0];
+    unsigned char* cb = luma + lumaSize;
+    unsigned char* cr = cb + chromaSize;
+    int stride = job->width * 4;
+
+    // Output row y is OpenGL's row height - 1 - y, each 2x2 block shares its averaged chroma.
+    for (int y = 0; y < h; y += 2)
+    {
+        const unsigned char* row0 = rgba + (size_t)(job->height - 1 - y) * stride;
+        const unsigned char* row1 = row0 - stride;
+        for (int x = 0; x < w; x += 2)
+        {
+            int r = 0, g = 0, b = 0;
+            const unsigned char* p[4] = {row0 + x * 4, row0 + x * 4 + 4, row1 + x * 4, row1 + x * 4 + 4};
+            for (int k = 0; k < 4; k++)
+            {
+                int pr = p[k][0], pg = p[k][1], pb = p[k][2];
+                luma[(size_t)(y + k / 2) * w + x + k % 2] = (unsigned char)(((66 * pr + 129 * pg + 25 * pb + 128) >> 8) + 16);
+                r += pr;
+                g += pg;
+                b += pb;
+            }
+            r /= 4;
+            g /= 4;
+            b /= 4;
+            size_t c = (size_t)(y / 2) * (w / 2) + x / 2;
+            cb[c] = (unsigned char)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            cr[c] = (unsigned char)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+
+    fputs("FRAME\n", video);
+    fwrite(&scratch[0], 1, scratch.size(), video);
+    videoWritten++;
+}
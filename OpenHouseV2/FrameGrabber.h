@@ -0,0 +1,143 @@
+#ifndef FRAMEGRABBER_H_INCLUDED
+#define FRAMEGRABBER_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <SFML/System.hpp>
+
+#include <stdio.h>
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+\file FrameGrabber.h
+
+\brief Header file for FrameGrabber.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define FG_PBO_COUNT 3      ///< Frames that can be reading back at once.
+#define FG_QUEUE_LIMIT 8    ///< Frames waiting to be encoded before video frames are dropped.
+
+/**
+\brief Work for the encoding thread.
+
+*/
+
+enum FrameGrabJobKind
+{
+    FG_PNG,            ///< Save the pixels to a png file.
+    FG_VIDEO_START,    ///< Open a video file.
+    FG_VIDEO_FRAME,    ///< Append the pixels to the video.
+    FG_VIDEO_STOP      ///< Close the video file.
+};
+
+/**
+\brief A frame, or a video command, handed to the encoding thread.  Jobs are pooled so
+the pixel buffers are reused.
+
+*/
+
+struct FrameGrabJob
+{
+    int kind;                            ///< One of FrameGrabJobKind.
+    std::string filename;                ///< File of FG_PNG and FG_VIDEO_START.
+    int width;                           ///< Width of the pixels, or the frame rate of FG_VIDEO_START.
+    int height;                          ///< Height of the pixels.
+    std::vector<unsigned char> pixels;   ///< RGBA rows, bottom row first as OpenGL reads them.
+};
+
+/**
+\class FrameGrabber
+
+\brief Screenshots and video of the window without stalling the render thread.
+
+grab, called after the frame is drawn and before the swap, starts an asynchronous read
+of the window into one of a ring of pixel pack buffers and puts a fence after it.  A
+later frame maps the buffer once its fence has passed, so the CPU never waits for the
+GPU unless every buffer in the ring is still busy.  The pixels are copied into a pooled
+job and encoded on a thread of its own, screenshots to png with stb_image_write and
+recordings to a YUV4MPEG2 (.y4m) or raw RGB24 stream at the game's full frame rate.
+
+If the encoder falls behind, video frames past FG_QUEUE_LIMIT are dropped and counted,
+screenshots are never dropped.  Only the render thread may call anything but the
+destructor.
+
+*/
+
+class FrameGrabber
+{
+private:
+    GLuint pbos[FG_PBO_COUNT];          ///< Ring of pixel pack buffers.
+    GLsync fences[FG_PBO_COUNT];        ///< Fence after each buffer's read, NULL if it is free.
+    GLuint pboSize[FG_PBO_COUNT];       ///< Bytes each buffer is allocated with.
+    int slotWidth[FG_PBO_COUNT];        ///< Width of the frame read into each buffer.
+    int slotHeight[FG_PBO_COUNT];       ///< Height of the frame read into each buffer.
+    std::string slotShot[FG_PBO_COUNT]; ///< Screenshot file of each buffer's frame, empty for none.
+    bool slotVideo[FG_PBO_COUNT];       ///< The buffer's frame goes to the video.
+    int next;                           ///< Buffer the next frame is read into, the oldest.
+    bool created;                       ///< The buffers have been made.
+
+    std::string pendingShot;            ///< Screenshot asked for, taken by the next grab.
+    bool recording;                     ///< Frames are going to a video.
+    int videoWidth;                     ///< Size of the video, from its first frame, 0 before.
+    int videoHeight;                    ///< Height of the video.
+    long long videoFrames;              ///< Frames sent to the video.
+    long long dropped;                  ///< Video frames dropped because the encoder was behind.
+    long long stalls;                   ///< Grabs that had to wait for the GPU.
+
+    sf::Thread encoder;                 ///< Runs encodeLoop.
+    bool launched;                      ///< The encoding thread is running.
+    std::mutex lock;                    ///< Guards the queue, the pool and quit.
+    std::condition_variable wake;       ///< Signalled when a job is queued or quit is set.
+    std::deque<FrameGrabJob*> queue;    ///< Jobs for the encoding thread, in order.
+    std::vector<FrameGrabJob*> pool;    ///< Jobs done with, to reuse.
+    bool quit;                          ///< The encoding thread is to finish the queue and stop.
+
+    // Owned by the encoding thread.
+    FILE* video;                        ///< Video file being written.
+    std::string videoName;              ///< Name of the video file.
+    bool videoY4M;                      ///< The video is YUV4MPEG2, otherwise raw RGB24.
+    int videoRate;                      ///< Frames per second of the video.
+    long long videoWritten;             ///< Frames written to the video.
+    bool headerWritten;                 ///< The YUV4MPEG2 header is written.
+    std::vector<unsigned char> scratch; ///< Converted rows.
+
+    FrameGrabJob* takeJob();
+    void submit(FrameGrabJob* job, bool mayDrop);
+    bool finish(int slot, bool wait);
+    void collect();
+    void encodeLoop();
+    void encode(FrameGrabJob* job);
+    void writePNG(FrameGrabJob* job);
+    void writeVideoFrame(FrameGrabJob* job);
+
+public:
+    FrameGrabber();
+    ~FrameGrabber();
+
+    void screenshot(const std::string& filename);
+    bool startRecording(const std::string& filename, int fps);
+    void stopRecording();
+    bool isRecording();
+
+    void grab(int width, int height);
+    void release();
+
+    long long getDropped();
+    long long getStalls();
+};
+
+#endif // FRAMEGRABBER_H_INCLUDED
@@ -0,0 +1,892 @@
+#include "GLCapture.h"
+#include "ShaderCache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <iostream>
+
+/**
+\file GLCapture.cpp
+\brief Capture of the OpenGL calls of a frame, and the file the replayer reads.
+
+The file is an 8 byte "OHGLCAP1" tag, the width and height and the number of setup and
+frame calls as 32 bit integers, then each call: its op and payload size as 32 bit
+integers, its GLCAPTURE_ARGS 64 bit arguments and the payload.  Everything is in the
+byte order of the machine that captured it.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+bool GLCapture::recording = false;
+bool GLCapture::busy = false;
+std::string GLCapture::fileName;
+int GLCapture::width = 0;
+int GLCapture::height = 0;
+std::vector<GLCaptureCall> GLCapture::setup;
+std::vector<GLCaptureCall> GLCapture::frame;
+std::set<GLuint> GLCapture::known[GLCAP_OBJECT_COUNT];
+std::set<GLuint> GLCapture::knownPrograms;
+
+static std::vector<GLCaptureCall> startState;   ///< Calls that set the state at the start of the frame, after the setup.
+
+static const char captureTag[8] = {'O', 'H', 'G', 'L', 'C', 'A', 'P', '1'};   ///< Start of a capture file.
+
+/**
+\brief Appends a 32 bit integer to a program payload.
+
+\param out --- Payload.
+\param v --- Value.
+
+*/
+
+static void putInt(std::vector<unsigned char>& out, int v)
+{
+    unsigned char* p = (unsigned char*)&v;
+    out.insert(out.end(), p, p + sizeof(v));
+}
+
+/**
+\brief Appends a string, its length first, to a program payload.
+
+\param out --- Payload.
+\param s --- String.
+
+*/
+
+static void putString(std::vector<unsigned char>& out, const std::string& s)
+{
+    putInt(out, (int)s.size());
+    out.insert(out.end(), s.begin(), s.end());
+}
+
+/**
+\brief Starts capturing, the calls are recorded until end.
+
+The state at the start of the frame is copied here, with every object it refers to.
+
+\param filename --- File written by end.
+
+\return False if a capture is already running.
+
+*/
+
+bool GLCapture::begin(const std::string& filename)
+{
+    if (recording)
+        return false;
+
+    fileName = filename;
+    setup.clear();
+    frame.clear();
+    startState.clear();
+    for (int i = 0; i < GLCAP_OBJECT_COUNT; i++)
+        known[i].clear();
+    knownPrograms.clear();
+
+    recording = true;
+    busy = true;
+    copyStartState();
+    busy = false;
+    return true;
+}
+
+/**
+\brief Stops capturing and writes the file.
+
+\return True if the file was written.
+
+*/
+
+bool GLCapture::end()
+{
+    if (!recording)
+        return false;
+    recording = false;
+
+    FILE* f = fopen(fileName.c_str(), "wb");
+    if (!f)
+    {
+        std::cerr << "Could not open " << fileName << " for writing." << std::endl;
+        return false;
+    }
+
+    setup.insert(setup.end(), startState.begin(), startState.end());
+
+    unsigned int counts[4] = {(unsigned int)width, (unsigned int)height, (unsigned int)setup.size(), (unsigned int)frame.size()};
+    fwrite(captureTag, 1, sizeof(captureTag), f);
+    fwrite(counts, sizeof(counts[0]), 4, f);
+
+    for (int s = 0; s < 2; s++)
+    {
+        const std::vector<GLCaptureCall>& calls = s == 0 ? setup : frame;
+        for (size_t i = 0; i < calls.size(); i++)
+        {
+            unsigned int head[2] = {calls[i].op, (unsigned int)calls[i].payload.size()};
+            fwrite(head, sizeof(head[0]), 2, f);
+            fwrite(calls[i].args, sizeof(calls[i].args[0]), GLCAPTURE_ARGS, f);
+            if (!calls[i].payload.empty())
+                fwrite(&calls[i].payload[0], 1, calls[i].payload.size(), f);
+        }
+    }
+
+    bool ok = !ferror(f);
+    fclose(f);
+
+    setup.clear();
+    frame.clear();
+    startState.clear();
+    return ok;
+}
+
+/**
+\brief Returns true if calls made now are recorded.
+
+*/
+
+bool GLCapture::isRecording()
+{
+    return recording && !busy;
+}
+
+/**
+\brief Appends a call to a list.
+
+\param calls --- List added to.
+\param op --- One of GLCaptureOp.
+\param args --- Arguments, the rest are zero.
+\param payload --- Data the call points to, NULL for none.
+\param size --- Bytes of data.
+
+*/
+
+void GLCapture::add(std::vector<GLCaptureCall>& calls, unsigned int op, std::initializer_list<unsigned long long> args,
+                    const void* payload, size_t size)
+{
+    calls.push_back(GLCaptureCall());
+    GLCaptureCall& c = calls.back();
+    c.op = op;
+    memset(c.args, 0, sizeof(c.args));
+
+    int i = 0;
+    for (std::initializer_list<unsigned long long>::const_iterator it = args.begin(); it != args.end() && i < GLCAPTURE_ARGS; ++it)
+        c.args[i++] = *it;
+
+    if (payload && size > 0)
+        c.payload.assign((const unsigned char*)payload, (const unsigned char*)payload + size);
+}
+
+/**
+\brief Records a call of the frame, from a hook after the call was made.
+
+An object the call binds for the first time is copied into the setup first.
+
+\param op --- One of GLCaptureOp.
+\param args --- Arguments, in the order OpenGL takes them.
+\param payload --- Data the call points to, NULL for none.
+\param size --- Bytes of data.
+
+*/
+
+void GLCapture::record(unsigned int op, std::initializer_list<unsigned long long> args, const void* payload, size_t size)
+{
+    if (!isRecording())
+        return;
+
+    const unsigned long long* a = args.begin();
+    busy = true;
+    switch (op)
+    {
+        case GLCAP_USE_PROGRAM:
+        case GLCAP_GET_UNIFORM_LOCATION:
+            copyProgram(a[0]);
+            break;
+        case GLCAP_BIND_VERTEX_ARRAY:
+            copyVertexArray(a[0]);
+            break;
+        case GLCAP_BIND_BUFFER:
+            copyBuffer(a[1]);
+            break;
+        case GLCAP_BIND_TEXTURE:
+            copyTexture(a[1], a[0]);
+            break;
+        case GLCAP_BIND_FRAMEBUFFER:
+            copyFramebuffer(a[1]);
+            break;
+        case GLCAP_BIND_RENDERBUFFER:
+            copyRenderbuffer(a[1]);
+            break;
+        case GLCAP_FRAMEBUFFER_TEXTURE_2D:
+            copyTexture(a[3], a[2] == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP);
+            break;
+        case GLCAP_FRAMEBUFFER_RENDERBUFFER:
+            copyRenderbuffer(a[3]);
+            break;
+        case GLCAP_BIND_BUFFER_BASE:
+        case GLCAP_TEX_BUFFER:
+            copyBuffer(a[2]);
+            break;
+        case GLCAP_UNIFORM_BLOCK_BINDING:
+            copyProgram(a[0]);
+            break;
+        default:
+            break;
+    }
+    busy = false;
+
+    add(frame, op, args, payload, size);
+}
+
+/**
+\brief Copies a buffer's contents into the setup, the first time it is seen.
+
+\param buffer --- Buffer name.
+
+*/
+
+void GLCapture::copyBuffer(GLuint buffer)
+{
+    if (buffer == 0 || !known[GLCAP_BUFFER].insert(buffer).second)
+        return;
+
+    GLint old = 0;
+    GLint size = 0;
+    GLint usage = GL_STATIC_DRAW;
+    glGetIntegerv(GL_COPY_READ_BUFFER_BINDING, &old);
+    glBindBuffer(GL_COPY_READ_BUFFER, buffer);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_SIZE, &size);
+    glGetBufferParameteriv(GL_COPY_READ_BUFFER, GL_BUFFER_USAGE, &usage);
+
+    std::vector<unsigned char> data(size);
+    if (size > 0)
+        glGetBufferSubData(GL_COPY_READ_BUFFER, 0, size, &data[0]);
+    glBindBuffer(GL_COPY_READ_BUFFER, old);
+
+    add(setup, GLCAP_CREATE, {GLCAP_BUFFER, buffer});
+    add(setup, GLCAP_BIND_BUFFER, {GL_COPY_WRITE_BUFFER, buffer});
+    if (size > 0)
+        add(setup, GLCAP_BUFFER_DATA, {GL_COPY_WRITE_BUFFER, (unsigned long long)size, (unsigned long long)usage}, &data[0], size);
+}
+
+/**
+\brief Copies a texture's parameters and level 0 images into the setup, the first time
+it is seen.  Mipmaps are generated again from level 0.  A buffer texture gets its
+buffer, with its contents, and format.
+
+\param texture --- Texture name.
+\param target --- GL_TEXTURE_2D, GL_TEXTURE_CUBE_MAP or GL_TEXTURE_BUFFER, other kinds
+are made empty.
+
+*/
+
+void GLCapture::copyTexture(GLuint texture, GLenum target)
+{
+    if (texture == 0 || !known[GLCAP_TEXTURE].insert(texture).second)
+        return;
+
+    add(setup, GLCAP_CREATE, {GLCAP_TEXTURE, texture});
+    GLint old = 0;
+    if (target == GL_TEXTURE_BUFFER)
+    {
+        GLint buffer = 0, internalFormat = 0;
+        glGetIntegerv(GL_TEXTURE_BINDING_BUFFER, &old);
+        glBindTexture(GL_TEXTURE_BUFFER, texture);
+        glGetTexLevelParameteriv(GL_TEXTURE_BUFFER, 0, GL_TEXTURE_BUFFER_DATA_STORE_BINDING, &buffer);
+        glGetTexLevelParameteriv(GL_TEXTURE_BUFFER, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+        glBindTexture(GL_TEXTURE_BUFFER, old);
+
+        copyBuffer(buffer);
+        add(setup, GLCAP_BIND_TEXTURE, {GL_TEXTURE_BUFFER, texture});
+        if (buffer)
+            add(setup, GLCAP_TEX_BUFFER, {GL_TEXTURE_BUFFER, (unsigned long long)internalFormat, (unsigned long long)buffer});
+        return;
+    }
+    if (target != GL_TEXTURE_2D && target != GL_TEXTURE_CUBE_MAP)
+        return;
+
+
+    glGetIntegerv(target == GL_TEXTURE_2D ? GL_TEXTURE_BINDING_2D : GL_TEXTURE_BINDING_CUBE_MAP, &old);
+    glBindTexture(target, texture);
+    add(setup, GLCAP_BIND_TEXTURE, {target, texture});
+
+    const GLenum params[5] = {GL_TEXTURE_MIN_FILTER, GL_TEXTURE_MAG_FILTER, GL_TEXTURE_WRAP_S, GL_TEXTURE_WRAP_T, GL_TEXTURE_WRAP_R};
+    GLint minFilter = GL_LINEAR;
+    for (int i = 0; i < 5; i++)
+    {
+        GLint v = 0;
+        glGetTexParameteriv(target, params[i], &v);
+        add(setup, GLCAP_TEX_PARAMETER_I, {target, params[i], (unsigned long long)v});
+        if (params[i] == GL_TEXTURE_MIN_FILTER)
+            minFilter = v;
+    }
+
+    int faces = target == GL_TEXTURE_CUBE_MAP ? 6 : 1;
+    for (int i = 0; i < faces; i++)
+    {
+        GLenum face = target == GL_TEXTURE_CUBE_MAP ? GL_TEXTURE_CUBE_MAP_POSITIVE_X + i : GL_TEXTURE_2D;
+        GLint w = 0, h = 0, internalFormat = 0;
+        glGetTexLevelParameteriv(face, 0, GL_TEXTURE_WIDTH, &w);
+        glGetTexLevelParameteriv(face, 0, GL_TEXTURE_HEIGHT, &h);
+        glGetTexLevelParameteriv(face, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat);
+        if (w <= 0 || h <= 0)
+            continue;
+
+        // Four bytes a texel whatever the format, depth as floats and colors as 8 bit RGBA.
+        GLenum format = GL_RGBA;
+        GLenum type = GL_UNSIGNED_BYTE;
+        if (internalFormat == GL_DEPTH_STENCIL || internalFormat == GL_DEPTH24_STENCIL8)
+        {
+            format = GL_DEPTH_STENCIL;
+            type = GL_UNSIGNED_INT_24_8;
+        }
+        else if (internalFormat == GL_DEPTH_COMPONENT || internalFormat == GL_DEPTH_COMPONENT16 ||
+                 internalFormat == GL_DEPTH_COMPONENT24 || internalFormat == GL_DEPTH_COMPONENT32F)
+        {
+            format = GL_DEPTH_COMPONENT;
+            type = GL_FLOAT;
+        }
+
+        std::vector<unsigned char> pixels((size_t)w * h * 4);
+        glPixelStorei(GL_PACK_ALIGNMENT, 4);
+        glGetTexImage(face, 0, format, type, &pixels[0]);
+        add(setup, GLCAP_TEX_IMAGE_2D, {face, 0, (unsigned long long)internalFormat, (unsigned long long)w, (unsigned long long)h, 0, format, type},
+            &pixels[0], pixels.size());
+    }
+
+    if (minFilter != GL_NEAREST && minFilter != GL_LINEAR)
+        add(setup, GLCAP_GENERATE_MIPMAP, {target});
+
+    glBindTexture(target, old);
+}
+
+/**
+\brief Copies a vertex array's attribute layout into the setup, with the buffers it
+uses, the first time it is seen.
+
+\param vao --- Vertex array name.
+
+*/
+
+void GLCapture::copyVertexArray(GLuint vao)
+{
+    if (vao == 0 || !known[GLCAP_VERTEX_ARRAY].insert(vao).second)
+        return;
+
+    struct Attrib
+    {
+        GLint enabled, size, type, normalized, stride, buffer, integer;
+        void* pointer;
+    };
+
+    GLint old = 0;
+    GLint maxAttribs = 0;
+    GLint elements = 0;
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &old);
+    glGetIntegerv(GL_MAX_VERTEX_ATTRIBS, &maxAttribs);
+    if (maxAttribs > 16)
+        maxAttribs = 16;
+
+    glBindVertexArray(vao);
+    std::vector<Attrib> attribs(maxAttribs);
+    for (int i = 0; i < maxAttribs; i++)
+    {
+        Attrib& a = attribs[i];
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_ENABLED, &a.enabled);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_SIZE, &a.size);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_TYPE, &a.type);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_NORMALIZED, &a.normalized);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_STRIDE, &a.stride);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_BUFFER_BINDING, &a.buffer);
+        glGetVertexAttribiv(i, GL_VERTEX_ATTRIB_ARRAY_INTEGER, &a.integer);
+        glGetVertexAttribPointerv(i, GL_VERTEX_ATTRIB_ARRAY_POINTER, &a.pointer);
+    }
+    glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elements);
+    glBindVertexArray(old);
+
+    for (int i = 0; i < maxAttribs; i++)
+        copyBuffer(attribs[i].buffer);
+    copyBuffer(elements);
+
+    add(setup, GLCAP_CREATE, {GLCAP_VERTEX_ARRAY, vao});
+    add(setup, GLCAP_BIND_VERTEX_ARRAY, {vao});
+    for (int i = 0; i < maxAttribs; i++)
+    {
+        const Attrib& a = attribs[i];
+        if (a.buffer == 0)
+            continue;
+
+        add(setup, GLCAP_BIND_BUFFER, {GL_ARRAY_BUFFER, (unsigned long long)a.buffer});
+        if (a.integer)
+            add(setup, GLCAP_VERTEX_ATTRIB_I_POINTER, {(unsigned long long)i, (unsigned long long)a.size, (unsigned long long)a.type,
+                                                       (unsigned long long)a.stride, (unsigned long long)(size_t)a.pointer});
+        else
+            add(setup, GLCAP_VERTEX_ATTRIB_POINTER, {(unsigned long long)i, (unsigned long long)a.size, (unsigned long long)a.type,
+                                                     (unsigned long long)a.normalized, (unsigned long long)a.stride,
+                                                     (unsigned long long)(size_t)a.pointer});
+        if (a.enabled)
+            add(setup, GLCAP_ENABLE_VERTEX_ATTRIB_ARRAY, {(unsigned long long)i});
+    }
+    if (elements)
+        add(setup, GLCAP_BIND_BUFFER, {GL_ELEMENT_ARRAY_BUFFER, (unsigned long long)elements});
+    add(setup, GLCAP_BIND_VERTEX_ARRAY, {0});
+}
+
+/**
+\brief Copies a framebuffer's attachments into the setup, with the textures and
+renderbuffers attached, the first time it is seen.
+
+\param fbo --- Framebuffer name, 0 is the window's and is never copied.
+
+*/
+
+void GLCapture::copyFramebuffer(GLuint fbo)
+{
+    if (fbo == 0 || !known[GLCAP_FRAMEBUFFER].insert(fbo).second)
+        return;
+
+    const GLenum attachments[6] = {GL_COLOR_ATTACHMENT0, GL_COLOR_ATTACHMENT1, GL_COLOR_ATTACHMENT2, GL_COLOR_ATTACHMENT3,
+                                   GL_DEPTH_ATTACHMENT, GL_STENCIL_ATTACHMENT};
+    GLint type[6], name[6], level[6], face[6];
+
+    GLint old = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &old);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    for (int i = 0; i < 6; i++)
+    {
+        type[i] = GL_NONE;
+        name[i] = level[i] = face[i] = 0;
+        glGetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, attachments[i], GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &type[i]);
+        if (type[i] == GL_NONE)
+            continue;
+        glGetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, attachments[i], GL_FRAMEBUFFER_ATTACHMENT_OBJECT_NAME, &name[i]);
+        if (type[i] == GL_TEXTURE)
+        {
+            glGetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, attachments[i], GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_LEVEL, &level[i]);
+            glGetFramebufferAttachmentParameteriv(GL_READ_FRAMEBUFFER, attachments[i], GL_FRAMEBUFFER_ATTACHMENT_TEXTURE_CUBE_MAP_FACE, &face[i]);
+        }
+    }
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, old);
+
+    for (int i = 0; i < 6; i++)
+        if (type[i] == GL_TEXTURE)
+            copyTexture(name[i], face[i] ? GL_TEXTURE_CUBE_MAP : GL_TEXTURE_2D);
+        else if (type[i] == GL_RENDERBUFFER)
+            copyRenderbuffer(name[i]);
+
+    add(setup, GLCAP_CREATE, {GLCAP_FRAMEBUFFER, fbo});
+    add(setup, GLCAP_BIND_FRAMEBUFFER, {GL_FRAMEBUFFER, fbo});
+    for (int i = 0; i < 6; i++)
+        if (type[i] == GL_TEXTURE)
+            add(setup, GLCAP_FRAMEBUFFER_TEXTURE_2D, {GL_FRAMEBUFFER, attachments[i], face[i] ? (unsigned long long)face[i] : GL_TEXTURE_2D,
+                                                      (unsigned long long)name[i], (unsigned long long)level[i]});
+        else if (type[i] == GL_RENDERBUFFER)
+            add(setup, GLCAP_FRAMEBUFFER_RENDERBUFFER, {GL_FRAMEBUFFER, attachments[i], GL_RENDERBUFFER, (unsigned long long)name[i]});
+    add(setup, GLCAP_BIND_FRAMEBUFFER, {GL_FRAMEBUFFER, 0});
+}
+
+/**
+\brief Copies a renderbuffer's storage settings into the setup, the first time it is seen.
+
+\param rbo --- Renderbuffer name.
+
+*/
+
+void GLCapture::copyRenderbuffer(GLuint rbo)
+{
+    if (rbo == 0 || !known[GLCAP_RENDERBUFFER].insert(rbo).second)
+        return;
+
+    GLint old = 0, w = 0, h = 0, internalFormat = 0, samples = 0;
+    glGetIntegerv(GL_RENDERBUFFER_BINDING, &old);
+    glBindRenderbuffer(GL_RENDERBUFFER, rbo);
+    glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_WIDTH, &w);
+    glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_HEIGHT, &h);
+    glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_INTERNAL_FORMAT, &internalFormat);
+    glGetRenderbufferParameteriv(GL_RENDERBUFFER, GL_RENDERBUFFER_SAMPLES, &samples);
+    glBindRenderbuffer(GL_RENDERBUFFER, old);
+
+    add(setup, GLCAP_CREATE, {GLCAP_RENDERBUFFER, rbo});
+    add(setup, GLCAP_BIND_RENDERBUFFER, {GL_RENDERBUFFER, rbo});
+    if (w > 0 && h > 0)
+        add(setup, GLCAP_RENDERBUFFER_STORAGE_MULTISAMPLE, {GL_RENDERBUFFER, (unsigned long long)samples, (unsigned long long)internalFormat,
+                                                            (unsigned long long)w, (unsigned long long)h});
+}
+
+/**
+\brief Copies a program into the setup, the first time it is seen: its shader sources,
+attribute and uniform locations, then the value of each uniform.
+
+The payload of GLCAP_CREATE_PROGRAM is the shader count, then the type and source of
+each, the attribute count, then the location and name of each, and the uniform count,
+then the location and name of each.  Counts, types, locations and string lengths are
+32 bit integers.
+
+\param program --- Program name.
+
+*/
+
+void GLCapture::copyProgram(GLuint program)
+{
+    if (program == 0 || !knownPrograms.insert(program).second)
+        return;
+
+    std::vector<unsigned char> payload;
+
+    // Programs ShaderCache built have no shaders attached, it kept their code.
+    const std::vector<ShaderSource>* sources = ShaderCache::getSources(program);
+    if (sources)
+    {
+        putInt(payload, (int)sources->size());
+        for (size_t i = 0; i < sources->size(); i++)
+        {
+            putInt(payload, (*sources)[i].type);
+            putString(payload, (*sources)[i].code);
+        }
+    }
+    else
+    {
+        GLuint shaders[8];
+        GLsizei shaderCount = 0;
+        glGetAttachedShaders(program, 8, &shaderCount, shaders);
+        putInt(payload, shaderCount);
+        for (int i = 0; i < shaderCount; i++)
+        {
+            GLint type = 0, length = 0;
+            glGetShaderiv(shaders[i], GL_SHADER_TYPE, &type);
+            glGetShaderiv(shaders[i], GL_SHADER_SOURCE_LENGTH, &length);
+            std::string source(length > 0 ? length : 1, 0);
+            if (length > 0)
+                glGetShaderSource(shaders[i], length, &length, &source[0]);
+            source.resize(length);
+            putInt(payload, type);
+            putString(payload, source);
+        }
+    }
+
+    char name[256];
+    GLint count = 0;
+    glGetProgramiv(program, GL_ACTIVE_ATTRIBUTES, &count);
+    putInt(payload, count);
+    for (int i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveAttrib(program, i, sizeof(name), &length, &size, &type, name);
+        putInt(payload, glGetAttribLocation(program, name));
+        putString(payload, name);
+    }
+
+    // Each element of a uniform array is listed on its own, the replay finds it by name.
+    struct Uniform
+    {
+        GLint location;
+        GLenum type;
+    };
+    std::vector<Uniform> uniforms;
+    std::vector<unsigned char> uniformNames;
+    count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    for (int i = 0; i < count; i++)
+    {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, i, sizeof(name), &length, &size, &type, name);
+
+        std::string base = name;
+        if (size > 1 && base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0)
+            base.resize(base.size() - 3);
+
+        for (int k = 0; k < size; k++)
+        {
+            std::string element = size > 1 ? base + "[" + std::to_string(k) + "]" : base;
+            Uniform u;
+            u.location = glGetUniformLocation(program, element.c_str());
+            u.type = type;
+            if (u.location < 0)
+                continue;
+            putInt(uniformNames, u.location);
+            putString(uniformNames, element);
+            uniforms.push_back(u);
+        }
+    }
+    putInt(payload, (int)uniforms.size());
+    payload.insert(payload.end(), uniformNames.begin(), uniformNames.end());
+
+    add(setup, GLCAP_CREATE_PROGRAM, {program}, &payload[0], payload.size());
+    add(setup, GLCAP_USE_PROGRAM, {program});
+
+    for (size_t i = 0; i < uniforms.size(); i++)
+    {
+        const Uniform& u = uniforms[i];
+        GLfloat f[16];
+        GLint n[4];
+        switch (u.type)
+        {
+            case GL_FLOAT:
+            case GL_FLOAT_VEC2:
+            case GL_FLOAT_VEC3:
+            case GL_FLOAT_VEC4:
+            case GL_FLOAT_MAT2:
+            case GL_FLOAT_MAT3:
+            case GL_FLOAT_MAT4:
+                glGetUniformfv(program, u.location, f);
+                add(setup, GLCAP_UNIFORM_VALUE, {(unsigned long long)u.location, u.type, 1}, f, sizeof(f));
+                break;
+            default:
+                glGetUniformiv(program, u.location, n);
+                add(setup, GLCAP_UNIFORM_VALUE, {(unsigned long long)u.location, u.type, 1}, n, sizeof(n));
+                break;
+        }
+    }
+
+    count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    for (int i = 0; i < count; i++)
+    {
+        GLint binding = 0;
+        GLsizei length = 0;
+        glGetActiveUniformBlockiv(program, i, GL_UNIFORM_BLOCK_BINDING, &binding);
+        glGetActiveUniformBlockName(program, i, sizeof(name), &length, name);
+        add(setup, GLCAP_UNIFORM_BLOCK_BINDING, {program, (unsigned long long)i, (unsigned long long)binding}, name, length + 1);
+    }
+}
+
+/**
+\brief Records the state at the start of the frame, and copies the objects bound.
+
+*/
+
+void GLCapture::copyStartState()
+{
+    GLint v[4];
+
+    glGetIntegerv(GL_VIEWPORT, v);
+    width = v[2];
+    height = v[3];
+
+    glGetIntegerv(GL_CURRENT_PROGRAM, v);
+    copyProgram(v[0]);
+    add(startState, GLCAP_USE_PROGRAM, {(unsigned long long)v[0]});
+
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, v);
+    copyVertexArray(v[0]);
+    add(startState, GLCAP_BIND_VERTEX_ARRAY, {(unsigned long long)v[0]});
+
+    glGetIntegerv(GL_ARRAY_BUFFER_BINDING, v);
+    copyBuffer(v[0]);
+    add(startState, GLCAP_BIND_BUFFER, {GL_ARRAY_BUFFER, (unsigned long long)v[0]});
+
+    GLint active = GL_TEXTURE0;
+    GLint units = 0;
+    glGetIntegerv(GL_ACTIVE_TEXTURE, &active);
+    glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+    for (int i = 0; i < units; i++)
+    {
+        GLint tex2D = 0, texCube = 0, texBuffer = 0;
+        glActiveTexture(GL_TEXTURE0 + i);
+        glGetIntegerv(GL_TEXTURE_BINDING_2D, &tex2D);
+        glGetIntegerv(GL_TEXTURE_BINDING_CUBE_MAP, &texCube);
+        glGetIntegerv(GL_TEXTURE_BINDING_BUFFER, &texBuffer);
+        if (!tex2D && !texCube && !texBuffer)
+            continue;
+
+        copyTexture(tex2D, GL_TEXTURE_2D);
+        copyTexture(texCube, GL_TEXTURE_CUBE_MAP);
+        copyTexture(texBuffer, GL_TEXTURE_BUFFER);
+        add(startState, GLCAP_ACTIVE_TEXTURE, {(unsigned long long)(GL_TEXTURE0 + i)});
+        add(startState, GLCAP_BIND_TEXTURE, {GL_TEXTURE_2D, (unsigned long long)tex2D});
+        add(startState, GLCAP_BIND_TEXTURE, {GL_TEXTURE_CUBE_MAP, (unsigned long long)texCube});
+        add(startState, GLCAP_BIND_TEXTURE, {GL_TEXTURE_BUFFER, (unsigned long long)texBuffer});
+    }
+    glActiveTexture(active);
+    add(startState, GLCAP_ACTIVE_TEXTURE, {(unsigned long long)active});
+
+    GLint blocks = 0;
+    glGetIntegerv(GL_MAX_UNIFORM_BUFFER_BINDINGS, &blocks);
+    for (int i = 0; i < blocks; i++)
+    {
+        glGetIntegeri_v(GL_UNIFORM_BUFFER_BINDING, i, v);
+        if (!v[0])
+            continue;
+        copyBuffer(v[0]);
+        add(startState, GLCAP_BIND_BUFFER_BASE, {GL_UNIFORM_BUFFER, (unsigned long long)i, (unsigned long long)v[0]});
+    }
+    glGetIntegerv(GL_UNIFORM_BUFFER_BINDING, v);
+    copyBuffer(v[0]);
+    add(startState, GLCAP_BIND_BUFFER, {GL_UNIFORM_BUFFER, (unsigned long long)v[0]});
+
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, v);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, v + 1);
+    copyFramebuffer(v[0]);
+    copyFramebuffer(v[1]);
+    add(startState, GLCAP_BIND_FRAMEBUFFER, {GL_DRAW_FRAMEBUFFER, (unsigned long long)v[0]});
+    add(startState, GLCAP_BIND_FRAMEBUFFER, {GL_READ_FRAMEBUFFER, (unsigned long long)v[1]});
+
+    glGetIntegerv(GL_RENDERBUFFER_BINDING, v);
+    copyRenderbuffer(v[0]);
+    add(startState, GLCAP_BIND_RENDERBUFFER, {GL_RENDERBUFFER, (unsigned long long)v[0]});
+
+    const GLenum caps[6] = {GL_DEPTH_TEST, GL_BLEND, GL_CULL_FACE, GL_SCISSOR_TEST, GL_STENCIL_TEST, GL_POLYGON_OFFSET_FILL};
+    for (int i = 0; i < 6; i++)
+        add(startState, glIsEnabled(caps[i]) ? GLCAP_ENABLE : GLCAP_DISABLE, {caps[i]});
+
+    GLboolean mask[4];
+    glGetIntegerv(GL_DEPTH_FUNC, v);
+    add(startState, GLCAP_DEPTH_FUNC, {(unsigned long long)v[0]});
+    glGetBooleanv(GL_DEPTH_WRITEMASK, mask);
+    add(startState, GLCAP_DEPTH_MASK, {mask[0]});
+    glGetBooleanv(GL_COLOR_WRITEMASK, mask);
+    add(startState, GLCAP_COLOR_MASK, {mask[0], mask[1], mask[2], mask[3]});
+
+    // Only the front face stencil state, the game never sets the faces apart.
+    glGetIntegerv(GL_STENCIL_FUNC, v);
+    glGetIntegerv(GL_STENCIL_REF, v + 1);
+    glGetIntegerv(GL_STENCIL_VALUE_MASK, v + 2);
+    add(startState, GLCAP_STENCIL_FUNC, {(unsigned long long)v[0], (unsigned long long)v[1], (unsigned long long)(GLuint)v[2]});
+    glGetIntegerv(GL_STENCIL_FAIL, v);
+    glGetIntegerv(GL_STENCIL_PASS_DEPTH_FAIL, v + 1);
+    glGetIntegerv(GL_STENCIL_PASS_DEPTH_PASS, v + 2);
+    add(startState, GLCAP_STENCIL_OP, {(unsigned long long)v[0], (unsigned long long)v[1], (unsigned long long)v[2]});
+    glGetIntegerv(GL_STENCIL_WRITEMASK, v);
+    add(startState, GLCAP_STENCIL_MASK, {(unsigned long long)(GLuint)v[0]});
+
+    glGetIntegerv(GL_SCISSOR_BOX, v);
+    add(startState, GLCAP_SCISSOR, {(unsigned long long)v[0], (unsigned long long)v[1], (unsigned long long)v[2], (unsigned long long)v[3]});
+
+    glGetIntegerv(GL_BLEND_SRC_RGB, v);
+    glGetIntegerv(GL_BLEND_DST_RGB, v + 1);
+    add(startState, GLCAP_BLEND_FUNC, {(unsigned long long)v[0], (unsigned long long)v[1]});
+
+    glGetIntegerv(GL_POLYGON_MODE, v);
+    add(startState, GLCAP_POLYGON_MODE, {GL_FRONT_AND_BACK, (unsigned long long)v[0]});
+
+    GLfloat f[4];
+    glGetFloatv(GL_LINE_WIDTH, f);
+    add(startState, GLCAP_LINE_WIDTH, {fromFloat(f[0])});
+
+    add(startState, GLCAP_VIEWPORT, {0, 0, (unsigned long long)width, (unsigned long long)height});
+
+    glGetFloatv(GL_COLOR_CLEAR_VALUE, f);
+    add(startState, GLCAP_CLEAR_COLOR, {fromFloat(f[0]), fromFloat(f[1]), fromFloat(f[2]), fromFloat(f[3])});
+}
+
+/**
+\brief Stores a float argument by its bits.
+
+\param f --- The float.
+
+*/
+
+unsigned long long GLCapture::fromFloat(GLfloat f)
+{
+    unsigned int bits;
+    memcpy(&bits, &f, sizeof(bits));
+    return bits;
+}
+
+/**
+\brief Reads back a float argument stored by fromFloat.
+
+\param arg --- The stored argument.
+
+*/
+
+GLfloat GLCapture::toFloat(unsigned long long arg)
+{
+    unsigned int bits = (unsigned int)arg;
+    GLfloat f;
+    memcpy(&f, &bits, sizeof(f));
+    return f;
+}
+
+/**
+\brief Returns the OpenGL function name of an op, for reports.
+
+\param op --- One of GLCaptureOp.
+
+*/
+
+const char* GLCapture::opName(unsigned int op)
+{
+    static const char* names[GLCAP_OP_COUNT] = {
+        "create", "create program", "uniform value", "glUseProgram", "glBindVertexArray", "glBindBuffer",
+        "glBindTexture", "glActiveTexture", "glBindFramebuffer", "glBindRenderbuffer", "glEnable", "glDisable",
+        "glViewport", "glPolygonMode", "glLineWidth", "glBlendFunc", "glClearColor", "glClear", "glDrawArrays",
+        "glDrawElements", "glDrawElementsBaseVertex", "glBufferData", "glBufferSubData", "glTexImage2D",
+        "glTexParameteri", "glTexParameterf", "glGenerateMipmap", "glVertexAttribPointer", "glVertexAttribIPointer",
+        "glEnableVertexAttribArray", "glDisableVertexAttribArray", "glGetUniformLocation", "glUniform1i",
+        "glUniform1f", "glUniform3f", "glUniform3fv", "glUniform4fv", "glUniformMatrix3fv", "glUniformMatrix4fv",
+        "glBlitFramebuffer", "glFramebufferTexture2D", "glFramebufferRenderbuffer", "glRenderbufferStorage",
+        "glRenderbufferStorageMultisample", "glBindBufferBase", "glTexBuffer", "glUniformBlockBinding",
+        "glDepthFunc", "glDepthMask", "glColorMask", "glPolygonOffset", "glStencilFunc", "glStencilOp", "glStencilMask", "glScissor"
+    };
+
+    return op < GLCAP_OP_COUNT ? names[op] : "unknown";
+}
+
+/**
+\brief Reads a capture file.
+
+\param filename --- File written by GLCapture::end.
+
+\return True if the whole file was read.
+
+*/
+
+bool GLCaptureFile::load(const std::string& filename)
+{
+    FILE* f = fopen(filename.c_str(), "rb");
+    if (!f)
+    {
+        std::cerr << "Could not open " << filename << std::endl;
+        return false;
+    }
+
+    char tag[8];
+    unsigned int counts[4];
+    if (fread(tag, 1, sizeof(tag), f) != sizeof(tag) || memcmp(tag, captureTag, sizeof(tag)) != 0 ||
+        fread(counts, sizeof(counts[0]), 4, f) != 4)
+    {
+        std::cerr << filename << " is not a capture file." << std::endl;
+        fclose(f);
+        return false;
+    }
+
+    width = counts[0];
+    height = counts[1];
+    setup.clear();
+    frame.clear();
+
+    for (int s = 0; s < 2; s++)
+    {
+        std::vector<GLCaptureCall>& calls = s == 0 ? setup : frame;
+        calls.resize(counts[2 + s]);
+        for (size_t i = 0; i < calls.size(); i++)
+        {
+            unsigned int head[2];
+            if (fread(head, sizeof(head[0]), 2, f) != 2 ||
+                fread(calls[i].args, sizeof(calls[i].args[0]), GLCAPTURE_ARGS, f) != GLCAPTURE_ARGS)
+            {
+                std::cerr << filename << " ends early." << std::endl;
+                fclose(f);
+                return false;
+            }
+            calls[i].op = head[0];
+            calls[i].payload.resize(head[1]);
+            if (head[1] > 0 && fread(&calls[i].payload[0], 1, head[1], f) != head[1])
+            {
+                std::cerr << filename << " ends early." << std::endl;
+                fclose(f);
+                return false;
+            }
+        }
+    }
+
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,203 @@
+#ifndef GLCAPTURE_H_INCLUDED
+#define GLCAPTURE_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <initializer_list>
+#include <set>
+#include <string>
+#include <vector>
+
+/**
+\file GLCapture.h
+
+\brief Header file for GLCapture.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define GLCAPTURE_ARGS 10   ///< Most arguments of a captured call, glBlitFramebuffer's.
+
+/**
+\brief Calls a capture holds, the OpenGL calls the renderer makes in a frame and the
+ones that rebuild the objects it used.
+
+*/
+
+enum GLCaptureOp
+{
+    GLCAP_CREATE,                   ///< Make an object, a = GLCaptureObject, b = its name.  Setup only.
+    GLCAP_CREATE_PROGRAM,           ///< Build a program, a = name, payload described at GLCapture::copyProgram.  Setup only.
+    GLCAP_UNIFORM_VALUE,            ///< Set a uniform of the program in use, a = location, b = type, c = count, payload = values.  Setup only.
+    GLCAP_USE_PROGRAM,
+    GLCAP_BIND_VERTEX_ARRAY,
+    GLCAP_BIND_BUFFER,
+    GLCAP_BIND_TEXTURE,
+    GLCAP_ACTIVE_TEXTURE,
+    GLCAP_BIND_FRAMEBUFFER,
+    GLCAP_BIND_RENDERBUFFER,
+    GLCAP_ENABLE,
+    GLCAP_DISABLE,
+    GLCAP_VIEWPORT,
+    GLCAP_POLYGON_MODE,
+    GLCAP_LINE_WIDTH,
+    GLCAP_BLEND_FUNC,
+    GLCAP_CLEAR_COLOR,
+    GLCAP_CLEAR,
+    GLCAP_DRAW_ARRAYS,
+    GLCAP_DRAW_ELEMENTS,
+    GLCAP_DRAW_ELEMENTS_BASE_VERTEX,
+    GLCAP_BUFFER_DATA,              ///< Payload is the data, none for storage only.
+    GLCAP_BUFFER_SUB_DATA,
+    GLCAP_TEX_IMAGE_2D,             ///< Payload is the pixels, none for storage only.
+    GLCAP_TEX_PARAMETER_I,
+    GLCAP_TEX_PARAMETER_F,
+    GLCAP_GENERATE_MIPMAP,
+    GLCAP_VERTEX_ATTRIB_POINTER,
+    GLCAP_VERTEX_ATTRIB_I_POINTER,
+    GLCAP_ENABLE_VERTEX_ATTRIB_ARRAY,
+    GLCAP_DISABLE_VERTEX_ATTRIB_ARRAY,
+    GLCAP_GET_UNIFORM_LOCATION,     ///< a = program, b = location found, payload = name.
+    GLCAP_UNIFORM_1I,
+    GLCAP_UNIFORM_1F,
+    GLCAP_UNIFORM_3F,
+    GLCAP_UNIFORM_3FV,
+    GLCAP_UNIFORM_4FV,
+    GLCAP_UNIFORM_MATRIX_3FV,
+    GLCAP_UNIFORM_MATRIX_4FV,
+    GLCAP_BLIT_FRAMEBUFFER,
+    GLCAP_FRAMEBUFFER_TEXTURE_2D,
+    GLCAP_FRAMEBUFFER_RENDERBUFFER,
+    GLCAP_RENDERBUFFER_STORAGE,
+    GLCAP_RENDERBUFFER_STORAGE_MULTISAMPLE,
+    GLCAP_BIND_BUFFER_BASE,
+    GLCAP_TEX_BUFFER,
+    GLCAP_UNIFORM_BLOCK_BINDING,    ///< a = program, b = block index, c = binding, payload = block name.
+    GLCAP_DEPTH_FUNC,
+    GLCAP_DEPTH_MASK,
+    GLCAP_COLOR_MASK,
+    GLCAP_POLYGON_OFFSET,
+    GLCAP_STENCIL_FUNC,
+    GLCAP_STENCIL_OP,
+    GLCAP_STENCIL_MASK,
+    GLCAP_SCISSOR,
+    GLCAP_OP_COUNT
+};
+
+/**
+\brief Kinds of object a capture rebuilds.
+
+*/
+
+enum GLCaptureObject
+{
+    GLCAP_BUFFER,
+    GLCAP_TEXTURE,
+    GLCAP_VERTEX_ARRAY,
+    GLCAP_FRAMEBUFFER,
+    GLCAP_RENDERBUFFER,
+    GLCAP_OBJECT_COUNT
+};
+
+/**
+\brief One captured OpenGL call.
+
+Names are the ones the game used and are mapped to the replay's own.  Integer arguments
+are stored as they are, floats by their bits, see GLCapture::fromFloat.
+
+*/
+
+struct GLCaptureCall
+{
+    unsigned int op;                                ///< One of GLCaptureOp.
+    unsigned long long args[GLCAPTURE_ARGS];        ///< Arguments, in the order OpenGL takes them.
+    std::vector<unsigned char> payload;             ///< Data the call pointed to.
+};
+
+/**
+\brief A capture read back from a file, for the replayer.
+
+*/
+
+struct GLCaptureFile
+{
+    int width;                          ///< Size of the window captured.
+    int height;                         ///< Height of the window captured.
+    std::vector<GLCaptureCall> setup;   ///< Calls that rebuild the objects and state at the start of the frame.
+    std::vector<GLCaptureCall> frame;   ///< Calls of the frame.
+
+    bool load(const std::string& filename);
+};
+
+/**
+\class GLCapture
+
+\brief Records the OpenGL calls of one frame to a file, with what is needed to replay them.
+
+The calls are recorded by the hooks in GLStats, so GLStats::install must have been called.
+Each object the frame uses is copied out of OpenGL the first time it is bound, before
+the call that binds it is recorded: buffer contents, level 0 of textures and the buffer
+behind a buffer texture, vertex array layouts, framebuffer attachments, and programs
+with their shader sources, uniform values and uniform block bindings.  The state at the start of the frame is recorded the same way.  These make the
+setup calls, which a replayer runs once to rebuild everything, the frame's calls can
+then be run as many times as wanted.
+
+Only the render thread may use it.  On Linux every call listed in GLCaptureOp is seen;
+elsewhere the OpenGL 1.1 ones (draws, texture binds, fixed state) cannot be hooked and
+are missing from the capture.
+
+*/
+
+class GLCapture
+{
+private:
+    static bool recording;                              ///< A frame is being recorded.
+    static bool busy;                                   ///< Copying an object, its calls are not recorded.
+    static std::string fileName;                        ///< File written by end.
+    static int width;                                   ///< Viewport width at begin.
+    static int height;                                  ///< Viewport height at begin.
+    static std::vector<GLCaptureCall> setup;            ///< Setup calls so far.
+    static std::vector<GLCaptureCall> frame;            ///< Frame calls so far.
+    static std::set<GLuint> known[GLCAP_OBJECT_COUNT];  ///< Objects already copied, of each kind.
+    static std::set<GLuint> knownPrograms;              ///< Programs already copied.
+
+    static void add(std::vector<GLCaptureCall>& calls, unsigned int op, std::initializer_list<unsigned long long> args,
+                    const void* payload = NULL, size_t size = 0);
+    static void copyBuffer(GLuint buffer);
+    static void copyTexture(GLuint texture, GLenum target);
+    static void copyVertexArray(GLuint vao);
+    static void copyFramebuffer(GLuint fbo);
+    static void copyRenderbuffer(GLuint rbo);
+    static void copyProgram(GLuint program);
+    static void copyStartState();
+
+public:
+    static bool begin(const std::string& filename);
+    static bool end();
+    static bool isRecording();
+
+    static void record(unsigned int op, std::initializer_list<unsigned long long> args, const void* payload = NULL, size_t size = 0);
+
+    static unsigned long long fromFloat(GLfloat f);
+    static GLfloat toFloat(unsigned long long arg);
+    static const char* opName(unsigned int op);
+};
+
+/// Records a call from a hook, only while a frame is being captured.
+#define GLCAPTURE(op, ...) \
+    if (GLCapture::isRecording()) \
+        GLCapture::record(op, {__VA_ARGS__})
+
+/// Records a call with the data it points to, only while a frame is being captured.
+#define GLCAPTURE_DATA(op, data, size, ...) \
+    if (GLCapture::isRecording()) \
+        GLCapture::record(op, {__VA_ARGS__}, data, size)
+
+#endif // GLCAPTURE_H_INCLUDED
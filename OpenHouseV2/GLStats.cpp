@@ -0,0 +1,745 @@
+#include "GLStats.h"
+#include "GLCapture.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <dlfcn.h>
+#endif // __linux__
+
+/**
+\file GLStats.cpp
+\brief Counting hooks over the OpenGL calls the program makes, which also feed GLCapture.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+static GLCallCounts counts = {0, 0, 0, 0, 0};   ///< Counts since the last reset.
+static thread_local bool hooked = false;         ///< Calls on this thread are counted and captured, set by install.
+
+#ifdef __linux__
+
+/**
+\brief Finds the driver's function of a name, the one this file's definition hides.
+
+\param name --- OpenGL function name.
+
+*/
+
+static void* driverFunction(const char* name)
+{
+    return dlsym(RTLD_NEXT, name);
+}
+
+typedef void (GLAPIENTRY *DrawArraysFn)(GLenum, GLint, GLsizei);
+typedef void (GLAPIENTRY *DrawElementsFn)(GLenum, GLsizei, GLenum, const void*);
+typedef void (GLAPIENTRY *BindTextureFn)(GLenum, GLuint);
+typedef void (GLAPIENTRY *CapabilityFn)(GLenum);
+typedef void (GLAPIENTRY *ViewportFn)(GLint, GLint, GLsizei, GLsizei);
+typedef void (GLAPIENTRY *PolygonModeFn)(GLenum, GLenum);
+typedef void (GLAPIENTRY *LineWidthFn)(GLfloat);
+typedef void (GLAPIENTRY *BlendFuncFn)(GLenum, GLenum);
+typedef void (GLAPIENTRY *TexImage2DFn)(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*);
+typedef void (GLAPIENTRY *TexParameteriFn)(GLenum, GLenum, GLint);
+typedef void (GLAPIENTRY *TexParameterfFn)(GLenum, GLenum, GLfloat);
+typedef void (GLAPIENTRY *ClearFn)(GLbitfield);
+typedef void (GLAPIENTRY *ClearColorFn)(GLfloat, GLfloat, GLfloat, GLfloat);
+typedef void (GLAPIENTRY *DepthFuncFn)(GLenum);
+typedef void (GLAPIENTRY *DepthMaskFn)(GLboolean);
+typedef void (GLAPIENTRY *ColorMaskFn)(GLboolean, GLboolean, GLboolean, GLboolean);
+typedef void (GLAPIENTRY *PolygonOffsetFn)(GLfloat, GLfloat);
+typedef void (GLAPIENTRY *StencilFuncFn)(GLenum, GLint, GLuint);
+typedef void (GLAPIENTRY *StencilOpFn)(GLenum, GLenum, GLenum);
+typedef void (GLAPIENTRY *StencilMaskFn)(GLuint);
+typedef void (GLAPIENTRY *ScissorFn)(GLint, GLint, GLsizei, GLsizei);
+
+/**
+\brief Returns the bytes of an image glTexImage2D reads, rows padded to four bytes.
+
+\param width --- Width in texels.
+\param height --- Height in texels.
+\param format --- Pixel format.
+\param type --- Component type.
+
+*/
+
+static size_t imageBytes(GLsizei width, GLsizei height, GLenum format, GLenum type)
+{
+    size_t components = 4;
+    if (format == GL_RED || format == GL_DEPTH_COMPONENT)
+        components = 1;
+    else if (format == GL_RG || format == GL_DEPTH_STENCIL)
+        components = 2;
+    else if (format == GL_RGB || format == GL_BGR)
+        components = 3;
+
+    size_t texel = components;
+    if (type == GL_FLOAT || type == GL_UNSIGNED_INT || type == GL_INT)
+        texel = components * 4;
+    else if (type == GL_HALF_FLOAT || type == GL_UNSIGNED_SHORT || type == GL_SHORT)
+        texel = components * 2;
+    else if (type == GL_UNSIGNED_INT_24_8)
+        texel = 4;
+
+    size_t row = (width * texel + 3) & ~(size_t)3;
+    return row * height;
+}
+
+extern "C" void GLAPIENTRY glDrawArrays(GLenum mode, GLint first, GLsizei count)
+{
+    static DrawArraysFn driver = (DrawArraysFn)driverFunction("glDrawArrays");
+    if (!hooked)
+    {
+        driver(mode, first, count);
+        return;
+    }
+
+    counts.drawCalls++;
+    driver(mode, first, count);
+    GLCAPTURE(GLCAP_DRAW_ARRAYS, mode, (unsigned long long)first, (unsigned long long)count);
+}
+
+extern "C" void GLAPIENTRY glDrawElements(GLenum mode, GLsizei count, GLenum type, const void* indices)
+{
+    static DrawElementsFn driver = (DrawElementsFn)driverFunction("glDrawElements");
+    if (!hooked)
+    {
+        driver(mode, count, type, indices);
+        return;
+    }
+
+    counts.drawCalls++;
+    driver(mode, count, type, indices);
+    GLCAPTURE(GLCAP_DRAW_ELEMENTS, mode, (unsigned long long)count, type, (unsigned long long)(size_t)indices);
+}
+
+extern "C" void GLAPIENTRY glBindTexture(GLenum target, GLuint texture)
+{
+    static BindTextureFn driver = (BindTextureFn)driverFunction("glBindTexture");
+    if (!hooked)
+    {
+        driver(target, texture);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(target, texture);
+    GLCAPTURE(GLCAP_BIND_TEXTURE, target, texture);
+}
+
+extern "C" void GLAPIENTRY glEnable(GLenum cap)
+{
+    static CapabilityFn driver = (CapabilityFn)driverFunction("glEnable");
+    if (!hooked)
+    {
+        driver(cap);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(cap);
+    GLCAPTURE(GLCAP_ENABLE, cap);
+}
+
+extern "C" void GLAPIENTRY glDisable(GLenum cap)
+{
+    static CapabilityFn driver = (CapabilityFn)driverFunction("glDisable");
+    if (!hooked)
+    {
+        driver(cap);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(cap);
+    GLCAPTURE(GLCAP_DISABLE, cap);
+}
+
+extern "C" void GLAPIENTRY glViewport(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    static ViewportFn driver = (ViewportFn)driverFunction("glViewport");
+    if (!hooked)
+    {
+        driver(x, y, width, height);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(x, y, width, height);
+    GLCAPTURE(GLCAP_VIEWPORT, (unsigned long long)x, (unsigned long long)y, (unsigned long long)width, (unsigned long long)height);
+}
+
+extern "C" void GLAPIENTRY glPolygonMode(GLenum face, GLenum mode)
+{
+    static PolygonModeFn driver = (PolygonModeFn)driverFunction("glPolygonMode");
+    if (!hooked)
+    {
+        driver(face, mode);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(face, mode);
+    GLCAPTURE(GLCAP_POLYGON_MODE, face, mode);
+}
+
+extern "C" void GLAPIENTRY glLineWidth(GLfloat width)
+{
+    static LineWidthFn driver = (LineWidthFn)driverFunction("glLineWidth");
+    if (!hooked)
+    {
+        driver(width);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(width);
+    GLCAPTURE(GLCAP_LINE_WIDTH, GLCapture::fromFloat(width));
+}
+
+extern "C" void GLAPIENTRY glBlendFunc(GLenum sfactor, GLenum dfactor)
+{
+    static BlendFuncFn driver = (BlendFuncFn)driverFunction("glBlendFunc");
+    if (!hooked)
+    {
+        driver(sfactor, dfactor);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(sfactor, dfactor);
+    GLCAPTURE(GLCAP_BLEND_FUNC, sfactor, dfactor);
+}
+
+extern "C" void GLAPIENTRY glTexImage2D(GLenum target, GLint level, GLint internalFormat, GLsizei width, GLsizei height,
+                                        GLint border, GLenum format, GLenum type, const void* pixels)
+{
+    static TexImage2DFn driver = (TexImage2DFn)driverFunction("glTexImage2D");
+    if (!hooked)
+    {
+        driver(target, level, internalFormat, width, height, border, format, type, pixels);
+        return;
+    }
+
+    if (pixels)
+        counts.uploadBytes += imageBytes(width, height, format, type);
+    driver(target, level, internalFormat, width, height, border, format, type, pixels);
+    GLCAPTURE_DATA(GLCAP_TEX_IMAGE_2D, pixels, pixels ? imageBytes(width, height, format, type) : 0, target, (unsigned long long)level,
+                   (unsigned long long)internalFormat, (unsigned long long)width, (unsigned long long)height, (unsigned long long)border,
+                   format, type);
+}
+
+extern "C" void GLAPIENTRY glTexParameteri(GLenum target, GLenum pname, GLint param)
+{
+    static TexParameteriFn driver = (TexParameteriFn)driverFunction("glTexParameteri");
+    if (!hooked)
+    {
+        driver(target, pname, param);
+        return;
+    }
+
+    driver(target, pname, param);
+    GLCAPTURE(GLCAP_TEX_PARAMETER_I, target, pname, (unsigned long long)param);
+}
+
+extern "C" void GLAPIENTRY glTexParameterf(GLenum target, GLenum pname, GLfloat param)
+{
+    static TexParameterfFn driver = (TexParameterfFn)driverFunction("glTexParameterf");
+    if (!hooked)
+    {
+        driver(target, pname, param);
+        return;
+    }
+
+    driver(target, pname, param);
+    GLCAPTURE(GLCAP_TEX_PARAMETER_F, target, pname, GLCapture::fromFloat(param));
+}
+
+extern "C" void GLAPIENTRY glClear(GLbitfield mask)
+{
+    static ClearFn driver = (ClearFn)driverFunction("glClear");
+    if (!hooked)
+    {
+        driver(mask);
+        return;
+    }
+
+    driver(mask);
+    GLCAPTURE(GLCAP_CLEAR, mask);
+}
+
+extern "C" void GLAPIENTRY glClearColor(GLfloat red, GLfloat green, GLfloat blue, GLfloat alpha)
+{
+    static ClearColorFn driver = (ClearColorFn)driverFunction("glClearColor");
+    if (!hooked)
+    {
+        driver(red, green, blue, alpha);
+        return;
+    }
+
+    driver(red, green, blue, alpha);
+    GLCAPTURE(GLCAP_CLEAR_COLOR, GLCapture::fromFloat(red), GLCapture::fromFloat(green), GLCapture::fromFloat(blue), GLCapture::fromFloat(alpha));
+}
+
+extern "C" void GLAPIENTRY glDepthFunc(GLenum func)
+{
+    static DepthFuncFn driver = (DepthFuncFn)driverFunction("glDepthFunc");
+    if (!hooked)
+    {
+        driver(func);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(func);
+    GLCAPTURE(GLCAP_DEPTH_FUNC, func);
+}
+
+extern "C" void GLAPIENTRY glDepthMask(GLboolean flag)
+{
+    static DepthMaskFn driver = (DepthMaskFn)driverFunction("glDepthMask");
+    if (!hooked)
+    {
+        driver(flag);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(flag);
+    GLCAPTURE(GLCAP_DEPTH_MASK, flag);
+}
+
+extern "C" void GLAPIENTRY glColorMask(GLboolean red, GLboolean green, GLboolean blue, GLboolean alpha)
+{
+    static ColorMaskFn driver = (ColorMaskFn)driverFunction("glColorMask");
+    if (!hooked)
+    {
+        driver(red, green, blue, alpha);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(red, green, blue, alpha);
+    GLCAPTURE(GLCAP_COLOR_MASK, red, green, blue, alpha);
+}
+
+extern "C" void GLAPIENTRY glPolygonOffset(GLfloat factor, GLfloat units)
+{
+    static PolygonOffsetFn driver = (PolygonOffsetFn)driverFunction("glPolygonOffset");
+    if (!hooked)
+    {
+        driver(factor, units);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(factor, units);
+    GLCAPTURE(GLCAP_POLYGON_OFFSET, GLCapture::fromFloat(factor), GLCapture::fromFloat(units));
+}
+
+extern "C" void GLAPIENTRY glStencilFunc(GLenum func, GLint ref, GLuint mask)
+{
+    static StencilFuncFn driver = (StencilFuncFn)driverFunction("glStencilFunc");
+    if (!hooked)
+    {
+        driver(func, ref, mask);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(func, ref, mask);
+    GLCAPTURE(GLCAP_STENCIL_FUNC, func, (unsigned long long)ref, mask);
+}
+
+extern "C" void GLAPIENTRY glStencilOp(GLenum sfail, GLenum dpfail, GLenum dppass)
+{
+    static StencilOpFn driver = (StencilOpFn)driverFunction("glStencilOp");
+    if (!hooked)
+    {
+        driver(sfail, dpfail, dppass);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(sfail, dpfail, dppass);
+    GLCAPTURE(GLCAP_STENCIL_OP, sfail, dpfail, dppass);
+}
+
+extern "C" void GLAPIENTRY glStencilMask(GLuint mask)
+{
+    static StencilMaskFn driver = (StencilMaskFn)driverFunction("glStencilMask");
+    if (!hooked)
+    {
+        driver(mask);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(mask);
+    GLCAPTURE(GLCAP_STENCIL_MASK, mask);
+}
+
+extern "C" void GLAPIENTRY glScissor(GLint x, GLint y, GLsizei width, GLsizei height)
+{
+    static ScissorFn driver = (ScissorFn)driverFunction("glScissor");
+    if (!hooked)
+    {
+        driver(x, y, width, height);
+        return;
+    }
+
+    counts.stateChanges++;
+    driver(x, y, width, height);
+    GLCAPTURE(GLCAP_SCISSOR, (unsigned long long)x, (unsigned long long)y, (unsigned long long)width, (unsigned long long)height);
+}
+
+#endif // __linux__
+
+#ifndef __APPLE__
+
+static PFNGLUSEPROGRAMPROC realUseProgram = NULL;
+static PFNGLBINDVERTEXARRAYPROC realBindVertexArray = NULL;
+static PFNGLBINDBUFFERPROC realBindBuffer = NULL;
+static PFNGLBINDFRAMEBUFFERPROC realBindFramebuffer = NULL;
+static PFNGLACTIVETEXTUREPROC realActiveTexture = NULL;
+static PFNGLDRAWELEMENTSBASEVERTEXPROC realDrawElementsBaseVertex = NULL;
+static PFNGLBUFFERDATAPROC realBufferData = NULL;
+static PFNGLBUFFERSUBDATAPROC realBufferSubData = NULL;
+static PFNGLGETUNIFORMLOCATIONPROC realGetUniformLocation = NULL;
+static PFNGLUNIFORM1IPROC realUniform1i = NULL;
+static PFNGLUNIFORM1FPROC realUniform1f = NULL;
+static PFNGLUNIFORM3FPROC realUniform3f = NULL;
+static PFNGLUNIFORM3FVPROC realUniform3fv = NULL;
+static PFNGLUNIFORM4FVPROC realUniform4fv = NULL;
+static PFNGLUNIFORMMATRIX3FVPROC realUniformMatrix3fv = NULL;
+static PFNGLUNIFORMMATRIX4FVPROC realUniformMatrix4fv = NULL;
+static PFNGLBINDRENDERBUFFERPROC realBindRenderbuffer = NULL;
+static PFNGLBLITFRAMEBUFFERPROC realBlitFramebuffer = NULL;
+static PFNGLGENERATEMIPMAPPROC realGenerateMipmap = NULL;
+static PFNGLVERTEXATTRIBPOINTERPROC realVertexAttribPointer = NULL;
+static PFNGLVERTEXATTRIBIPOINTERPROC realVertexAttribIPointer = NULL;
+static PFNGLENABLEVERTEXATTRIBARRAYPROC realEnableVertexAttribArray = NULL;
+static PFNGLDISABLEVERTEXATTRIBARRAYPROC realDisableVertexAttribArray = NULL;
+static PFNGLFRAMEBUFFERTEXTURE2DPROC realFramebufferTexture2D = NULL;
+static PFNGLFRAMEBUFFERRENDERBUFFERPROC realFramebufferRenderbuffer = NULL;
+static PFNGLRENDERBUFFERSTORAGEPROC realRenderbufferStorage = NULL;
+static PFNGLRENDERBUFFERSTORAGEMULTISAMPLEPROC realRenderbufferStorageMultisample = NULL;
+static PFNGLBINDBUFFERBASEPROC realBindBufferBase = NULL;
+static PFNGLTEXBUFFERPROC realTexBuffer = NULL;
+static PFNGLUNIFORMBLOCKBINDINGPROC realUniformBlockBinding = NULL;
+
+static void GLAPIENTRY countUseProgram(GLuint program)
+{
+    counts.stateChanges++;
+    realUseProgram(program);
+    GLCAPTURE(GLCAP_USE_PROGRAM, program);
+}
+
+static void GLAPIENTRY countBindVertexArray(GLuint array)
+{
+    counts.stateChanges++;
+    realBindVertexArray(array);
+    GLCAPTURE(GLCAP_BIND_VERTEX_ARRAY, array);
+}
+
+static void GLAPIENTRY countBindBuffer(GLenum target, GLuint buffer)
+{
+    counts.stateChanges++;
+    realBindBuffer(target, buffer);
+    GLCAPTURE(GLCAP_BIND_BUFFER, target, buffer);
+}
+
+static void GLAPIENTRY countBindFramebuffer(GLenum target, GLuint framebuffer)
+{
+    counts.stateChanges++;
+    realBindFramebuffer(target, framebuffer);
+    GLCAPTURE(GLCAP_BIND_FRAMEBUFFER, target, framebuffer);
+}
+
+static void GLAPIENTRY countActiveTexture(GLenum texture)
+{
+    counts.stateChanges++;
+    realActiveTexture(texture);
+    GLCAPTURE(GLCAP_ACTIVE_TEXTURE, texture);
+}
+
+static void GLAPIENTRY countDrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const void* indices, GLint basevertex)
+{
+    counts.drawCalls++;
+    realDrawElementsBaseVertex(mode, count, type, indices, basevertex);
+    GLCAPTURE(GLCAP_DRAW_ELEMENTS_BASE_VERTEX, mode, (unsigned long long)count, type, (unsigned long long)(size_t)indices, (unsigned long long)basevertex);
+}
+
+static void GLAPIENTRY countBufferData(GLenum target, GLsizeiptr size, const void* data, GLenum usage)
+{
+    if (data)
+        counts.uploadBytes += size;
+    realBufferData(target, size, data, usage);
+    GLCAPTURE_DATA(GLCAP_BUFFER_DATA, data, data ? size : 0, target, (unsigned long long)size, usage);
+}
+
+static void GLAPIENTRY countBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    counts.uploadBytes += size;
+    realBufferSubData(target, offset, size, data);
+    GLCAPTURE_DATA(GLCAP_BUFFER_SUB_DATA, data, size, target, (unsigned long long)offset, (unsigned long long)size);
+}
+
+static GLint GLAPIENTRY countGetUniformLocation(GLuint program, const GLchar* name)
+{
+    counts.uniformLookups++;
+    GLint location = realGetUniformLocation(program, name);
+    GLCAPTURE_DATA(GLCAP_GET_UNIFORM_LOCATION, name, strlen(name) + 1, program, (unsigned long long)location);
+    return location;
+}
+
+static void GLAPIENTRY countUniform1i(GLint location, GLint v0)
+{
+    counts.uniformCalls++;
+    realUniform1i(location, v0);
+    GLCAPTURE(GLCAP_UNIFORM_1I, (unsigned long long)location, (unsigned long long)v0);
+}
+
+static void GLAPIENTRY countUniform1f(GLint location, GLfloat v0)
+{
+    counts.uniformCalls++;
+    realUniform1f(location, v0);
+    GLCAPTURE(GLCAP_UNIFORM_1F, (unsigned long long)location, GLCapture::fromFloat(v0));
+}
+
+static void GLAPIENTRY countUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+    counts.uniformCalls++;
+    realUniform3f(location, v0, v1, v2);
+    GLCAPTURE(GLCAP_UNIFORM_3F, (unsigned long long)location, GLCapture::fromFloat(v0), GLCapture::fromFloat(v1), GLCapture::fromFloat(v2));
+}
+
+static void GLAPIENTRY countUniform3fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    counts.uniformCalls++;
+    realUniform3fv(location, count, value);
+    GLCAPTURE_DATA(GLCAP_UNIFORM_3FV, value, count * 3 * sizeof(GLfloat), (unsigned long long)location, (unsigned long long)count);
+}
+
+static void GLAPIENTRY countUniform4fv(GLint location, GLsizei count, const GLfloat* value)
+{
+    counts.uniformCalls++;
+    realUniform4fv(location, count, value);
+    GLCAPTURE_DATA(GLCAP_UNIFORM_4FV, value, count * 4 * sizeof(GLfloat), (unsigned long long)location, (unsigned long long)count);
+}
+
+static void GLAPIENTRY countUniformMatrix3fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    counts.uniformCalls++;
+    realUniformMatrix3fv(location, count, transpose, value);
+    GLCAPTURE_DATA(GLCAP_UNIFORM_MATRIX_3FV, value, count * 9 * sizeof(GLfloat), (unsigned long long)location, (unsigned long long)count, transpose);
+}
+
+static void GLAPIENTRY countUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    counts.uniformCalls++;
+    realUniformMatrix4fv(location, count, transpose, value);
+    GLCAPTURE_DATA(GLCAP_UNIFORM_MATRIX_4FV, value, count * 16 * sizeof(GLfloat), (unsigned long long)location, (unsigned long long)count, transpose);
+}
+
+static void GLAPIENTRY countBindRenderbuffer(GLenum target, GLuint renderbuffer)
+{
+    counts.stateChanges++;
+    realBindRenderbuffer(target, renderbuffer);
+    GLCAPTURE(GLCAP_BIND_RENDERBUFFER, target, renderbuffer);
+}
+
+// The rest are not counted, only captured.
+
+static void GLAPIENTRY countBlitFramebuffer(GLint srcX0, GLint srcY0, GLint srcX1, GLint srcY1, GLint dstX0, GLint dstY0,
+                                            GLint dstX1, GLint dstY1, GLbitfield mask, GLenum filter)
+{
+    realBlitFramebuffer(srcX0, srcY0, srcX1, srcY1, dstX0, dstY0, dstX1, dstY1, mask, filter);
+    GLCAPTURE(GLCAP_BLIT_FRAMEBUFFER, (unsigned long long)srcX0, (unsigned long long)srcY0, (unsigned long long)srcX1,
+              (unsigned long long)srcY1, (unsigned long long)dstX0, (unsigned long long)dstY0, (unsigned long long)dstX1,
+              (unsigned long long)dstY1, mask, filter);
+}
+
+static void GLAPIENTRY countGenerateMipmap(GLenum target)
+{
+    realGenerateMipmap(target);
+    GLCAPTURE(GLCAP_GENERATE_MIPMAP, target);
+}
+
+static void GLAPIENTRY countVertexAttribPointer(GLuint index, GLint size, GLenum type, GLboolean normalized, GLsizei stride,
+                                                const void* pointer)
+{
+    realVertexAttribPointer(index, size, type, normalized, stride, pointer);
+    GLCAPTURE(GLCAP_VERTEX_ATTRIB_POINTER, index, (unsigned long long)size, type, normalized, (unsigned long long)stride,
+              (unsigned long long)(size_t)pointer);
+}
+
+static void GLAPIENTRY countVertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const void* pointer)
+{
+    realVertexAttribIPointer(index, size, type, stride, pointer);
+    GLCAPTURE(GLCAP_VERTEX_ATTRIB_I_POINTER, index, (unsigned long long)size, type, (unsigned long long)stride,
+              (unsigned long long)(size_t)pointer);
+}
+
+static void GLAPIENTRY countEnableVertexAttribArray(GLuint index)
+{
+    realEnableVertexAttribArray(index);
+    GLCAPTURE(GLCAP_ENABLE_VERTEX_ATTRIB_ARRAY, index);
+}
+
+static void GLAPIENTRY countDisableVertexAttribArray(GLuint index)
+{
+    realDisableVertexAttribArray(index);
+    GLCAPTURE(GLCAP_DISABLE_VERTEX_ATTRIB_ARRAY, index);
+}
+
+static void GLAPIENTRY countFramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level)
+{
+    realFramebufferTexture2D(target, attachment, textarget, texture, level);
+    GLCAPTURE(GLCAP_FRAMEBUFFER_TEXTURE_2D, target, attachment, textarget, texture, (unsigned long long)level);
+}
+
+static void GLAPIENTRY countFramebufferRenderbuffer(GLenum target, GLenum attachment, GLenum renderbuffertarget, GLuint renderbuffer)
+{
+    realFramebufferRenderbuffer(target, attachment, renderbuffertarget, renderbuffer);
+    GLCAPTURE(GLCAP_FRAMEBUFFER_RENDERBUFFER, target, attachment, renderbuffertarget, renderbuffer);
+}
+
+static void GLAPIENTRY countRenderbufferStorage(GLenum target, GLenum internalformat, GLsizei width, GLsizei height)
+{
+    realRenderbufferStorage(target, internalformat, width, height);
+    GLCAPTURE(GLCAP_RENDERBUFFER_STORAGE, target, internalformat, (unsigned long long)width, (unsigned long long)height);
+}
+
+static void GLAPIENTRY countRenderbufferStorageMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width,
+                                                           GLsizei height)
+{
+    realRenderbufferStorageMultisample(target, samples, internalformat, width, height);
+    GLCAPTURE(GLCAP_RENDERBUFFER_STORAGE_MULTISAMPLE, target, (unsigned long long)samples, internalformat, (unsigned long long)width,
+              (unsigned long long)height);
+}
+
+static void GLAPIENTRY countBindBufferBase(GLenum target, GLuint index, GLuint buffer)
+{
+    counts.stateChanges++;
+    realBindBufferBase(target, index, buffer);
+    GLCAPTURE(GLCAP_BIND_BUFFER_BASE, target, index, buffer);
+}
+
+static void GLAPIENTRY countTexBuffer(GLenum target, GLenum internalformat, GLuint buffer)
+{
+    counts.stateChanges++;
+    realTexBuffer(target, internalformat, buffer);
+    GLCAPTURE(GLCAP_TEX_BUFFER, target, internalformat, buffer);
+}
+
+static void GLAPIENTRY countUniformBlockBinding(GLuint program, GLuint index, GLuint binding)
+{
+    counts.uniformCalls++;
+    realUniformBlockBinding(program, index, binding);
+    if (!GLCapture::isRecording())
+        return;
+
+    // The replay's block indices can differ, it finds the block by name.
+    GLchar name[256];
+    GLsizei length = 0;
+    glGetActiveUniformBlockName(program, index, sizeof(name), &length, name);
+    GLCAPTURE_DATA(GLCAP_UNIFORM_BLOCK_BINDING, name, length + 1, program, index, binding);
+}
+
+/// Puts the counting function in place of GLEW's pointer, keeping the driver's.  The cast
+/// covers GLEW versions that leave const off a pointer argument.
+#define GLSTATS_HOOK(name) \
+    if (__glew##name) \
+    { \
+        real##name = (decltype(real##name))__glew##name; \
+        __glew##name = (decltype(__glew##name))count##name; \
+    }
+
+#endif // __APPLE__
+
+/**
+\brief Swaps the counting functions in for the entry points GLEW loaded.
+
+Must be called after glewInit, on the render thread with the context current.  It also
+turns on the OpenGL 1.1 hooks for the calling thread; calls on other threads, and all
+calls before this, go straight to the driver.  Does nothing after the first time.
+
+\return True if the GLEW entry points are counted.
+
+*/
+
+bool GLStats::install()
+{
+    hooked = true;
+
+#ifndef __APPLE__
+    static bool installed = false;
+    if (installed)
+        return true;
+
+    GLSTATS_HOOK(UseProgram);
+    GLSTATS_HOOK(BindVertexArray);
+    GLSTATS_HOOK(BindBuffer);
+    GLSTATS_HOOK(BindFramebuffer);
+    GLSTATS_HOOK(ActiveTexture);
+    GLSTATS_HOOK(DrawElementsBaseVertex);
+    GLSTATS_HOOK(BufferData);
+    GLSTATS_HOOK(BufferSubData);
+    GLSTATS_HOOK(GetUniformLocation);
+    GLSTATS_HOOK(Uniform1i);
+    GLSTATS_HOOK(Uniform1f);
+    GLSTATS_HOOK(Uniform3f);
+    GLSTATS_HOOK(Uniform3fv);
+    GLSTATS_HOOK(Uniform4fv);
+    GLSTATS_HOOK(UniformMatrix3fv);
+    GLSTATS_HOOK(UniformMatrix4fv);
+    GLSTATS_HOOK(BindRenderbuffer);
+    GLSTATS_HOOK(BlitFramebuffer);
+    GLSTATS_HOOK(GenerateMipmap);
+    GLSTATS_HOOK(VertexAttribPointer);
+    GLSTATS_HOOK(VertexAttribIPointer);
+    GLSTATS_HOOK(EnableVertexAttribArray);
+    GLSTATS_HOOK(DisableVertexAttribArray);
+    GLSTATS_HOOK(FramebufferTexture2D);
+    GLSTATS_HOOK(FramebufferRenderbuffer);
+    GLSTATS_HOOK(RenderbufferStorage);
+    GLSTATS_HOOK(RenderbufferStorageMultisample);
+    GLSTATS_HOOK(BindBufferBase);
+    GLSTATS_HOOK(TexBuffer);
+    GLSTATS_HOOK(UniformBlockBinding);
+
+    installed = true;
+    return true;
+#else
+    return false;
+#endif // __APPLE__
+}
+
+/**
+\brief Zeroes the counts.
+
+*/
+
+void GLStats::reset()
+{
+    counts.drawCalls = 0;
+    counts.stateChanges = 0;
+    counts.uniformCalls = 0;
+    counts.uniformLookups = 0;
+    counts.uploadBytes = 0;
+}
+
+/**
+\brief Returns the counts since the last reset.
+
+*/
+
+const GLCallCounts& GLStats::get()
+{
+    return counts;
+}
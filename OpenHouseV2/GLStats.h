@@ -0,0 +1,64 @@
+#ifndef GLSTATS_H_INCLUDED
+#define GLSTATS_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+/**
+\file GLStats.h
+
+\brief Header file for GLStats.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Counts of the OpenGL calls made since the last GLStats::reset.
+
+*/
+
+struct GLCallCounts
+{
+    long long drawCalls;        ///< glDrawArrays, glDrawElements and glDrawElementsBaseVertex.
+    long long stateChanges;     ///< Program, vertex array, buffer, texture and framebuffer binds and fixed state.
+    long long uniformCalls;     ///< glUniform* uploads.
+    long long uniformLookups;   ///< glGetUniformLocation calls.
+    long long uploadBytes;      ///< Bytes given to glBufferData, glBufferSubData and glTexImage2D.
+};
+
+/**
+\class GLStats
+
+\brief Counts the OpenGL calls the program makes, for the benchmark mode.
+
+The entry points GLEW loads are counted by swapping GLEW's function pointers for
+counting ones in install, after glewInit.  The OpenGL 1.1 ones (the draw calls, texture
+binds and fixed state) are linked straight to the driver, so on Linux this file
+defines them itself and forwards to the driver's through dlsym.  Those pass every call
+straight through until install is called, and after it count only the calls made on
+the thread that called it, so SFML's own calls and play before then are not touched.
+Elsewhere, and on macOS where there is no GLEW, only what can be hooked is counted.
+
+Counting costs an add per call, and a test of a thread local flag per OpenGL 1.1 call
+when not installed.  Only the render thread is counted, so the counts are not atomic.
+The same hooks hand each call to GLCapture while a frame is
+captured, with a few more (clears, texture parameters, vertex attribute layouts and
+renderbuffers) that are captured but not counted.
+
+*/
+
+class GLStats
+{
+public:
+    static bool install();
+    static void reset();
+    static const GLCallCounts& get();
+};
+
+#endif // GLSTATS_H_INCLUDED
@@ -4,7 +4,7 @@
 \file GraphicsEngine.cpp
 \brief Main graphics driver for the program.
 
-This class extends sf::RenderWindow.
+This class owns the program's sf::RenderWindow, or draws offscreen for the benchmark mode.
 
 \author    Don Spickler Modified by Brian Bowers
 \version   1.5
@@ -20,14 +20,23 @@ This class extends sf::RenderWindow.
 \param MinorVer --- The OpenGL minor version that is requested.
 \param width --- The width (in pixels) of the graphics window.
 \param height --- The height (in pixels) of the graphics window.
+\param netConfig --- Network match to host or join, NULL to play locally.
+\param offscreen --- No window, draw with the context already current and step the game
+logic with benchTick.
 
 Creates rendering window, loads the shaders, and sets some initial data settings.
 
 */
 
-GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer, int width, int height) :
-    sf::RenderWindow(sf::VideoMode(width, height), title, sf::Style::Default,
-                     sf::ContextSettings(24, 8, 4, MajorVer, MinorVer, sf::ContextSettings::Core))
+GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer, int width, int height, const NetConfig* netConfig,
+                               bool offscreen) :
+    window(offscreen ? NULL :
+           new sf::RenderWindow(sf::VideoMode(width, height), title, sf::Style::Default,
+                                sf::ContextSettings(24, 8, 4, MajorVer, MinorVer, sf::ContextSettings::Core))),
+    offscreenSize(width, height),
+    simThread(&GraphicsEngine::simulationLoop, this),
+    sim(&fighterClass[0], &fighterClass[1], &simTable),
+    net(&sim)
 {
     //Define the 2D Shader
     fragShader2DPass =
@@ -66,13 +75,38 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
     text.setScreenSize(getSize().x, getSize().y);
     */
 
+    //  Setup the HUD quads, added in draw order.  The centers, heights and backing colors never change.
+    hpBar1 = hud.addQuad(-1, 1.35);
+    hpBar2 = hud.addQuad(1, 1.35);
+    behindBar2 = hud.addQuad(1, 1.35, 1, 1.03);
+    hud.setAllColor(behindBar2, 0, 0.2);
+    behindBar1 = hud.addQuad(-1, 1.35, 1, 1.03);
+    hud.setAllColor(behindBar1, 0, 0.2);
+
+    //  Nothing in the arenas is meaningful past the back wall, so the cars are dropped
+    //  once they drive well past the street.
+    frustum.setMaxDistance(300);
+
+    //  GPU timestamps for the profiler, the graph is off until F3.
+    Profiler::get().initGPU();
+    profileOn = false;
+    traceCount = 0;
+    capturePending = false;
+    captureCount = 0;
+    recordingCount = 1;
+    shadowArena = -1;
+
     drawAxes = false;
 
-    //  Load cubemap shaders and texture.
+    //  Load cubemap shaders and texture.  The three compile at once in a shader cache
+    //  batch, a failed one is reported by endBatch.
 
-    CMprogram = LoadShadersFromFile("VertexShaderCubeMap.glsl", "FragmentCubeMap.glsl");
+    ShaderCache::beginBatch();
+    CMprogram = ShaderLibrary::load("VertexShaderCubeMap.glsl", "FragmentCubeMap.glsl");
+    depthProgram = ShaderLibrary::load("ShadowDepthVertex.glsl", "ShadowDepthFragment.glsl");
     //Testing for weird cube map
-    WeirdProgram = LoadShadersFromFile("AspectRatioVert.glsl", "StrangeFrag.glsl");
+    WeirdProgram = ShaderLibrary::load("AspectRatioVert.glsl", "StrangeFrag.glsl");
+    bool shadersBuilt = ShaderCache::endBatch();
 
     glUseProgram(WeirdProgram);
 
@@ -86,7 +120,7 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
 
     glUseProgram(program);
 
-    if (!CMprogram)
+    if (!CMprogram || !shadersBuilt)
     {
         std::cerr << "Could not load Cube Map Shader programs." << std::endl;
         exit(EXIT_FAILURE);
@@ -188,31 +222,22 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
 */
     //sMesh = new BasicMesh();
 //    sMesh = new SkinnedMesh();
-    gMesh[0] = new SkinnedMesh();
-    gMesh[1] = new SkinnedMesh();
-    mMesh[0] = new SkinnedMesh();
-    mMesh[1] = new SkinnedMesh();
-    /*
-    if (!mMesh->LoadMesh("Models/animTest/multiAnim.fbx")){
-        printf("Failed to load with assimp!");
-    }
-    //*/
-    //This is the HandFighter, works very well
-    for(int i = 0; i < 2; i++){
-        if (!gMesh[i]->LoadMesh("Models/handFighter/handFighter2.fbx")){
-            printf("Failed to load with assimp!");
-        }
-        //*
-        if (!mMesh[i]->LoadMesh("Models/animTest/mondayMemo.fbx")){
-            printf("Failed to load with assimp!");
-        }
-        /*
-        if (!mMesh[i]->LoadMesh("Models/animTest/mondayMemoDisc.fbx")){
-            printf("Failed to load with assimp!");
-        }
-        */
+
+    //Fighter definitions, the game logic and the renderer each keep a copy
+    if (!simTable.load(FIGHTER_LIST))
+    {
+        std::cerr << "Could not load the fighters." << std::endl;
+        exit(EXIT_FAILURE);
     }
-    //*
+    drawTable = simTable;
+    fighterVersion = 0;
+    drawFighterVersion = 0;
+    //The game logic was reset before the table was loaded
+    sim.reset();
+
+    //Skinned fighters, the hand fighter and Monday Memo, and the crowd made of them
+    crowdOn = false;
+    loadFighterMeshes();
 
     /*
     if (!gMesh->LoadMesh("Models/animTest/testAnimSkelii.fbx")){
@@ -241,6 +266,64 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
     pSkinningTech->SetSpecularExponentTextureUnit(6);
 
 
+    //  The lights and how many the models have, before the models are loaded so their
+    //  programs are built for them.
+    for (int i = 0; i < 3; i++)
+        lt[i].setLight(true,
+                       30.0, 30.0, 30.0, 1.0,
+                       -1.0, -1.0, -1.0,
+                       0.0, 0.0, 0.0, 1.0,
+                       0.70, 0.70, 0.70, 1.0,
+                       0.70, 0.70, 0.70, 1.0,
+                       180.0, 10.0,
+                       1.0, 0.0, 0.0
+                      );
+
+    for (int i = 0; i < 3; i++)
+    {
+        lt[i].setPosition(glm::vec4(LtPos[i].getPosition(), 1.0));
+        lt[i].setSpotDirection(-LtPos[i].getPosition());
+    }
+
+    //INITIALLIZE OBJ NUMB OF LIGHTS + SET LIGHTS
+
+    //Arena One
+    objmodel.setNumberOfLights(3);
+    objmodel2.setNumberOfLights(3);
+    voltsWagon.setNumberOfLights(3);
+    fence.setNumberOfLights(3);
+    blackCar.setNumberOfLights(3);
+
+    //Arena Zero
+    bathHouse.setNumberOfLights(3);
+    tree1.setNumberOfLights(3);
+    tree2.setNumberOfLights(3);
+
+    //Main Menu
+    column.setNumberOfLights(3);
+
+    //Fighter
+    for (int i = 0; i < 24; i++)
+        fighterOne[i].setNumberOfLights(3);
+
+    for (int i = 0; i < 3; i++)
+    {
+        objmodel.setLight(i, lt[i]);
+        objmodel2.setLight(i, lt[i]);
+        voltsWagon.setLight(i, lt[i]);
+        fence.setLight(i, lt[i]);
+        blackCar.setLight(i, lt[i]);
+
+        bathHouse.setLight(i, lt[i]);
+        tree1.setLight(1, lt[i]);
+        tree2.setLight(1, lt[i]);
+
+        column.setLight(1, lt[i]);
+
+        for (int x = 0; x < 24; x++)
+            fighterOne[x].setLight(i, lt[i]);
+    }
+
     //  Load Wavwfront models
     //Arena One: Night City Alley
     voltsWagon.Load("Models/LowPol/","Car_Low_Poly.obj");
@@ -303,8 +386,9 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
     for (int i = 0; i < 24; i++)
         fighterOne[i].setTextureRatio(0.3);
 
-    //  Load the shaders
-    program = LoadShadersFromFile("VertexShaderLightingTexture.glsl", "PhongMultipleLightsAndTexture.glsl");
+    //  Load the shaders, built for the lights
+    program = 0;
+    selectLightProgram();
 
     if (!program)
     {
@@ -312,35 +396,26 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
         exit(EXIT_FAILURE);
     }
 
-    // Turn on the shader & get location of transformation matrix.
-    glUseProgram(program);
-    PVMLoc = glGetUniformLocation(program, "PVM");
-    ModelLoc = glGetUniformLocation(program, "Model");
-    NormalLoc = glGetUniformLocation(program, "NormalMatrix");
-    useTextureLoc = glGetUniformLocation(program, "useTexture");
-    texTransLoc = glGetUniformLocation(program, "textrans");
-
     // Initialize some data.
     mode = GL_FILL;
     sscount = 1;
     CameraNumber = 2;
     restartVid = false;
-    PauseVideo = false;
 
     // Set position of spherical camera
     sphcamera.setPosition(30, 30, 20);
 
     glEnable(GL_DEPTH_TEST);
 
-    if (SetVS)
+    if (window && SetVS)
     {
-        setVerticalSyncEnabled(true);
-        setFramerateLimit(60);
+        window->setVerticalSyncEnabled(true);
+        window->setFramerateLimit(60);
     }
-    else
+    else if (window)
     {
-        setVerticalSyncEnabled(false);
-        setFramerateLimit(0);
+        window->setVerticalSyncEnabled(false);
+        window->setFramerateLimit(0);
     }
 
     //Initialize Screen and floor obj
@@ -351,20 +426,8 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
 
     mat = Materials::bluePlastic;
 
-    for (int i = 0; i < 3; i++)
-        lt[i].setLight(true,
-                       30.0, 30.0, 30.0, 1.0,
-                       -1.0, -1.0, -1.0,
-                       0.0, 0.0, 0.0, 1.0,
-                       0.70, 0.70, 0.70, 1.0,
-                       0.70, 0.70, 0.70, 1.0,
-                       180.0, 10.0,
-                       1.0, 0.0, 0.0
-                      );
-
     LoadLights(lt, "Lt", 3);
     loadMaterial(mat);
-    glUniform1i(glGetUniformLocation(program, "numLights"), 3);
 
     //INITIALLIZE OBJ GLOBAL AMBIENT
     glm::vec4 GlobalAmbient(0.02, 0.02, 0.02, 1);
@@ -401,50 +464,6 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
     LtPos[2].setPsi(-55);
     LtPos[2].setR(1);
 */
-    for (int i = 0; i < 3; i++)
-    {
-        lt[i].setPosition(glm::vec4(LtPos[i].getPosition(), 1.0));
-        lt[i].setSpotDirection(-LtPos[i].getPosition());
-    }
-
-    //INITIALLIZE OBJ NUMB OF LIGHTS + SET LIGHTS
-
-    //Arena One
-    objmodel.setNumberOfLights(3);
-    objmodel2.setNumberOfLights(3);
-    voltsWagon.setNumberOfLights(3);
-    fence.setNumberOfLights(3);
-    blackCar.setNumberOfLights(3);
-
-    //Arena Zero
-    bathHouse.setNumberOfLights(3);
-    tree1.setNumberOfLights(3);
-    tree2.setNumberOfLights(3);
-
-    //Main Menu
-    column.setNumberOfLights(3);
-
-    //Fighter
-    for (int i = 0; i < 24; i++)
-        fighterOne[i].setNumberOfLights(3);
-
-    for (int i = 0; i < 3; i++)
-    {
-        objmodel.setLight(i, lt[i]);
-        objmodel2.setLight(i, lt[i]);
-        voltsWagon.setLight(i, lt[i]);
-        fence.setLight(i, lt[i]);
-        blackCar.setLight(i, lt[i]);
-
-        bathHouse.setLight(i, lt[i]);
-        tree1.setLight(1, lt[i]);
-        tree2.setLight(1, lt[i]);
-
-        column.setLight(1, lt[i]);
-
-        for (int x = 0; x < 24; x++)
-            fighterOne[x].setLight(i, lt[i]);
-    }
     //Arena One
     objmodel.setModelMatrix(glm::scale(glm::mat4(1.0), glm::vec3(objectScale, objectScale, objectScale)));
     objmodel2.setModelMatrix(glm::scale(glm::mat4(1.0), glm::vec3(objectScale, objectScale, objectScale)));
@@ -704,21 +723,29 @@ GraphicsEngine::GraphicsEngine(std::string title, GLint MajorVer, GLint MinorVer
         strike.setBuffer(strikeBuffer);
 */
 
-fighterClass[0].newFighter(0, 3); // Important to change later, right now set to hand fighter by default
-fighterClass[1].newFighter(1, 1);
+//The game logic starts on the main menu, see MatchSim::reset
+replaying = false;
+recordCount = 1;
 
-cameraPos = 0;
-cameraX = 0;
-cameraZ = 100;
-//Sets default "arena" to the main menu
-arenaNum = 3;
+//A network match that cannot be opened falls back to local play
+if (netConfig && !net.open(*netConfig))
+    std::cerr << "Network play not started, playing locally." << std::endl;
 
-//Used for skeletal animation;
-StartTimeMillis[0] = GetCurrentTimeMillis();
-StartTimeMillis[1] = GetCurrentTimeMillis();
+//First snapshot is published here so the renderer has a state before the thread runs
+publishSnapshot();
+snapshots.acquire();
+frameState = &snapshots.read();
+interpolateSimState();
+
+//Offscreen the caller steps the game logic, see benchTick
+simRunning = true;
+simClock.reset();
+if (window)
+    simThread.launch();
 
 //Concluding Statements
-    setActive();
+    if (window)
+        window->setActive();
     glClearColor(0, 0, 0, 1);
     resize();
 }
@@ -731,7 +758,72 @@ Currently empty, no allocated memory to clear.
 
 */
 
-GraphicsEngine::~GraphicsEngine() {}
+GraphicsEngine::~GraphicsEngine()
+{
+    simRunning = false;
+    simThread.wait();
+    grabber.release();
+    clusters.release();
+    shadows.release();
+    Profiler::get().releaseGPU();
+}
+
+/**
+\brief Looks up the locations of the uniforms the engine sets in the main, background
+and depth pre-pass programs, again when ShaderLibrary rebuilt them.
+
+*/
+
+void GraphicsEngine::findUniforms()
+{
+    PVMLoc = glGetUniformLocation(program, "PVM");
+    ModelLoc = glGetUniformLocation(program, "Model");
+    NormalLoc = glGetUniformLocation(program, "NormalMatrix");
+    useTextureLoc = glGetUniformLocation(program, "useTexture");
+    texTransLoc = glGetUniformLocation(program, "textrans");
+
+    projLoc = glGetUniformLocation(WeirdProgram, "Projection");
+    timeGG = glGetUniformLocation(WeirdProgram, "time");
+    flopLoc = glGetUniformLocation(WeirdProgram, "flopper");
+    gFlopLoc = glGetUniformLocation(WeirdProgram, "gFlopper");
+
+    depthPVMLoc = glGetUniformLocation(depthProgram, "PVM");
+}
+
+/**
+\brief Switches the main program to the permutation for the scene's lights, their
+number and kinds, when they changed.  The new program gets the uniform values of the
+old one and is made current.
+
+*/
+
+void GraphicsEngine::selectLightProgram()
+{
+    std::string lights = Light::shaderDefines(lt, 3) + " " + LightClusters::shaderDefines() + " " +
+                         ShadowMaps::shaderDefines();
+    if (program && lights == lightDefines)
+        return;
+
+    // Not tried again every frame if the permutation does not build.
+    lightDefines = lights;
+
+    GLuint lit = ShaderLibrary::load("VertexShaderLightingTexture.glsl", "PhongMultipleLightsAndTexture.glsl", lights);
+    if (!lit)
+        return;
+
+    LightClusters::bindProgram(lit);
+    ShadowMaps::bindProgram(lit);
+    if (program)
+    {
+        ShaderLibrary::copyUniforms(program, lit);
+        ShaderLibrary::release(program);
+        glDeleteProgram(program);
+    }
+
+    program = lit;
+    glUseProgram(program);
+    findUniforms();
+}
 
 /**
 \brief The function responsible for drawing to the OpenGL frame buffer.
@@ -742,7 +834,50 @@ This function clears the screen and calls the draw functions of the box and circ
 
 void GraphicsEngine::display()
 {
+    PROFILE_SCOPE("display");
+
+    // Record this frame's OpenGL calls for the replayer when F12 asked for it.
+    char capturefilename[100];
+    bool capturing = false;
+    if (capturePending)
+    {
+        capturePending = false;
+        sprintf(capturefilename, "GLCapture%d.ohgl", captureCount);
+        capturing = GLCapture::begin(capturefilename);
+    }
+
+    // Render into the offscreen target at the current internal resolution.
+    scaler.begin(getSize().x, getSize().y);
     glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    overdrawView.begin();
+
+    // Take the newest game state from the simulation thread and blend it for drawing.
+    if (snapshots.acquire())
+        frameState = &snapshots.read();
+    interpolateSimState();
+
+    // The game logic reloaded the fighter files, follow it.
+    if (frameState->fighterVersion != drawFighterVersion)
+    {
+        drawFighterVersion = frameState->fighterVersion;
+        FighterTable fresh;
+        if (fresh.load(FIGHTER_LIST))
+        {
+            drawTable = fresh;
+            loadFighterMeshes();
+        }
+    }
+
+    // Build the shaders again when their files were edited.
+    if (shaderCheck.getElapsedTime().asSeconds() >= 1)
+    {
+        shaderCheck.restart();
+        if (ShaderLibrary::reloadIfChanged())
+        {
+            findUniforms();
+            pSkinningTech->FindUniforms();
+        }
+    }
 
     // Set view matrix via current camera.
     glm::mat4 view(1.0);
@@ -765,6 +900,7 @@ void GraphicsEngine::display()
         lt[i].setPosition(glm::vec4(LtPos[i].getPosition(), 1.0));
         lt[i].setSpotDirection(-LtPos[i].getPosition());
     }
+    selectLightProgram();
     LoadLights(lt, "Lt", 3);
 
     for (int i = 0; i < 3; i++)
@@ -787,144 +923,548 @@ void GraphicsEngine::display()
 
     glUniform3fv(glGetUniformLocation(program, "eye"), 1, glm::value_ptr(eye));
 
-    long long CurrentTimeMillis = GetCurrentTimeMillis();
-    AnimationTimeSec[0] = ((float)(CurrentTimeMillis - StartTimeMillis[0])) / 1000.0f;
-    AnimationTimeSec[1] = ((float)(CurrentTimeMillis - StartTimeMillis[1])) / 1000.0f;
-    //float AnimationTimeSec = ((float)(CurrentTimeMillis - StartTimeMillis)) / 1000.0f;
+    // Planes for culling this frame's objects, also rolls the drawn/culled counters over.
+    frustum.update(projection*view, eye);
+    placeLights(view);
+
+    //Fighters are placed again by loadSelectedFighter, the crowd only stands in the bath house
+    entities.setActive(ENTITY_FIGHTER, false);
+    entities.setActive(ENTITY_CROWD, crowdOn && frameState->arenaNum == 0);
 
     //Call function to load the arena in
-    switch(arenaNum)
+    switch(frameState->arenaNum)
     {
         case 0:
-            loadArenaZero(view, eye);
             //loadFighter(0, view, eye);
             //loadHandFighter(0, view, eye);
-            loadSelectedFighter(curFIndex[0], 0, view, eye);
+            loadSelectedFighter(frameState->curFIndex[0], 0, view, eye);
             //loadFighter(1, view, eye);
-            loadSelectedFighter(curFIndex[1], 1, view, eye);
+            loadSelectedFighter(frameState->curFIndex[1], 1, view, eye);
+            animateEntities();
+            renderShadows();
+            drawEntities(view);
+            loadArenaZero(view, eye);
+            drawSky(view);
+            finishScene();
             activateHUD();
-            yprcamera.setPosition(((fighterClass[0].fighterX[0]+fighterClass[1].fighterX[1])/2), yprcamera.getPosition().y, ((fighterClass[0].fighterX[0]-fighterClass[1].fighterX[1])*(-1) + 25));
-            glUseProgram(CMprogram);
-            glUniformMatrix4fv(glGetUniformLocation(CMprogram, "PVM"), 1, GL_FALSE, glm::value_ptr(projection*view));
-            CMSphere.draw();
-            glUseProgram(program);
+            yprcamera.setPosition(((drawFighterX[0]+drawFighterX[1])/2), yprcamera.getPosition().y, ((drawFighterX[0]-drawFighterX[1])*(-1) + 25));
             break;
 
         case 1:
-            loadSelectedFighter(curFIndex[0], 0, view, eye);
+            loadSelectedFighter(frameState->curFIndex[0], 0, view, eye);
             //loadFighter(1, view, eye);
-            loadSelectedFighter(curFIndex[1], 1, view, eye);
+            loadSelectedFighter(frameState->curFIndex[1], 1, view, eye);
+            animateEntities();
+            renderShadows();
+            drawEntities(view);
             loadArenaOne(view, eye);
             //loadFighter(0, view, eye, false);
             //loadFighter(1, view, eye, false);
+            finishScene();
             activateHUD();
-            yprcamera.setPosition(((fighterClass[0].fighterX[0]+fighterClass[1].fighterX[1])/2), yprcamera.getPosition().y, ((fighterClass[0].fighterX[0]-fighterClass[1].fighterX[1])*(-1) + 25));
+            yprcamera.setPosition(((drawFighterX[0]+drawFighterX[1])/2), yprcamera.getPosition().y, ((drawFighterX[0]-drawFighterX[1])*(-1) + 25));
             //CMSphere.draw();
             //glUseProgram(program);
             break;
 
         case 2:
             //loadArenaTwo(view, eye);
+            finishScene();
             break;
         case 3:
+            renderShadows();
             runMainMenu(view, eye);
+            finishScene();
             //yprcamera.setPosition(((fighterClass[0].fighterX[0]+fighterClass[1].fighterX[1])/2), yprcamera.getPosition().y, ((fighterClass[0].fighterX[0]-fighterClass[1].fighterX[1])*(-1) + 25));
             //DO CAMERA STUFF
             //activateHUD();
             break;
     }
 
-    //Combat Animation
-    for (int i = 0; i < 2; i ++)
-    {
-        if (!PauseVideo)
-        {
-            fighterClass[i].oppTracker(rivalNum[i], curFIndex[i], fighterClass[rivalNum[i]].fighterX[rivalNum[i]], fighterClass[rivalNum[i]].fighterY[rivalNum[i]], fighterClass[rivalNum[i]].attacking[rivalNum[i]], fighterClass[rivalNum[i]].kick[rivalNum[i]], fighterClass[rivalNum[i]].punch[rivalNum[i]], fighterClass[rivalNum[i]].punch2[rivalNum[i]], fighterClass[rivalNum[i]].tornado[rivalNum[i]], fighterClass[i].fighterStun[rivalNum[i]], fighterClass[rivalNum[i]].fighterStun[i]);
-            fighterClass[i].preformActions();
-            //std::cout<< PauseVideo << std::endl;
-        }
-    }
-
     turnLightsOff("Lt", 3);
     glUniform1i(useTextureLoc, false);
 
 //Back to OG programing
     turnLightsOn("Lt", 3);
 
-    sf::RenderWindow::display();
+    // Upscale onto the window and adjust the scale from the GPU frame time.
+    scaler.end();
+
+    // Frame time graph at the window's resolution, over the upscaled scene.
+    if (profileOn)
+    {
+        PROFILE_SCOPE("profile overlay");
+        glUseProgram(program2DPass);
+        profileOverlay.draw(Profiler::get());
+        glUseProgram(program);
+    }
+
+    if (capturing && GLCapture::end())
+    {
+        std::cout << "Saved " << capturefilename << std::endl;
+        captureCount++;
+    }
+
+    // Screenshots and recordings read the finished frame back without waiting on it.
+    grabber.grab(getSize().x, getSize().y);
+
+    {
+        PROFILE_SCOPE("swap");
+        if (window)
+            window->display();
+        else
+            glFlush();
+    }
     //printOpenGLErrors();
 }
 
 /**
-\brief Loads the matrices to the shader.
+\brief Body of the simulation thread.
 
-\param projection --- The projection matrix for the scene.
-\param view --- The view matrix for the scene.
-\param model --- The model matrix for the object.
-\param PVMLocation --- Unsigned integer for the location of the PVM matrix in the shader.
-\param ModelLocation --- Unsigned integer for the location of the model matrix in the shader.
-\param NormalLocation --- Unsigned integer for the location of the normal matrix in the shader.
+Runs the game logic at SimTickRate until the engine is destroyed.  Input queued by the
+event loop is applied before each tick and a snapshot is published after each batch of
+ticks, so a slow frame on the render thread never holds up input handling or hit
+detection.  During a network match NetPlay runs the tick instead, and may not run it
+at all while it waits for the other player.  Nothing here may touch OpenGL.
+
+Once a second the fighter files are checked and reloaded if they changed, except
+during a network match, a recording or a replay, which must keep the rules they
+started with.
 
 */
 
-void GraphicsEngine::loadMatrices(glm::mat4 projection, glm::mat4 view, glm::mat4 model,
-                                  GLuint PVMLocation, GLuint ModelLocation, GLuint NormalLocation)
+void GraphicsEngine::simulationLoop()
 {
-    glUniformMatrix4fv(ModelLocation, 1, GL_FALSE, glm::value_ptr(model));
-    glUniformMatrix4fv(PVMLocation, 1, GL_FALSE, glm::value_ptr(projection*view*model));
+    while (simRunning)
+    {
+        int steps = simClock.advance();
+        for (int i = 0; i < steps; i++)
+            simulationStep();
 
-    glm::mat3 nM(model);
-    glm::mat3 normalMatrix = glm::transpose(glm::inverse(nM));
-    glUniformMatrix3fv(NormalLocation, 1, GL_FALSE, glm::value_ptr(normalMatrix));
+        if (fighterCheck.getElapsedTime().asSeconds() >= 1)
+        {
+            fighterCheck.restart();
+            if (!net.isOpen() && !replaying && !recorder.isRecording() && simTable.reloadIfChanged())
+                fighterVersion++;
+        }
+
+        if (steps > 0)
+            publishSnapshot();
+        else
+            sf::sleep(sf::milliseconds(1));
+    }
 }
 
 /**
-\brief Changes the fill and line mode being used.
+\brief Runs one tick of the game logic, after the input queued before it.
 
 */
 
-void GraphicsEngine::changeMode()
+void GraphicsEngine::simulationStep()
 {
-    if (mode == GL_FILL)
-        mode = GL_LINE;
-    else
-        mode = GL_FILL;
+    SimInput in;
+    while (inputs.pop(in))
+        applyInput(in);
 
-    glPolygonMode(GL_FRONT_AND_BACK, mode);
+    if (net.isOpen())
+    {
+        net.step();
+        return;
+    }
+
+    if (replaying)
+    {
+        while (replayLog.next(sim.tickCount, in))
+            sim.applyInput(in);
+
+        if (replayLog.isDone(sim.tickCount))
+            endReplay();
+    }
+
+    sim.tick();
 }
 
 /**
-\brief Saves a screenshot of the current display to a file, ScreenShot###.png.
+\brief Starts a match for the benchmark mode, offscreen only.
+
+The game logic is reset and, unless the arena is the menu, the fighters are picked and
+the match started right away, without going through the menu.
+
+\param arena --- Arena number, 0 for the bath house, 1 for the alley way and 3 for the menu.
+\param fighterOne --- Player one's fighter ID.
+\param fighterTwo --- Player two's fighter ID.
 
 */
 
-void GraphicsEngine::screenshot()
+void GraphicsEngine::startBenchMatch(int arena, int fighterOne, int fighterTwo)
 {
-    char ssfilename[100];
-    sprintf(ssfilename, "ScreenShot%d.png", sscount);
-    sf::Vector2u windowSize = getSize();
-    sf::Texture texture;
-    texture.create(windowSize.x, windowSize.y);
-    texture.update(*this);
-    sf::Image img = texture.copyToImage();
-    img.saveToFile(ssfilename);
-    sscount++;
+    if (window)
+        return;
+
+    sim.reset();
+    if (arena != 3)
+    {
+        sim.setCurFIndex(0, fighterOne);
+        sim.setCurFIndex(1, fighterTwo);
+        sim.startMatch(arena);
+    }
+    publishSnapshot();
 }
 
 /**
-\brief Handles the resizing events of the window.
+\brief Runs one tick of the game logic and publishes it for the next frame, offscreen
+only.
+
+With no simulation thread the benchmark ticks once a frame, so a run is the same on
+any machine however long its frames take.
 
-Sets the viewport to the entire screen and recalculates the projection matrix.
 */
 
-void GraphicsEngine::resize()
+void GraphicsEngine::benchTick()
 {
-    glViewport(0, 0, getSize().x, getSize().y);
-    projection = glm::perspective(50.0f*degf, (float)getSize().x/getSize().y, 0.01f, 1000.0f);
+    if (window)
+        return;
+
+    simulationStep();
+    publishSnapshot();
 }
 
 /**
-\brief Sets the size of the rendering window.
+\brief Scatters point lights over the arenas for the benchmark, lit through the light
+clusters on top of the scene's lights.
+
+\param count --- Number of lights, 0 for none.
+\param seed --- Seed of their places, colors and ranges.
+
+*/
+
+void GraphicsEngine::setBenchLights(int count, unsigned int seed)
+{
+    benchLights.clear();
+    benchLightRanges.clear();
+    for (int i = 0; i < count; i++)
+    {
+        float r[7];
+        for (int k = 0; k < 7; k++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            r[k] = (seed >> 16) / 65535.0f;
+        }
+
+        glm::vec4 color(0.3f + 0.7f*r[3], 0.3f + 0.7f*r[4], 0.3f + 0.7f*r[5], 1);
+        benchLights.push_back(Light(true, glm::vec4(-40 + 80*r[0], 1 + 11*r[1], -60 + 80*r[2], 1),
+                                    glm::vec3(0, -1, 0), glm::vec4(0), color, color, 180, 0, glm::vec3(1, 0, 0.01f)));
+        benchLightRanges.push_back(8 + 7*r[6]);
+    }
+}
+
+/**
+\brief Applies one input from the event loop, on the simulation thread.
+
+Recording and replay controls are handled here.  Everything else goes to the game
+logic, and into the recording if one is running, except during a replay when live
+input is ignored so the replay stays exact.  During a network match everything goes to
+NetPlay as the local player's input, whichever player's keys it came from.
+
+\param in --- Input taken from the ring.
+
+*/
+
+void GraphicsEngine::applyInput(const SimInput& in)
+{
+    switch (in.type)
+    {
+        case SIM_RECORD:
+            toggleRecording();
+            break;
+        case SIM_REPLAY:
+            startReplay();
+            break;
+        default:
+            if (net.isOpen())
+            {
+                net.addLocalInput(in);
+                break;
+            }
+            if (replaying)
+                break;
+            recorder.record(sim.tickCount, in);
+            sim.applyInput(in);
+            break;
+    }
+}
+
+/**
+\brief Starts or stops recording input, on the simulation thread.
+
+Starting resets the game to the main menu so the log can be replayed from the
+starting state.  Stopping saves the log as InputLog1.ohil, InputLog2.ohil and so on.
+
+*/
+
+void GraphicsEngine::toggleRecording()
+{
+    if (replaying || net.isOpen())
+        return;
+
+    if (!recorder.isRecording())
+    {
+        sim.reset();
+        recorder.begin(SimTickRate);
+        std::cout << "Recording input." << std::endl;
+        return;
+    }
+
+    recorder.end(sim.tickCount, sim.checksum());
+
+    char logFileName[100];
+    sprintf(logFileName, "InputLog%d.ohil", recordCount);
+    if (recorder.save(logFileName))
+    {
+        std::cout << "Saved " << logFileName << ", " << sim.tickCount << " ticks, " << recorder.getSize() << " bytes." << std::endl;
+        lastLogFile = logFileName;
+        recordCount++;
+    }
+}
+
+/**
+\brief Replays the last recorded input log from the starting state, on the simulation thread.
+
+*/
+
+void GraphicsEngine::startReplay()
+{
+    if (recorder.isRecording() || replaying || lastLogFile.empty() || net.isOpen())
+        return;
+
+    if (!replayLog.load(lastLogFile))
+        return;
+
+    sim.reset();
+    replaying = true;
+    std::cout << "Replaying " << lastLogFile << "." << std::endl;
+}
+
+/**
+\brief Ends a replay and reports if it finished on the recorded state, on the simulation thread.
+
+*/
+
+void GraphicsEngine::endReplay()
+{
+    SimInput in;
+    while (replayLog.next(sim.tickCount, in))
+        sim.applyInput(in);
+
+    replaying = false;
+    if (sim.checksum() == replayLog.getChecksum())
+        std::cout << "Replay finished on the recorded state." << std::endl;
+    else
+        std::cout << "Replay diverged from the recording." << std::endl;
+}
+
+/**
+\brief Queues an input for the simulation thread, called from the event loop.
+
+\param type --- One of SimInputType.
+\param player --- Player the input is for.
+\param a --- First argument, depends on the type.
+\param b --- Second argument, depends on the type.
+
+*/
+
+void GraphicsEngine::sendInput(int type, int player, int a, int b)
+{
+    SimInput in;
+    in.type = type;
+    in.player = player;
+    in.a = a;
+    in.b = b;
+
+    if (!inputs.push(in))
+        std::cerr << "Simulation input queue full, input dropped." << std::endl;
+}
+
+/**
+\brief Writes the game state into the snapshot buffer for the renderer.
+
+The tick time is backed off by the time left in the accumulator so the renderer
+blends from when the last tick was due rather than when it ran.
+
+*/
+
+void GraphicsEngine::publishSnapshot()
+{
+    SimSnapshot& snap = snapshots.writeSlot();
+
+    snap.prev = sim.prev;
+    sim.captureState(snap.cur);
+    snap.tickTime = simTime.getElapsedTime().asSeconds() - simClock.getAlpha() * simClock.getTickSeconds();
+    snap.tick = sim.tickCount;
+
+    snap.hp[0] = fighterClass[1].fighterHP[0];
+    snap.hp[1] = fighterClass[0].fighterHP[1];
+    snap.stunned[0] = fighterClass[1].fighterStun[0] || fighterClass[0].stunCounter[0] != 15;
+    snap.stunned[1] = fighterClass[0].fighterStun[1] || fighterClass[1].stunCounter[1] != 15;
+
+    for (int i = 0; i < 2; i++)
+    {
+        snap.animation[i] = fighterClass[i].getFighterAnimation();
+        snap.curFIndex[i] = sim.curFIndex[i];
+    }
+
+    snap.arenaNum = sim.arenaNum;
+    snap.cameraPos = sim.cameraPos;
+    snap.paused = sim.paused;
+    snap.gameOver = sim.gameOver;
+
+    int depth;
+    double resimSeconds;
+    net.takeFrameStats(depth, resimSeconds);
+    snap.netPlay = net.isPlaying();
+    snap.rollbackDepth = depth;
+    snap.resimMs = (float)(resimSeconds * 1000);
+    snap.pingMs = net.getPing();
+    snap.fighterVersion = fighterVersion;
+
+    snapshots.publish();
+}
+
+/**
+\brief Blends the latest snapshot between its two ticks for drawing, on the render thread.
+
+Rotations that jumped by more than a quarter turn in one tick (the tornado spin
+resetting) and cars that wrapped around are not blended.
+
+*/
+
+void GraphicsEngine::interpolateSimState()
+{
+    const SimState& prev = frameState->prev;
+    const SimState& cur = frameState->cur;
+
+    float alpha = (simTime.getElapsedTime().asSeconds() - frameState->tickTime) / simClock.getTickSeconds();
+    if (alpha < 0)
+        alpha = 0;
+    if (alpha > 1 || !window)
+        alpha = 1;
+
+    for (int i = 0; i < 2; i++)
+    {
+        drawFighterX[i] = SimClock::lerp(prev.fighterX[i], cur.fighterX[i], alpha, 5);
+        drawFighterHeight[i] = SimClock::lerp(prev.fighterHeight[i], cur.fighterHeight[i], alpha, 0);
+        drawCarX[i] = SimClock::lerp(prev.carX[i], cur.carX[i], alpha, 100);
+        drawCarAngle[i] = SimClock::lerp(prev.carAngle[i], cur.carAngle[i], alpha, 30);
+    }
+
+    for (int i = 0; i < 24; i++)
+        for (int x = 0; x < 3; x++)
+            drawRotations[i][x] = SimClock::lerp(prev.rotations[i][x], cur.rotations[i][x], alpha, 90);
+
+    drawMenuAngle = SimClock::lerp(prev.menuAngle, cur.menuAngle, alpha, 0);
+    drawCameraX = SimClock::lerp(prev.cameraX, cur.cameraX, alpha, 0);
+    drawCameraZ = SimClock::lerp(prev.cameraZ, cur.cameraZ, alpha, 0);
+}
+
+/**
+\brief Loads the matrices to the shader.
+
+\param projection --- The projection matrix for the scene.
+\param view --- The view matrix for the scene.
+\param model --- The model matrix for the object.
+\param PVMLocation --- Unsigned integer for the location of the PVM matrix in the shader.
+\param ModelLocation --- Unsigned integer for the location of the model matrix in the shader.
+\param NormalLocation --- Unsigned integer for the location of the normal matrix in the shader.
+
+*/
+
+void GraphicsEngine::loadMatrices(glm::mat4 projection, glm::mat4 view, glm::mat4 model,
+                                  GLuint PVMLocation, GLuint ModelLocation, GLuint NormalLocation)
+{
+    glUniformMatrix4fv(ModelLocation, 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(PVMLocation, 1, GL_FALSE, glm::value_ptr(projection*view*model));
+
+    glm::mat3 nM(model);
+    glm::mat3 normalMatrix = glm::transpose(glm::inverse(nM));
+    glUniformMatrix3fv(NormalLocation, 1, GL_FALSE, glm::value_ptr(normalMatrix));
+}
+
+/**
+\brief Changes the fill and line mode being used.
+
+*/
+
+void GraphicsEngine::changeMode()
+{
+    if (mode == GL_FILL)
+        mode = GL_LINE;
+    else
+        mode = GL_FILL;
+
+    glPolygonMode(GL_FRONT_AND_BACK, mode);
+}
+
+/**
+\brief Saves a screenshot of the current display to a file, ScreenShot###.png.
+
+The next frame is read back asynchronously and saved on the grabber's thread, so the
+frame does not stall.
+
+*/
+
+void GraphicsEngine::screenshot()
+{
+    char ssfilename[100];
+    sprintf(ssfilename, "ScreenShot%d.png", sscount);
+    grabber.screenshot(ssfilename);
+    sscount++;
+}
+
+/**
+\brief Starts recording every frame to a video file, or stops the recording.
+
+Recordings are MatchN.y4m, YUV4MPEG2 that ffmpeg and most players read, or MatchN.rgb,
+raw RGB24 frames of the window's size.  The frame rate in the file is 60, the rate the
+game runs at with vertical sync.
+
+\param raw --- Record raw RGB24 instead of YUV4MPEG2.
+
+*/
+
+void GraphicsEngine::toggleVideoRecording(bool raw)
+{
+    if (grabber.isRecording())
+    {
+        grabber.stopRecording();
+        return;
+    }
+
+    char recfilename[100];
+    sprintf(recfilename, raw ? "Match%d.rgb" : "Match%d.y4m", recordingCount);
+    if (grabber.startRecording(recfilename, 60))
+    {
+        std::cout << "Recording " << recfilename;
+        if (raw)
+            std::cout << ", " << getSize().x << "x" << getSize().y << " rgb24";
+        std::cout << std::endl;
+        recordingCount++;
+    }
+}
+
+/**
+\brief Handles the resizing events of the window.
+
+Sets the viewport to the entire screen and recalculates the projection matrix.
+*/
+
+void GraphicsEngine::resize()
+{
+    glViewport(0, 0, getSize().x, getSize().y);
+    projection = glm::perspective(50.0f*degf, (float)getSize().x/getSize().y, 0.01f, 1000.0f);
+}
+
+/**
+\brief Sets the size of the rendering window.
 
 \param width --- the width in pixels of the new size.
 
@@ -934,10 +1474,83 @@ void GraphicsEngine::resize()
 
 void GraphicsEngine::setSize(unsigned int width, unsigned int height)
 {
-    sf::RenderWindow::setSize(sf::Vector2u(width, height));
+    if (window)
+        window->setSize(sf::Vector2u(width, height));
+    else
+        offscreenSize = sf::Vector2u(width, height);
     resize();
 }
 
+/**
+\brief Returns true while the window is open, always true offscreen.
+
+*/
+
+bool GraphicsEngine::isOpen()
+{
+    return !window || window->isOpen();
+}
+
+/**
+\brief Closes the window.
+
+*/
+
+void GraphicsEngine::close()
+{
+    if (window)
+        window->close();
+}
+
+/**
+\brief Takes the next event from the window's queue.
+
+\param event --- Filled with the event.
+
+\return True if there was an event, never offscreen.
+
+*/
+
+bool GraphicsEngine::pollEvent(sf::Event& event)
+{
+    return window && window->pollEvent(event);
+}
+
+/**
+\brief Sets the window's title.
+
+\param title --- New title.
+
+*/
+
+void GraphicsEngine::setTitle(const std::string& title)
+{
+    if (window)
+        window->setTitle(title);
+}
+
+/**
+\brief Returns the size drawn at, the window's or the offscreen size.
+
+*/
+
+sf::Vector2u GraphicsEngine::getSize()
+{
+    if (window)
+        return window->getSize();
+    return offscreenSize;
+}
+
+/**
+\brief Returns true if there is no window, for the benchmark mode.
+
+*/
+
+bool GraphicsEngine::isOffscreen()
+{
+    return !window;
+}
+
 /**
 \brief Returns a pointer to the spherical camera.
 
@@ -1283,77 +1896,397 @@ void GraphicsEngine::toggleLights()
 }
 
 /**
-\brief Toggles the Video Pause
+\brief Toggles the drawing of the axes.
 
 */
 
-void GraphicsEngine::togglePause()
+void GraphicsEngine::restartVideo()
 {
-    if (PauseVideo)
-        PauseVideo = false;
-    else
-        PauseVideo = true;
+    restartVid = true;
 }
 
 /**
-\brief Toggles the drawing of the axes.
+\brief Returns the model matrix of a car of the alley way at its place this frame.
+
+\param car --- 0 for the near car, driving to -x, 1 for the far one, driving to +x.
 
 */
 
-void GraphicsEngine::restartVideo()
+glm::mat4 GraphicsEngine::carMatrix(int car)
 {
-    restartVid = true;
+    glm::mat4 carMod(1.0);
+    carMod = glm::translate(carMod, glm::vec3(drawCarX[car], 0, car == 0 ? -40 : -80));
+    if (car == 1)
+        carMod = glm::rotate(carMod, 180*degf, glm::vec3(0, 1, 0));
+    carMod = glm::scale(carMod, glm::vec3(5, 5, 5));
+    return carMod;
 }
 
 /**
-\brief Loads the first arena
-
-\param view --- Camera
-
-\param eye --- Camera Matrix
+\brief Returns the model matrix of the alley way's fence.
 
 */
 
-void GraphicsEngine::loadArenaOne(glm::mat4 view, glm::vec3 eye)
+glm::mat4 GraphicsEngine::fenceMatrix()
 {
-//Low Polygon Car
+    glm::mat4 fenceMod(1.0);
+    fenceMod = glm::translate(fenceMod, glm::vec3(-45, 0.2, -20));
+    fenceMod = glm::scale(fenceMod, glm::vec3(18, 10, 18));
+    return fenceMod;
+}
 
-    voltsWagon.setEye(eye);
-    voltsWagon.setProjectionMatrix(projection);
-    voltsWagon.setViewMatrix(view);
+/**
+\brief Returns the model matrix of a brick wall of the alley way.
 
-    glm::mat4 voltsMod(1.0);
+\param side --- 0 for the right wall, 1 for the left.
 
-    static float a = 500;
-    static float angle1 = 10;
-    if(!(PauseVideo || gameOver))
-    {
-        if (a >= -500)
-            a -= 8;
-        else
-            a = 500;
+*/
+
+glm::mat4 GraphicsEngine::brickWallMatrix(int side)
+{
+    glm::mat4 brickMod(1.0);
+    brickMod = glm::translate(brickMod, glm::vec3(side == 0 ? 34 : -34, 14, 5));
+    brickMod = glm::rotate(brickMod, (side == 0 ? -70 : 250)*degf, glm::vec3(0, 1, 0));
+    brickMod = glm::scale(brickMod, glm::vec3(30, 35, 12));
+    return brickMod;
+}
+
+/**
+\brief Adds this frame's clustered lights, the headlights of the alley way's cars and
+the benchmark's lights, and assigns them to the clusters of the view.  The headlights
+and any directional or spot light of lt get shadow maps, fit to the view.  Called after
+the camera is placed and before anything is drawn.
+
+\param view --- View matrix of the frame.
+
+*/
+
+void GraphicsEngine::placeLights(glm::mat4 view)
+{
+    PROFILE_SCOPE("light clusters");
+
+    clusters.clear();
+    shadows.clear();
 
-        if (a <= 120 && a >= -120)
+    // The scene's lights are point lights, which cast no shadows, unless one is changed.
+    for (int i = 0; i < 3; i++)
+        shadows.setLtMap(i, shadows.add(lt[i], 150));
+
+    if (frameState->arenaNum == 1)
+    {
+        // Two spots low on the front of each car, the model faces -x.
+        const BoundingVolume& b = voltsWagon.getBounds();
+        glm::vec4 beam(1.0f, 0.95f, 0.8f, 1.0f);
+        for (int car = 0; car < 2; car++)
         {
-            angle1 += 5;
-            LtPos[0].setTheta(angle1);
+            glm::mat4 carMod = carMatrix(car);
+            glm::vec3 dir = glm::normalize(glm::vec3(carMod*glm::vec4(-1.0f, -0.15f, 0.0f, 0.0f)));
+            for (int side = 0; side < 2; side++)
+            {
+                glm::vec4 p(b.boxMin.x, b.boxMin.y + 0.4f*(b.boxMax.y - b.boxMin.y),
+                            b.boxMin.z + (side ? 0.8f : 0.2f)*(b.boxMax.z - b.boxMin.z), 1.0f);
+                Light headlight(true, carMod*p, dir, glm::vec4(0), beam, beam, 25, 8, glm::vec3(1, 0, 0.001f));
+                clusters.add(headlight, 60, shadows.add(headlight, 60));
+            }
         }
-        else
+    }
+
+    for (size_t i = 0; i < benchLights.size(); i++)
+        clusters.add(benchLights[i], benchLightRanges[i]);
+
+    clusters.update(view, projection);
+    shadows.fit(view, projection);
+}
+
+/**
+\brief Draws this frame's shadow maps, after the entities are animated and before
+anything lit is drawn.  The static casters of a map are only drawn when its light moved
+or the arena changed, the cars and the skinned fighters every frame.  The limb fighters
+cast no shadow, and are lit with the maps of the frame before since they are drawn as
+they are placed.
+
+*/
+
+void GraphicsEngine::renderShadows()
+{
+    if (!ShadowMaps::isEnabled())
+        return;
+
+    PROFILE_GPU_SCOPE("shadows");
+    overdrawView.pause();
+    if (frameState->arenaNum != shadowArena)
+    {
+        shadowArena = frameState->arenaNum;
+        shadows.invalidate();
+    }
+
+    for (int m = 0; m < shadows.getCount(); m++)
+    {
+        glm::mat4 light = shadows.getMatrix(m);
+        shadowFrustum.update(light, shadows.getPosition(m));
+
+        if (shadows.beginStatic(m))
+            drawShadowCasters(true);
+        shadows.beginDynamic(m);
+        drawShadowCasters(false);
+
+        shadows.useProgram(true);
+        entities.drawDepth(light, shadows.getPVMLocation(), shadows.getBonesLocation(), shadowFrustum);
+    }
+    shadows.end();
+    overdrawView.resume();
+
+    glUseProgram(program);
+}
+
+/**
+\brief Draws the arena's static or moving casters inside the light's frustum into the
+shadow map begun.
+
+\param still --- True for the ones that never move, the fence and the walls of the alley
+way, false for the cars.
+
+*/
+
+void GraphicsEngine::drawShadowCasters(bool still)
+{
+    if (frameState->arenaNum != 1)
+        return;
+
+    shadows.useProgram(false);
+    if (still)
+    {
+        glm::mat4 fenceMod = fenceMatrix();
+        if (shadowFrustum.isVisible(fence.getBounds(), fenceMod))
         {
-            angle1 = 10;
-            LtPos[0].setTheta(0);
+            shadows.setModel(fenceMod);
+            fence.drawDepth();
         }
+
+        for (int side = 0; side < 2; side++)
+        {
+            glm::mat4 brickMod = brickWallMatrix(side);
+            if (shadowFrustum.isVisible(floor.getBounds(), brickMod))
+            {
+                shadows.setModel(brickMod);
+                floor.draw();
+            }
+        }
+    }
+    else
+    {
+        for (int car = 0; car < 2; car++)
+        {
+            glm::mat4 carMod = carMatrix(car);
+            if (shadowFrustum.isVisible(voltsWagon.getBounds(), carMod))
+            {
+                shadows.setModel(carMod);
+                voltsWagon.drawDepth();
+            }
+        }
+    }
+}
+
+/**
+\brief Draws the opaque objects the arena added to opaque, nearest first.
+
+With the depth pre-pass on they are first drawn into the depth buffer alone with
+depthProgram, pushed back a little by a polygon offset, and then shaded with
+GL_LEQUAL, so only the nearest surface of each pixel is shaded.  The shading pass is
+not counted by the overdraw view while the pre-pass runs.
+
+\param view --- View matrix.
+
+*/
+
+void GraphicsEngine::drawOpaque(glm::mat4 view)
+{
+    opaque.sort();
+
+    bool prepass = DrawOrder::isDepthPrepass() && depthProgram;
+    if (prepass)
+    {
+        PROFILE_GPU_SCOPE("depth prepass");
+        overdrawView.pause();
+        glUseProgram(depthProgram);
+        glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(1.0f, 1.0f);
+
+        for (int i = 0; i < opaque.getCount(); i++)
+            drawSceneObject(opaque.getItem(i), view, true, false);
+
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+        glDepthFunc(GL_LEQUAL);
+        overdrawView.resume();
+    }
+
+    // A material is only loaded again when the kind of object changes.
+    int lastObject = -1;
+    for (int i = 0; i < opaque.getCount(); i++)
+    {
+        const DrawItem& item = opaque.getItem(i);
+        drawSceneObject(item, view, false, item.object != lastObject);
+        lastObject = item.object;
+    }
+
+    if (prepass)
+        glDepthFunc(GL_LESS);
+    glUseProgram(program);
+}
+
+/**
+\brief Draws one object of an arena or the menu.
+
+The Wavefront models draw with their own programs and the planes with program, whose
+matrices, texture transformation and lights the arena set before adding them.
+
+\param item --- Object, its texture and model matrix.
+\param view --- View matrix.
+\param depthOnly --- Draw its triangles alone with depthProgram in use.
+\param newMaterial --- Load the material of the planes, false when the last object
+drawn was of the same kind.
+
+*/
+
+void GraphicsEngine::drawSceneObject(const DrawItem& item, glm::mat4 view, bool depthOnly, bool newMaterial)
+{
+    ObjModel* obj = NULL;
+    switch (item.object)
+    {
+        case SCENE_CAR:
+            obj = &voltsWagon;
+            break;
+        case SCENE_FENCE:
+            obj = &fence;
+            break;
+        case SCENE_BATH_HOUSE:
+            obj = &bathHouse;
+            break;
+        case SCENE_TREE:
+            obj = item.variant == 0 ? &tree1 : &tree2;
+            break;
+        case SCENE_COLUMN:
+            obj = &column;
+            break;
+        case SCENE_BRICK_WALL:
+            mat = Materials::obsidian;
+            break;
+        case SCENE_STREET_BACK:
+            mat = Materials::polishedBronze;
+            break;
+        default:
+            mat = Materials::bluePlastic;
+            break;
+    }
+
+    if (depthOnly)
+    {
+        glUniformMatrix4fv(depthPVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*item.model));
+        if (obj)
+            obj->drawDepth();
+        else if (item.object == SCENE_ASPHALT || item.object == SCENE_MENU_GROUND)
+            screen.draw();
+        else
+            floor.draw();
+        return;
+    }
+
+    if (obj)
+    {
+        obj->setModelMatrix(item.model);
+        obj->draw();
+        return;
+    }
+
+    if (newMaterial)
+        loadMaterial(mat);
+    else
+        glUseProgram(program);
+    glUniform1i(tex1_uniform_loc, item.variant);
+    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*item.model));
+    if (item.object == SCENE_ASPHALT || item.object == SCENE_MENU_GROUND)
+        screen.draw();
+    else
+        floor.draw();
+}
+
+/**
+\brief Draws the cube map sphere of the bath house behind everything drawn.
+
+The sphere's vertex shader puts it on the far plane, and with GL_LEQUAL it is only
+drawn where the depth buffer still holds the clear, without writing depth.
+
+\param view --- View matrix.
+
+*/
+
+void GraphicsEngine::drawSky(glm::mat4 view)
+{
+    PROFILE_GPU_SCOPE("sky");
+    glUseProgram(CMprogram);
+    glUniformMatrix4fv(glGetUniformLocation(CMprogram, "PVM"), 1, GL_FALSE, glm::value_ptr(projection*view));
+    glDepthFunc(GL_LEQUAL);
+    glDepthMask(GL_FALSE);
+    CMSphere.draw();
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LESS);
+    glUseProgram(program);
+}
+
+/**
+\brief Ends the overdraw count of the frame's scene and covers it with the heat map
+when it is shown, before the HUD is drawn.
+
+*/
+
+void GraphicsEngine::finishScene()
+{
+    overdrawView.end(scaler.getWidth(), scaler.getHeight());
+    if (OverdrawView::isVisible())
+    {
+        glUseProgram(program2DPass);
+        overdrawView.draw();
+        glUseProgram(program);
     }
-    //if (angle >= )
-    voltsMod = glm::translate(voltsMod, glm::vec3(a, 0, -40));
-    voltsMod = glm::scale(voltsMod, glm::vec3(5, 5, 5));
+}
+
+/**
+\brief Loads the first arena
+
+\param view --- Camera
+
+\param eye --- Camera Matrix
+
+*/
+
+void GraphicsEngine::loadArenaOne(glm::mat4 view, glm::vec3 eye)
+{
+    PROFILE_GPU_SCOPE("loadArenaOne");
+//Low Polygon Car
+
+    voltsWagon.setEye(eye);
+    voltsWagon.setProjectionMatrix(projection);
+    voltsWagon.setViewMatrix(view);
+
+    opaque.clear(eye);
+
+    glm::mat4 voltsMod(1.0);
+
+    //Car motion is stepped in MatchSim::tick, headlights sweep while it passes the arena
+    if (frameState->cur.carX[0] <= 120 && frameState->cur.carX[0] >= -120)
+        LtPos[0].setTheta(drawCarAngle[0]);
+    else
+        LtPos[0].setTheta(0);
+
+    voltsMod = carMatrix(0);
 
 
     lt[0].setPosition(glm::vec4(LtPos[0].getPosition(), 1.0));
     lt[0].setSpotDirection(-LtPos[0].getPosition());
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*voltsMod));
-    voltsWagon.setModelMatrix(voltsMod);
-    voltsWagon.draw();
+    if (frustum.isVisible(voltsWagon.getBounds(), voltsMod))
+        opaque.add(SCENE_CAR, 0, voltsWagon.getBounds(), voltsMod);
 
 
 //Car Two (Was a different model but decided it would be better to reuse for optimization on loading)
@@ -1369,108 +2302,64 @@ void GraphicsEngine::loadArenaOne(glm::mat4 view, glm::vec3 eye)
 
     glm::mat4 carMod(1.0);
 
-    static float b = -800;
-    static float angle2 = 156;
-    if(!(PauseVideo || gameOver))
-    {
-        if (b <= 800)
-            b += 6;
-        else
-            b = -800;
+    if (frameState->cur.carX[1] <= 120 && frameState->cur.carX[1] >= -120)
+        LtPos[1].setTheta(drawCarAngle[1]);
+    else
+        LtPos[1].setTheta(0);
 
-        if (b <= 120 && b >= -120)
-        {
-            angle2 -= 3;
-            LtPos[1].setTheta(angle2);
-        }
-        else
-        {
-            angle2 = 156;
-            LtPos[1].setTheta(0);
-        }
-    }
-    carMod = glm::translate(carMod, glm::vec3(b, 0, -80));
-    carMod = glm::rotate(carMod, 180*degf, glm::vec3(0, 1, 0));
-    carMod = glm::scale(carMod, glm::vec3(5, 5, 5));
+    carMod = carMatrix(1);
 
     lt[1].setPosition(glm::vec4(LtPos[1].getPosition(), 1.0));
     lt[1].setSpotDirection(-LtPos[1].getPosition());
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*carMod));
-    voltsWagon.setModelMatrix(carMod);
-    voltsWagon.draw();
+    if (frustum.isVisible(voltsWagon.getBounds(), carMod))
+        opaque.add(SCENE_CAR, 1, voltsWagon.getBounds(), carMod);
 
 //FENCE
     fence.setEye(eye);
     fence.setProjectionMatrix(projection);
     fence.setViewMatrix(view);
 
-    glm::mat4 fenceMod(1.0);
-
-    fenceMod = glm::translate(fenceMod, glm::vec3(-45, 0.2, -20));
-
-    fenceMod = glm::scale(fenceMod, glm::vec3(18, 10, 18));
+    glm::mat4 fenceMod = fenceMatrix();
 
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*fenceMod));
-    fence.setModelMatrix(fenceMod);
-    fence.draw();
+    if (frustum.isVisible(fence.getBounds(), fenceMod))
+        opaque.add(SCENE_FENCE, 0, fence.getBounds(), fenceMod);
 
 //OUT OF OBJ MODELS
-    turnLightsOff("Lt", 3);
-    glUniform1i(useTextureLoc, false);
-    glm::mat4 axesscale = glm::scale(glm::mat4(1.0), glm::vec3(10, 10, 10));
-    loadMatrices(projection, view, axesscale, PVMLoc, ModelLoc, NormalLoc);
-
+    turnLightsOn("Lt", 3);
     loadMatrices(projection, view, model, PVMLoc, ModelLoc, NormalLoc);
     glUniformMatrix4fv(texTransLoc, 1, GL_FALSE, glm::value_ptr(textrans));
-    turnLightsOn("Lt", 3);
     glUniform1i(useTextureLoc, true);
 //Right Brick Wall
-    mat = Materials::obsidian;
-    loadMaterial(mat);
-    glm::mat4 brickMod1(1.0);
-    brickMod1 = glm::translate(brickMod1, glm::vec3(34, 14, 5));
-    brickMod1 = glm::rotate(brickMod1, -70*degf, glm::vec3(0, 1, 0));
-    brickMod1 = glm::scale(brickMod1, glm::vec3(30, 35, 12));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*brickMod1));
-    glUniform1i(tex1_uniform_loc, texID);
-    floor.draw();
+    glm::mat4 brickMod1 = brickWallMatrix(0);
+    if (frustum.isVisible(floor.getBounds(), brickMod1))
+        opaque.add(SCENE_BRICK_WALL, texID, floor.getBounds(), brickMod1);
 //Left Brick Wall
-    glm::mat4 brickMod2(1.0);
-    brickMod2 = glm::translate(brickMod2, glm::vec3(-34, 14, 5));
-    brickMod2 = glm::rotate(brickMod2, 250*degf, glm::vec3(0, 1, 0));
-    brickMod2 = glm::scale(brickMod2, glm::vec3(30, 35, 12));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*brickMod2));
-    floor.draw();
+    glm::mat4 brickMod2 = brickWallMatrix(1);
+    if (frustum.isVisible(floor.getBounds(), brickMod2))
+        opaque.add(SCENE_BRICK_WALL, texID, floor.getBounds(), brickMod2);
 //Asfault Ground
-    mat = Materials::bluePlastic;
-    loadMaterial(mat);
     glm::mat4 asfaultMod(1.0);
     //asfaultMod = glm::translate(asfaultMod, glm::vec3(0, 2, 0));
     asfaultMod = glm::translate(asfaultMod, glm::vec3(0, 0, 19));
     asfaultMod = glm::rotate(asfaultMod, 90*degf, glm::vec3(-1, 0, 0));
     asfaultMod = glm::scale(asfaultMod, glm::vec3(20, 20, 4));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*asfaultMod));
-
-    glUniform1i(tex1_uniform_loc, texID2);
-    screen.draw();
+    if (frustum.isVisible(screen.getBounds(), asfaultMod))
+        opaque.add(SCENE_ASPHALT, texID2, screen.getBounds(), asfaultMod);
 //Road Ground
     glm::mat4 roadMod(1.0);
     roadMod = glm::translate(roadMod, glm::vec3(0, 0, -69));
     roadMod = glm::rotate(roadMod, 90*degf, glm::vec3(-1, 0, 0));
     roadMod = glm::scale(roadMod, glm::vec3(100, 50, 0));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*roadMod));
-
-    glUniform1i(tex1_uniform_loc, texID4);
-    floor.draw();
+    if (frustum.isVisible(floor.getBounds(), roadMod))
+        opaque.add(SCENE_ROAD, texID4, floor.getBounds(), roadMod);
 //Background of Street
-    mat = Materials::polishedBronze;
-    loadMaterial(mat);
     glm::mat4 backMod(1.0);
     backMod = glm::translate(backMod, glm::vec3(0, 5, -120));
     backMod = glm::scale(backMod, glm::vec3(120, 120, 0));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*backMod));
-    glUniform1i(tex1_uniform_loc, texID3);
-    floor.draw();
+    if (frustum.isVisible(floor.getBounds(), backMod))
+        opaque.add(SCENE_STREET_BACK, texID3, floor.getBounds(), backMod);
+
+    drawOpaque(view);
 }
 /**
 \brief Loads the main menu
@@ -1482,6 +2371,7 @@ void GraphicsEngine::loadArenaOne(glm::mat4 view, glm::vec3 eye)
 */
 void GraphicsEngine::runMainMenu(glm::mat4 view, glm::vec3 eye)
 {
+    PROFILE_GPU_SCOPE("runMainMenu");
     //Light Pos for Arena Zero
     LtPos[0].setTheta(45);
     LtPos[0].setPsi(45);
@@ -1501,128 +2391,82 @@ void GraphicsEngine::runMainMenu(glm::mat4 view, glm::vec3 eye)
         lt[i].setSpotDirection(-LtPos[i].getPosition());
     }
 
-    //Camera Movements Handler
-    switch (cameraPos)
+    //Camera movements are stepped in MatchSim::tick, the menu position is read from the
+    //snapshot since the member belongs to the simulation thread
+    int cameraPos = frameState->cameraPos;
+    if (cameraPos == 6 || cameraPos == 7)
     {
-        case 0:
-            makeValue(0, 0, 1);
-            makeValue(1, 100, 1);
-            break;
-        case 1:
-            makeValue(0, 0, 1);
-            makeValue(1, 50, 1);
-            break;
-        case 2:
-            makeValue(0, 35, 1);
-            makeValue(1, 50, 1);
-            break;
-        case 3:
-            makeValue(0, -35, 1);
-            makeValue(1, 50, 1);
-            break;
-        case 4:
-            makeValue(0, -10, 0.5);
-            makeValue(1, -10, 0.5);
-            break;
-        case 5:
-            makeValue(0, 10, 0.5);
-            makeValue(1, -10, 0.5);
-            break;
-        case 6:
-            displayFighter(curFIndex[0], 0, view, eye);
-            displayFighter(curFIndex[1], 1, view, eye);
-            makeValue(0, 0, 1);
-            makeValue(1, -30, 1);
-            break;
-        case 7:
-            displayFighter(curFIndex[0], 0, view, eye);
-            displayFighter(curFIndex[1], 1, view, eye);
-            makeValue(0, 0, 1);
-            makeValue(1, -30, 1);
-            break;
+        displayFighter(frameState->curFIndex[0], 0, view, eye);
+        displayFighter(frameState->curFIndex[1], 1, view, eye);
+        animateEntities();
+        drawEntities(view);
     }
 
-    yprcamera.setPosition(cameraX, yprcamera.getPosition().y, cameraZ);
+    yprcamera.setPosition(drawCameraX, yprcamera.getPosition().y, drawCameraZ);
 
     //Column 1 (0 1 0 0)
     column.setEye(eye);
     column.setProjectionMatrix(projection);
     column.setViewMatrix(view);
 
+    opaque.clear(eye);
+
     glm::mat4 colMod(1.0);
 
     colMod = glm::scale(colMod, glm::vec3(0.5, 0.5, 0.5));
     colMod = glm::translate(colMod, glm::vec3(-35, -1, 0));
     //colMod = glm::rotate(bathMod, 90*degf, glm::vec3(0, -1, 0));
 
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*colMod));
-    column.setModelMatrix(colMod);
-    column.draw();
+    if (frustum.isVisible(column.getBounds(), colMod))
+        opaque.add(SCENE_COLUMN, 0, column.getBounds(), colMod);
     //Column 2 (1 0 0 0)
     colMod = glm::translate(colMod, glm::vec3(-70, 0, 0));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*colMod));
-    column.setModelMatrix(colMod);
-    column.draw();
+    if (frustum.isVisible(column.getBounds(), colMod))
+        opaque.add(SCENE_COLUMN, 0, column.getBounds(), colMod);
     //Column 3 (0 0 1 0)
     colMod = glm::mat4(1.0);
 
     colMod = glm::scale(colMod, glm::vec3(0.5, 0.5, 0.5));
     colMod = glm::translate(colMod, glm::vec3(35, -1, 0));
 
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*colMod));
-    column.setModelMatrix(colMod);
-    column.draw();
+    if (frustum.isVisible(column.getBounds(), colMod))
+        opaque.add(SCENE_COLUMN, 0, column.getBounds(), colMod);
     //Column 4 (0 0 0 1)
     colMod = glm::translate(colMod, glm::vec3(70, 0, 0));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*colMod));
-    column.setModelMatrix(colMod);
-    column.draw();
+    if (frustum.isVisible(column.getBounds(), colMod))
+        opaque.add(SCENE_COLUMN, 0, column.getBounds(), colMod);
     //Column 5 (0 1 0)
     colMod = glm::mat4(1.0);
     colMod = glm::translate(colMod, glm::vec3(0, 0, -45));
     colMod = glm::scale(colMod, glm::vec3(0.5, 0.5, 0.5));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*colMod));
-    column.setModelMatrix(colMod);
-    column.draw();
-
-    turnLightsOn("Lt", 3);
-    loadMatrices(projection, view, model, PVMLoc, ModelLoc, NormalLoc);
-    glUniformMatrix4fv(texTransLoc, 1, GL_FALSE, glm::value_ptr(textrans));
-    glUniform1i(useTextureLoc, true);
+    if (frustum.isVisible(column.getBounds(), colMod))
+        opaque.add(SCENE_COLUMN, 0, column.getBounds(), colMod);
 
     //Ground
-    //turnLightsOn("Lt", 3);
+    turnLightsOn("Lt", 3);
     loadMatrices(projection, view, model, PVMLoc, ModelLoc, NormalLoc);
     glUniformMatrix4fv(texTransLoc, 1, GL_FALSE, glm::value_ptr(textrans));
-    //turnLightsOn("Lt", 3);
     glUniform1i(useTextureLoc, true);
 
-    mat = Materials::bluePlastic;
-    loadMaterial(mat);
     glm::mat4 asfaultMod(1.0);
     //asfaultMod = glm::translate(asfaultMod, glm::vec3(0, 2, 0));
     asfaultMod = glm::translate(asfaultMod, glm::vec3(0, 0, 0));
     asfaultMod = glm::rotate(asfaultMod, 90*degf, glm::vec3(-1, 0, 0));
     //asfaultMod = glm::scale(asfaultMod, glm::vec3(30, 30, 4));
     asfaultMod = glm::scale(asfaultMod, glm::vec3(30, 40, 4));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*asfaultMod));
-
-    glUniform1i(tex1_uniform_loc, texID2);
-    screen.draw();
+    if (frustum.isVisible(screen.getBounds(), asfaultMod))
+        opaque.add(SCENE_MENU_GROUND, texID2, screen.getBounds(), asfaultMod);
 
     //Start Blade
     glm::mat4 msgMod(1.0);
 
     msgMod = glm::translate(msgMod, glm::vec3(0, 10, 80));
-    static float angle = 0;
-    angle += 1;
+    float angle = drawMenuAngle;
     //if (cameraPos == 0)
         msgMod = glm::rotate(msgMod, angle*degf, glm::vec3(0, 1, 0));
     msgMod = glm::scale(msgMod, glm::vec3(5, 5, 5));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*msgMod));
-
-    glUniform1i(tex1_uniform_loc, texID5);
-    floor.draw();
+    if (frustum.isVisible(floor.getBounds(), msgMod))
+        opaque.add(SCENE_BLADE, texID5, floor.getBounds(), msgMod);
 
     //Vs Blade
     msgMod = glm::mat4(1.0);
@@ -1630,9 +2474,8 @@ void GraphicsEngine::runMainMenu(glm::mat4 view, glm::vec3 eye)
     if (cameraPos != 1)
         msgMod = glm::rotate(msgMod, angle*degf, glm::vec3(0, 1, 0));
     msgMod = glm::scale(msgMod, glm::vec3(5, 5, 5));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*msgMod));
-    glUniform1i(tex1_uniform_loc, texID6);
-    floor.draw();
+    if (frustum.isVisible(floor.getBounds(), msgMod))
+        opaque.add(SCENE_BLADE, texID6, floor.getBounds(), msgMod);
 
     //Story Mode Blade
     msgMod = glm::mat4(1.0);
@@ -1640,9 +2483,8 @@ void GraphicsEngine::runMainMenu(glm::mat4 view, glm::vec3 eye)
     if (cameraPos != 3)
         msgMod = glm::rotate(msgMod, angle*degf, glm::vec3(0, 1, 0));
     msgMod = glm::scale(msgMod, glm::vec3(5, 5, 5));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*msgMod));
-    glUniform1i(tex1_uniform_loc, texID7);
-    floor.draw();
+    if (frustum.isVisible(floor.getBounds(), msgMod))
+        opaque.add(SCENE_BLADE, texID7, floor.getBounds(), msgMod);
 
     //Vs AI Blade
     msgMod = glm::mat4(1.0);
@@ -1650,9 +2492,8 @@ void GraphicsEngine::runMainMenu(glm::mat4 view, glm::vec3 eye)
     if (cameraPos != 2)
         msgMod = glm::rotate(msgMod, angle*degf, glm::vec3(0, 1, 0));
     msgMod = glm::scale(msgMod, glm::vec3(5, 5, 5));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*msgMod));
-    glUniform1i(tex1_uniform_loc, texID8);
-    floor.draw();
+    if (frustum.isVisible(floor.getBounds(), msgMod))
+        opaque.add(SCENE_BLADE, texID8, floor.getBounds(), msgMod);
 
     //Temple Arena Blade
     msgMod = glm::mat4(1.0);
@@ -1660,9 +2501,8 @@ void GraphicsEngine::runMainMenu(glm::mat4 view, glm::vec3 eye)
     if (cameraPos != 4)
         msgMod = glm::rotate(msgMod, angle*degf, glm::vec3(0, 1, 0));
     msgMod = glm::scale(msgMod, glm::vec3(5, 5, 5));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*msgMod));
-    glUniform1i(tex1_uniform_loc, texID9);
-    floor.draw();
+    if (frustum.isVisible(floor.getBounds(), msgMod))
+        opaque.add(SCENE_BLADE, texID9, floor.getBounds(), msgMod);
 
     //Alley Arena Blade
     msgMod = glm::mat4(1.0);
@@ -1670,208 +2510,20 @@ void GraphicsEngine::runMainMenu(glm::mat4 view, glm::vec3 eye)
     if (cameraPos != 5)
         msgMod = glm::rotate(msgMod, angle*degf, glm::vec3(0, 1, 0));
     msgMod = glm::scale(msgMod, glm::vec3(5, 5, 5));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*msgMod));
-    glUniform1i(tex1_uniform_loc, texID10);
-    floor.draw();
+    if (frustum.isVisible(floor.getBounds(), msgMod))
+        opaque.add(SCENE_BLADE, texID10, floor.getBounds(), msgMod);
 
-    runWeirdProgram(view);
-}
-
-
-void GraphicsEngine::makeValue(float changingVar, float toValue, float rate)
-{
-    bool isX = true;
-    if (changingVar == 0)
-        changingVar = cameraX;
-    else if (changingVar == 1)
-    {
-        changingVar = cameraZ;
-        isX = 0;
-    }
+    drawOpaque(view);
 
-    if (changingVar < toValue)
-        changingVar += rate;
-    else if (changingVar > toValue)
-        changingVar -= rate;
-
-    if (isX)
-        cameraX = changingVar;
-    else
-        cameraZ = changingVar;
-}
-void GraphicsEngine::menuRightSlide()
-{
-    switch (cameraPos)
-    {
-        case 1:
-            cameraPos = 2;
-            break;
-        case 2:
-            cameraPos = 3;
-            break;
-        case 3:
-            cameraPos = 1;
-            break;
-        case 4:
-            cameraPos = 5;
-            break;
-        case 5:
-            cameraPos = 4;
-            break;
-        case 6:
-            //Swaps displayed fighter
-            if (curFIndex[0] == 3)
-                curFIndex[0] = 0;
-            else if (curFIndex[0] == 1)
-                curFIndex[0] = 3;
-            else
-                curFIndex[0]++;
-            break;
-        case 7:
-            //Swaps displayed fighter
-            if (curFIndex[0] == 3)
-                curFIndex[0] = 0;
-            else if (curFIndex[0] == 1)
-                curFIndex[0] = 3;
-            else
-                curFIndex[0]++;
-            break;
-        default:
-            break;
-    }
-    //std::cout<<cameraPos<<std::endl;
-}
-
-void GraphicsEngine::menuLeftSlide()
-{
-    switch (cameraPos)
-    {
-        case 1:
-            cameraPos = 3;
-            break;
-        case 2:
-            cameraPos = 1;
-            break;
-        case 3:
-            cameraPos = 2;
-            break;
-        case 4:
-            cameraPos = 5;
-            break;
-        case 5:
-            cameraPos = 4;
-        case 6:
-            //Swaps displayed fighter
-            if (curFIndex[0] == 0)
-                curFIndex[0] = 3;
-            else if (curFIndex[0] == 3)
-                curFIndex[0] = 1;
-            else
-                curFIndex[0]--;
-            break;
-        case 7:
-            //Swaps displayed fighter
-            if (curFIndex[0] == 3)
-                curFIndex[0] = 0;
-            else if (curFIndex[0] == 3)
-                curFIndex[0] = 1;
-            else
-                curFIndex[0]--;
-            break;
-        default:
-            break;
-    }
-    //std::cout<<cameraPos<<std::endl;
-}
-
-void GraphicsEngine::menuSelect()
-{
-    switch (cameraPos)
-    {
-        case 0:
-            cameraPos = 1;
-            break;
-        case 1:
-            cameraPos = 4;
-            break;
-        case 2:
-            //Goes to Vs Battle options (When gamemode is added)
-            break;
-        case 3:
-            //Goes to Story mode options (When gamemode is added)
-            break;
-        case 4:
-            //arenaNum = 0;
-            //restartGame();
-            cameraPos = 6;//Roman Arena Selected
-            break;
-        case 5:
-            //arenaNum = 1;
-            //restartGame();
-            cameraPos = 7;//Roman Arena Selected
-            break;
-        case 6:
-            arenaNum = 0;//Loads Roman Bath House
-            //Set Correct Fighter IDs
-            fighterClass[0].setFighterID(curFIndex[0], curFIndex[1]);
-            fighterClass[1].setFighterID(curFIndex[1], curFIndex[0]);
-            restartGame();
-            break;
-        case 7:
-            arenaNum = 1;//Loads alley way
-            //Set Correct Fighter IDs
-            fighterClass[0].setFighterID(curFIndex[0], curFIndex[1]);
-            fighterClass[1].setFighterID(curFIndex[1], curFIndex[0]);
-            restartGame();
-            break;
-        default:
-            break;
-    }
-    //std::cout<<cameraPos<<std::endl;
+    //The background sphere is drawn last, over only what the scene left uncovered
+    runWeirdProgram(view);
 }
 
-void GraphicsEngine::menuBackout()
-{
-    switch (cameraPos)
-    {
-        case 1:
-            cameraPos = 0;
-            break;
-        case 2:
-            cameraPos = 0;
-            break;
-        case 3:
-            cameraPos = 0;
-            break;
-        case 4:
-            cameraPos = 1;
-            break;
-        case 5:
-            cameraPos = 1;
-            break;
-        case 6:
-            cameraPos = 4;
-            break;
-        case 7:
-            cameraPos = 5;
-        default:
-            break;
-    }
-    //std::cout<<cameraPos<<std::endl;
-}
 
-void GraphicsEngine::returnToMenu()
-{
-    if (PauseVideo || gameOver)
-    {
-        cameraPos = 1;
-        arenaNum = 3;
-    }
-}
 //Returns Arena Num (for the UI to only allow attacks on non menu arenas && menu selectors on menu only)
 int GraphicsEngine::getArenaNum()
 {
-    return arenaNum;
+    return frameState->arenaNum;
 }
 
 // GraphicsEngine::menuObjLoad()
@@ -1882,6 +2534,7 @@ int GraphicsEngine::getArenaNum()
 
 void GraphicsEngine::loadArenaZero(glm::mat4 view, glm::vec3 eye)
 {
+    PROFILE_GPU_SCOPE("loadArenaZero");
     //Light Pos for Arena Zero
     LtPos[0].setTheta(45);
     LtPos[0].setPsi(45);
@@ -1912,9 +2565,9 @@ void GraphicsEngine::loadArenaZero(glm::mat4 view, glm::vec3 eye)
     bathMod = glm::rotate(bathMod, 90*degf, glm::vec3(0, -1, 0));
     bathMod = glm::scale(bathMod, glm::vec3(5, 5, 5));
 
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*bathMod));
-    bathHouse.setModelMatrix(bathMod);
-    bathHouse.draw();
+    opaque.clear(eye);
+    if (frustum.isVisible(bathHouse.getBounds(), bathMod))
+        opaque.add(SCENE_BATH_HOUSE, 0, bathHouse.getBounds(), bathMod);
 
     //Small Tree
     tree1.setEye(eye);
@@ -1929,9 +2582,8 @@ void GraphicsEngine::loadArenaZero(glm::mat4 view, glm::vec3 eye)
     treeMod = glm::translate(treeMod, glm::vec3(0, -1, -8));
     treeMod = glm::translate(treeMod, glm::vec3(-20.5, 0, 0));
 
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*treeMod));
-    tree1.setModelMatrix(treeMod);
-    tree1.draw();
+    if (frustum.isVisible(tree1.getBounds(), treeMod))
+        opaque.add(SCENE_TREE, 0, tree1.getBounds(), treeMod);
 
 
     //Small Tree
@@ -1946,15 +2598,17 @@ void GraphicsEngine::loadArenaZero(glm::mat4 view, glm::vec3 eye)
     treeMod = glm::scale(treeMod, glm::vec3(10, 10, 10));
     treeMod = glm::translate(treeMod, glm::vec3(3, -2, -8));
 
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*treeMod));
-    tree2.setModelMatrix(treeMod);
-    tree2.draw();
+    if (frustum.isVisible(tree2.getBounds(), treeMod))
+        opaque.add(SCENE_TREE, 1, tree2.getBounds(), treeMod);
+
+    drawOpaque(view);
 }
 
 void GraphicsEngine::activateHUD()
 {
+    PROFILE_GPU_SCOPE("HUD");
     glUseProgram(program2DPass);
-    glViewport(0, 0, getSize().x, getSize().y);
+    glViewport(0, 0, scaler.getWidth(), scaler.getHeight());
 
     //Initilaize text variables
     int starty = getSize().y/20;
@@ -1963,39 +2617,26 @@ void GraphicsEngine::activateHUD()
     //text.setColor(1, 1, 1, 1);
     //text.setFontSize((int)(0.8*starty));
 
-    //Player One's HP bar
-    hpBar1.setCenter(-1, 1.35);
-
-
-    if (fighterClass[1].fighterStun[0] == true || fighterClass[0].stunCounter[0] != 15)
-        hpBar1.setAllColor(0.45, 1);
+    //Player One's HP bar, only quads whose values changed are re-uploaded by the HUD layer
+    if (frameState->stunned[0])
+        hud.setAllColor(hpBar1, 0.45, 1);
     else
     {
-        hpBar1.setAllColor(0, 1);
-        hpBar1.setWidth((fighterClass[1].fighterHP[0]/0.75)/100);
+        hud.setAllColor(hpBar1, 0, 1);
+        hud.setWidth(hpBar1, (frameState->hp[0]/0.75)/100);
     }
-    hpBar1.draw();
 
     //Player Two's HP bar
-    hpBar2.setCenter(1, 1.35);
-
-    if (fighterClass[0].fighterStun[1] == true || fighterClass[1].stunCounter[1] != 15)
-        hpBar2.setAllColor(0.45, 1);
+    if (frameState->stunned[1])
+        hud.setAllColor(hpBar2, 0.45, 1);
     else
     {
-        hpBar2.setAllColor(0, 1);
-        hpBar2.setWidth((fighterClass[0].fighterHP[1]/0.75)/100);
+        hud.setAllColor(hpBar2, 0, 1);
+        hud.setWidth(hpBar2, (frameState->hp[1]/0.75)/100);
     }
-    hpBar2.draw();
 
-    behindBar1.setCenter(-1, 1.35);
-    behindBar1.setAllColor(0, 0.2);
-    behindBar1.setHeight(1.03);
-    behindBar2.setCenter(1, 1.35);
-    behindBar2.setAllColor(0, 0.2);
-    behindBar2.setHeight(1.03);
-    behindBar2.draw();
-    behindBar1.draw();
+    //All four bars in one draw call
+    hud.draw();
 //Pause and Game Over Stuff (Gotta redue without the Text Renderer so I don't have to deal with VS code compilation garbage)
 /*
     if (fighterClass[0].fighterHP[1] <= 0 || fighterClass[1].fighterHP[0] <= 0)
@@ -2008,12 +2649,11 @@ void GraphicsEngine::activateHUD()
             text.setColor(1, 0, 0, 1);
         else
             text.setColor(1, 1, 1, 1);
+        TextRendererTTFLayout fit = text.layoutText("-Game Over-", getSize().x * 0.9, ftsz);
+        ftsz = fit.fontSize;
         text.setFontSize(ftsz);
 
-        while (text.textWidth("-Game Over-") > getSize().x * 0.9)
-        text.setFontSize(--ftsz);
-
-        int x = (getSize().x - text.textWidth("-Game Over-"))/2;
+        int x = (getSize().x - fit.width)/2;
         int y = (getSize().y)/2;
 
         if (x < 1)
@@ -2037,10 +2677,11 @@ void GraphicsEngine::activateHUD()
             text.draw(playerOneWin, (getSize().x/2)-startx/2, getSize().y/2-startx/2);
         }
 
-        while (text.textWidth("-Press Z for Menu-") > getSize().x * 0.9)
-        text.setFontSize(--ftsz);
+        fit = text.layoutText("-Press Z for Menu-", getSize().x * 0.9, ftsz);
+        ftsz = fit.fontSize;
+        text.setFontSize(ftsz);
 
-        x = (getSize().x - text.textWidth("-Press Z for Menu-"))/2;
+        x = (getSize().x - fit.width)/2;
         y = (getSize().y)/2;
 
         if (x < 1)
@@ -2058,12 +2699,11 @@ void GraphicsEngine::activateHUD()
             text.setColor(1, 0, 0, 1);
         else
             text.setColor(1, 1, 1, 1);
+        TextRendererTTFLayout fit = text.layoutText("-Game Paused-", getSize().x * 0.9, ftsz);
+        ftsz = fit.fontSize;
         text.setFontSize(ftsz);
 
-        while (text.textWidth("-Game Paused-") > getSize().x * 0.9)
-        text.setFontSize(--ftsz);
-
-        int x = (getSize().x - text.textWidth("-Game Paused-"))/2;
+        int x = (getSize().x - fit.width)/2;
         int y = (getSize().y)/2;
 
         if (x < 1)
@@ -2073,10 +2713,11 @@ void GraphicsEngine::activateHUD()
 
         text.draw("-Game Paused-", x, y);
 
-        while (text.textWidth("-Press Z for Menu-") > getSize().x * 0.9)
-        text.setFontSize(--ftsz);
+        fit = text.layoutText("-Press Z for Menu-", getSize().x * 0.9, ftsz);
+        ftsz = fit.fontSize;
+        text.setFontSize(ftsz);
 
-        x = (getSize().x - text.textWidth("-Press Z for Menu-"))/2;
+        x = (getSize().x - fit.width)/2;
         y = (getSize().y)/2;
 
         if (x < 1)
@@ -2102,6 +2743,7 @@ void GraphicsEngine::activateHUD()
 */
 void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool menuMode)
 {
+    PROFILE_GPU_SCOPE("loadFighter");
     for (int i = 0; i < 12; i++)
     {
         fighterOne[i+addNum[fiNum]].setEye(eye);
@@ -2111,7 +2753,7 @@ void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool
 
     ModelMatrix[fiNum] = glm::mat4(1.0);
     if (!menuMode){
-        ModelMatrix[fiNum] = glm::translate(ModelMatrix[fiNum], glm::vec3(fighterClass[fiNum].fighterX[fiNum], fighterClass[fiNum].fighterY[fiNum]+0.7, 0));
+        ModelMatrix[fiNum] = glm::translate(ModelMatrix[fiNum], glm::vec3(drawFighterX[fiNum], fighterClass[fiNum].fighterY[fiNum]+0.7, 0));
     }
     else{
         ModelMatrix[fiNum] = glm::translate(ModelMatrix[fiNum], glm::vec3(fighterClass[fiNum].fighterDir[fiNum]*-14, fighterClass[fiNum].fighterY[fiNum]+0.7, -60));
@@ -2131,15 +2773,16 @@ void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool
     {
         if (i == 0)
         {
-            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
-            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
-            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
+            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], drawRotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
+            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], drawRotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
+            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], drawRotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
             ModelMatrix[fiNum] = glm::scale(ModelMatrix[fiNum], glm::vec3(0.5, 0.5, 0.5));
 
             glUniformMatrix4fv(ModelLoc, 1, GL_FALSE, glm::value_ptr(ModelMatrix[fiNum]));
 
             fighterOne[i+addNum[fiNum]].setModelMatrix(ModelMatrix[fiNum]);
-            fighterOne[i+addNum[fiNum]].draw();
+            if (frustum.isVisible(fighterOne[i+addNum[fiNum]].getBounds(), ModelMatrix[fiNum]))
+                fighterOne[i+addNum[fiNum]].draw();
 
             ModelMatrix[fiNum] = glm::scale(ModelMatrix[fiNum], glm::vec3(1/0.5, 1/0.5, 1/0.5));
             //Set the other Matrices as children of the torso
@@ -2156,23 +2799,24 @@ void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool
         }
         else if (i == 1)
         {
-            headMat[fiNum] = glm::rotate(headMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
-            headMat[fiNum] = glm::rotate(headMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
-            headMat[fiNum] = glm::rotate(headMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
+            headMat[fiNum] = glm::rotate(headMat[fiNum], drawRotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
+            headMat[fiNum] = glm::rotate(headMat[fiNum], drawRotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
+            headMat[fiNum] = glm::rotate(headMat[fiNum], drawRotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
 
             headMat[fiNum] = glm::scale(headMat[fiNum], glm::vec3(0.5, 0.5, 0.5));
 
             glUniformMatrix4fv(ModelLoc, 1, GL_FALSE, glm::value_ptr(headMat[fiNum]));
 
             fighterOne[i+addNum[fiNum]].setModelMatrix(headMat[fiNum]);
-            fighterOne[i+addNum[fiNum]].draw();
+            if (frustum.isVisible(fighterOne[i+addNum[fiNum]].getBounds(), headMat[fiNum]))
+                fighterOne[i+addNum[fiNum]].draw();
         }
         else if (i >= 2 && i <= 4)
         {
             //Rotate Arms
-            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
-            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
-            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
+            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], drawRotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
+            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], drawRotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
+            ModelMatrix[fiNum] = glm::rotate(ModelMatrix[fiNum], drawRotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
             // Scale
             ModelMatrix[fiNum] = glm::scale(ModelMatrix[fiNum], glm::vec3(0.5, 0.5, 0.5));
 
@@ -2181,7 +2825,8 @@ void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool
 
             // Draw
             fighterOne[i+addNum[fiNum]].setModelMatrix(ModelMatrix[fiNum]);
-            fighterOne[i+addNum[fiNum]].draw();
+            if (frustum.isVisible(fighterOne[i+addNum[fiNum]].getBounds(), ModelMatrix[fiNum]))
+                fighterOne[i+addNum[fiNum]].draw();
 
             // Scale back
             ModelMatrix[fiNum] = glm::scale(ModelMatrix[fiNum], glm::vec3(1/0.5, 1/0.5, 1/0.5));
@@ -2191,16 +2836,17 @@ void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool
         else if (i >=5 && i <= 7)
         {
             //Left Arm
-            leftArmMat[fiNum] = glm::rotate(leftArmMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
-            leftArmMat[fiNum] = glm::rotate(leftArmMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
-            leftArmMat[fiNum] = glm::rotate(leftArmMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
+            leftArmMat[fiNum] = glm::rotate(leftArmMat[fiNum], drawRotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
+            leftArmMat[fiNum] = glm::rotate(leftArmMat[fiNum], drawRotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
+            leftArmMat[fiNum] = glm::rotate(leftArmMat[fiNum], drawRotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
 
             leftArmMat[fiNum] = glm::scale(leftArmMat[fiNum], glm::vec3(0.5, 0.5, 0.5));
 
             glUniformMatrix4fv(ModelLoc, 1, GL_FALSE, glm::value_ptr(leftArmMat[fiNum]));
 
             fighterOne[i+addNum[fiNum]].setModelMatrix(leftArmMat[fiNum]);
-            fighterOne[i+addNum[fiNum]].draw();
+            if (frustum.isVisible(fighterOne[i+addNum[fiNum]].getBounds(), leftArmMat[fiNum]))
+                fighterOne[i+addNum[fiNum]].draw();
 
             leftArmMat[fiNum] = glm::scale(leftArmMat[fiNum], glm::vec3(1/0.5, 1/0.5, 1/0.5));
 
@@ -2209,16 +2855,17 @@ void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool
         else if (i >= 8 && i <= 9)
         {
             //Right Leg
-            rightLegMat[fiNum] = glm::rotate(rightLegMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
-            rightLegMat[fiNum] = glm::rotate(rightLegMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
-            rightLegMat[fiNum] = glm::rotate(rightLegMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
+            rightLegMat[fiNum] = glm::rotate(rightLegMat[fiNum], drawRotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
+            rightLegMat[fiNum] = glm::rotate(rightLegMat[fiNum], drawRotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
+            rightLegMat[fiNum] = glm::rotate(rightLegMat[fiNum], drawRotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
 
             rightLegMat[fiNum] = glm::scale(rightLegMat[fiNum], glm::vec3(0.5, 0.5, 0.5));
 
             glUniformMatrix4fv(ModelLoc, 1, GL_FALSE, glm::value_ptr(rightLegMat[fiNum]));
 
             fighterOne[i+addNum[fiNum]].setModelMatrix(rightLegMat[fiNum]);
-            fighterOne[i+addNum[fiNum]].draw();
+            if (frustum.isVisible(fighterOne[i+addNum[fiNum]].getBounds(), rightLegMat[fiNum]))
+                fighterOne[i+addNum[fiNum]].draw();
 
             rightLegMat[fiNum] = glm::scale(rightLegMat[fiNum], glm::vec3(1/0.5, 1/0.5, 1/0.5));
 
@@ -2228,16 +2875,17 @@ void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool
         else if (i >= 10 && i <= 11)
         {
             //Left Leg
-            leftLegMat[fiNum] = glm::rotate(leftLegMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
-            leftLegMat[fiNum] = glm::rotate(leftLegMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
-            leftLegMat[fiNum] = glm::rotate(leftLegMat[fiNum], fighterClass[fiNum].rotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
+            leftLegMat[fiNum] = glm::rotate(leftLegMat[fiNum], drawRotations[i+addNum[fiNum]][2] * degf, glm::vec3(0, 0, 1));
+            leftLegMat[fiNum] = glm::rotate(leftLegMat[fiNum], drawRotations[i+addNum[fiNum]][1] * degf, glm::vec3(0, 1, 0));
+            leftLegMat[fiNum] = glm::rotate(leftLegMat[fiNum], drawRotations[i+addNum[fiNum]][0] * degf, glm::vec3(1, 0, 0));
 
             leftLegMat[fiNum] = glm::scale(leftLegMat[fiNum], glm::vec3(0.5, 0.5, 0.5));
 
             glUniformMatrix4fv(ModelLoc, 1, GL_FALSE, glm::value_ptr(leftLegMat[fiNum]));
 
             fighterOne[i+addNum[fiNum]].setModelMatrix(leftLegMat[fiNum]);
-            fighterOne[i+addNum[fiNum]].draw();
+            if (frustum.isVisible(fighterOne[i+addNum[fiNum]].getBounds(), leftLegMat[fiNum]))
+                fighterOne[i+addNum[fiNum]].draw();
 
             leftLegMat[fiNum] = glm::scale(leftLegMat[fiNum], glm::vec3(1/0.5, 1/0.5, 1/0.5));
 
@@ -2247,154 +2895,173 @@ void GraphicsEngine::loadFighter(int fiNum, glm::mat4 view, glm::vec3 eye, bool
 }
 
 /**
-\brief Graphs to screen the hand fighter
+\brief Loads the meshes of every skinned fighter in drawTable that has none yet or whose
+mesh file changed.  One mesh is shared by both players and the crowd, each entity keeps
+its own animation clock.  The entities are spawned again since they point at the meshes.
 
 */
-void GraphicsEngine::loadHandFighter(int playerNum, glm::mat4 view, glm::vec3 eye, bool menuMode)
+void GraphicsEngine::loadFighterMeshes()
 {
-    glm::mat4 atm(1.0);
-    if(!menuMode){
-        atm = glm::translate(atm, glm::vec3(fighterClass[playerNum].fighterX[playerNum], 3, 0));
-    }
-    else if(menuMode){
-        atm = glm::translate(atm, glm::vec3(fighterClass[playerNum].fighterDir[playerNum]*-14, 3, -60));
+    for (int id = 0; id < FIGHTER_MAX; id++)
+    {
+        std::string file = (id < drawTable.count && drawTable.look[id] == LOOK_SKINNED) ? drawTable.mesh[id] : "";
+        if (file == fighterMeshFile[id])
+            continue;
+
+        delete fighterMesh[id];
+        fighterMesh[id] = NULL;
+        fighterMeshFile[id] = file;
+        if (file.empty())
+            continue;
+
+        fighterMesh[id] = new SkinnedMesh();
+        if (!fighterMesh[id]->LoadMesh(file)){
+            printf("Failed to load with assimp!");
+            delete fighterMesh[id];
+            fighterMesh[id] = NULL;
+        }
     }
 
-    if (playerNum == 1)
-        atm = glm::scale(atm, glm::vec3(-0.009, 0.009, 0.009));
-    else
-        atm = glm::scale(atm, glm::vec3(0.009, 0.009, 0.009));
-
-
-    //atm = glm::scale(glm::mat4(1.0), glm::vec3(0.005, 0.005, 0.005));
-    //atm = glm::translate(atm, glm::vec3(fighterClass[playerNum].fighterX[playerNum], 3, -30));
-    //atm = glm::rotate(atm, 90*degf, glm::vec3(1, 0, 0));
-    //atm = glm::scale(glm::mat4(1.0), glm::vec3(0.03, 0.03, 0.03));
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*atm));
-
-    //pMesh->Render();
-
-    glm::mat4 WVP = projection * view * atm;
-
-    pSkinningTech->SetWVP(WVP);
-
-    pSkinningTech->SetMaterial(gMesh[playerNum]->GetMaterial());
+    spawnEntities();
+}
 
-    vector<Matrix4f> Transforms;
-    //printf("%f\n", AnimationTimeSec);
+/**
+\brief Makes an entity for each player's fighter and CrowdSize for the crowd, in rows
+behind the fighters of the bath house.  The crowd cycles through the skinned fighters,
+each one's members spawned together so the animation system works one mesh at a time.
 
-    //Check to reset animation clock, will need to make these into arrays of two for both fighters
-    if (fighterClass[playerNum].getFighterAnimation() != curAnimIndex[playerNum]){
-        //reset AnimationTimeSec to 0
-        StartTimeMillis[playerNum] = GetCurrentTimeMillis();
-        AnimationTimeSec[playerNum] = ((float)(GetCurrentTimeMillis() - StartTimeMillis[playerNum])) / 1000.0f;
-        //setAnimationIndex
-        gMesh[playerNum]->setAnimationIndex(fighterClass[playerNum].getFighterAnimation());
-        //set current animation
-        curAnimIndex[playerNum] = fighterClass[playerNum].getFighterAnimation();
+*/
+void GraphicsEngine::spawnEntities()
+{
+    entities.clear();
+    for (int p = 0; p < 2; p++)
+        playerEntity[p] = entities.spawn(ENTITY_FIGHTER, NULL, 0, p);
 
+    int skinned[FIGHTER_MAX];
+    int numSkinned = 0;
+    for (int id = 0; id < drawTable.count; id++)
+    {
+        if (fighterMesh[id])
+            skinned[numSkinned++] = id;
     }
-    //printf("PlayerNum=%d, curAnimIndex=%d\n", playerNum, curAnimIndex[playerNum]);
-    gMesh[playerNum]->GetBoneTransforms(AnimationTimeSec[playerNum], Transforms);
+    if (numSkinned == 0)
+        return;
 
+    double now = GetCurrentTimeMillis() / 1000.0;
+    for (int i = 0; i < CrowdSize; i++)
+    {
+        int id = skinned[i * numSkinned / CrowdSize];
+        int e = entities.spawn(ENTITY_CROWD, fighterMesh[id], id, -1);
+        if (e < 0)
+            break;
 
-    for(uint i = 0; i < Transforms.size(); i++){
-        //sMesh->SetBoneTransform(i, Transforms[i]);
-        pSkinningTech->SetBoneTransform(i, Transforms[i]);
+        int column = i % 12;
+        int row = i / 12;
+        entities.posX[e] = -44 + column*8 + (row % 2)*4;
+        entities.posY[e] = drawTable.base[id];
+        entities.posZ[e] = -16 - row*6;
+        entities.scale[e] = drawTable.scale[id];
+        entities.facing[e] = (column % 2) ? -1 : 1;
+        entities.clip[e] = drawTable.anim[ANIM_STANCE][id];
+        entities.clipStart[e] = now - 0.37*i;   //Out of step with each other
+        entities.active[e] = false;
     }
-
-    gMesh[playerNum]->Render();
 }
 
 /**
-\brief Graphs to screen Monday Memo fighter
+\brief Runs the cull and animation systems over the entities placed this frame: culls
+them against the view and the frustums of this frame's shadow maps and works out the
+bones of the ones in any of them, for the shadow maps and drawEntities.
 
 */
-void GraphicsEngine::loadMondayFighter(int playerNum, glm::mat4 view, glm::vec3 eye, bool menuMode)
+void GraphicsEngine::animateEntities()
 {
-    glm::mat4 atm(1.0);
-    if(!menuMode){
-        atm = glm::translate(atm, glm::vec3(fighterClass[playerNum].fighterX[playerNum], fighterClass[playerNum].fighterHeight[playerNum], 0));
-    }
-    else if(menuMode){
-        atm = glm::translate(atm, glm::vec3(fighterClass[playerNum].fighterDir[playerNum]*-14, 0, -60));
+    PROFILE_SCOPE("skinning bones");
+    int shown = entities.cull(frustum);
+    if (ShadowMaps::isEnabled())
+    {
+        for (int m = 0; m < shadows.getCount(); m++)
+        {
+            shadowFrustum.update(shadows.getMatrix(m), shadows.getPosition(m));
+            shown += entities.cullShadows(shadowFrustum);
+        }
     }
 
-    if (playerNum == 1)
-        atm = glm::scale(atm, glm::vec3(-0.0008, 0.0008, 0.0008));
-    else
-        atm = glm::scale(atm, glm::vec3(0.0008, 0.0008, 0.0008));
-
-    glUniformMatrix4fv(PVMLoc, 1, GL_FALSE, glm::value_ptr(projection*view*atm));
+    if (shown > 0)
+        entities.animate(GetCurrentTimeMillis() / 1000.0);
+}
 
-    glm::mat4 WVP = projection * view * atm;
+/**
+\brief Runs the draw system over the entities animateEntities found visible.
 
-    pSkinningTech->SetWVP(WVP);
+\param view --- View matrix.
 
-    pSkinningTech->SetMaterial(mMesh[playerNum]->GetMaterial());
+*/
+void GraphicsEngine::drawEntities(glm::mat4 view)
+{
+    PROFILE_GPU_SCOPE("skinning");
+    entities.draw(pSkinningTech, projection*view, PVMLoc);
+}
 
-    vector<Matrix4f> Transforms;
-    //printf("%f\n", AnimationTimeSec);
+/**
+\brief Places a player's fighter whose look is a skinned mesh, the hand fighter and
+Monday Memo, for drawEntities to draw.
 
-    //Check to reset animation clock, will need to make these into arrays of two for both fighters
-    if (fighterClass[playerNum].getFighterAnimation() != curAnimIndex[playerNum]){
-        //reset AnimationTimeSec to 0
-        StartTimeMillis[playerNum] = GetCurrentTimeMillis();
-        AnimationTimeSec[playerNum] = ((float)(GetCurrentTimeMillis() - StartTimeMillis[playerNum])) / 1000.0f;
-        //setAnimationIndex
-        mMesh[playerNum]->setAnimationIndex(fighterClass[playerNum].getFighterAnimation());
-        //set current animation
-        curAnimIndex[playerNum] = fighterClass[playerNum].getFighterAnimation();
-    }
+\param fighterNum --- Fighter ID.
+\param playerNum --- Player drawn, player two's mesh is mirrored.
+\param view --- View matrix.
+\param eye --- Camera position.
+\param menuMode --- True on the menu, false in a fight.
 
-    mMesh[playerNum]->GetBoneTransforms(AnimationTimeSec[playerNum], Transforms);
+*/
+void GraphicsEngine::loadSkinnedFighter(int fighterNum, int playerNum, glm::mat4 view, glm::vec3 eye, bool menuMode)
+{
+    int e = playerEntity[playerNum];
+    SkinnedMesh* mesh = fighterMesh[fighterNum];
+    if (e < 0 || !mesh)
+        return;
 
+    if (entities.mesh[e] != mesh)
+        entities.setMesh(e, mesh);
+    entities.fighterID[e] = fighterNum;
 
-    for(uint i = 0; i < Transforms.size(); i++){
-        //sMesh->SetBoneTransform(i, Transforms[i]);
-        pSkinningTech->SetBoneTransform(i, Transforms[i]);
+    if(!menuMode){
+        float height = drawTable.base[fighterNum];
+        if (drawTable.followJump[fighterNum])
+            height += drawFighterHeight[playerNum];
+        entities.posX[e] = drawFighterX[playerNum];
+        entities.posY[e] = height;
+        entities.posZ[e] = 0;
+    }
+    else if(menuMode){
+        entities.posX[e] = fighterClass[playerNum].fighterDir[playerNum]*-14;
+        entities.posY[e] = drawTable.base[fighterNum];
+        entities.posZ[e] = -60;
     }
 
-    mMesh[playerNum]->Render();
-}
-
+    entities.scale[e] = drawTable.scale[fighterNum];
+    entities.facing[e] = (playerNum == 1) ? -1 : 1;
 
+    //Restarts the animation clock when the clip changes
+    entities.setClip(e, frameState->animation[playerNum], GetCurrentTimeMillis() / 1000.0);
+    entities.active[e] = true;
+}
 
-/**
-\brief Restarts the game if and only if the game is already over
 
-*/
-void GraphicsEngine::restartGame()
-{
-    //if (gameOver)
-    //{
-    for (int i = 0; i < 2; i++)
-    {
-        fighterClass[i].fighterHP[rivalNum[i]] = 75;
-        fighterClass[i].readyStance(i);
-        fighterClass[i].fighterX[i] = -fighterClass[i].fighterDir[i]*18;
-        fighterClass[i].fighterHeight[i] = 0;
-    }
-    gameOver = false;
-    PauseVideo = false;
-    //}
-}
 
 void GraphicsEngine::displayFighter(int fighterNum, int playerNum, glm::mat4 view, glm::vec3 eye)
 {
     //fighterClass[playerNum].setFighterID(fighterNum, curFIndex[rivalNum[playerNum]]);
-    switch (fighterNum)
+    if (fighterNum < 0 || fighterNum >= drawTable.count)
+        return;
+
+    switch (drawTable.look[fighterNum])
     {
-        case 0:
-            loadHandFighter(playerNum, view, eye, true);
-            break;
-        case 1:
+        case LOOK_LIMBS:
             loadFighter(playerNum, view, eye, true);
             break;
-        case 2:
-            break;
-        case 3:
-            loadMondayFighter(playerNum, view, eye, true);
+        case LOOK_SKINNED:
+            loadSkinnedFighter(fighterNum, playerNum, view, eye, true);
             break;
         default:
             break;
@@ -2404,35 +3071,219 @@ void GraphicsEngine::displayFighter(int fighterNum, int playerNum, glm::mat4 vie
 void GraphicsEngine::loadSelectedFighter(int fighterNum, int playerNum, glm::mat4 view, glm::vec3 eye)
 {
     //fighterClass[playerNum].setFighterID(fighterNum);
-    switch (fighterNum)
+    if (fighterNum < 0 || fighterNum >= drawTable.count)
+        return;
+
+    switch (drawTable.look[fighterNum])
     {
-        case 0:
-            loadHandFighter(playerNum, view, eye, false);
-            break;
-        case 1:
+        case LOOK_LIMBS:
             loadFighter(playerNum, view, eye, false);
             break;
-        case 2:
-            break;
-        case 3:
-            loadMondayFighter(playerNum, view, eye, false);
+        case LOOK_SKINNED:
+            loadSkinnedFighter(fighterNum, playerNum, view, eye, false);
             break;
         default:
             break;
     }
 }
 
-void GraphicsEngine::setCurFIndex(int playerNum, int fighterIndex)
+bool GraphicsEngine::getPause()
 {
-    //Don't want fighter swapping mid fight, only in arena  which is menu
-    if (arenaNum == 3){
-        curFIndex[playerNum] = fighterIndex;
+    return frameState->paused;
+}
+
+/**
+\brief Returns true if the match drawn is over.
+
+*/
+
+bool GraphicsEngine::getGameOver()
+{
+    return frameState->gameOver;
+}
+
+/**
+\brief Toggles the automatic render scale controller.
+
+*/
+
+void GraphicsEngine::toggleAutoScale()
+{
+    scaler.setAutoScale(!scaler.isAutoScale());
+}
+
+/**
+\brief Shows or hides the crowd in the bath house.
+
+*/
+
+void GraphicsEngine::toggleCrowd()
+{
+    crowdOn = !crowdOn;
+}
+
+/**
+\brief Shows or hides the frame time graph.
+
+*/
+
+void GraphicsEngine::toggleProfiler()
+{
+    profileOn = !profileOn;
+}
+
+/**
+\brief Toggles the overdraw heat map.
+
+*/
+
+void GraphicsEngine::toggleOverdraw()
+{
+    OverdrawView::setVisible(!OverdrawView::isVisible());
+}
+
+/**
+\brief Toggles the depth pre-pass of the opaque objects.
+
+*/
+
+void GraphicsEngine::toggleDepthPrepass()
+{
+    DrawOrder::setDepthPrepass(!DrawOrder::isDepthPrepass());
+}
+
+/**
+\brief Saves the last frames the profiler kept to a Chrome trace file, Trace###.json.
+
+*/
+
+void GraphicsEngine::saveTrace()
+{
+    char tracefilename[100];
+    sprintf(tracefilename, "Trace%d.json", traceCount);
+    if (Profiler::get().writeTrace(tracefilename))
+    {
+        std::cout << "Saved " << tracefilename << std::endl;
+        traceCount++;
     }
 }
 
-bool GraphicsEngine::getPause()
+/**
+\brief Captures the OpenGL calls of the next frame to a file, GLCapture###.ohgl, for
+bench/GLReplay.
+
+The capture hooks are put in the first time, so play before it is not slowed.
+
+*/
+
+void GraphicsEngine::captureFrame()
+{
+    GLStats::install();
+    capturePending = true;
+}
+
+/**
+\brief Changes the internal render resolution scale by a step, turning off automatic scaling.
+
+\param delta --- Amount to add to the current scale.
+
+*/
+
+void GraphicsEngine::changeRenderScale(GLfloat delta)
+{
+    scaler.setAutoScale(false);
+    scaler.setScale(scaler.getScale() + delta);
+}
+
+/**
+\brief Returns the current internal render resolution scale.
+
+*/
+
+GLfloat GraphicsEngine::getRenderScale()
+{
+    return scaler.getScale();
+}
+
+/**
+\brief Returns the smoothed GPU frame time in milliseconds.
+
+*/
+
+double GraphicsEngine::getGPUFrameTime()
+{
+    return scaler.getGPUFrameTime();
+}
+
+/**
+\brief Returns the number of objects that passed frustum culling in the last frame.
+
+*/
+
+int GraphicsEngine::getDrawnCount()
+{
+    return frustum.getDrawn();
+}
+
+/**
+\brief Returns the number of objects rejected by frustum culling in the last frame.
+
+*/
+
+int GraphicsEngine::getCulledCount()
+{
+    return frustum.getCulled();
+}
+
+/**
+\brief Returns the shaded samples per sample of the scene of a recent frame, 1 when each
+was shaded once, -1 before the first is measured.
+
+*/
+
+double GraphicsEngine::getOverdraw()
+{
+    return overdrawView.getOverdraw();
+}
+
+/**
+\brief Returns true during a network match.
+
+*/
+
+bool GraphicsEngine::isNetPlay()
+{
+    return frameState->netPlay;
+}
+
+/**
+\brief Returns the deepest rollback in the ticks behind the frame being drawn.
+
+*/
+
+int GraphicsEngine::getRollbackDepth()
+{
+    return frameState->rollbackDepth;
+}
+
+/**
+\brief Returns the time spent simulating ticks again for the frame being drawn, in milliseconds.
+
+*/
+
+float GraphicsEngine::getResimTime()
+{
+    return frameState->resimMs;
+}
+
+/**
+\brief Returns the round trip time to the other player in milliseconds.
+
+*/
+
+float GraphicsEngine::getPing()
 {
-    return PauseVideo;
+    return frameState->pingMs;
 }
 
 void GraphicsEngine::runWeirdProgram(glm::mat4 view)
@@ -2440,7 +3291,7 @@ void GraphicsEngine::runWeirdProgram(glm::mat4 view)
     changeMode();
     glUseProgram(WeirdProgram);
 
-    glUniform1i(statLoc, cameraPos);
+    glUniform1i(statLoc, frameState->cameraPos);
     static sf::Clock shaderClock;
     static float time = 0;
     time += 0.005 * shaderClock.getElapsedTime().asMilliseconds();
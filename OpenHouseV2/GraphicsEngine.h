@@ -14,6 +14,7 @@
 #include <SFML/Audio.hpp>
 
 #include <iostream>
+#include <memory>
 #include <string>
 #include <stdio.h>
 #include <stdlib.h>
@@ -23,6 +24,7 @@
 #include <glm/gtc/type_ptr.hpp>
 
 #include "LoadShaders.h"
+#include "ShaderLibrary.h"
 #include "ProgramDefines.h"
 #include "SphericalCamera.h"
 #include "YPRCamera.h"
@@ -37,9 +39,27 @@
 //#include "TextRendererTTF.h"
 #include "Fighter.h"
 #include "Box.h"
+#include "HUDLayer.h"
+#include "RenderScaler.h"
+#include "ViewFrustum.h"
+#include "DrawOrder.h"
+#include "OverdrawView.h"
+#include "LightClusters.h"
+#include "ShadowMaps.h"
+#include "SimClock.h"
+#include "SimChannel.h"
+#include "MatchSim.h"
+#include "InputLog.h"
+#include "NetPlay.h"
 #include "Cube.h"
 #include "skinned_mesh.h"
 #include "skinning_technique.h"
+#include "EntityWorld.h"
+#include "Profiler.h"
+#include "ProfileOverlay.h"
+#include "GLStats.h"
+#include "GLCapture.h"
+#include "FrameGrabber.h"
 
 #include "ModelLoaderAssimp.h"
 
@@ -53,17 +73,45 @@
 
 */
 
+/**
+\brief Opaque objects of the arenas and the menu, the objects of the DrawItems the
+engine sorts.
+
+*/
+
+enum SceneObject
+{
+    SCENE_CAR,          ///< A car of the alley way, variant is which one.
+    SCENE_FENCE,        ///< The alley way's fence.
+    SCENE_BRICK_WALL,   ///< A brick wall of the alley way, variant is its texture.
+    SCENE_ASPHALT,      ///< The ground the fighters stand on in the alley way.
+    SCENE_ROAD,         ///< The road behind the fence.
+    SCENE_STREET_BACK,  ///< The picture behind the road.
+    SCENE_BATH_HOUSE,   ///< The bath house.
+    SCENE_TREE,         ///< A tree of the bath house, variant is which one.
+    SCENE_COLUMN,       ///< A column of the menu.
+    SCENE_MENU_GROUND,  ///< The menu's ground.
+    SCENE_BLADE         ///< A blade of the menu, variant is its texture.
+};
+
 /**
 \class GraphicsEngine
 
-\brief The GraphicsEngine class is an extension of sf::RenderWindow which
-handles all of the graphics rendering in the program.
+\brief The GraphicsEngine class owns the program's sf::RenderWindow and handles all of
+the graphics rendering in the program.
+
+Made offscreen, for the benchmark mode, it has no window and draws with whatever
+context the caller made current, see OffscreenContext.  The game logic then has no
+thread of its own and is stepped with benchTick.
 
 */
 
-class GraphicsEngine : public sf::RenderWindow
+class GraphicsEngine
 {
 private:
+    std::unique_ptr<sf::RenderWindow> window;   ///< The window, NULL offscreen.  Declared first so it is made before, and destroyed after, everything using its context.
+    sf::Vector2u offscreenSize;                 ///< Size drawn at offscreen.
+
     GLenum mode;      ///< Mode, either point, line or fill.
     int sscount;      ///< Screenshot count to be appended to the screenshot filename.
     bool drawAxes;    ///< Boolean for drawing the axes.
@@ -77,6 +125,8 @@ private:
     GLuint useTextureLoc;
     GLuint texTransLoc;    ///< Location ID of the texture transformation matrix in the shader.
     GLuint program2DPass;  ///< ID for the 2D hud stuff
+    GLuint depthProgram;   ///< ID of the depth only program of the depth pre-pass.
+    GLint depthPVMLoc;     ///< Location ID of the PVM matrix in depthProgram.
 
     //Weird Shader Cube Map trial
     GLuint projLoc;
@@ -87,6 +137,19 @@ private:
     GLuint gFlopLoc;
 
     void setWeirdProjection();
+    void findUniforms();   ///< Looks up the uniform locations of program and WeirdProgram
+    void selectLightProgram();   ///< Builds program for the number and kinds of lights in lt
+    std::string lightDefines;    ///< Light defines program was built with
+    void placeLights(glm::mat4 view);   ///< Adds this frame's clustered lights and shadow maps and fits them to the view
+    glm::mat4 carMatrix(int car);   ///< Model matrix of a car of the alley way
+    glm::mat4 fenceMatrix();        ///< Model matrix of the alley way's fence
+    glm::mat4 brickWallMatrix(int side);   ///< Model matrix of a brick wall of the alley way
+    void renderShadows();           ///< Draws the casters into this frame's shadow maps
+    void drawShadowCasters(bool still);   ///< Draws the static or the moving casters of the arena into a shadow map
+    void drawOpaque(glm::mat4 view);      ///< Draws the objects in opaque nearest first, after a depth pre-pass when it is on
+    void drawSceneObject(const DrawItem& item, glm::mat4 view, bool depthOnly, bool newMaterial);   ///< Draws one object of opaque
+    void drawSky(glm::mat4 view);         ///< Draws the cube map sphere behind everything drawn
+    void finishScene();                   ///< Ends the overdraw count and draws its heat map, before the HUD
 
 
     GLuint gBonesLoc;   ///< ID for skeletal data
@@ -135,18 +198,17 @@ private:
     //Skinned Mesh for bones
     SkinnedMesh* sMesh = NULL;
 
-    //Skinned Mesh for Hand
-    //SkinnedMesh* gMesh = NULL;
-    SkinnedMesh* gMesh[2] = {NULL, NULL};
-
-    //Skinned Mesh for Monday Memo
-    SkinnedMesh* mMesh[2] = {NULL, NULL};
+    //Skinned Mesh of each fighter, shared by every entity that looks like it, NULL unless its look is skinned
+    SkinnedMesh* fighterMesh[FIGHTER_MAX] = {};
+    std::string fighterMeshFile[FIGHTER_MAX];   ///< File each fighter's mesh was loaded from
 
     SkinningTechnique* pSkinningTech = NULL;
-    long long StartTimeMillis[2] = {0, 0};
-    float AnimationTimeSec[2];
     //BasicMesh* sMesh = NULL;
 
+    EntityWorld entities;   ///< Skinned characters, the players' fighters and the crowd
+    int playerEntity[2];    ///< Entity of each player's fighter
+    bool crowdOn;           ///< Crowd shown in the bath house, F5
+
     //Arena Zero
     ObjModel bathHouse;
     ObjModel tree1;
@@ -154,9 +216,6 @@ private:
 
     //Menu
     ObjModel column;
-    int cameraPos;
-    float cameraX;
-    float cameraZ;
     Cube cube;
 
     ObjModel fighterOne[24];    ///< Array of Object wrappers for Wavefront obj file data sets (FighterOne and FighterTwo)
@@ -168,28 +227,25 @@ private:
 
 
     //GLboolean PauseVideo; ///< Boolean for the video pausing
-    bool PauseVideo;      ///< Boolean for the gamePausing
     bool GameStart;       /// < Boolean value that if false, in main menu, if true in gameplay
-    int arenaNum;         ///< Integer ID value that is equivalent with a specific arena
     int playerOneValue;   ///< Integer ID value that is equivalent with a specific fighter for playerOne
     int playerTwoValue;   ///< Integer ID value that is equivalent with a specific fighter for playerTwo
     GLboolean restartVid; ///< Boolean for video restart
 
-    void loadHandFighter(int playerNum, glm::mat4 view, glm::vec3 eye, bool menuMode); ///< Function that loads the hand fighter character to the game
-    void loadMondayFighter(int playerNum, glm::mat4 view, glm::vec3 eye, bool menuMode);   ///<Function that loads the Monday Memo fighter Character to the game
+    void loadSkinnedFighter(int fighterNum, int playerNum, glm::mat4 view, glm::vec3 eye, bool menuMode); ///< Places a fighter whose look is a skinned mesh
+    void loadFighterMeshes();   ///< Loads the meshes of skinned fighters that are new or changed in drawTable
+    void spawnEntities();       ///< Makes the players' and crowd's entities over the loaded meshes
+    void animateEntities();              ///< Runs the cull and animation systems over the entities
+    void drawEntities(glm::mat4 view);   ///< Runs the draw system over the entities
 
     void loadSelectedFighter(int fighterNum, int playerNum, glm::mat4 view, glm::vec3 eye);
     void displayFighter(int fighterNum, int playerNum, glm::mat4 view, glm::vec3 eye);
 
-    int curAnimIndex[2] = {0, 0};
-
     glm::mat4 projection;  ///< Projection Matrix
     glm::mat4 model;       ///< Model Matrix
     glm::mat4 textrans;    ///< Texture transformation matrix.
 
     int addNum[2] = {0, 12};
-    bool gameOver = false;
-    int rivalNum[2] = {1, 0};
 
     glm::mat4 ModelMatrix[2];
     glm::mat4 leftArmMat[2];
@@ -205,12 +261,69 @@ private:
     sf::SoundBuffer strikeBuffer;
 
     //Health Bar HUD stuff
-    Box hpBar1;    ///< Simple Box object used for the Player One's Health Bar
-    Box hpBar2;    ///< Simple Box object used for the Player Two's Health Bar
-    Box behindBar1;
-    Box behindBar2;
-
-    int curFIndex[2] = {3, 1};
+    HUDLayer hud;      ///< Retained 2D overlay holding every HUD quad in one buffer
+    int hpBar1;        ///< HUD quad used for the Player One's Health Bar
+    int hpBar2;        ///< HUD quad used for the Player Two's Health Bar
+    int behindBar1;    ///< HUD quad drawn behind Player One's Health Bar
+    int behindBar2;    ///< HUD quad drawn behind Player Two's Health Bar
+
+    RenderScaler scaler;   ///< Offscreen target with dynamic internal resolution
+    ProfileOverlay profileOverlay;   ///< Frame time graph, F3
+    bool profileOn;        ///< Frame time graph shown
+    int traceCount;        ///< Number for the next trace file, F4
+    bool capturePending;   ///< The next frame's OpenGL calls are to be captured, F12
+    int captureCount;      ///< Number for the next capture file, F12
+    FrameGrabber grabber;  ///< Reads the window back for screenshots and match recordings, F10 and F2
+    sf::Clock shaderCheck; ///< Time since the shader files were last checked for changes
+    int recordingCount;    ///< Number for the next match recording, F2
+    ViewFrustum frustum;   ///< Culls objects against the camera before drawing
+    LightClusters clusters;               ///< Point and spot lights beyond lt, assigned to clusters of the view each frame
+    std::vector<Light> benchLights;       ///< Extra clustered lights of the benchmark, see setBenchLights
+    std::vector<float> benchLightRanges;  ///< Range of each benchmark light
+    ShadowMaps shadows;                   ///< Shadow maps of the directional and spot lights, drawn each frame
+    ViewFrustum shadowFrustum;            ///< Culls shadow casters against the frustum of the light being drawn
+    int shadowArena;                      ///< Arena the cached static shadow casters were drawn for
+    DrawOrder opaque;                     ///< Opaque objects of the arena being drawn, sorted front to back
+    OverdrawView overdrawView;            ///< Counts the shaded samples of each frame, its heat map F1
+
+    //Fixed timestep game logic on its own thread, owned by that thread
+    SimClock simClock;               ///< Runs the game logic at SimTickRate
+    InputRecorder recorder;          ///< Input log being recorded, F9
+    InputReplay replayLog;           ///< Input log being replayed, F11
+    sf::Clock fighterCheck;          ///< Time since the fighter files were last checked for changes
+    int fighterVersion;              ///< Counts the reloads of simTable
+    bool replaying;                  ///< True while replayLog drives the game logic
+    int recordCount;                 ///< Number for the next input log file
+    std::string lastLogFile;         ///< Last input log saved
+
+    //Hand off between the threads
+    sf::Thread simThread;            ///< Runs simulationLoop
+    std::atomic<bool> simRunning;    ///< Cleared to stop the simulation thread
+    sf::Clock simTime;               ///< Clock shared by both threads for snapshot times
+    InputRing inputs;                ///< Input from the event loop to the simulation thread
+    SnapshotBuffer snapshots;        ///< Game state from the simulation thread to the renderer
+
+    //Owned by the render thread
+    const SimSnapshot* frameState;   ///< Latest snapshot, read while drawing a frame
+    FighterTable drawTable;          ///< Fighter definitions for drawing, reloaded after simTable is
+    int drawFighterVersion;          ///< fighterVersion drawTable was loaded at
+    float drawFighterX[2];           ///< Fighter positions blended for this frame
+    float drawFighterHeight[2];      ///< Fighter heights blended for this frame
+    float drawRotations[24][3];      ///< Limb rotations of both fighters blended for this frame
+    float drawCarX[2];               ///< Car positions blended for this frame
+    float drawCarAngle[2];           ///< Headlight angles blended for this frame
+    float drawMenuAngle;             ///< Menu blade spin blended for this frame
+    float drawCameraX;               ///< Menu camera x blended for this frame
+    float drawCameraZ;               ///< Menu camera z blended for this frame
+
+    void simulationLoop();
+    void simulationStep();
+    void applyInput(const SimInput& in);
+    void toggleRecording();
+    void startReplay();
+    void endReplay();
+    void publishSnapshot();
+    void interpolateSimState();
 
     sf::Image texture;     ///< Cube map texture.
     void printOpenGLErrors();
@@ -221,12 +334,24 @@ private:
 
 public:
     GraphicsEngine(std::string title = "OpenGL Window", GLint MajorVer = 3, GLint MinorVer = 3,
-                   int width = 600, int height = 600);
+                   int width = 600, int height = 600, const NetConfig* netConfig = NULL, bool offscreen = false);
     ~GraphicsEngine();
 
+    bool isOpen();
+    void close();
+    bool pollEvent(sf::Event& event);
+    void setTitle(const std::string& title);
+    sf::Vector2u getSize();
+    bool isOffscreen();
+
+    void startBenchMatch(int arena, int fighterOne, int fighterTwo);
+    void setBenchLights(int count, unsigned int seed);
+    void benchTick();
+
     void display();
     void changeMode();
     void screenshot();
+    void toggleVideoRecording(bool raw);
     void resize();
     void setSize(unsigned int, unsigned int);
     GLfloat* getScreenBounds();
@@ -254,18 +379,10 @@ public:
     void LoadLight(Light Lt, std::string name, int i);
 
     //Remove during cleanup (check UI)
-    void togglePause();
     void restartVideo();
 
     void menuObjLoad();
 
-    void menuRightSlide();
-    void menuLeftSlide();
-    void menuSelect();
-    void menuBackout();
-    void makeValue(float changingVar, float toValue, float rate);
-    void returnToMenu();
-
     int getArenaNum();
 
     void activateHUD();
@@ -274,17 +391,37 @@ public:
     void loadArenaOne(glm::mat4 view, glm::vec3 eye);
     void loadFighter(int fighterNum, glm::mat4 view, glm::vec3 eye, bool menuMode);
 
-    void setCurFIndex(int playerNum, int fighterIndex);
-
     bool getPause();
+    bool getGameOver();
+    void sendInput(int type, int player = 0, int a = 0, int b = 0);
+
+    void toggleAutoScale();
+    void toggleCrowd();
+    void toggleProfiler();
+    void toggleOverdraw();
+    void toggleDepthPrepass();
+    void saveTrace();
+    void captureFrame();
+    void changeRenderScale(GLfloat delta);
+    GLfloat getRenderScale();
+    double getGPUFrameTime();
+    int getDrawnCount();
+    int getCulledCount();
+    double getOverdraw();
+
+    bool isNetPlay();
+    int getRollbackDepth();
+    float getResimTime();
+    float getPing();
 
 
     Fighter fighterClass[2];
+    FighterTable simTable;   ///< Fighter definitions of the game logic, owned by the simulation thread, declared before sim
+    MatchSim sim;   ///< Game logic over fighterClass, owned by the simulation thread, declared after it
+    NetPlay net;    ///< Network match over sim, owned by the simulation thread while open
 
     //void hudDispay();
 
-    void restartGame();
-
     SphericalCamera* getLtPos();
     SphericalCamera* getSphericalCamera();
     YPRCamera* getYPRCamera();
@@ -0,0 +1,319 @@
+#include "HUDLayer.h"
+
+/**
+\file HUDLayer.cpp
+\brief Retained-mode 2D overlay for the HUD.
+
+All HUD quads live in one interleaved array buffer of (x, y, r, g, b) vertices with a
+static index buffer of {0, 3, 2, 0, 2, 1} per quad, the same winding used by Box.
+Setters only update the CPU copy and widen the dirty range, so a frame where nothing
+changes does not touch the buffer at all and a frame where the health bars change
+uploads just the quads between the first and last changed one.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor
+
+\param maxQuads --- Number of quads to allocate buffer space for.
+
+Generates the vertex array, array buffer and index buffer, allocates the array buffer
+for maxQuads quads and loads the index data, which never changes.
+
+*/
+
+HUDLayer::HUDLayer(int maxQuads)
+{
+    capacity = maxQuads;
+    dirtyFirst = -1;
+    dirtyLast = -1;
+
+    glGenVertexArrays(1, &HudVAO);
+    glGenBuffers(1, &ArrayBuffer);
+    glGenBuffers(1, &HudEBO);
+
+    LoadDataToGraphicsCard();
+}
+
+/**
+\brief Destructor
+
+Clears the graphics memory used for the overlay.
+
+*/
+
+HUDLayer::~HUDLayer()
+{
+    glBindVertexArray(HudVAO);
+    glDeleteBuffers(1, &ArrayBuffer);
+    glDeleteBuffers(1, &HudEBO);
+    glDeleteVertexArrays(1, &HudVAO);
+}
+
+/**
+\brief Allocates the array buffer and loads the index array for the current capacity.
+
+The array buffer is allocated with no data, every quad is uploaded through the dirty
+range on the next draw.
+
+*/
+
+void HUDLayer::LoadDataToGraphicsCard()
+{
+    std::vector<GLuint> indices(6 * capacity);
+    for (int i = 0; i < capacity; i++)
+    {
+        indices[6*i + 0] = 4*i + 0;
+        indices[6*i + 1] = 4*i + 3;
+        indices[6*i + 2] = 4*i + 2;
+        indices[6*i + 3] = 4*i + 0;
+        indices[6*i + 4] = 4*i + 2;
+        indices[6*i + 5] = 4*i + 1;
+    }
+
+    glBindVertexArray(HudVAO);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, HudEBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof(GLuint), &indices[0], GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ARRAY_BUFFER, ArrayBuffer);
+    glBufferData(GL_ARRAY_BUFFER, capacity * 20 * sizeof(GLfloat), NULL, GL_DYNAMIC_DRAW);
+
+    // Interleaved (x, y, r, g, b), stride of 5 floats.
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), BUFFER_OFFSET(0));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), BUFFER_OFFSET(2 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+
+    if (!quads.empty())
+    {
+        dirtyFirst = 0;
+        dirtyLast = quads.size() - 1;
+    }
+}
+
+/**
+\brief Adds a quad to the overlay and returns its handle.
+
+\param cx --- X position of the center.
+\param cy --- Y position of the center.
+\param w --- The width of the quad, using the Box convention.
+\param h --- The height of the quad.
+
+Quads are drawn in the order they are added.  If the buffers are full they are
+reallocated with twice the capacity.
+
+*/
+
+int HUDLayer::addQuad(GLfloat cx, GLfloat cy, GLfloat w, GLfloat h)
+{
+    Quad q;
+    q.centerX = cx;
+    q.centerY = cy;
+    q.width = w;
+    q.height = h;
+    for (int i = 0; i < 12; i++)
+        q.colors[i] = 1;
+
+    quads.push_back(q);
+
+    if ((int)quads.size() > capacity)
+    {
+        capacity *= 2;
+        LoadDataToGraphicsCard();
+    }
+
+    int id = quads.size() - 1;
+    markDirty(id);
+    return id;
+}
+
+/**
+\brief Widens the dirty range to include a quad.
+
+\param id --- Handle of the changed quad.
+
+*/
+
+void HUDLayer::markDirty(int id)
+{
+    if (dirtyFirst < 0)
+    {
+        dirtyFirst = id;
+        dirtyLast = id;
+        return;
+    }
+
+    if (id < dirtyFirst)
+        dirtyFirst = id;
+    if (id > dirtyLast)
+        dirtyLast = id;
+}
+
+/**
+\brief Resets the width of a quad if it changed.
+
+\param id --- Handle of the quad.
+\param w --- The width of the quad.
+
+*/
+
+void HUDLayer::setWidth(int id, GLfloat w)
+{
+    if (quads[id].width == w)
+        return;
+
+    quads[id].width = w;
+    markDirty(id);
+}
+
+/**
+\brief Resets the height of a quad if it changed.
+
+\param id --- Handle of the quad.
+\param h --- The height of the quad.
+
+*/
+
+void HUDLayer::setHeight(int id, GLfloat h)
+{
+    if (quads[id].height == h)
+        return;
+
+    quads[id].height = h;
+    markDirty(id);
+}
+
+/**
+\brief Resets the center of a quad if it changed.
+
+\param id --- Handle of the quad.
+\param cx --- X position of the center.
+\param cy --- Y position of the center.
+
+*/
+
+void HUDLayer::setCenter(int id, GLfloat cx, GLfloat cy)
+{
+    if (quads[id].centerX == cx && quads[id].centerY == cy)
+        return;
+
+    quads[id].centerX = cx;
+    quads[id].centerY = cy;
+    markDirty(id);
+}
+
+/**
+\brief Sets the two tone color of a quad, same pattern as Box::setAllColor.
+
+\param id --- Handle of the quad.
+\param c --- Intensity of the blue and alternating channels.
+\param g --- Intensity of the remaining channels.
+
+*/
+
+void HUDLayer::setAllColor(int id, GLfloat c, GLfloat g)
+{
+    GLfloat colors[12] = {g, g, c,
+                          g, c, c,
+                          g, g, c,
+                          g, c, c};
+
+    bool changed = false;
+    for (int i = 0; i < 12; i++)
+    {
+        if (quads[id].colors[i] != colors[i])
+        {
+            quads[id].colors[i] = colors[i];
+            changed = true;
+        }
+    }
+
+    if (changed)
+        markDirty(id);
+}
+
+/**
+\brief Changes the color of one vertex of a quad.
+
+\param id --- Handle of the quad.
+\param v --- Number of the vertex to alter, 0 to 3 clockwise from the upper left.
+\param r --- Red intensity for the vertex.
+\param g --- Green intensity for the vertex.
+\param b --- Blue intensity for the vertex.
+
+*/
+
+void HUDLayer::setVertexColor(int id, GLint v, GLfloat r, GLfloat g, GLfloat b)
+{
+    GLfloat* col = &quads[id].colors[3*v];
+    if (col[0] == r && col[1] == g && col[2] == b)
+        return;
+
+    col[0] = r;
+    col[1] = g;
+    col[2] = b;
+    markDirty(id);
+}
+
+/**
+\brief Writes the 4 interleaved vertices of a quad.
+
+\param q --- Quad to write.
+\param v --- Destination, 20 floats.
+
+*/
+
+void HUDLayer::writeVertices(const Quad& q, GLfloat* v)
+{
+    GLfloat x[4] = {q.centerX - q.width, q.centerX + q.width,
+                    q.centerX + q.width/1.4f, q.centerX - q.width/1.4f};
+    GLfloat y[4] = {q.centerY + q.height/2, q.centerY + q.height/2,
+                    q.centerY - q.height/2, q.centerY - q.height/2};
+
+    for (int i = 0; i < 4; i++)
+    {
+        v[5*i + 0] = x[i];
+        v[5*i + 1] = y[i];
+        v[5*i + 2] = q.colors[3*i + 0];
+        v[5*i + 3] = q.colors[3*i + 1];
+        v[5*i + 4] = q.colors[3*i + 2];
+    }
+}
+
+/**
+\brief Uploads the dirty range, if any, and draws every quad with a single call.
+
+The 2D pass-through shader must be in use.
+
+*/
+
+void HUDLayer::draw()
+{
+    if (quads.empty())
+        return;
+
+    glBindVertexArray(HudVAO);
+
+    if (dirtyFirst >= 0)
+    {
+        int count = dirtyLast - dirtyFirst + 1;
+        std::vector<GLfloat> verts(20 * count);
+
+        for (int i = 0; i < count; i++)
+            writeVertices(quads[dirtyFirst + i], &verts[20*i]);
+
+        glBindBuffer(GL_ARRAY_BUFFER, ArrayBuffer);
+        glBufferSubData(GL_ARRAY_BUFFER, dirtyFirst * 20 * sizeof(GLfloat),
+                        verts.size() * sizeof(GLfloat), &verts[0]);
+
+        dirtyFirst = -1;
+        dirtyLast = -1;
+    }
+
+    glDrawElements(GL_TRIANGLES, 6 * quads.size(), GL_UNSIGNED_INT, NULL);
+}
@@ -0,0 +1,83 @@
+#ifndef HUDLAYER_H_INCLUDED
+#define HUDLAYER_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <iostream>
+#include <vector>
+
+#include "ProgramDefines.h"
+
+/**
+\file HUDLayer.h
+
+\brief Header file for HUDLayer.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\class HUDLayer
+
+\brief Retained-mode 2D overlay holding every HUD quad in a single dynamic vertex buffer.
+
+Quads are created once with addQuad and referred to by the integer handle it returns.
+The setters mirror the Box interface but only record the new values and mark the quad
+as dirty if something actually changed.  On draw, the dirty range of the buffer is
+patched with one glBufferSubData call and all quads are drawn with one glDrawElements.
+
+Each quad has the same trapezoid shape as Box, four vertices of interleaved (x, y, r, g, b)
+data, and is drawn with the 2D pass-through shader.
+
+*/
+
+class HUDLayer
+{
+private:
+    /**
+    \brief Retained state of a single quad.
+    */
+    struct Quad
+    {
+        GLfloat centerX;     ///< X coordinate of the center of the quad.
+        GLfloat centerY;     ///< Y coordinate of the center of the quad.
+        GLfloat width;       ///< Half width of the top edge, same convention as Box.
+        GLfloat height;      ///< Height of the quad.
+        GLfloat colors[12];  ///< (r,g,b) color values for each of the 4 vertices.
+    };
+
+    std::vector<Quad> quads;  ///< All quads in draw order.
+    int capacity;             ///< Number of quads the buffers were allocated for.
+    int dirtyFirst;           ///< First quad needing an upload, -1 if none.
+    int dirtyLast;            ///< Last quad needing an upload.
+
+    GLuint HudVAO;            ///< Vertex Array Object ID.
+    GLuint ArrayBuffer;       ///< Interleaved position and color buffer ID.
+    GLuint HudEBO;            ///< Index buffer ID.
+
+    void markDirty(int id);
+    void writeVertices(const Quad& q, GLfloat* v);
+    void LoadDataToGraphicsCard();
+
+public:
+    HUDLayer(int maxQuads = 16);
+    ~HUDLayer();
+
+    int addQuad(GLfloat cx = 0, GLfloat cy = 0, GLfloat w = 1, GLfloat h = 1);
+    void setWidth(int id, GLfloat w);
+    void setHeight(int id, GLfloat h);
+    void setCenter(int id, GLfloat cx, GLfloat cy);
+    void setAllColor(int id, GLfloat c, GLfloat g);
+    void setVertexColor(int id, GLint v, GLfloat r, GLfloat g, GLfloat b);
+
+    void draw();
+};
+
+#endif // HUDLAYER_H_INCLUDED
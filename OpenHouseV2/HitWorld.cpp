@@ -0,0 +1,127 @@
+#include "HitWorld.h"
+
+/**
+\file HitWorld.cpp
+\brief Sweep and prune collision of hitboxes against hurtboxes.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor, no boxes.
+
+*/
+
+HitWorld::HitWorld()
+{
+    pairsTested = 0;
+}
+
+/**
+\brief Removes the boxes of the last tick, keeping the sorted order for the next.
+
+*/
+
+void HitWorld::clear()
+{
+    boxes.clear();
+}
+
+/**
+\brief Adds a box for this tick.
+
+\param box --- The box, in world space.
+
+*/
+
+void HitWorld::add(const HitBox& box)
+{
+    boxes.push_back(box);
+}
+
+/**
+\brief Finds every hitbox touching a hurtbox of another player.
+
+\return The contacts, valid until the next call.
+
+*/
+
+const std::vector<HitContact>& HitWorld::collide()
+{
+    contacts.clear();
+
+    // Keep the order of the last tick where it still fits, box i of this tick is most
+    // likely the same box as box i of the last one.
+    if (order.size() != boxes.size())
+    {
+        order.resize(boxes.size());
+        for (size_t i = 0; i < order.size(); i++)
+            order[i] = (int)i;
+    }
+
+    for (size_t i = 1; i < order.size(); i++)
+    {
+        int b = order[i];
+        size_t j = i;
+        while (j > 0 && (boxes[order[j - 1]].minX > boxes[b].minX ||
+                         (boxes[order[j - 1]].minX == boxes[b].minX && order[j - 1] > b)))
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = b;
+    }
+
+    open.clear();
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        const HitBox& a = boxes[order[i]];
+
+        // Drop the boxes that end before this one starts, then pair with the rest.
+        size_t kept = 0;
+        for (size_t k = 0; k < open.size(); k++)
+        {
+            const HitBox& b = boxes[open[k]];
+            if (b.maxX < a.minX)
+                continue;
+            open[kept++] = open[k];
+
+            if (a.owner == b.owner || (a.move < 0) == (b.move < 0))
+                continue;
+
+            pairsTested++;
+            if (a.maxY < b.minY || b.maxY < a.minY)
+                continue;
+
+            const HitBox& hit = a.move >= 0 ? a : b;
+            const HitBox& hurt = a.move >= 0 ? b : a;
+
+            bool seen = false;
+            for (size_t c = 0; c < contacts.size() && !seen; c++)
+                seen = contacts[c].attacker == hit.owner && contacts[c].defender == hurt.owner && contacts[c].move == hit.move;
+            if (!seen)
+            {
+                HitContact contact = {hit.owner, hurt.owner, hit.move};
+                contacts.push_back(contact);
+            }
+        }
+        open.resize(kept);
+        open.push_back(order[i]);
+    }
+
+    return contacts;
+}
+
+/**
+\brief Returns the number of hitbox and hurtbox pairs the broad phase passed to the
+narrow phase since the world was made.
+
+*/
+
+long long HitWorld::getPairsTested()
+{
+    return pairsTested;
+}
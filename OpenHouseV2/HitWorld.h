@@ -0,0 +1,85 @@
+#ifndef HITWORLD_H_INCLUDED
+#define HITWORLD_H_INCLUDED
+
+#include <stddef.h>
+
+#include <vector>
+
+/**
+\file HitWorld.h
+
+\brief Header file for HitWorld.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief One box of a fighter for one tick, in world space.  x runs across the arena and
+y up from the floor.
+
+*/
+
+struct HitBox
+{
+    float minX;     ///< Left edge.
+    float minY;     ///< Bottom edge.
+    float maxX;     ///< Right edge.
+    float maxY;     ///< Top edge.
+    int owner;      ///< Player the box belongs to.
+    int move;       ///< One of FightHit for a hitbox, -1 for a hurtbox.
+};
+
+/**
+\brief A hitbox that touched a hurtbox of another player.
+
+*/
+
+struct HitContact
+{
+    int attacker;   ///< Owner of the hitbox.
+    int defender;   ///< Owner of the hurtbox.
+    int move;       ///< Move of the hitbox.
+};
+
+/**
+\class HitWorld
+
+\brief Collision of every fighter's hitboxes against the other fighters' hurtboxes for
+one tick.
+
+The boxes are added fresh each tick.  The broad phase is sweep and prune along x: the
+boxes are kept sorted by their left edge, with an insertion sort since the fighters
+add them in the same order each tick and they barely move between ticks, and one sweep
+pairs up every box with the boxes whose x ranges overlap it.  The narrow phase then
+checks y for those pairs only.  Nothing is allocated once the arrays have grown to the
+largest tick.
+
+Contacts are reported once per attacker, defender and move, in the order of the
+sweep, which only depends on the boxes, so a tick always resolves the same way.
+
+*/
+
+class HitWorld
+{
+private:
+    std::vector<HitBox> boxes;          ///< Boxes of this tick.
+    std::vector<int> order;             ///< Box indices by left edge.
+    std::vector<int> open;              ///< Boxes the sweep is inside of.
+    std::vector<HitContact> contacts;   ///< Contacts found by collide.
+
+    long long pairsTested;              ///< Pairs passed to the narrow phase, for benchmarks.
+
+public:
+    HitWorld();
+
+    void clear();
+    void add(const HitBox& box);
+    const std::vector<HitContact>& collide();
+
+    long long getPairsTested();
+};
+
+#endif // HITWORLD_H_INCLUDED
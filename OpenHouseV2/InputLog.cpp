@@ -0,0 +1,392 @@
+#include "InputLog.h"
+
+#include <stdio.h>
+#include <iostream>
+
+/**
+\file InputLog.cpp
+\brief Recording and reading of the binary input log used to replay matches.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor, not recording.
+
+*/
+
+InputRecorder::InputRecorder()
+{
+    lastTick = 0;
+    recording = false;
+}
+
+/**
+\brief Appends an unsigned varint, 7 bits per byte with the top bit set on all but the
+last byte.
+
+\param v --- Value to write.
+
+*/
+
+void InputRecorder::writeVarint(unsigned long long v)
+{
+    while (v >= 0x80)
+    {
+        data.push_back((unsigned char)(v | 0x80));
+        v >>= 7;
+    }
+    data.push_back((unsigned char)v);
+}
+
+/**
+\brief Appends the ticks since the last record.
+
+\param tick --- Tick of the new record.
+
+*/
+
+void InputRecorder::writeTick(long long tick)
+{
+    if (tick < lastTick)
+        tick = lastTick;
+
+    writeVarint((unsigned long long)(tick - lastTick));
+    lastTick = tick;
+}
+
+/**
+\brief Starts a new log, dropping anything recorded before.
+
+The caller resets its MatchSim at the same time, a log is always played back from the
+starting state.
+
+\param tickRate --- Simulation ticks per second, stored so a replay can warn on a mismatch.
+
+*/
+
+void InputRecorder::begin(int tickRate)
+{
+    data.clear();
+    data.push_back('O');
+    data.push_back('H');
+    data.push_back('I');
+    data.push_back('L');
+    data.push_back(INPUT_LOG_VERSION & 0xFF);
+    data.push_back(INPUT_LOG_VERSION >> 8);
+    data.push_back(tickRate & 0xFF);
+    data.push_back((tickRate >> 8) & 0xFF);
+
+    lastTick = 0;
+    recording = true;
+}
+
+/**
+\brief Records an input.
+
+\param tick --- Tick the input is applied before, MatchSim::tickCount.
+\param in --- The input.
+
+*/
+
+void InputRecorder::record(long long tick, const SimInput& in)
+{
+    if (!recording)
+        return;
+
+    writeTick(tick);
+    data.push_back((unsigned char)((in.type & 0x7F) | ((in.player & 1) << 7)));
+    writeVarint(((unsigned int)in.a << 1) ^ (unsigned int)(in.a >> 31));
+    writeVarint(((unsigned int)in.b << 1) ^ (unsigned int)(in.b >> 31));
+}
+
+/**
+\brief Ends the log.
+
+\param tick --- Last tick run, MatchSim::tickCount.
+\param checksum --- MatchSim::checksum at that tick.
+
+*/
+
+void InputRecorder::end(long long tick, unsigned int checksum)
+{
+    if (!recording)
+        return;
+
+    writeTick(tick);
+    data.push_back(INPUT_LOG_END);
+    for (int i = 0; i < 4; i++)
+        data.push_back((checksum >> (8*i)) & 0xFF);
+
+    recording = false;
+}
+
+/**
+\brief Writes the finished log to a file.
+
+\param fileName --- File to write.
+
+\return False if the log is not finished or the file could not be written.
+
+*/
+
+bool InputRecorder::save(const std::string& fileName)
+{
+    if (recording || data.empty())
+        return false;
+
+    FILE* fp = fopen(fileName.c_str(), "wb");
+    if (!fp)
+    {
+        std::cerr << "Could not write input log " << fileName << std::endl;
+        return false;
+    }
+
+    bool ok = fwrite(data.data(), 1, data.size(), fp) == data.size();
+    fclose(fp);
+    return ok;
+}
+
+/**
+\brief Returns true between begin and end.
+
+*/
+
+bool InputRecorder::isRecording()
+{
+    return recording;
+}
+
+/**
+\brief Returns the size of the log in bytes.
+
+*/
+
+size_t InputRecorder::getSize()
+{
+    return data.size();
+}
+
+/**
+\brief Constructor, holds no log.
+
+*/
+
+InputReplay::InputReplay()
+{
+    pos = 0;
+    nextTick = 0;
+    nextByte = -1;
+    endTick = 0;
+    checksum = 0;
+    tickRate = 0;
+}
+
+/**
+\brief Reads an unsigned varint at the read position.
+
+\param v --- Set to the value.
+
+\return False if the log ends first.
+
+*/
+
+bool InputReplay::readVarint(unsigned long long& v)
+{
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7)
+    {
+        if (pos >= data.size())
+            return false;
+
+        unsigned char c = data[pos++];
+        v |= (unsigned long long)(c & 0x7F) << shift;
+        if (!(c & 0x80))
+            return true;
+    }
+    return false;
+}
+
+/**
+\brief Reads the tick and type of the next record into nextTick and nextByte.
+
+\return False if the log ends first.
+
+*/
+
+bool InputReplay::readHeader()
+{
+    unsigned long long delta;
+    if (!readVarint(delta) || pos >= data.size())
+    {
+        nextByte = -1;
+        return false;
+    }
+
+    nextTick += delta;
+    nextByte = data[pos++];
+    return true;
+}
+
+/**
+\brief Loads a log and checks that it is complete.
+
+\param fileName --- File to read.
+
+\return False if the file could not be read or is not a complete input log.
+
+*/
+
+bool InputReplay::load(const std::string& fileName)
+{
+    data.clear();
+    nextByte = -1;
+
+    FILE* fp = fopen(fileName.c_str(), "rb");
+    if (!fp)
+    {
+        std::cerr << "Could not open input log " << fileName << std::endl;
+        return false;
+    }
+
+    unsigned char buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+        data.insert(data.end(), buf, buf + n);
+    fclose(fp);
+
+    if (data.size() < 8 || data[0] != 'O' || data[1] != 'H' || data[2] != 'I' || data[3] != 'L')
+    {
+        std::cerr << fileName << " is not an input log." << std::endl;
+        data.clear();
+        return false;
+    }
+
+    int version = data[4] | (data[5] << 8);
+    if (version != INPUT_LOG_VERSION)
+    {
+        std::cerr << fileName << " is input log version " << version << ", expected " << INPUT_LOG_VERSION << std::endl;
+        data.clear();
+        return false;
+    }
+    tickRate = data[6] | (data[7] << 8);
+
+    // Walk every record once so a truncated log is caught here and not mid replay.
+    rewind();
+    while (nextByte != INPUT_LOG_END)
+    {
+        unsigned long long a, b;
+        if (nextByte < 0 || !readVarint(a) || !readVarint(b) || !readHeader())
+        {
+            std::cerr << fileName << " is truncated." << std::endl;
+            data.clear();
+            return false;
+        }
+    }
+
+    if (pos + 4 > data.size())
+    {
+        std::cerr << fileName << " is truncated." << std::endl;
+        data.clear();
+        return false;
+    }
+
+    endTick = nextTick;
+    checksum = 0;
+    for (int i = 0; i < 4; i++)
+        checksum |= (unsigned int)data[pos + i] << (8*i);
+
+    rewind();
+    return true;
+}
+
+/**
+\brief Goes back to the first input.
+
+*/
+
+void InputReplay::rewind()
+{
+    pos = 8;
+    nextTick = 0;
+    if (data.size() < 8 || !readHeader())
+        nextByte = -1;
+}
+
+/**
+\brief Takes the next input if it was recorded before the given tick.
+
+Call repeatedly before each tick until it returns false.
+
+\param tick --- Tick about to run, MatchSim::tickCount.
+\param out --- Set to the input.
+
+\return False if there are no more inputs for this tick.
+
+*/
+
+bool InputReplay::next(long long tick, SimInput& out)
+{
+    if (nextByte < 0 || nextByte == INPUT_LOG_END || nextTick > tick)
+        return false;
+
+    unsigned long long a, b;
+    if (!readVarint(a) || !readVarint(b))
+    {
+        nextByte = -1;
+        return false;
+    }
+
+    out.type = nextByte & 0x7F;
+    out.player = nextByte >> 7;
+    out.a = (int)((unsigned int)(a >> 1) ^ -(unsigned int)(a & 1));
+    out.b = (int)((unsigned int)(b >> 1) ^ -(unsigned int)(b & 1));
+
+    readHeader();
+    return true;
+}
+
+/**
+\brief Returns true once the replay has reached the last tick of the recording.
+
+\param tick --- Ticks run, MatchSim::tickCount.
+
+*/
+
+bool InputReplay::isDone(long long tick)
+{
+    return data.empty() || tick >= endTick;
+}
+
+/**
+\brief Returns the last tick of the recording.
+
+*/
+
+long long InputReplay::getEndTick()
+{
+    return endTick;
+}
+
+/**
+\brief Returns the MatchSim checksum recorded at the last tick.
+
+*/
+
+unsigned int InputReplay::getChecksum()
+{
+    return checksum;
+}
+
+/**
+\brief Returns the tick rate the log was recorded at.
+
+*/
+
+int InputReplay::getTickRate()
+{
+    return tickRate;
+}
@@ -0,0 +1,98 @@
+#ifndef INPUTLOG_H_INCLUDED
+#define INPUTLOG_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "SimChannel.h"
+
+/**
+\file InputLog.h
+
+\brief Header file for InputLog.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define INPUT_LOG_VERSION 1      ///< Version written to the header of new logs.
+#define INPUT_LOG_END 0x7F       ///< Type byte marking the end of a log.
+
+/**
+\class InputRecorder
+
+\brief Records the inputs applied to a MatchSim, stamped with the tick they were
+applied before, into the compact binary input log format.
+
+The log starts with the 4 bytes "OHIL", a 2 byte version and the 2 byte tick rate, all
+little endian.  Each input is then
+
+- the ticks since the previous input as an unsigned varint,
+- one byte holding the type in the low 7 bits and the player in the top bit,
+- a and b as zigzag varints,
+
+so a typical input takes 4 bytes.  The log ends with a record of type INPUT_LOG_END
+whose tick is the last tick run, followed by the 4 byte MatchSim checksum at that tick.
+
+*/
+
+class InputRecorder
+{
+private:
+    std::vector<unsigned char> data;   ///< Encoded log.
+    long long lastTick;                ///< Tick of the last record written.
+    bool recording;                    ///< True between begin and end.
+
+    void writeVarint(unsigned long long v);
+    void writeTick(long long tick);
+
+public:
+    InputRecorder();
+
+    void begin(int tickRate);
+    void record(long long tick, const SimInput& in);
+    void end(long long tick, unsigned int checksum);
+    bool save(const std::string& fileName);
+
+    bool isRecording();
+    size_t getSize();
+};
+
+/**
+\class InputReplay
+
+\brief Reads a binary input log and hands its inputs back on the ticks they were
+recorded on.
+
+*/
+
+class InputReplay
+{
+private:
+    std::vector<unsigned char> data;   ///< Encoded log.
+    size_t pos;                        ///< Read position in data.
+    long long nextTick;                ///< Tick of the input at pos.
+    int nextByte;                      ///< Type and player byte of the input at pos, -1 if none.
+    long long endTick;                 ///< Last tick of the recording.
+    unsigned int checksum;             ///< Checksum at the last tick.
+    int tickRate;                      ///< Tick rate of the recording.
+
+    bool readVarint(unsigned long long& v);
+    bool readHeader();
+
+public:
+    InputReplay();
+
+    bool load(const std::string& fileName);
+    void rewind();
+    bool next(long long tick, SimInput& out);
+
+    bool isDone(long long tick);
+    long long getEndTick();
+    unsigned int getChecksum();
+    int getTickRate();
+};
+
+#endif // INPUTLOG_H_INCLUDED
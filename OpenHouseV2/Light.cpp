@@ -273,6 +273,48 @@ glm::vec3 Light::getAttenuation()
     return attenuation;
 }
 
+/**
+\brief Returns the kind of light, from its position and spot cutoff.
+
+\return LIGHT_DIRECTIONAL if the position's w is 0, LIGHT_SPOT if the cutoff is under
+180 degrees, otherwise LIGHT_POINT.
+
+*/
+
+LightType Light::getType()
+{
+    if (position.w == 0)
+        return LIGHT_DIRECTIONAL;
+
+    // The shaders always treated a cutoff of 179.9 or more as no cone at all.
+    if (spotCutoff < 179.9)
+        return LIGHT_SPOT;
+
+    return LIGHT_POINT;
+}
+
+/**
+\brief Returns the shader defines for a set of lights, the number of lights and the
+kind of each, for instance "LIGHTS=3 LIGHT_TYPES=2,2,3".
+
+\param lights --- The lights, as they are loaded into the shader's Lt array.
+
+\param num --- The number of lights.
+
+\return The defines to build the Phong shaders with, see ShaderLibrary.
+
+*/
+
+std::string Light::shaderDefines(Light lights[], int num)
+{
+    std::string defines = "LIGHTS=" + std::to_string(num);
+
+    for (int i = 0; i < num; i++)
+        defines += (i ? "," : " LIGHT_TYPES=") + std::to_string(lights[i].getType());
+
+    return defines;
+}
+
 /**
 \brief Sets the on for the light to the value of b.
 
@@ -5,6 +5,8 @@
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/type_ptr.hpp>
 
+#include <string>
+
 
 /**
 \file Light.h
@@ -16,6 +18,19 @@
 
 */
 
+/**
+\brief Kinds of light, the shaders are built for the kind of each light in the scene.
+The values match the LIGHT_ defines in PhongLights.glsl.
+
+*/
+
+enum LightType
+{
+    LIGHT_DIRECTIONAL = 1,  ///< Position w is 0, a light from far away along the position.
+    LIGHT_POINT = 2,        ///< Lights all around it, with attenuation.
+    LIGHT_SPOT = 3          ///< A point light fading outside its spot cutoff.
+};
+
 /**
 \class Light
 
@@ -72,6 +87,9 @@ public:
     float getSpotCutoff();
     float getSpotExponent();
     glm::vec3 getAttenuation();
+    LightType getType();
+
+    static std::string shaderDefines(Light lights[], int num);
 
     void setOn(bool b);
     void setPosition(glm::vec4 p);
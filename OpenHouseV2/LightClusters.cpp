@@ -0,0 +1,416 @@
+#include "LightClusters.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+/**
+\file LightClusters.cpp
+\brief Assigns many point and spot lights to a grid of clusters over the view frustum.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define CLUSTER_COUNT (CLUSTER_TILES_X*CLUSTER_TILES_Y*CLUSTER_SLICES)   ///< Clusters in the grid.
+
+bool LightClusters::enabled = true;
+GLint LightClusters::firstUnit = -1;
+
+/**
+\brief Fills a buffer, orphaning its old storage.  An empty buffer is given a few bytes
+so its texture is never without storage.
+
+\param target --- Target the buffer is bound to.
+\param buffer --- The buffer.
+\param data --- Data to upload.
+\param size --- Bytes of data.
+
+*/
+
+static void uploadBuffer(GLenum target, GLuint buffer, const void* data, size_t size)
+{
+    glBindBuffer(target, buffer);
+    glBufferData(target, std::max(size, (size_t)16), NULL, GL_STREAM_DRAW);
+    if (size > 0)
+        glBufferSubData(target, 0, size, data);
+    glBindBuffer(target, 0);
+}
+
+/**
+\brief Constructor, nothing is made until the first update.
+
+*/
+
+LightClusters::LightClusters()
+{
+    for (int i = 0; i < 4; i++)
+        buffers[i] = 0;
+    for (int i = 0; i < 3; i++)
+        textures[i] = 0;
+    maxTexels = 0;
+    assigned = 0;
+    cells.resize(2*CLUSTER_COUNT, 0);
+}
+
+/**
+\brief Destructor.  The OpenGL objects must already have been freed by release while
+the context was current.
+
+*/
+
+LightClusters::~LightClusters()
+{
+}
+
+/**
+\brief Returns the texture unit of the light buffer, the cell and index buffers are on
+the two after it, the last three units there are.
+
+*/
+
+GLint LightClusters::textureUnit()
+{
+    if (firstUnit < 0)
+    {
+        GLint units = 0;
+        glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+        firstUnit = std::max(units - 3, 0);
+    }
+    return firstUnit;
+}
+
+/**
+\brief Makes the buffers and their textures.
+
+*/
+
+void LightClusters::create()
+{
+    glGenBuffers(4, buffers);
+    glGenTextures(3, textures);
+
+    static const GLenum formats[3] = {GL_RGBA32F, GL_RG32UI, GL_R16UI};
+    for (int i = 0; i < 3; i++)
+    {
+        uploadBuffer(GL_TEXTURE_BUFFER, buffers[i], NULL, 0);
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+        glTexBuffer(GL_TEXTURE_BUFFER, formats[i], buffers[i]);
+    }
+    glBindTexture(GL_TEXTURE_BUFFER, 0);
+
+    glGetIntegerv(GL_MAX_TEXTURE_BUFFER_SIZE, &maxTexels);
+}
+
+/**
+\brief Frees the buffers and their textures.
+
+*/
+
+void LightClusters::release()
+{
+    if (buffers[0])
+    {
+        glDeleteTextures(3, textures);
+        glDeleteBuffers(4, buffers);
+    }
+    for (int i = 0; i < 4; i++)
+        buffers[i] = 0;
+    for (int i = 0; i < 3; i++)
+        textures[i] = 0;
+}
+
+/**
+\brief Removes the lights, called at the start of each frame before they are added.
+
+*/
+
+void LightClusters::clear()
+{
+    lights.clear();
+}
+
+/**
+\brief Adds a point or spot light for this frame.
+
+\param light --- The light, its position w must be 1 and it must be on.
+\param range --- Distance past which it lights nothing, it fades out before it.
+\param shadow --- Its shadow map from ShadowMaps::add, -1 for none.
+
+\return The light's number, -1 if it was off or there are CLUSTER_MAX_LIGHTS already.
+
+*/
+
+int LightClusters::add(Light light, float range, int shadow)
+{
+    if (!light.getOn() || light.getType() == LIGHT_DIRECTIONAL || lights.size() >= CLUSTER_MAX_LIGHTS)
+        return -1;
+
+    ClusterLight c;
+    c.position = glm::vec4(glm::vec3(light.getPosition()), range);
+    c.diffuse = glm::vec4(glm::vec3(light.getDiffuse()), light.getSpotExponent());
+    c.specular = glm::vec4(glm::vec3(light.getSpecular()), -2.0f);
+    c.spotDirection = glm::vec4(0.0f);
+    if (light.getType() == LIGHT_SPOT)
+    {
+        c.specular.w = cos(glm::radians(light.getSpotCutoff()));
+        c.spotDirection = glm::vec4(glm::normalize(light.getSpotDirection()), 0.0f);
+    }
+    c.attenuation = glm::vec4(light.getAttenuation(), shadow + 1.0f);
+
+    lights.push_back(c);
+    return lights.size() - 1;
+}
+
+/**
+\brief Finds the clusters a light's range sphere overlaps, a box of tiles and slices
+around the screen rectangle and depth span of the sphere.
+
+\param light --- Number of the light.
+\param view --- View matrix.
+\param projection --- Projection matrix.
+\param nearPlane --- Near plane distance of the projection.
+\param sliceScale --- Slices per unit of log depth.
+
+*/
+
+void LightClusters::assign(int light, const glm::mat4& view, const glm::mat4& projection, float nearPlane, float sliceScale)
+{
+    int* span = &spans[6*light];
+    span[0] = 1;
+    span[1] = 0;
+
+    glm::vec3 c = glm::vec3(view*glm::vec4(glm::vec3(lights[light].position), 1.0f));
+    float r = lights[light].position.w;
+    float depth = -c.z;
+    if (depth + r < nearPlane)
+        return;
+
+    int x0 = 0, x1 = CLUSTER_TILES_X - 1;
+    int y0 = 0, y1 = CLUSTER_TILES_Y - 1;
+
+    // A sphere crossing the near plane may cover any part of the screen.
+    if (depth - r > nearPlane)
+    {
+        glm::vec2 lo(1e30f), hi(-1e30f);
+        for (int i = 0; i < 8; i++)
+        {
+            glm::vec3 corner = c + glm::vec3(i & 1 ? r : -r, i & 2 ? r : -r, i & 4 ? r : -r);
+            glm::vec4 clip = projection*glm::vec4(corner, 1.0f);
+            glm::vec2 ndc = glm::vec2(clip)/clip.w;
+            lo = glm::min(lo, ndc);
+            hi = glm::max(hi, ndc);
+        }
+        if (hi.x < -1 || hi.y < -1 || lo.x > 1 || lo.y > 1)
+            return;
+
+        x0 = glm::clamp(int((lo.x*0.5f + 0.5f)*CLUSTER_TILES_X), 0, CLUSTER_TILES_X - 1);
+        x1 = glm::clamp(int((hi.x*0.5f + 0.5f)*CLUSTER_TILES_X), 0, CLUSTER_TILES_X - 1);
+        y0 = glm::clamp(int((lo.y*0.5f + 0.5f)*CLUSTER_TILES_Y), 0, CLUSTER_TILES_Y - 1);
+        y1 = glm::clamp(int((hi.y*0.5f + 0.5f)*CLUSTER_TILES_Y), 0, CLUSTER_TILES_Y - 1);
+    }
+
+    // Same slice as the shader finds, the first slice holds everything nearer than CLUSTER_NEAR.
+    float dmin = std::max(depth - r, CLUSTER_NEAR);
+    float dmax = std::max(depth + r, CLUSTER_NEAR);
+    int z0 = std::min(int(log(dmin/CLUSTER_NEAR)*sliceScale), CLUSTER_SLICES - 1);
+    int z1 = std::min(int(log(dmax/CLUSTER_NEAR)*sliceScale), CLUSTER_SLICES - 1);
+
+    span[0] = x0;
+    span[1] = x1;
+    span[2] = y0;
+    span[3] = y1;
+    span[4] = z0;
+    span[5] = z1;
+}
+
+/**
+\brief Assigns the lights added since clear to the clusters of a view, uploads the
+buffers and binds them for the clustered programs.  Called each frame after the lights
+are added and before anything is drawn.
+
+\param view --- View matrix of the frame.
+\param projection --- Perspective projection matrix of the frame.
+
+*/
+
+void LightClusters::update(const glm::mat4& view, const glm::mat4& projection)
+{
+    if (!buffers[0])
+        create();
+
+    // Near and far planes back from the perspective matrix.
+    float nearPlane = projection[3][2]/(projection[2][2] - 1.0f);
+    float farPlane = projection[3][2]/(projection[2][2] + 1.0f);
+    float sliceScale = CLUSTER_SLICES/log(std::max(farPlane/CLUSTER_NEAR, 1.0001f));
+
+    // Count the lights of each cluster.
+    std::fill(cells.begin(), cells.end(), 0);
+    spans.resize(6*lights.size());
+    long long total = 0;
+    assigned = 0;
+    for (size_t i = 0; i < lights.size(); i++)
+    {
+        assign(i, view, projection, nearPlane, sliceScale);
+        const int* s = &spans[6*i];
+        if (s[1] < s[0])
+            continue;
+
+        long long n = (long long)(s[1] - s[0] + 1)*(s[3] - s[2] + 1)*(s[5] - s[4] + 1);
+        if (total + n > maxTexels)
+        {
+            spans[6*i] = 1;
+            spans[6*i + 1] = 0;
+            continue;
+        }
+        total += n;
+        assigned++;
+
+        for (int z = s[4]; z <= s[5]; z++)
+            for (int y = s[2]; y <= s[3]; y++)
+                for (int x = s[0]; x <= s[1]; x++)
+                    cells[2*((z*CLUSTER_TILES_Y + y)*CLUSTER_TILES_X + x) + 1]++;
+    }
+
+    // Each cluster's lists starts where the one before it ends.
+    GLuint offset = 0;
+    for (int c = 0; c < CLUSTER_COUNT; c++)
+    {
+        cells[2*c] = offset;
+        offset += cells[2*c + 1];
+        cells[2*c + 1] = 0;
+    }
+
+    // Fill the lists, counting each cluster up again.
+    indices.resize(total);
+    for (size_t i = 0; i < lights.size(); i++)
+    {
+        const int* s = &spans[6*i];
+        for (int z = s[4]; z <= s[5] && s[0] <= s[1]; z++)
+            for (int y = s[2]; y <= s[3]; y++)
+                for (int x = s[0]; x <= s[1]; x++)
+                {
+                    GLuint* cell = &cells[2*((z*CLUSTER_TILES_Y + y)*CLUSTER_TILES_X + x)];
+                    indices[cell[0] + cell[1]++] = i;
+                }
+    }
+
+    ClusterGrid grid;
+    grid.view = view;
+    grid.projection = projection;
+    grid.depth = glm::vec4(CLUSTER_NEAR, sliceScale, nearPlane, farPlane);
+    grid.dims[0] = CLUSTER_TILES_X;
+    grid.dims[1] = CLUSTER_TILES_Y;
+    grid.dims[2] = CLUSTER_SLICES;
+    grid.dims[3] = 0;
+
+    uploadBuffer(GL_TEXTURE_BUFFER, buffers[0], lights.empty() ? NULL : &lights[0], lights.size()*sizeof(ClusterLight));
+    uploadBuffer(GL_TEXTURE_BUFFER, buffers[1], &cells[0], cells.size()*sizeof(GLuint));
+    uploadBuffer(GL_TEXTURE_BUFFER, buffers[2], indices.empty() ? NULL : &indices[0], indices.size()*sizeof(GLushort));
+    uploadBuffer(GL_UNIFORM_BUFFER, buffers[3], &grid, sizeof(grid));
+
+    glBindBufferBase(GL_UNIFORM_BUFFER, CLUSTER_GRID_BINDING, buffers[3]);
+    GLint unit = textureUnit();
+    for (int i = 0; i < 3; i++)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit + i);
+        glBindTexture(GL_TEXTURE_BUFFER, textures[i]);
+    }
+    glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+\brief Returns the lights added since clear.
+
+*/
+
+int LightClusters::getLightCount()
+{
+    return lights.size();
+}
+
+/**
+\brief Returns the lights that reached a cluster in the last update.
+
+*/
+
+int LightClusters::getAssignedCount()
+{
+    return assigned;
+}
+
+/**
+\brief Returns the entries of all the clusters' light lists in the last update.
+
+*/
+
+int LightClusters::getIndexCount()
+{
+    return indices.size();
+}
+
+/**
+\brief Turns clustered lighting on or off for the programs built after the call, on by
+default.
+
+\param on --- Build the lighting programs with CLUSTERED.
+
+*/
+
+void LightClusters::setEnabled(bool on)
+{
+    enabled = on;
+}
+
+/**
+\brief Returns true if the lighting programs are built with CLUSTERED.
+
+*/
+
+bool LightClusters::isEnabled()
+{
+    return enabled;
+}
+
+/**
+\brief Returns the define the lighting programs are built with, "CLUSTERED" or "".
+
+*/
+
+std::string LightClusters::shaderDefines()
+{
+    return enabled ? "CLUSTERED" : "";
+}
+
+/**
+\brief Points a program's ClusterGrid block and cluster samplers at the binding point
+and texture units update binds.  Called after a clustered program is built, a program
+without the block is left as it is.
+
+\param program --- The program.
+
+*/
+
+void LightClusters::bindProgram(GLuint program)
+{
+    if (!program)
+        return;
+
+    GLuint block = glGetUniformBlockIndex(program, "ClusterGrid");
+    if (block == GL_INVALID_INDEX)
+        return;
+    glUniformBlockBinding(program, block, CLUSTER_GRID_BINDING);
+
+    GLint current = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+    glUseProgram(program);
+
+    GLint unit = textureUnit();
+    glUniform1i(glGetUniformLocation(program, "clusterLights"), unit);
+    glUniform1i(glGetUniformLocation(program, "clusterCells"), unit + 1);
+    glUniform1i(glGetUniformLocation(program, "clusterIndices"), unit + 2);
+
+    glUseProgram(current);
+}
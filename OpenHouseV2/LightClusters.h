@@ -0,0 +1,127 @@
+#ifndef LIGHTCLUSTERS_H_INCLUDED
+#define LIGHTCLUSTERS_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+#include "Light.h"
+
+/**
+\file LightClusters.h
+
+\brief Header file for LightClusters.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define CLUSTER_TILES_X 16          ///< Clusters across the screen.
+#define CLUSTER_TILES_Y 9           ///< Clusters down the screen.
+#define CLUSTER_SLICES 24           ///< Clusters in depth, exponentially spaced.
+#define CLUSTER_NEAR 1.0f           ///< Depth where the second slice starts, everything nearer is in the first.
+#define CLUSTER_MAX_LIGHTS 4096     ///< Most lights in a frame, the rest are dropped.
+#define CLUSTER_GRID_BINDING 1      ///< Uniform buffer binding point of the ClusterGrid block.
+
+/**
+\brief A light as the shaders read it, five RGBA32F texels of the clusterLights buffer.
+
+*/
+
+struct ClusterLight
+{
+    glm::vec4 position;         ///< World position, w the range past which it lights nothing.
+    glm::vec4 diffuse;          ///< Diffuse color, w the spot exponent.
+    glm::vec4 specular;         ///< Specular color, w the cosine of the spot cutoff, -2 for a point light.
+    glm::vec4 spotDirection;    ///< Unit spot direction.
+    glm::vec4 attenuation;      ///< Constant, linear and quadratic attenuation, w its shadow map plus one.
+};
+
+/**
+\brief The ClusterGrid uniform block, std140.
+
+*/
+
+struct ClusterGrid
+{
+    glm::mat4 view;             ///< View the grid was built for.
+    glm::mat4 projection;       ///< Projection the grid was built for.
+    glm::vec4 depth;            ///< CLUSTER_NEAR and slices per unit of log depth.
+    GLint dims[4];              ///< Tiles across, tiles down and slices.
+};
+
+/**
+\class LightClusters
+
+\brief Clustered forward lighting, any number of point and spot lights at a cost that only
+depends on the lights reaching each pixel.
+
+The view frustum is cut into CLUSTER_TILES_X by CLUSTER_TILES_Y screen tiles and
+CLUSTER_SLICES depth slices, spaced exponentially from CLUSTER_NEAR to the far plane
+so the clusters are roughly cubes.  Each frame the lights added since clear are
+assigned on the CPU to the clusters their range sphere overlaps, found from the
+screen rectangle and depth span of the sphere, and written to three texture buffers:
+the lights, the first index and count of each cluster, and the light indices of all
+clusters one after another.  A fragment shader built with CLUSTERED (PhongLights.glsl)
+finds its cluster from its position and lights itself with that cluster's list.
+
+A clustered light has a range and fades smoothly to nothing at it, on top of the
+Light's attenuation, so it can be assigned to only the clusters it reaches.  Its
+ambient color is not used.  The scene's Lt lights are lit as before, the clusters are
+for the many small lights on top of them.
+
+The buffers are made on the first update and freed by release, which must be called
+with the context current.  Only the render thread may use it.
+
+*/
+
+class LightClusters
+{
+private:
+    static bool enabled;                    ///< Programs are built with CLUSTERED.
+    static GLint firstUnit;                 ///< Texture unit of the light buffer, the cell and index buffers follow.
+
+    std::vector<ClusterLight> lights;       ///< Lights added since clear.
+    std::vector<GLuint> cells;              ///< First index and count of each cluster.
+    std::vector<GLushort> indices;          ///< Lights of each cluster, one cluster after another.
+    std::vector<int> spans;                 ///< Cluster box of each light, x0 x1 y0 y1 z0 z1, x1 < x0 if it lights none.
+    GLuint buffers[4];                      ///< Light, cell and index texture buffers, then the ClusterGrid block.
+    GLuint textures[3];                     ///< Buffer textures over the first three buffers.
+    GLint maxTexels;                        ///< Most texels of a texture buffer.
+    int assigned;                           ///< Lights that reached a cluster in the last update.
+
+    static GLint textureUnit();
+
+    void create();
+    void assign(int light, const glm::mat4& view, const glm::mat4& projection, float nearPlane, float sliceScale);
+
+public:
+    LightClusters();
+    ~LightClusters();
+
+    void release();
+
+    void clear();
+    int add(Light light, float range, int shadow = -1);
+    void update(const glm::mat4& view, const glm::mat4& projection);
+
+    int getLightCount();
+    int getAssignedCount();
+    int getIndexCount();
+
+    static void setEnabled(bool on);
+    static bool isEnabled();
+    static std::string shaderDefines();
+    static void bindProgram(GLuint program);
+};
+
+#endif // LIGHTCLUSTERS_H_INCLUDED
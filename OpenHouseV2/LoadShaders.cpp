@@ -1,4 +1,7 @@
 #include "LoadShaders.h"
+#include "ShaderCache.h"
+
+#include <vector>
 
 /**
 \file LoadShaders.cpp
@@ -17,6 +20,9 @@ or the web page linking to them.
 None of these functions will invoke the glUseProgram function since it the user may
 wish to load in several shader programs.
 
+The programs are built by ShaderCache, which loads the binary an earlier run saved for
+the same code and driver instead of compiling, see ShaderCache.h.
+
 \subsection loadvffile Loading Vertex and Fragment Shaders from Files
 
 The files Shader1.vert and Shader1.frag are the vertex and fragment shaders respectively.
@@ -213,6 +219,30 @@ std::string getShaderString(GLenum type)
 }
 
 
+/**
+
+\brief Makes a program and has ShaderCache build it from the shader code, from a
+saved binary if it can.  Used by the LoadShaders functions.
+
+\param sources --- The shader types and code.
+
+\return Identifier for the shader program, or 0 on failure.
+
+*/
+
+static GLuint BuildProgram(const std::vector<ShaderSource>& sources)
+{
+    GLuint program = glCreateProgram();
+
+    if (!ShaderCache::build(program, sources))
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
 /**
 
 \brief Takes a ShaderInfo array containing the shader types and filenames for the
@@ -234,74 +264,22 @@ GLuint LoadShadersFromFile(ShaderInfo* shaders)
     if (shaders == NULL)
         return 0;
 
-    GLuint program = glCreateProgram();
-
-    ShaderInfo* entry = shaders;
-    while (entry->type != GL_NONE)
+    std::vector<ShaderSource> sources;
+    for (ShaderInfo* entry = shaders; entry->type != GL_NONE; ++entry)
     {
-        GLuint shader = glCreateShader(entry->type);
-
-        entry->shader = shader;
-
-        const GLchar* source = ReadShader(entry->filename);
-        if (source == NULL)
-        {
-            for (entry = shaders; entry->type != GL_NONE; ++entry)
-            {
-                glDeleteShader(entry->shader);
-                entry->shader = 0;
-            }
-
-            return 0;
-        }
-
-        glShaderSource(shader, 1, &source, NULL);
-        delete [] source;
+        entry->shader = 0;
 
-        glCompileShader(shader);
-
-        GLint compiled;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
-        if (!compiled)
-        {
-            GLsizei len;
-            glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &len);
-
-            GLchar* log = new GLchar[len+1];
-            glGetShaderInfoLog(shader, len, &len, log);
-            std::cerr << std::endl << getShaderString(entry->type) << " shader compilation failed: " << log << std::endl;
-            delete [] log;
+        const GLchar* code = ReadShader(entry->filename);
+        if (code == NULL)
             return 0;
-        }
-
-        glAttachShader(program, shader);
-        ++entry;
-    }
-
-    glLinkProgram(program);
-
-    GLint linked;
-    glGetProgramiv(program, GL_LINK_STATUS, &linked);
-    if (!linked)
-    {
-        GLsizei len;
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &len);
 
-        GLchar* log = new GLchar[len+1];
-        glGetProgramInfoLog(program, len, &len, log);
-        std::cerr << "Shader linking failed: " << log << std::endl;
-        delete [] log;
+        ShaderSource source = {entry->type, entry->filename, code};
+        delete [] code;
 
-        for (entry = shaders; entry->type != GL_NONE; ++entry)
-        {
-            glDeleteShader(entry->shader);
-            entry->shader = 0;
-        }
-
-        return 0;
+        sources.push_back(source);
     }
 
-    return program;
+    return BuildProgram(sources);
 }
 
 /**
@@ -325,72 +303,16 @@ GLuint LoadShadersFromMemory(ShaderInfo* shaders)
     if (shaders == NULL)
         return 0;
 
-    GLuint program = glCreateProgram();
-
-    ShaderInfo* entry = shaders;
-    while (entry->type != GL_NONE)
-    {
-        GLuint shader = glCreateShader(entry->type);
-
-        entry->shader = shader;
-
-        const GLchar* source = (GLchar*)(entry->code.c_str());
-        if (source == NULL)
-        {
-            for (entry = shaders; entry->type != GL_NONE; ++entry)
-            {
-                glDeleteShader(entry->shader);
-                entry->shader = 0;
-            }
-
-            return 0;
-        }
-
-        glShaderSource(shader, 1, &source, NULL);
-        glCompileShader(shader);
-
-        GLint compiled;
-        glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
-        if (!compiled)
-        {
-            GLsizei len;
-            glGetShaderiv( shader, GL_INFO_LOG_LENGTH, &len );
-
-            GLchar* log = new GLchar[len+1];
-            glGetShaderInfoLog( shader, len, &len, log );
-            std::cerr << std::endl << getShaderString(entry->type) << " shader compilation failed: " << log << std::endl;
-            delete [] log;
-            return 0;
-        }
-
-        glAttachShader(program, shader);
-        ++entry;
-    }
-
-    glLinkProgram(program);
-
-    GLint linked;
-    glGetProgramiv(program, GL_LINK_STATUS, &linked);
-    if (!linked)
+    std::vector<ShaderSource> sources;
+    for (ShaderInfo* entry = shaders; entry->type != GL_NONE; ++entry)
     {
-        GLsizei len;
-        glGetProgramiv(program, GL_INFO_LOG_LENGTH, &len);
-
-        GLchar* log = new GLchar[len+1];
-        glGetProgramInfoLog(program, len, &len, log);
-        std::cerr << "Shader linking failed: " << log << std::endl;
-        delete [] log;
+        entry->shader = 0;
 
-        for (entry = shaders; entry->type != GL_NONE; ++entry)
-        {
-            glDeleteShader(entry->shader);
-            entry->shader = 0;
-        }
-
-        return 0;
+        ShaderSource source = {entry->type, "", entry->code};
+        sources.push_back(source);
     }
 
-    return program;
+    return BuildProgram(sources);
 }
 
 /**
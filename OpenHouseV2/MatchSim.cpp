@@ -0,0 +1,573 @@
+#include "MatchSim.h"
+
+#include <string.h>
+
+/**
+\file MatchSim.cpp
+\brief The fixed timestep game logic, moved out of GraphicsEngine so a match can be run
+and replayed without a window.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor, puts the game in its starting state.
+
+\param f0 --- Player one's fighter.
+\param f1 --- Player two's fighter.
+\param fighterTable --- Fighter definitions, which must have the fighters picked by
+default, IDs 1 and 3.
+
+*/
+
+MatchSim::MatchSim(FighterCore* f0, FighterCore* f1, const FighterTable* fighterTable)
+{
+    fighters[0] = f0;
+    fighters[1] = f1;
+    table = fighterTable;
+    reset();
+}
+
+/**
+\brief Puts the game back to how it is when the program starts, on the main menu.
+
+The fighters are reset to a freshly constructed FighterCore first so nothing from an
+earlier match carries over, a recording always starts from here.
+
+*/
+
+void MatchSim::reset()
+{
+    FighterCore fresh;
+    for (int i = 0; i < 2; i++)
+    {
+        *fighters[i] = fresh;
+        fighters[i]->setTable(table);
+    }
+
+    fighters[0]->newFighter(0, 3); // Important to change later, right now set to hand fighter by default
+    fighters[1]->newFighter(1, 1);
+
+    curFIndex[0] = 3;
+    curFIndex[1] = 1;
+
+    cameraPos = 0;
+    cameraX = 0;
+    cameraZ = 100;
+    //Sets default "arena" to the main menu
+    arenaNum = 3;
+    paused = false;
+    gameOver = false;
+
+    carX[0] = 500;
+    carX[1] = -800;
+    carAngle[0] = 10;
+    carAngle[1] = 156;
+    menuAngle = 0;
+
+    tickCount = 0;
+    saveState();
+}
+
+/**
+\brief Runs one fixed step of the game logic.
+
+Everything that moves by a set amount per step lives here, the fighters' combat
+animation, the cars in arena one and the menu blades and camera.  The state before the
+step is saved first so the renderer can blend between the two.
+
+*/
+
+void MatchSim::tick()
+{
+    saveState();
+
+    //Combat Animation
+    if (!paused)
+        FighterCore::stepPair(*fighters[0], *fighters[1], curFIndex, hits);
+
+    if (arenaNum == 1 && !(paused || gameOver))
+    {
+        //Low Polygon Car
+        if (carX[0] >= -500)
+            carX[0] -= 8;
+        else
+            carX[0] = 500;
+
+        if (carX[0] <= 120 && carX[0] >= -120)
+            carAngle[0] += 5;
+        else
+            carAngle[0] = 10;
+
+        //Car Two
+        if (carX[1] <= 800)
+            carX[1] += 6;
+        else
+            carX[1] = -800;
+
+        if (carX[1] <= 120 && carX[1] >= -120)
+            carAngle[1] -= 3;
+        else
+            carAngle[1] = 156;
+    }
+    else if (arenaNum == 3)
+    {
+        menuAngle += 1;
+
+        //Camera Movements Handler
+        switch (cameraPos)
+        {
+            case 0:
+                makeValue(0, 0, 1);
+                makeValue(1, 100, 1);
+                break;
+            case 1:
+                makeValue(0, 0, 1);
+                makeValue(1, 50, 1);
+                break;
+            case 2:
+                makeValue(0, 35, 1);
+                makeValue(1, 50, 1);
+                break;
+            case 3:
+                makeValue(0, -35, 1);
+                makeValue(1, 50, 1);
+                break;
+            case 4:
+                makeValue(0, -10, 0.5);
+                makeValue(1, -10, 0.5);
+                break;
+            case 5:
+                makeValue(0, 10, 0.5);
+                makeValue(1, -10, 0.5);
+                break;
+            case 6:
+            case 7:
+                makeValue(0, 0, 1);
+                makeValue(1, -30, 1);
+                break;
+        }
+    }
+
+    tickCount++;
+}
+
+/**
+\brief Applies one input, before the tick it was stamped with.
+
+\param in --- The input.
+
+*/
+
+void MatchSim::applyInput(const SimInput& in)
+{
+    if (in.player < 0 || in.player > 1)
+        return;
+
+    switch (in.type)
+    {
+        case SIM_MOVE:
+            fighters[in.player]->fighterMoveX(in.player, in.a, in.b);
+            break;
+        case SIM_PUNCH:
+            fighters[in.player]->punchNow(in.player);
+            break;
+        case SIM_KICK:
+            fighters[in.player]->kickNow(in.player);
+            break;
+        case SIM_TORNADO:
+            fighters[in.player]->tornadoNow(in.player);
+            break;
+        case SIM_JUMP:
+            fighters[in.player]->fighterJump(in.player);
+            break;
+        case SIM_RESTART:
+            restartGame();
+            break;
+        case SIM_PAUSE:
+            togglePause();
+            break;
+        case SIM_MENU_RIGHT:
+            menuRightSlide();
+            break;
+        case SIM_MENU_LEFT:
+            menuLeftSlide();
+            break;
+        case SIM_MENU_SELECT:
+            menuSelect();
+            break;
+        case SIM_MENU_BACK:
+            menuBackout();
+            break;
+        case SIM_RETURN_TO_MENU:
+            returnToMenu();
+            break;
+        case SIM_SET_FIGHTER:
+            setCurFIndex(in.player, in.a);
+            break;
+        default:
+            break;
+    }
+}
+
+/**
+\brief Copies the current game state into the "before the last tick" state.
+
+Also called after anything that teleports the fighters so they are not blended
+across the jump.
+
+*/
+
+void MatchSim::saveState()
+{
+    captureState(prev);
+}
+
+/**
+\brief Copies the continuous game state into a SimState.
+
+\param st --- State to fill.
+
+*/
+
+void MatchSim::captureState(SimState& st)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        st.fighterX[i] = fighters[i]->fighterX[i];
+        st.fighterHeight[i] = fighters[i]->fighterHeight[i];
+        st.carX[i] = carX[i];
+        st.carAngle[i] = carAngle[i];
+    }
+
+    for (int i = 0; i < 2*FIGHTER_LIMBS; i++)
+        for (int x = 0; x < 3; x++)
+            st.rotations[i][x] = fighters[i/FIGHTER_LIMBS]->rotations[i%FIGHTER_LIMBS][x];
+
+    st.menuAngle = menuAngle;
+    st.cameraX = cameraX;
+    st.cameraZ = cameraZ;
+}
+
+/**
+\brief Adds bytes to an FNV-1a hash.
+
+\param h --- Hash so far.
+\param data --- Bytes to add.
+\param size --- Number of bytes.
+
+\return The new hash.
+
+*/
+
+static unsigned int hashBytes(unsigned int h, const void* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/**
+\brief Returns a hash of the game state, used to check that a replay ended exactly
+where the recording did.
+
+*/
+
+unsigned int MatchSim::checksum()
+{
+    SimState st;
+    captureState(st);
+
+    unsigned int h = 2166136261u;
+    h = hashBytes(h, &st, sizeof(st));
+    h = hashBytes(h, &tickCount, sizeof(tickCount));
+
+    int flags[4] = {arenaNum, cameraPos, curFIndex[0], curFIndex[1]};
+    h = hashBytes(h, flags, sizeof(flags));
+
+    float hp[4] = {fighters[1]->fighterHP[0], fighters[0]->fighterHP[1],
+                   fighters[0]->stunCounter[0], fighters[1]->stunCounter[1]};
+    h = hashBytes(h, hp, sizeof(hp));
+
+    return h;
+}
+
+/**
+\brief Saves the whole game logic state.
+
+\param snap --- Snapshot to fill.
+
+*/
+
+void MatchSim::save(MatchSnapshot& snap)
+{
+    snap.match = *this;
+    fighters[0]->saveState(snap.fighters[0]);
+    fighters[1]->saveState(snap.fighters[1]);
+}
+
+/**
+\brief Puts back a state saved by save.
+
+\param snap --- Snapshot to restore.
+
+*/
+
+void MatchSim::restore(const MatchSnapshot& snap)
+{
+    MatchState::operator=(snap.match);
+    fighters[0]->loadState(snap.fighters[0]);
+    fighters[1]->loadState(snap.fighters[1]);
+}
+
+/**
+\brief Turns the sound effects of both fighters off or back on, for ticks that are
+simulated again after a rollback.
+
+\param on --- True for no sound.
+
+*/
+
+void MatchSim::setQuiet(bool on)
+{
+    fighters[0]->quiet = on;
+    fighters[1]->quiet = on;
+}
+
+/**
+\brief Restarts the game if and only if the game is already over
+
+*/
+
+void MatchSim::restartGame()
+{
+    //if (gameOver)
+    //{
+    for (int i = 0; i < 2; i++)
+    {
+        fighters[i]->fighterHP[1 - i] = 75;
+        fighters[i]->readyStance(i);
+        fighters[i]->fighterX[i] = -fighters[i]->fighterDir[i]*18;
+        fighters[i]->fighterHeight[i] = 0;
+    }
+    saveState();
+    gameOver = false;
+    paused = false;
+    //}
+}
+
+/**
+\brief Starts a match in an arena between the fighters picked on the menu.
+
+\param arena --- Arena number, 0 for the bath house and 1 for the alley way.
+
+*/
+
+void MatchSim::startMatch(int arena)
+{
+    arenaNum = arena;
+    //Set Correct Fighter IDs
+    fighters[0]->setFighterID(curFIndex[0], curFIndex[1]);
+    fighters[1]->setFighterID(curFIndex[1], curFIndex[0]);
+    restartGame();
+}
+
+/**
+\brief Toggles the Video Pause
+
+*/
+
+void MatchSim::togglePause()
+{
+    paused = !paused;
+}
+
+/**
+\brief Changes a player's selected fighter, only on the menu and only to one that can
+be picked.
+
+\param playerNum --- Player number.
+\param fighterIndex --- Fighter ID.
+
+*/
+
+void MatchSim::setCurFIndex(int playerNum, int fighterIndex)
+{
+    if (fighterIndex < 0 || fighterIndex >= table->count || !table->selectable[fighterIndex])
+        return;
+
+    //Don't want fighter swapping mid fight, only in arena  which is menu
+    if (arenaNum == 3){
+        curFIndex[playerNum] = fighterIndex;
+    }
+}
+
+void MatchSim::makeValue(float changingVar, float toValue, float rate)
+{
+    bool isX = true;
+    if (changingVar == 0)
+        changingVar = cameraX;
+    else if (changingVar == 1)
+    {
+        changingVar = cameraZ;
+        isX = 0;
+    }
+
+    if (changingVar < toValue)
+        changingVar += rate;
+    else if (changingVar > toValue)
+        changingVar -= rate;
+
+    if (isX)
+        cameraX = changingVar;
+    else
+        cameraZ = changingVar;
+}
+void MatchSim::menuRightSlide()
+{
+    switch (cameraPos)
+    {
+        case 1:
+            cameraPos = 2;
+            break;
+        case 2:
+            cameraPos = 3;
+            break;
+        case 3:
+            cameraPos = 1;
+            break;
+        case 4:
+            cameraPos = 5;
+            break;
+        case 5:
+            cameraPos = 4;
+            break;
+        case 6:
+            //Swaps displayed fighter
+            curFIndex[0] = table->nextSelectable(curFIndex[0], 1);
+            break;
+        case 7:
+            //Swaps displayed fighter
+            curFIndex[0] = table->nextSelectable(curFIndex[0], 1);
+            break;
+        default:
+            break;
+    }
+    //std::cout<<cameraPos<<std::endl;
+}
+
+void MatchSim::menuLeftSlide()
+{
+    switch (cameraPos)
+    {
+        case 1:
+            cameraPos = 3;
+            break;
+        case 2:
+            cameraPos = 1;
+            break;
+        case 3:
+            cameraPos = 2;
+            break;
+        case 4:
+            cameraPos = 5;
+            break;
+        case 5:
+            cameraPos = 4;
+        case 6:
+            //Swaps displayed fighter
+            curFIndex[0] = table->nextSelectable(curFIndex[0], -1);
+            break;
+        case 7:
+            //Swaps displayed fighter
+            curFIndex[0] = table->nextSelectable(curFIndex[0], -1);
+            break;
+        default:
+            break;
+    }
+    //std::cout<<cameraPos<<std::endl;
+}
+
+void MatchSim::menuSelect()
+{
+    switch (cameraPos)
+    {
+        case 0:
+            cameraPos = 1;
+            break;
+        case 1:
+            cameraPos = 4;
+            break;
+        case 2:
+            //Goes to Vs Battle options (When gamemode is added)
+            break;
+        case 3:
+            //Goes to Story mode options (When gamemode is added)
+            break;
+        case 4:
+            //arenaNum = 0;
+            //restartGame();
+            cameraPos = 6;//Roman Arena Selected
+            break;
+        case 5:
+            //arenaNum = 1;
+            //restartGame();
+            cameraPos = 7;//Roman Arena Selected
+            break;
+        case 6:
+            startMatch(0);//Loads Roman Bath House
+            break;
+        case 7:
+            startMatch(1);//Loads alley way
+            break;
+        default:
+            break;
+    }
+    //std::cout<<cameraPos<<std::endl;
+}
+
+void MatchSim::menuBackout()
+{
+    switch (cameraPos)
+    {
+        case 1:
+            cameraPos = 0;
+            break;
+        case 2:
+            cameraPos = 0;
+            break;
+        case 3:
+            cameraPos = 0;
+            break;
+        case 4:
+            cameraPos = 1;
+            break;
+        case 5:
+            cameraPos = 1;
+            break;
+        case 6:
+            cameraPos = 4;
+            break;
+        case 7:
+            cameraPos = 5;
+        default:
+            break;
+    }
+    //std::cout<<cameraPos<<std::endl;
+}
+
+void MatchSim::returnToMenu()
+{
+    if (paused || gameOver)
+    {
+        cameraPos = 1;
+        arenaNum = 3;
+    }
+}
@@ -0,0 +1,107 @@
+#ifndef MATCHSIM_H_INCLUDED
+#define MATCHSIM_H_INCLUDED
+
+#include "FighterCore.h"
+#include "SimChannel.h"
+
+/**
+\file MatchSim.h
+
+\brief Header file for MatchSim.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief The parts of the game logic state that are not in the fighters.
+
+*/
+
+struct MatchState
+{
+    int arenaNum;         ///< Arena being played, 3 is the menu.
+    int cameraPos;        ///< Menu position.
+    int curFIndex[2];     ///< Fighter selected by each player.
+    bool paused;          ///< Game paused.
+    bool gameOver;        ///< Game over.
+
+    float carX[2];        ///< Positions of the two cars in arena one.
+    float carAngle[2];    ///< Headlight sweep angles of the two cars.
+    float menuAngle;      ///< Spin of the menu blades.
+    float cameraX;        ///< Menu camera x.
+    float cameraZ;        ///< Menu camera z.
+
+    long long tickCount;  ///< Ticks run since the last reset.
+};
+
+/**
+\brief The whole game logic state, saved and restored by MatchSim for rollback.
+
+A plain copy of 640 bytes, close to half of it the limb rotations.  The state before the
+last tick kept for drawing is left out, the next tick recomputes it.
+
+*/
+
+struct MatchSnapshot
+{
+    MatchState match;             ///< Menu, arena and tick.
+    FighterState fighters[2];     ///< Both fighters.
+};
+
+static_assert(std::is_trivially_copyable<MatchSnapshot>::value, "MatchSnapshot must stay a plain copyable struct");
+
+/**
+\class MatchSim
+
+\brief The game logic run by the fixed timestep, the two fighters, the menu, the arena
+one cars, pause and restart, with no graphics or sound.
+
+Given the same starting state and the same inputs on the same ticks it always ends in
+the same state, which is what input recording and replay rely on.  The fighters are
+owned by the caller so the engine can hand in its Fighter objects and a headless
+driver plain FighterCore objects, and so is the FighterTable they fight by.
+
+*/
+
+class MatchSim : public MatchState
+{
+private:
+    HitWorld hits;              ///< Collision scratch space, rebuilt every tick so not part of the state.
+
+    void makeValue(float changingVar, float toValue, float rate);
+
+public:
+    FighterCore* fighters[2];   ///< The two fighters, not owned.
+    const FighterTable* table;  ///< Fighter definitions, not owned.
+    SimState prev;              ///< State before the last tick.
+
+    MatchSim(FighterCore* f0, FighterCore* f1, const FighterTable* fighterTable);
+
+    void reset();
+    void tick();
+    void applyInput(const SimInput& in);
+
+    void saveState();
+    void captureState(SimState& st);
+    unsigned int checksum();
+
+    void save(MatchSnapshot& snap);
+    void restore(const MatchSnapshot& snap);
+    void setQuiet(bool on);
+
+    void restartGame();
+    void startMatch(int arena);
+    void togglePause();
+    void returnToMenu();
+    void setCurFIndex(int playerNum, int fighterIndex);
+
+    void menuRightSlide();
+    void menuLeftSlide();
+    void menuSelect();
+    void menuBackout();
+};
+
+#endif // MATCHSIM_H_INCLUDED
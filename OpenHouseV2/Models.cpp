@@ -1,5 +1,9 @@
 #include "Models.h"
 
+#include <algorithm>
+#include <functional>
+#include <thread>
+
 /**
 \file Models.cpp
 \brief Implementation file for the Models class.
@@ -10,6 +14,8 @@
 
 */
 
+GLint Models::threads = 1;
+
 /**
 \brief Constructor, default.
 
@@ -88,13 +94,14 @@ array into a one dimensional array.
 \param k --- Dimension 3 index.
 
 \return The position of the three dimensional (i, j, k) position in
-the one dimensional array, i.e. 3*((lon+1)*j+i)+k.
+the one dimensional array, i.e. k*(lon+1)*(lat+1)+(lon+1)*j+i, so each
+coordinate is a plane of its own and each row is contiguous in it.
 
 */
 
 int Models::pos(int i, int j, int k)
 {
-    return 3*((lon+1)*j+i)+k;
+    return k*(lon+1)*(lat+1)+(lon+1)*j+i;
 }
 
 /**
@@ -115,6 +122,55 @@ void Models::CrossProd(GLfloat x1, GLfloat y1, GLfloat z1,
     *cz = x1*y2-x2*y1;
 }
 
+/**
+\brief Sizes the terms of a surface.
+
+\param t --- Terms, every column and row array is resized.
+\param cols --- Number of columns, lon+1.
+\param rows --- Number of rows, lat+1.
+
+*/
+
+void Models::resizeTerms(SurfaceTerms& t, int cols, int rows)
+{
+    for (int i = 0; i < 8; i++)
+        t.col[i].resize(cols);
+    for (int i = 0; i < 4; i++)
+        t.row[i].resize(rows);
+    for (int i = 0; i < 4; i++)
+        t.k[i] = 0;
+}
+
+/**
+\brief Builds every row of the surface with a row kernel.  A surface of at least
+MODELS_THREAD_VERTICES vertices is split into blocks of rows, one for each thread, the
+first block built on the calling thread.  The kernels only write their own rows, so
+the blocks need no locking.
+
+\param kernel --- Row kernel.
+\param t --- Terms of the surface passed to the kernel.
+
+*/
+
+void Models::runRows(RowKernel kernel, const SurfaceTerms& t)
+{
+    int rows = lat+1;
+    int n = threads;
+    if ((lon+1)*(lat+1) < MODELS_THREAD_VERTICES)
+        n = 1;
+    if (n > rows)
+        n = rows;
+
+    std::vector<std::thread> workers;
+    for (int w = 1; w < n; w++)
+        workers.push_back(std::thread(kernel, this, std::cref(t), rows*w/n, rows*(w+1)/n));
+
+    (this->*kernel)(t, 0, rows/n);
+
+    for (size_t w = 0; w < workers.size(); w++)
+        workers[w].join();
+}
+
 /**
 \brief Uses the data set to determine the normals at each vertex.  The algorithm
 uses the 8 vertices around each vertex and the 8 triangles produced by each of
@@ -124,105 +180,87 @@ the consecutive vertices and averages the normals.
 
 void Models::createNormals()
 {
-    GLfloat v1x, v1y, v1z, v2x, v2y, v2z;
-    GLfloat cx, cy, cz;
-    GLfloat scx, scy, scz;
-    int v1i, v1j, v2i, v2j;
-    GLfloat mod;
+    SurfaceTerms none;
+    runRows(&Models::normalRows, none);
+}
 
-    for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
+/**
+\brief Row kernel of createNormals.  Rather than test every neighbor of every vertex,
+each of the 8 triangles around the vertices is added across the run of columns that
+has both its far corners in the grid, so the loop over the row has no branches.  The
+triangles are added in the same order around each vertex as before.
+
+\param j0 --- First row.
+\param j1 --- One past the last row.
+
+*/
+
+void Models::normalRows(const SurfaceTerms&, int j0, int j1)
+{
+    // Column and row steps to the two far corners of each triangle, in turn around the vertex.
+    static const int ring[8][4] = {{1, 0, 1, 1}, {1, 1, 0, 1}, {0, 1, -1, 1}, {-1, 1, -1, 0},
+                                   {-1, 0, -1, -1}, {-1, -1, 0, -1}, {0, -1, 1, -1}, {1, -1, 1, 0}};
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *X = dat;
+    const GLfloat *Y = dat+n;
+    const GLfloat *Z = dat+2*n;
+
+    std::vector<GLfloat> sum(3*w);
+    GLfloat *sx = &sum[0];
+    GLfloat *sy = sx+w;
+    GLfloat *sz = sy+w;
+
+    for (int j = j0; j < j1; j++)
+    {
+        std::fill(sum.begin(), sum.end(), 0.0f);
+        int p = j*w;
+
+        for (int k = 0; k < 8; k++)
         {
-            scx = 0;
-            scy = 0;
-            scz = 0;
-            for (int k = 0; k < 8; k++)
-            {
-                switch (k)
-                {
-                case 0:
-                    v1i = i+1;
-                    v1j = j;
-                    v2i = i+1;
-                    v2j = j+1;
-                    break;
-                case 1:
-                    v1i = i+1;
-                    v1j = j+1;
-                    v2i = i;
-                    v2j = j+1;
-                    break;
-                case 2:
-                    v1i = i;
-                    v1j = j+1;
-                    v2i = i-1;
-                    v2j = j+1;
-                    break;
-                case 3:
-                    v1i = i-1;
-                    v1j = j+1;
-                    v2i = i-1;
-                    v2j = j;
-                    break;
-                case 4:
-                    v1i = i-1;
-                    v1j = j;
-                    v2i = i-1;
-                    v2j = j-1;
-                    break;
-                case 5:
-                    v1i = i-1;
-                    v1j = j-1;
-                    v2i = i;
-                    v2j = j-1;
-                    break;
-                case 6:
-                    v1i = i;
-                    v1j = j-1;
-                    v2i = i+1;
-                    v2j = j-1;
-                    break;
-                case 7:
-                    v1i = i+1;
-                    v1j = j-1;
-                    v2i = i+1;
-                    v2j = j;
-                    break;
-                }
-
-                if ((v1i >= 0) && (v1i <= lon) && (v1j >= 0) && (v1j <= lat) && (v2i >= 0) && (v2i <= lon) && (v2j >= 0) && (v2j <= lat))
-                {
-                    v1x = dat[pos(v1i,v1j,0)] - dat[pos(i,j,0)];
-                    v1y = dat[pos(v1i,v1j,1)] - dat[pos(i,j,1)];
-                    v1z = dat[pos(v1i,v1j,2)] - dat[pos(i,j,2)];
-                    v2x = dat[pos(v2i,v2j,0)] - dat[pos(i,j,0)];
-                    v2y = dat[pos(v2i,v2j,1)] - dat[pos(i,j,1)];
-                    v2z = dat[pos(v2i,v2j,2)] - dat[pos(i,j,2)];
-
-                    CrossProd(v1x, v1y, v1z, v2x, v2y, v2z, &cx, &cy, &cz);
-                    mod = sqrt(cx*cx + cy*cy + cz*cz);
-                    if (mod > 0.000001)
-                    {
-                        scx += cx;
-                        scy += cy;
-                        scz += cz;
-                    }
-                }
-            }
-            mod = sqrt(scx*scx + scy*scy + scz*scz);
-            if (mod > 0.000001)
+            int v1j = j+ring[k][1];
+            int v2j = j+ring[k][3];
+            if ((v1j < 0) || (v1j > lat) || (v2j < 0) || (v2j > lat))
+                continue;
+
+            int first = std::max(0, -std::min(ring[k][0], ring[k][2]));
+            int last = lon - std::max(0, std::max(ring[k][0], ring[k][2]));
+            int a = v1j*w+ring[k][0];
+            int b = v2j*w+ring[k][2];
+
+#pragma GCC ivdep
+            for (int i = first; i <= last; i++)
             {
-                normals[pos(i,j,0)] = scx/mod;
-                normals[pos(i,j,1)] = scy/mod;
-                normals[pos(i,j,2)] = scz/mod;
-            }
-            else
-            {
-                normals[pos(i,j,0)] = scx;
-                normals[pos(i,j,1)] = scy;
-                normals[pos(i,j,2)] = scz;
+                GLfloat v1x = X[a+i] - X[p+i];
+                GLfloat v1y = Y[a+i] - Y[p+i];
+                GLfloat v1z = Z[a+i] - Z[p+i];
+                GLfloat v2x = X[b+i] - X[p+i];
+                GLfloat v2y = Y[b+i] - Y[p+i];
+                GLfloat v2z = Z[b+i] - Z[p+i];
+
+                GLfloat cx = v1y*v2z-v2y*v1z;
+                GLfloat cy = -v1x*v2z+v1z*v2x;
+                GLfloat cz = v1x*v2y-v2x*v1y;
+
+                // Degenerate triangles, at a pole for instance, are left out.
+                bool keep = cx*cx + cy*cy + cz*cz > 0.000000000001f;
+                sx[i] += keep ? cx : 0;
+                sy[i] += keep ? cy : 0;
+                sz[i] += keep ? cz : 0;
             }
         }
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
+        {
+            GLfloat mod = sqrt(sx[i]*sx[i] + sy[i]*sy[i] + sz[i]*sz[i]);
+            if (!(mod > 0.000001f))
+                mod = 1;
+            normals[p+i] = sx[i]/mod;
+            normals[n+p+i] = sy[i]/mod;
+            normals[2*n+p+i] = sz[i]/mod;
+        }
+    }
 }
 
 /**
@@ -232,10 +270,8 @@ void Models::createNormals()
 
 void Models::reverseNormals()
 {
-    for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-            for (int k = 0; k < 3; k++)
-                normals[pos(i,j,k)] = -normals[pos(i,j,k)];
+    for (int i = 0; i < 3*(lon+1)*(lat+1); i++)
+        normals[i] = -normals[i];
 }
 
 /**
@@ -371,14 +407,17 @@ void Models::LoadDataToGraphicsCard(GLint v, GLint c, GLint n, GLint t)
             tex[2*i*(lat+1)+2*j+1] = 1.0*j/lat;
         }
 
+    bounds.reset();
     for (int i = 0; i < lon+1; i++)
         for (int j = 0; j < lat+1; j++)
         {
+            bounds.add(dat[pos(i,j,0)], dat[pos(i,j,1)], dat[pos(i,j,2)]);
             points[4*i*(lat+1)+4*j] = dat[pos(i,j,0)];
             points[4*i*(lat+1)+4*j+1] = dat[pos(i,j,1)];
             points[4*i*(lat+1)+4*j+2] = dat[pos(i,j,2)];
             points[4*i*(lat+1)+4*j+3] = 1;
         }
+    bounds.finish();
 
     for (int i = 0; i < lon+1; i++)
         for (int j = 0; j < lat+1; j++)
@@ -556,6 +595,16 @@ void Models::draw()
     }
 }
 
+/**
+\brief Returns the object space bounding volume of the model for culling.
+
+*/
+
+const BoundingVolume& Models::getBounds()
+{
+    return bounds;
+}
+
 /**
 \brief Creates a sphere.
 
@@ -586,20 +635,67 @@ void Models::createSphereOBJ(GLfloat r, GLint ilon, GLint ilat)
 void Models::createPartialSphereOBJ(GLfloat r, GLint ilon, GLint ilat, GLfloat begintheta, GLfloat endtheta, GLfloat beginpsi, GLfloat endpsi)
 {
     resetArraySize(ilon, ilat);
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
     for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
+    {
+        GLfloat theta = begintheta + (endtheta-begintheta)*((float)i/lon);
+        t.col[0][i] = cos(theta);
+        t.col[1][i] = sin(theta);
+    }
+
+    for (int j = 0; j <= lat; j++)
+    {
+        GLfloat psi = beginpsi + (endpsi-beginpsi)*((float)j/lat);
+        t.row[0][j] = cos(psi);
+        t.row[1][j] = sin(psi);
+    }
+
+    t.k[0] = r;
+    runRows(&Models::sphereRows, t);
+}
+
+/**
+\brief Row kernel of the sphere.  Columns cos(theta), sin(theta), rows cos(psi),
+sin(psi), constant the radius.
+
+\param t --- Terms of the sphere.
+\param j0 --- First row.
+\param j1 --- One past the last row.
+
+*/
+
+void Models::sphereRows(const SurfaceTerms& t, int j0, int j1)
+{
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *ct = &t.col[0][0];
+    const GLfloat *st = &t.col[1][0];
+    GLfloat r = t.k[0];
+
+    for (int j = j0; j < j1; j++)
+    {
+        GLfloat *x = dat+j*w;
+        GLfloat *y = x+n;
+        GLfloat *z = y+n;
+        GLfloat *nx = normals+j*w;
+        GLfloat *ny = nx+n;
+        GLfloat *nz = ny+n;
+        GLfloat cp = t.row[0][j];
+        GLfloat sp = t.row[1][j];
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
         {
-            GLfloat theta = begintheta + (endtheta-begintheta)*((float)i/lon);
-            GLfloat psi = beginpsi + (endpsi-beginpsi)*((float)j/lat);
-
-            dat[pos(i,j,0)] = r*cos(psi)*cos(theta);
-            dat[pos(i,j,1)] = r*cos(psi)*sin(theta);
-            dat[pos(i,j,2)] = r*sin(psi);
-            normals[pos(i,j,0)] = dat[pos(i,j,0)]/r;
-            normals[pos(i,j,1)] = dat[pos(i,j,1)]/r;
-            normals[pos(i,j,2)] = dat[pos(i,j,2)]/r;
+            nx[i] = cp*ct[i];
+            ny[i] = cp*st[i];
+            nz[i] = sp;
+            x[i] = r*nx[i];
+            y[i] = r*ny[i];
+            z[i] = r*sp;
         }
+    }
 }
 
 /**
@@ -636,27 +732,116 @@ void Models::createPartialTorusOBJ(GLfloat irad, GLfloat orad, GLint ilon, GLint
     GLfloat r = (orad - irad)/2;
     GLfloat rax = r+irad;
     resetArraySize(ilon, ilat);
-    GLdouble cx, cy, cz;
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
     for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-        {
-            GLfloat theta = begintheta + (endtheta-begintheta)*((float)i/lon);
-            GLfloat psi = endpsi - (beginpsi + (endpsi-beginpsi)*((float)j/lat));
+    {
+        GLfloat theta = begintheta + (endtheta-begintheta)*((float)i/lon);
+        t.col[0][i] = cos(theta);
+        t.col[1][i] = sin(theta);
+    }
 
-            dat[pos(i,j,0)] = (rax-r*cos(psi))*cos(theta);
-            dat[pos(i,j,1)] = (rax-r*cos(psi))*sin(theta);
-            dat[pos(i,j,2)] = r*sin(psi);
+    for (int j = 0; j <= lat; j++)
+    {
+        GLfloat psi = endpsi - (beginpsi + (endpsi-beginpsi)*((float)j/lat));
+        GLdouble cr = -r*cos(psi);
+        GLdouble cz = r*sin(psi);
+        GLdouble mod = sqrt(cr*cr + cz*cz);
+
+        t.row[0][j] = rax-r*cos(psi);
+        t.row[1][j] = r*sin(psi);
+        t.row[2][j] = cr/mod;
+        t.row[3][j] = cz/mod;
+    }
 
-            cx = -r*cos(psi)*cos(theta);
-            cy = -r*cos(psi)*sin(theta);
-            cz = r*sin(psi);
+    runRows(&Models::torusRows, t);
+}
+
+/**
+\brief Row kernel of the torus.  Columns cos(theta), sin(theta), rows the distance
+from the axis, the height, and the normal's part away from the axis and its height.
+
+\param t --- Terms of the torus.
+\param j0 --- First row.
+\param j1 --- One past the last row.
+
+*/
+
+void Models::torusRows(const SurfaceTerms& t, int j0, int j1)
+{
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *ct = &t.col[0][0];
+    const GLfloat *st = &t.col[1][0];
 
-            GLdouble mod = sqrt(cx*cx + cy*cy + cz*cz);
-            normals[pos(i,j,0)] = cx/mod;
-            normals[pos(i,j,1)] = cy/mod;
-            normals[pos(i,j,2)] = cz/mod;
+    for (int j = j0; j < j1; j++)
+    {
+        GLfloat *x = dat+j*w;
+        GLfloat *y = x+n;
+        GLfloat *z = y+n;
+        GLfloat *nx = normals+j*w;
+        GLfloat *ny = nx+n;
+        GLfloat *nz = ny+n;
+        GLfloat rad = t.row[0][j];
+        GLfloat height = t.row[1][j];
+        GLfloat nrad = t.row[2][j];
+        GLfloat nheight = t.row[3][j];
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
+        {
+            x[i] = rad*ct[i];
+            y[i] = rad*st[i];
+            z[i] = height;
+            nx[i] = nrad*ct[i];
+            ny[i] = nrad*st[i];
+            nz[i] = nheight;
         }
+    }
+}
+
+/**
+\brief Fills the column terms of a trefoil or braided torus, a tube around a knot.
+
+\param t --- Terms filled, sized for the surface.
+\param lon --- Number of longitudinal divisions.
+\param lat --- Number of latitude divisions.
+\param turns --- Turns around the axis, theta runs from 2*PI*turns down to 0.
+\param amp --- Amplitude of the knot.
+\param numtwists --- Number of twists.
+\param rmaj --- Major radius.
+\param yscale --- Scale of the knot's height.
+
+*/
+
+static void knotTerms(SurfaceTerms& t, int lon, int lat, GLfloat turns, GLfloat amp, GLfloat numtwists, GLfloat rmaj, GLfloat yscale)
+{
+    for (int i = 0; i <= lon; i++)
+    {
+        GLfloat theta = 2*turns*PI - 2*turns*PI*((float)i/lon);
+        GLfloat ct = cos(theta);
+        GLfloat st = sin(theta);
+        GLfloat cn = cos(numtwists*theta);
+        GLfloat sn = sin(numtwists*theta);
+        GLfloat R = rmaj*(1+amp*cn);
+
+        t.col[0][i] = ct;
+        t.col[1][i] = st;
+        t.col[2][i] = R*ct;
+        t.col[3][i] = R*st;
+        t.col[4][i] = -R*st-rmaj*ct*(numtwists*amp*sn);
+        t.col[5][i] = R*ct-rmaj*st*(numtwists*amp*sn);
+        t.col[6][i] = yscale*amp*sn;
+        t.col[7][i] = yscale*numtwists*amp*cn;
+    }
+
+    for (int j = 0; j <= lat; j++)
+    {
+        GLfloat psi = 2*PI*((float)j/lat);
+        t.row[0][j] = cos(psi);
+        t.row[1][j] = sin(psi);
+    }
 }
 
 /**
@@ -674,35 +859,71 @@ void Models::createPartialTorusOBJ(GLfloat irad, GLfloat orad, GLint ilon, GLint
 
 void Models::createTrefoilOBJ(GLfloat amp, GLfloat numtwists, GLfloat rmaj, GLfloat rmin, GLfloat elongfact, GLint ilon, GLint ilat)
 {
-    GLfloat cx, cy, cz;
-    GLfloat x1, y1, z1;
-    GLfloat x2, y2, z2;
     resetArraySize(ilon, ilat);
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
-    for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
+    knotTerms(t, lon, lat, 2, amp, numtwists, rmaj, 1);
+    t.k[0] = rmin;
+    t.k[1] = elongfact;
+    runRows(&Models::knotRows, t);
+}
+
+/**
+\brief Row kernel of the trefoil and braided torus.  Columns cos(theta), sin(theta),
+the knot's x and z and their derivatives, its height and the height's derivative, rows
+cos(psi), sin(psi), constants the minor radius and the elongation.
+
+\param t --- Terms of the knot.
+\param j0 --- First row.
+\param j1 --- One past the last row.
+
+*/
+
+void Models::knotRows(const SurfaceTerms& t, int j0, int j1)
+{
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *ct = &t.col[0][0];
+    const GLfloat *st = &t.col[1][0];
+    const GLfloat *kx = &t.col[2][0];
+    const GLfloat *kz = &t.col[3][0];
+    const GLfloat *dkx = &t.col[4][0];
+    const GLfloat *dkz = &t.col[5][0];
+    const GLfloat *ky = &t.col[6][0];
+    const GLfloat *dky = &t.col[7][0];
+    GLfloat rmin = t.k[0];
+    GLfloat elongfact = t.k[1];
+
+    for (int j = j0; j < j1; j++)
+    {
+        GLfloat *x = dat+j*w;
+        GLfloat *y = x+n;
+        GLfloat *z = y+n;
+        GLfloat *nx = normals+j*w;
+        GLfloat *ny = nx+n;
+        GLfloat *nz = ny+n;
+        GLfloat rc = rmin*t.row[0][j];
+        GLfloat rs = rmin*t.row[1][j];
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
         {
-            GLfloat theta = 4*PI-4*PI*((float)i/lon);
-            GLfloat psi = 2*PI*((float)j/lat);
-
-            dat[pos(i,j,0)] = rmin*cos(psi)*cos(theta)+rmaj*cos(theta)*(1+amp*cos(numtwists*theta));
-            dat[pos(i,j,1)] = elongfact*rmin*sin(psi)+amp*sin(numtwists*theta);
-            dat[pos(i,j,2)] = rmin*cos(psi)*sin(theta)+rmaj*sin(theta)*(1+amp*cos(numtwists*theta));
-
-            x2 = -rmin*cos(psi)*sin(theta)-rmaj*sin(theta)*(1+amp*cos(numtwists*theta))-rmaj*cos(theta)*(numtwists*amp*sin(numtwists*theta));
-            y2 = numtwists*amp*cos(numtwists*theta);
-            z2 = rmin*cos(psi)*cos(theta)+rmaj*cos(theta)*(1+amp*cos(numtwists*theta))-rmaj*sin(theta)*(numtwists*amp*sin(numtwists*theta));
-            x1 = -rmin*sin(psi)*cos(theta);
-            y1 = elongfact*rmin*cos(psi);
-            z1 = -rmin*sin(psi)*sin(theta);
-
-            CrossProd(x1, y1, z1, x2, y2, z2, &cx, &cy, &cz);
-
-            GLdouble mod = sqrt(cx*cx + cy*cy + cz*cz);
-            normals[pos(i,j,0)] = cx/mod;
-            normals[pos(i,j,1)] = cy/mod;
-            normals[pos(i,j,2)] = cz/mod;
+            GLfloat cx, cy, cz;
+
+            x[i] = rc*ct[i]+kx[i];
+            y[i] = elongfact*rs+ky[i];
+            z[i] = rc*st[i]+kz[i];
+
+            CrossProd(-rs*ct[i], elongfact*rc, -rs*st[i],
+                      -rc*st[i]+dkx[i], dky[i], rc*ct[i]+dkz[i], &cx, &cy, &cz);
+
+            GLfloat mod = sqrt(cx*cx + cy*cy + cz*cz);
+            nx[i] = cx/mod;
+            ny[i] = cy/mod;
+            nz[i] = cz/mod;
         }
+    }
 }
 
 /**
@@ -716,20 +937,69 @@ void Models::createTrefoilOBJ(GLfloat amp, GLfloat numtwists, GLfloat rmaj, GLfl
 void Models::createUmbilicTorusOBJ(GLint ilon, GLint ilat)
 {
     resetArraySize(ilon, ilat);
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
     for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-        {
-            GLfloat theta = 2*PI - 2*PI*((float)i/lon);
-            GLfloat psi = 2*PI*((float)j/lat);
+    {
+        GLfloat theta = 2*PI - 2*PI*((float)i/lon);
+        t.col[0][i] = sin(theta);
+        t.col[1][i] = cos(theta);
+        t.col[2][i] = cos(theta/3);
+        t.col[3][i] = sin(theta/3);
+    }
 
-            dat[pos(i,j,0)] = sin(theta)*(7+cos(theta/3-2*psi)+2*cos(theta/3+psi));
-            dat[pos(i,j,1)] = cos(theta)*(7+cos(theta/3-2*psi)+2*cos(theta/3+psi));
-            dat[pos(i,j,2)] = sin(theta/3-2*psi)+2*sin(theta/3+psi);
-        }
+    // cos(theta/3-2*psi)+2*cos(theta/3+psi) and the sines, split by the angle sum formulas.
+    for (int j = 0; j <= lat; j++)
+    {
+        GLfloat psi = 2*PI*((float)j/lat);
+        t.row[0][j] = cos(2*psi)+2*cos(psi);
+        t.row[1][j] = sin(2*psi)-2*sin(psi);
+    }
+
+    runRows(&Models::umbilicRows, t);
     createNormals();
 }
 
+/**
+\brief Row kernel of the umbilic torus, the vertices only.  Columns sin(theta),
+cos(theta), cos(theta/3), sin(theta/3), rows cos(2*psi)+2*cos(psi) and
+sin(2*psi)-2*sin(psi).
+
+\param t --- Terms of the umbilic torus.
+\param j0 --- First row.
+\param j1 --- One past the last row.
+
+*/
+
+void Models::umbilicRows(const SurfaceTerms& t, int j0, int j1)
+{
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *st = &t.col[0][0];
+    const GLfloat *ct = &t.col[1][0];
+    const GLfloat *ca = &t.col[2][0];
+    const GLfloat *sa = &t.col[3][0];
+
+    for (int j = j0; j < j1; j++)
+    {
+        GLfloat *x = dat+j*w;
+        GLfloat *y = x+n;
+        GLfloat *z = y+n;
+        GLfloat A = t.row[0][j];
+        GLfloat B = t.row[1][j];
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
+        {
+            GLfloat ring = 7+ca[i]*A+sa[i]*B;
+            x[i] = st[i]*ring;
+            y[i] = ct[i]*ring;
+            z[i] = sa[i]*A-ca[i]*B;
+        }
+    }
+}
+
 /**
 \brief Creates a braided torus.
 
@@ -745,36 +1015,14 @@ void Models::createUmbilicTorusOBJ(GLint ilon, GLint ilat)
 
 void Models::createBraidedTorusOBJ(GLfloat amp, GLfloat numtwists, GLfloat rmaj, GLfloat rmin, GLfloat elongfact, GLint ilon, GLint ilat)
 {
-    GLfloat cx, cy, cz;
-    GLfloat x1, y1, z1;
-    GLfloat x2, y2, z2;
     resetArraySize(ilon, ilat);
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
-    for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-        {
-            GLfloat theta = 8*PI - 8*PI*((float)i/lon);
-            GLfloat psi = 2*PI*((float)j/lat);
-
-            dat[pos(i,j,0)] = rmin*cos(psi)*cos(theta)+rmaj*cos(theta)*(1+amp*cos(numtwists*theta));
-            dat[pos(i,j,1)] = elongfact*(rmin*sin(psi)+amp*sin(numtwists*theta));
-            dat[pos(i,j,2)] = rmin*cos(psi)*sin(theta)+rmaj*sin(theta)*(1+amp*cos(numtwists*theta));
-
-            x1 = -rmin*sin(psi)*cos(theta);
-            y1 = elongfact*rmin*cos(psi);
-            z1 = -rmin*sin(psi)*sin(theta);
-
-            x2 = -rmin*cos(psi)*sin(theta)-rmaj*sin(theta)*(1+amp*cos(numtwists*theta))-rmaj*cos(theta)*(numtwists*amp*sin(numtwists*theta));
-            y2 = elongfact*(numtwists*amp*cos(numtwists*theta));
-            z2 = rmin*cos(psi)*cos(theta)+rmaj*cos(theta)*(1+amp*cos(numtwists*theta))-rmaj*sin(theta)*(numtwists*amp*sin(numtwists*theta));
-
-            CrossProd(x1, y1, z1, x2, y2, z2, &cx, &cy, &cz);
-
-            GLdouble mod = sqrt(cx*cx + cy*cy + cz*cz);
-            normals[pos(i,j,0)] = cx/mod;
-            normals[pos(i,j,1)] = cy/mod;
-            normals[pos(i,j,2)] = cz/mod;
-        }
+    knotTerms(t, lon, lat, 4, amp, numtwists, rmaj, elongfact);
+    t.k[0] = rmin;
+    t.k[1] = elongfact;
+    runRows(&Models::knotRows, t);
 }
 
 /**
@@ -790,37 +1038,26 @@ void Models::createBraidedTorusOBJ(GLfloat amp, GLfloat numtwists, GLfloat rmaj,
 
 void Models::createExpHornOBJ(GLfloat r1, GLfloat r2, GLfloat len, GLint ilon, GLint ilat)
 {
-    GLfloat cx, cy, cz;
-    GLfloat x1, y1, z1;
-    GLfloat x2, y2, z2;
     resetArraySize(ilon, ilat);
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
     for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-        {
-            GLfloat theta = 2*PI - 2*PI*((float)i/lon);
-            GLfloat x = len*((float)j/lat);
-            GLfloat Rad = r1*exp(log(r2/r1)/len*x);
-
-            dat[pos(i,j,0)] = Rad*sin(theta);
-            dat[pos(i,j,1)] = Rad*cos(theta);
-            dat[pos(i,j,2)] = x;
-
-            x1 = log(r2/r1)/len*r1*exp(log(r2/r1)/len*x)*sin(theta);
-            y1 = log(r2/r1)/len*r1*exp(log(r2/r1)/len*x)*cos(theta);
-            z1 = 1;
-
-            x2 = Rad*cos(theta);
-            y2 = -Rad*sin(theta);
-            z2 = 0;
+    {
+        GLfloat theta = 2*PI - 2*PI*((float)i/lon);
+        t.col[0][i] = sin(theta);
+        t.col[1][i] = cos(theta);
+    }
 
-            CrossProd(x1, y1, z1, x2, y2, z2, &cx, &cy, &cz);
+    for (int j = 0; j <= lat; j++)
+    {
+        GLfloat x = len*((float)j/lat);
+        t.row[0][j] = x;
+        t.row[1][j] = r1*exp(log(r2/r1)/len*x);
+        t.row[2][j] = log(r2/r1)/len*r1*exp(log(r2/r1)/len*x);
+    }
 
-            GLdouble mod = sqrt(cx*cx + cy*cy + cz*cz);
-            normals[pos(i,j,0)] = cx/mod;
-            normals[pos(i,j,1)] = cy/mod;
-            normals[pos(i,j,2)] = cz/mod;
-        }
+    runRows(&Models::hornRows, t);
 }
 
 /**
@@ -836,37 +1073,74 @@ void Models::createExpHornOBJ(GLfloat r1, GLfloat r2, GLfloat len, GLint ilon, G
 
 void Models::createQuadHornOBJ(GLfloat r1, GLfloat r2, GLfloat len, GLint ilon, GLint ilat)
 {
-    GLfloat cx, cy, cz;
-    GLfloat x1, y1, z1;
-    GLfloat x2, y2, z2;
     resetArraySize(ilon, ilat);
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
     for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-        {
-            GLfloat theta = 2*PI - 2*PI*((float)i/lon);
-            GLfloat x = len*((float)j/lat);
-            GLfloat Rad = (r2-r1)/(len*len)*(x*x) + r1;
+    {
+        GLfloat theta = 2*PI - 2*PI*((float)i/lon);
+        t.col[0][i] = sin(theta);
+        t.col[1][i] = cos(theta);
+    }
 
-            dat[pos(i,j,0)] = Rad*sin(theta);
-            dat[pos(i,j,1)] = Rad*cos(theta);
-            dat[pos(i,j,2)] = x;
+    for (int j = 0; j <= lat; j++)
+    {
+        GLfloat x = len*((float)j/lat);
+        t.row[0][j] = x;
+        t.row[1][j] = (r2-r1)/(len*len)*(x*x) + r1;
+        t.row[2][j] = 2.0*(r2-r1)/(len*len)*x;
+    }
 
-            x1 = 2.0*(r2-r1)/(len*len)*x*sin(theta);
-            y1 = 2.0*(r2-r1)/(len*len)*x*cos(theta);
-            z1 = 1;
+    runRows(&Models::hornRows, t);
+}
 
-            x2 = Rad*cos(theta);
-            y2 = -Rad*sin(theta);
-            z2 = 0;
+/**
+\brief Row kernel of the horns.  Columns sin(theta), cos(theta), rows the distance
+along the horn, its radius there and the radius' derivative.
+
+\param t --- Terms of the horn.
+\param j0 --- First row.
+\param j1 --- One past the last row.
+
+*/
+
+void Models::hornRows(const SurfaceTerms& t, int j0, int j1)
+{
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *st = &t.col[0][0];
+    const GLfloat *ct = &t.col[1][0];
+
+    for (int j = j0; j < j1; j++)
+    {
+        GLfloat *x = dat+j*w;
+        GLfloat *y = x+n;
+        GLfloat *z = y+n;
+        GLfloat *nx = normals+j*w;
+        GLfloat *ny = nx+n;
+        GLfloat *nz = ny+n;
+        GLfloat along = t.row[0][j];
+        GLfloat Rad = t.row[1][j];
+        GLfloat dRad = t.row[2][j];
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
+        {
+            GLfloat cx, cy, cz;
 
-            CrossProd(x1, y1, z1, x2, y2, z2, &cx, &cy, &cz);
+            x[i] = Rad*st[i];
+            y[i] = Rad*ct[i];
+            z[i] = along;
 
-            GLdouble mod = sqrt(cx*cx + cy*cy + cz*cz);
-            normals[pos(i,j,0)] = cx/mod;
-            normals[pos(i,j,1)] = cy/mod;
-            normals[pos(i,j,2)] = cz/mod;
+            CrossProd(dRad*st[i], dRad*ct[i], 1, Rad*ct[i], -Rad*st[i], 0, &cx, &cy, &cz);
+
+            GLfloat mod = sqrt(cx*cx + cy*cy + cz*cz);
+            nx[i] = cx/mod;
+            ny[i] = cy/mod;
+            nz[i] = cz/mod;
         }
+    }
 }
 
 /**
@@ -884,38 +1158,81 @@ void Models::createQuadHornOBJ(GLfloat r1, GLfloat r2, GLfloat len, GLint ilon,
 
 void Models::createHelicalTorusOBJ(GLfloat irad, GLfloat orad, GLfloat strFact, GLfloat begang, GLfloat endang, GLint ilon, GLint ilat)
 {
-    GLfloat cx, cy, cz;
-    GLfloat x1, y1, z1;
-    GLfloat x2, y2, z2;
     resetArraySize(ilon, ilat);
     GLfloat r = (orad - irad)/2;
     GLfloat rax = r+irad;
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
     for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-        {
-            GLfloat theta = endang - (begang + (endang - begang)*((float)i/lon));
-            GLfloat psi = -PI + 2*PI*((float)j/lat);
+    {
+        GLfloat theta = endang - (begang + (endang - begang)*((float)i/lon));
+        t.col[0][i] = cos(theta);
+        t.col[1][i] = sin(theta);
+        t.col[2][i] = strFact*theta;
+    }
+
+    for (int j = 0; j <= lat; j++)
+    {
+        GLfloat psi = -PI + 2*PI*((float)j/lat);
+        t.row[0][j] = rax-r*cos(psi);
+        t.row[1][j] = r*sin(psi);
+        t.row[2][j] = r*cos(psi);
+    }
 
-            dat[pos(i,j,0)] = (rax-r*cos(psi))*cos(theta);
-            dat[pos(i,j,1)] = (rax-r*cos(psi))*sin(theta);
-            dat[pos(i,j,2)] = strFact*theta + r*sin(psi);
+    t.k[0] = strFact;
+    runRows(&Models::helicalRows, t);
+}
 
-            x1 = r*sin(psi)*cos(theta);
-            y1 = r*sin(psi)*sin(theta);
-            z1 = r*cos(psi);
+/**
+\brief Row kernel of the helical torus.  Columns cos(theta), sin(theta), the rise of
+the helix, rows the distance from the axis, r*sin(psi) and r*cos(psi), constant the
+stretch factor.
 
-            x2 = -sin(theta);
-            y2 = cos(theta);
-            z2 = strFact;
+\param t --- Terms of the helical torus.
+\param j0 --- First row.
+\param j1 --- One past the last row.
 
-            CrossProd(x1, y1, z1, x2, y2, z2, &cx, &cy, &cz);
+*/
 
-            GLdouble mod = sqrt(cx*cx + cy*cy + cz*cz);
-            normals[pos(i,j,0)] = cx/mod;
-            normals[pos(i,j,1)] = cy/mod;
-            normals[pos(i,j,2)] = cz/mod;
+void Models::helicalRows(const SurfaceTerms& t, int j0, int j1)
+{
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *ct = &t.col[0][0];
+    const GLfloat *st = &t.col[1][0];
+    const GLfloat *rise = &t.col[2][0];
+    GLfloat strFact = t.k[0];
+
+    for (int j = j0; j < j1; j++)
+    {
+        GLfloat *x = dat+j*w;
+        GLfloat *y = x+n;
+        GLfloat *z = y+n;
+        GLfloat *nx = normals+j*w;
+        GLfloat *ny = nx+n;
+        GLfloat *nz = ny+n;
+        GLfloat rad = t.row[0][j];
+        GLfloat rs = t.row[1][j];
+        GLfloat rc = t.row[2][j];
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
+        {
+            GLfloat cx, cy, cz;
+
+            x[i] = rad*ct[i];
+            y[i] = rad*st[i];
+            z[i] = rise[i] + rs;
+
+            CrossProd(rs*ct[i], rs*st[i], rc, -st[i], ct[i], strFact, &cx, &cy, &cz);
+
+            GLfloat mod = sqrt(cx*cx + cy*cy + cz*cz);
+            nx[i] = cx/mod;
+            ny[i] = cy/mod;
+            nz[i] = cz/mod;
         }
+    }
 }
 
 /**
@@ -930,36 +1247,84 @@ void Models::createHelicalTorusOBJ(GLfloat irad, GLfloat orad, GLfloat strFact,
 
 void Models::createMobiusOBJ(GLfloat begv, GLfloat endv, GLint ilon, GLint ilat)
 {
-    GLfloat cx, cy, cz;
-    GLfloat x1, y1, z1;
-    GLfloat x2, y2, z2;
     resetArraySize(ilon, ilat);
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
     for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-        {
-            GLfloat theta = 2*PI*((float)i/lon);
-            GLfloat v = begv + (endv-begv)*((float)j/lat);
+    {
+        GLfloat theta = 2*PI*((float)i/lon);
+        GLfloat ct = cos(theta);
+        GLfloat st = sin(theta);
+        GLfloat ch = cos(theta/2);
+        GLfloat sh = sin(theta/2);
+
+        t.col[0][i] = ct;
+        t.col[1][i] = st;
+        t.col[2][i] = ch*ct;
+        t.col[3][i] = ch*st;
+        t.col[4][i] = sh;
+        t.col[5][i] = ch;
+        t.col[6][i] = -ch*st-0.5*sh*ct;
+        t.col[7][i] = ch*ct-0.5*sh*st;
+    }
+
+    for (int j = 0; j <= lat; j++)
+        t.row[0][j] = begv + (endv-begv)*((float)j/lat);
+
+    runRows(&Models::mobiusRows, t);
+}
+
+/**
+\brief Row kernel of the Mobius strip.  Columns cos(theta), sin(theta), the direction
+across the strip, cos(theta/2) and the derivative of the direction, rows v.
 
-            dat[pos(i,j,0)] = cos(theta)+v*cos(theta/2)*cos(theta);
-            dat[pos(i,j,1)] = sin(theta)+v*cos(theta/2)*sin(theta);
-            dat[pos(i,j,2)] = v*sin(theta/2);
+\param t --- Terms of the Mobius strip.
+\param j0 --- First row.
+\param j1 --- One past the last row.
 
-            x2 = cos(theta/2)*cos(theta);
-            y2 = cos(theta/2)*sin(theta);
-            z2 = sin(theta/2);
+*/
 
-            x1 = -sin(theta)+v*(-cos(theta/2)*sin(theta)-0.5*sin(theta/2)*cos(theta));
-            y1 = cos(theta)+v*(cos(theta/2)*cos(theta)-0.5*sin(theta/2)*sin(theta));
-            z1 = 0.5*v*cos(theta/2);
+void Models::mobiusRows(const SurfaceTerms& t, int j0, int j1)
+{
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *ct = &t.col[0][0];
+    const GLfloat *st = &t.col[1][0];
+    const GLfloat *ax = &t.col[2][0];
+    const GLfloat *ay = &t.col[3][0];
+    const GLfloat *az = &t.col[4][0];
+    const GLfloat *ch = &t.col[5][0];
+    const GLfloat *dax = &t.col[6][0];
+    const GLfloat *day = &t.col[7][0];
+
+    for (int j = j0; j < j1; j++)
+    {
+        GLfloat *x = dat+j*w;
+        GLfloat *y = x+n;
+        GLfloat *z = y+n;
+        GLfloat *nx = normals+j*w;
+        GLfloat *ny = nx+n;
+        GLfloat *nz = ny+n;
+        GLfloat v = t.row[0][j];
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
+        {
+            GLfloat cx, cy, cz;
+
+            x[i] = ct[i]+v*ax[i];
+            y[i] = st[i]+v*ay[i];
+            z[i] = v*az[i];
 
-            CrossProd(x1, y1, z1, x2, y2, z2, &cx, &cy, &cz);
+            CrossProd(-st[i]+v*dax[i], ct[i]+v*day[i], 0.5f*v*ch[i], ax[i], ay[i], az[i], &cx, &cy, &cz);
 
-            GLdouble mod = sqrt(cx*cx + cy*cy + cz*cz);
-            normals[pos(i,j,0)] = cx/mod;
-            normals[pos(i,j,1)] = cy/mod;
-            normals[pos(i,j,2)] = cz/mod;
+            GLfloat mod = sqrt(cx*cx + cy*cy + cz*cz);
+            nx[i] = cx/mod;
+            ny[i] = cy/mod;
+            nz[i] = cz/mod;
         }
+    }
 }
 
 /**
@@ -975,18 +1340,53 @@ void Models::createMobiusOBJ(GLfloat begv, GLfloat endv, GLint ilon, GLint ilat)
 void Models::createTessellatedWallOBJ(GLfloat width, GLfloat height, GLint ilon, GLint ilat)
 {
     resetArraySize(ilon, ilat);
+    SurfaceTerms t;
+    resizeTerms(t, lon+1, lat+1);
 
     for (int i = 0; i <= lon; i++)
-        for (int j = 0; j <= lat; j++)
-        {
-            dat[pos(i,j,0)] = -width/2.0+(float)i/(float)lon*width;
-            dat[pos(i,j,1)] = -height/2.0+(float)j/(float)lat*height;
-            dat[pos(i,j,2)] = 0;
+        t.col[0][i] = -width/2.0+(float)i/(float)lon*width;
+    for (int j = 0; j <= lat; j++)
+        t.row[0][j] = -height/2.0+(float)j/(float)lat*height;
+
+    runRows(&Models::wallRows, t);
+}
 
-            normals[pos(i,j,0)] = 0;
-            normals[pos(i,j,1)] = 0;
-            normals[pos(i,j,2)] = 1;
+/**
+\brief Row kernel of the tessellated wall.  Columns x, rows y.
+
+\param t --- Terms of the wall.
+\param j0 --- First row.
+\param j1 --- One past the last row.
+
+*/
+
+void Models::wallRows(const SurfaceTerms& t, int j0, int j1)
+{
+    int w = lon+1;
+    int n = w*(lat+1);
+    const GLfloat *wx = &t.col[0][0];
+
+    for (int j = j0; j < j1; j++)
+    {
+        GLfloat *x = dat+j*w;
+        GLfloat *y = x+n;
+        GLfloat *z = y+n;
+        GLfloat *nx = normals+j*w;
+        GLfloat *ny = nx+n;
+        GLfloat *nz = ny+n;
+        GLfloat wy = t.row[0][j];
+
+#pragma GCC ivdep
+        for (int i = 0; i <= lon; i++)
+        {
+            x[i] = wx[i];
+            y[i] = wy;
+            z[i] = 0;
+            nx[i] = 0;
+            ny[i] = 0;
+            nz[i] = 1;
         }
+    }
 }
 
 /**
@@ -1033,3 +1433,29 @@ void Models::perturbNormalsRandom(float a)
             normals[pos(i,j,2)] /= mod;
         }
 }
+
+/**
+\brief Sets the threads the rows of a surface are split between, 1 to build them all on
+the calling thread, the default.  Only surfaces of MODELS_THREAD_VERTICES or more are
+split, below that starting the threads costs more than it saves.
+
+\param n --- Number of threads, 0 or less for one per hardware thread.
+
+*/
+
+void Models::setThreads(GLint n)
+{
+    if (n <= 0)
+        n = std::thread::hardware_concurrency();
+    threads = n > 0 ? n : 1;
+}
+
+/**
+\brief Returns the threads the rows of a surface are split between.
+
+*/
+
+GLint Models::getThreads()
+{
+    return threads;
+}
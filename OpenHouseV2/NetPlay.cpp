@@ -0,0 +1,657 @@
+#include "NetPlay.h"
+
+#include <stdlib.h>
+#include <time.h>
+#include <iostream>
+
+#include "ProgramDefines.h"
+
+/**
+\file NetPlay.cpp
+\brief Network versus over UDP, exchanging only each tick's input.
+
+Every packet starts with "OH", the protocol version, the packet type and the 2 byte
+match id, little endian like the input log.  An input packet then holds
+
+- the first tick of the sender's remote input it does not have (the acknowledgement),
+- the sender's tick and how many ticks it thinks it is ahead,
+- the sender's clock and the clock of the last packet it heard, with the time it held
+  it, for the round trip time,
+- the first tick of input in the packet and the number of ticks, then for each tick the
+  number of events and each event's type, a and b as single bytes.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Appends a 2 byte value.
+
+*/
+
+static void putU16(unsigned char*& p, unsigned int v)
+{
+    *p++ = v & 0xFF;
+    *p++ = (v >> 8) & 0xFF;
+}
+
+/**
+\brief Appends a 4 byte value.
+
+*/
+
+static void putU32(unsigned char*& p, unsigned int v)
+{
+    putU16(p, v & 0xFFFF);
+    putU16(p, v >> 16);
+}
+
+/**
+\brief Reads a 2 byte value.
+
+*/
+
+static unsigned int getU16(const unsigned char*& p)
+{
+    unsigned int v = p[0] | (p[1] << 8);
+    p += 2;
+    return v;
+}
+
+/**
+\brief Reads a 4 byte value.
+
+*/
+
+static unsigned int getU32(const unsigned char*& p)
+{
+    unsigned int lo = getU16(p);
+    return lo | (getU16(p) << 16);
+}
+
+/**
+\brief Constructor, closed.
+
+\param matchSim --- Simulation to run, reset when a match starts.
+
+*/
+
+NetPlay::NetPlay(MatchSim* matchSim)
+{
+    sim = matchSim;
+    session = NULL;
+    state = NET_CLOSED;
+    localPlayer = 0;
+    peerPort = 0;
+    matchID = 0;
+}
+
+/**
+\brief Destructor, tells the peer this side is leaving.
+
+*/
+
+NetPlay::~NetPlay()
+{
+    close();
+    delete session;
+}
+
+/**
+\brief Returns the time since open in milliseconds.
+
+*/
+
+int NetPlay::now()
+{
+    return clock.getElapsedTime().asMilliseconds();
+}
+
+/**
+\brief Opens the socket and starts hosting or joining.
+
+\param cfg --- Settings.
+
+\return False if the socket could not be bound or the address is not valid.
+
+*/
+
+bool NetPlay::open(const NetConfig& cfg)
+{
+    close();
+    config = cfg;
+
+    socket.setBlocking(false);
+    if (socket.bind(config.host ? config.port : sf::Socket::AnyPort) != sf::Socket::Done)
+    {
+        std::cerr << "Could not open UDP port " << config.port << "." << std::endl;
+        return false;
+    }
+
+    if (config.host)
+    {
+        peerAddress = sf::IpAddress::None;
+        peerPort = 0;
+        matchID = (unsigned short)((time(NULL) ^ rand()) & 0xFFFF);
+        std::cout << "Hosting on port " << config.port << ", waiting for a player." << std::endl;
+    }
+    else
+    {
+        peerAddress = sf::IpAddress(config.address);
+        peerPort = config.port;
+        matchID = 0;
+        if (peerAddress == sf::IpAddress::None)
+        {
+            std::cerr << "Could not resolve " << config.address << "." << std::endl;
+            socket.unbind();
+            return false;
+        }
+        std::cout << "Joining " << config.address << ":" << config.port << "." << std::endl;
+    }
+
+    clock.restart();
+    lastHello = -NET_HELLO_MS;
+    lastHeard = 0;
+    ping = 0;
+    echoTime = 0;
+    echoHeardAt = -1;
+    packetsSent = 0;
+    packetsReceived = 0;
+    bytesSent = 0;
+    waits = 0;
+    state = NET_CONNECTING;
+    return true;
+}
+
+/**
+\brief Ends the match, telling the peer, and closes the socket.
+
+*/
+
+void NetPlay::close()
+{
+    if (state == NET_CLOSED)
+        return;
+
+    if (peerPort != 0)
+    {
+        unsigned char data[8];
+        writeHeader(data, NET_BYE);
+        sendPacket(data, 6);
+    }
+
+    socket.unbind();
+    state = NET_CLOSED;
+}
+
+/**
+\brief Starts the match on both sides from the main menu on tick 0.
+
+\param mode --- The host's mode.
+\param delay --- The host's input delay.
+\param player --- Player this side controls.
+
+*/
+
+void NetPlay::begin(int mode, int delay, int player)
+{
+    config.mode = mode;
+    config.inputDelay = delay;
+    localPlayer = player;
+
+    delete session;
+    session = new RollbackSession(sim, player);
+    session->setInputDelay(delay);
+    session->setMaxPrediction(mode == NET_DELAY ? 0 : ROLLBACK_WINDOW);
+
+    sim->reset();
+    session->start();
+
+    localEnd = session->getTick() + session->getInputDelay();
+    peerAck = localEnd;
+    peerTick = 0;
+    peerAdvantage = 0;
+    lastWait = 0;
+    lastHeard = now();
+    state = NET_PLAYING;
+
+    std::cout << "Playing as player " << player + 1 << ", " << (mode == NET_DELAY ? "delay" : "rollback")
+              << " mode, " << session->getInputDelay() << " ticks input delay." << std::endl;
+}
+
+/**
+\brief Writes the header of a packet.
+
+\param data --- Packet, at least 6 bytes.
+\param type --- One of NetPacketType.
+
+*/
+
+void NetPlay::writeHeader(unsigned char* data, int type)
+{
+    data[0] = 'O';
+    data[1] = 'H';
+    data[2] = NET_PROTOCOL_VERSION;
+    data[3] = type;
+    data[4] = matchID & 0xFF;
+    data[5] = matchID >> 8;
+}
+
+/**
+\brief Sends a packet to the peer.
+
+*/
+
+void NetPlay::sendPacket(const unsigned char* data, size_t size)
+{
+    if (socket.send(data, size, peerAddress, peerPort) == sf::Socket::Done)
+    {
+        packetsSent++;
+        bytesSent += size;
+    }
+}
+
+/**
+\brief Sends the local input the peer does not have yet, with the acknowledgement and
+timing.
+
+*/
+
+void NetPlay::sendInput()
+{
+    unsigned char data[NET_MAX_PACKET];
+    writeHeader(data, NET_INPUT);
+    unsigned char* p = data + 6;
+
+    int t = now();
+    putU32(p, (unsigned int)session->getConfirmedTick());
+    putU32(p, (unsigned int)session->getTick());
+    *p++ = (unsigned char)(signed char)advantage();
+    putU32(p, (unsigned int)t);
+    putU32(p, echoTime);
+    putU16(p, echoHeardAt < 0 ? 0xFFFF : (t - echoHeardAt > 0xFFFE ? 0xFFFE : t - echoHeardAt));
+
+    // The oldest ticks the peer lacks go first, it cannot take the later ones without
+    // them, and the window moves on as it acknowledges.
+    long long first = peerAck;
+    long long last = localEnd;
+    if (last - first > NET_MAX_RESEND)
+        last = first + NET_MAX_RESEND;
+    putU32(p, (unsigned int)first);
+    *p++ = (unsigned char)(last - first);
+
+    for (long long tick = first; tick < last; tick++)
+    {
+        const TickInput& in = history[tick & (NET_HISTORY - 1)];
+        *p++ = (unsigned char)in.count;
+        for (int i = 0; i < in.count; i++)
+        {
+            *p++ = (unsigned char)in.events[i].type;
+            *p++ = (unsigned char)(signed char)in.events[i].a;
+            *p++ = (unsigned char)(signed char)in.events[i].b;
+        }
+    }
+
+    sendPacket(data, p - data);
+}
+
+/**
+\brief Reads every packet waiting on the socket.
+
+*/
+
+void NetPlay::receive()
+{
+    unsigned char data[NET_MAX_PACKET];
+    size_t size;
+    sf::IpAddress from;
+    unsigned short fromPort;
+
+    while (state != NET_CLOSED && socket.receive(data, sizeof(data), size, from, fromPort) == sf::Socket::Done)
+        handlePacket(data, size, from, fromPort);
+}
+
+/**
+\brief Handles one packet, anything malformed or from another match is ignored.
+
+\param data --- The packet.
+\param size --- Its size in bytes.
+\param from --- Sender's address.
+\param fromPort --- Sender's port.
+
+*/
+
+void NetPlay::handlePacket(const unsigned char* data, size_t size, const sf::IpAddress& from, unsigned short fromPort)
+{
+    if (size < 6 || data[0] != 'O' || data[1] != 'H' || data[2] != NET_PROTOCOL_VERSION)
+        return;
+
+    int type = data[3];
+    unsigned short id = data[4] | (data[5] << 8);
+
+    // The host takes the first player to ask and answers every ask from them, in case
+    // the welcome was lost.
+    if (type == NET_HELLO)
+    {
+        if (!config.host || (state == NET_PLAYING && (from != peerAddress || fromPort != peerPort)))
+            return;
+
+        peerAddress = from;
+        peerPort = fromPort;
+        if (state == NET_CONNECTING)
+        {
+            std::cout << "Player joined from " << from.toString() << ":" << fromPort << "." << std::endl;
+            begin(config.mode, config.inputDelay, 0);
+        }
+
+        unsigned char reply[8];
+        writeHeader(reply, NET_WELCOME);
+        reply[6] = config.mode;
+        reply[7] = session->getInputDelay();
+        sendPacket(reply, 8);
+        return;
+    }
+
+    if (type == NET_WELCOME)
+    {
+        if (config.host || state != NET_CONNECTING || size < 8)
+            return;
+
+        matchID = id;
+        begin(data[6] == NET_DELAY ? NET_DELAY : NET_ROLLBACK, data[7], 1);
+        return;
+    }
+
+    if (state != NET_PLAYING || id != matchID || from != peerAddress || fromPort != peerPort)
+        return;
+
+    packetsReceived++;
+    lastHeard = now();
+
+    if (type == NET_BYE)
+    {
+        std::cout << "The other player left." << std::endl;
+        close();
+        return;
+    }
+
+    if (type != NET_INPUT || size < 30)
+        return;
+
+    const unsigned char* p = data + 6;
+    const unsigned char* end = data + size;
+
+    long long ack = getU32(p);
+    long long tick = getU32(p);
+    int adv = (signed char)*p++;
+    unsigned int sentAt = getU32(p);
+    unsigned int echo = getU32(p);
+    unsigned int held = getU16(p);
+    long long first = getU32(p);
+    int count = *p++;
+
+    if (ack > peerAck && ack <= localEnd)
+        peerAck = ack;
+    if (tick >= peerTick)
+    {
+        peerTick = tick;
+        peerAdvantage = adv;
+    }
+
+    echoTime = sentAt;
+    echoHeardAt = lastHeard;
+    if (held != 0xFFFF)
+    {
+        float rtt = (float)(lastHeard - (int)echo - (int)held);
+        if (rtt >= 0)
+            ping = ping == 0 ? rtt : ping * 0.9f + rtt * 0.1f;
+    }
+
+    for (int i = 0; i < count; i++)
+    {
+        if (p >= end)
+            return;
+
+        TickInput in;
+        in.count = *p++;
+        if (in.count > ROLLBACK_MAX_EVENTS || p + 3 * in.count > end)
+            return;
+
+        for (int e = 0; e < in.count; e++)
+        {
+            in.events[e].type = p[0];
+            in.events[e].player = 1 - localPlayer;
+            in.events[e].a = (signed char)p[1];
+            in.events[e].b = (signed char)p[2];
+            p += 3;
+        }
+
+        if (!session->addRemoteInput(first + i, in))
+            return;
+    }
+}
+
+/**
+\brief Returns how many ticks this side thinks it is ahead of the peer, allowing for the
+peer's tick being half a round trip old, clamped to fit in a byte.
+
+*/
+
+int NetPlay::advantage()
+{
+    double behind = ping * 0.5 * SimTickRate / 1000.0;
+    long long adv = session->getTick() - (peerTick + (long long)(behind + 0.5));
+    if (adv > 127)
+        adv = 127;
+    if (adv < -127)
+        adv = -127;
+    return (int)adv;
+}
+
+/**
+\brief Runs one fixed timestep tick of the network match.
+
+Reads the socket, then unless the match is not running, the peer's input is too far
+behind or this side is waiting for the peer to catch up, runs the next tick with the
+local input given since the last call, and sends.
+
+\return True if a tick was run.
+
+*/
+
+bool NetPlay::step()
+{
+    receive();
+
+    if (state == NET_CONNECTING && !config.host && now() - lastHello >= NET_HELLO_MS)
+    {
+        unsigned char data[8];
+        writeHeader(data, NET_HELLO);
+        sendPacket(data, 6);
+        lastHello = now();
+    }
+
+    if (state != NET_PLAYING)
+        return false;
+
+    if (now() - lastHeard > NET_TIMEOUT_MS)
+    {
+        std::cout << "Lost the connection to the other player." << std::endl;
+        close();
+        return false;
+    }
+
+    bool ran = false;
+    long long tick = session->getTick();
+    if (config.mode == NET_ROLLBACK && (advantage() - peerAdvantage) / 2 >= 1 && tick - lastWait >= NET_SYNC_INTERVAL)
+    {
+        lastWait = tick;
+        waits++;
+    }
+    else if (localEnd - peerAck < NET_HISTORY)
+    {
+        TickInput sent;
+        if (session->advance(tick, sent))
+        {
+            history[tick & (NET_HISTORY - 1)] = sent;
+            localEnd = tick + 1;
+            ran = true;
+        }
+    }
+
+    sendInput();
+    return ran;
+}
+
+/**
+\brief Reads and sends without running a tick, to finish a match.
+
+*/
+
+void NetPlay::poll()
+{
+    receive();
+    if (state == NET_PLAYING)
+        sendInput();
+}
+
+/**
+\brief Returns true if the peer has every local input and every remote input up to the
+current tick is in, so both sides are in the same state.
+
+*/
+
+bool NetPlay::isSettled()
+{
+    return state == NET_PLAYING && peerAck >= localEnd && session->getConfirmedTick() >= session->getTick();
+}
+
+/**
+\brief Adds a local input for the next tick, ignored unless a match is running.
+
+*/
+
+void NetPlay::addLocalInput(const SimInput& in)
+{
+    if (state == NET_PLAYING)
+        session->addLocalInput(in);
+}
+
+/**
+\brief Returns true from open until the match ends.
+
+*/
+
+bool NetPlay::isOpen()
+{
+    return state != NET_CLOSED;
+}
+
+/**
+\brief Returns true while a match is running.
+
+*/
+
+bool NetPlay::isPlaying()
+{
+    return state == NET_PLAYING;
+}
+
+/**
+\brief Returns the player this side controls.
+
+*/
+
+int NetPlay::getLocalPlayer()
+{
+    return localPlayer;
+}
+
+/**
+\brief Returns the mode being played, the host's.
+
+*/
+
+int NetPlay::getMode()
+{
+    return config.mode;
+}
+
+/**
+\brief Returns the rollback session, NULL before the match starts.
+
+*/
+
+RollbackSession* NetPlay::getSession()
+{
+    return session;
+}
+
+/**
+\brief Returns the deepest rollback and the time spent simulating again since the last
+call.
+
+\param depth --- Set to the deepest rollback in ticks.
+\param seconds --- Set to the time spent in rollbacks.
+
+*/
+
+void NetPlay::takeFrameStats(int& depth, double& seconds)
+{
+    depth = 0;
+    seconds = 0;
+    if (session)
+        session->takeFrameStats(depth, seconds);
+}
+
+/**
+\brief Returns the smoothed round trip time to the peer in milliseconds.
+
+*/
+
+float NetPlay::getPing()
+{
+    return ping;
+}
+
+/**
+\brief Returns the number of packets sent.
+
+*/
+
+long long NetPlay::getPacketsSent()
+{
+    return packetsSent;
+}
+
+/**
+\brief Returns the number of packets taken from the peer.
+
+*/
+
+long long NetPlay::getPacketsReceived()
+{
+    return packetsReceived;
+}
+
+/**
+\brief Returns the number of bytes sent.
+
+*/
+
+long long NetPlay::getBytesSent()
+{
+    return bytesSent;
+}
+
+/**
+\brief Returns the number of ticks waited for the peer to catch up.
+
+*/
+
+long long NetPlay::getWaits()
+{
+    return waits;
+}
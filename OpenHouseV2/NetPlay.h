@@ -0,0 +1,173 @@
+#ifndef NETPLAY_H_INCLUDED
+#define NETPLAY_H_INCLUDED
+
+#include <SFML/System.hpp>
+#include <SFML/Network.hpp>
+
+#include <string>
+
+#include "MatchSim.h"
+#include "Rollback.h"
+
+/**
+\file NetPlay.h
+
+\brief Header file for NetPlay.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define NET_PORT 45000              ///< Default port the host listens on.
+#define NET_PROTOCOL_VERSION 1      ///< Version byte of every packet, peers must match.
+#define NET_MAX_PACKET 1024         ///< Largest packet sent or read.
+#define NET_MAX_RESEND 32           ///< Most ticks of local input put in one packet.
+#define NET_HISTORY 128             ///< Ticks of local input kept until the peer has them, a power of 2.
+#define NET_HELLO_MS 250            ///< Time between join requests while connecting.
+#define NET_TIMEOUT_MS 5000         ///< Silence from the peer that ends a match.
+#define NET_SYNC_INTERVAL 15        ///< Fewest ticks between two waits to let the peer catch up.
+
+/**
+\brief How a network match hides the time input takes to reach the other side.
+
+*/
+
+enum NetMode
+{
+    NET_DELAY,       ///< Lockstep, every tick waits for both inputs, which are delayed to give them time.
+    NET_ROLLBACK     ///< Predict the remote input and roll back when it turns out different.
+};
+
+/**
+\brief Where a NetPlay is in a match.
+
+*/
+
+enum NetState
+{
+    NET_CLOSED,        ///< No socket, or the match has ended.
+    NET_CONNECTING,    ///< Waiting for the other player.
+    NET_PLAYING        ///< Match running.
+};
+
+/**
+\brief Packet types, the fourth byte of every packet.
+
+*/
+
+enum NetPacketType
+{
+    NET_HELLO = 1,   ///< Join request from the client.
+    NET_WELCOME,     ///< Host's reply, the mode and delay to play with.
+    NET_INPUT,       ///< Recent local input, acknowledgement and timing.
+    NET_BYE          ///< The sender is leaving.
+};
+
+/**
+\brief Settings for a network match.  The host's mode and delay are used by both sides.
+
+*/
+
+struct NetConfig
+{
+    bool host;              ///< True to wait for a player to join, false to join one.
+    std::string address;    ///< Host, or relay in front of it, to join.
+    unsigned short port;    ///< Port the host listens on, or the port to join.
+    int mode;               ///< One of NetMode.
+    int inputDelay;         ///< Ticks local input is held back, at least 1 for NET_DELAY.
+};
+
+/**
+\class NetPlay
+
+\brief Two player versus over UDP, each side running its own MatchSim and sending only
+its input for each tick.
+
+The host is player one and the player that joins is player two.  Once joined both
+sides reset to the main menu on tick 0 and from there every local input, menu
+selections included, goes through a RollbackSession.  In NET_DELAY mode the session
+never predicts, so a tick only runs once both inputs for it are in.  In NET_ROLLBACK
+mode the session runs ahead on predicted input and rolls back when the real input
+arrives.
+
+Every packet carries all the local input the peer has not acknowledged, the oldest
+NET_MAX_RESEND ticks of it, so a lost packet costs nothing but the wait for the next one.
+Packets also carry the sender's tick and how far it thinks it is ahead, and in
+rollback mode the side that is ahead waits a tick now and then so neither side does
+all the rolling back.
+
+step is called once per fixed timestep tick and never blocks.
+
+*/
+
+class NetPlay
+{
+private:
+    MatchSim* sim;                     ///< Simulation being run, not owned.
+    RollbackSession* session;          ///< Rollback over sim, made when the match starts.
+    NetConfig config;                  ///< Settings, the mode and delay come from the host.
+    int state;                         ///< One of NetState.
+    int localPlayer;                   ///< 0 on the host, 1 on the client.
+
+    sf::UdpSocket socket;              ///< Non blocking socket.
+    sf::IpAddress peerAddress;         ///< Where packets go.
+    unsigned short peerPort;           ///< Port packets go to.
+    unsigned short matchID;            ///< Picked by the host, packets of other matches are ignored.
+    sf::Clock clock;                   ///< Time since open.
+    int lastHello;                     ///< Time the last join request was sent, ms.
+    int lastHeard;                     ///< Time the last packet came in, ms.
+
+    TickInput history[NET_HISTORY];    ///< Local input by tick, until the peer has it.
+    long long localEnd;                ///< One past the last tick with local input.
+    long long peerAck;                 ///< The peer has every local input before this tick.
+    long long peerTick;                ///< Latest tick the peer said it was on.
+    int peerAdvantage;                 ///< Ticks the peer thinks it is ahead of this side.
+    long long lastWait;                ///< Tick of the last wait for the peer.
+
+    unsigned int echoTime;             ///< Send time of the last packet heard, sent back for the round trip time.
+    int echoHeardAt;                   ///< Time it was heard, ms, -1 for nothing to send back.
+    float ping;                        ///< Smoothed round trip time, ms.
+
+    long long packetsSent;             ///< Packets sent.
+    long long packetsReceived;         ///< Packets taken.
+    long long bytesSent;               ///< Bytes sent.
+    long long waits;                   ///< Ticks waited for the peer to catch up.
+
+    int now();
+    void begin(int mode, int delay, int player);
+    void receive();
+    void handlePacket(const unsigned char* data, size_t size, const sf::IpAddress& from, unsigned short fromPort);
+    void writeHeader(unsigned char* data, int type);
+    void sendPacket(const unsigned char* data, size_t size);
+    void sendInput();
+    int advantage();
+
+public:
+    NetPlay(MatchSim* matchSim);
+    ~NetPlay();
+
+    bool open(const NetConfig& cfg);
+    void close();
+
+    bool isOpen();
+    bool isPlaying();
+    int getLocalPlayer();
+    int getMode();
+
+    void addLocalInput(const SimInput& in);
+    bool step();
+    void poll();
+    bool isSettled();
+
+    RollbackSession* getSession();
+    void takeFrameStats(int& depth, double& seconds);
+    float getPing();
+    long long getPacketsSent();
+    long long getPacketsReceived();
+    long long getBytesSent();
+    long long getWaits();
+};
+
+#endif // NETPLAY_H_INCLUDED
@@ -23,61 +23,52 @@
 
 \param [uniform] GlobalAmbient --- vec4 global ambient color vector.
 
-*/
+Defines: SKINNED --- use the material and texture of the animated fighters, gMaterial and
+gSampler, when they are set.  TEX_A, TEX_D, TEX_S --- blend the ambient, diffuse or
+specular color with the texture texA, texD or texS.
 
-struct Light
-{
-    bool on;             ///< Light on or off.
-    vec4 position;       ///< Position of the light.
-    vec3 spotDirection;  ///< Direction of the spot light.
-    vec4 ambient;        ///< Ambient color of the light.
-    vec4 diffuse;        ///< Diffuse color of the light.
-    vec4 specular;       ///< Specular color of the light.
-    float spotCutoff;    ///< Spot cutoff angle.
-    float spotExponent;  ///< Spot falloff exponent.
-    vec3 attenuation;    ///< Attenuation vector, x = constant, y = linear, z = quadratic.
-};
+*/
 
-struct Material
-{
-    vec4 ambient;     ///< Ambient color of the material.
-    vec4 diffuse;     ///< Diffuse color of the material.
-    vec4 specular;    ///< Specular color of the material.
-    vec4 emission;    ///< Emission color of the material.
-    float shininess;  ///< Shininess exponent of the material.
-};
+#include "PhongLights.glsl"
 
+#ifdef SKINNED
 struct material
 {
         vec3 AmbientColor;
         vec3 DiffuseColor;
         vec3 SpecularColor;
 };
+#endif
 
 in vec4 position;
 in vec4 color;
 in vec3 normal;
 in vec2 tex_coord;
+#ifdef SKINNED
 //Bone Stuffs
 flat in ivec4 BoneIDs0;
 in vec4 Weights0;
+#endif
 
-uniform Light Lt[10];
 uniform Material Mat;
 uniform vec3 eye;
 uniform vec4 GlobalAmbient;
-uniform int numLights;
+#ifdef SKINNED
 //Material for animated object
 uniform material gMaterial;
 uniform sampler2D gSampler;
+#endif
 
 
+#ifdef TEX_A
 uniform sampler2D texA;
+#endif
+#ifdef TEX_D
 uniform sampler2D texD;
+#endif
+#ifdef TEX_S
 uniform sampler2D texS;
-uniform bool useTexA;
-uniform bool useTexD;
-uniform bool useTexS;
+#endif
 
 uniform float texRatio;
 
@@ -85,16 +76,17 @@ out vec4 fColor;
 
 void main()
 {
-    float deg = 0.017453292519943296;
-
     vec4 cc = vec4(0.0);
     bool usingLights = false;
     vec4 globalAmbientPortion = vec4(0.0);
+#ifdef SKINNED
     if(gMaterial.AmbientColor != vec3(0.0)){
         vec4 gAmb = vec4(gMaterial.AmbientColor, 1);
         globalAmbientPortion = gAmb*GlobalAmbient;
     }
-    else {
+    else
+#endif
+    {
         //vec4 globalAmbientPortion = Mat.ambient*GlobalAmbient;//Original line
         globalAmbientPortion = Mat.ambient*GlobalAmbient;
     }
@@ -102,71 +94,79 @@ void main()
     vec4 DiffuseSum = vec4(0.0);
     vec4 SpecularSum = vec4(0.0);
 
-    for (int i = 0; i < numLights; i++)
+#if LIGHTS > 0
+    for (int i = 0; i < LIGHTS; i++)
     {
         if (Lt[i].on)
         {
             usingLights = true;
             vec3 n = normalize(normal);
-            vec3 l = normalize(vec3(Lt[i].position)-vec3(position));
+            vec3 l;
+            float reach = lightReach(Lt[i], LtType[i], vec3(position), l);
+#ifdef SHADOWS
+            if (LtType[i] != LIGHT_POINT)
+                reach *= ltShadow(i, vec3(position), n);
+#endif
             vec3 r = normalize(2.0*dot(l,n)*n - l);
             vec3 v = normalize(eye-vec3(position));
-            float lightDistance =length(vec3(Lt[i].position)-vec3(position));
 
             float dfang = max(0.0, dot(l, n));
             float specang = max(0.0, dot(r, v));
             if (dfang == 0)
                 specang = 0;
 
-            float attenuation = 1.0 / (Lt[i].attenuation[0] +
-                                       Lt[i].attenuation[1] * lightDistance +
-                                       Lt[i].attenuation[2] * lightDistance * lightDistance);
-
-            float spotCos = dot(l, -normalize(Lt[i].spotDirection));
-            float SpotCosCutoff = cos(Lt[i].spotCutoff*deg);  // assumes that spotCutoff is in degrees
-
-            float spotFactor = 1.0;
-            if (spotCos < SpotCosCutoff && Lt[i].spotCutoff < 179.9)  // Only fade if a spotlight
-            {
-                float range = 1 + SpotCosCutoff;
-                spotFactor = pow(1 - (SpotCosCutoff - spotCos)/range, Lt[i].spotExponent);
-            }
-
             vec4 ambientPortion;
             vec4 diffusePortion;
             vec4 specularPortion;
 
+#ifdef SKINNED
             if(gMaterial.DiffuseColor != vec3(0.0) || gMaterial.AmbientColor != vec3(0.0) || gMaterial.SpecularColor != vec3(0.0)){
                 ambientPortion = vec4(gMaterial.AmbientColor, 1)*Lt[i].ambient;
-                diffusePortion = vec4(gMaterial.DiffuseColor, 1)*Lt[i].diffuse*dfang*attenuation*spotFactor;
-                specularPortion = vec4(gMaterial.SpecularColor, 1)*Lt[i].specular*pow(specang, 0.5f)*attenuation*spotFactor;
+                diffusePortion = vec4(gMaterial.DiffuseColor, 1)*Lt[i].diffuse*dfang*reach;
+                specularPortion = vec4(gMaterial.SpecularColor, 1)*Lt[i].specular*pow(specang, 0.5f)*reach;
             }
-            else{
+            else
+#endif
+            {
                 ambientPortion = Mat.ambient*Lt[i].ambient;
-                diffusePortion = Mat.diffuse*Lt[i].diffuse*dfang*attenuation*spotFactor;
-                specularPortion = Mat.specular*Lt[i].specular*pow(specang, Mat.shininess)*attenuation*spotFactor;
+                diffusePortion = Mat.diffuse*Lt[i].diffuse*dfang*reach;
+                specularPortion = Mat.specular*Lt[i].specular*pow(specang, Mat.shininess)*reach;
             }
             /*
             vec4 ambientPortion = Mat.ambient*Lt[i].ambient;
             vec4 diffusePortion = Mat.diffuse*Lt[i].diffuse*dfang*attenuation*spotFactor;
-            vec4 specularPortion = Mat.specular*Lt[i].specular*pow(specang, Mat.shininess)*attenuation*spotFactor;
+            vec4 specularPortion = Mat.specular*Lt[i].specular*pow(specang, Mat.shininess)*attenuation*spotFactor;
             */
             AmbientSum += ambientPortion;
             DiffuseSum += diffusePortion;
             SpecularSum += specularPortion;
         }
     }
+#endif
+
+#ifdef CLUSTERED
+    // The clustered lights add to the scene's lights, they do not light an unlit scene.
+    vec3 clusterDiffuse;
+    vec3 clusterSpecular;
+    clusterLighting(vec3(position), normalize(normal), normalize(eye-vec3(position)), Mat.shininess,
+                    clusterDiffuse, clusterSpecular);
+    DiffuseSum += Mat.diffuse*vec4(clusterDiffuse, 0);
+    SpecularSum += Mat.specular*vec4(clusterSpecular, 0);
+#endif
 
     mat2 textrans = mat2(1, 0, 0, -1);  // images are y reversed to the texture coordinate.s
 
-    if (useTexA)
-        AmbientSum = (1-texRatio)*AmbientSum+texRatio*texture(texA, textrans*tex_coord);
+#ifdef TEX_A
+    AmbientSum = (1-texRatio)*AmbientSum+texRatio*texture(texA, textrans*tex_coord);
+#endif
 
-    if (useTexD)
-        DiffuseSum = (1-texRatio)*DiffuseSum+texRatio*texture(texD, textrans*tex_coord);
+#ifdef TEX_D
+    DiffuseSum = (1-texRatio)*DiffuseSum+texRatio*texture(texD, textrans*tex_coord);
+#endif
 
-    if (useTexS)
-        SpecularSum = (1-texRatio)*SpecularSum+texRatio*texture(texS, textrans*tex_coord);
+#ifdef TEX_S
+    SpecularSum = (1-texRatio)*SpecularSum+texRatio*texture(texS, textrans*tex_coord);
+#endif
 
     vec4 c = AmbientSum + DiffuseSum + SpecularSum;
     cc = min(c + globalAmbientPortion + Mat.emission, vec4(1.0));
@@ -175,12 +175,14 @@ void main()
         fColor = cc;
     else
         fColor = color;
+#ifdef SKINNED
     if(gMaterial.DiffuseColor != vec3(0.0) || gMaterial.AmbientColor != vec3(0.0) || gMaterial.SpecularColor != vec3(0.0))
     {
             fColor = texture2D(gSampler, tex_coord.xy);// * min(fColor, vec4(1.0));
             //fColor = min(fColor, vec4(1.0));
     }
     else
+#endif
     {
         fColor = min(fColor, vec4(1.0));
     }
@@ -20,6 +20,7 @@ Default constructor.
 ObjModel::ObjModel()
 {
     numLights = 0;
+    lightsChanged = false;
     GlobalAmbient = glm::vec4(0);
 
     VBOs.clear();
@@ -575,11 +576,26 @@ bool ObjModel::Load(std::string path, std::string filename)
 
     fclose(file);
 
+    bounds.reset();
+    for (unsigned int i = 0; i < file_vertices.size(); i++)
+        bounds.add(file_vertices[i]);
+    bounds.finish();
+
     LoadPrograms();
 
     return true;
 }
 
+/**
+\brief Returns the object space bounding volume of the model, computed when it was loaded.
+
+*/
+
+const BoundingVolume& ObjModel::getBounds()
+{
+    return bounds;
+}
+
 
 /**
 \brief Loads the GLSL programs to the graphics card.  There is one
@@ -588,63 +604,132 @@ the draw method, the material is stored for each segment of the
 model, matched to the correct shader program and the porgram
 is used.
 
+Each program is the permutation for the textures its material has, TEX_A, TEX_D and
+TEX_S, so no program tests for textures it does not use, and for the model's lights,
+see selectLightPrograms.  Materials with the same textures share one compile through
+the shader cache.  The programs are built in one shader cache batch, so the different
+permutations compile at once, and are set up after all of them are checked.  Giving
+the model its lights before it is loaded saves draw building the programs again.
+
 */
 
 bool ObjModel::LoadPrograms()
 {
+    lightDefines = Light::shaderDefines(lt, numLights) + " " + LightClusters::shaderDefines() + " " +
+                   ShadowMaps::shaderDefines();
+    lightsChanged = false;
+
+    size_t first = programs.size();
+    bool built = true;
+    ShaderCache::beginBatch();
     for (unsigned int i = 0; i < mats.size(); i++)
     {
-        GLuint program = LoadShadersFromFile("ObjVertexShader.glsl", "ObjFragmentShader.glsl");
+        std::string defines;
+        if (findTexture(mats[i].ATextureFile) >= 0)
+            defines += " TEX_A";
+        if (findTexture(mats[i].DTextureFile) >= 0)
+            defines += " TEX_D";
+        if (findTexture(mats[i].STextureFile) >= 0)
+            defines += " TEX_S";
+
+        GLuint program = ShaderLibrary::load("ObjVertexShader.glsl", "ObjFragmentShader.glsl", defines + " " + lightDefines);
+        built = built && program;
+        programs.push_back(program);
+        programDefines.push_back(defines);
+    }
 
-        if (!program)
-        {
-            std::cerr << "Could not load Wavefront Object Shader programs." << std::endl;
-            exit(EXIT_FAILURE);
-        }
+    if (!ShaderCache::endBatch() || !built)
+    {
+        std::cerr << "Could not load Wavefront Object Shader programs." << std::endl;
+        exit(EXIT_FAILURE);
+    }
 
-        programs.push_back(program);
+    for (unsigned int i = 0; i < mats.size(); i++)
+    {
+        objMaterial objmat = mats[i];
+        int texA = findTexture(objmat.ATextureFile);
+        int texD = findTexture(objmat.DTextureFile);
+        int texS = findTexture(objmat.STextureFile);
+        GLuint program = programs[first + i];
+
+        LightClusters::bindProgram(program);
+        ShadowMaps::bindProgram(program);
 
         // Turn on the shader & get location of transformation matrix.
         glUseProgram(program);
 
-        GLuint Atexloc = glGetUniformLocation(program, "useTexA");
-        GLuint Dtexloc = glGetUniformLocation(program, "useTexD");
-        GLuint Stexloc = glGetUniformLocation(program, "useTexS");
-
-        objMaterial objmat = mats[i];
         loadMaterial(program, objmat.mat);
+        LoadLights(program, lt, "Lt", numLights);
 
-        glUniform1i(Atexloc, false);
-        if (!objmat.ATextureFile.empty())
-            for (unsigned int k = 0; k < textures.size(); k++)
-                if (textures[k].Filename.compare(objmat.ATextureFile) == 0)
-                {
-                    loadTexture(program, textures[k].Texture, "texA");
-                    glUniform1i(Atexloc, true);
-                }
+        if (texA >= 0)
+            loadTexture(program, textures[texA].Texture, "texA");
 
-        glUniform1i(Dtexloc, false);
-        if (!objmat.DTextureFile.empty())
-            for (unsigned int k = 0; k < textures.size(); k++)
-                if (textures[k].Filename.compare(objmat.DTextureFile) == 0)
-                {
-                    loadTexture(program, textures[k].Texture, "texD");
-                    glUniform1i(Dtexloc, true);
-                }
+        if (texD >= 0)
+            loadTexture(program, textures[texD].Texture, "texD");
 
-        glUniform1i(Stexloc, false);
-        if (!objmat.STextureFile.empty())
-            for (unsigned int k = 0; k < textures.size(); k++)
-                if (textures[k].Filename.compare(objmat.STextureFile) == 0)
-                {
-                    loadTexture(program, textures[k].Texture, "texS");
-                    glUniform1i(Stexloc, true);
-                }
+        if (texS >= 0)
+            loadTexture(program, textures[texS].Texture, "texS");
     }
 
     return true;
 }
 
+/**
+\brief Finds a texture loaded by the model.
+
+\param filename --- Image file named by a material, may be empty.
+
+\return Index of the texture, the last one loaded with the name, -1 if none.
+
+*/
+
+int ObjModel::findTexture(const std::string& filename)
+{
+    int found = -1;
+    if (!filename.empty())
+        for (unsigned int k = 0; k < textures.size(); k++)
+            if (textures[k].Filename.compare(filename) == 0)
+                found = k;
+
+    return found;
+}
+
+/**
+\brief Switches the programs to the permutation for the model's lights, their number
+and kinds, when they changed since the programs were built.  Each new program gets
+the uniform values of the one it replaces.  Called by draw after the lights changed.
+
+*/
+
+void ObjModel::selectLightPrograms()
+{
+    lightsChanged = false;
+
+    std::string lights = Light::shaderDefines(lt, numLights) + " " + LightClusters::shaderDefines() + " " +
+                         ShadowMaps::shaderDefines();
+    if (lights == lightDefines)
+        return;
+
+    lightDefines = lights;
+
+    for (unsigned int i = 0; i < programs.size(); i++)
+    {
+        GLuint program = ShaderLibrary::load("ObjVertexShader.glsl", "ObjFragmentShader.glsl",
+                                             programDefines[i] + " " + lightDefines);
+
+        // Keep drawing with the old lights rather than nothing.
+        if (!program)
+            continue;
+
+        LightClusters::bindProgram(program);
+        ShadowMaps::bindProgram(program);
+        ShaderLibrary::copyUniforms(programs[i], program);
+        ShaderLibrary::release(programs[i]);
+        glDeleteProgram(programs[i]);
+        programs[i] = program;
+    }
+}
+
 
 /**
 \brief Draws the object.
@@ -653,6 +738,9 @@ bool ObjModel::LoadPrograms()
 
 void ObjModel::draw()
 {
+    if (lightsChanged)
+        selectLightPrograms();
+
     for (unsigned int i = 0; i < VBOs.size(); i++)
     {
         std::string matname = MatNames[i];
@@ -672,6 +760,21 @@ void ObjModel::draw()
     }
 }
 
+/**
+\brief Draws the object's triangles with the program in use, for the shadow map pass.
+Only the positions are read.
+
+*/
+
+void ObjModel::drawDepth()
+{
+    for (unsigned int i = 0; i < VBOs.size(); i++)
+    {
+        glBindVertexArray(VBOs[i]);
+        glDrawArrays(GL_TRIANGLES, 0, VertexSizes[i]);
+    }
+}
+
 /**
 \brief Loads the material structure to the shader material structure.
 
@@ -966,11 +1069,8 @@ void ObjModel::setNumberOfLights(int num)
 
     numLights = num;
 
-    for (unsigned int i = 0; i < programs.size(); i++)
-    {
-        glUseProgram(programs[i]);
-        glUniform1i(glGetUniformLocation(programs[i], "numLights"), numLights);
-    }
+    // The programs are built for the number of lights, draw switches them.
+    lightsChanged = true;
 }
 
 
@@ -988,6 +1088,9 @@ void ObjModel::setLight(int num, Light light)
     if (num < 0 || num >= MaxLights)
         return;
 
+    if (num < numLights && light.getType() != lt[num].getType())
+        lightsChanged = true;
+
     lt[num] = light;
 
     for (unsigned int i = 0; i < programs.size(); i++)
@@ -20,10 +20,14 @@
 #include <fstream>
 
 #include "LoadShaders.h"
+#include "ShaderLibrary.h"
 #include "ProgramDefines.h"
 #include "Material.h"
 #include "Light.h"
+#include "LightClusters.h"
+#include "ShadowMaps.h"
 #include "Shape.h"
+#include "ViewFrustum.h"
 
 /**
 \file ObjModel.h
@@ -76,6 +80,8 @@ struct objTexture
 
 #define MaxLights 10
 
+static_assert(SHADOW_MAX_LT >= MaxLights && SHADOW_MAX_LT % 4 == 0, "Every Lt light needs a shadow map entry in the ShadowBlock ivec4s");
+
 class ObjModel : public Shape
 {
 private:
@@ -98,6 +104,9 @@ private:
     std::vector<objTexture> textures;   ///< Vector for storing the object textures.
 
     std::vector<GLuint> programs;   ///< Vector for storing the GLSL program addresses.
+    std::vector<std::string> programDefines;   ///< Texture defines of each program.
+    std::string lightDefines;   ///< Light defines the programs were built with.
+    bool lightsChanged;         ///< The number or kind of the lights changed since the programs were chosen.
 
     Material mat;         ///< Default material for the object.
     Light lt[MaxLights];  ///< Light object.
@@ -108,6 +117,8 @@ private:
 
     float texRatio;   ///< Material texture ratio, r to texture and (1-r) to material.
 
+    BoundingVolume bounds;  ///< Object space bounds of all the vertices in the file.
+
     void LoadDataToGraphicsCard(std::string matname);
 
     void turnLightOn(GLuint program, std::string name, int i);
@@ -116,6 +127,8 @@ private:
     void LoadLight(GLuint program, Light Lt, std::string name, int i);
 
     std::string RemovePath(std::string filename);
+    int findTexture(const std::string& filename);
+    void selectLightPrograms();
 
     void setViewMatrix(GLuint program, glm::mat4 viewMatrix);
     void setProjectionMatrix(GLuint program, glm::mat4 projectionMatrix);
@@ -158,6 +171,8 @@ public:
     void setTextureRatio(float texR);
 
     void draw();
+    void drawDepth();
+    const BoundingVolume& getBounds();
 };
 
 #endif // OBJMODEL_H_INCLUDED
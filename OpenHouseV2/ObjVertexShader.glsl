@@ -30,15 +30,21 @@ to the fragment shader.
 
 \param [uniform] NormalMatrix --- mat3 normal transformation matrix.
 
+\param [uniform] gBones --- mat4 array of bone transformations, SKINNED only.
+
+Defines: SKINNED --- transform the vertices by their bones, for the animated fighters.
+
 */
 
 layout(location = 0) in vec4 vposition;
 layout(location = 1) in vec4 vcolor;
 layout(location = 2) in vec3 vnormal;
 layout(location = 3) in vec2 in_tex_coord;
+#ifdef SKINNED
 //Bone Stuff
 layout(location = 4) in ivec4 BoneIDs;
 layout(location = 5) in vec4 Weights;
+#endif
 
 uniform mat4 PVM;
 uniform mat4 Model;
@@ -48,12 +54,14 @@ out vec4 color;
 out vec4 position;
 out vec3 normal;
 out vec2 tex_coord;
+#ifdef SKINNED
 //Bone Stuffs
 flat out ivec4 BoneIDs0;
 out vec4 Weights0;
 
 const int MAX_BONES = 200;
 uniform mat4 gBones[MAX_BONES];
+#endif
 
 //mat4 BoneTransform;
 
@@ -61,6 +69,7 @@ uniform mat4 gBones[MAX_BONES];
 
 void main()
 {
+#ifdef SKINNED
     //If no bones, weight will be 0 so multiplication has no effect (hopefully)
     mat4 BoneTransform = gBones[BoneIDs[0]] * Weights[0];
     mat4 EmptyMatrix;
@@ -76,6 +85,7 @@ void main()
         //vec4 PosL = BoneTransform * vposition;
         //vec4 PosL = BoneTransform * (vposition * vec4(1.0));
     }
+#endif
 
     tex_coord = in_tex_coord;
     color = vcolor;
@@ -84,7 +94,11 @@ void main()
     //gl_Position = PVM * vposition;//Original in case of debug needs
     //Bone Stuffs
     //gl_Position = PVM * PosL;//This includes the bone transformations
+#ifdef SKINNED
     gl_Position = PVM * BoneTransform * vposition;
     BoneIDs0 = BoneIDs;
     Weights0 = Weights;
+#else
+    gl_Position = PVM * vposition;
+#endif
 }
@@ -0,0 +1,154 @@
+#include "OffscreenContext.h"
+
+#include <string.h>
+
+#include <iostream>
+
+#ifdef __linux__
+#include <EGL/eglext.h>
+#endif // __linux__
+
+/**
+\file OffscreenContext.cpp
+\brief OpenGL context with no window, for the benchmark mode.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor, no context until create.
+
+*/
+
+OffscreenContext::OffscreenContext()
+{
+#ifdef __linux__
+    display = EGL_NO_DISPLAY;
+    surface = EGL_NO_SURFACE;
+    context = EGL_NO_CONTEXT;
+#endif // __linux__
+}
+
+/**
+\brief Destructor
+
+Releases the context if it is still there.
+
+*/
+
+OffscreenContext::~OffscreenContext()
+{
+    destroy();
+}
+
+/**
+\brief Makes an OpenGL core context drawing into a pbuffer and makes it current.
+
+\param width --- Width of the pbuffer in pixels.
+\param height --- Height of the pbuffer in pixels.
+\param major --- OpenGL major version asked for.
+\param minor --- OpenGL minor version asked for.
+
+\return True if the context is current.
+
+*/
+
+bool OffscreenContext::create(int width, int height, int major, int minor)
+{
+#ifdef __linux__
+    // The surfaceless platform needs no X server, it is a client extension of Mesa.
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+    if (clientExtensions && strstr(clientExtensions, "EGL_MESA_platform_surfaceless"))
+    {
+        PFNEGLGETPLATFORMDISPLAYEXTPROC getPlatformDisplay =
+            (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay)
+            display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, NULL);
+    }
+    if (display == EGL_NO_DISPLAY)
+        display = eglGetDisplay(EGL_DEFAULT_DISPLAY);
+
+    if (display == EGL_NO_DISPLAY || !eglInitialize(display, NULL, NULL))
+    {
+        std::cerr << "Could not open an EGL display." << std::endl;
+        display = EGL_NO_DISPLAY;
+        return false;
+    }
+
+    const EGLint configAttribs[] = {
+        EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+        EGL_RED_SIZE, 8,
+        EGL_GREEN_SIZE, 8,
+        EGL_BLUE_SIZE, 8,
+        EGL_ALPHA_SIZE, 8,
+        EGL_DEPTH_SIZE, 24,
+        EGL_STENCIL_SIZE, 8,
+        EGL_NONE
+    };
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(display, configAttribs, &config, 1, &configCount) || configCount < 1)
+    {
+        std::cerr << "No EGL config for an OpenGL pbuffer." << std::endl;
+        destroy();
+        return false;
+    }
+
+    const EGLint surfaceAttribs[] = {EGL_WIDTH, width, EGL_HEIGHT, height, EGL_NONE};
+    surface = eglCreatePbufferSurface(display, config, surfaceAttribs);
+    if (surface == EGL_NO_SURFACE)
+    {
+        std::cerr << "Could not make a " << width << "x" << height << " pbuffer." << std::endl;
+        destroy();
+        return false;
+    }
+
+    eglBindAPI(EGL_OPENGL_API);
+    const EGLint contextAttribs[] = {
+        EGL_CONTEXT_MAJOR_VERSION, major,
+        EGL_CONTEXT_MINOR_VERSION, minor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+    };
+    context = eglCreateContext(display, config, EGL_NO_CONTEXT, contextAttribs);
+    if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, surface, surface, context))
+    {
+        std::cerr << "Could not make an OpenGL " << major << "." << minor << " core context." << std::endl;
+        destroy();
+        return false;
+    }
+
+    return true;
+#else
+    std::cerr << "Offscreen contexts are only built on Linux." << std::endl;
+    return false;
+#endif // __linux__
+}
+
+/**
+\brief Releases the context, surface and display.
+
+*/
+
+void OffscreenContext::destroy()
+{
+#ifdef __linux__
+    if (display == EGL_NO_DISPLAY)
+        return;
+
+    eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    if (context != EGL_NO_CONTEXT)
+        eglDestroyContext(display, context);
+    if (surface != EGL_NO_SURFACE)
+        eglDestroySurface(display, surface);
+    eglTerminate(display);
+
+    display = EGL_NO_DISPLAY;
+    surface = EGL_NO_SURFACE;
+    context = EGL_NO_CONTEXT;
+#endif // __linux__
+}
@@ -0,0 +1,48 @@
+#ifndef OFFSCREENCONTEXT_H_INCLUDED
+#define OFFSCREENCONTEXT_H_INCLUDED
+
+#ifdef __linux__
+#include <EGL/egl.h>
+#endif // __linux__
+
+/**
+\file OffscreenContext.h
+
+\brief Header file for OffscreenContext.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\class OffscreenContext
+
+\brief OpenGL core context with no window, through EGL.
+
+Uses Mesa's surfaceless platform when it is there, so no X server or GPU is needed and
+llvmpipe does the drawing, otherwise the default EGL display.  The context draws into
+a pbuffer of the size asked for, which stands in for the window's framebuffer.  Only
+built on Linux, elsewhere create always fails.
+
+*/
+
+class OffscreenContext
+{
+private:
+#ifdef __linux__
+    EGLDisplay display;   ///< EGL display connection.
+    EGLSurface surface;   ///< Pbuffer drawn into.
+    EGLContext context;   ///< The OpenGL context.
+#endif // __linux__
+
+public:
+    OffscreenContext();
+    ~OffscreenContext();
+
+    bool create(int width, int height, int major, int minor);
+    void destroy();
+};
+
+#endif // OFFSCREENCONTEXT_H_INCLUDED
@@ -0,0 +1,275 @@
+#include "OverdrawView.h"
+
+#include <vector>
+
+/**
+\file OverdrawView.cpp
+\brief Overdraw measurement and heat map.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+bool OverdrawView::visible = false;
+
+/**
+\brief Constructor
+
+Generates the queries and the rectangles of the heat map, one covering the screen for
+each level.
+
+*/
+
+OverdrawView::OverdrawView()
+{
+    const GLfloat colors[OVERDRAW_LEVELS][3] = {{0, 0, 0}, {0, 0, 0.6f}, {0, 0.5f, 1}, {0, 0.8f, 0.2f},
+                                                {0.8f, 0.8f, 0}, {1, 0.5f, 0}, {1, 0, 0}, {1, 1, 1}};
+    const GLfloat x[6] = {-1, 1, 1, -1, 1, -1};
+    const GLfloat y[6] = {-1, -1, 1, -1, 1, 1};
+
+    std::vector<GLfloat> verts;
+    for (int level = 0; level < OVERDRAW_LEVELS; level++)
+        for (int i = 0; i < 6; i++)
+        {
+            verts.push_back(x[i]);
+            verts.push_back(y[i]);
+            verts.push_back(colors[level][0]);
+            verts.push_back(colors[level][1]);
+            verts.push_back(colors[level][2]);
+        }
+
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(GLfloat), &verts[0], GL_STATIC_DRAW);
+
+    // Interleaved (x, y, r, g, b), the 2D pass-through shader's layout.
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), BUFFER_OFFSET(0));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), BUFFER_OFFSET(2 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+
+    glGenQueries(OVERDRAW_QUERY_FRAMES * OVERDRAW_SEGMENTS, &queries[0][0]);
+    for (int i = 0; i < OVERDRAW_QUERY_FRAMES; i++)
+    {
+        used[i] = 0;
+        samples[i] = 0;
+    }
+
+    frame = 0;
+    counting = false;
+    querying = false;
+    active = false;
+    overdraw = -1;
+}
+
+/**
+\brief Destructor
+
+Clears the graphics memory used for the heat map and the queries.
+
+*/
+
+OverdrawView::~OverdrawView()
+{
+    glDeleteQueries(OVERDRAW_QUERY_FRAMES * OVERDRAW_SEGMENTS, &queries[0][0]);
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+}
+
+/**
+\brief Reads the counts of every frame whose queries have all finished, without
+blocking, oldest first so the newest is kept.
+
+*/
+
+void OverdrawView::collect()
+{
+    for (int i = 1; i <= OVERDRAW_QUERY_FRAMES; i++)
+    {
+        int f = (frame + i) % OVERDRAW_QUERY_FRAMES;
+        if (!used[f])
+            continue;
+
+        // The queries of a frame finish in the order they were begun.
+        GLint available = 0;
+        glGetQueryObjectiv(queries[f][used[f] - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+
+        double passed = 0;
+        for (int q = 0; q < used[f]; q++)
+        {
+            GLuint n = 0;
+            glGetQueryObjectuiv(queries[f][q], GL_QUERY_RESULT, &n);
+            passed += n;
+        }
+        used[f] = 0;
+
+        if (samples[f] > 0)
+            overdraw = passed / samples[f];
+    }
+}
+
+/**
+\brief Starts counting the shaded samples of the frame, after the target is bound and
+cleared.  With the heat map shown the stencil buffer is cleared and counts them too.
+
+*/
+
+void OverdrawView::begin()
+{
+    collect();
+
+    counting = true;
+    querying = used[frame] == 0;
+    active = false;
+
+    if (visible)
+    {
+        glStencilMask(0xFF);
+        glClear(GL_STENCIL_BUFFER_BIT);
+        glEnable(GL_STENCIL_TEST);
+        glStencilFunc(GL_ALWAYS, 0, 0xFF);
+        glStencilOp(GL_KEEP, GL_KEEP, GL_INCR);
+    }
+
+    resume();
+}
+
+/**
+\brief Stops counting for a pass that shades nothing, the depth pre-pass or the shadow
+maps.  Does nothing outside begin and end.
+
+*/
+
+void OverdrawView::pause()
+{
+    if (!counting)
+        return;
+
+    if (visible)
+        glStencilMask(0);
+    if (active)
+    {
+        glEndQuery(GL_SAMPLES_PASSED);
+        active = false;
+    }
+}
+
+/**
+\brief Counts again after pause.  Past OVERDRAW_SEGMENTS stretches in a frame the
+rest of it goes uncounted.
+
+*/
+
+void OverdrawView::resume()
+{
+    if (!counting || active)
+        return;
+
+    if (visible)
+        glStencilMask(0xFF);
+    if (querying && used[frame] < OVERDRAW_SEGMENTS)
+    {
+        glBeginQuery(GL_SAMPLES_PASSED, queries[frame][used[frame]++]);
+        active = true;
+    }
+}
+
+/**
+\brief Stops counting the frame, with the target still bound.
+
+\param width --- Width of the target in pixels.
+\param height --- Height of the target in pixels.
+
+*/
+
+void OverdrawView::end(GLuint width, GLuint height)
+{
+    if (!counting)
+        return;
+
+    pause();
+    counting = false;
+
+    if (visible)
+    {
+        glDisable(GL_STENCIL_TEST);
+        glStencilMask(0xFF);
+    }
+
+    if (querying)
+    {
+        GLint perPixel = 1;
+        glGetIntegerv(GL_SAMPLES, &perPixel);
+        samples[frame] = (double)width * height * (perPixel > 1 ? perPixel : 1);
+        frame = (frame + 1) % OVERDRAW_QUERY_FRAMES;
+    }
+}
+
+/**
+\brief Covers the scene with the heat map of the counts in the stencil buffer, if it is
+shown.  The 2D pass-through shader must be in use with the target still bound, after
+end.  Depth testing is turned off for the map and back on after.
+
+*/
+
+void OverdrawView::draw()
+{
+    if (!visible)
+        return;
+
+    glDisable(GL_DEPTH_TEST);
+    glEnable(GL_STENCIL_TEST);
+    glStencilMask(0);
+    glBindVertexArray(vao);
+
+    for (int level = 0; level < OVERDRAW_LEVELS; level++)
+    {
+        // The last color takes every count from its level up.
+        glStencilFunc(level + 1 < OVERDRAW_LEVELS ? GL_EQUAL : GL_LEQUAL, level, 0xFF);
+        glDrawArrays(GL_TRIANGLES, 6 * level, 6);
+    }
+
+    glStencilMask(0xFF);
+    glDisable(GL_STENCIL_TEST);
+    glEnable(GL_DEPTH_TEST);
+}
+
+/**
+\brief Returns the shaded samples per sample of the target of the newest frame read
+back, -1 before the first.
+
+*/
+
+double OverdrawView::getOverdraw()
+{
+    return overdraw;
+}
+
+/**
+\brief Shows or hides the heat map.  Takes effect at the next begin.
+
+\param on --- Show the heat map.
+
+*/
+
+void OverdrawView::setVisible(bool on)
+{
+    visible = on;
+}
+
+/**
+\brief Returns true if the heat map is shown.
+
+*/
+
+bool OverdrawView::isVisible()
+{
+    return visible;
+}
@@ -0,0 +1,79 @@
+#ifndef OVERDRAWVIEW_H_INCLUDED
+#define OVERDRAWVIEW_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include "ProgramDefines.h"
+
+/**
+\file OverdrawView.h
+
+\brief Header file for OverdrawView.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define OVERDRAW_LEVELS 8           ///< Colors of the heat map, the last one for this many shaded samples or more.
+#define OVERDRAW_QUERY_FRAMES 4     ///< Frames of sample counts waiting to be read back.
+#define OVERDRAW_SEGMENTS 8         ///< Most counted stretches of a frame, one more after each pause.
+
+/**
+\class OverdrawView
+
+\brief Measures how many times each pixel of the scene is shaded and shows it as a heat
+map, F1.
+
+Every sample that passes the depth test between begin and end is counted with
+GL_SAMPLES_PASSED queries, and the count over the samples of the target is the
+overdraw, 1 when every sample is shaded once.  The depth pre-pass and the shadow maps
+pause the count since they shade nothing.  The results are read back
+OVERDRAW_QUERY_FRAMES frames late without waiting on the GPU.
+
+While the heat map is shown the stencil buffer counts the same samples per pixel, and
+draw covers the scene with one color for each count, black for none through blue,
+green, yellow and red to white for OVERDRAW_LEVELS or more.
+
+*/
+
+class OverdrawView
+{
+private:
+    static bool visible;            ///< Heat map drawn over the scene.
+
+    GLuint vao;                     ///< Vertex Array Object ID.
+    GLuint vbo;                     ///< Screen covering rectangle of each level, (x, y, r, g, b).
+    GLuint queries[OVERDRAW_QUERY_FRAMES][OVERDRAW_SEGMENTS];  ///< Sample counting queries of each frame of the ring.
+    int used[OVERDRAW_QUERY_FRAMES];            ///< Queries of each frame waiting to be read, 0 for none.
+    double samples[OVERDRAW_QUERY_FRAMES];      ///< Samples of the target each frame was drawn at.
+    int frame;                      ///< Slot of this frame in the ring.
+    bool counting;                  ///< Between begin and end.
+    bool querying;                  ///< This frame's samples are counted, its slot was free.
+    bool active;                    ///< A query is running.
+    double overdraw;                ///< Shaded samples per sample of the last frame read back, -1 before any.
+
+    void collect();
+
+public:
+    OverdrawView();
+    ~OverdrawView();
+
+    void begin();
+    void pause();
+    void resume();
+    void end(GLuint width, GLuint height);
+    void draw();
+
+    double getOverdraw();
+
+    static void setVisible(bool on);
+    static bool isVisible();
+};
+
+#endif // OVERDRAWVIEW_H_INCLUDED
@@ -0,0 +1,241 @@
+/**
+\file PhongLights.glsl
+
+\brief The lights of the Phong fragment shaders, built for the lights of the scene.
+
+The program is built for LIGHTS lights with the kind of each listed in LIGHT_TYPES, for
+instance LIGHTS=3 LIGHT_TYPES=2,2,3, see Light::shaderDefines.  The loops over the lights
+run a constant number of times and branch on constant kinds, so the compiler unrolls
+them and each light costs only what its kind needs.  Whether a light is on stays a
+uniform, Lt[i].on.
+
+With SHADOWS=n the directional and spot lights, Lt and clustered, are darkened by the
+shadow maps they were given (see ShadowMaps), n being the most maps in a frame.  The
+first SHADOW_LT Lt lights can have a map, the rest cast none.
+
+\param [uniform] Lt --- Light array, one for each light of the scene.
+
+\param [uniform] ShadowBlock --- Shadow map matrices and rectangles and the map of each
+Lt light, SHADOWS only.
+
+\param [uniform] shadowAtlas --- sampler2DShadow, the depth atlas, SHADOWS only.
+
+*/
+
+#include "PhongStructs.glsl"
+
+#define LIGHT_DIRECTIONAL 1
+#define LIGHT_POINT 2
+#define LIGHT_SPOT 3
+
+#ifndef LIGHTS
+#define LIGHTS 0
+#endif
+
+#if LIGHTS > 0
+uniform Light Lt[LIGHTS];
+const int LtType[LIGHTS] = int[LIGHTS](LIGHT_TYPES);
+#endif
+
+/**
+\brief Finds the direction to a light and how much of it reaches a point.
+
+\param lt --- The light.
+
+\param type --- Its kind, LIGHT_DIRECTIONAL, LIGHT_POINT or LIGHT_SPOT.
+
+\param p --- The point.
+
+\param l --- Set to the unit direction from the point to the light.
+
+\return The attenuation times the spot fade, 1 for a directional light.
+
+*/
+
+float lightReach(Light lt, int type, vec3 p, out vec3 l)
+{
+    if (type == LIGHT_DIRECTIONAL)
+    {
+        l = normalize(vec3(lt.position));
+        return 1.0;
+    }
+
+    l = normalize(vec3(lt.position)-p);
+    float lightDistance = length(vec3(lt.position)-p);
+
+    float attenuation = 1.0 / (lt.attenuation[0] +
+                               lt.attenuation[1] * lightDistance +
+                               lt.attenuation[2] * lightDistance * lightDistance);
+
+    float spotFactor = 1.0;
+    if (type == LIGHT_SPOT)
+    {
+        float spotCos = dot(l, -normalize(lt.spotDirection));
+        float SpotCosCutoff = cos(radians(lt.spotCutoff));  // assumes that spotCutoff is in degrees
+
+        if (spotCos < SpotCosCutoff)
+        {
+            float range = 1 + SpotCosCutoff;
+            spotFactor = pow(1 - (SpotCosCutoff - spotCos)/range, lt.spotExponent);
+        }
+    }
+
+    return attenuation*spotFactor;
+}
+
+#ifdef SHADOWS
+layout(std140) uniform ShadowBlock
+{
+    mat4 shadowMatrix[SHADOWS];
+    vec4 shadowRect[SHADOWS];
+    vec4 shadowParams[SHADOWS];
+    ivec4 shadowLt[SHADOW_LT / 4];
+};
+
+uniform sampler2DShadow shadowAtlas;
+
+/**
+\brief Finds how much of a light reaches a point past the casters of its shadow map,
+from four filtered compares half a texel apart.
+
+\param map --- The light's map, -1 for none.
+
+\param p --- The point, in world coordinates.
+
+\param n --- Unit normal at the point.
+
+\return 0 in full shadow to 1 in full light, 1 with no map or off the map.
+
+*/
+
+float shadowFactor(int map, vec3 p, vec3 n)
+{
+    if (map < 0)
+        return 1.0;
+
+    // Pushed off the surface by a texel and a half against self shadowing, a spot's
+    // texels grow with the distance, which is clip w.
+    vec4 s = shadowMatrix[map]*vec4(p, 1.0);
+    s += shadowMatrix[map]*vec4(n*1.5*shadowParams[map].x*s.w, 0.0);
+    if (s.w <= 0.0)
+        return 1.0;
+
+    vec3 c = s.xyz/s.w;
+    vec4 rect = shadowRect[map];
+    if (c.x < rect.x || c.y < rect.y || c.x > rect.z || c.y > rect.w || c.z > 1.0)
+        return 1.0;
+
+    // The taps stay inside the map's tile of the atlas.
+    float texel = shadowParams[map].y;
+    float lit = 0.0;
+    for (int i = 0; i < 4; i++)
+    {
+        vec2 tap = c.xy + (vec2(i & 1, i >> 1) - 0.5)*texel;
+        lit += texture(shadowAtlas, vec3(clamp(tap, rect.xy + texel, rect.zw - texel), c.z));
+    }
+    return 0.25*lit;
+}
+
+/**
+\brief Finds how much of Lt light i reaches a point past the casters of its shadow map.
+
+\param i --- Index of the light.
+
+\param p --- The point, in world coordinates.
+
+\param n --- Unit normal at the point.
+
+\return 0 in full shadow to 1 in full light.
+
+*/
+
+float ltShadow(int i, vec3 p, vec3 n)
+{
+    if (i >= SHADOW_LT)
+        return 1.0;
+
+    return shadowFactor(shadowLt[i >> 2][i & 3] - 1, p, n);
+}
+#endif
+
+#ifdef CLUSTERED
+layout(std140) uniform ClusterGrid
+{
+    mat4 clusterView;
+    mat4 clusterProj;
+    vec4 clusterDepth;
+    ivec4 clusterDims;
+};
+
+uniform samplerBuffer clusterLights;
+uniform usamplerBuffer clusterCells;
+uniform usamplerBuffer clusterIndices;
+
+/**
+\brief Sums the diffuse and specular light reaching a point from the lights of its
+cluster.  A light fades smoothly to nothing at its range, on top of its attenuation and
+spot fade, and is darkened by its shadow map if it has one.
+
+\param p --- The point, in world coordinates.
+
+\param n --- Unit normal at the point.
+
+\param v --- Unit direction from the point to the eye.
+
+\param shininess --- Specular exponent of the material.
+
+\param diffuse --- Set to the sum of the lights' diffuse colors times their reach.
+
+\param specular --- Set to the sum of the lights' specular colors times their reach.
+
+*/
+
+void clusterLighting(vec3 p, vec3 n, vec3 v, float shininess, out vec3 diffuse, out vec3 specular)
+{
+    diffuse = vec3(0.0);
+    specular = vec3(0.0);
+
+    // Points off the grid's screen are lit by its edge clusters.
+    vec4 viewPos = clusterView*vec4(p, 1.0);
+    vec4 clip = clusterProj*viewPos;
+    vec2 ndc = clip.xy/max(clip.w, 1e-5);
+    ivec2 tile = clamp(ivec2((ndc*0.5 + 0.5)*vec2(clusterDims.xy)), ivec2(0), clusterDims.xy - 1);
+    int slice = clamp(int(log(max(-viewPos.z, clusterDepth.x)/clusterDepth.x)*clusterDepth.y), 0, clusterDims.z - 1);
+    uvec2 cell = texelFetch(clusterCells, (slice*clusterDims.y + tile.y)*clusterDims.x + tile.x).xy;
+
+    for (uint i = 0u; i < cell.y; i++)
+    {
+        int base = 5*int(texelFetch(clusterIndices, int(cell.x + i)).x);
+        vec4 position = texelFetch(clusterLights, base);
+        vec4 color = texelFetch(clusterLights, base + 1);
+        vec4 shine = texelFetch(clusterLights, base + 2);
+        vec3 spotDirection = texelFetch(clusterLights, base + 3).xyz;
+        vec4 atten = texelFetch(clusterLights, base + 4);
+
+        vec3 toLight = position.xyz - p;
+        float lightDistance = max(length(toLight), 1e-4);
+        vec3 l = toLight/lightDistance;
+
+        float window = clamp(1.0 - pow(lightDistance/position.w, 4.0), 0.0, 1.0);
+        float reach = window*window/(atten.x + atten.y*lightDistance + atten.z*lightDistance*lightDistance);
+
+        // shine.w is the cosine of the spot cutoff, -2 for a point light.
+        float spotCos = dot(l, -spotDirection);
+        if (spotCos < shine.w)
+            reach *= pow(1 - (shine.w - spotCos)/(1 + shine.w), color.w);
+
+#ifdef SHADOWS
+        // atten.w is the light's shadow map plus one, 0 for none.
+        if (reach > 0.0)
+            reach *= shadowFactor(int(atten.w) - 1, p, n);
+#endif
+
+        float dfang = max(0.0, dot(l, n));
+        vec3 r = normalize(2.0*dot(l,n)*n - l);
+        float specang = dfang == 0 ? 0 : max(0.0, dot(r, v));
+
+        diffuse += color.rgb*dfang*reach;
+        specular += shine.rgb*pow(specang, shininess)*reach;
+    }
+}
+#endif
@@ -33,38 +33,16 @@ textual for the same fragment and combines the two.
 */
 
 
-struct Light
-{
-    bool on;             ///< Light on or off.
-    vec4 position;       ///< Position of the light.
-    vec3 spotDirection;  ///< Direction of the spot light.
-    vec4 ambient;        ///< Ambient color of the light.
-    vec4 diffuse;        ///< Diffuse color of the light.
-    vec4 specular;       ///< Specular color of the light.
-    float spotCutoff;    ///< Spot cutoff angle.
-    float spotExponent;  ///< Spot falloff exponent.
-    vec3 attenuation;    ///< Attenuation vector, x = constant, y = linear, z = quadratic.
-};
-
-struct Material
-{
-    vec4 ambient;     ///< Ambient color of the material.
-    vec4 diffuse;     ///< Diffuse color of the material.
-    vec4 specular;    ///< Specular color of the material.
-    vec4 emission;    ///< Emission color of the material.
-    float shininess;  ///< Shininess exponent of the material.
-};
+#include "PhongLights.glsl"
 
 in vec4 position;
 in vec4 color;
 in vec3 normal;
 in vec2 tex_coord;
 
-uniform Light Lt[10];
 uniform Material Mat;
 uniform vec3 eye;
 uniform vec4 GlobalAmbient;
-uniform int numLights;
 uniform bool useTexture;
 uniform mat4 textrans;
 
@@ -74,8 +52,6 @@ out vec4 fColor;
 
 void main()
 {
-    float deg = 0.017453292519943296;
-
     vec4 cc = vec4(0.0);
     bool usingLights = false;
     vec4 globalAmbientPortion = Mat.ambient*GlobalAmbient;
@@ -99,44 +75,45 @@ void main()
     Mat2.emission= vec4(0);
     Mat2.shininess= 32;
 
-    for (int i = 0; i < numLights; i++)
+#if LIGHTS > 0
+    for (int i = 0; i < LIGHTS; i++)
     {
         if (Lt[i].on)
         {
             usingLights = true;
             vec3 n = normalize(normal);
-            vec3 l = normalize(vec3(Lt[i].position)-vec3(position));
+            vec3 l;
+            float reach = lightReach(Lt[i], LtType[i], vec3(position), l);
+#ifdef SHADOWS
+            if (LtType[i] != LIGHT_POINT)
+                reach *= ltShadow(i, vec3(position), n);
+#endif
             vec3 r = normalize(2.0*dot(l,n)*n - l);
             vec3 v = normalize(eye-vec3(position));
-            float lightDistance =length(vec3(Lt[i].position)-vec3(position));
 
             float dfang = max(0.0, dot(l, n));
             float specang = max(0.0, dot(r, v));
             if (dfang == 0)
                 specang = 0;
 
-            float attenuation = 1.0 / (Lt[i].attenuation[0] +
-                                       Lt[i].attenuation[1] * lightDistance +
-                                       Lt[i].attenuation[2] * lightDistance * lightDistance);
-
-            float spotCos = dot(l, -normalize(Lt[i].spotDirection));
-            float SpotCosCutoff = cos(Lt[i].spotCutoff*deg);  // assumes that spotCutoff is in degrees
-
-            float spotFactor = 1.0;
-            if (spotCos < SpotCosCutoff && Lt[i].spotCutoff < 179.9)  // Only fade if a spotlight
-            {
-                float range = 1 + SpotCosCutoff;
-                spotFactor = pow(1 - (SpotCosCutoff - spotCos)/range, Lt[i].spotExponent);
-            }
-
             vec4 ambientPortion = Mat2.ambient*Lt[i].ambient;
-            vec4 diffusePortion = Mat2.diffuse*Lt[i].diffuse*dfang*attenuation*spotFactor;
-            vec4 specularPortion = Mat2.specular*Lt[i].specular*pow(specang, Mat2.shininess)*attenuation*spotFactor;
+            vec4 diffusePortion = Mat2.diffuse*Lt[i].diffuse*dfang*reach;
+            vec4 specularPortion = Mat2.specular*Lt[i].specular*pow(specang, Mat2.shininess)*reach;
 
             vec4 c = ambientPortion + diffusePortion + specularPortion;
             cc += min(c, vec4(1.0));
         }
     }
+#endif
+
+#ifdef CLUSTERED
+    // The clustered lights add to the scene's lights, they do not light an unlit scene.
+    vec3 clusterDiffuse;
+    vec3 clusterSpecular;
+    clusterLighting(vec3(position), normalize(normal), normalize(eye-vec3(position)), Mat2.shininess,
+                    clusterDiffuse, clusterSpecular);
+    cc += min(Mat2.diffuse*vec4(clusterDiffuse, 0) + Mat2.specular*vec4(clusterSpecular, 0), vec4(1.0));
+#endif
 
     cc = min(cc + globalAmbientPortion + Mat2.emission, vec4(1.0));
 
@@ -0,0 +1,29 @@
+/**
+\file PhongStructs.glsl
+
+\brief Light and material structs shared by the Phong fragment shaders, pulled in
+with #include "PhongStructs.glsl" after the #version line.
+
+*/
+
+struct Light
+{
+    bool on;             ///< Light on or off.
+    vec4 position;       ///< Position of the light.
+    vec3 spotDirection;  ///< Direction of the spot light.
+    vec4 ambient;        ///< Ambient color of the light.
+    vec4 diffuse;        ///< Diffuse color of the light.
+    vec4 specular;       ///< Specular color of the light.
+    float spotCutoff;    ///< Spot cutoff angle.
+    float spotExponent;  ///< Spot falloff exponent.
+    vec3 attenuation;    ///< Attenuation vector, x = constant, y = linear, z = quadratic.
+};
+
+struct Material
+{
+    vec4 ambient;     ///< Ambient color of the material.
+    vec4 diffuse;     ///< Diffuse color of the material.
+    vec4 specular;    ///< Specular color of the material.
+    vec4 emission;    ///< Emission color of the material.
+    float shininess;  ///< Shininess exponent of the material.
+};
@@ -28,6 +28,10 @@ Plane::Plane()
     green = 1.0;
     blue = 1.0;
 
+    bounds.add(-1, -1, 0);
+    bounds.add(1, 1, 0);
+    bounds.finish();
+
     LoadDataToGraphicsCard();
 }
 
@@ -190,6 +194,16 @@ void Plane::draw()
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, NULL);
 }
 
+/**
+\brief Returns the object space bounding volume of the plane for culling.
+
+*/
+
+const BoundingVolume& Plane::getBounds()
+{
+    return bounds;
+}
+
 /**
 \brief Sets the color of the plane and reloads the data.
 
@@ -15,6 +15,7 @@
 
 #include "ProgramDefines.h"
 #include "Shape.h"
+#include "ViewFrustum.h"
 
 /**
 \file Plane.h
@@ -50,6 +51,8 @@ private:
     GLuint bufptr;  ///< ID for the data buffer.
     GLuint eboptr;  ///< ID for the index buffer.
 
+    BoundingVolume bounds;  ///< Object space bounds of the plane.
+
 public:
     Plane();
     ~Plane();
@@ -60,6 +63,7 @@ public:
     void LoadDataToGraphicsCard(GLint v, GLint c, GLint n, GLint t);
 
     void draw();
+    const BoundingVolume& getBounds();
 };
 
 
@@ -0,0 +1,143 @@
+#include "ProfileOverlay.h"
+
+/**
+\file ProfileOverlay.cpp
+\brief Frame time graph of the profiler.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor
+
+Generates the vertex array and buffer, the data is streamed in on each draw.
+
+*/
+
+ProfileOverlay::ProfileOverlay()
+{
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    // Interleaved (x, y, r, g, b), stride of 5 floats, same layout as HUDLayer.
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), BUFFER_OFFSET(0));
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 5 * sizeof(GLfloat), BUFFER_OFFSET(2 * sizeof(GLfloat)));
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+}
+
+/**
+\brief Destructor
+
+Clears the graphics memory used for the graph.
+
+*/
+
+ProfileOverlay::~ProfileOverlay()
+{
+    glDeleteBuffers(1, &vbo);
+    glDeleteVertexArrays(1, &vao);
+}
+
+/**
+\brief Adds a solid rectangle as two triangles.
+
+\param x0 --- Left edge.
+\param y0 --- Bottom edge.
+\param x1 --- Right edge.
+\param y1 --- Top edge.
+\param r --- Red intensity.
+\param g --- Green intensity.
+\param b --- Blue intensity.
+
+*/
+
+void ProfileOverlay::addRect(GLfloat x0, GLfloat y0, GLfloat x1, GLfloat y1, GLfloat r, GLfloat g, GLfloat b)
+{
+    GLfloat x[6] = {x0, x1, x1, x0, x1, x0};
+    GLfloat y[6] = {y0, y0, y1, y0, y1, y1};
+
+    for (int i = 0; i < 6; i++)
+    {
+        verts.push_back(x[i]);
+        verts.push_back(y[i]);
+        verts.push_back(r);
+        verts.push_back(g);
+        verts.push_back(b);
+    }
+}
+
+/**
+\brief Builds and draws the graph of the frames the profiler has kept.
+
+The 2D pass-through shader must be in use with the window framebuffer bound.  Depth
+testing is turned off for the graph and back on after.
+
+\param profiler --- Profiler to graph.
+
+*/
+
+void ProfileOverlay::draw(Profiler& profiler)
+{
+    const GLfloat left = -0.98f;
+    const GLfloat right = -0.18f;
+    const GLfloat bottom = -0.98f;
+    const GLfloat top = -0.58f;
+    const GLfloat line = 0.004f;
+    const GLfloat perMs = (top - bottom) / PROFILE_GRAPH_MS;
+    const GLfloat column = (right - left) / PROFILER_HISTORY;
+    const double budget = 1000.0 / 60;
+
+    verts.clear();
+    addRect(left - 0.01f, bottom - 0.01f, right + 0.01f, top + 0.01f, 0.08f, 0.08f, 0.1f);
+
+    int n = profiler.getFrameCount() < PROFILER_HISTORY ? profiler.getFrameCount() : PROFILER_HISTORY;
+    for (int i = 0; i < n; i++)
+    {
+        const ProfileFrame& f = profiler.getFrame(i);
+        GLfloat x1 = right - i * column;
+        GLfloat x0 = x1 - column;
+
+        double cpu = f.cpuMs < PROFILE_GRAPH_MS ? f.cpuMs : PROFILE_GRAPH_MS;
+        if (f.cpuMs <= budget)
+            addRect(x0, bottom, x1, bottom + cpu * perMs, 0.2f, 0.7f, 0.2f);
+        else if (f.cpuMs <= 2 * budget)
+            addRect(x0, bottom, x1, bottom + cpu * perMs, 0.8f, 0.7f, 0.1f);
+        else
+            addRect(x0, bottom, x1, bottom + cpu * perMs, 0.8f, 0.15f, 0.1f);
+
+        if (f.gpuMs >= 0)
+        {
+            double gpu = f.gpuMs < PROFILE_GRAPH_MS ? f.gpuMs : PROFILE_GRAPH_MS;
+            addRect(x0 + column / 4, bottom, x1 - column / 4, bottom + gpu * perMs, 0.2f, 0.4f, 1.0f);
+        }
+    }
+
+    addRect(left, bottom + budget * perMs, right, bottom + budget * perMs + line, 0.5f, 0.5f, 0.5f);
+    addRect(left, bottom + 2 * budget * perMs, right, bottom + 2 * budget * perMs + line, 0.5f, 0.5f, 0.5f);
+
+    double p[3] = {profiler.frameTimePercentile(50), profiler.frameTimePercentile(95), profiler.frameTimePercentile(99)};
+    GLfloat pColor[3][3] = {{0, 1, 1}, {1, 1, 0}, {1, 0, 1}};
+    for (int i = 0; i < 3; i++)
+    {
+        if (p[i] <= 0 || p[i] > PROFILE_GRAPH_MS)
+            continue;
+        GLfloat y = bottom + p[i] * perMs;
+        addRect(left, y, right, y + line, pColor[i][0], pColor[i][1], pColor[i][2]);
+    }
+
+    glDisable(GL_DEPTH_TEST);
+
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, verts.size() * sizeof(GLfloat), &verts[0], GL_STREAM_DRAW);
+    glDrawArrays(GL_TRIANGLES, 0, verts.size() / 5);
+
+    glEnable(GL_DEPTH_TEST);
+}
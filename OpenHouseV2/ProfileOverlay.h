@@ -0,0 +1,61 @@
+#ifndef PROFILEOVERLAY_H_INCLUDED
+#define PROFILEOVERLAY_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <vector>
+
+#include "ProgramDefines.h"
+#include "Profiler.h"
+
+/**
+\file ProfileOverlay.h
+
+\brief Header file for ProfileOverlay.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define PROFILE_GRAPH_MS 50   ///< Frame time at the top of the graph, milliseconds.
+
+/**
+\class ProfileOverlay
+
+\brief Frame time graph of the Profiler history drawn over the lower left of the window.
+
+Each of the last PROFILER_HISTORY frames is a column, oldest on the left.  The CPU
+frame time is a bar colored green within a 60 Hz frame, yellow within two and red past
+that, and the GPU time of the frame is a narrower blue bar in front of it, so a GPU
+bound frame shows blue above the CPU bar.  Gray lines mark 16.7 and 33.3 ms and
+colored lines the 50th (cyan), 95th (yellow) and 99th (magenta) percentile of the CPU
+frame times.
+
+The graph is rebuilt every frame as plain (x, y, r, g, b) triangles in one streamed
+buffer and drawn with one call using the 2D pass-through shader.
+
+*/
+
+class ProfileOverlay
+{
+private:
+    GLuint vao;                   ///< Vertex Array Object ID.
+    GLuint vbo;                   ///< Interleaved position and color buffer ID.
+    std::vector<GLfloat> verts;   ///< Triangles of the graph being built.
+
+    void addRect(GLfloat x0, GLfloat y0, GLfloat x1, GLfloat y1, GLfloat r, GLfloat g, GLfloat b);
+
+public:
+    ProfileOverlay();
+    ~ProfileOverlay();
+
+    void draw(Profiler& profiler);
+};
+
+#endif // PROFILEOVERLAY_H_INCLUDED
@@ -0,0 +1,487 @@
+#include "Profiler.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include <algorithm>
+#include <iostream>
+
+/**
+\file Profiler.cpp
+\brief Frame time profiler with scoped CPU and GPU timers and Chrome trace output.
+
+The CPU side only reads a steady clock and writes into fixed rings, so a scope costs
+two clock reads whether or not anyone looks at the results.  The GPU side issues two
+glQueryCounter calls per scope into a fixed set of query objects per frame slot and
+polls the last query of a slot before reading it, so it never stalls the pipeline.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor, no frames and no GPU timers until initGPU.
+
+*/
+
+Profiler::Profiler()
+{
+    origin = std::chrono::steady_clock::now();
+    frameNumber = 0;
+    frameStart = -1;
+    eventCount = 0;
+    gpuTimers = false;
+    gpuSlot = 0;
+    gpuOffset = 0;
+
+    for (int i = 0; i < PROFILER_HISTORY; i++)
+    {
+        memset(&frames[i], 0, sizeof(ProfileFrame));
+        frames[i].gpuMs = -1;
+    }
+    for (int i = 0; i < PROFILER_GPU_FRAMES; i++)
+    {
+        gpuFrames[i].frame = -1;
+        gpuFrames[i].scopeCount = 0;
+    }
+
+    frameZone = zone("frame");
+}
+
+/**
+\brief Destructor
+
+The query objects are freed by releaseGPU, the context is gone by the time this runs.
+
+*/
+
+Profiler::~Profiler() {}
+
+/**
+\brief Returns the profiler.
+
+*/
+
+Profiler& Profiler::get()
+{
+    static Profiler profiler;
+    return profiler;
+}
+
+/**
+\brief Generates the timestamp queries, once an OpenGL context is current.
+
+Without timer queries only the CPU is timed.
+
+*/
+
+void Profiler::initGPU()
+{
+    if (gpuTimers || !(GLEW_VERSION_3_3 || GLEW_ARB_timer_query))
+        return;
+
+    for (int i = 0; i < PROFILER_GPU_FRAMES; i++)
+    {
+        GPUFrame& g = gpuFrames[i];
+        glGenQueries(2, g.frameQuery);
+        for (int s = 0; s < PROFILER_GPU_SCOPES; s++)
+            glGenQueries(2, g.scopes[s].query);
+        g.frame = -1;
+        g.scopeCount = 0;
+    }
+
+    gpuTimers = true;
+    calibrateGPU();
+}
+
+/**
+\brief Deletes the timestamp queries, before the context is destroyed.
+
+*/
+
+void Profiler::releaseGPU()
+{
+    if (!gpuTimers)
+        return;
+
+    for (int i = 0; i < PROFILER_GPU_FRAMES; i++)
+    {
+        GPUFrame& g = gpuFrames[i];
+        glDeleteQueries(2, g.frameQuery);
+        for (int s = 0; s < PROFILER_GPU_SCOPES; s++)
+            glDeleteQueries(2, g.scopes[s].query);
+        g.frame = -1;
+    }
+    gpuTimers = false;
+}
+
+/**
+\brief Works out the difference between the CPU and GPU clocks.
+
+*/
+
+void Profiler::calibrateGPU()
+{
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    gpuOffset = now() - gpuNow / 1000.0;
+}
+
+/**
+\brief Current time in microseconds since the profiler was made.
+
+*/
+
+double Profiler::now()
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - origin).count();
+}
+
+/**
+\brief Returns true if a scope begun now would be timed: a frame is open and this is
+the thread that opened it.
+
+*/
+
+bool Profiler::isTimed()
+{
+    return frameStart >= 0 && std::this_thread::get_id() == renderThread;
+}
+
+/**
+\brief Starts a frame on the calling thread, which becomes the one timed.
+
+Reads back whatever GPU timestamps have come in and takes the GPU slot of the frame,
+dropping the frame that held it if its timestamps never came back.
+
+*/
+
+void Profiler::beginFrame()
+{
+    renderThread = std::this_thread::get_id();
+
+    ProfileFrame& f = frames[frameNumber % PROFILER_HISTORY];
+    memset(&f, 0, sizeof(ProfileFrame));
+    f.gpuMs = -1;
+
+    if (gpuTimers)
+    {
+        collectGPU();
+
+        gpuSlot = frameNumber % PROFILER_GPU_FRAMES;
+        GPUFrame& g = gpuFrames[gpuSlot];
+        g.frame = frameNumber;
+        g.scopeCount = 0;
+        glQueryCounter(g.frameQuery[0], GL_TIMESTAMP);
+
+        // The two clocks drift apart slowly, once a second keeps the trace lined up.
+        if (frameNumber % 60 == 0)
+            calibrateGPU();
+    }
+
+    frameStart = now();
+}
+
+/**
+\brief Ends the frame, after the buffer swap.
+
+*/
+
+void Profiler::endFrame()
+{
+    if (!isTimed())
+        return;
+
+    double t = now();
+    ProfileFrame& f = frames[frameNumber % PROFILER_HISTORY];
+    f.cpuMs = (t - frameStart) / 1000;
+    f.zoneMs[frameZone] = f.cpuMs;
+    addEvent(frameZone, false, frameStart, t - frameStart);
+
+    if (gpuTimers)
+        glQueryCounter(gpuFrames[gpuSlot].frameQuery[1], GL_TIMESTAMP);
+
+    frameNumber++;
+    frameStart = -1;
+}
+
+/**
+\brief Returns the ID of a zone, adding it the first time its name is seen.
+
+\param name --- Name shown on the trace.
+
+\return The zone, or -1 if there are already PROFILER_ZONES, in which case it is not timed.
+
+*/
+
+int Profiler::zone(const char* name)
+{
+    for (size_t i = 0; i < zoneNames.size(); i++)
+    {
+        if (zoneNames[i] == name)
+            return i;
+    }
+
+    if ((int)zoneNames.size() >= PROFILER_ZONES)
+    {
+        std::cerr << "Profiler zone " << name << " not timed, too many zones." << std::endl;
+        return -1;
+    }
+
+    zoneNames.push_back(name);
+    return zoneNames.size() - 1;
+}
+
+/**
+\brief Returns the number of zones.
+
+*/
+
+int Profiler::zoneCount()
+{
+    return zoneNames.size();
+}
+
+/**
+\brief Returns the name of a zone.
+
+\param id --- The zone.
+
+*/
+
+const std::string& Profiler::zoneName(int id)
+{
+    return zoneNames[id];
+}
+
+/**
+\brief Records one timed scope in the trace ring.
+
+\param zone --- Zone ID.
+\param gpu --- True if timed on the GPU.
+\param start --- Start in microseconds, on the CPU clock.
+\param duration --- Length in microseconds.
+
+*/
+
+void Profiler::addEvent(int zone, bool gpu, double start, double duration)
+{
+    ProfileEvent& e = events[eventCount % PROFILER_EVENTS];
+    e.zone = zone;
+    e.gpu = gpu;
+    e.start = start;
+    e.duration = duration;
+    eventCount++;
+}
+
+/**
+\brief Ends a CPU scope, adding it to the frame's totals and the trace.
+
+\param zone --- Zone ID.
+\param start --- Start from now().
+
+*/
+
+void Profiler::endScope(int zone, double start)
+{
+    double t = now();
+    frames[frameNumber % PROFILER_HISTORY].zoneMs[zone] += (t - start) / 1000;
+    addEvent(zone, false, start, t - start);
+}
+
+/**
+\brief Issues the starting timestamp of a GPU scope.
+
+\param zone --- Zone ID.
+
+\return The scope to pass to endGPU, or -1 if it is not timed on the GPU.
+
+*/
+
+int Profiler::beginGPU(int zone)
+{
+    GPUFrame& g = gpuFrames[gpuSlot];
+    if (!gpuTimers || g.scopeCount >= PROFILER_GPU_SCOPES)
+        return -1;
+
+    int s = g.scopeCount++;
+    g.scopes[s].zone = zone;
+    glQueryCounter(g.scopes[s].query[0], GL_TIMESTAMP);
+    return s;
+}
+
+/**
+\brief Issues the ending timestamp of a GPU scope.
+
+\param scope --- From beginGPU.
+
+*/
+
+void Profiler::endGPU(int scope)
+{
+    glQueryCounter(gpuFrames[gpuSlot].scopes[scope].query[1], GL_TIMESTAMP);
+}
+
+/**
+\brief Reads the timestamps of every frame slot whose frame has finished on the GPU.
+
+Timestamps complete in order, so once the frame's last one is available the rest are
+too.  A slot still waiting when it is next needed is dropped.
+
+*/
+
+void Profiler::collectGPU()
+{
+    for (int i = 0; i < PROFILER_GPU_FRAMES; i++)
+    {
+        GPUFrame& g = gpuFrames[i];
+        if (g.frame < 0)
+            continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(g.frameQuery[1], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+        {
+            if (i == frameNumber % PROFILER_GPU_FRAMES)
+                g.frame = -1;
+            continue;
+        }
+
+        bool kept = frameNumber - g.frame < PROFILER_HISTORY;
+        ProfileFrame& f = frames[g.frame % PROFILER_HISTORY];
+
+        GLuint64 t0 = 0;
+        GLuint64 t1 = 0;
+        glGetQueryObjectui64v(g.frameQuery[0], GL_QUERY_RESULT, &t0);
+        glGetQueryObjectui64v(g.frameQuery[1], GL_QUERY_RESULT, &t1);
+        if (kept)
+            f.gpuMs = (t1 - t0) / 1.0e6;
+
+        for (int s = 0; s < g.scopeCount; s++)
+        {
+            glGetQueryObjectui64v(g.scopes[s].query[0], GL_QUERY_RESULT, &t0);
+            glGetQueryObjectui64v(g.scopes[s].query[1], GL_QUERY_RESULT, &t1);
+            if (kept)
+                f.zoneGpuMs[g.scopes[s].zone] += (t1 - t0) / 1.0e6;
+            addEvent(g.scopes[s].zone, true, t0 / 1000.0 + gpuOffset, (t1 - t0) / 1000.0);
+        }
+
+        g.frame = -1;
+    }
+}
+
+/**
+\brief Returns the number of frames ended.
+
+*/
+
+long long Profiler::getFrameCount()
+{
+    return frameNumber;
+}
+
+/**
+\brief Returns the totals of an ended frame.
+
+\param back --- 0 for the last frame ended, up to PROFILER_HISTORY - 1 and less than
+getFrameCount.
+
+*/
+
+const ProfileFrame& Profiler::getFrame(int back)
+{
+    return frames[(frameNumber - 1 - back) % PROFILER_HISTORY];
+}
+
+/**
+\brief Returns a percentile of the CPU frame times kept.
+
+\param p --- Percentile, 0 to 100.
+
+\return The frame time in milliseconds, 0 before the first frame has ended.
+
+*/
+
+double Profiler::frameTimePercentile(double p)
+{
+    int n = frameNumber < PROFILER_HISTORY ? frameNumber : PROFILER_HISTORY;
+    if (n == 0)
+        return 0;
+
+    double ms[PROFILER_HISTORY];
+    for (int i = 0; i < n; i++)
+        ms[i] = getFrame(i).cpuMs;
+
+    int k = (int)(p / 100 * (n - 1) + 0.5);
+    std::nth_element(ms, ms + k, ms + n);
+    return ms[k];
+}
+
+/**
+\brief Returns the average GPU frame time of the frames kept whose timestamps came back.
+
+\return Milliseconds, 0 if there are none.
+
+*/
+
+double Profiler::averageGPUFrameTime()
+{
+    int n = frameNumber < PROFILER_HISTORY ? frameNumber : PROFILER_HISTORY;
+    double sum = 0;
+    int count = 0;
+    for (int i = 0; i < n; i++)
+    {
+        if (getFrame(i).gpuMs >= 0)
+        {
+            sum += getFrame(i).gpuMs;
+            count++;
+        }
+    }
+    return count > 0 ? sum / count : 0;
+}
+
+/**
+\brief Writes the scopes kept to a Chrome trace file.
+
+The render thread and the GPU are shown as two threads of one process, with times in
+microseconds from when the profiler was made.  GPU scopes come in a few frames late,
+so the last frames may have no GPU row yet.
+
+\param filename --- File to write.
+
+\return True if it was written.
+
+*/
+
+bool Profiler::writeTrace(const std::string& filename)
+{
+    FILE* out = fopen(filename.c_str(), "w");
+    if (!out)
+    {
+        std::cerr << "Could not write the trace " << filename << std::endl;
+        return false;
+    }
+
+    fprintf(out, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(out, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"args\":{\"name\":\"OpenHouse\"}},\n");
+    fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,\"args\":{\"name\":\"Render thread\"}},\n");
+    fprintf(out, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":2,\"args\":{\"name\":\"GPU\"}}");
+
+    long long first = eventCount > PROFILER_EVENTS ? eventCount - PROFILER_EVENTS : 0;
+    for (long long i = first; i < eventCount; i++)
+    {
+        const ProfileEvent& e = events[i % PROFILER_EVENTS];
+        fprintf(out, ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%d}",
+                zoneNames[e.zone].c_str(), e.gpu ? "gpu" : "cpu", e.start, e.duration, e.gpu ? 2 : 1);
+    }
+
+    fprintf(out, "\n]}\n");
+    bool ok = !ferror(out);
+    fclose(out);
+
+    if (!ok)
+        std::cerr << "Could not write the trace " << filename << std::endl;
+    return ok;
+}
@@ -0,0 +1,215 @@
+#ifndef PROFILER_H_INCLUDED
+#define PROFILER_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+\file Profiler.h
+
+\brief Header file for Profiler.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define PROFILER_HISTORY 240      ///< Frames kept for the overlay and percentiles, 4 seconds at 60.
+#define PROFILER_ZONES 32         ///< Most named zones.
+#define PROFILER_EVENTS 16384     ///< Timed scopes kept for the trace file, CPU and GPU together.
+#define PROFILER_GPU_FRAMES 4     ///< Frames a GPU timestamp is given to finish before it is dropped.
+#define PROFILER_GPU_SCOPES 32    ///< Most GPU scopes timed in one frame.
+
+/**
+\brief One timed scope, kept for the trace file.
+
+*/
+
+struct ProfileEvent
+{
+    int zone;          ///< Zone ID.
+    bool gpu;          ///< True if timed on the GPU.
+    double start;      ///< Start, microseconds since the profiler was made.
+    double duration;   ///< Length in microseconds.
+};
+
+/**
+\brief Totals of one frame.
+
+*/
+
+struct ProfileFrame
+{
+    double cpuMs;                  ///< Time from beginFrame to endFrame, 0 if not yet ended.
+    double gpuMs;                  ///< GPU time of the frame, -1 until the timestamps come back.
+    float zoneMs[PROFILER_ZONES];  ///< CPU time of each zone in the frame.
+    float zoneGpuMs[PROFILER_ZONES];   ///< GPU time of each zone in the frame, 0 until it comes back.
+};
+
+/**
+\class Profiler
+
+\brief Frame time profiler of the render thread, scoped CPU timers and GPU timestamps
+over the main phases of a frame.
+
+A scope is timed by PROFILE_SCOPE("name") or, for one that issues draw calls,
+PROFILE_GPU_SCOPE("name"), which also brackets it with GL_TIMESTAMP queries.
+Timestamps are used rather than GL_TIME_ELAPSED so scopes can nest and so they do not
+clash with the frame query of RenderScaler.  The results are read back
+PROFILER_GPU_FRAMES frames late without waiting on the GPU, and the scope is dropped
+if they have not come back by then.
+
+Each frame's totals go into a ring of the last PROFILER_HISTORY frames, read by
+ProfileOverlay and the percentiles, and each scope into a ring of the last
+PROFILER_EVENTS, written out by writeTrace as a Chrome trace (chrome://tracing or
+Perfetto).  Only the thread that calls beginFrame is timed, a scope on any other
+thread, such as the simulation thread, is ignored.  There is one profiler, got from
+get().
+
+*/
+
+class Profiler
+{
+private:
+    /**
+    \brief A GPU scope waiting for its timestamps.
+    */
+    struct GPUScope
+    {
+        int zone;         ///< Zone ID.
+        GLuint query[2];  ///< Begin and end timestamp queries.
+    };
+
+    /**
+    \brief GPU work of one frame waiting for its timestamps.
+    */
+    struct GPUFrame
+    {
+        long long frame;                        ///< Frame number, -1 if the slot is free.
+        GLuint frameQuery[2];                   ///< Timestamps at the start and end of the frame.
+        GPUScope scopes[PROFILER_GPU_SCOPES];   ///< Scopes begun this frame.
+        int scopeCount;                         ///< Number of scopes used.
+    };
+
+    std::chrono::steady_clock::time_point origin;   ///< Time zero of every event.
+    std::thread::id renderThread;   ///< Thread being timed, set by beginFrame.
+
+    std::vector<std::string> zoneNames;   ///< Name of each zone, by ID.
+    int frameZone;                        ///< Zone of the whole frame.
+
+    ProfileFrame frames[PROFILER_HISTORY];   ///< Ring of frame totals.
+    long long frameNumber;                   ///< Frames begun so far.
+    double frameStart;                       ///< Start of the current frame, microseconds, -1 between frames.
+
+    ProfileEvent events[PROFILER_EVENTS];    ///< Ring of scopes for the trace.
+    long long eventCount;                    ///< Scopes recorded so far.
+
+    bool gpuTimers;      ///< True if GL_TIMESTAMP queries are available and initGPU was called.
+    GPUFrame gpuFrames[PROFILER_GPU_FRAMES];   ///< Frames waiting for their timestamps.
+    int gpuSlot;         ///< Slot of the current frame.
+    double gpuOffset;    ///< CPU minus GPU clock, microseconds, to place GPU scopes on the trace.
+
+    Profiler();
+    Profiler(const Profiler&);
+    Profiler& operator=(const Profiler&);
+
+    void addEvent(int zone, bool gpu, double start, double duration);
+    void collectGPU();
+    void calibrateGPU();
+
+public:
+    ~Profiler();
+
+    static Profiler& get();
+
+    void initGPU();
+    void releaseGPU();
+
+    void beginFrame();
+    void endFrame();
+
+    int zone(const char* name);
+    int zoneCount();
+    const std::string& zoneName(int id);
+
+    double now();
+    bool isTimed();
+    void endScope(int zone, double start);
+    int beginGPU(int zone);
+    void endGPU(int scope);
+
+    long long getFrameCount();
+    const ProfileFrame& getFrame(int back);
+    double frameTimePercentile(double p);
+    double averageGPUFrameTime();
+
+    bool writeTrace(const std::string& filename);
+};
+
+/**
+\class ProfileScope
+
+\brief Times the block it is declared in, made by the PROFILE_SCOPE macros.
+
+*/
+
+class ProfileScope
+{
+private:
+    int zone;        ///< Zone ID, -1 when not timed.
+    double start;    ///< Start, microseconds.
+    int gpuScope;    ///< GPU scope, -1 for none.
+
+public:
+    /**
+    \brief Starts timing a zone.
+
+    \param zoneID --- Zone from Profiler::zone.
+    \param gpu --- True to time it on the GPU as well.
+    */
+    ProfileScope(int zoneID, bool gpu)
+    {
+        Profiler& p = Profiler::get();
+        zone = p.isTimed() ? zoneID : -1;
+        gpuScope = (zone >= 0 && gpu) ? p.beginGPU(zone) : -1;
+        start = zone >= 0 ? p.now() : 0;
+    }
+
+    /**
+    \brief Ends timing the zone.
+    */
+    ~ProfileScope()
+    {
+        if (zone < 0)
+            return;
+
+        Profiler& p = Profiler::get();
+        p.endScope(zone, start);
+        if (gpuScope >= 0)
+            p.endGPU(gpuScope);
+    }
+};
+
+#define PROFILE_JOIN2(a, b) a##b
+#define PROFILE_JOIN(a, b) PROFILE_JOIN2(a, b)
+
+/// Times the rest of the enclosing block on the CPU under the given name.
+#define PROFILE_SCOPE(name) \
+    static const int PROFILE_JOIN(profileZone, __LINE__) = Profiler::get().zone(name); \
+    ProfileScope PROFILE_JOIN(profileScope, __LINE__)(PROFILE_JOIN(profileZone, __LINE__), false)
+
+/// Times the rest of the enclosing block on the CPU and the GPU under the given name.
+#define PROFILE_GPU_SCOPE(name) \
+    static const int PROFILE_JOIN(profileZone, __LINE__) = Profiler::get().zone(name); \
+    ProfileScope PROFILE_JOIN(profileScope, __LINE__)(PROFILE_JOIN(profileZone, __LINE__), true)
+
+#endif // PROFILER_H_INCLUDED
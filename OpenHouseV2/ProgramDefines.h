@@ -16,8 +16,17 @@ The file is simply for convenience so that multiple headers do not need to redef
 
 // SetVS sets the Vertical Sync for SFML.  When true, the frame rate will be very close to the
 // refresh rate of the machine.  When false, the frame rate will run at maximum speed.
+// The game speed does not depend on it, see SimTickRate.
 #define SetVS true
 
+// SimTickRate is the number of fixed game logic steps per second.  The per step amounts in
+// FighterCore::preformActions and the arena and menu motion were tuned at 60 frames per second.
+#define SimTickRate 60
+
+// CrowdSize is the number of animated characters watching from the back of the bath house
+// when the crowd is turned on with F5.
+#define CrowdSize 36
+
 #define BUFFER_OFFSET(x) ((const void*) (x))
 #define PI 3.14159265358979323846264338328
 #define PI_DIV_180 0.0174532925199432957692369076849
@@ -0,0 +1,442 @@
+#include "RenderScaler.h"
+
+#include <math.h>
+
+/**
+\file RenderScaler.cpp
+\brief Offscreen render target with dynamic resolution.
+
+The scene is drawn into a multisampled framebuffer, resolved into a single sample
+texture of the same size and then blitted, with linear filtering, onto the window.
+The attachments are allocated once at the window size times the maximum scale and
+the current scale only changes the viewport used inside them, so moving the scale
+never reallocates anything.
+
+The automatic controller treats GPU time as proportional to the number of pixels
+shaded, that is to scale squared, and moves the scale by sqrt(target / measured)
+with a dead band and a settling period so it does not oscillate.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor
+
+Generates the framebuffer, attachment and query IDs and loads the default settings,
+native scale, manual mode and a 60 FPS target.  Attachments are allocated on the
+first call to begin, once the window size is known.
+
+*/
+
+RenderScaler::RenderScaler()
+{
+    windowW = windowH = 0;
+    targetW = targetH = 0;
+    allocW = allocH = 0;
+
+    scale = 1;
+    minScale = 0.5;
+    maxScale = 1;
+    autoScale = false;
+    enabled = true;
+
+    targetMs = 1000.0 / 60.0;
+    gpuMs = 0;
+    settleFrames = 0;
+    queryIndex = 0;
+
+    glGenFramebuffers(1, &fbo);
+    glGenFramebuffers(1, &resolveFbo);
+    glGenRenderbuffers(1, &colorRB);
+    glGenRenderbuffers(1, &depthRB);
+    glGenTextures(1, &colorTex);
+
+    GLint s = 0;
+    glGetIntegerv(GL_SAMPLES, &s);
+    samples = s;
+
+#ifdef __APPLE__
+    timerQueries = true;
+#else
+    timerQueries = GLEW_VERSION_3_3 || GLEW_ARB_timer_query;
+#endif // __APPLE__
+
+    glGenQueries(RS_QUERY_FRAMES, queries);
+    for (int i = 0; i < RS_QUERY_FRAMES; i++)
+        queryPending[i] = false;
+    queryActive = false;
+}
+
+/**
+\brief Destructor
+
+Clears the framebuffers, attachments and queries.
+
+*/
+
+RenderScaler::~RenderScaler()
+{
+    glDeleteQueries(RS_QUERY_FRAMES, queries);
+    glDeleteTextures(1, &colorTex);
+    glDeleteRenderbuffers(1, &depthRB);
+    glDeleteRenderbuffers(1, &colorRB);
+    glDeleteFramebuffers(1, &resolveFbo);
+    glDeleteFramebuffers(1, &fbo);
+}
+
+/**
+\brief Allocates the attachments at the window size times the maximum scale.
+
+The scene framebuffer uses the same number of samples as the window so that
+rendering at scale 1 matches rendering straight to the window.
+
+*/
+
+void RenderScaler::allocateTarget()
+{
+    allocW = (GLuint)ceil(windowW * maxScale);
+    allocH = (GLuint)ceil(windowH * maxScale);
+    if (allocW < 1)
+        allocW = 1;
+    if (allocH < 1)
+        allocH = 1;
+
+    glBindTexture(GL_TEXTURE_2D, colorTex);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, allocW, allocH, 0, GL_RGBA, GL_UNSIGNED_BYTE, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glBindTexture(GL_TEXTURE_2D, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, resolveFbo);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTex, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    if (samples > 1)
+    {
+        glBindRenderbuffer(GL_RENDERBUFFER, colorRB);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_RGBA8, allocW, allocH);
+        glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, colorRB);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRB);
+        glRenderbufferStorageMultisample(GL_RENDERBUFFER, samples, GL_DEPTH24_STENCIL8, allocW, allocH);
+    }
+    else
+    {
+        glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, colorTex, 0);
+
+        glBindRenderbuffer(GL_RENDERBUFFER, depthRB);
+        glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, allocW, allocH);
+    }
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depthRB);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+    {
+        std::cerr << "Offscreen framebuffer incomplete, rendering directly to the window." << std::endl;
+        enabled = false;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+/**
+\brief Starts a frame, binding the offscreen target and setting the scaled viewport.
+
+\param w --- Current window width in pixels.
+\param h --- Current window height in pixels.
+
+If the offscreen path is disabled the window framebuffer is bound at full size
+instead, so callers do not need to check.
+
+*/
+
+void RenderScaler::begin(GLuint w, GLuint h)
+{
+    if (w != windowW || h != windowH)
+    {
+        windowW = w;
+        windowH = h;
+        if (enabled)
+            allocateTarget();
+    }
+
+    if (!enabled)
+    {
+        targetW = windowW;
+        targetH = windowH;
+        glBindFramebuffer(GL_FRAMEBUFFER, 0);
+        glViewport(0, 0, targetW, targetH);
+        return;
+    }
+
+    targetW = (GLuint)(windowW * scale + 0.5f);
+    targetH = (GLuint)(windowH * scale + 0.5f);
+    if (targetW < 1)
+        targetW = 1;
+    if (targetH < 1)
+        targetH = 1;
+    if (targetW > allocW)
+        targetW = allocW;
+    if (targetH > allocH)
+        targetH = allocH;
+
+    if (timerQueries)
+    {
+        collectQueries();
+
+        if (!queryPending[queryIndex])
+        {
+            glBeginQuery(GL_TIME_ELAPSED, queries[queryIndex]);
+            queryActive = true;
+        }
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, fbo);
+    glViewport(0, 0, targetW, targetH);
+}
+
+/**
+\brief Ends a frame, resolving and upscaling the offscreen image onto the window.
+
+Leaves the window framebuffer bound with a full window viewport, ready for the
+buffer swap and for anything that reads back the window.
+
+*/
+
+void RenderScaler::end()
+{
+    if (!enabled)
+        return;
+
+    if (samples > 1)
+    {
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, resolveFbo);
+        glBlitFramebuffer(0, 0, targetW, targetH, 0, 0, targetW, targetH, GL_COLOR_BUFFER_BIT, GL_NEAREST);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, resolveFbo);
+    }
+    else
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, 0);
+    glBlitFramebuffer(0, 0, targetW, targetH, 0, 0, windowW, windowH, GL_COLOR_BUFFER_BIT,
+                      (targetW == windowW && targetH == windowH) ? GL_NEAREST : GL_LINEAR);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glViewport(0, 0, windowW, windowH);
+
+    if (queryActive)
+    {
+        glEndQuery(GL_TIME_ELAPSED);
+        queryPending[queryIndex] = true;
+        queryActive = false;
+    }
+    queryIndex = (queryIndex + 1) % RS_QUERY_FRAMES;
+}
+
+/**
+\brief Reads every finished timer query in the ring without blocking and feeds the
+results to the controller.
+
+*/
+
+void RenderScaler::collectQueries()
+{
+    for (int i = 1; i <= RS_QUERY_FRAMES; i++)
+    {
+        int q = (queryIndex + i) % RS_QUERY_FRAMES;
+        if (!queryPending[q])
+            continue;
+
+        GLint available = 0;
+        glGetQueryObjectiv(queries[q], GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            continue;
+
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(queries[q], GL_QUERY_RESULT, &ns);
+        queryPending[q] = false;
+        updateScale(ns / 1.0e6);
+    }
+}
+
+/**
+\brief Smooths a GPU frame time sample and, in automatic mode, moves the scale
+toward the target frame time.
+
+\param ms --- Measured GPU time of one frame in milliseconds.
+
+*/
+
+void RenderScaler::updateScale(double ms)
+{
+    if (gpuMs == 0)
+        gpuMs = ms;
+    else
+        gpuMs = 0.9 * gpuMs + 0.1 * ms;
+
+    if (!autoScale)
+        return;
+
+    if (settleFrames > 0)
+    {
+        settleFrames--;
+        return;
+    }
+
+    double ratio = targetMs / gpuMs;
+
+    // Dead band, drop quickly when over budget but only climb back with clear headroom.
+    if (ratio > 0.95 && ratio < 1.2)
+        return;
+
+    double s = scale * sqrt(ratio);
+    if (s > scale + 0.1)
+        s = scale + 0.1;
+    if (s < scale - 0.1)
+        s = scale - 0.1;
+
+    setScale(s);
+
+    // The ring holds results a few frames old, wait until they reflect the new scale.
+    settleFrames = 2 * RS_QUERY_FRAMES;
+}
+
+/**
+\brief Turns the offscreen path on or off.
+
+\param e --- True to render offscreen, false to render straight to the window.
+
+*/
+
+void RenderScaler::setEnabled(bool e)
+{
+    enabled = e;
+    if (enabled && windowW > 0)
+        allocateTarget();
+}
+
+/**
+\brief Returns true if the offscreen path is on.
+
+*/
+
+bool RenderScaler::isEnabled()
+{
+    return enabled;
+}
+
+/**
+\brief Sets the internal resolution scale, clamped to the scale range.
+
+\param s --- New scale, 1 renders at the window resolution.
+
+*/
+
+void RenderScaler::setScale(GLfloat s)
+{
+    if (s < minScale)
+        s = minScale;
+    if (s > maxScale)
+        s = maxScale;
+
+    // Snap to 1/32 steps so small controller changes do not shimmer.
+    scale = floor(s * 32 + 0.5f) / 32;
+}
+
+/**
+\brief Returns the internal resolution scale.
+
+*/
+
+GLfloat RenderScaler::getScale()
+{
+    return scale;
+}
+
+/**
+\brief Sets the range of scales the controller and setScale may use.
+
+\param lo --- Minimum scale.
+\param hi --- Maximum scale, values above 1 supersample.
+
+*/
+
+void RenderScaler::setScaleRange(GLfloat lo, GLfloat hi)
+{
+    minScale = lo;
+    maxScale = hi;
+    if (enabled && windowW > 0)
+        allocateTarget();
+    setScale(scale);
+}
+
+/**
+\brief Turns the automatic scale controller on or off.
+
+\param a --- True for automatic scale.
+
+*/
+
+void RenderScaler::setAutoScale(bool a)
+{
+    autoScale = a;
+    settleFrames = 0;
+}
+
+/**
+\brief Returns true if the automatic scale controller is on.
+
+*/
+
+bool RenderScaler::isAutoScale()
+{
+    return autoScale;
+}
+
+/**
+\brief Sets the GPU frame time the controller tries to hold.
+
+\param ms --- Target frame time in milliseconds.
+
+*/
+
+void RenderScaler::setTargetFrameTime(double ms)
+{
+    targetMs = ms;
+}
+
+/**
+\brief Returns the smoothed GPU frame time in milliseconds, 0 if no timer queries.
+
+*/
+
+double RenderScaler::getGPUFrameTime()
+{
+    return gpuMs;
+}
+
+/**
+\brief Returns the width of the current render target in pixels.
+
+*/
+
+GLuint RenderScaler::getWidth()
+{
+    return targetW;
+}
+
+/**
+\brief Returns the height of the current render target in pixels.
+
+*/
+
+GLuint RenderScaler::getHeight()
+{
+    return targetH;
+}
@@ -0,0 +1,99 @@
+#ifndef RENDERSCALER_H_INCLUDED
+#define RENDERSCALER_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <iostream>
+
+/**
+\file RenderScaler.h
+
+\brief Header file for RenderScaler.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\class RenderScaler
+
+\brief Offscreen render target with a configurable internal resolution scale.
+
+The scene is rendered into a framebuffer object whose size is the window size times
+the current scale and then upscaled onto the window with a linear blit.  In automatic
+mode each frame is wrapped in a GL_TIME_ELAPSED query and the scale is adjusted to
+hold a target GPU frame time.
+
+Query results are read back RS_QUERY_FRAMES frames late so the controller never stalls
+the pipeline waiting on the GPU.  Everything used here is core OpenGL 3.3, so the same
+path runs on Mesa llvmpipe.
+
+*/
+
+#define RS_QUERY_FRAMES 4
+
+class RenderScaler
+{
+private:
+    GLuint fbo;           ///< Offscreen framebuffer object ID the scene is drawn into.
+    GLuint resolveFbo;    ///< Single sample framebuffer the multisampled image is resolved into.
+    GLuint colorRB;       ///< Multisampled color renderbuffer ID.
+    GLuint depthRB;       ///< Depth/stencil renderbuffer ID.
+    GLuint colorTex;      ///< Single sample color texture ID.
+    GLint samples;        ///< Number of samples, taken from the window's context.
+
+    GLuint windowW;       ///< Width of the window being presented to.
+    GLuint windowH;       ///< Height of the window being presented to.
+    GLuint targetW;       ///< Width of the offscreen target.
+    GLuint targetH;       ///< Height of the offscreen target.
+    GLuint allocW;        ///< Width the attachments are currently allocated at.
+    GLuint allocH;        ///< Height the attachments are currently allocated at.
+
+    GLfloat scale;        ///< Internal resolution scale, 1 is native.
+    GLfloat minScale;     ///< Lowest scale the controller may choose.
+    GLfloat maxScale;     ///< Highest scale the controller may choose.
+    bool autoScale;       ///< Automatic scale controller on/off.
+    bool enabled;         ///< Offscreen path on/off, off renders straight to the window.
+    bool timerQueries;    ///< True if GL_TIME_ELAPSED queries are available.
+
+    GLuint queries[RS_QUERY_FRAMES];  ///< Ring of timer query objects.
+    bool queryPending[RS_QUERY_FRAMES];  ///< True while a query in the ring has no result yet.
+    int queryIndex;       ///< Slot of the query for the current frame.
+    bool queryActive;     ///< True between glBeginQuery and glEndQuery.
+
+    double targetMs;      ///< Target GPU frame time in milliseconds.
+    double gpuMs;         ///< Smoothed measured GPU frame time in milliseconds.
+    int settleFrames;     ///< Frames left before the controller may change the scale again.
+
+    void allocateTarget();
+    void collectQueries();
+    void updateScale(double ms);
+
+public:
+    RenderScaler();
+    ~RenderScaler();
+
+    void begin(GLuint w, GLuint h);
+    void end();
+
+    void setEnabled(bool e);
+    bool isEnabled();
+    void setScale(GLfloat s);
+    GLfloat getScale();
+    void setScaleRange(GLfloat lo, GLfloat hi);
+    void setAutoScale(bool a);
+    bool isAutoScale();
+    void setTargetFrameTime(double ms);
+    double getGPUFrameTime();
+
+    GLuint getWidth();
+    GLuint getHeight();
+};
+
+#endif // RENDERSCALER_H_INCLUDED
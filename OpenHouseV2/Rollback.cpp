@@ -0,0 +1,428 @@
+#include "Rollback.h"
+
+#include <iostream>
+#include <chrono>
+
+/**
+\file Rollback.cpp
+\brief Rollback of the game logic for two player matches with delayed remote input.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor.
+
+\param matchSim --- Simulation to run, set up for the match before start is called.
+\param player --- Player this side controls, 0 or 1.
+
+*/
+
+RollbackSession::RollbackSession(MatchSim* matchSim, int player)
+{
+    sim = matchSim;
+    localPlayer = player;
+    remotePlayer = 1 - player;
+    inputDelay = 0;
+    maxPrediction = ROLLBACK_WINDOW;
+    start();
+}
+
+/**
+\brief Sets how many ticks local input is held back before it is applied, takes effect
+on the next start.
+
+\param ticks --- Delay in ticks, 0 to ROLLBACK_MAX_DELAY.
+
+*/
+
+void RollbackSession::setInputDelay(int ticks)
+{
+    if (ticks < 0)
+        ticks = 0;
+    if (ticks > ROLLBACK_MAX_DELAY)
+        ticks = ROLLBACK_MAX_DELAY;
+    inputDelay = ticks;
+}
+
+/**
+\brief Sets the most ticks the session runs past the last confirmed remote input
+before it stalls.
+
+\param ticks --- 0 never predicts, up to ROLLBACK_WINDOW.
+
+*/
+
+void RollbackSession::setMaxPrediction(int ticks)
+{
+    if (ticks < 0)
+        ticks = 0;
+    if (ticks > ROLLBACK_WINDOW)
+        ticks = ROLLBACK_WINDOW;
+    maxPrediction = ticks;
+}
+
+/**
+\brief Returns the ticks local input is held back.
+
+*/
+
+int RollbackSession::getInputDelay()
+{
+    return inputDelay;
+}
+
+/**
+\brief Starts a session from the simulation's current state, both sides must start
+from the same state on the same tick.
+
+The ticks before the first delayed local input have no local input on either side.
+With no prediction the delay is at least one tick, otherwise neither side could run a
+tick before it had the other's input for it.
+
+*/
+
+void RollbackSession::start()
+{
+    for (int i = 0; i < ROLLBACK_INPUT_RING; i++)
+    {
+        inputTick[i][0] = -1;
+        inputTick[i][1] = -1;
+    }
+
+    pendingLocal.count = 0;
+    rollbackFrom = -1;
+    if (maxPrediction == 0 && inputDelay == 0)
+        inputDelay = 1;
+
+    // Both sides leave the ticks before their first delayed input empty.
+    long long first = sim->tickCount;
+    for (long long t = first; t < first + inputDelay; t++)
+    {
+        int slot = t & (ROLLBACK_INPUT_RING - 1);
+        for (int p = 0; p < 2; p++)
+        {
+            inputs[slot][p].count = 0;
+            inputTick[slot][p] = t;
+        }
+    }
+    remoteConfirmed = first + inputDelay;
+
+    rollbacks = 0;
+    resimulated = 0;
+    maxRollback = 0;
+    stalls = 0;
+    resimSeconds = 0;
+    frameRollback = 0;
+    frameResimSeconds = 0;
+}
+
+/**
+\brief Adds a local input for the next tick, plus the input delay.
+
+\param in --- The input, its player is set to the local player.
+
+\return False if the tick already has ROLLBACK_MAX_EVENTS inputs and this one was dropped.
+
+*/
+
+bool RollbackSession::addLocalInput(const SimInput& in)
+{
+    if (pendingLocal.count >= ROLLBACK_MAX_EVENTS)
+    {
+        std::cerr << "Too many inputs on one tick, input dropped." << std::endl;
+        return false;
+    }
+
+    SimInput& ev = pendingLocal.events[pendingLocal.count++];
+    ev = in;
+    ev.player = localPlayer;
+    return true;
+}
+
+/**
+\brief Adds the remote player's input for a tick, in any order and more than once.
+
+If the tick has already run on a prediction and the input has events, the next
+advance rolls back to it.
+
+\param tick --- Tick the input is for.
+\param in --- The remote player's input on that tick, possibly no events.
+
+\return False if the tick is too far ahead to hold.
+
+*/
+
+bool RollbackSession::addRemoteInput(long long tick, const TickInput& in)
+{
+    if (tick < remoteConfirmed)
+        return true;
+
+    // Input still needed by a pending rollback must not be overwritten.
+    long long oldest = remoteConfirmed;
+    if (rollbackFrom >= 0 && rollbackFrom < oldest)
+        oldest = rollbackFrom;
+    if (tick >= oldest + ROLLBACK_INPUT_RING)
+        return false;
+
+    int slot = tick & (ROLLBACK_INPUT_RING - 1);
+    if (inputTick[slot][remotePlayer] == tick)
+        return true;
+
+    TickInput& dst = inputs[slot][remotePlayer];
+    dst.count = in.count < ROLLBACK_MAX_EVENTS ? in.count : ROLLBACK_MAX_EVENTS;
+    for (int i = 0; i < dst.count; i++)
+    {
+        dst.events[i] = in.events[i];
+        dst.events[i].player = remotePlayer;
+    }
+    inputTick[slot][remotePlayer] = tick;
+
+    if (tick < sim->tickCount && dst.count > 0 && (rollbackFrom < 0 || tick < rollbackFrom))
+        rollbackFrom = tick;
+
+    while (inputTick[remoteConfirmed & (ROLLBACK_INPUT_RING - 1)][remotePlayer] == remoteConfirmed)
+        remoteConfirmed++;
+
+    return true;
+}
+
+/**
+\brief Returns the input of a player for a tick, or NULL if it is not known.
+
+*/
+
+const TickInput* RollbackSession::inputFor(long long tick, int player)
+{
+    int slot = tick & (ROLLBACK_INPUT_RING - 1);
+    if (inputTick[slot][player] != tick)
+        return NULL;
+    return &inputs[slot][player];
+}
+
+/**
+\brief Saves the state and runs one tick with the known input, player one's first.
+
+*/
+
+void RollbackSession::runTick()
+{
+    long long t = sim->tickCount;
+    sim->save(snapshots[t & (ROLLBACK_WINDOW - 1)]);
+
+    for (int p = 0; p < 2; p++)
+    {
+        const TickInput* in = inputFor(t, p);
+        if (!in)
+            continue;
+
+        for (int i = 0; i < in->count; i++)
+            sim->applyInput(in->events[i]);
+    }
+
+    sim->tick();
+}
+
+/**
+\brief Returns true if the session may run the next tick without going past the
+prediction limit.
+
+*/
+
+bool RollbackSession::canAdvance()
+{
+    return sim->tickCount - remoteConfirmed < maxPrediction;
+}
+
+/**
+\brief Rolls back if remote input came in for ticks already run, then runs the next
+tick with the local input given since the last call.
+
+\param tick --- Set to the tick the local input is for, the tick that was run plus the
+input delay.
+\param sent --- Set to the local input of that tick, to send to the other side.
+
+\return False if the session is stalled waiting for remote input, nothing was run.
+
+*/
+
+bool RollbackSession::advance(long long& tick, TickInput& sent)
+{
+    if (!canAdvance())
+    {
+        stalls++;
+        return false;
+    }
+
+    catchUp();
+
+    tick = sim->tickCount + inputDelay;
+    int slot = tick & (ROLLBACK_INPUT_RING - 1);
+    inputs[slot][localPlayer] = pendingLocal;
+    inputTick[slot][localPlayer] = tick;
+    pendingLocal.count = 0;
+
+    runTick();
+
+    sent = inputs[slot][localPlayer];
+    return true;
+}
+
+/**
+\brief Does a pending rollback now, restoring the first tick whose remote input
+changed and simulating back up to the present, without running a new tick.
+
+The fighters are quiet while the ticks run again.
+
+*/
+
+void RollbackSession::catchUp()
+{
+    if (rollbackFrom < 0)
+        return;
+
+    std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+    long long now = sim->tickCount;
+    sim->restore(snapshots[rollbackFrom & (ROLLBACK_WINDOW - 1)]);
+    sim->setQuiet(true);
+    while (sim->tickCount < now)
+        runTick();
+    sim->setQuiet(false);
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    resimSeconds += sec;
+    frameResimSeconds += sec;
+
+    int depth = (int)(now - rollbackFrom);
+    rollbacks++;
+    resimulated += depth;
+    if (depth > maxRollback)
+        maxRollback = depth;
+    if (depth > frameRollback)
+        frameRollback = depth;
+    rollbackFrom = -1;
+}
+
+/**
+\brief Rolls back a number of ticks and simulates them again with the same input,
+checking that the state comes out the same.
+
+Run after advance on every tick it forces the worst case cost of rollback and catches
+any game logic that is not deterministic.
+
+\param frames --- Ticks to roll back, at most ROLLBACK_WINDOW - 1.
+
+\return False if the state after simulating again differs.
+
+*/
+
+bool RollbackSession::syncTest(int frames)
+{
+    long long now = sim->tickCount;
+    if (frames > ROLLBACK_WINDOW - 1)
+        frames = ROLLBACK_WINDOW - 1;
+    // Skipped before enough ticks have run, and while a real rollback is pending since
+    // the input has changed and the state is meant to come out different.
+    if (frames <= 0 || rollbackFrom >= 0 || inputFor(now - frames, localPlayer) == NULL)
+        return true;
+
+    unsigned int before = sim->checksum();
+    sim->restore(snapshots[(now - frames) & (ROLLBACK_WINDOW - 1)]);
+    sim->setQuiet(true);
+    while (sim->tickCount < now)
+        runTick();
+    sim->setQuiet(false);
+
+    return sim->checksum() == before;
+}
+
+/**
+\brief Returns the next tick to run.
+
+*/
+
+long long RollbackSession::getTick()
+{
+    return sim->tickCount;
+}
+
+/**
+\brief Returns the first tick whose remote input has not arrived.
+
+*/
+
+long long RollbackSession::getConfirmedTick()
+{
+    return remoteConfirmed;
+}
+
+/**
+\brief Returns the number of rollbacks since start.
+
+*/
+
+long long RollbackSession::getRollbacks()
+{
+    return rollbacks;
+}
+
+/**
+\brief Returns the number of ticks simulated again in rollbacks since start.
+
+*/
+
+long long RollbackSession::getResimulated()
+{
+    return resimulated;
+}
+
+/**
+\brief Returns the deepest rollback since start, in ticks.
+
+*/
+
+int RollbackSession::getMaxRollback()
+{
+    return maxRollback;
+}
+
+/**
+\brief Returns the number of times advance was refused since start.
+
+*/
+
+long long RollbackSession::getStalls()
+{
+    return stalls;
+}
+
+/**
+\brief Returns the time spent simulating ticks again in rollbacks since start, in seconds.
+
+*/
+
+double RollbackSession::getResimSeconds()
+{
+    return resimSeconds;
+}
+
+/**
+\brief Returns the deepest rollback and the time spent in rollbacks since the last
+call, for per frame metrics.
+
+\param depth --- Set to the deepest rollback in ticks, 0 for none.
+\param seconds --- Set to the time spent simulating ticks again.
+
+*/
+
+void RollbackSession::takeFrameStats(int& depth, double& seconds)
+{
+    depth = frameRollback;
+    seconds = frameResimSeconds;
+    frameRollback = 0;
+    frameResimSeconds = 0;
+}
@@ -0,0 +1,113 @@
+#ifndef ROLLBACK_H_INCLUDED
+#define ROLLBACK_H_INCLUDED
+
+#include "MatchSim.h"
+
+/**
+\file Rollback.h
+
+\brief Header file for Rollback.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define ROLLBACK_WINDOW 32        ///< Ticks of snapshots kept, the furthest a session can roll back, a power of 2.
+#define ROLLBACK_INPUT_RING 64    ///< Ticks of input kept, twice the window since the peer can run ahead, a power of 2.
+#define ROLLBACK_MAX_EVENTS 8     ///< Inputs one player can give on one tick.
+#define ROLLBACK_MAX_DELAY 15     ///< Largest input delay, so local input never overwrites a tick still in the window.
+
+/**
+\brief The inputs one player gave on one tick, in the order they were given.
+
+*/
+
+struct TickInput
+{
+    int count;                               ///< Number of events.
+    SimInput events[ROLLBACK_MAX_EVENTS];    ///< The events.
+};
+
+/**
+\class RollbackSession
+
+\brief Runs a MatchSim for one side of a two player match where the other player's
+input arrives late.
+
+Each tick the local player's input is applied at once and the remote player is
+predicted to give no input, which leaves whatever they are holding held since
+movement is state in the fighter.  A snapshot of the state before every tick is kept.
+When the remote input for a tick that has already run turns out to have events, the
+session restores the snapshot of that tick and simulates forward again to the present
+with the real input.
+
+Both sides apply player one's events before player two's on every tick, so once all
+input is known both end in the same state as a match played with no delay.  A session
+stalls rather than running more ticks past the last tick it has the remote input for
+than the prediction limit, ROLLBACK_WINDOW unless set lower.  A limit of 0 never
+predicts, which is plain delay based lockstep.
+
+Local input can be delayed a number of ticks, so input given on tick t is applied on
+tick t + delay.  Both sides must use the same delay.  The remote input then has that
+many ticks to arrive before it would need a rollback, trading a little responsiveness
+for fewer and shallower rollbacks.
+
+*/
+
+class RollbackSession
+{
+private:
+    MatchSim* sim;                                     ///< Simulation being run, not owned.
+    int localPlayer;                                   ///< Player this side controls.
+    int remotePlayer;                                  ///< Player the other side controls.
+
+    MatchSnapshot snapshots[ROLLBACK_WINDOW];          ///< State before each recent tick.
+    TickInput inputs[ROLLBACK_INPUT_RING][2];          ///< Input of each player for recent ticks.
+    long long inputTick[ROLLBACK_INPUT_RING][2];       ///< Tick each input slot holds, -1 for none.
+
+    TickInput pendingLocal;                            ///< Local input for the next tick.
+    int inputDelay;                                    ///< Ticks local input is held back.
+    int maxPrediction;                                 ///< Most ticks run past the confirmed remote input.
+    long long remoteConfirmed;                         ///< Every tick before this has its remote input.
+    long long rollbackFrom;                            ///< Earliest tick to simulate again, -1 for none.
+
+    long long rollbacks;                               ///< Number of rollbacks.
+    long long resimulated;                             ///< Ticks simulated again in all rollbacks.
+    int maxRollback;                                   ///< Deepest rollback, in ticks.
+    long long stalls;                                  ///< Ticks advance was refused.
+    double resimSeconds;                               ///< Time spent in all rollbacks.
+    int frameRollback;                                 ///< Deepest rollback since takeFrameStats.
+    double frameResimSeconds;                          ///< Time spent in rollbacks since takeFrameStats.
+
+    void runTick();
+    const TickInput* inputFor(long long tick, int player);
+
+public:
+    RollbackSession(MatchSim* matchSim, int player);
+
+    void setInputDelay(int ticks);
+    void setMaxPrediction(int ticks);
+    int getInputDelay();
+
+    void start();
+    bool addLocalInput(const SimInput& in);
+    bool addRemoteInput(long long tick, const TickInput& in);
+
+    bool canAdvance();
+    bool advance(long long& tick, TickInput& sent);
+    void catchUp();
+    bool syncTest(int frames);
+
+    long long getTick();
+    long long getConfirmedTick();
+    long long getRollbacks();
+    long long getResimulated();
+    int getMaxRollback();
+    long long getStalls();
+    double getResimSeconds();
+    void takeFrameStats(int& depth, double& seconds);
+};
+
+#endif // ROLLBACK_H_INCLUDED
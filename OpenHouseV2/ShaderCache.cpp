@@ -0,0 +1,632 @@
+#include "ShaderCache.h"
+#include "LoadShaders.h"
+
+#include <stdio.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#ifdef _WIN32
+#include <direct.h>
+#else
+#include <sys/stat.h>
+#endif // _WIN32
+
+/**
+\file ShaderCache.cpp
+\brief Builds shader programs, reloading the binaries of earlier runs with glProgramBinary.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define SHADERCACHE_MAGIC 0x4353484Fu   ///< "OHSC", the start of each binary file.
+
+bool ShaderCache::enabled = true;
+bool ShaderCache::initialized = false;
+bool ShaderCache::binaries = false;
+std::string ShaderCache::directory = "ShaderCache";
+std::string ShaderCache::driver;
+std::map<unsigned long long, ShaderBinary> ShaderCache::memory;
+std::map<GLuint, std::vector<ShaderSource> > ShaderCache::built;
+ShaderCacheStats ShaderCache::stats = {0, 0, 0, 0, 0, 0};
+bool ShaderCache::parallel = false;
+bool ShaderCache::batching = false;
+std::vector<ShaderPending> ShaderCache::pending;
+
+/**
+\brief Returns an OpenGL string, "" if the driver gives none.
+
+\param name --- GL_VENDOR, GL_RENDERER or GL_VERSION.
+
+*/
+
+static std::string glString(GLenum name)
+{
+    const GLubyte* s = glGetString(name);
+    return s ? (const char*)s : "";
+}
+
+/**
+\brief Adds bytes to an FNV-1a hash.
+
+\param h --- Hash so far.
+\param data --- Bytes to add.
+\param size --- Number of bytes.
+
+\return The new hash.
+
+*/
+
+static unsigned long long fnv1a(unsigned long long h, const void* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= p[i];
+        h *= 0x100000001B3ull;
+    }
+    return h;
+}
+
+/**
+\brief Asks the driver for its strings, whether it has a program binary format, and to
+compile in parallel if it can.  Called by the first build, once a context is current.
+
+*/
+
+void ShaderCache::init()
+{
+    initialized = true;
+    driver = glString(GL_VENDOR) + "|" + glString(GL_RENDERER) + "|" + glString(GL_VERSION);
+
+    GLint formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+    binaries = formats > 0;
+
+#if !defined(__APPLE__) && defined(GL_KHR_parallel_shader_compile)
+    // Let the driver use as many compiler threads as it likes.
+    if (GLEW_KHR_parallel_shader_compile)
+    {
+        glMaxShaderCompilerThreadsKHR(0xFFFFFFFF);
+        parallel = true;
+    }
+#endif // GL_KHR_parallel_shader_compile
+}
+
+/**
+\brief Returns the key of a program, a hash of the driver and of its stages.
+
+\param sources --- Stages of the program.
+
+*/
+
+unsigned long long ShaderCache::hash(const std::vector<ShaderSource>& sources)
+{
+    unsigned long long h = 0xCBF29CE484222325ull;
+    h = fnv1a(h, driver.c_str(), driver.size() + 1);
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        unsigned int type = sources[i].type;
+        unsigned long long size = sources[i].code.size();
+        h = fnv1a(h, &type, sizeof(type));
+        h = fnv1a(h, &size, sizeof(size));
+        h = fnv1a(h, sources[i].code.c_str(), sources[i].code.size());
+    }
+    return h;
+}
+
+/**
+\brief Returns the file a program's binary is saved in.
+
+\param key --- Key of the program.
+
+*/
+
+std::string ShaderCache::fileName(unsigned long long key)
+{
+    char name[32];
+    snprintf(name, sizeof(name), "/%016llx.bin", key);
+    return directory + name;
+}
+
+/**
+\brief Reads a program's binary from the cache directory.
+
+\param key --- Key of the program.
+\param binary --- Filled with the binary.
+
+\return True if the file is there and whole.
+
+*/
+
+bool ShaderCache::readBinary(unsigned long long key, ShaderBinary& binary)
+{
+    FILE* f = fopen(fileName(key).c_str(), "rb");
+    if (!f)
+        return false;
+
+    unsigned int magic = 0;
+    unsigned long long fileKey = 0;
+    unsigned int format = 0;
+    unsigned int size = 0;
+    bool ok = fread(&magic, sizeof(magic), 1, f) == 1 && magic == SHADERCACHE_MAGIC &&
+              fread(&fileKey, sizeof(fileKey), 1, f) == 1 && fileKey == key &&
+              fread(&format, sizeof(format), 1, f) == 1 &&
+              fread(&size, sizeof(size), 1, f) == 1 && size > 0;
+    if (ok)
+    {
+        binary.format = format;
+        binary.data.resize(size);
+        ok = fread(&binary.data[0], 1, size, f) == size;
+    }
+    fclose(f);
+
+    return ok;
+}
+
+/**
+\brief Saves a program's binary to the cache directory, making the directory if need be.
+
+\param key --- Key of the program.
+\param binary --- The binary.
+
+*/
+
+void ShaderCache::writeBinary(unsigned long long key, const ShaderBinary& binary)
+{
+    std::string name = fileName(key);
+    FILE* f = fopen(name.c_str(), "wb");
+    if (!f)
+    {
+#ifdef _WIN32
+        _mkdir(directory.c_str());
+#else
+        mkdir(directory.c_str(), 0755);
+#endif // _WIN32
+        f = fopen(name.c_str(), "wb");
+    }
+    if (!f)
+    {
+        std::cerr << "Could not save the shader binary " << name << std::endl;
+        return;
+    }
+
+    unsigned int magic = SHADERCACHE_MAGIC;
+    unsigned int format = binary.format;
+    unsigned int size = binary.data.size();
+    bool ok = fwrite(&magic, sizeof(magic), 1, f) == 1 &&
+              fwrite(&key, sizeof(key), 1, f) == 1 &&
+              fwrite(&format, sizeof(format), 1, f) == 1 &&
+              fwrite(&size, sizeof(size), 1, f) == 1 &&
+              fwrite(&binary.data[0], 1, size, f) == size;
+    fclose(f);
+
+    // A partly written file would only be turned down each run, so leave none.
+    if (!ok)
+        remove(name.c_str());
+}
+
+/**
+\brief Gives a program a binary.
+
+\param program --- Program to load.
+\param binary --- The binary.
+
+\return True if the driver took the binary and the program is linked.
+
+*/
+
+bool ShaderCache::loadBinary(GLuint program, const ShaderBinary& binary)
+{
+    glProgramBinary(program, binary.format, &binary.data[0], binary.data.size());
+
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    return linked == GL_TRUE;
+}
+
+/**
+\brief Saves the binary of a program just linked, in memory and in the cache directory.
+
+\param program --- The program.
+\param key --- Its key.
+
+*/
+
+void ShaderCache::saveBinary(GLuint program, unsigned long long key)
+{
+    GLint length = 0;
+    glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+    if (length <= 0)
+        return;
+
+    ShaderBinary binary;
+    binary.data.resize(length);
+    glGetProgramBinary(program, length, &length, &binary.format, &binary.data[0]);
+    binary.data.resize(length);
+    if (length > 0)
+    {
+        memory[key] = binary;
+        writeBinary(key, binary);
+    }
+}
+
+/**
+\brief Compiles the stages of a program and links it, without asking for any status,
+so a driver with parallel compiling compiles the stages at once and returns at once.
+
+\param program --- Program to link.
+\param sources --- Stages of the program.
+
+\return The shaders, for finishCompile.
+
+*/
+
+std::vector<GLuint> ShaderCache::startCompile(GLuint program, const std::vector<ShaderSource>& sources)
+{
+    std::vector<GLuint> shaders;
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        GLuint shader = glCreateShader(sources[i].type);
+        const GLchar* code = sources[i].code.c_str();
+        glShaderSource(shader, 1, &code, NULL);
+        glCompileShader(shader);
+        glAttachShader(program, shader);
+        shaders.push_back(shader);
+    }
+
+    if (enabled && binaries)
+        glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+    glLinkProgram(program);
+
+    return shaders;
+}
+
+/**
+\brief Waits for a program startCompile started, then prints the stages' logs if it did
+not link.  The shaders are deleted.
+
+\param program --- The program.
+\param sources --- Its stages.
+\param shaders --- Its shaders, from startCompile.
+
+\return True if the program linked.
+
+*/
+
+bool ShaderCache::finishCompile(GLuint program, const std::vector<ShaderSource>& sources, const std::vector<GLuint>& shaders)
+{
+    GLint linked = GL_FALSE;
+    glGetProgramiv(program, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        bool stageFailed = false;
+        for (size_t i = 0; i < shaders.size(); i++)
+        {
+            GLint compiled = GL_FALSE;
+            glGetShaderiv(shaders[i], GL_COMPILE_STATUS, &compiled);
+            if (compiled)
+                continue;
+
+            GLsizei len = 0;
+            glGetShaderiv(shaders[i], GL_INFO_LOG_LENGTH, &len);
+            std::vector<GLchar> log(len + 1, 0);
+            glGetShaderInfoLog(shaders[i], len, &len, &log[0]);
+            std::cerr << std::endl << getShaderString(sources[i].type) << " shader compilation failed";
+            if (!sources[i].name.empty())
+                std::cerr << " in '" << sources[i].name << "'";
+            std::cerr << ": " << &log[0] << std::endl;
+            stageFailed = true;
+        }
+
+        if (!stageFailed)
+        {
+            GLsizei len = 0;
+            glGetProgramiv(program, GL_INFO_LOG_LENGTH, &len);
+            std::vector<GLchar> log(len + 1, 0);
+            glGetProgramInfoLog(program, len, &len, &log[0]);
+            std::cerr << "Shader linking failed: " << &log[0] << std::endl;
+        }
+    }
+
+    for (size_t i = 0; i < shaders.size(); i++)
+    {
+        glDetachShader(program, shaders[i]);
+        glDeleteShader(shaders[i]);
+    }
+
+    return linked == GL_TRUE;
+}
+
+/**
+\brief Returns whether the driver has finished linking a program, always true when it
+cannot say.
+
+\param program --- The program.
+
+*/
+
+bool ShaderCache::isDone(GLuint program)
+{
+#if !defined(__APPLE__) && defined(GL_KHR_parallel_shader_compile)
+    if (parallel)
+    {
+        GLint done = GL_FALSE;
+        glGetProgramiv(program, GL_COMPLETION_STATUS_KHR, &done);
+        return done == GL_TRUE;
+    }
+#endif // GL_KHR_parallel_shader_compile
+
+    return true;
+}
+
+/**
+\brief Checks a program started in a batch, counts it and saves its binary.
+
+\param p --- The program.
+
+\return True if it linked.
+
+*/
+
+bool ShaderCache::check(const ShaderPending& p)
+{
+    static const std::vector<ShaderSource> none;
+    const std::vector<ShaderSource>* sources = getSources(p.program);
+
+    bool ok = finishCompile(p.program, sources ? *sources : none, p.shaders);
+    if (ok)
+    {
+        stats.compiled++;
+        if (p.key)
+            saveBinary(p.program, p.key);
+    }
+    else
+    {
+        stats.failed++;
+        built.erase(p.program);
+    }
+    return ok;
+}
+
+/**
+\brief Checks the program of a key started in the batch, waiting for it, so a build of
+the same key loads its binary instead of compiling it again.
+
+\param key --- Key of the program.
+
+*/
+
+void ShaderCache::checkKey(unsigned long long key)
+{
+    for (size_t i = 0; i < pending.size(); i++)
+        if (pending[i].key == key)
+        {
+            ShaderPending p = pending[i];
+            pending.erase(pending.begin() + i);
+            check(p);
+            return;
+        }
+}
+
+/**
+\brief Builds a program, from a saved binary if there is one for it, otherwise by
+compiling and linking it and saving its binary.  In a batch the compile and link are
+only started, endBatch finishes them.
+
+\param program --- Program made by glCreateProgram, with nothing attached.
+\param sources --- Stages of the program.
+
+\return True if the program is linked, the errors are printed if not.  In a batch,
+true if it is linked or being compiled.
+
+*/
+
+bool ShaderCache::build(GLuint program, const std::vector<ShaderSource>& sources)
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    if (!initialized)
+        init();
+
+    stats.programs++;
+    bool cached = enabled && binaries;
+    bool ok = false;
+    unsigned long long key = 0;
+
+    if (cached)
+    {
+        key = hash(sources);
+        checkKey(key);
+
+        std::map<unsigned long long, ShaderBinary>::iterator it = memory.find(key);
+        if (it != memory.end())
+        {
+            ok = loadBinary(program, it->second);
+            if (ok)
+                stats.memoryHits++;
+            else
+                memory.erase(it);
+        }
+
+        ShaderBinary binary;
+        if (!ok && readBinary(key, binary))
+        {
+            ok = loadBinary(program, binary);
+            if (ok)
+            {
+                stats.diskHits++;
+                memory[key] = binary;
+            }
+        }
+    }
+
+    if (!ok && batching)
+    {
+        ShaderPending p;
+        p.program = program;
+        p.key = cached ? key : 0;
+        p.shaders = startCompile(program, sources);
+        pending.push_back(p);
+        built[program] = sources;
+
+        stats.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        return true;
+    }
+
+    if (!ok)
+    {
+        ok = finishCompile(program, sources, startCompile(program, sources));
+        if (ok)
+            stats.compiled++;
+        else
+            stats.failed++;
+
+        if (ok && cached)
+            saveBinary(program, key);
+    }
+
+    if (ok)
+        built[program] = sources;
+    else
+        built.erase(program);
+
+    stats.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    return ok;
+}
+
+/**
+\brief Returns the stages a program was built from.
+
+\param program --- Program name.
+
+\return The stages, NULL if the program was not built here.
+
+*/
+
+const std::vector<ShaderSource>* ShaderCache::getSources(GLuint program)
+{
+    std::map<GLuint, std::vector<ShaderSource> >::iterator it = built.find(program);
+    return it == built.end() ? NULL : &it->second;
+}
+
+/**
+\brief Drops the stages kept for a program, called when it is deleted.
+
+\param program --- Program name.
+
+*/
+
+void ShaderCache::forget(GLuint program)
+{
+    built.erase(program);
+
+    for (size_t i = 0; i < pending.size(); i++)
+        if (pending[i].program == program)
+        {
+            for (size_t k = 0; k < pending[i].shaders.size(); k++)
+                glDeleteShader(pending[i].shaders[k]);
+            pending.erase(pending.begin() + i);
+            return;
+        }
+}
+
+/**
+\brief Starts a batch, the builds until endBatch only start compiling.
+
+*/
+
+void ShaderCache::beginBatch()
+{
+    batching = true;
+}
+
+/**
+\brief Ends a batch, checking each program started in it as the driver finishes it.
+
+\return True if every program of the batch linked, the errors are printed if not.
+
+*/
+
+bool ShaderCache::endBatch()
+{
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    batching = false;
+    bool ok = true;
+    while (!pending.empty())
+    {
+        bool checked = false;
+        for (size_t i = 0; i < pending.size();)
+        {
+            if (!isDone(pending[i].program))
+            {
+                i++;
+                continue;
+            }
+
+            ShaderPending p = pending[i];
+            pending.erase(pending.begin() + i);
+            ok = check(p) && ok;
+            checked = true;
+        }
+
+        if (!checked)
+            std::this_thread::yield();
+    }
+
+    stats.ms += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    return ok;
+}
+
+/**
+\brief Turns the binary cache on or off, off compiles every program as it was before
+there was a cache.
+
+\param on --- Look for and save binaries.
+
+*/
+
+void ShaderCache::setEnabled(bool on)
+{
+    enabled = on;
+}
+
+/**
+\brief Sets the directory the binaries are saved in, "ShaderCache" by default.
+
+\param dir --- Directory, made when the first binary is saved.
+
+*/
+
+void ShaderCache::setDirectory(const std::string& dir)
+{
+    directory = dir;
+}
+
+/**
+\brief Zeroes the counts.
+
+*/
+
+void ShaderCache::resetStats()
+{
+    stats.programs = stats.memoryHits = stats.diskHits = stats.compiled = stats.failed = 0;
+    stats.ms = 0;
+}
+
+/**
+\brief Returns the counts since the last resetStats.
+
+*/
+
+const ShaderCacheStats& ShaderCache::getStats()
+{
+    return stats;
+}
@@ -0,0 +1,144 @@
+#ifndef SHADERCACHE_H_INCLUDED
+#define SHADERCACHE_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <map>
+#include <string>
+#include <vector>
+
+/**
+\file ShaderCache.h
+
+\brief Header file for ShaderCache.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief One stage of a program, its type and GLSL code.
+
+*/
+
+struct ShaderSource
+{
+    GLenum type;        ///< GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, ...
+    std::string name;   ///< File the code came from, or "" from memory, for error messages.
+    std::string code;   ///< GLSL code.
+};
+
+/**
+\brief Where the programs built since the last ShaderCache::resetStats came from.
+
+*/
+
+struct ShaderCacheStats
+{
+    int programs;       ///< Programs built.
+    int memoryHits;     ///< Loaded from a binary already read this run.
+    int diskHits;       ///< Loaded from a binary in the cache directory.
+    int compiled;       ///< Compiled and linked from the GLSL.
+    int failed;         ///< Failed to compile or link.
+    double ms;          ///< Time spent building them.
+};
+
+/**
+\brief A linked program as the driver gave it back by glGetProgramBinary.
+
+*/
+
+struct ShaderBinary
+{
+    GLenum format;                      ///< Driver's binary format.
+    std::vector<unsigned char> data;    ///< The binary.
+};
+
+/**
+\brief A program whose link was started in a batch and has not been checked yet.
+
+*/
+
+struct ShaderPending
+{
+    GLuint program;                 ///< The program.
+    unsigned long long key;         ///< Its key, 0 if its binary is not saved.
+    std::vector<GLuint> shaders;    ///< Its stages, deleted when it is checked.
+};
+
+/**
+\class ShaderCache
+
+\brief Builds the shader programs, from program binaries saved by earlier runs when it can.
+
+Each program is keyed by a hash of the driver (vendor, renderer and version strings) and
+the type and code of each of its stages, so a change to a shader or a driver update makes
+a new key and the old binary is never used.  A program's binary is looked for first in
+memory, where every binary read or made this run is kept (the Wavefront models build the
+same program once per material), then in a file named by the key in the cache directory.
+When neither is there, or the driver turns the binary down, the program is compiled and
+linked from the GLSL as before and its binary saved for next time.
+
+When the driver has GL_KHR_parallel_shader_compile it is given every thread it wants, and
+the stages are compiled and linked without asking for their status in between, so the
+driver can compile them on its own threads.  The compile logs are only read when the
+link fails.  Between beginBatch and endBatch a build only starts the compile and link
+and returns, so every program of a batch compiles at once; endBatch checks each as the
+driver reports it done, with GL_COMPLETION_STATUS_KHR, prints the errors and saves the
+binaries.  A program may be used before endBatch, the driver then waits for that one.
+
+The sources of each program built are kept so GLCapture can record programs that were
+loaded from a binary and have no shaders attached.  Only the render thread may use it.
+
+*/
+
+class ShaderCache
+{
+private:
+    static bool enabled;                                        ///< Binaries are looked for and saved.
+    static bool initialized;                                    ///< The driver has been asked what it supports.
+    static bool binaries;                                       ///< The driver has a program binary format.
+    static std::string directory;                               ///< Directory the binaries are saved in.
+    static std::string driver;                                  ///< Vendor, renderer and version, part of every key.
+    static std::map<unsigned long long, ShaderBinary> memory;   ///< Binaries read or made this run, by key.
+    static std::map<GLuint, std::vector<ShaderSource> > built;  ///< Sources of each program built.
+    static ShaderCacheStats stats;                              ///< Counts since the last resetStats.
+    static bool parallel;                                       ///< The driver compiles on its own threads.
+    static bool batching;                                       ///< Builds only start, endBatch checks them.
+    static std::vector<ShaderPending> pending;                  ///< Programs started in the batch, not checked yet.
+
+    static void init();
+    static unsigned long long hash(const std::vector<ShaderSource>& sources);
+    static std::string fileName(unsigned long long key);
+    static bool readBinary(unsigned long long key, ShaderBinary& binary);
+    static void writeBinary(unsigned long long key, const ShaderBinary& binary);
+    static bool loadBinary(GLuint program, const ShaderBinary& binary);
+    static void saveBinary(GLuint program, unsigned long long key);
+    static std::vector<GLuint> startCompile(GLuint program, const std::vector<ShaderSource>& sources);
+    static bool finishCompile(GLuint program, const std::vector<ShaderSource>& sources, const std::vector<GLuint>& shaders);
+    static bool isDone(GLuint program);
+    static bool check(const ShaderPending& p);
+    static void checkKey(unsigned long long key);
+
+public:
+    static bool build(GLuint program, const std::vector<ShaderSource>& sources);
+    static const std::vector<ShaderSource>* getSources(GLuint program);
+    static void forget(GLuint program);
+
+    static void beginBatch();
+    static bool endBatch();
+
+    static void setEnabled(bool on);
+    static void setDirectory(const std::string& dir);
+
+    static void resetStats();
+    static const ShaderCacheStats& getStats();
+};
+
+#endif // SHADERCACHE_H_INCLUDED
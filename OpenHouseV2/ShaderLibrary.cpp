@@ -0,0 +1,637 @@
+#include "ShaderLibrary.h"
+
+#include <stdio.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+/**
+\file ShaderLibrary.cpp
+\brief Shader preprocessor with includes and permutations, and reloading of changed shaders.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+std::vector<ShaderLibraryProgram> ShaderLibrary::programs;
+std::map<std::string, ShaderLibrarySource> ShaderLibrary::sources;
+
+/**
+\brief A uniform's value, kept while a program is built again.
+
+*/
+
+struct UniformValue
+{
+    std::string name;           ///< Name, with the index for array elements.
+    GLenum type;                ///< Type from glGetActiveUniform, GL_UNIFORM_BLOCK_BINDING for a uniform block.
+    std::vector<GLfloat> f;     ///< Value of a float, vector or matrix uniform.
+    std::vector<GLint> i;       ///< Value of an int, bool or sampler uniform, or a block's binding point.
+};
+
+/**
+\brief Returns the change time of a file, 0 if it can not be read.
+
+\param path --- The file.
+
+*/
+
+static time_t fileChangeTime(const std::string& path)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+        return 0;
+    return st.st_mtime;
+}
+
+/**
+\brief Returns the number of values in a uniform of a type, 0 for types not kept.
+
+\param type --- Type from glGetActiveUniform.
+\param isFloat --- Set to true if the values are floats.
+
+*/
+
+static int uniformComponents(GLenum type, bool& isFloat)
+{
+    isFloat = true;
+    switch (type)
+    {
+        case GL_FLOAT:
+            return 1;
+        case GL_FLOAT_VEC2:
+            return 2;
+        case GL_FLOAT_VEC3:
+            return 3;
+        case GL_FLOAT_VEC4:
+        case GL_FLOAT_MAT2:
+            return 4;
+        case GL_FLOAT_MAT3:
+            return 9;
+        case GL_FLOAT_MAT4:
+            return 16;
+    }
+
+    isFloat = false;
+    switch (type)
+    {
+        case GL_INT:
+        case GL_BOOL:
+        case GL_SAMPLER_2D:
+        case GL_SAMPLER_CUBE:
+        case GL_SAMPLER_2D_SHADOW:
+        case GL_SAMPLER_3D:
+        case GL_SAMPLER_BUFFER:
+        case GL_INT_SAMPLER_BUFFER:
+        case GL_UNSIGNED_INT_SAMPLER_BUFFER:
+            return 1;
+        case GL_INT_VEC2:
+        case GL_BOOL_VEC2:
+            return 2;
+        case GL_INT_VEC3:
+        case GL_BOOL_VEC3:
+            return 3;
+        case GL_INT_VEC4:
+        case GL_BOOL_VEC4:
+            return 4;
+    }
+
+    return 0;
+}
+
+/**
+\brief Reads the value of every active uniform of a program, and the binding point of
+every uniform block, which linking resets too.
+
+\param program --- Linked program.
+\param values --- Filled with the values, one for each array element, then the blocks.
+
+*/
+
+static void saveUniforms(GLuint program, std::vector<UniformValue>& values)
+{
+    GLint count = 0;
+    glGetProgramiv(program, GL_ACTIVE_UNIFORMS, &count);
+    for (GLint u = 0; u < count; u++)
+    {
+        char name[256];
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(program, u, sizeof(name), &length, &size, &type, name);
+
+        bool isFloat;
+        int components = uniformComponents(type, isFloat);
+        if (components == 0)
+            continue;
+
+        // Arrays are listed once as name[0], each element has a location of its own.
+        std::string base = name;
+        if (size > 1 && base.size() > 3 && base.compare(base.size() - 3, 3, "[0]") == 0)
+            base.resize(base.size() - 3);
+
+        for (GLint e = 0; e < size; e++)
+        {
+            UniformValue v;
+            v.name = size > 1 ? base + "[" + std::to_string(e) + "]" : base;
+            v.type = type;
+
+            GLint loc = glGetUniformLocation(program, v.name.c_str());
+            if (loc < 0)
+                continue;
+
+            if (isFloat)
+            {
+                v.f.resize(components);
+                glGetUniformfv(program, loc, &v.f[0]);
+            }
+            else
+            {
+                v.i.resize(components);
+                glGetUniformiv(program, loc, &v.i[0]);
+            }
+            values.push_back(v);
+        }
+    }
+
+    glGetProgramiv(program, GL_ACTIVE_UNIFORM_BLOCKS, &count);
+    for (GLint b = 0; b < count; b++)
+    {
+        char name[256];
+        GLsizei length = 0;
+        glGetActiveUniformBlockName(program, b, sizeof(name), &length, name);
+
+        UniformValue v;
+        v.name = name;
+        v.type = GL_UNIFORM_BLOCK_BINDING;
+        v.i.resize(1);
+        glGetActiveUniformBlockiv(program, b, GL_UNIFORM_BLOCK_BINDING, &v.i[0]);
+        values.push_back(v);
+    }
+}
+
+/**
+\brief Sets the uniforms and block bindings of a program to values saved from it, by
+name, skipping uniforms it no longer has or whose type changed.
+
+\param program --- Linked program.
+\param values --- Values from saveUniforms.
+
+*/
+
+static void restoreUniforms(GLuint program, const std::vector<UniformValue>& values)
+{
+    GLint current = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+    glUseProgram(program);
+
+    for (size_t k = 0; k < values.size(); k++)
+    {
+        const UniformValue& v = values[k];
+        if (v.type == GL_UNIFORM_BLOCK_BINDING)
+        {
+            GLuint block = glGetUniformBlockIndex(program, v.name.c_str());
+            if (block != GL_INVALID_INDEX)
+                glUniformBlockBinding(program, block, v.i[0]);
+            continue;
+        }
+
+        GLint loc = glGetUniformLocation(program, v.name.c_str());
+        if (loc < 0)
+            continue;
+
+        GLint size = 0;
+        GLenum type = 0;
+        char name[256];
+        GLuint index = 0;
+        const GLchar* names[1] = {v.name.c_str()};
+        glGetUniformIndices(program, 1, names, &index);
+        if (index == GL_INVALID_INDEX)
+            continue;
+        glGetActiveUniform(program, index, sizeof(name), NULL, &size, &type, name);
+        if (type != v.type)
+            continue;
+
+        switch (type)
+        {
+            case GL_FLOAT:
+                glUniform1fv(loc, 1, &v.f[0]);
+                break;
+            case GL_FLOAT_VEC2:
+                glUniform2fv(loc, 1, &v.f[0]);
+                break;
+            case GL_FLOAT_VEC3:
+                glUniform3fv(loc, 1, &v.f[0]);
+                break;
+            case GL_FLOAT_VEC4:
+                glUniform4fv(loc, 1, &v.f[0]);
+                break;
+            case GL_FLOAT_MAT2:
+                glUniformMatrix2fv(loc, 1, GL_FALSE, &v.f[0]);
+                break;
+            case GL_FLOAT_MAT3:
+                glUniformMatrix3fv(loc, 1, GL_FALSE, &v.f[0]);
+                break;
+            case GL_FLOAT_MAT4:
+                glUniformMatrix4fv(loc, 1, GL_FALSE, &v.f[0]);
+                break;
+            default:
+                if (v.i.size() == 1)
+                    glUniform1iv(loc, 1, &v.i[0]);
+                else if (v.i.size() == 2)
+                    glUniform2iv(loc, 1, &v.i[0]);
+                else if (v.i.size() == 3)
+                    glUniform3iv(loc, 1, &v.i[0]);
+                else
+                    glUniform4iv(loc, 1, &v.i[0]);
+                break;
+        }
+    }
+
+    glUseProgram(current);
+}
+
+/**
+\brief Puts a list of defines in a single order, with each name once, so the same
+permutation always has the same name.
+
+\param defines --- Names, or NAME=VALUE, split by spaces.
+
+*/
+
+std::string ShaderLibrary::normalize(const std::string& defines)
+{
+    std::istringstream in(defines);
+    std::vector<std::string> names;
+    std::string name;
+    while (in >> name)
+        names.push_back(name);
+
+    std::sort(names.begin(), names.end());
+    names.erase(std::unique(names.begin(), names.end()), names.end());
+
+    std::string out;
+    for (size_t i = 0; i < names.size(); i++)
+        out += (i ? " " : "") + names[i];
+    return out;
+}
+
+/**
+\brief Reads a shader file into a string, replacing each #include line with the file
+it names, unless that file is already in.
+
+\param file --- The file.
+\param out --- The code is appended to it.
+\param files --- Files read so far, the file is added.  Its position is its source
+string number in the #line directives.
+
+\return False if a file could not be read or an #include is malformed.
+
+*/
+
+bool ShaderLibrary::expand(const std::string& file, std::string& out, std::vector<std::string>& files)
+{
+    int index = files.size();
+    files.push_back(file);
+
+    std::ifstream in(file.c_str());
+    if (!in)
+    {
+        std::cerr << "Unable to open file '" << file << "'" << std::endl;
+        return false;
+    }
+
+    // Included names are relative to the file including them.
+    size_t slash = file.find_last_of("/\\");
+    std::string dir = slash == std::string::npos ? "" : file.substr(0, slash + 1);
+
+    std::string line;
+    int number = 0;
+    while (std::getline(in, line))
+    {
+        number++;
+        if (!line.empty() && line[line.size() - 1] == '\r')
+            line.resize(line.size() - 1);
+
+        size_t start = line.find_first_not_of(" \t");
+        if (start == std::string::npos || line.compare(start, 8, "#include") != 0)
+        {
+            out += line + "\n";
+            continue;
+        }
+
+        size_t open = line.find('"', start);
+        size_t close = open == std::string::npos ? open : line.find('"', open + 1);
+        if (close == std::string::npos)
+        {
+            std::cerr << file << ":" << number << ": #include needs a \"file\"" << std::endl;
+            return false;
+        }
+
+        std::string name = dir + line.substr(open + 1, close - open - 1);
+        if (std::find(files.begin(), files.end(), name) != files.end())
+        {
+            out += "\n";
+            continue;
+        }
+
+        out += "#line 1 " + std::to_string(files.size()) + "\n";
+        if (!expand(name, out, files))
+            return false;
+        out += "#line " + std::to_string(number + 1) + " " + std::to_string(index) + "\n";
+    }
+
+    return true;
+}
+
+/**
+\brief Returns a shader file preprocessed for a permutation, reading it the first time.
+
+The defines go right after the #version line, which must be in the file itself.
+
+\param file --- The file.
+\param type --- GL_VERTEX_SHADER, GL_FRAGMENT_SHADER, ...
+\param defines --- Normalized defines of the permutation.
+
+\return The code and the files it came from, NULL if a file could not be read.
+
+*/
+
+const ShaderLibrarySource* ShaderLibrary::preprocess(const std::string& file, GLenum type, const std::string& defines)
+{
+    std::string key = file + "|" + std::to_string(type) + "|" + defines;
+    std::map<std::string, ShaderLibrarySource>::iterator it = sources.find(key);
+    if (it != sources.end())
+        return &it->second;
+
+    ShaderLibrarySource entry;
+    std::string code;
+    bool ok = expand(file, code, entry.files);
+
+    std::string header;
+    std::istringstream in(defines);
+    std::string define;
+    while (in >> define)
+    {
+        size_t equals = define.find('=');
+        if (equals == std::string::npos)
+            header += "#define " + define + " 1\n";
+        else
+            header += "#define " + define.substr(0, equals) + " " + define.substr(equals + 1) + "\n";
+    }
+
+    size_t version = code.find("#version");
+    size_t end = version == std::string::npos ? version : code.find('\n', version);
+    if (ok && end == std::string::npos)
+    {
+        std::cerr << file << ": no #version line" << std::endl;
+        ok = false;
+    }
+
+    if (ok)
+    {
+        int line = std::count(code.begin(), code.begin() + end + 1, '\n') + 1;
+        code.insert(end + 1, header + "#line " + std::to_string(line) + " 0\n");
+    }
+
+    entry.source.type = type;
+    entry.source.name = file;
+    entry.source.code = code;
+    if (entry.files.size() > 1)
+    {
+        entry.source.name += " (";
+        for (size_t i = 1; i < entry.files.size(); i++)
+            entry.source.name += (i > 1 ? ", " : "") + std::to_string(i) + " = " + entry.files[i];
+        entry.source.name += ")";
+    }
+
+    // Failures are kept too, so the files are still watched and the error is not
+    // printed again for every program of the permutation.
+    sources[key] = entry;
+    return ok ? &sources[key] : NULL;
+}
+
+/**
+\brief Preprocesses the stages of a program and notes the files they came from.
+
+\param entry --- The program, its files and their change times are set.
+\param out --- Filled with the stages.
+
+\return False if a file could not be read.
+
+*/
+
+bool ShaderLibrary::stages(ShaderLibraryProgram& entry, std::vector<ShaderSource>& out)
+{
+    const ShaderLibrarySource* vs = preprocess(entry.vertexFile, GL_VERTEX_SHADER, entry.defines);
+    const ShaderLibrarySource* fs = preprocess(entry.fragmentFile, GL_FRAGMENT_SHADER, entry.defines);
+
+    entry.files.clear();
+    std::string keys[2] =
+    {
+        entry.vertexFile + "|" + std::to_string(GL_VERTEX_SHADER) + "|" + entry.defines,
+        entry.fragmentFile + "|" + std::to_string(GL_FRAGMENT_SHADER) + "|" + entry.defines
+    };
+    for (int s = 0; s < 2; s++)
+    {
+        const std::vector<std::string>& files = sources[keys[s]].files;
+        for (size_t i = 0; i < files.size(); i++)
+            if (std::find(entry.files.begin(), entry.files.end(), files[i]) == entry.files.end())
+                entry.files.push_back(files[i]);
+    }
+
+    entry.times.clear();
+    for (size_t i = 0; i < entry.files.size(); i++)
+        entry.times.push_back(fileChangeTime(entry.files[i]));
+
+    if (!vs || !fs)
+        return false;
+
+    out.clear();
+    out.push_back(vs->source);
+    out.push_back(fs->source);
+    return true;
+}
+
+/**
+\brief Makes a program from a vertex and a fragment shader file.
+
+\param vertexFile --- Vertex shader file.
+\param fragmentFile --- Fragment shader file.
+\param defines --- Permutation, names or NAME=VALUE split by spaces.
+
+\return The program, 0 on failure.  In a ShaderCache batch a program that does not link
+is returned and reported by ShaderCache::endBatch.
+
+*/
+
+GLuint ShaderLibrary::load(const std::string& vertexFile, const std::string& fragmentFile, const std::string& defines)
+{
+    GLuint program = glCreateProgram();
+
+    if (!build(program, vertexFile, fragmentFile, defines))
+    {
+        glDeleteProgram(program);
+        return 0;
+    }
+
+    return program;
+}
+
+/**
+\brief Builds a program made by the caller from a vertex and a fragment shader file,
+for programs owned by someone else, the skinning technique's.
+
+\param program --- Program made by glCreateProgram.
+\param vertexFile --- Vertex shader file.
+\param fragmentFile --- Fragment shader file.
+\param defines --- Permutation, names or NAME=VALUE split by spaces.
+
+\return True if the program is linked, the errors are printed if not.
+
+*/
+
+bool ShaderLibrary::build(GLuint program, const std::string& vertexFile, const std::string& fragmentFile,
+                          const std::string& defines)
+{
+    ShaderLibraryProgram entry;
+    entry.program = program;
+    entry.vertexFile = vertexFile;
+    entry.fragmentFile = fragmentFile;
+    entry.defines = normalize(defines);
+
+    std::vector<ShaderSource> code;
+    if (!stages(entry, code) || !ShaderCache::build(program, code))
+        return false;
+
+    // Only the old entry goes, the sources ShaderCache just kept are the capture's.
+    unwatch(program);
+    programs.push_back(entry);
+    return true;
+}
+
+/**
+\brief Stops watching a program's files, keeping what ShaderCache knows of it.
+
+\param program --- Program name.
+
+*/
+
+void ShaderLibrary::unwatch(GLuint program)
+{
+    for (size_t i = 0; i < programs.size(); i++)
+        if (programs[i].program == program)
+        {
+            programs.erase(programs.begin() + i);
+            break;
+        }
+}
+
+/**
+\brief Stops watching a program's files, called before the program is deleted.
+
+\param program --- Program name.
+
+*/
+
+void ShaderLibrary::release(GLuint program)
+{
+    unwatch(program);
+    ShaderCache::forget(program);
+}
+
+/**
+\brief Sets the uniforms of a program to the values they have in another, by name,
+for a program switched for another permutation of the same files.  Uniforms the
+other program does not have keep their values.
+
+\param from --- Linked program to read.
+\param to --- Linked program to set.
+
+*/
+
+void ShaderLibrary::copyUniforms(GLuint from, GLuint to)
+{
+    std::vector<UniformValue> values;
+    saveUniforms(from, values);
+    restoreUniforms(to, values);
+}
+
+/**
+\brief Builds again every program whose files changed since it was built.
+
+Each changed permutation is first built into a program of its own, so a file with an
+error leaves the programs as they were.  Once it builds, each program of the
+permutation is built again under its own name with its uniform values put back.
+
+\return True if any program was built again, its uniform locations may have moved.
+
+*/
+
+bool ShaderLibrary::reloadIfChanged()
+{
+    std::map<std::string, time_t> now;
+    std::vector<size_t> changed;
+    for (size_t p = 0; p < programs.size(); p++)
+    {
+        const ShaderLibraryProgram& entry = programs[p];
+        for (size_t i = 0; i < entry.files.size(); i++)
+        {
+            if (now.find(entry.files[i]) == now.end())
+                now[entry.files[i]] = fileChangeTime(entry.files[i]);
+            if (now[entry.files[i]] != entry.times[i])
+            {
+                changed.push_back(p);
+                break;
+            }
+        }
+    }
+
+    if (changed.empty())
+        return false;
+
+    sources.clear();
+
+    std::map<std::string, bool> tested;
+    int rebuilt = 0;
+    int kept = 0;
+    for (size_t c = 0; c < changed.size(); c++)
+    {
+        ShaderLibraryProgram& entry = programs[changed[c]];
+        std::vector<ShaderSource> code;
+        bool ok = stages(entry, code);
+
+        std::string key = entry.vertexFile + "|" + entry.fragmentFile + "|" + entry.defines;
+        if (ok && tested.find(key) == tested.end())
+        {
+            GLuint test = glCreateProgram();
+            tested[key] = ShaderCache::build(test, code);
+            ShaderCache::forget(test);
+            glDeleteProgram(test);
+        }
+
+        if (!ok || !tested[key])
+        {
+            kept++;
+            continue;
+        }
+
+        std::vector<UniformValue> values;
+        saveUniforms(entry.program, values);
+        ShaderCache::build(entry.program, code);
+        restoreUniforms(entry.program, values);
+        rebuilt++;
+    }
+
+    if (rebuilt > 0)
+        std::cout << "Reloaded " << rebuilt << " shader programs." << std::endl;
+    if (kept > 0)
+        std::cerr << kept << " shader programs kept as they were." << std::endl;
+
+    return rebuilt > 0;
+}
@@ -0,0 +1,109 @@
+#ifndef SHADERLIBRARY_H_INCLUDED
+#define SHADERLIBRARY_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <time.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "ShaderCache.h"
+
+/**
+\file ShaderLibrary.h
+
+\brief Header file for ShaderLibrary.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief A shader file run through the preprocessor with a set of defines.
+
+*/
+
+struct ShaderLibrarySource
+{
+    ShaderSource source;                ///< The code to compile.
+    std::vector<std::string> files;     ///< The file and every file it includes, source string numbers in #line order.
+};
+
+/**
+\brief A program the library built, remembered so it can be built again when its files change.
+
+*/
+
+struct ShaderLibraryProgram
+{
+    GLuint program;                     ///< The program, its name never changes.
+    std::string vertexFile;             ///< Vertex shader file.
+    std::string fragmentFile;           ///< Fragment shader file.
+    std::string defines;                ///< Permutation, see ShaderLibrary::normalize.
+    std::vector<std::string> files;     ///< Every file the program was built from.
+    std::vector<time_t> times;          ///< Change time of each file when it was built.
+};
+
+/**
+\class ShaderLibrary
+
+\brief Builds programs from shader files with includes and permutations, and builds them
+again while the game runs when the files change.
+
+A shader file may use
+
+    #include "file.glsl"
+
+to share code, the Light and Material structs for instance.  A file is included once
+per shader however often it is asked for, so files may include each other.  The
+included code is marked with #line directives, so an error in it is reported with its
+line and its source string number, the number of the file in the list printed with
+the error.
+
+Each program is a permutation of its files, named by a list of defines such as
+"SKINNED TEX_D" or "LIGHTS=3", which are put after the #version line as #define NAME 1
+or #define NAME VALUE.  Only the permutations asked for are built, each file is read
+and preprocessed once per permutation, and the programs of a permutation share their
+binary through ShaderCache, so the per-material programs of the Wavefront models cost
+one compile.
+
+reloadIfChanged checks the files of every program it built, includes too, and builds
+the programs of changed files again under the same names, keeping their uniform
+values, so nothing holding the names has to change.  Uniform locations may move if
+the uniforms did; the caller looks up the ones it keeps again when it returns true.  A
+file with an error is reported and the programs stay as they were.  Only the render
+thread may use it.
+
+*/
+
+class ShaderLibrary
+{
+private:
+    static std::vector<ShaderLibraryProgram> programs;          ///< Programs built, to reload.
+    static std::map<std::string, ShaderLibrarySource> sources;  ///< Preprocessed files, by file, type and defines.
+
+    static std::string normalize(const std::string& defines);
+    static bool expand(const std::string& file, std::string& out, std::vector<std::string>& files);
+    static const ShaderLibrarySource* preprocess(const std::string& file, GLenum type, const std::string& defines);
+    static bool stages(ShaderLibraryProgram& entry, std::vector<ShaderSource>& out);
+    static void unwatch(GLuint program);
+
+public:
+    static GLuint load(const std::string& vertexFile, const std::string& fragmentFile, const std::string& defines = "");
+    static bool build(GLuint program, const std::string& vertexFile, const std::string& fragmentFile,
+                      const std::string& defines = "");
+    static void release(GLuint program);
+    static void copyUniforms(GLuint from, GLuint to);
+
+    static bool reloadIfChanged();
+};
+
+#endif // SHADERLIBRARY_H_INCLUDED
@@ -0,0 +1,12 @@
+#version 330 core
+
+/**
+\file ShadowDepthFragment.glsl
+
+\brief Fragment shader of the shadow map pass, the depth is all it writes.
+
+*/
+
+void main()
+{
+}
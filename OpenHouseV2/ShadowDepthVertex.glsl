@@ -0,0 +1,47 @@
+#version 330 core
+
+/**
+\file ShadowDepthVertex.glsl
+
+\brief Vertex shader of the shadow map pass and the depth pre-pass, it only
+places the vertex.
+
+\param [in] vposition --- vec4 vertex position from memory.
+
+\param [uniform] PVM --- mat4 light projection times light view times model.
+
+\param [uniform] gBones --- mat4 array of bone transformations, SKINNED only.
+
+Defines: SKINNED --- move the vertex by its bones, as ObjVertexShader.glsl does.
+
+*/
+
+layout(location = 0) in vec4 vposition;
+#ifdef SKINNED
+layout(location = 4) in ivec4 BoneIDs;
+layout(location = 5) in vec4 Weights;
+
+const int MAX_BONES = 200;
+uniform mat4 gBones[MAX_BONES];
+#endif
+
+uniform mat4 PVM;
+
+void main()
+{
+#ifdef SKINNED
+    // A vertex whose first bone does not move it is not moved, as in ObjVertexShader.glsl.
+    mat4 BoneTransform = gBones[BoneIDs[0]] * Weights[0];
+    if (BoneTransform == mat4(0.0))
+        BoneTransform = mat4(1.0);
+    else
+    {
+        BoneTransform += gBones[BoneIDs[1]] * Weights[1];
+        BoneTransform += gBones[BoneIDs[2]] * Weights[2];
+        BoneTransform += gBones[BoneIDs[3]] * Weights[3];
+    }
+    gl_Position = PVM * BoneTransform * vposition;
+#else
+    gl_Position = PVM * vposition;
+#endif
+}
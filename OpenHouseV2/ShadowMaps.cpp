@@ -0,0 +1,798 @@
+#include "ShadowMaps.h"
+
+#include <math.h>
+
+#include <algorithm>
+#include <iostream>
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+#include "ShaderLibrary.h"
+#include "ogldev_math_3d.h"
+
+/**
+\file ShadowMaps.cpp
+\brief Shadow maps of the directional and spot lights in one depth atlas.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define SHADOW_SPOT_NEAR 0.1f           ///< Near plane of a spot's map.
+#define SHADOW_SPOT_MAX_ANGLE 60.0f     ///< Widest half angle of a spot's map, degrees.
+#define SHADOW_CASTER_DEPTH 100.0f      ///< How far toward a directional light casters are caught past the view.
+#define SHADOW_BOX_MARGIN 0.25f         ///< Part of its size a directional light's box is grown by, so it is kept longer.
+#define SHADOW_MAX_BONES 200            ///< Bones of the skinned depth shader, as ObjVertexShader.glsl.
+
+bool ShadowMaps::enabled = true;
+int ShadowMaps::defaultSize = SHADOW_DEFAULT_SIZE;
+GLint ShadowMaps::unit = -1;
+
+/**
+\brief Constructor, nothing is made until the first fit.
+
+*/
+
+ShadowMaps::ShadowMaps()
+{
+    count = 0;
+    atlas = 0;
+    cache = 0;
+    framebuffers[0] = framebuffers[1] = 0;
+    buffer = 0;
+    programs[0] = programs[1] = 0;
+    pvmLoc[0] = pvmLoc[1] = -1;
+    bonesLoc = -1;
+    bound = 0;
+    maxAtlas = 0;
+    atlasSize = 0;
+    version = 0;
+    redrawn = 0;
+    current = 0;
+    drawing = false;
+    block = ShadowBlock();
+}
+
+/**
+\brief Destructor.  The OpenGL objects must already have been freed by release while
+the context was current.
+
+*/
+
+ShadowMaps::~ShadowMaps()
+{
+}
+
+/**
+\brief Returns the texture unit of the atlas, the one before the light clusters' three
+at the end of the units there are.
+
+*/
+
+GLint ShadowMaps::textureUnit()
+{
+    if (unit < 0)
+    {
+        GLint units = 0;
+        glGetIntegerv(GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS, &units);
+        unit = std::max(units - 4, 0);
+    }
+    return unit;
+}
+
+/**
+\brief Makes the atlas, the cache, their framebuffers, the block buffer and the depth
+programs.
+
+\return False if a depth program did not build, shadow maps are then left empty.
+
+*/
+
+bool ShadowMaps::create()
+{
+    glGenTextures(1, &atlas);
+    glGenRenderbuffers(1, &cache);
+    glGenFramebuffers(2, framebuffers);
+    glGenBuffers(1, &buffer);
+
+    GLint textureMax = 0;
+    GLint renderbufferMax = 0;
+    glGetIntegerv(GL_MAX_TEXTURE_SIZE, &textureMax);
+    glGetIntegerv(GL_MAX_RENDERBUFFER_SIZE, &renderbufferMax);
+    maxAtlas = std::min(SHADOW_MAX_ATLAS, (int)std::min(textureMax, renderbufferMax));
+
+    programs[0] = ShaderLibrary::load("ShadowDepthVertex.glsl", "ShadowDepthFragment.glsl");
+    programs[1] = ShaderLibrary::load("ShadowDepthVertex.glsl", "ShadowDepthFragment.glsl", "SKINNED");
+    if (!programs[0] || !programs[1])
+    {
+        std::cerr << "The shadow depth shaders did not build, nothing casts a shadow." << std::endl;
+        return false;
+    }
+    pvmLoc[0] = glGetUniformLocation(programs[0], "PVM");
+    pvmLoc[1] = glGetUniformLocation(programs[1], "PVM");
+    bonesLoc = glGetUniformLocation(programs[1], "gBones");
+
+    return resize(std::min(SHADOW_DEFAULT_SIZE, maxAtlas));
+}
+
+/**
+\brief Gives the atlas and the cache new storage, cleared to the far plane.  Every
+cached map is drawn again.
+
+\param size --- Texels across.
+
+\return False if a framebuffer is not complete.
+
+*/
+
+bool ShadowMaps::resize(int size)
+{
+    GLint saved[2];
+    glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &saved[0]);
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &saved[1]);
+
+    // The atlas stays bound to its unit, the shaders compare against it with linear filtering.
+    glActiveTexture(GL_TEXTURE0 + textureUnit());
+    glBindTexture(GL_TEXTURE_2D, atlas);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_DEPTH_COMPONENT24, size, size, 0, GL_DEPTH_COMPONENT, GL_UNSIGNED_INT, NULL);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glActiveTexture(GL_TEXTURE0);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, cache);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH_COMPONENT24, size, size);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    bool complete = true;
+    for (int i = 0; i < 2; i++)
+    {
+        glBindFramebuffer(GL_FRAMEBUFFER, framebuffers[i]);
+        if (i == 0)
+            glFramebufferTexture2D(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_TEXTURE_2D, atlas, 0);
+        else
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, GL_RENDERBUFFER, cache);
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+        if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        {
+            std::cerr << "The shadow map framebuffer is not complete at " << size << " texels." << std::endl;
+            complete = false;
+        }
+        glClear(GL_DEPTH_BUFFER_BIT);
+    }
+
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, saved[0]);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, saved[1]);
+
+    atlasSize = size;
+    version++;
+    return complete;
+}
+
+/**
+\brief Frees the atlas, the cache, the block buffer and the depth programs.
+
+*/
+
+void ShadowMaps::release()
+{
+    if (atlas)
+    {
+        glDeleteFramebuffers(2, framebuffers);
+        glDeleteRenderbuffers(1, &cache);
+        glDeleteTextures(1, &atlas);
+        glDeleteBuffers(1, &buffer);
+    }
+    for (int i = 0; i < 2; i++)
+    {
+        if (programs[i])
+        {
+            ShaderLibrary::release(programs[i]);
+            glDeleteProgram(programs[i]);
+        }
+        programs[i] = 0;
+        framebuffers[i] = 0;
+    }
+    atlas = 0;
+    cache = 0;
+    buffer = 0;
+    atlasSize = 0;
+    count = 0;
+}
+
+/**
+\brief Removes the lights, called at the start of each frame before they are added.
+
+*/
+
+void ShadowMaps::clear()
+{
+    count = 0;
+    redrawn = 0;
+    for (int i = 0; i < SHADOW_MAX_LT; i++)
+        block.lt[i] = 0;
+}
+
+/**
+\brief Adds a directional or spot light's shadow map for this frame.
+
+A spot's map reaches out to where its fade is down to a thirtysecond, since the spot
+fade of the Phong shaders lights past the cutoff, but no wider than 60 degrees from
+its direction.
+
+\param light --- The light, it must be on.
+\param range --- Far plane of a spot's map, or how far from the camera a directional
+light's map reaches.
+\param size --- Texels across the map, rounded up to a power of two, 0 for the default.
+
+\return The map, -1 for a point light, a light that is off, or when there are already
+SHADOW_MAX_MAPS.
+
+*/
+
+int ShadowMaps::add(Light light, float range, int size)
+{
+    LightType type = light.getType();
+    if (!enabled || !light.getOn() || type == LIGHT_POINT || count >= SHADOW_MAX_MAPS)
+        return -1;
+
+    if (size <= 0)
+        size = defaultSize;
+    int texels = SHADOW_MIN_SIZE;
+    while (texels < size && texels < SHADOW_MAX_ATLAS)
+        texels *= 2;
+
+    if ((int)maps.size() <= count)
+    {
+        ShadowMap fresh = ShadowMap();
+        fresh.cachedX = -1;
+        maps.push_back(fresh);
+    }
+
+    ShadowMap& m = maps[count];
+    m.range = range;
+    m.size = texels;
+    if (type == LIGHT_DIRECTIONAL)
+    {
+        m.position = glm::vec3(0.0f);
+        m.direction = -glm::normalize(glm::vec3(light.getPosition()));
+        m.angle = 0;
+    }
+    else
+    {
+        float cutoff = cos(glm::radians(light.getSpotCutoff()));
+        float reach = cutoff - (1 + cutoff)*(1 - pow(1.0f/32.0f, 1.0f/light.getSpotExponent()));
+        m.position = glm::vec3(light.getPosition());
+        m.direction = glm::normalize(light.getSpotDirection());
+        m.angle = std::min((float)glm::degrees(acos(glm::clamp(reach, -1.0f, 1.0f))), SHADOW_SPOT_MAX_ANGLE);
+    }
+
+    return count++;
+}
+
+/**
+\brief Gives an Lt light of the Phong shaders a shadow map.
+
+\param light --- Index of the light in the Lt array, below SHADOW_MAX_LT.
+\param map --- Map from add, -1 for none.
+
+*/
+
+void ShadowMaps::setLtMap(int light, int map)
+{
+    if (light >= 0 && light < SHADOW_MAX_LT)
+        block.lt[light] = map + 1;
+}
+
+/**
+\brief Places the maps in the atlas in rows, tallest first.
+
+\param size --- Texels across the atlas.
+
+\return False if they do not fit.
+
+*/
+
+bool ShadowMaps::pack(int size)
+{
+    std::vector<int> order;
+    for (int i = 0; i < count; i++)
+        order.push_back(i);
+    std::stable_sort(order.begin(), order.end(), [this](int a, int b) { return maps[a].tile > maps[b].tile; });
+
+    int x = 0;
+    int y = 0;
+    int row = 0;
+    for (size_t i = 0; i < order.size(); i++)
+    {
+        ShadowMap& m = maps[order[i]];
+        if (x + m.tile > size)
+        {
+            x = 0;
+            y += row;
+            row = 0;
+        }
+        if (m.tile > size || y + m.tile > size)
+            return false;
+        m.x = x;
+        m.y = y;
+        x += m.tile;
+        row = std::max(row, m.tile);
+    }
+    return true;
+}
+
+/**
+\brief Points a spot's map down its direction through its angle.
+
+\param m --- The map.
+
+*/
+
+void ShadowMaps::fitSpot(ShadowMap& m)
+{
+    glm::vec3 up = fabs(m.direction.y) > 0.99f ? glm::vec3(1, 0, 0) : glm::vec3(0, 1, 0);
+    glm::mat4 lightView = glm::lookAt(m.position, m.position + m.direction, up);
+    glm::mat4 lightProjection = glm::perspective(glm::radians(2*m.angle), 1.0f, SHADOW_SPOT_NEAR, m.range);
+    m.matrix = lightProjection*lightView;
+}
+
+/**
+\brief Fits a directional light's map tightly around the view out to its range, with
+CalcTightLightProjection, keeping the box of the frames before while the view stays in
+it.  The box is pulled back toward the light so casters between it and the view are
+caught.
+
+\param m --- The map.
+\param view --- View matrix of the frame.
+\param projection --- Perspective projection of the frame.
+
+*/
+
+void ShadowMaps::fitDirectional(ShadowMap& m, const glm::mat4& view, const glm::mat4& projection)
+{
+    // CalcTightLightProjection looks down +z with a horizontal field of view, glm down -z.
+    float fovy = 2*atan(1/projection[1][1]);
+    float aspect = projection[1][1]/projection[0][0];
+    PersProjInfo persProjInfo;
+    persProjInfo.FOV = glm::degrees(2*atan(tan(fovy/2)*aspect));
+    persProjInfo.Width = aspect;
+    persProjInfo.Height = 1;
+    persProjInfo.zNear = projection[3][2]/(projection[2][2] - 1);
+    persProjInfo.zFar = m.range;
+
+    Matrix4f cameraView;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            cameraView.m[i][j] = (i == 2 ? -1 : 1)*view[j][i];
+
+    // The light's up is +y, a light shining straight down is tilted off it a little.
+    glm::vec3 dir = m.direction;
+    if (fabs(dir.y) > 0.999f)
+        dir = glm::normalize(dir + glm::vec3(0.02f, 0, 0));
+    Vector3f lightDir(dir.x, dir.y, dir.z);
+
+    Vector3f lightPos;
+    OrthoProjInfo ortho;
+    CalcTightLightProjection(cameraView, lightDir, persProjInfo, lightPos, ortho);
+
+    // The box is around the light's position, move it into the light's rotated space.
+    Matrix4f rotation;
+    rotation.InitCameraTransform(Vector3f(0, 0, 0), lightDir, Vector3f(0, 1, 0));
+    Vector4f center = rotation*Vector4f(lightPos.x, lightPos.y, lightPos.z, 1.0f);
+    glm::vec3 lo(ortho.l + center.x, ortho.b + center.y, ortho.n + center.z);
+    glm::vec3 hi(ortho.r + center.x, ortho.t + center.y, ortho.f + center.z);
+
+    bool kept = m.boxDirection == m.direction &&
+                lo.x >= m.boxMin.x && lo.y >= m.boxMin.y && lo.z - 0.5f*SHADOW_CASTER_DEPTH >= m.boxMin.z &&
+                hi.x <= m.boxMax.x && hi.y <= m.boxMax.y && hi.z <= m.boxMax.z;
+    if (!kept)
+    {
+        glm::vec3 margin = SHADOW_BOX_MARGIN*(hi - lo);
+        m.boxDirection = m.direction;
+        m.boxMin = lo - margin;
+        m.boxMax = hi + margin;
+        m.boxMin.z = lo.z - SHADOW_CASTER_DEPTH;
+    }
+
+    ortho.l = m.boxMin.x;
+    ortho.r = m.boxMax.x;
+    ortho.b = m.boxMin.y;
+    ortho.t = m.boxMax.y;
+    ortho.n = m.boxMin.z;
+    ortho.f = m.boxMax.z;
+    Matrix4f lightProjection;
+    lightProjection.InitOrthoProjTransform(ortho);
+    Matrix4f lightMatrix = lightProjection*rotation;
+
+    // glm is column major, Matrix4f is row major.
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            m.matrix[j][i] = lightMatrix.m[i][j];
+}
+
+/**
+\brief Places the maps added this frame in the atlas and fits each to its light.  The
+atlas grows when they do not fit, and when it cannot grow further the largest maps are
+halved until they do.
+
+\param view --- View matrix of the frame.
+\param projection --- Perspective projection of the frame.
+
+*/
+
+void ShadowMaps::fit(const glm::mat4& view, const glm::mat4& projection)
+{
+    if (!enabled)
+        return;
+    if (!atlas && !create())
+        count = 0;
+    if (!programs[0] || !programs[1])
+        count = 0;
+
+    for (int i = 0; i < count; i++)
+        maps[i].tile = std::min(maps[i].size, maxAtlas);
+
+    int size = atlasSize;
+    while (!pack(size))
+    {
+        if (size*2 <= maxAtlas)
+        {
+            size *= 2;
+            continue;
+        }
+
+        int largest = 0;
+        for (int i = 0; i < count; i++)
+            largest = std::max(largest, maps[i].tile);
+        if (largest <= SHADOW_MIN_SIZE)
+        {
+            count = 0;
+            break;
+        }
+        for (int i = 0; i < count; i++)
+            if (maps[i].tile == largest)
+                maps[i].tile /= 2;
+    }
+    if (size != atlasSize && !resize(size))
+        count = 0;
+
+    float a = (float)atlasSize;
+    for (int i = 0; i < count; i++)
+    {
+        ShadowMap& m = maps[i];
+        float texelWorld;
+        if (m.angle > 0)
+        {
+            fitSpot(m);
+            texelWorld = 2*tan(glm::radians(m.angle))/m.tile;
+        }
+        else
+        {
+            fitDirectional(m, view, projection);
+            texelWorld = (m.boxMax.x - m.boxMin.x)/m.tile;
+        }
+
+        // Clip space to the map's tile of the atlas, depth to 0 to 1.
+        glm::mat4 toTile(1.0f);
+        toTile[0][0] = 0.5f*m.tile/a;
+        toTile[1][1] = 0.5f*m.tile/a;
+        toTile[2][2] = 0.5f;
+        toTile[3] = glm::vec4((m.x + 0.5f*m.tile)/a, (m.y + 0.5f*m.tile)/a, 0.5f, 1.0f);
+
+        block.matrix[i] = toTile*m.matrix;
+        block.rect[i] = glm::vec4(m.x/a, m.y/a, (m.x + m.tile)/a, (m.y + m.tile)/a);
+        block.params[i] = glm::vec4(texelWorld, 1/a, 0, 0);
+    }
+}
+
+/**
+\brief Has every map draw its static casters again, when the static scene changed.
+
+*/
+
+void ShadowMaps::invalidate()
+{
+    version++;
+}
+
+/**
+\brief Binds a map's tile of a framebuffer, the viewport and scissor on the tile.
+
+\param map --- The map.
+\param framebuffer --- The atlas or the cache framebuffer.
+
+*/
+
+void ShadowMaps::bindTile(int map, GLuint framebuffer)
+{
+    const ShadowMap& m = maps[map];
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(m.x, m.y, m.tile, m.tile);
+    glScissor(m.x, m.y, m.tile, m.tile);
+    glEnable(GL_SCISSOR_TEST);
+}
+
+/**
+\brief Starts the static casters of a map, if the cache does not already hold them for
+the map's light and place.  The first begin of a frame keeps the framebuffer and
+viewport for end and turns on the depth offset against self shadowing.
+
+\param map --- The map.
+
+\return True if the static casters must be drawn now, into the cache.
+
+*/
+
+bool ShadowMaps::beginStatic(int map)
+{
+    if (!drawing)
+    {
+        glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &savedFramebuffers[0]);
+        glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &savedFramebuffers[1]);
+        glGetIntegerv(GL_VIEWPORT, savedViewport);
+        glEnable(GL_DEPTH_TEST);
+        glDepthMask(GL_TRUE);
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(2.0f, 4.0f);
+        drawing = true;
+    }
+
+    current = map;
+    ShadowMap& m = maps[map];
+    if (m.cachedVersion == version && m.cachedX == m.x && m.cachedY == m.y && m.cachedTile == m.tile && m.cached == m.matrix)
+        return false;
+
+    bindTile(map, framebuffers[1]);
+    glClear(GL_DEPTH_BUFFER_BIT);
+    m.cached = m.matrix;
+    m.cachedX = m.x;
+    m.cachedY = m.y;
+    m.cachedTile = m.tile;
+    m.cachedVersion = version;
+    redrawn++;
+    return true;
+}
+
+/**
+\brief Starts the moving casters of a map, after its beginStatic, by copying its static
+casters from the cache into the atlas.
+
+\param map --- The map.
+
+*/
+
+void ShadowMaps::beginDynamic(int map)
+{
+    const ShadowMap& m = maps[map];
+    current = map;
+
+    glDisable(GL_SCISSOR_TEST);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, framebuffers[1]);
+    glBindFramebuffer(GL_DRAW_FRAMEBUFFER, framebuffers[0]);
+    glBlitFramebuffer(m.x, m.y, m.x + m.tile, m.y + m.tile, m.x, m.y, m.x + m.tile, m.y + m.tile,
+                      GL_DEPTH_BUFFER_BIT, GL_NEAREST);
+    bindTile(map, framebuffers[0]);
+}
+
+/**
+\brief Makes a depth program current.
+
+\param skinned --- True for the one that moves vertices by a skinning palette.
+
+*/
+
+void ShadowMaps::useProgram(bool skinned)
+{
+    bound = skinned ? 1 : 0;
+    glUseProgram(programs[bound]);
+}
+
+/**
+\brief Sets the PVM of the current depth program for a caster of the current map.
+
+\param model --- Model matrix of the caster.
+
+*/
+
+void ShadowMaps::setModel(const glm::mat4& model)
+{
+    glm::mat4 pvm = maps[current].matrix*model;
+    glUniformMatrix4fv(pvmLoc[bound], 1, GL_FALSE, glm::value_ptr(pvm));
+}
+
+/**
+\brief Returns the location of PVM in the current depth program.
+
+*/
+
+GLint ShadowMaps::getPVMLocation()
+{
+    return pvmLoc[bound];
+}
+
+/**
+\brief Returns the location of gBones in the skinned depth program, SHADOW_MAX_BONES
+matrices.
+
+*/
+
+GLint ShadowMaps::getBonesLocation()
+{
+    return bonesLoc;
+}
+
+/**
+\brief Finishes the frame's maps, putting back the framebuffer and viewport, and
+uploads the ShadowBlock and binds the atlas for the Phong shaders.  Called every frame
+after fit, even with no maps, so the Lt lights' maps are cleared.
+
+*/
+
+void ShadowMaps::end()
+{
+    if (!enabled || !buffer)
+        return;
+
+    if (drawing)
+    {
+        glDisable(GL_SCISSOR_TEST);
+        glDisable(GL_POLYGON_OFFSET_FILL);
+        glBindFramebuffer(GL_DRAW_FRAMEBUFFER, savedFramebuffers[0]);
+        glBindFramebuffer(GL_READ_FRAMEBUFFER, savedFramebuffers[1]);
+        glViewport(savedViewport[0], savedViewport[1], savedViewport[2], savedViewport[3]);
+        drawing = false;
+    }
+
+    glBindBuffer(GL_UNIFORM_BUFFER, buffer);
+    glBufferData(GL_UNIFORM_BUFFER, sizeof(block), &block, GL_STREAM_DRAW);
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, SHADOW_BLOCK_BINDING, buffer);
+
+    glActiveTexture(GL_TEXTURE0 + textureUnit());
+    glBindTexture(GL_TEXTURE_2D, atlas);
+    glActiveTexture(GL_TEXTURE0);
+}
+
+/**
+\brief Returns the maps of this frame.
+
+*/
+
+int ShadowMaps::getCount()
+{
+    return count;
+}
+
+/**
+\brief Returns the maps whose static casters were drawn this frame, the rest came from
+the cache.
+
+*/
+
+int ShadowMaps::getRedrawnCount()
+{
+    return redrawn;
+}
+
+/**
+\brief Returns the texels across the atlas.
+
+*/
+
+int ShadowMaps::getAtlasSize()
+{
+    return atlasSize;
+}
+
+/**
+\brief Returns a map's light projection times light view, for culling its casters.
+
+\param map --- The map.
+
+*/
+
+glm::mat4 ShadowMaps::getMatrix(int map)
+{
+    return maps[map].matrix;
+}
+
+/**
+\brief Returns a spot's position, the origin for a directional light.
+
+\param map --- The map.
+
+*/
+
+glm::vec3 ShadowMaps::getPosition(int map)
+{
+    return maps[map].position;
+}
+
+/**
+\brief Turns the shadow maps on or off, before the lighting programs are built.
+
+\param on --- True to build them with SHADOWS.
+
+*/
+
+void ShadowMaps::setEnabled(bool on)
+{
+    enabled = on;
+}
+
+/**
+\brief Returns true if the lighting programs are built with SHADOWS.
+
+*/
+
+bool ShadowMaps::isEnabled()
+{
+    return enabled;
+}
+
+/**
+\brief Sets the texels across the map of a light that does not ask for its own size.
+
+\param size --- Texels across, rounded up to a power of two.
+
+*/
+
+void ShadowMaps::setDefaultSize(int size)
+{
+    defaultSize = std::max(size, SHADOW_MIN_SIZE);
+}
+
+/**
+\brief Returns the texels across the map of a light that does not ask for its own size.
+
+*/
+
+int ShadowMaps::getDefaultSize()
+{
+    return defaultSize;
+}
+
+/**
+\brief Returns the defines the lighting programs are built with, "SHADOWS=n SHADOW_LT=m"
+with n SHADOW_MAX_MAPS and m SHADOW_MAX_LT, or "".
+
+*/
+
+std::string ShadowMaps::shaderDefines()
+{
+    return enabled ? "SHADOWS=" + std::to_string(SHADOW_MAX_MAPS) + " SHADOW_LT=" + std::to_string(SHADOW_MAX_LT) : "";
+}
+
+/**
+\brief Points a program's ShadowBlock block and atlas sampler at the binding point and
+texture unit end binds.  Called after a shadowed program is built, a program without
+the block is left as it is.
+
+\param program --- The program.
+
+*/
+
+void ShadowMaps::bindProgram(GLuint program)
+{
+    if (!program)
+        return;
+
+    GLuint index = glGetUniformBlockIndex(program, "ShadowBlock");
+    if (index == GL_INVALID_INDEX)
+        return;
+    glUniformBlockBinding(program, index, SHADOW_BLOCK_BINDING);
+
+    GLint current = 0;
+    glGetIntegerv(GL_CURRENT_PROGRAM, &current);
+    glUseProgram(program);
+    glUniform1i(glGetUniformLocation(program, "shadowAtlas"), textureUnit());
+    glUseProgram(current);
+}
@@ -0,0 +1,169 @@
+#ifndef SHADOWMAPS_H_INCLUDED
+#define SHADOWMAPS_H_INCLUDED
+
+#ifdef __APPLE__
+#include <OpenGL/gl3.h>
+#else
+#include <GL/glew.h>
+#endif // __APPLE__
+
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+#include "Light.h"
+
+/**
+\file ShadowMaps.h
+
+\brief Header file for ShadowMaps.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define SHADOW_MAX_MAPS 16          ///< Most shadow maps in a frame, the rest of the lights cast none.
+#define SHADOW_MAX_LT 12            ///< Most Lt lights of a program that can have a shadow map, a multiple of 4 no less than MaxLights.
+#define SHADOW_BLOCK_BINDING 2      ///< Uniform buffer binding point of the ShadowBlock block.
+#define SHADOW_DEFAULT_SIZE 1024    ///< Texels across a shadow map when the light does not ask for a size.
+#define SHADOW_MIN_SIZE 128         ///< Smallest a map is shrunk to when the atlas is full.
+#define SHADOW_MAX_ATLAS 8192       ///< Largest the atlas grows, texels across.
+
+/**
+\brief The ShadowBlock uniform block, std140.
+
+*/
+
+struct ShadowBlock
+{
+    glm::mat4 matrix[SHADOW_MAX_MAPS];  ///< World to atlas texture coordinates and depth of each map.
+    glm::vec4 rect[SHADOW_MAX_MAPS];    ///< Atlas rectangle of each map, minimum and maximum corner.
+    glm::vec4 params[SHADOW_MAX_MAPS];  ///< World size of a texel, at distance 1 for a spot, and texel size in the atlas.
+    GLint lt[SHADOW_MAX_LT];            ///< Map of each Lt light plus one, 0 for none, read as ivec4s.
+};
+
+/**
+\brief A shadow map of the frame, where it is in the atlas and what it was last drawn for.
+
+*/
+
+struct ShadowMap
+{
+    glm::vec3 position;         ///< Spot position, unused for a directional light.
+    glm::vec3 direction;        ///< Unit direction the light shines in.
+    float angle;                ///< Half angle of the spot's frustum, degrees, 0 for a directional light.
+    float range;                ///< Far plane of a spot, shadow distance from the camera of a directional light.
+    int size;                   ///< Texels across asked for.
+    int tile;                   ///< Texels across it got in the atlas.
+    int x;                      ///< Atlas column of its corner.
+    int y;                      ///< Atlas row of its corner.
+    glm::mat4 matrix;           ///< Projection times view of the light, world to clip space.
+    glm::mat4 cached;           ///< Matrix the static casters in the cache were drawn with.
+    int cachedX;                ///< Atlas corner and size of the cached static casters, -1 for none.
+    int cachedY;                ///< Atlas row of the cached static casters.
+    int cachedTile;             ///< Texels across the cached static casters.
+    int cachedVersion;          ///< ShadowMaps version the cached static casters were drawn at.
+    glm::vec3 boxDirection;     ///< Direction a directional light's box was fit for.
+    glm::vec3 boxMin;           ///< Minimum corner of the box, in the light's rotated space.
+    glm::vec3 boxMax;           ///< Maximum corner of the box.
+};
+
+/**
+\class ShadowMaps
+
+\brief Shadow maps of the directional and spot lights, packed into one depth atlas and
+read by the Phong shaders built with SHADOWS (PhongLights.glsl).
+
+Each frame the lights are added after clear, each asking for its own resolution so
+quality can be traded against frame time light by light, and fit places them.  A spot
+light gets a perspective map from its position through the angle its fade reaches.  A
+directional light gets a tight orthographic map around the part of the view within its
+range, found with CalcTightLightProjection, whose box is kept while the view stays
+inside it grown by a margin.  The maps are packed into rows of the atlas, which grows
+when they do not fit and shrinks the maps when it cannot grow.
+
+The casters are drawn in two passes a map with the minimal ShadowDepth shaders, the
+SKINNED one taking a skinning palette.  Static casters are drawn into a cache the size
+of the atlas only when the map's light or place changed or invalidate was called, and
+copied into the atlas each frame before the moving casters are drawn on top, so a
+still light costs one copy and the moving casters.
+
+Texture and buffer objects are made on the first fit and freed by release, which must
+be called with the context current.  Only the render thread may use it.
+
+*/
+
+class ShadowMaps
+{
+private:
+    static bool enabled;                    ///< Programs are built with SHADOWS.
+    static int defaultSize;                 ///< Texels across a map with no size of its own.
+    static GLint unit;                      ///< Texture unit of the atlas.
+
+    std::vector<ShadowMap> maps;            ///< Maps of this frame, the first count of them in use.
+    int count;                              ///< Maps added since clear.
+    ShadowBlock block;                      ///< Block uploaded by end.
+    GLuint atlas;                           ///< Depth texture the shaders read.
+    GLuint cache;                           ///< Depth renderbuffer of the static casters.
+    GLuint framebuffers[2];                 ///< Framebuffers of the atlas and the cache.
+    GLuint buffer;                          ///< ShadowBlock uniform buffer.
+    GLuint programs[2];                     ///< Depth programs, plain and SKINNED.
+    GLint pvmLoc[2];                        ///< PVM of each depth program.
+    GLint bonesLoc;                         ///< gBones of the skinned depth program.
+    int bound;                              ///< Depth program in use, 1 for the skinned one.
+    int maxAtlas;                           ///< Largest the atlas may grow on this context.
+    int atlasSize;                          ///< Texels across the atlas.
+    int version;                            ///< Bumped by invalidate, cached casters of older versions are redrawn.
+    int redrawn;                            ///< Maps whose static casters were drawn this frame.
+    int current;                            ///< Map the last begin bound.
+    GLint savedFramebuffers[2];             ///< Draw and read framebuffers before the first begin.
+    GLint savedViewport[4];                 ///< Viewport before the first begin.
+    bool drawing;                           ///< Between a begin and end.
+
+    static GLint textureUnit();
+
+    bool create();
+    bool resize(int size);
+    bool pack(int size);
+    void fitSpot(ShadowMap& m);
+    void fitDirectional(ShadowMap& m, const glm::mat4& view, const glm::mat4& projection);
+    void bindTile(int map, GLuint framebuffer);
+
+public:
+    ShadowMaps();
+    ~ShadowMaps();
+
+    void release();
+
+    void clear();
+    int add(Light light, float range, int size = 0);
+    void setLtMap(int light, int map);
+    void fit(const glm::mat4& view, const glm::mat4& projection);
+    void invalidate();
+
+    bool beginStatic(int map);
+    void beginDynamic(int map);
+    void useProgram(bool skinned);
+    void setModel(const glm::mat4& model);
+    GLint getPVMLocation();
+    GLint getBonesLocation();
+    void end();
+
+    int getCount();
+    int getRedrawnCount();
+    int getAtlasSize();
+    glm::mat4 getMatrix(int map);
+    glm::vec3 getPosition(int map);
+
+    static void setEnabled(bool on);
+    static bool isEnabled();
+    static void setDefaultSize(int size);
+    static int getDefaultSize();
+    static std::string shaderDefines();
+    static void bindProgram(GLuint program);
+};
+
+#endif // SHADOWMAPS_H_INCLUDED
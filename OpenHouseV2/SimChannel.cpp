@@ -0,0 +1,132 @@
+#include "SimChannel.h"
+
+#include <string.h>
+
+/**
+\file SimChannel.cpp
+\brief Lock-free containers passing input to the simulation thread and snapshots back
+to the render thread.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define SB_FRESH 4   ///< Flag on the spare index of SnapshotBuffer for an unread snapshot.
+
+/**
+\brief Constructor, creates an empty ring.
+
+*/
+
+InputRing::InputRing()
+{
+    head.store(0);
+    tail.store(0);
+}
+
+/**
+\brief Adds an input to the ring, called by the producer only.
+
+\param in --- Input to add.
+
+\return False if the ring was full and the input was dropped.
+
+*/
+
+bool InputRing::push(const SimInput& in)
+{
+    unsigned int h = head.load(std::memory_order_relaxed);
+    unsigned int t = tail.load(std::memory_order_acquire);
+
+    if (h - t >= SIM_INPUT_RING_SIZE)
+        return false;
+
+    items[h & (SIM_INPUT_RING_SIZE - 1)] = in;
+    head.store(h + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+\brief Takes the oldest input from the ring, called by the consumer only.
+
+\param out --- Set to the input.
+
+\return False if the ring was empty.
+
+*/
+
+bool InputRing::pop(SimInput& out)
+{
+    unsigned int t = tail.load(std::memory_order_relaxed);
+    unsigned int h = head.load(std::memory_order_acquire);
+
+    if (t == h)
+        return false;
+
+    out = items[t & (SIM_INPUT_RING_SIZE - 1)];
+    tail.store(t + 1, std::memory_order_release);
+    return true;
+}
+
+/**
+\brief Constructor, zeroes the three slots.
+
+*/
+
+SnapshotBuffer::SnapshotBuffer()
+{
+    memset(slots, 0, sizeof(slots));
+    writeIndex = 0;
+    spare.store(1);
+    readIndex = 2;
+}
+
+/**
+\brief Returns the slot the writer fills next.
+
+*/
+
+SimSnapshot& SnapshotBuffer::writeSlot()
+{
+    return slots[writeIndex];
+}
+
+/**
+\brief Publishes the write slot and takes the spare slot to write next.
+
+*/
+
+void SnapshotBuffer::publish()
+{
+    int old = spare.exchange(writeIndex | SB_FRESH, std::memory_order_acq_rel);
+    writeIndex = old & 3;
+}
+
+/**
+\brief Takes the latest published snapshot if there is one the reader has not seen.
+
+\return True if read now returns a newer snapshot.
+
+*/
+
+bool SnapshotBuffer::acquire()
+{
+    if (!(spare.load(std::memory_order_relaxed) & SB_FRESH))
+        return false;
+
+    int old = spare.exchange(readIndex, std::memory_order_acq_rel);
+    readIndex = old & 3;
+    return true;
+}
+
+/**
+\brief Returns the snapshot the reader holds, valid until the next acquire.
+
+*/
+
+const SimSnapshot& SnapshotBuffer::read()
+{
+    return slots[readIndex];
+}
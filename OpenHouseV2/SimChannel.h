@@ -0,0 +1,160 @@
+#ifndef SIMCHANNEL_H_INCLUDED
+#define SIMCHANNEL_H_INCLUDED
+
+#include <atomic>
+
+/**
+\file SimChannel.h
+
+\brief Header file for SimChannel.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+#define SIM_INPUT_RING_SIZE 256   ///< Capacity of the input ring, must be a power of 2.
+
+/**
+\brief Kinds of input sent from the event loop to the simulation thread.
+
+*/
+
+enum SimInputType
+{
+    SIM_MOVE,             ///< a = forward, b = backward
+    SIM_PUNCH,
+    SIM_KICK,
+    SIM_TORNADO,
+    SIM_JUMP,
+    SIM_RESTART,
+    SIM_PAUSE,
+    SIM_MENU_RIGHT,
+    SIM_MENU_LEFT,
+    SIM_MENU_SELECT,
+    SIM_MENU_BACK,
+    SIM_RETURN_TO_MENU,
+    SIM_SET_FIGHTER,      ///< a = fighter index
+    SIM_RECORD,           ///< Start or stop recording, handled by the engine and never recorded
+    SIM_REPLAY            ///< Replay the last recording, handled by the engine and never recorded
+};
+
+/**
+\brief One input event, applied by the simulation thread before its next tick.
+
+*/
+
+struct SimInput
+{
+    int type;     ///< One of SimInputType.
+    int player;   ///< Player the input is for.
+    int a;        ///< First argument, depends on the type.
+    int b;        ///< Second argument, depends on the type.
+};
+
+/**
+\brief Continuous game state that is blended between ticks for drawing.
+
+*/
+
+struct SimState
+{
+    float fighterX[2];          ///< Fighter positions.
+    float fighterHeight[2];     ///< Fighter jump heights.
+    float rotations[24][3];     ///< Limb rotations of both fighters.
+    float carX[2];              ///< Positions of the two cars in arena one.
+    float carAngle[2];          ///< Headlight sweep angles of the two cars.
+    float menuAngle;            ///< Spin of the menu blades.
+    float cameraX;              ///< Menu camera x.
+    float cameraZ;              ///< Menu camera z.
+};
+
+/**
+\brief Everything the renderer needs from one simulation step.
+
+A snapshot is written by the simulation thread and is never changed once it is
+published, so the render thread can read it without locking.
+
+*/
+
+struct SimSnapshot
+{
+    SimState prev;        ///< State before the last tick.
+    SimState cur;         ///< State after the last tick.
+    double tickTime;      ///< Time of the last tick on the engine's shared clock, in seconds.
+    long long tick;       ///< Number of ticks run when the snapshot was taken.
+
+    float hp[2];          ///< HP shown on each player's health bar.
+    bool stunned[2];      ///< True while a player's health bar should flash.
+    int animation[2];     ///< Animation index for each player's skinned mesh.
+
+    int arenaNum;         ///< Arena being played, 3 is the menu.
+    int cameraPos;        ///< Menu position.
+    int curFIndex[2];     ///< Fighter selected by each player.
+    bool paused;          ///< Game paused.
+    bool gameOver;        ///< Game over.
+
+    bool netPlay;         ///< True during a network match.
+    int rollbackDepth;    ///< Deepest rollback since the last snapshot, in ticks.
+    float resimMs;        ///< Time spent simulating ticks again since the last snapshot, in milliseconds.
+    float pingMs;         ///< Round trip time to the other player, in milliseconds.
+    int fighterVersion;   ///< Counts the times the game logic reloaded the fighter files.
+};
+
+/**
+\class InputRing
+
+\brief Lock-free single producer, single consumer ring of SimInput.
+
+The event loop is the only writer of head and the simulation thread is the only writer
+of tail, so neither side ever waits on the other.  If the ring is full the input is
+dropped, which only happens if the simulation thread has stopped.
+
+*/
+
+class InputRing
+{
+private:
+    SimInput items[SIM_INPUT_RING_SIZE];   ///< Ring storage.
+    std::atomic<unsigned int> head;        ///< Next slot to write, owned by the producer.
+    std::atomic<unsigned int> tail;        ///< Next slot to read, owned by the consumer.
+
+public:
+    InputRing();
+
+    bool push(const SimInput& in);
+    bool pop(SimInput& out);
+};
+
+/**
+\class SnapshotBuffer
+
+\brief Lock-free triple buffer of SimSnapshot.
+
+The writer fills its own slot and publishes it by swapping it with the spare slot.  The
+reader takes the spare slot in exchange for the one it is done with, but only when a
+new snapshot has been published since, so it always sees the latest complete snapshot
+and the writer never waits for the reader to finish a frame.
+
+*/
+
+class SnapshotBuffer
+{
+private:
+    SimSnapshot slots[3];       ///< Snapshot storage.
+    std::atomic<int> spare;     ///< Index of the spare slot, SB_FRESH is set when it holds a new snapshot.
+    int writeIndex;             ///< Slot owned by the writer.
+    int readIndex;              ///< Slot owned by the reader.
+
+public:
+    SnapshotBuffer();
+
+    SimSnapshot& writeSlot();
+    void publish();
+
+    bool acquire();
+    const SimSnapshot& read();
+};
+
+#endif // SIMCHANNEL_H_INCLUDED
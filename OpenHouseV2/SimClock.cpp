@@ -0,0 +1,136 @@
+#include "SimClock.h"
+
+#include <math.h>
+
+/**
+\file SimClock.cpp
+\brief Fixed timestep clock for the game logic.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor
+
+\param hz --- Number of ticks per second.
+
+*/
+
+SimClock::SimClock(double hz)
+{
+    setRate(hz);
+    maxFrameSeconds = 0.25;
+    reset();
+}
+
+/**
+\brief Sets the number of ticks per second.
+
+\param hz --- Number of ticks per second, must be positive.
+
+*/
+
+void SimClock::setRate(double hz)
+{
+    if (hz > 0)
+        tickSeconds = 1.0 / hz;
+}
+
+/**
+\brief Returns the length of one tick in seconds.
+
+*/
+
+double SimClock::getTickSeconds()
+{
+    return tickSeconds;
+}
+
+/**
+\brief Sets the longest frame time that will be simulated.
+
+\param sec --- Frame time in seconds, anything longer is dropped.
+
+*/
+
+void SimClock::setMaxFrameTime(double sec)
+{
+    maxFrameSeconds = sec;
+}
+
+/**
+\brief Adds the real time since the last call and returns the number of ticks to run.
+
+The whole ticks are taken out of the accumulator, what is left over is used by
+getAlpha until the next call.
+
+*/
+
+int SimClock::advance()
+{
+    double elapsed = clock.restart().asSeconds();
+    if (elapsed > maxFrameSeconds)
+        elapsed = maxFrameSeconds;
+
+    accumulator += elapsed;
+
+    int steps = (int)(accumulator / tickSeconds);
+    accumulator -= steps * tickSeconds;
+    ticks += steps;
+
+    return steps;
+}
+
+/**
+\brief Returns how far the current frame is between the last two ticks, from 0 to 1.
+
+*/
+
+float SimClock::getAlpha()
+{
+    return (float)(accumulator / tickSeconds);
+}
+
+/**
+\brief Returns the number of ticks run since the last reset.
+
+*/
+
+long long SimClock::getTickCount()
+{
+    return ticks;
+}
+
+/**
+\brief Clears the accumulator and tick count and restarts the real time clock.
+
+*/
+
+void SimClock::reset()
+{
+    clock.restart();
+    accumulator = 0;
+    ticks = 0;
+}
+
+/**
+\brief Blends a value between its state at the last two ticks.
+
+\param prev --- Value before the last tick.
+\param cur --- Value after the last tick.
+\param alpha --- Blend factor from getAlpha.
+\param snap --- If the value jumped by more than this in one tick (a wrap around or a
+reset) the current value is used as is, 0 to always blend.
+
+*/
+
+float SimClock::lerp(float prev, float cur, float alpha, float snap)
+{
+    if (snap > 0 && fabs(cur - prev) > snap)
+        return cur;
+
+    return prev + (cur - prev) * alpha;
+}
@@ -0,0 +1,58 @@
+#ifndef SIMCLOCK_H_INCLUDED
+#define SIMCLOCK_H_INCLUDED
+
+#include <SFML/System.hpp>
+
+#include "ProgramDefines.h"
+
+/**
+\file SimClock.h
+
+\brief Header file for SimClock.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\class SimClock
+
+\brief Fixed timestep clock that keeps the game logic running at the same speed
+regardless of the frame rate.
+
+Each frame the real time since the last frame is added to an accumulator and advance
+returns how many whole ticks fit in it.  The caller runs the game logic that many
+times and then draws with getAlpha, the fraction of a tick left over, to blend the
+state before and after the last tick.  Long frames (window drags, breakpoints,
+loading) are clamped so the game slows down instead of trying to catch up on
+hundreds of ticks at once.
+
+*/
+
+class SimClock
+{
+private:
+    sf::Clock clock;          ///< Real time since the last call to advance.
+    double tickSeconds;       ///< Length of one tick in seconds.
+    double accumulator;       ///< Real time not yet consumed by ticks.
+    double maxFrameSeconds;   ///< Longest frame time added to the accumulator.
+    long long ticks;          ///< Number of ticks run since the last reset.
+
+public:
+    SimClock(double hz = SimTickRate);
+
+    void setRate(double hz);
+    double getTickSeconds();
+    void setMaxFrameTime(double sec);
+
+    int advance();
+    float getAlpha();
+    long long getTickCount();
+    void reset();
+
+    static float lerp(float prev, float cur, float alpha, float snap);
+};
+
+#endif // SIMCLOCK_H_INCLUDED
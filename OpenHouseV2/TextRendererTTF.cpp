@@ -236,6 +236,7 @@ void TextRendererTTF::setColor(GLfloat c[4])
 void TextRendererTTF::loadFont(std::string fontFile)
 {
     fontLoadError = GL_FALSE;
+    clearCache();
     FILE* infile = fopen(fontFile.c_str(), "rb");
 
     if (!infile)
@@ -358,6 +359,9 @@ void TextRendererTTF::draw(const char* text, GLuint xpos, GLuint ypos, GLfloat r
     glBindBuffer(GL_ARRAY_BUFFER, TextVBO);
     glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 0, 0);
 
+    bool hasKerning = FT_HAS_KERNING(face);
+    FT_UInt prev = 0;
+
     /* Loop through all characters */
     for (p = text; *p; p++)
     {
@@ -365,6 +369,16 @@ void TextRendererTTF::draw(const char* text, GLuint xpos, GLuint ypos, GLfloat r
         if (FT_Load_Char(face, *p, FT_LOAD_RENDER))
             continue;
 
+        /* Apply kerning so the drawn string matches textWidth */
+        FT_UInt glyph = FT_Get_Char_Index(face, (unsigned char)*p);
+        if (hasKerning && prev && glyph)
+        {
+            FT_Vector delta;
+            FT_Get_Kerning(face, prev, glyph, FT_KERNING_DEFAULT, &delta);
+            x += delta.x >> 6;
+        }
+        prev = glyph;
+
         /* Upload the "bitmap", which contains an 8-bit grayscale image, as an alpha texture */
         glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, g->bitmap.width, g->bitmap.rows, 0, GL_RED, GL_UNSIGNED_BYTE, g->bitmap.buffer);
 
@@ -423,24 +437,209 @@ positions and sizes to correspond to pixels.
 */
 
 int TextRendererTTF::textWidth(const char* text)
+{
+    return textWidth(text, fontSize);
+}
+
+/**
+\brief Returns the pixel width of the text using the current font at the given size.
+
+Widths come from the per-size metrics cache, so after the first call for a size no
+glyphs are loaded or rasterized.  Kerning is included when the font provides it.
+
+\param text --- char* type string to be analyzed.
+\param sz --- Font size in pixels to measure with.
+
+*/
+
+int TextRendererTTF::textWidth(const char* text, GLuint sz)
 {
     if (isError())
         return 0;
 
-    FT_Set_Pixel_Sizes(face, 0, fontSize);
-    FT_GlyphSlot g = face->glyph;
-    const char *p;
-    int  x = 0;
+    return measure(sz, text);
+}
 
-    for (p = text; *p; p++)
+/**
+\brief Returns the cached glyph metrics for a font size, creating an empty entry
+if this size has not been measured before.
+
+\param sz --- Font size in pixels.
+
+*/
+
+TextRendererTTFMetrics& TextRendererTTF::getMetrics(GLuint sz)
+{
+    std::map<GLuint, TextRendererTTFMetrics>::iterator it = metricsCache.find(sz);
+    if (it != metricsCache.end())
+        return it->second;
+
+    TextRendererTTFMetrics& m = metricsCache[sz];
+    for (int i = 0; i < 128; i++)
     {
-        /* Try to load and render the character */
-        if (FT_Load_Char(face, *p, FT_LOAD_RENDER))
-            continue;
+        m.advance[i] = -1;
+        m.glyphIndex[i] = 0;
+    }
 
-        /* Advance the cursor to the start of the next character */
-        x += g->advance.x >> 6;
+    return m;
+}
+
+/**
+\brief Sums the advances and kerning of a string using a metrics table, loading
+any glyph that is missing from the table.
+
+Missing glyphs are loaded with FT_LOAD_DEFAULT, which gives the same hinted advance
+as FT_LOAD_RENDER without producing the bitmap.
+
+\param sz --- Font size in pixels being measured.
+\param text --- char* type string to be analyzed.
+
+*/
+
+int TextRendererTTF::measure(GLuint sz, const char* text)
+{
+    TextRendererTTFMetrics& m = getMetrics(sz);
+    bool sizeSet = false;
+    bool hasKerning = FT_HAS_KERNING(face);
+    FT_UInt prev = 0;
+    int x = 0;
+
+    for (const char* p = text; *p; p++)
+    {
+        unsigned char c = (unsigned char)*p;
+        FT_UInt glyph;
+        int adv;
+
+        if (c < 128 && m.advance[c] >= 0)
+        {
+            glyph = m.glyphIndex[c];
+            adv = m.advance[c];
+        }
+        else
+        {
+            if (!sizeSet)
+            {
+                FT_Set_Pixel_Sizes(face, 0, sz);
+                sizeSet = true;
+            }
+
+            glyph = FT_Get_Char_Index(face, c);
+            if (FT_Load_Glyph(face, glyph, FT_LOAD_DEFAULT))
+                continue;
+
+            adv = face->glyph->advance.x >> 6;
+            if (c < 128)
+            {
+                m.advance[c] = adv;
+                m.glyphIndex[c] = glyph;
+            }
+        }
+
+        if (hasKerning && prev && glyph)
+        {
+            unsigned long key = ((unsigned long)prev << 16) | glyph;
+            std::map<unsigned long, int>::iterator k = m.kern.find(key);
+            if (k != m.kern.end())
+                x += k->second;
+            else
+            {
+                if (!sizeSet)
+                {
+                    FT_Set_Pixel_Sizes(face, 0, sz);
+                    sizeSet = true;
+                }
+
+                FT_Vector delta;
+                FT_Get_Kerning(face, prev, glyph, FT_KERNING_DEFAULT, &delta);
+                m.kern[key] = delta.x >> 6;
+                x += delta.x >> 6;
+            }
+        }
+
+        x += adv;
+        prev = glyph;
     }
 
+    /* Leave the face at the current draw size if we had to change it */
+    if (sizeSet && sz != fontSize)
+        FT_Set_Pixel_Sizes(face, 0, fontSize);
+
     return x;
 }
+
+/**
+\brief Returns the largest font size whose rendering of the text fits in the given width.
+
+Text width grows monotonically with font size, so the size is found by a binary search
+over [minSize, maxSize], taking O(log(maxSize - minSize)) cached measurements instead of
+stepping the size down one pixel at a time.
+
+\param text --- char* type string to be fit.
+\param maxWidth --- Maximum width in pixels.
+\param maxSize --- Largest font size to consider.
+\param minSize --- Optional, smallest font size to consider, returned if nothing fits.
+
+*/
+
+GLuint TextRendererTTF::fitFontSize(const char* text, int maxWidth, GLuint maxSize, GLuint minSize)
+{
+    if (isError() || maxSize <= minSize)
+        return minSize;
+
+    GLuint lo = minSize;
+    GLuint hi = maxSize;
+
+    while (lo < hi)
+    {
+        GLuint mid = lo + (hi - lo + 1) / 2;
+
+        if (textWidth(text, mid) <= maxWidth)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return lo;
+}
+
+/**
+\brief Returns the fitted font size and width of a string, caching the result so that
+strings which do not change between frames are only laid out once.
+
+\param text --- String to be fit.
+\param maxWidth --- Maximum width in pixels, usually a fraction of the screen width.
+\param maxSize --- Largest font size to consider.
+
+\note The cached entry is reused only while the width and size limits match, so a
+window resize simply replaces it.
+
+*/
+
+TextRendererTTFLayout TextRendererTTF::layoutText(std::string text, int maxWidth, GLuint maxSize)
+{
+    std::map<std::string, TextRendererTTFLayout>::iterator it = layoutCache.find(text);
+    if (it != layoutCache.end() && it->second.maxWidth == maxWidth && it->second.maxSize == maxSize)
+        return it->second;
+
+    TextRendererTTFLayout layout;
+    layout.maxWidth = maxWidth;
+    layout.maxSize = maxSize;
+    layout.fontSize = fitFontSize(text.c_str(), maxWidth, maxSize);
+    layout.width = textWidth(text.c_str(), layout.fontSize);
+
+    if (!isError())
+        layoutCache[text] = layout;
+
+    return layout;
+}
+
+/**
+\brief Empties the glyph metrics and layout caches, needed whenever the font changes.
+
+*/
+
+void TextRendererTTF::clearCache()
+{
+    metricsCache.clear();
+    layoutCache.clear();
+}
@@ -13,6 +13,7 @@
 #include <string>
 #include <iostream>
 #include <fstream>
+#include <map>
 
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -61,6 +62,39 @@ struct TextRendererTTFPoint
 };
 
 
+/**
+\class TextRendererTTFMetrics
+
+\brief Cached horizontal glyph metrics for a single pixel size of the loaded font.
+
+Advances are filled in lazily for the 7-bit ASCII range, a value of -1 meaning the
+glyph has not been measured yet.  Kerning pairs are keyed by (left << 16 | right)
+glyph indices and are only stored once they have been queried.
+
+*/
+
+struct TextRendererTTFMetrics
+{
+    int advance[128];                   ///< Advance in pixels of each ASCII character, -1 if not loaded.
+    FT_UInt glyphIndex[128];            ///< FreeType glyph index of each ASCII character.
+    std::map<unsigned long, int> kern;  ///< Kerning adjustment in pixels for glyph index pairs.
+};
+
+/**
+\class TextRendererTTFLayout
+
+\brief Result of fitting a string into a maximum pixel width.
+
+*/
+
+struct TextRendererTTFLayout
+{
+    int maxWidth;     ///< Width the string was fit into.
+    GLuint maxSize;   ///< Upper bound on the font size used for the fit.
+    GLuint fontSize;  ///< Largest font size that fits the requested width.
+    int width;        ///< Pixel width of the string at that font size.
+};
+
 /**
 \class TextRendererTTF
 
@@ -113,6 +147,12 @@ private:
     FT_Library ft;            ///< Freetype Library variable.
     FT_Face face;             ///< Freetype font face variable.
 
+    std::map<GLuint, TextRendererTTFMetrics> metricsCache;  ///< Glyph metrics per pixel size.
+    std::map<std::string, TextRendererTTFLayout> layoutCache;  ///< Fitted layouts of static strings.
+
+    TextRendererTTFMetrics& getMetrics(GLuint sz);
+    int measure(GLuint sz, const char* text);
+
 public:
     TextRendererTTF(std::string fontFile = "");
     ~TextRendererTTF();
@@ -127,6 +167,11 @@ public:
 
     int textWidth(std::string text);
     int textWidth(const char* text);
+    int textWidth(const char* text, GLuint sz);
+
+    GLuint fitFontSize(const char* text, int maxWidth, GLuint maxSize, GLuint minSize = 1);
+    TextRendererTTFLayout layoutText(std::string text, int maxWidth, GLuint maxSize);
+    void clearCache();
 
     void draw(std::string text, GLuint xpos, GLuint ypos, GLfloat rot = 0);
     void draw(const char* text, GLuint xpos, GLuint ypos, GLfloat rot = 0);
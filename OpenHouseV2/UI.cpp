@@ -46,6 +46,8 @@ method, outside the event loop.
 
 void UI::processEvents()
 {
+    PROFILE_SCOPE("processEvents");
+
     // Process user events
     sf::Event event;
     while (ge->pollEvent(event))
@@ -113,15 +115,15 @@ void UI::processJoystickMoved(sf::Event::JoystickMoveEvent joystickMoved)
         {
             if (joystickMoved.position == 100)
             {
-                ge->fighterClass[joystickMoved.joystickId].fighterMoveX(joystickMoved.joystickId, 1, 0);
+                ge->sendInput(SIM_MOVE, joystickMoved.joystickId, 1, 0);
             }
             else if (joystickMoved.position == -100)
             {
-                ge->fighterClass[joystickMoved.joystickId].fighterMoveX(joystickMoved.joystickId, 0, 1);
+                ge->sendInput(SIM_MOVE, joystickMoved.joystickId, 0, 1);
             }
             else if (joystickMoved.position == 0)
             {
-            ge->fighterClass[joystickMoved.joystickId].fighterMoveX(joystickMoved.joystickId, 0, 0);
+            ge->sendInput(SIM_MOVE, joystickMoved.joystickId, 0, 0);
             }
         }
     }
@@ -192,28 +194,28 @@ void UI::processJoystickButtonPressed(sf::Event::JoystickButtonEvent joystickBut
     //std::cout << "Joystick: " << joystickButtonEvent.joystickId << "   Button Pressed: " << joystickButtonEvent.button << std::endl;
     if (!(ge->getArenaNum() == 3)){
         if (joystickButtonEvent.button == 2 && joystickButtonEvent.joystickId == 0)
-            ge->fighterClass[joystickButtonEvent.joystickId].punchNow(0);
+            ge->sendInput(SIM_PUNCH, 0);
 
         if (joystickButtonEvent.button == 2 && joystickButtonEvent.joystickId == 1)
-            ge->fighterClass[joystickButtonEvent.joystickId].punchNow(1);
+            ge->sendInput(SIM_PUNCH, 1);
 
         if(joystickButtonEvent.button == 3 && joystickButtonEvent.joystickId == 0)
-            ge->fighterClass[joystickButtonEvent.joystickId].kickNow(0);
+            ge->sendInput(SIM_KICK, 0);
 
         if(joystickButtonEvent.button == 3 && joystickButtonEvent.joystickId == 1)
-            ge->fighterClass[joystickButtonEvent.joystickId].kickNow(1);
+            ge->sendInput(SIM_KICK, 1);
 
         if(joystickButtonEvent.button == 1 && joystickButtonEvent.joystickId == 0)
-            ge->fighterClass[joystickButtonEvent.joystickId].tornadoNow(0);
+            ge->sendInput(SIM_TORNADO, 0);
 
         if(joystickButtonEvent.button == 1 && joystickButtonEvent.joystickId == 1)
-            ge->fighterClass[joystickButtonEvent.joystickId].tornadoNow(1);
+            ge->sendInput(SIM_TORNADO, 1);
 
         if (joystickButtonEvent.button == 6)
-            ge->restartGame();
+            ge->sendInput(SIM_RESTART);
 
         if (joystickButtonEvent.button == 7)
-            ge->togglePause();
+            ge->sendInput(SIM_PAUSE);
     }
 
 }
@@ -306,6 +308,17 @@ void UI::processMouseButtonReleased(sf::Event::MouseButtonEvent mouseButtonEvent
 - F10: Saves a screen shot of the graphics window to a png file.
 - P: Toggles the Game Pause
 - R: Restarts the Game if it is over
+- F1: Toggles the overdraw heat map, with Shift the depth pre-pass
+- F3: Toggles the frame time graph
+- F4: Saves the last frames timed by the profiler to a Chrome trace file
+- F12: Captures the OpenGL calls of the next frame to a file for bench/GLReplay
+- F2: Starts or stops recording the match to a y4m video, with Shift to raw RGB frames
+- F5: Toggles the crowd in the bath house
+- F6: Toggles automatic render resolution scaling
+- F7: Lowers the render resolution scale
+- F8: Raises the render resolution scale
+- F9: Starts a recording of the input from the main menu, or stops and saves it
+- F11: Replays the last recording
 
 Fighter One Keyboard Controls
 
@@ -331,9 +344,56 @@ void UI::keyPressed(sf::Event::KeyEvent keyevent)
         ge->screenshot();
         break;
 
+    case sf::Keyboard::F1:
+        if (keyevent.shift)
+            ge->toggleDepthPrepass();
+        else
+            ge->toggleOverdraw();
+        break;
+
+    case sf::Keyboard::F3:
+        ge->toggleProfiler();
+        break;
+
+    case sf::Keyboard::F4:
+        ge->saveTrace();
+        break;
+
+    case sf::Keyboard::F12:
+        ge->captureFrame();
+        break;
+
+    case sf::Keyboard::F2:
+        ge->toggleVideoRecording(keyevent.shift);
+        break;
+
+    case sf::Keyboard::F5:
+        ge->toggleCrowd();
+        break;
+
+    case sf::Keyboard::F6:
+        ge->toggleAutoScale();
+        break;
+
+    case sf::Keyboard::F7:
+        ge->changeRenderScale(-0.125);
+        break;
+
+    case sf::Keyboard::F8:
+        ge->changeRenderScale(0.125);
+        break;
+
+    case sf::Keyboard::F9:
+        ge->sendInput(SIM_RECORD);
+        break;
+
+    case sf::Keyboard::F11:
+        ge->sendInput(SIM_REPLAY);
+        break;
+
     case sf::Keyboard::P:
         if (!(ge->getArenaNum() == 3))
-            ge->togglePause();
+            ge->sendInput(SIM_PAUSE);
         break;
 
     case sf::Keyboard::M:
@@ -342,67 +402,67 @@ void UI::keyPressed(sf::Event::KeyEvent keyevent)
 
     case sf::Keyboard::R:
         if (!(ge->getArenaNum() == 3))
-            ge->restartGame();
+            ge->sendInput(SIM_RESTART);
         break;
     case sf::Keyboard::B:
         if (!(ge->getArenaNum() == 3))
-            ge->fighterClass[1].punchNow(1);
+            ge->sendInput(SIM_PUNCH, 1);
         break;
     case sf::Keyboard::K:
         if (!(ge->getArenaNum() == 3))
-            ge->fighterClass[1].kickNow(1);
+            ge->sendInput(SIM_KICK, 1);
         break;
     case sf::Keyboard::O:
         if (!(ge->getArenaNum() == 3))
-            ge->fighterClass[1].tornadoNow(1);
+            ge->sendInput(SIM_TORNADO, 1);
         break;
     case sf::Keyboard::C:
         if (!(ge->getArenaNum() == 3))
-            ge->fighterClass[0].punchNow(0);
+            ge->sendInput(SIM_PUNCH, 0);
         break;
     case sf::Keyboard::S:
         if (!(ge->getArenaNum() == 3))
-            ge->fighterClass[0].kickNow(0);
+            ge->sendInput(SIM_KICK, 0);
         break;
     case sf::Keyboard::Q:
         if (!(ge->getArenaNum() == 3))
-            ge->fighterClass[0].tornadoNow(0);
+            ge->sendInput(SIM_TORNADO, 0);
         break;
     case sf::Keyboard::Enter:
         if (ge->getArenaNum() == 3)
-            ge->menuSelect();
+            ge->sendInput(SIM_MENU_SELECT);
         break;
     case sf::Keyboard::Right:
         if (ge->getArenaNum() == 3)
-            ge->menuRightSlide();
+            ge->sendInput(SIM_MENU_RIGHT);
         break;
     case sf::Keyboard::Left:
          if (ge->getArenaNum() == 3)
-            ge->menuLeftSlide();
+            ge->sendInput(SIM_MENU_LEFT);
         break;
     case sf::Keyboard::BackSpace:
         if (ge->getArenaNum() == 3)
-           ge->menuBackout();
+           ge->sendInput(SIM_MENU_BACK);
         break;
     case sf::Keyboard::Z:
         if (ge->getPause() == true)
-            ge->returnToMenu();
+            ge->sendInput(SIM_RETURN_TO_MENU);
         break;
     case sf::Keyboard::Numpad1:
         if (ge->getArenaNum() == 3)
-            ge->setCurFIndex(1, 0);
+            ge->sendInput(SIM_SET_FIGHTER, 1, 0);
         break;
     case sf::Keyboard::Numpad2:
         if (ge->getArenaNum() == 3)
-            ge->setCurFIndex(1, 1);
+            ge->sendInput(SIM_SET_FIGHTER, 1, 1);
         break;
     case sf::Keyboard::Numpad3:
         if (ge->getArenaNum() == 3)
-            ge->setCurFIndex(1, 3);
+            ge->sendInput(SIM_SET_FIGHTER, 1, 3);
         break;
     case sf::Keyboard::Space:
         if (!(ge->getArenaNum() == 3))
-            ge->fighterClass[0].fighterJump(0);
+            ge->sendInput(SIM_JUMP, 0);
         break;
     default:
         break;
@@ -426,18 +486,18 @@ void UI::keyboardStateProcessing()
     bool leftDownOne = sf::Keyboard::isKeyPressed(sf::Keyboard::A);
     if (!(ge->getArenaNum() == 3)){
         if (rightDownTwo)
-            ge->fighterClass[1].fighterMoveX(1, 0, 1);
+            ge->sendInput(SIM_MOVE, 1, 0, 1);
         else if (leftDownTwo)
-            ge->fighterClass[1].fighterMoveX(1, 1, 0);
+            ge->sendInput(SIM_MOVE, 1, 1, 0);
         else if (!(leftDownTwo || rightDownTwo))
-            ge->fighterClass[1].fighterMoveX(1, 0, 0);
+            ge->sendInput(SIM_MOVE, 1, 0, 0);
 
         if (rightDownOne)
-            ge->fighterClass[0].fighterMoveX(0, 1, 0);
+            ge->sendInput(SIM_MOVE, 0, 1, 0);
         else if (leftDownOne)
-            ge->fighterClass[0].fighterMoveX(0, 0, 1);
+            ge->sendInput(SIM_MOVE, 0, 0, 1);
         else if (!(leftDownOne || rightDownOne))
-            ge->fighterClass[0].fighterMoveX(0, 0, 0);
+            ge->sendInput(SIM_MOVE, 0, 0, 0);
     }
 
 }
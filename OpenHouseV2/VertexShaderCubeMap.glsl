@@ -5,7 +5,8 @@
 
 \brief Vertex shader specifically for a cub map texture.  Incorporates
 the transformation of vertices by a projection*view*model matrix. Sets
-the texture coordinate to the position of the vertex.
+the texture coordinate to the position of the vertex.  The depth is set to
+the far plane so the sky can be drawn last with GL_LEQUAL, behind everything.
 
 \param [in] vposition --- vec4 vertex position from memory.
 
@@ -24,5 +25,5 @@ out vec3 tex_coord;
 void main()
 {
     tex_coord = vec3(vposition);
-    gl_Position = PVM * vposition;
+    gl_Position = (PVM * vposition).xyww;
 }
@@ -0,0 +1,265 @@
+#include "ViewFrustum.h"
+
+#include <float.h>
+#include <math.h>
+
+#include "ogldev_math_3d.h"
+
+/**
+\file ViewFrustum.cpp
+\brief Bounding volumes and view frustum culling.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Constructor, creates an empty volume.
+
+*/
+
+BoundingVolume::BoundingVolume()
+{
+    reset();
+}
+
+/**
+\brief Empties the volume so it can be rebuilt.
+
+*/
+
+void BoundingVolume::reset()
+{
+    boxMin = glm::vec3(FLT_MAX, FLT_MAX, FLT_MAX);
+    boxMax = glm::vec3(-FLT_MAX, -FLT_MAX, -FLT_MAX);
+    center = glm::vec3(0, 0, 0);
+    radius = 0;
+    valid = false;
+}
+
+/**
+\brief Grows the box to contain a point.
+
+\param p --- Object space position.
+
+*/
+
+void BoundingVolume::add(const glm::vec3& p)
+{
+    add(p.x, p.y, p.z);
+}
+
+/**
+\brief Grows the box to contain a point.
+
+\param x --- X coordinate.
+\param y --- Y coordinate.
+\param z --- Z coordinate.
+
+*/
+
+void BoundingVolume::add(float x, float y, float z)
+{
+    if (x < boxMin.x) boxMin.x = x;
+    if (y < boxMin.y) boxMin.y = y;
+    if (z < boxMin.z) boxMin.z = z;
+    if (x > boxMax.x) boxMax.x = x;
+    if (y > boxMax.y) boxMax.y = y;
+    if (z > boxMax.z) boxMax.z = z;
+    valid = true;
+}
+
+/**
+\brief Computes the center and sphere radius from the box.
+
+\param padding --- Optional factor to grow the volume by about its center, used for
+skinned meshes whose animated pose can leave the bind pose box.
+
+*/
+
+void BoundingVolume::finish(float padding)
+{
+    if (!valid)
+        return;
+
+    center = (boxMin + boxMax) * 0.5f;
+    glm::vec3 half = (boxMax - boxMin) * (0.5f * padding);
+    boxMin = center - half;
+    boxMax = center + half;
+    radius = glm::length(half);
+}
+
+/**
+\brief Constructor, starts with no planes loaded so every test passes.
+
+*/
+
+ViewFrustum::ViewFrustum()
+{
+    for (int i = 0; i < 6; i++)
+        planes[i] = glm::vec4(0, 0, 0, 1);
+
+    eye = glm::vec3(0, 0, 0);
+    maxDistance = 0;
+    drawn = culled = 0;
+    lastDrawn = lastCulled = 0;
+}
+
+/**
+\brief Loads the planes for a new frame and rolls the counters over.
+
+\param projView --- Projection times view matrix.
+\param Eye --- Camera position, used for distance culling.
+
+*/
+
+void ViewFrustum::update(const glm::mat4& projView, const glm::vec3& Eye)
+{
+    // glm is column major, Matrix4f is row major.
+    Matrix4f m;
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            m.m[i][j] = projView[j][i];
+
+    Vector4f l, r, b, t, n, f;
+    m.CalcClipPlanes(l, r, b, t, n, f);
+
+    // Right, top and far come out facing away from the frustum.
+    planes[0] = glm::vec4(l.x, l.y, l.z, l.w);
+    planes[1] = glm::vec4(-r.x, -r.y, -r.z, -r.w);
+    planes[2] = glm::vec4(b.x, b.y, b.z, b.w);
+    planes[3] = glm::vec4(-t.x, -t.y, -t.z, -t.w);
+    planes[4] = glm::vec4(n.x, n.y, n.z, n.w);
+    planes[5] = glm::vec4(-f.x, -f.y, -f.z, -f.w);
+
+    // Normalize so sphere radii can be compared against plane distances.
+    for (int i = 0; i < 6; i++)
+    {
+        float len = glm::length(glm::vec3(planes[i].x, planes[i].y, planes[i].z));
+        if (len > 0)
+            planes[i] = planes[i] * (1.0f / len);
+    }
+
+    eye = Eye;
+    lastDrawn = drawn;
+    lastCulled = culled;
+    drawn = culled = 0;
+}
+
+/**
+\brief Sets the distance past which objects are culled.
+
+\param d --- Maximum draw distance, 0 to disable.
+
+*/
+
+void ViewFrustum::setMaxDistance(float d)
+{
+    maxDistance = d;
+}
+
+/**
+\brief Returns true if a world space sphere is at least partly inside the frustum.
+
+\param c --- Center of the sphere.
+\param r --- Radius of the sphere.
+
+*/
+
+bool ViewFrustum::testSphere(const glm::vec3& c, float r)
+{
+    for (int i = 0; i < 6; i++)
+        if (planes[i].x*c.x + planes[i].y*c.y + planes[i].z*c.z + planes[i].w < -r)
+            return false;
+
+    if (maxDistance > 0 && glm::length(c - eye) - r > maxDistance)
+        return false;
+
+    return true;
+}
+
+/**
+\brief Returns true if a world space box is at least partly inside the frustum.
+
+Tests the corner furthest along each plane normal, so the box is only rejected
+when it is entirely behind one plane.
+
+\param bmin --- Minimum corner.
+\param bmax --- Maximum corner.
+
+*/
+
+bool ViewFrustum::testBox(const glm::vec3& bmin, const glm::vec3& bmax)
+{
+    for (int i = 0; i < 6; i++)
+    {
+        float px = planes[i].x >= 0 ? bmax.x : bmin.x;
+        float py = planes[i].y >= 0 ? bmax.y : bmin.y;
+        float pz = planes[i].z >= 0 ? bmax.z : bmin.z;
+
+        if (planes[i].x*px + planes[i].y*py + planes[i].z*pz + planes[i].w < 0)
+            return false;
+    }
+
+    return true;
+}
+
+/**
+\brief Culls an object space volume placed by a model matrix and updates the counters.
+
+The box is moved to world space by transforming its center and summing the absolute
+values of the matrix columns against its half extents, which gives the world box of
+the rotated and scaled box without transforming all eight corners.
+
+\param b --- Object space bounding volume.
+\param model --- Model matrix of the object.
+
+*/
+
+bool ViewFrustum::isVisible(const BoundingVolume& b, const glm::mat4& model)
+{
+    if (!b.valid)
+    {
+        drawn++;
+        return true;
+    }
+
+    glm::vec4 c4 = model * glm::vec4(b.center, 1.0f);
+    glm::vec3 c(c4.x, c4.y, c4.z);
+    glm::vec3 half = (b.boxMax - b.boxMin) * 0.5f;
+
+    glm::vec3 ext;
+    for (int i = 0; i < 3; i++)
+        ext[i] = fabs(model[0][i]) * half.x + fabs(model[1][i]) * half.y + fabs(model[2][i]) * half.z;
+
+    if (!testSphere(c, glm::length(ext)) || !testBox(c - ext, c + ext))
+    {
+        culled++;
+        return false;
+    }
+
+    drawn++;
+    return true;
+}
+
+/**
+\brief Returns the number of objects drawn in the last complete frame.
+
+*/
+
+int ViewFrustum::getDrawn()
+{
+    return lastDrawn;
+}
+
+/**
+\brief Returns the number of objects culled in the last complete frame.
+
+*/
+
+int ViewFrustum::getCulled()
+{
+    return lastCulled;
+}
@@ -0,0 +1,82 @@
+#ifndef VIEWFRUSTUM_H_INCLUDED
+#define VIEWFRUSTUM_H_INCLUDED
+
+#include <glm/glm.hpp>
+
+/**
+\file ViewFrustum.h
+
+\brief Header file for ViewFrustum.cpp
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\class BoundingVolume
+
+\brief Object space axis aligned box and enclosing sphere of a mesh.
+
+Built once at load time by adding every vertex position and then calling finish,
+which computes the sphere around the center of the box.
+
+*/
+
+struct BoundingVolume
+{
+    glm::vec3 boxMin;   ///< Minimum corner of the box.
+    glm::vec3 boxMax;   ///< Maximum corner of the box.
+    glm::vec3 center;   ///< Center of the box and sphere.
+    float radius;       ///< Radius of the enclosing sphere.
+    bool valid;         ///< False until at least one point has been added.
+
+    BoundingVolume();
+    void reset();
+    void add(const glm::vec3& p);
+    void add(float x, float y, float z);
+    void finish(float padding = 1.0f);
+};
+
+/**
+\class ViewFrustum
+
+\brief Culls bounding volumes against the six planes of the camera frustum and an
+optional maximum draw distance, keeping counts of what was drawn and culled.
+
+The planes are extracted from the projection-view matrix with Matrix4f::CalcClipPlanes
+and turned so that all normals point into the frustum.  A volume is first tested as a
+sphere, which is cheap and rejects most off screen objects, and survivors are then
+tested as a world space box, which is tighter for long flat objects like the walls and
+the road.
+
+*/
+
+class ViewFrustum
+{
+private:
+    glm::vec4 planes[6];   ///< Inward facing frustum planes, (a, b, c, d) with ax + by + cz + d >= 0 inside.
+    glm::vec3 eye;         ///< Camera position for distance culling.
+    float maxDistance;     ///< Distance past which objects are culled, 0 disables.
+
+    int drawn;             ///< Objects that passed the test this frame.
+    int culled;            ///< Objects that were rejected this frame.
+    int lastDrawn;         ///< Objects drawn last frame.
+    int lastCulled;        ///< Objects culled last frame.
+
+public:
+    ViewFrustum();
+
+    void update(const glm::mat4& projView, const glm::vec3& Eye);
+    void setMaxDistance(float d);
+
+    bool testSphere(const glm::vec3& c, float r);
+    bool testBox(const glm::vec3& bmin, const glm::vec3& bmax);
+    bool isVisible(const BoundingVolume& b, const glm::mat4& model);
+
+    int getDrawn();
+    int getCulled();
+};
+
+#endif // VIEWFRUSTUM_H_INCLUDED
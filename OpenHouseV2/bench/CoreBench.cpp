@@ -0,0 +1,573 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../Models.h"
+#include "../ObjModel.h"
+#include "../TextRendererTTF.h"
+#include "../ogldev_math_3d.h"
+#include "../skinned_mesh.h"
+
+/**
+\file CoreBench.cpp
+\brief CPU microbenchmarks of the math, loaders and animation.
+
+Times the pieces the other optimization work changes, each on its own, with the OpenGL
+calls stubbed out (see GLStubs.cpp) so no context is needed:
+
+- Matrix4f::operator* and Matrix4f::Inverse
+- ObjModel::Load of the car, with its materials and textures
+- SkinnedMesh::GetBoneTransforms of a character's clip
+- Models::createNormals of a torus, and the Models surfaces at 1024 by 1024, on one
+  thread and split between every hardware thread (Models::setThreads)
+- TextRendererTTF::textWidth of a HUD string, cached and uncached
+
+Each benchmark is run with more iterations until it has taken the minimum time, like
+Google Benchmark, and the time per iteration printed.  The results are also written in
+Google Benchmark's JSON format, so its compare.py and other tools can read them.  A
+benchmark whose asset is missing is reported with an error and the rest still run.
+
+Usage:
+
+    bench_core [-f filter] [-t minSeconds] [-o out.json] [-d dir]
+
+-f runs only the benchmarks with the text in their name.  -d is the directory the assets
+are found from, the game's by default when run from the compile directory.  The default
+minimum time is half a second and the results go to bench_core.json in the directory the
+benchmark was started from.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+static volatile float sink;   ///< Results are added here so the work cannot be optimized away.
+
+/**
+\brief Iteration count and extra results of one run of a benchmark.
+
+*/
+
+struct CoreBenchState
+{
+    long long iterations;    ///< Iterations to run.
+    long long items;         ///< Items processed per iteration, for items_per_second, 0 for none.
+    std::string error;       ///< Set if the benchmark could not run.
+};
+
+typedef void (*CoreBenchFunction)(CoreBenchState& state);
+
+/**
+\brief A benchmark and its results.
+
+*/
+
+struct CoreBench
+{
+    std::string name;             ///< Name in the results.
+    CoreBenchFunction function;   ///< Runs state.iterations iterations.
+    long long iterations;         ///< Iterations of the final run.
+    double realNs;                ///< Wall time per iteration.
+    double cpuNs;                 ///< Process CPU time per iteration.
+    long long items;              ///< Items per iteration.
+    std::string error;            ///< Why it could not run, empty if it ran.
+};
+
+static std::string meshFile = "Models/animTest/mondayMemo.fbx";   ///< Skinned mesh animated.
+static std::string objPath = "Models/LowPol/";                    ///< Directory of the obj loaded.
+static std::string objFile = "Car_Low_Poly.obj";                  ///< Obj loaded, the car.
+static std::string fontFile = "fonts/Game-Of-Squids.ttf";         ///< Font measured, the HUD's.
+
+/**
+\brief Returns true if a file can be opened for reading.
+
+\param filename --- The file.
+
+*/
+
+static bool fileExists(const std::string& filename)
+{
+    FILE* f = fopen(filename.c_str(), "rb");
+    if (!f)
+        return false;
+    fclose(f);
+    return true;
+}
+
+/**
+\brief Matrix4f::operator*, a running product with a rotation.
+
+*/
+
+static void benchMatrixMultiply(CoreBenchState& state)
+{
+    Matrix4f r, m;
+    r.InitIdentity();
+    m.InitRotateTransform(0.3f, 0.7f, 1.1f);
+
+    for (long long i = 0; i < state.iterations; i++)
+        r = r * m;
+
+    sink += r.m[0][0];
+}
+
+/**
+\brief Matrix4f::Inverse of a rotation and translation.
+
+*/
+
+static void benchMatrixInverse(CoreBenchState& state)
+{
+    Matrix4f rotate, translate;
+    rotate.InitRotateTransform(0.3f, 0.7f, 1.1f);
+    translate.InitTranslationTransform(1, 2, 3);
+    Matrix4f m = translate * rotate;
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        Matrix4f inv = m.Inverse();
+        sink += inv.m[0][3];
+        m.m[0][3] += 1e-6f;
+    }
+}
+
+/**
+\brief ObjModel::Load of the car, parsing, materials and textures, each time into a new
+model.
+
+*/
+
+static void benchObjLoad(CoreBenchState& state)
+{
+    if (!fileExists(objPath + objFile))
+    {
+        state.error = "missing " + objPath + objFile;
+        return;
+    }
+
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        ObjModel model;
+        if (!model.Load(objPath, objFile))
+        {
+            state.error = "could not load " + objPath + objFile;
+            return;
+        }
+        sink += model.getBounds().radius;
+    }
+}
+
+/**
+\brief SkinnedMesh::GetBoneTransforms of the first clip, a frame further in each time.
+
+*/
+
+static void benchBoneTransforms(CoreBenchState& state)
+{
+    static SkinnedMesh* mesh = NULL;
+    static bool tried = false;
+    if (!tried)
+    {
+        tried = true;
+        if (fileExists(meshFile))
+        {
+            mesh = new SkinnedMesh;
+            if (!mesh->LoadMesh(meshFile))
+            {
+                delete mesh;
+                mesh = NULL;
+            }
+        }
+    }
+    if (!mesh)
+    {
+        state.error = "could not load " + meshFile;
+        return;
+    }
+
+    vector<Matrix4f> transforms;
+    state.items = mesh->NumBones();
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        mesh->GetBoneTransforms(i / 60.0f, transforms);
+        sink += transforms[0].m[0][0];
+    }
+}
+
+/**
+\brief Models::createNormals of a 128 by 128 torus.
+
+*/
+
+static void benchCreateNormals(CoreBenchState& state)
+{
+    Models torus;
+    torus.createTorusOBJ(0.5f, 1.0f, 128, 128);
+
+    state.items = 129 * 129;
+    for (long long i = 0; i < state.iterations; i++)
+        torus.createNormals();
+
+    sink += torus.getBounds().radius;
+}
+
+#define DENSE_DIVISIONS 1024   ///< Longitude and latitude divisions of the dense surfaces.
+
+/**
+\brief Which dense surface benchDense builds.
+
+*/
+
+enum DenseSurface
+{
+    DENSE_SPHERE,    ///< Models::createSphereOBJ.
+    DENSE_TREFOIL,   ///< Models::createTrefoilOBJ, analytic normals.
+    DENSE_UMBILIC,   ///< Models::createUmbilicTorusOBJ, normals from createNormals.
+    DENSE_NORMALS    ///< Models::createNormals of a torus.
+};
+
+/**
+\brief Builds a dense surface, the kind of procedural prop that shows in the load time.
+
+\param state --- Benchmark state.
+\param surface --- Surface built.
+\param threads --- Threads the rows are split between, 0 for one per hardware thread.
+
+*/
+
+static void benchDense(CoreBenchState& state, DenseSurface surface, int threads)
+{
+    Models model;
+    Models::setThreads(threads);
+    if (surface == DENSE_NORMALS)
+        model.createTorusOBJ(0.5f, 1.0f, DENSE_DIVISIONS, DENSE_DIVISIONS);
+
+    state.items = (DENSE_DIVISIONS + 1) * (DENSE_DIVISIONS + 1);
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        if (surface == DENSE_SPHERE)
+            model.createSphereOBJ(1.0f, DENSE_DIVISIONS, DENSE_DIVISIONS);
+        else if (surface == DENSE_TREFOIL)
+            model.createTrefoilOBJ(0.2f, 1.5f, 1.0f, 0.3f, 1.0f, DENSE_DIVISIONS, DENSE_DIVISIONS);
+        else if (surface == DENSE_UMBILIC)
+            model.createUmbilicTorusOBJ(DENSE_DIVISIONS, DENSE_DIVISIONS);
+        else
+            model.createNormals();
+    }
+
+    Models::setThreads(1);
+    sink += model.getBounds().radius;
+}
+
+/**
+\brief The 1024 by 1024 sphere, see benchDense.
+
+*/
+
+static void benchDenseSphere(CoreBenchState& state)
+{
+    benchDense(state, DENSE_SPHERE, 1);
+}
+
+/**
+\brief The 1024 by 1024 trefoil, see benchDense.
+
+*/
+
+static void benchDenseTrefoil(CoreBenchState& state)
+{
+    benchDense(state, DENSE_TREFOIL, 1);
+}
+
+/**
+\brief The 1024 by 1024 umbilic torus, see benchDense.
+
+*/
+
+static void benchDenseUmbilic(CoreBenchState& state)
+{
+    benchDense(state, DENSE_UMBILIC, 1);
+}
+
+/**
+\brief The normals of a 1024 by 1024 torus, see benchDense.
+
+*/
+
+static void benchDenseNormals(CoreBenchState& state)
+{
+    benchDense(state, DENSE_NORMALS, 1);
+}
+
+/**
+\brief The 1024 by 1024 trefoil on every hardware thread, see benchDense.
+
+*/
+
+static void benchDenseTrefoilThreads(CoreBenchState& state)
+{
+    benchDense(state, DENSE_TREFOIL, 0);
+}
+
+/**
+\brief The normals of a 1024 by 1024 torus on every hardware thread, see benchDense.
+
+*/
+
+static void benchDenseNormalsThreads(CoreBenchState& state)
+{
+    benchDense(state, DENSE_NORMALS, 0);
+}
+
+/**
+\brief Returns the text renderer with the HUD font, loaded on first use.
+
+*/
+
+static TextRendererTTF* getText()
+{
+    static TextRendererTTF* text = NULL;
+    if (!text && fileExists(fontFile))
+    {
+        text = new TextRendererTTF(fontFile);
+        if (text->isError())
+        {
+            delete text;
+            text = NULL;
+        }
+    }
+    return text;
+}
+
+/**
+\brief TextRendererTTF::textWidth of a HUD string at one size, the metrics cached.
+
+*/
+
+static void benchTextWidth(CoreBenchState& state)
+{
+    TextRendererTTF* text = getText();
+    if (!text)
+    {
+        state.error = "could not load " + fontFile;
+        return;
+    }
+
+    const char* msg = "Player One Wins!";
+    state.items = strlen(msg);
+    for (long long i = 0; i < state.iterations; i++)
+        sink += text->textWidth(msg, 48);
+}
+
+/**
+\brief TextRendererTTF::textWidth of a HUD string with the cache cleared each time, so
+each glyph is loaded through FreeType.
+
+*/
+
+static void benchTextWidthUncached(CoreBenchState& state)
+{
+    TextRendererTTF* text = getText();
+    if (!text)
+    {
+        state.error = "could not load " + fontFile;
+        return;
+    }
+
+    const char* msg = "Player One Wins!";
+    state.items = strlen(msg);
+    for (long long i = 0; i < state.iterations; i++)
+    {
+        text->clearCache();
+        sink += text->textWidth(msg, 48);
+    }
+}
+
+/**
+\brief Runs a benchmark with more iterations until it takes the minimum time.
+
+\param bench --- The benchmark, its results are filled in.
+\param minSeconds --- Minimum time of the final run.
+
+*/
+
+static void runCoreBench(CoreBench& bench, double minSeconds)
+{
+    CoreBenchState state;
+    state.iterations = 1;
+
+    while (true)
+    {
+        state.items = 0;
+        state.error.clear();
+
+        clock_t cpuStart = clock();
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        bench.function(state);
+        double real = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        double cpu = (double)(clock() - cpuStart) / CLOCKS_PER_SEC;
+
+        bench.error = state.error;
+        if (!state.error.empty())
+            return;
+
+        if (real >= minSeconds || state.iterations >= 1000000000LL)
+        {
+            bench.iterations = state.iterations;
+            bench.realNs = real * 1e9 / state.iterations;
+            bench.cpuNs = cpu * 1e9 / state.iterations;
+            bench.items = state.items;
+            return;
+        }
+
+        // Aim past the minimum from the rate so far, at most ten times more each round.
+        double grow = real > 0 ? minSeconds * 1.4 / real : 10;
+        if (grow > 10)
+            grow = 10;
+        if (grow < 2)
+            grow = 2;
+        state.iterations = (long long)(state.iterations * grow);
+    }
+}
+
+/**
+\brief Writes the results in Google Benchmark's JSON format.
+
+\param filename --- File written.
+\param program --- Name the benchmark was run as.
+\param benches --- Benchmarks that were run.
+
+\return True if the file was written.
+
+*/
+
+static bool writeResults(const std::string& filename, const char* program, const std::vector<CoreBench>& benches)
+{
+    FILE* f = fopen(filename.c_str(), "w");
+    if (!f)
+    {
+        fprintf(stderr, "Could not open %s for writing.\n", filename.c_str());
+        return false;
+    }
+
+    char date[64];
+    time_t now = time(NULL);
+    strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+
+    fprintf(f, "{\n  \"context\": {\n");
+    fprintf(f, "    \"date\": \"%s\",\n    \"executable\": \"%s\",\n", date, program);
+    fprintf(f, "    \"num_cpus\": %u,\n    \"library_build_type\": \"release\"\n  },\n", std::thread::hardware_concurrency());
+    fprintf(f, "  \"benchmarks\": [\n");
+
+    for (size_t i = 0; i < benches.size(); i++)
+    {
+        const CoreBench& b = benches[i];
+        fprintf(f, "    {\n      \"name\": \"%s\",\n      \"run_type\": \"iteration\",\n", b.name.c_str());
+        if (!b.error.empty())
+            fprintf(f, "      \"error_occurred\": true,\n      \"error_message\": \"%s\"\n", b.error.c_str());
+        else
+        {
+            fprintf(f, "      \"iterations\": %lld,\n      \"real_time\": %.3f,\n      \"cpu_time\": %.3f,\n",
+                    b.iterations, b.realNs, b.cpuNs);
+            if (b.items > 0)
+                fprintf(f, "      \"items_per_second\": %.1f,\n", b.items * 1e9 / b.realNs);
+            fprintf(f, "      \"time_unit\": \"ns\"\n");
+        }
+        fprintf(f, "    }%s\n", i + 1 < benches.size() ? "," : "");
+    }
+
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
+
+/**
+\brief Benchmark entry point.
+
+*/
+
+int main(int argc, char** argv)
+{
+    std::string filter;
+    double minSeconds = 0.5;
+    std::string outFile = "bench_core.json";
+    std::string dir = "../OpenHouseV2";
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+            filter = argv[++i];
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            minSeconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+            outFile = argv[++i];
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            dir = argv[++i];
+        else
+        {
+            fprintf(stderr, "Usage: %s [-f filter] [-t minSeconds] [-o out.json] [-d dir]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    // The results go where the benchmark was started, the assets are found from dir.
+    char startDir[4096];
+    if (!getcwd(startDir, sizeof(startDir)))
+        startDir[0] = 0;
+    if (outFile[0] != '/' && startDir[0])
+        outFile = std::string(startDir) + "/" + outFile;
+    if (chdir(dir.c_str()) != 0)
+    {
+        fprintf(stderr, "Could not change to %s\n", dir.c_str());
+        return EXIT_FAILURE;
+    }
+
+    CoreBench all[] = {
+        {"Matrix4f::operator*", benchMatrixMultiply},
+        {"Matrix4f::Inverse", benchMatrixInverse},
+        {"ObjModel::Load/" + objFile, benchObjLoad},
+        {"SkinnedMesh::GetBoneTransforms/" + meshFile, benchBoneTransforms},
+        {"Models::createNormals/torus128", benchCreateNormals},
+        {"Models::createSphereOBJ/1024", benchDenseSphere},
+        {"Models::createTrefoilOBJ/1024", benchDenseTrefoil},
+        {"Models::createUmbilicTorusOBJ/1024", benchDenseUmbilic},
+        {"Models::createNormals/torus1024", benchDenseNormals},
+        {"Models::createTrefoilOBJ/1024/threads", benchDenseTrefoilThreads},
+        {"Models::createNormals/torus1024/threads", benchDenseNormalsThreads},
+        {"TextRendererTTF::textWidth/cached", benchTextWidth},
+        {"TextRendererTTF::textWidth/uncached", benchTextWidthUncached},
+    };
+
+    std::vector<CoreBench> benches;
+    printf("%-60s %14s %14s %12s\n", "Benchmark", "Time (ns)", "CPU (ns)", "Iterations");
+    for (size_t i = 0; i < sizeof(all) / sizeof(all[0]); i++)
+    {
+        CoreBench b = all[i];
+        if (!filter.empty() && b.name.find(filter) == std::string::npos)
+            continue;
+
+        runCoreBench(b, minSeconds);
+        if (!b.error.empty())
+            printf("%-60s ERROR: %s\n", b.name.c_str(), b.error.c_str());
+        else if (b.items > 0)
+            printf("%-60s %14.1f %14.1f %12lld   %.3g items/s\n", b.name.c_str(), b.realNs, b.cpuNs, b.iterations,
+                   b.items * 1e9 / b.realNs);
+        else
+            printf("%-60s %14.1f %14.1f %12lld\n", b.name.c_str(), b.realNs, b.cpuNs, b.iterations);
+        benches.push_back(b);
+    }
+
+    if (!writeResults(outFile, argv[0], benches))
+        return EXIT_FAILURE;
+
+    printf("Saved %s\n", outFile.c_str());
+    return EXIT_SUCCESS;
+}
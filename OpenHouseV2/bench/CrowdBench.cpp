@@ -0,0 +1,195 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <string>
+
+#include <GL/glew.h>
+#include <SFML/Window.hpp>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "../EntityWorld.h"
+#include "../ProgramDefines.h"
+
+/**
+\file CrowdBench.cpp
+\brief Skinned crowd stress benchmark.
+
+Spawns a grid of animated instances of one skinned mesh in an EntityWorld and runs the
+game's cull, animation and draw systems over them for a number of frames in an
+offscreen OpenGL context, the same path the fighters and the bath house crowd take.
+Each instance plays the clip from its own point in time.  Reports the time per frame
+of each system, and of the bone work per instance, which is what limits how many
+characters a scene can hold.
+
+Usage:
+
+    bench_crowd [-n instances] [-f frames] [-m mesh] [-c clip] [-d dir]
+
+-d is the directory the shaders and mesh are found from, the game's by default when
+run from the compile directory.  The defaults are 100 instances of Monday Memo for 300
+frames.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Seconds since a time point.
+
+\param start --- The time point.
+
+*/
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+\brief Benchmark entry point.
+
+*/
+
+int main(int argc, char** argv)
+{
+    int instances = 100;
+    int frames = 300;
+    int clip = 0;
+    std::string meshFile = "Models/animTest/mondayMemo.fbx";
+    std::string dir = "../OpenHouseV2";
+    int width = 1280;
+    int height = 720;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            instances = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+            frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+            meshFile = argv[++i];
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+            clip = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            dir = argv[++i];
+        else
+        {
+            fprintf(stderr, "Usage: %s [-n instances] [-f frames] [-m mesh] [-c clip] [-d dir]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+    if (instances < 1 || instances > ENTITY_MAX || frames < 1)
+    {
+        fprintf(stderr, "Instances must be 1 to %d and frames at least 1.\n", ENTITY_MAX);
+        return EXIT_FAILURE;
+    }
+
+    // The shaders and models are named relative to the game's directory.
+    if (chdir(dir.c_str()) != 0)
+    {
+        fprintf(stderr, "Could not change to %s\n", dir.c_str());
+        return EXIT_FAILURE;
+    }
+
+    sf::ContextSettings settings(24, 8, 0, 3, 3);
+    sf::Context context(settings, width, height);
+    context.setActive(true);
+
+    glewExperimental = GL_TRUE;
+    if (glewInit() != GLEW_OK)
+    {
+        fprintf(stderr, "Could not initialize GLEW.\n");
+        return EXIT_FAILURE;
+    }
+
+    glViewport(0, 0, width, height);
+    glEnable(GL_DEPTH_TEST);
+    glClearColor(0, 0, 0, 1);
+
+    SkinningTechnique tech;
+    if (!tech.Init())
+    {
+        fprintf(stderr, "Could not load the skinning shaders.\n");
+        return EXIT_FAILURE;
+    }
+    tech.Enable();
+    tech.SetTextureUnit(0);
+    tech.SetSpecularExponentTextureUnit(6);
+
+    SkinnedMesh mesh;
+    if (!mesh.LoadMesh(meshFile))
+    {
+        fprintf(stderr, "Could not load %s\n", meshFile.c_str());
+        return EXIT_FAILURE;
+    }
+
+    // A square grid on the ground, spaced by the mesh's size, all in view.
+    EntityWorld world;
+    const BoundingVolume& bounds = mesh.getBounds();
+    float spacing = 2 * bounds.radius;
+    int side = (int)ceil(sqrt((double)instances));
+    for (int i = 0; i < instances; i++)
+    {
+        int e = world.spawn(ENTITY_CROWD, &mesh, 0, -1);
+        world.posX[e] = ((i % side) - (side - 1) * 0.5f) * spacing;
+        world.posZ[e] = -((i / side) - (side - 1) * 0.5f) * spacing;
+        world.facing[e] = (i % 2) ? -1 : 1;
+        world.clip[e] = clip;
+        world.clipStart[e] = -0.37 * i;   // Out of step with each other
+    }
+
+    float extent = side * spacing;
+    glm::vec3 eye(0, extent, extent * 1.5f);
+    glm::mat4 view = glm::lookAt(eye, glm::vec3(0, 0, 0), glm::vec3(0, 1, 0));
+    glm::mat4 projection = glm::perspective(50.0f * degf, (float)width / height, spacing * 0.05f, extent * 10);
+    glm::mat4 projView = projection * view;
+
+    ViewFrustum frustum;
+    frustum.update(projView, eye);
+
+    double cullSec = 0;
+    double animateSec = 0;
+    double drawSec = 0;
+    int visible = 0;
+
+    // The clock steps at the game's frame rate, so each run poses the same bones.
+    for (int f = 0; f < frames; f++)
+    {
+        double now = (double)f / SimTickRate;
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        visible = world.cull(frustum);
+        cullSec += secondsSince(start);
+
+        start = std::chrono::steady_clock::now();
+        world.animate(now);
+        animateSec += secondsSince(start);
+
+        // No main shader here, location -1 is ignored by OpenGL.
+        start = std::chrono::steady_clock::now();
+        world.draw(&tech, projView, (GLuint)-1);
+        glFinish();
+        drawSec += secondsSince(start);
+    }
+
+    double total = cullSec + animateSec + drawSec;
+    printf("Mesh:         %s, %u bones, clip %d\n", meshFile.c_str(), mesh.NumBones(), clip);
+    printf("Instances:    %d (%d visible)\n", instances, visible);
+    printf("Frames:       %d\n", frames);
+    printf("Cull:         %.3f ms per frame\n", cullSec * 1000 / frames);
+    printf("Animate:      %.3f ms per frame, %.2f us per instance\n", animateSec * 1000 / frames,
+           visible > 0 ? animateSec * 1e6 / frames / visible : 0.0);
+    printf("Draw:         %.3f ms per frame, GPU finished\n", drawSec * 1000 / frames);
+    printf("Total:        %.3f ms per frame (%.0f frames/sec)\n", total * 1000 / frames, total > 0 ? frames / total : 0.0);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,300 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <algorithm>
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../FighterCore.h"
+#include "../ProgramDefines.h"
+
+/**
+\file FightBench.cpp
+\brief Headless fight simulation benchmark.
+
+Plays N scripted matches between every pairing of the selectable fighters using only
+FighterCore, so no window, OpenGL context or audio device is needed, and reports how
+many simulation ticks per second were run along with the wins for each pairing.
+
+Player one moves first each step, which gives it an edge, so each pairing is played in
+groups of four rounds with the same two scripts: the fighters swap sides every other
+round and swap scripts every other two, so each fighter plays each script from each
+side.  The wins are counted by fighter, the side wins are reported apart.
+
+Usage:
+
+    bench_fight [-n matches] [-s seed] [-t maxSeconds] [-d id attack value] [-r id attack value]
+                [-c id counter value] [-fighters list]
+
+-d and -c override an entry of the damage and frames tables before the run, and -r
+moves the front edge of every hitbox of a move (0 punch, 1 double punch, 2 kick,
+3 knee, 4 special) to the value given, which sets its reach.  Each can be repeated,
+which is what balance sweeps use.  -fighters is the fighter list
+to load, the game's by default when run from the compile directory.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+static const char* defaultFighterList = "../OpenHouseV2/" FIGHTER_LIST;   ///< The game's fighters, from the compile directory.
+
+/**
+\brief One table override from the command line.
+
+*/
+
+struct BenchOverride
+{
+    char table;     ///< 'd' damage, 'r' hitbox reach or 'c' frames table.
+    int id;         ///< Fighter ID.
+    int attack;     ///< Column of the table, or the move for reach.
+    float value;    ///< New value.
+};
+
+/**
+\brief Scripted player, walks in and throws random attacks once in range.
+
+*/
+
+struct BenchScript
+{
+    unsigned int seed;   ///< State of the random sequence.
+    int backTicks;       ///< Ticks left of backing off.
+
+    /**
+    \brief Returns the next pseudo random number, 0 to 65535.
+    */
+    unsigned int next()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 16;
+    }
+
+    /**
+    \brief Chooses this tick's input for a player.
+
+    Walks forward, which stops on its own at the closest spacing, now and then backs
+    off for a moment, and throws a random attack each tick with a small chance once
+    the rival is close.
+
+    \param f --- The player's fighter.
+    \param p --- Player number.
+    \param dist --- Distance between the fighters.
+    */
+    void play(FighterCore& f, int p, float dist)
+    {
+        if (backTicks > 0)
+        {
+            backTicks--;
+            f.fighterMoveX(p, false, true);
+        }
+        else if (next() % 200 == 0)
+        {
+            backTicks = 10 + next() % 20;
+        }
+        else
+        {
+            f.fighterMoveX(p, true, false);
+        }
+
+        if (dist > 20)
+            return;
+
+        unsigned int r = next() % 100;
+        if (r < 6)
+            f.punchNow(p);
+        else if (r < 10)
+            f.kickNow(p);
+        else if (r < 12)
+            f.tornadoNow(p);
+        else if (r < 13)
+            f.fighterJump(p);
+    }
+};
+
+/**
+\brief Plays one match to a knock out or the time limit.
+
+\param table --- Fighter definitions, with the overrides applied.
+\param id0 --- Player one's fighter ID.
+\param id1 --- Player two's fighter ID.
+\param seed0 --- Seed of player one's script.
+\param seed1 --- Seed of player two's script.
+\param maxTicks --- Tick limit.
+\param ticks --- Incremented by the number of ticks run.
+\param world --- Collision space, shared by the matches.
+
+\return 0 if player one won, 1 if player two won, 2 for a draw.
+
+*/
+
+static int playMatch(const FighterTable& table, int id0, int id1, unsigned int seed0, unsigned int seed1, long long maxTicks, long long& ticks, HitWorld& world)
+{
+    FighterCore f[2];
+    f[0].setTable(&table);
+    f[1].setTable(&table);
+    f[0].newFighter(0, id0);
+    f[1].newFighter(1, id1);
+
+    f[0].setFighterID(id0, id1);
+    f[1].setFighterID(id1, id0);
+
+    int fiIndex[2] = {id0, id1};
+    BenchScript script[2] = {{seed0, 0}, {seed1, 0}};
+
+    for (long long t = 0; t < maxTicks; t++)
+    {
+        float dist = fabs(f[0].fighterX[0] - f[1].fighterX[1]);
+        script[0].play(f[0], 0, dist);
+        script[1].play(f[1], 1, dist);
+
+        FighterCore::stepPair(f[0], f[1], fiIndex, world);
+        ticks++;
+
+        // Each fighter tracks the HP it has taken from the other, as in the HUD.
+        float hp0 = f[1].fighterHP[0];
+        float hp1 = f[0].fighterHP[1];
+        if (hp0 <= 0 && hp1 <= 0)
+            return 2;
+        if (hp1 <= 0)
+            return 0;
+        if (hp0 <= 0)
+            return 1;
+    }
+
+    return 2;
+}
+
+/**
+\brief Benchmark entry point.
+
+*/
+
+int main(int argc, char** argv)
+{
+    int matches = 1000;
+    unsigned int seed = 1;
+    double maxSeconds = 99;
+    std::vector<BenchOverride> overrides;
+    std::string fighterList = defaultFighterList;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            matches = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            maxSeconds = atof(argv[++i]);
+        else if ((strcmp(argv[i], "-d") == 0 || strcmp(argv[i], "-r") == 0 || strcmp(argv[i], "-c") == 0) && i + 3 < argc)
+        {
+            BenchOverride o;
+            o.table = argv[i][1];
+            o.id = atoi(argv[i + 1]);
+            o.attack = atoi(argv[i + 2]);
+            o.value = atof(argv[i + 3]);
+            i += 3;
+            overrides.push_back(o);
+        }
+        else if (strcmp(argv[i], "-fighters") == 0 && i + 1 < argc)
+            fighterList = argv[++i];
+        else
+        {
+            fprintf(stderr, "Usage: %s [-n matches] [-s seed] [-t maxSeconds] [-d id attack value] [-r id attack value] [-c id counter value] [-fighters list]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    FighterTable table;
+    if (!table.load(fighterList))
+        return EXIT_FAILURE;
+
+    for (size_t i = 0; i < overrides.size(); i++)
+    {
+        const BenchOverride& o = overrides[i];
+        int columns = FRAMES_COUNT;
+        if (o.table == 'd')
+            columns = ATTACK_COUNT;
+        else if (o.table == 'r')
+            columns = FIGHT_HIT_MOVES;
+        if (o.id < 0 || o.id >= table.count || o.attack < 0 || o.attack >= columns)
+        {
+            fprintf(stderr, "Table entry out of range.\n");
+            return EXIT_FAILURE;
+        }
+
+        if (o.table == 'd')
+            table.damage[o.attack][o.id] = o.value;
+        else if (o.table == 'r')
+        {
+            for (int b = 0; b < table.boxCount[o.id]; b++)
+            {
+                if (table.boxHits[b][o.id] && table.boxMove[b][o.id] == o.attack)
+                    table.boxMax[0][b][o.id] = o.value;
+            }
+        }
+        else
+            table.frames[o.attack][o.id] = (int)o.value;
+    }
+
+    std::vector<int> ids;
+    for (int id = 0; id < table.count; id++)
+    {
+        if (table.selectable[id])
+            ids.push_back(id);
+    }
+    int n = (int)ids.size();
+
+    long long maxTicks = (long long)(maxSeconds * SimTickRate);
+    long long ticks = 0;
+    std::vector<int> results(n * n * 3, 0);
+    int sideWins[3] = {0, 0, 0};
+    HitWorld world;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int m = 0; m < matches; m++)
+    {
+        int a = m % n;
+        int b = (m / n) % n;
+        int round = m / (n * n);
+        bool swap = round % 2 == 1;
+
+        // The four rounds of a group replay the scripts of its first one.
+        unsigned int group = seed + m - (round % 4) * n * n;
+        unsigned int seedA = group * 2 + 1;
+        unsigned int seedB = group * 2 + 2;
+        if (round % 4 >= 2)
+            std::swap(seedA, seedB);
+
+        int r = swap ? playMatch(table, ids[b], ids[a], seedB, seedA, maxTicks, ticks, world)
+                     : playMatch(table, ids[a], ids[b], seedA, seedB, maxTicks, ticks, world);
+        sideWins[r]++;
+        if (swap && r < 2)
+            r = 1 - r;
+        results[(a * n + b) * 3 + r]++;
+    }
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    printf("Matches:      %d\n", matches);
+    printf("Ticks:        %lld (%.1f per match)\n", ticks, matches > 0 ? (double)ticks / matches : 0.0);
+    printf("Time:         %.3f s\n", sec);
+    printf("Ticks/sec:    %.0f\n", sec > 0 ? ticks / sec : 0.0);
+    printf("Matches/sec:  %.0f\n", sec > 0 ? matches / sec : 0.0);
+    printf("Box pairs:    %.2f tested per tick\n", ticks > 0 ? (double)world.getPairsTested() / ticks : 0.0);
+    printf("Side wins:    P1 %d, P2 %d, draws %d\n", sideWins[0], sideWins[1], sideWins[2]);
+    printf("\n%-12s %-12s %8s %8s %8s\n", "A", "B", "A wins", "B wins", "Draws");
+
+    for (int a = 0; a < n; a++)
+        for (int b = 0; b < n; b++)
+            printf("%-12s %-12s %8d %8d %8d\n", table.name[ids[a]].c_str(), table.name[ids[b]].c_str(),
+                   results[(a * n + b) * 3], results[(a * n + b) * 3 + 1], results[(a * n + b) * 3 + 2]);
+
+    return EXIT_SUCCESS;
+}
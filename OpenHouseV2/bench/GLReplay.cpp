@@ -0,0 +1,1046 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <GL/glew.h>
+
+#include "../GLCapture.h"
+#include "../OffscreenContext.h"
+
+/**
+\file GLReplay.cpp
+\brief Replays a frame captured with F12 in an offscreen context, times it and flags
+wasted calls.
+
+The capture's setup calls rebuild the programs, buffers, textures, vertex arrays and
+framebuffers the frame used, then the frame's calls are run again and again, back to
+back as the game would, with nothing else in the way.  Each call is timed on the CPU and
+the times summed by function, which is the cost of submitting it; the whole frame is
+also timed with glFinish, and on the GPU with a timer query, to show the work the driver
+put off.
+
+Before replaying, the frame is checked against the state the calls before it left, and
+calls that change nothing are listed:
+
+- binds of what is already bound, and fixed state set to what it already is
+- uniforms set to the value they already have in that program
+- glGetUniformLocation, which should be looked up once after linking
+- glBufferData on a buffer that already has storage, which reallocates it, and uploads of
+the same bytes the buffer already holds
+- glTexImage2D over an image that is already there
+- vertex attribute layouts and texture parameters set again unchanged
+
+Usage:
+
+    gl_replay capture.ohgl [-n frames] [-w warmup] [-v]
+
+-v lists every flagged call instead of the first few of each kind.  The defaults are 200
+frames after 20 warmup frames.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief Time spent in one OpenGL function over the timed frames.
+
+*/
+
+struct OpCost
+{
+    unsigned int op;       ///< One of GLCaptureOp.
+    long long calls;       ///< Calls made.
+    double seconds;        ///< Time in them.
+};
+
+/**
+\brief Runs captured calls, mapping the game's names and uniform locations to the ones
+made here.
+
+*/
+
+struct Replayer
+{
+    std::map<GLuint, GLuint> names[GLCAP_OBJECT_COUNT];   ///< Captured name to replay name, of each kind.
+    std::map<GLuint, GLuint> programs;                    ///< Captured program to replay program.
+    std::map<GLuint, std::map<GLint, GLint> > uniforms;   ///< Captured program to its captured to replay uniform locations.
+    GLuint program;                                       ///< Captured program in use.
+
+    Replayer() : program(0) {}
+
+    GLuint object(unsigned long long kind, unsigned long long name);
+    GLint uniform(unsigned long long location);
+    void buildProgram(GLuint captured, const std::vector<unsigned char>& payload);
+    void setUniform(const GLCaptureCall& c);
+    void run(const GLCaptureCall& c);
+};
+
+/**
+\brief Returns the replay's object for a captured name, made the first time.
+
+\param kind --- One of GLCaptureObject.
+\param name --- Name the game used, 0 stays 0.
+
+*/
+
+GLuint Replayer::object(unsigned long long kind, unsigned long long name)
+{
+    if (name == 0 || kind >= GLCAP_OBJECT_COUNT)
+        return 0;
+
+    std::map<GLuint, GLuint>::iterator it = names[kind].find((GLuint)name);
+    if (it != names[kind].end())
+        return it->second;
+
+    GLuint made = 0;
+    switch (kind)
+    {
+        case GLCAP_BUFFER:
+            glGenBuffers(1, &made);
+            break;
+        case GLCAP_TEXTURE:
+            glGenTextures(1, &made);
+            break;
+        case GLCAP_VERTEX_ARRAY:
+            glGenVertexArrays(1, &made);
+            break;
+        case GLCAP_FRAMEBUFFER:
+            glGenFramebuffers(1, &made);
+            break;
+        case GLCAP_RENDERBUFFER:
+            glGenRenderbuffers(1, &made);
+            break;
+    }
+    names[kind][(GLuint)name] = made;
+    return made;
+}
+
+/**
+\brief Returns the replay's location for a captured uniform location of the program in
+use.
+
+\param location --- Location the game used.
+
+*/
+
+GLint Replayer::uniform(unsigned long long location)
+{
+    GLint loc = (GLint)location;
+    if (loc < 0)
+        return loc;
+
+    std::map<GLint, GLint>& map = uniforms[program];
+    std::map<GLint, GLint>::iterator it = map.find(loc);
+    return it != map.end() ? it->second : loc;
+}
+
+/**
+\brief Reads a 32 bit integer of a program payload.
+
+\param p --- Payload, moved past the integer.
+\param end --- End of the payload.
+
+*/
+
+static int takeInt(const unsigned char*& p, const unsigned char* end)
+{
+    int v = 0;
+    if (p + sizeof(v) <= end)
+        memcpy(&v, p, sizeof(v));
+    p += sizeof(v);
+    return v;
+}
+
+/**
+\brief Reads a string of a program payload.
+
+\param p --- Payload, moved past the string.
+\param end --- End of the payload.
+
+*/
+
+static std::string takeString(const unsigned char*& p, const unsigned char* end)
+{
+    int length = takeInt(p, end);
+    if (length < 0 || p + length > end)
+    {
+        p = end;
+        return "";
+    }
+    std::string s((const char*)p, length);
+    p += length;
+    return s;
+}
+
+/**
+\brief Compiles and links a captured program, with its attributes at the locations the
+game had, and maps its uniform locations.
+
+\param captured --- Program name the game used.
+\param payload --- The GLCAP_CREATE_PROGRAM payload, see GLCapture::copyProgram.
+
+*/
+
+void Replayer::buildProgram(GLuint captured, const std::vector<unsigned char>& payload)
+{
+    const unsigned char* p = payload.empty() ? NULL : &payload[0];
+    const unsigned char* end = p + payload.size();
+
+    GLuint made = glCreateProgram();
+    int shaderCount = takeInt(p, end);
+    for (int i = 0; i < shaderCount; i++)
+    {
+        GLenum type = takeInt(p, end);
+        std::string source = takeString(p, end);
+        const GLchar* text = source.c_str();
+        GLuint shader = glCreateShader(type);
+        glShaderSource(shader, 1, &text, NULL);
+        glCompileShader(shader);
+        glAttachShader(made, shader);
+        glDeleteShader(shader);
+    }
+
+    int attribCount = takeInt(p, end);
+    for (int i = 0; i < attribCount; i++)
+    {
+        int location = takeInt(p, end);
+        std::string name = takeString(p, end);
+        if (location >= 0 && name.compare(0, 3, "gl_") != 0)
+            glBindAttribLocation(made, location, name.c_str());
+    }
+
+    glLinkProgram(made);
+    GLint linked = GL_FALSE;
+    glGetProgramiv(made, GL_LINK_STATUS, &linked);
+    if (!linked)
+    {
+        char log[1024];
+        glGetProgramInfoLog(made, sizeof(log), NULL, log);
+        fprintf(stderr, "Program %u did not link: %s\n", captured, log);
+    }
+
+    std::map<GLint, GLint>& map = uniforms[captured];
+    int uniformCount = takeInt(p, end);
+    for (int i = 0; i < uniformCount; i++)
+    {
+        int location = takeInt(p, end);
+        std::string name = takeString(p, end);
+        map[location] = glGetUniformLocation(made, name.c_str());
+    }
+
+    programs[captured] = made;
+}
+
+/**
+\brief Sets a uniform of the program in use from a GLCAP_UNIFORM_VALUE call.
+
+\param c --- The call.
+
+*/
+
+void Replayer::setUniform(const GLCaptureCall& c)
+{
+    GLint loc = uniform(c.args[0]);
+    GLfloat f[16];
+    GLint n[4];
+    memset(f, 0, sizeof(f));
+    memset(n, 0, sizeof(n));
+    if (!c.payload.empty())
+        memcpy(f, &c.payload[0], std::min(c.payload.size(), sizeof(f)));
+    memcpy(n, f, sizeof(n));
+
+    switch (c.args[1])
+    {
+        case GL_FLOAT:
+            glUniform1fv(loc, 1, f);
+            break;
+        case GL_FLOAT_VEC2:
+            glUniform2fv(loc, 1, f);
+            break;
+        case GL_FLOAT_VEC3:
+            glUniform3fv(loc, 1, f);
+            break;
+        case GL_FLOAT_VEC4:
+            glUniform4fv(loc, 1, f);
+            break;
+        case GL_FLOAT_MAT2:
+            glUniformMatrix2fv(loc, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT3:
+            glUniformMatrix3fv(loc, 1, GL_FALSE, f);
+            break;
+        case GL_FLOAT_MAT4:
+            glUniformMatrix4fv(loc, 1, GL_FALSE, f);
+            break;
+        case GL_INT_VEC2:
+        case GL_BOOL_VEC2:
+            glUniform2iv(loc, 1, n);
+            break;
+        case GL_INT_VEC3:
+        case GL_BOOL_VEC3:
+            glUniform3iv(loc, 1, n);
+            break;
+        case GL_INT_VEC4:
+        case GL_BOOL_VEC4:
+            glUniform4iv(loc, 1, n);
+            break;
+        default:
+            // Ints, bools and samplers.
+            glUniform1iv(loc, 1, n);
+            break;
+    }
+}
+
+/**
+\brief Runs one captured call.
+
+\param c --- The call.
+
+*/
+
+void Replayer::run(const GLCaptureCall& c)
+{
+    const unsigned long long* a = c.args;
+    const void* data = c.payload.empty() ? NULL : &c.payload[0];
+
+    switch (c.op)
+    {
+        case GLCAP_CREATE:
+            object(a[0], a[1]);
+            break;
+        case GLCAP_CREATE_PROGRAM:
+            buildProgram(a[0], c.payload);
+            break;
+        case GLCAP_UNIFORM_VALUE:
+            setUniform(c);
+            break;
+        case GLCAP_USE_PROGRAM:
+            program = a[0];
+            glUseProgram(a[0] ? programs[a[0]] : 0);
+            break;
+        case GLCAP_BIND_VERTEX_ARRAY:
+            glBindVertexArray(object(GLCAP_VERTEX_ARRAY, a[0]));
+            break;
+        case GLCAP_BIND_BUFFER:
+            glBindBuffer(a[0], object(GLCAP_BUFFER, a[1]));
+            break;
+        case GLCAP_BIND_TEXTURE:
+            glBindTexture(a[0], object(GLCAP_TEXTURE, a[1]));
+            break;
+        case GLCAP_ACTIVE_TEXTURE:
+            glActiveTexture(a[0]);
+            break;
+        case GLCAP_BIND_FRAMEBUFFER:
+            glBindFramebuffer(a[0], object(GLCAP_FRAMEBUFFER, a[1]));
+            break;
+        case GLCAP_BIND_RENDERBUFFER:
+            glBindRenderbuffer(a[0], object(GLCAP_RENDERBUFFER, a[1]));
+            break;
+        case GLCAP_ENABLE:
+            glEnable(a[0]);
+            break;
+        case GLCAP_DISABLE:
+            glDisable(a[0]);
+            break;
+        case GLCAP_VIEWPORT:
+            glViewport((GLint)a[0], (GLint)a[1], (GLsizei)a[2], (GLsizei)a[3]);
+            break;
+        case GLCAP_POLYGON_MODE:
+            glPolygonMode(a[0], a[1]);
+            break;
+        case GLCAP_LINE_WIDTH:
+            glLineWidth(GLCapture::toFloat(a[0]));
+            break;
+        case GLCAP_BLEND_FUNC:
+            glBlendFunc(a[0], a[1]);
+            break;
+        case GLCAP_CLEAR_COLOR:
+            glClearColor(GLCapture::toFloat(a[0]), GLCapture::toFloat(a[1]), GLCapture::toFloat(a[2]), GLCapture::toFloat(a[3]));
+            break;
+        case GLCAP_CLEAR:
+            glClear(a[0]);
+            break;
+        case GLCAP_DRAW_ARRAYS:
+            glDrawArrays(a[0], (GLint)a[1], (GLsizei)a[2]);
+            break;
+        case GLCAP_DRAW_ELEMENTS:
+            glDrawElements(a[0], (GLsizei)a[1], a[2], (const void*)(size_t)a[3]);
+            break;
+        case GLCAP_DRAW_ELEMENTS_BASE_VERTEX:
+            glDrawElementsBaseVertex(a[0], (GLsizei)a[1], a[2], (const void*)(size_t)a[3], (GLint)a[4]);
+            break;
+        case GLCAP_BUFFER_DATA:
+            glBufferData(a[0], (GLsizeiptr)a[1], data, a[2]);
+            break;
+        case GLCAP_BUFFER_SUB_DATA:
+            glBufferSubData(a[0], (GLintptr)a[1], (GLsizeiptr)a[2], data);
+            break;
+        case GLCAP_TEX_IMAGE_2D:
+            glTexImage2D(a[0], (GLint)a[1], (GLint)a[2], (GLsizei)a[3], (GLsizei)a[4], (GLint)a[5], a[6], a[7], data);
+            break;
+        case GLCAP_TEX_PARAMETER_I:
+            glTexParameteri(a[0], a[1], (GLint)a[2]);
+            break;
+        case GLCAP_TEX_PARAMETER_F:
+            glTexParameterf(a[0], a[1], GLCapture::toFloat(a[2]));
+            break;
+        case GLCAP_GENERATE_MIPMAP:
+            glGenerateMipmap(a[0]);
+            break;
+        case GLCAP_VERTEX_ATTRIB_POINTER:
+            glVertexAttribPointer(a[0], (GLint)a[1], a[2], (GLboolean)a[3], (GLsizei)a[4], (const void*)(size_t)a[5]);
+            break;
+        case GLCAP_VERTEX_ATTRIB_I_POINTER:
+            glVertexAttribIPointer(a[0], (GLint)a[1], a[2], (GLsizei)a[3], (const void*)(size_t)a[4]);
+            break;
+        case GLCAP_ENABLE_VERTEX_ATTRIB_ARRAY:
+            glEnableVertexAttribArray(a[0]);
+            break;
+        case GLCAP_DISABLE_VERTEX_ATTRIB_ARRAY:
+            glDisableVertexAttribArray(a[0]);
+            break;
+        case GLCAP_GET_UNIFORM_LOCATION:
+            if (data)
+                uniforms[a[0]][(GLint)a[1]] = glGetUniformLocation(programs[a[0]], (const GLchar*)data);
+            break;
+        case GLCAP_UNIFORM_1I:
+            glUniform1i(uniform(a[0]), (GLint)a[1]);
+            break;
+        case GLCAP_UNIFORM_1F:
+            glUniform1f(uniform(a[0]), GLCapture::toFloat(a[1]));
+            break;
+        case GLCAP_UNIFORM_3F:
+            glUniform3f(uniform(a[0]), GLCapture::toFloat(a[1]), GLCapture::toFloat(a[2]), GLCapture::toFloat(a[3]));
+            break;
+        case GLCAP_UNIFORM_3FV:
+            glUniform3fv(uniform(a[0]), (GLsizei)a[1], (const GLfloat*)data);
+            break;
+        case GLCAP_UNIFORM_4FV:
+            glUniform4fv(uniform(a[0]), (GLsizei)a[1], (const GLfloat*)data);
+            break;
+        case GLCAP_UNIFORM_MATRIX_3FV:
+            glUniformMatrix3fv(uniform(a[0]), (GLsizei)a[1], (GLboolean)a[2], (const GLfloat*)data);
+            break;
+        case GLCAP_UNIFORM_MATRIX_4FV:
+            glUniformMatrix4fv(uniform(a[0]), (GLsizei)a[1], (GLboolean)a[2], (const GLfloat*)data);
+            break;
+        case GLCAP_BLIT_FRAMEBUFFER:
+            glBlitFramebuffer((GLint)a[0], (GLint)a[1], (GLint)a[2], (GLint)a[3], (GLint)a[4], (GLint)a[5], (GLint)a[6], (GLint)a[7],
+                              a[8], a[9]);
+            break;
+        case GLCAP_FRAMEBUFFER_TEXTURE_2D:
+            glFramebufferTexture2D(a[0], a[1], a[2], object(GLCAP_TEXTURE, a[3]), (GLint)a[4]);
+            break;
+        case GLCAP_FRAMEBUFFER_RENDERBUFFER:
+            glFramebufferRenderbuffer(a[0], a[1], a[2], object(GLCAP_RENDERBUFFER, a[3]));
+            break;
+        case GLCAP_RENDERBUFFER_STORAGE:
+            glRenderbufferStorage(a[0], a[1], (GLsizei)a[2], (GLsizei)a[3]);
+            break;
+        case GLCAP_RENDERBUFFER_STORAGE_MULTISAMPLE:
+            glRenderbufferStorageMultisample(a[0], (GLsizei)a[1], a[2], (GLsizei)a[3], (GLsizei)a[4]);
+            break;
+        case GLCAP_BIND_BUFFER_BASE:
+            glBindBufferBase(a[0], a[1], object(GLCAP_BUFFER, a[2]));
+            break;
+        case GLCAP_TEX_BUFFER:
+            glTexBuffer(a[0], a[1], object(GLCAP_BUFFER, a[2]));
+            break;
+        case GLCAP_DEPTH_FUNC:
+            glDepthFunc(a[0]);
+            break;
+        case GLCAP_DEPTH_MASK:
+            glDepthMask((GLboolean)a[0]);
+            break;
+        case GLCAP_COLOR_MASK:
+            glColorMask((GLboolean)a[0], (GLboolean)a[1], (GLboolean)a[2], (GLboolean)a[3]);
+            break;
+        case GLCAP_POLYGON_OFFSET:
+            glPolygonOffset(GLCapture::toFloat(a[0]), GLCapture::toFloat(a[1]));
+            break;
+        case GLCAP_STENCIL_FUNC:
+            glStencilFunc(a[0], (GLint)a[1], (GLuint)a[2]);
+            break;
+        case GLCAP_STENCIL_OP:
+            glStencilOp(a[0], a[1], a[2]);
+            break;
+        case GLCAP_STENCIL_MASK:
+            glStencilMask((GLuint)a[0]);
+            break;
+        case GLCAP_SCISSOR:
+            glScissor((GLint)a[0], (GLint)a[1], (GLsizei)a[2], (GLsizei)a[3]);
+            break;
+        case GLCAP_UNIFORM_BLOCK_BINDING:
+        {
+            GLuint made = programs[a[0]];
+            GLuint index = data ? glGetUniformBlockIndex(made, (const GLchar*)data) : (GLuint)a[1];
+            if (made && index != GL_INVALID_INDEX)
+                glUniformBlockBinding(made, index, a[2]);
+            break;
+        }
+    }
+}
+
+/**
+\brief Kinds of wasted call the check lists.
+
+*/
+
+enum Waste
+{
+    WASTE_BIND,           ///< Bind of what is already bound.
+    WASTE_STATE,          ///< Fixed state set to what it is.
+    WASTE_UNIFORM,        ///< Uniform set to the value it has.
+    WASTE_LOOKUP,         ///< glGetUniformLocation during the frame.
+    WASTE_RESPECIFY,      ///< glBufferData on a buffer that has storage.
+    WASTE_SAME_UPLOAD,    ///< Buffer upload of the bytes already there.
+    WASTE_TEX_RESPECIFY,  ///< glTexImage2D over an existing image.
+    WASTE_ATTRIB,         ///< Vertex attribute layout or enable unchanged.
+    WASTE_TEX_PARAMETER,  ///< Texture parameter unchanged.
+    WASTE_COUNT
+};
+
+static const char* wasteNames[WASTE_COUNT] = {
+    "Redundant binds",
+    "Redundant fixed state",
+    "Uniforms set to their current value",
+    "Uniform lookups every frame",
+    "Buffers re-specified with glBufferData",
+    "Buffer uploads of unchanged data",
+    "Texture images re-specified",
+    "Vertex attribute setup unchanged",
+    "Texture parameters unchanged"
+};
+
+/**
+\brief What a piece of state the check follows is, the first part of its key.
+
+*/
+
+enum StateSlot
+{
+    SLOT_PROGRAM,
+    SLOT_VERTEX_ARRAY,
+    SLOT_BUFFER,
+    SLOT_TEXTURE,
+    SLOT_ACTIVE_TEXTURE,
+    SLOT_FRAMEBUFFER,
+    SLOT_RENDERBUFFER,
+    SLOT_CAPABILITY,
+    SLOT_FIXED,
+    SLOT_UNIFORM,
+    SLOT_TEX_PARAMETER,
+    SLOT_ATTRIB_LAYOUT,
+    SLOT_ATTRIB_ENABLED,
+    SLOT_BUFFER_BASE,
+    SLOT_BLOCK_BINDING
+};
+
+/**
+\brief Follows the OpenGL state through the calls, without OpenGL, to find the calls
+that change nothing.
+
+*/
+
+struct StateTracker
+{
+    typedef std::vector<unsigned long long> Key;
+
+    std::map<Key, unsigned long long> bound;                ///< What each bind point holds.
+    std::map<Key, std::vector<unsigned char> > values;      ///< Fixed state, uniform values and layouts last set.
+    std::map<unsigned long long, std::vector<unsigned char> > buffers;   ///< Contents of each buffer.
+    std::set<Key> images;                                   ///< Texture images that exist.
+    unsigned long long program;                             ///< Program in use.
+    unsigned long long vao;                                 ///< Vertex array bound.
+    unsigned long long unit;                                ///< Active texture unit.
+
+    std::vector<size_t> found[WASTE_COUNT];                 ///< Frame calls of each kind of waste.
+
+    StateTracker() : program(0), vao(0), unit(GL_TEXTURE0) {}
+
+    bool bind(const Key& point, unsigned long long name);
+    bool set(const Key& what, const std::vector<unsigned char>& value);
+    unsigned long long bufferAt(unsigned long long target);
+    int step(const GLCaptureCall& c);
+};
+
+/**
+\brief Binds a name to a bind point.
+
+\param point --- The bind point.
+\param name --- The name.
+
+\return True if it was already bound there.
+
+*/
+
+bool StateTracker::bind(const Key& point, unsigned long long name)
+{
+    std::map<Key, unsigned long long>::iterator it = bound.find(point);
+    if (it != bound.end() && it->second == name)
+        return true;
+    bound[point] = name;
+    return false;
+}
+
+/**
+\brief Sets a value.
+
+\param what --- What is set.
+\param value --- Its bytes.
+
+\return True if it already had the value.
+
+*/
+
+bool StateTracker::set(const Key& what, const std::vector<unsigned char>& value)
+{
+    std::map<Key, std::vector<unsigned char> >::iterator it = values.find(what);
+    if (it != values.end() && it->second == value)
+        return true;
+    values[what] = value;
+    return false;
+}
+
+/**
+\brief Returns the buffer bound to a target, the element buffer being the vertex
+array's.
+
+\param target --- Buffer target.
+
+*/
+
+unsigned long long StateTracker::bufferAt(unsigned long long target)
+{
+    Key point = target == GL_ELEMENT_ARRAY_BUFFER ? Key{SLOT_BUFFER, target, vao} : Key{SLOT_BUFFER, target};
+    std::map<Key, unsigned long long>::iterator it = bound.find(point);
+    return it != bound.end() ? it->second : 0;
+}
+
+/**
+\brief Returns the bytes of some arguments, to compare.
+
+\param c --- The call.
+\param first --- First argument.
+\param count --- Number of arguments.
+
+*/
+
+static std::vector<unsigned char> argBytes(const GLCaptureCall& c, int first, int count)
+{
+    const unsigned char* p = (const unsigned char*)(c.args + first);
+    return std::vector<unsigned char>(p, p + count * sizeof(c.args[0]));
+}
+
+/**
+\brief Returns the components of a uniform type, for GLCAP_UNIFORM_VALUE.
+
+\param type --- Uniform type.
+
+*/
+
+static int uniformComponents(unsigned long long type)
+{
+    switch (type)
+    {
+        case GL_FLOAT_VEC2:
+        case GL_INT_VEC2:
+        case GL_BOOL_VEC2:
+            return 2;
+        case GL_FLOAT_VEC3:
+        case GL_INT_VEC3:
+        case GL_BOOL_VEC3:
+            return 3;
+        case GL_FLOAT_VEC4:
+        case GL_INT_VEC4:
+        case GL_BOOL_VEC4:
+        case GL_FLOAT_MAT2:
+            return 4;
+        case GL_FLOAT_MAT3:
+            return 9;
+        case GL_FLOAT_MAT4:
+            return 16;
+        default:
+            return 1;
+    }
+}
+
+/**
+\brief Follows one call.
+
+\param c --- The call.
+
+\return The kind of waste the call is, or WASTE_COUNT if it changed something.
+
+*/
+
+int StateTracker::step(const GLCaptureCall& c)
+{
+    const unsigned long long* a = c.args;
+    std::vector<unsigned char> uniformValue;
+
+    switch (c.op)
+    {
+        case GLCAP_USE_PROGRAM:
+            return bind(Key{SLOT_PROGRAM}, program = a[0]) ? WASTE_BIND : WASTE_COUNT;
+        case GLCAP_BIND_VERTEX_ARRAY:
+            return bind(Key{SLOT_VERTEX_ARRAY}, vao = a[0]) ? WASTE_BIND : WASTE_COUNT;
+        case GLCAP_BIND_BUFFER:
+            if (a[0] == GL_ELEMENT_ARRAY_BUFFER)
+                return bind(Key{SLOT_BUFFER, a[0], vao}, a[1]) ? WASTE_BIND : WASTE_COUNT;
+            return bind(Key{SLOT_BUFFER, a[0]}, a[1]) ? WASTE_BIND : WASTE_COUNT;
+        case GLCAP_BIND_TEXTURE:
+            return bind(Key{SLOT_TEXTURE, unit, a[0]}, a[1]) ? WASTE_BIND : WASTE_COUNT;
+        case GLCAP_ACTIVE_TEXTURE:
+            unit = a[0];
+            return bind(Key{SLOT_ACTIVE_TEXTURE}, a[0]) ? WASTE_BIND : WASTE_COUNT;
+        case GLCAP_BIND_FRAMEBUFFER:
+            if (a[0] == GL_FRAMEBUFFER)
+            {
+                bool draw = bind(Key{SLOT_FRAMEBUFFER, GL_DRAW_FRAMEBUFFER}, a[1]);
+                bool read = bind(Key{SLOT_FRAMEBUFFER, GL_READ_FRAMEBUFFER}, a[1]);
+                return draw && read ? WASTE_BIND : WASTE_COUNT;
+            }
+            return bind(Key{SLOT_FRAMEBUFFER, a[0]}, a[1]) ? WASTE_BIND : WASTE_COUNT;
+        case GLCAP_BIND_RENDERBUFFER:
+            return bind(Key{SLOT_RENDERBUFFER}, a[1]) ? WASTE_BIND : WASTE_COUNT;
+        case GLCAP_BIND_BUFFER_BASE:
+        {
+            // Binds the target's general point too.
+            bool general = bind(Key{SLOT_BUFFER, a[0]}, a[2]);
+            bool indexed = bind(Key{SLOT_BUFFER_BASE, a[0], a[1]}, a[2]);
+            return general && indexed ? WASTE_BIND : WASTE_COUNT;
+        }
+
+        case GLCAP_ENABLE:
+        case GLCAP_DISABLE:
+            return set(Key{SLOT_CAPABILITY, a[0]}, std::vector<unsigned char>(1, c.op == GLCAP_ENABLE)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_VIEWPORT:
+            return set(Key{SLOT_FIXED, GL_VIEWPORT}, argBytes(c, 0, 4)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_POLYGON_MODE:
+            return set(Key{SLOT_FIXED, GL_POLYGON_MODE}, argBytes(c, 1, 1)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_LINE_WIDTH:
+            return set(Key{SLOT_FIXED, GL_LINE_WIDTH}, argBytes(c, 0, 1)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_BLEND_FUNC:
+            return set(Key{SLOT_FIXED, GL_BLEND}, argBytes(c, 0, 2)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_CLEAR_COLOR:
+            return set(Key{SLOT_FIXED, GL_COLOR_CLEAR_VALUE}, argBytes(c, 0, 4)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_DEPTH_FUNC:
+            return set(Key{SLOT_FIXED, GL_DEPTH_FUNC}, argBytes(c, 0, 1)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_DEPTH_MASK:
+            return set(Key{SLOT_FIXED, GL_DEPTH_WRITEMASK}, argBytes(c, 0, 1)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_COLOR_MASK:
+            return set(Key{SLOT_FIXED, GL_COLOR_WRITEMASK}, argBytes(c, 0, 4)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_POLYGON_OFFSET:
+            return set(Key{SLOT_FIXED, GL_POLYGON_OFFSET_FACTOR}, argBytes(c, 0, 2)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_STENCIL_FUNC:
+            return set(Key{SLOT_FIXED, GL_STENCIL_FUNC}, argBytes(c, 0, 3)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_STENCIL_OP:
+            return set(Key{SLOT_FIXED, GL_STENCIL_FAIL}, argBytes(c, 0, 3)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_STENCIL_MASK:
+            return set(Key{SLOT_FIXED, GL_STENCIL_WRITEMASK}, argBytes(c, 0, 1)) ? WASTE_STATE : WASTE_COUNT;
+        case GLCAP_SCISSOR:
+            return set(Key{SLOT_FIXED, GL_SCISSOR_BOX}, argBytes(c, 0, 4)) ? WASTE_STATE : WASTE_COUNT;
+
+        case GLCAP_UNIFORM_VALUE:
+            uniformValue.assign(c.payload.begin(), c.payload.begin() + std::min(c.payload.size(), (size_t)uniformComponents(a[1]) * 4));
+            return set(Key{SLOT_UNIFORM, program, a[0]}, uniformValue) ? WASTE_UNIFORM : WASTE_COUNT;
+        case GLCAP_UNIFORM_1I:
+        case GLCAP_UNIFORM_1F:
+            uniformValue.assign((const unsigned char*)(a + 1), (const unsigned char*)(a + 1) + 4);
+            return set(Key{SLOT_UNIFORM, program, a[0]}, uniformValue) ? WASTE_UNIFORM : WASTE_COUNT;
+        case GLCAP_UNIFORM_3F:
+            for (int i = 1; i <= 3; i++)
+                uniformValue.insert(uniformValue.end(), (const unsigned char*)(a + i), (const unsigned char*)(a + i) + 4);
+            return set(Key{SLOT_UNIFORM, program, a[0]}, uniformValue) ? WASTE_UNIFORM : WASTE_COUNT;
+        case GLCAP_UNIFORM_3FV:
+        case GLCAP_UNIFORM_4FV:
+        case GLCAP_UNIFORM_MATRIX_3FV:
+        case GLCAP_UNIFORM_MATRIX_4FV:
+            return set(Key{SLOT_UNIFORM, program, a[0]}, c.payload) ? WASTE_UNIFORM : WASTE_COUNT;
+        case GLCAP_GET_UNIFORM_LOCATION:
+            return WASTE_LOOKUP;
+        case GLCAP_UNIFORM_BLOCK_BINDING:
+            return set(Key{SLOT_BLOCK_BINDING, a[0], a[1]}, argBytes(c, 2, 1)) ? WASTE_UNIFORM : WASTE_COUNT;
+
+        case GLCAP_BUFFER_DATA:
+        {
+            unsigned long long buffer = bufferAt(a[0]);
+            std::map<unsigned long long, std::vector<unsigned char> >::iterator it = buffers.find(buffer);
+            bool had = it != buffers.end();
+            bool same = had && !c.payload.empty() && it->second == c.payload;
+            buffers[buffer] = c.payload.empty() ? std::vector<unsigned char>(a[1]) : c.payload;
+            if (same)
+                return WASTE_SAME_UPLOAD;
+            return had ? WASTE_RESPECIFY : WASTE_COUNT;
+        }
+        case GLCAP_BUFFER_SUB_DATA:
+        {
+            std::vector<unsigned char>& contents = buffers[bufferAt(a[0])];
+            size_t offset = a[1];
+            size_t size = c.payload.size();
+            if (contents.size() < offset + size)
+                contents.resize(offset + size);
+            bool same = size > 0 && memcmp(&contents[offset], &c.payload[0], size) == 0;
+            if (size > 0)
+                memcpy(&contents[offset], &c.payload[0], size);
+            return same ? WASTE_SAME_UPLOAD : WASTE_COUNT;
+        }
+        case GLCAP_TEX_IMAGE_2D:
+        {
+            unsigned long long target = a[0] == GL_TEXTURE_2D ? GL_TEXTURE_2D : GL_TEXTURE_CUBE_MAP;
+            Key image{bound[Key{SLOT_TEXTURE, unit, target}], a[0], a[1]};
+            return images.insert(image).second ? WASTE_COUNT : WASTE_TEX_RESPECIFY;
+        }
+        case GLCAP_TEX_PARAMETER_I:
+        case GLCAP_TEX_PARAMETER_F:
+            return set(Key{SLOT_TEX_PARAMETER, bound[Key{SLOT_TEXTURE, unit, a[0]}], a[1]}, argBytes(c, 2, 1)) ? WASTE_TEX_PARAMETER : WASTE_COUNT;
+        case GLCAP_TEX_BUFFER:
+            return set(Key{SLOT_TEX_PARAMETER, bound[Key{SLOT_TEXTURE, unit, a[0]}], GL_TEXTURE_BUFFER}, argBytes(c, 1, 2)) ? WASTE_TEX_PARAMETER : WASTE_COUNT;
+
+        case GLCAP_VERTEX_ATTRIB_POINTER:
+        case GLCAP_VERTEX_ATTRIB_I_POINTER:
+        {
+            std::vector<unsigned char> layout = argBytes(c, 0, 6);
+            unsigned long long buffer = bufferAt(GL_ARRAY_BUFFER);
+            layout.insert(layout.end(), (const unsigned char*)&buffer, (const unsigned char*)&buffer + sizeof(buffer));
+            return set(Key{SLOT_ATTRIB_LAYOUT, vao, a[0]}, layout) ? WASTE_ATTRIB : WASTE_COUNT;
+        }
+        case GLCAP_ENABLE_VERTEX_ATTRIB_ARRAY:
+        case GLCAP_DISABLE_VERTEX_ATTRIB_ARRAY:
+            return set(Key{SLOT_ATTRIB_ENABLED, vao, a[0]},
+                       std::vector<unsigned char>(1, c.op == GLCAP_ENABLE_VERTEX_ATTRIB_ARRAY)) ? WASTE_ATTRIB : WASTE_COUNT;
+
+        default:
+            return WASTE_COUNT;
+    }
+}
+
+/**
+\brief Prints a call, its function and arguments.
+
+\param c --- The call.
+\param index --- Its place in the frame.
+
+*/
+
+static void printCall(const GLCaptureCall& c, size_t index)
+{
+    // Arguments each op records, in GLCaptureOp order.
+    static const int argCounts[GLCAP_OP_COUNT] = {
+        2, 1, 3, 1, 1, 2, 2, 1, 2, 2, 1, 1, 4, 2, 1, 2, 4, 1, 3, 4, 5, 3, 3, 8, 3, 3, 1, 6, 5, 1, 1, 2, 2, 2, 4, 2, 2,
+        3, 3, 10, 5, 4, 4, 5, 3, 3, 3, 1, 1, 4, 2, 3, 3, 1, 4
+    };
+
+    printf("      #%-6zu %s(", index, GLCapture::opName(c.op));
+    int count = c.op < GLCAP_OP_COUNT ? argCounts[c.op] : 0;
+    for (int i = 0; i < count; i++)
+        printf(i ? ", %lld" : "%lld", (long long)c.args[i]);
+    if ((c.op == GLCAP_GET_UNIFORM_LOCATION || c.op == GLCAP_UNIFORM_BLOCK_BINDING) && !c.payload.empty())
+        printf(", \"%s\"", (const char*)&c.payload[0]);
+    else if (!c.payload.empty())
+        printf(", %zu bytes", c.payload.size());
+    printf(")\n");
+}
+
+/**
+\brief Finds and prints the frame's calls that change nothing.
+
+\param capture --- The capture.
+\param verbose --- List every call found, not only the first few of each kind.
+
+*/
+
+static void checkWaste(const GLCaptureFile& capture, bool verbose)
+{
+    StateTracker state;
+    for (size_t i = 0; i < capture.setup.size(); i++)
+        state.step(capture.setup[i]);
+
+    for (size_t i = 0; i < capture.frame.size(); i++)
+    {
+        int waste = state.step(capture.frame[i]);
+        if (waste < WASTE_COUNT)
+            state.found[waste].push_back(i);
+    }
+
+    printf("\nCalls that change nothing, of %zu in the frame:\n", capture.frame.size());
+    bool any = false;
+    for (int w = 0; w < WASTE_COUNT; w++)
+    {
+        const std::vector<size_t>& found = state.found[w];
+        if (found.empty())
+            continue;
+        any = true;
+        printf("  %-40s %6zu\n", wasteNames[w], found.size());
+        size_t shown = verbose ? found.size() : std::min(found.size(), (size_t)3);
+        for (size_t i = 0; i < shown; i++)
+            printCall(capture.frame[found[i]], found[i]);
+        if (shown < found.size())
+            printf("      ...\n");
+    }
+    if (!any)
+        printf("  None\n");
+}
+
+/**
+\brief Seconds since a time point.
+
+\param start --- The time point.
+
+*/
+
+static double secondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+/**
+\brief Sorts the most costly function first.
+
+*/
+
+static bool costlier(const OpCost& a, const OpCost& b)
+{
+    return a.seconds > b.seconds;
+}
+
+/**
+\brief Replayer entry point.
+
+*/
+
+int main(int argc, char** argv)
+{
+    std::string file;
+    int frames = 200;
+    int warmup = 20;
+    bool verbose = false;
+    bool usage = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-n") == 0 && i + 1 < argc)
+            frames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-w") == 0 && i + 1 < argc)
+            warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-v") == 0)
+            verbose = true;
+        else if (argv[i][0] != '-' && file.empty())
+            file = argv[i];
+        else
+            usage = true;
+    }
+    if (usage || file.empty() || frames < 1)
+    {
+        fprintf(stderr, "Usage: %s capture.ohgl [-n frames] [-w warmup] [-v]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    GLCaptureFile capture;
+    if (!capture.load(file))
+        return EXIT_FAILURE;
+
+    printf("%s: %dx%d, %zu setup calls, %zu frame calls\n", file.c_str(), capture.width, capture.height, capture.setup.size(),
+           capture.frame.size());
+    checkWaste(capture, verbose);
+
+    OffscreenContext context;
+    if (!context.create(capture.width, capture.height, 3, 3))
+        return EXIT_FAILURE;
+
+    glewExperimental = GL_TRUE;
+    GLenum glewErr = glewInit();
+#ifdef GLEW_ERROR_NO_GLX_DISPLAY
+    // GLEW built for GLX finds no X display under EGL but still loads the core functions.
+    if (glewErr == GLEW_ERROR_NO_GLX_DISPLAY)
+        glewErr = GLEW_OK;
+#endif // GLEW_ERROR_NO_GLX_DISPLAY
+    if (glewErr != GLEW_OK)
+    {
+        fprintf(stderr, "Unable to initialize GLEW\n");
+        return EXIT_FAILURE;
+    }
+    while (glGetError() != GL_NO_ERROR)
+        ;
+
+    printf("\nReplaying on %s\n", (const char*)glGetString(GL_RENDERER));
+
+    Replayer replayer;
+    std::chrono::steady_clock::time_point setupStart = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < capture.setup.size(); i++)
+        replayer.run(capture.setup[i]);
+    glFinish();
+    printf("Setup: %.1f ms\n", secondsSince(setupStart) * 1000);
+    if (glGetError() != GL_NO_ERROR)
+        fprintf(stderr, "The setup raised OpenGL errors, the replay may differ from the game.\n");
+
+    for (int f = 0; f < warmup; f++)
+        for (size_t i = 0; i < capture.frame.size(); i++)
+            replayer.run(capture.frame[i]);
+    glFinish();
+
+    std::vector<OpCost> costs(GLCAP_OP_COUNT);
+    for (unsigned int op = 0; op < GLCAP_OP_COUNT; op++)
+    {
+        costs[op].op = op;
+        costs[op].calls = 0;
+        costs[op].seconds = 0;
+    }
+
+    GLuint query = 0;
+    glGenQueries(1, &query);
+    double submitSeconds = 0;
+    double frameSeconds = 0;
+    double gpuSeconds = 0;
+
+    for (int f = 0; f < frames; f++)
+    {
+        std::chrono::steady_clock::time_point frameStart = std::chrono::steady_clock::now();
+        glBeginQuery(GL_TIME_ELAPSED, query);
+        for (size_t i = 0; i < capture.frame.size(); i++)
+        {
+            const GLCaptureCall& c = capture.frame[i];
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+            replayer.run(c);
+            double s = secondsSince(start);
+            costs[c.op].calls++;
+            costs[c.op].seconds += s;
+            submitSeconds += s;
+        }
+        glEndQuery(GL_TIME_ELAPSED);
+        glFinish();
+        frameSeconds += secondsSince(frameStart);
+
+        GLuint64 ns = 0;
+        glGetQueryObjectui64v(query, GL_QUERY_RESULT, &ns);
+        gpuSeconds += ns * 1e-9;
+    }
+    glDeleteQueries(1, &query);
+
+    printf("\nPer frame over %d frames: submit %.3f ms, with glFinish %.3f ms, GPU %.3f ms\n", frames, submitSeconds * 1000 / frames,
+           frameSeconds * 1000 / frames, gpuSeconds * 1000 / frames);
+
+    std::sort(costs.begin(), costs.end(), costlier);
+    printf("\n%-34s %10s %14s %12s %8s\n", "Function", "Calls", "us/frame", "ns/call", "Share");
+    for (size_t i = 0; i < costs.size(); i++)
+    {
+        const OpCost& c = costs[i];
+        if (c.calls == 0)
+            continue;
+        printf("%-34s %10lld %14.2f %12.1f %7.1f%%\n", GLCapture::opName(c.op), c.calls / frames, c.seconds * 1e6 / frames,
+               c.seconds * 1e9 / c.calls, submitSeconds > 0 ? c.seconds * 100 / submitSeconds : 0.0);
+    }
+
+    return EXIT_SUCCESS;
+}
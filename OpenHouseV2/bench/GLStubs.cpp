@@ -0,0 +1,195 @@
+#include <GL/glew.h>
+
+/**
+\file GLStubs.cpp
+\brief OpenGL functions that do nothing, for benchmarks with no context.
+
+Linked in place of GLEW and the OpenGL library, so the loaders and text renderer can be
+timed on the CPU alone.  Each GLEW entry point the game's loaders use is defined here
+already pointing at a stub, so glewInit is never needed, and the OpenGL 1.1 functions are
+defined as stubs themselves.  Names handed out count up from 1, shaders always compile
+and link, and every uniform is found at location 0, so no loader takes its error path.
+There are no program binary formats, so ShaderCache always compiles and never saves.
+
+A benchmark that calls a function missing from here fails to link, add a stub for it.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+static GLuint nextName = 0;   ///< Last buffer, vertex array, texture, shader or program name given out.
+
+static void GLAPIENTRY stubGenNames(GLsizei n, GLuint* names)
+{
+    for (GLsizei i = 0; i < n; i++)
+        names[i] = ++nextName;
+}
+
+static void GLAPIENTRY stubDeleteNames(GLsizei, const GLuint*) {}
+static void GLAPIENTRY stubBind(GLenum, GLuint) {}
+static void GLAPIENTRY stubUint(GLuint) {}
+static void GLAPIENTRY stubEnum(GLenum) {}
+static GLuint GLAPIENTRY stubCreateProgram() { return ++nextName; }
+static GLuint GLAPIENTRY stubCreateShader(GLenum) { return ++nextName; }
+static void GLAPIENTRY stubAttachShader(GLuint, GLuint) {}
+static void GLAPIENTRY stubProgramParameteri(GLuint, GLenum, GLint) {}
+static void GLAPIENTRY stubGetProgramBinary(GLuint, GLsizei, GLsizei* length, GLenum*, void*) { *length = 0; }
+static void GLAPIENTRY stubProgramBinary(GLuint, GLenum, const void*, GLsizei) {}
+static void GLAPIENTRY stubShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) {}
+static void GLAPIENTRY stubInfoLog(GLuint, GLsizei, GLsizei* length, GLchar* log)
+{
+    if (length)
+        *length = 0;
+    if (log)
+        log[0] = 0;
+}
+
+static void GLAPIENTRY stubGetiv(GLuint, GLenum pname, GLint* params)
+{
+    *params = pname == GL_INFO_LOG_LENGTH ? 0 : GL_TRUE;
+}
+
+static GLint GLAPIENTRY stubGetUniformLocation(GLuint, const GLchar*) { return 0; }
+static void GLAPIENTRY stubGetActiveUniform(GLuint, GLuint, GLsizei, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    stubInfoLog(0, 0, length, name);
+    *size = 0;
+    *type = 0;
+}
+static void GLAPIENTRY stubGetUniformIndices(GLuint, GLsizei count, const GLchar* const*, GLuint* indices)
+{
+    for (GLsizei i = 0; i < count; i++)
+        indices[i] = GL_INVALID_INDEX;
+}
+static GLuint GLAPIENTRY stubGetUniformBlockIndex(GLuint, const GLchar*) { return GL_INVALID_INDEX; }
+static void GLAPIENTRY stubGetActiveUniformBlockName(GLuint, GLuint, GLsizei, GLsizei* length, GLchar* name)
+{
+    stubInfoLog(0, 0, length, name);
+}
+static void GLAPIENTRY stubGetActiveUniformBlockiv(GLuint, GLuint, GLenum, GLint* params) { *params = 0; }
+static void GLAPIENTRY stubUniformBlockBinding(GLuint, GLuint, GLuint) {}
+static void GLAPIENTRY stubBindBufferBase(GLenum, GLuint, GLuint) {}
+static void GLAPIENTRY stubTexBuffer(GLenum, GLenum, GLuint) {}
+static void GLAPIENTRY stubGetUniformfv(GLuint, GLint, GLfloat* params) { *params = 0; }
+static void GLAPIENTRY stubGetUniformiv(GLuint, GLint, GLint* params) { *params = 0; }
+static void GLAPIENTRY stubBufferData(GLenum, GLsizeiptr, const void*, GLenum) {}
+static void GLAPIENTRY stubBufferSubData(GLenum, GLintptr, GLsizeiptr, const void*) {}
+static void GLAPIENTRY stubVertexAttribPointer(GLuint, GLint, GLenum, GLboolean, GLsizei, const void*) {}
+static void GLAPIENTRY stubVertexAttribIPointer(GLuint, GLint, GLenum, GLsizei, const void*) {}
+static void GLAPIENTRY stubDrawElementsBaseVertex(GLenum, GLsizei, GLenum, const void*, GLint) {}
+static void GLAPIENTRY stubUniform1i(GLint, GLint) {}
+static void GLAPIENTRY stubUniform1f(GLint, GLfloat) {}
+static void GLAPIENTRY stubUniformfv(GLint, GLsizei, const GLfloat*) {}
+static void GLAPIENTRY stubUniformiv(GLint, GLsizei, const GLint*) {}
+static void GLAPIENTRY stubUniformMatrixfv(GLint, GLsizei, GLboolean, const GLfloat*) {}
+static GLenum GLAPIENTRY stubCheckFramebufferStatus(GLenum) { return GL_FRAMEBUFFER_COMPLETE; }
+static void GLAPIENTRY stubRenderbufferStorage(GLenum, GLenum, GLsizei, GLsizei) {}
+static void GLAPIENTRY stubFramebufferRenderbuffer(GLenum, GLenum, GLenum, GLuint) {}
+static void GLAPIENTRY stubFramebufferTexture2D(GLenum, GLenum, GLenum, GLuint, GLint) {}
+static void GLAPIENTRY stubBlitFramebuffer(GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLint, GLbitfield, GLenum) {}
+
+PFNGLACTIVETEXTUREPROC __glewActiveTexture = stubEnum;
+PFNGLATTACHSHADERPROC __glewAttachShader = stubAttachShader;
+PFNGLBINDBUFFERPROC __glewBindBuffer = stubBind;
+PFNGLBINDBUFFERBASEPROC __glewBindBufferBase = stubBindBufferBase;
+PFNGLBINDFRAMEBUFFERPROC __glewBindFramebuffer = stubBind;
+PFNGLBINDRENDERBUFFERPROC __glewBindRenderbuffer = stubBind;
+PFNGLBINDVERTEXARRAYPROC __glewBindVertexArray = stubUint;
+PFNGLBLITFRAMEBUFFERPROC __glewBlitFramebuffer = stubBlitFramebuffer;
+PFNGLBUFFERDATAPROC __glewBufferData = stubBufferData;
+PFNGLBUFFERSUBDATAPROC __glewBufferSubData = stubBufferSubData;
+PFNGLCHECKFRAMEBUFFERSTATUSPROC __glewCheckFramebufferStatus = stubCheckFramebufferStatus;
+PFNGLCOMPILESHADERPROC __glewCompileShader = stubUint;
+PFNGLCREATEPROGRAMPROC __glewCreateProgram = stubCreateProgram;
+PFNGLCREATESHADERPROC __glewCreateShader = stubCreateShader;
+PFNGLDELETEBUFFERSPROC __glewDeleteBuffers = stubDeleteNames;
+PFNGLDELETEFRAMEBUFFERSPROC __glewDeleteFramebuffers = stubDeleteNames;
+PFNGLDELETEPROGRAMPROC __glewDeleteProgram = stubUint;
+PFNGLDELETERENDERBUFFERSPROC __glewDeleteRenderbuffers = stubDeleteNames;
+PFNGLDELETESHADERPROC __glewDeleteShader = stubUint;
+PFNGLDELETEVERTEXARRAYSPROC __glewDeleteVertexArrays = stubDeleteNames;
+PFNGLDETACHSHADERPROC __glewDetachShader = stubAttachShader;
+PFNGLDISABLEVERTEXATTRIBARRAYPROC __glewDisableVertexAttribArray = stubUint;
+PFNGLDRAWELEMENTSBASEVERTEXPROC __glewDrawElementsBaseVertex = stubDrawElementsBaseVertex;
+PFNGLENABLEVERTEXATTRIBARRAYPROC __glewEnableVertexAttribArray = stubUint;
+PFNGLFRAMEBUFFERRENDERBUFFERPROC __glewFramebufferRenderbuffer = stubFramebufferRenderbuffer;
+PFNGLFRAMEBUFFERTEXTURE2DPROC __glewFramebufferTexture2D = stubFramebufferTexture2D;
+PFNGLGENBUFFERSPROC __glewGenBuffers = stubGenNames;
+PFNGLGENFRAMEBUFFERSPROC __glewGenFramebuffers = stubGenNames;
+PFNGLGENERATEMIPMAPPROC __glewGenerateMipmap = stubEnum;
+PFNGLGENRENDERBUFFERSPROC __glewGenRenderbuffers = stubGenNames;
+PFNGLGENVERTEXARRAYSPROC __glewGenVertexArrays = stubGenNames;
+PFNGLGETPROGRAMBINARYPROC __glewGetProgramBinary = stubGetProgramBinary;
+PFNGLGETPROGRAMINFOLOGPROC __glewGetProgramInfoLog = stubInfoLog;
+PFNGLGETPROGRAMIVPROC __glewGetProgramiv = stubGetiv;
+PFNGLGETSHADERINFOLOGPROC __glewGetShaderInfoLog = stubInfoLog;
+PFNGLGETSHADERIVPROC __glewGetShaderiv = stubGetiv;
+PFNGLGETACTIVEUNIFORMPROC __glewGetActiveUniform = stubGetActiveUniform;
+PFNGLGETACTIVEUNIFORMBLOCKNAMEPROC __glewGetActiveUniformBlockName = stubGetActiveUniformBlockName;
+PFNGLGETACTIVEUNIFORMBLOCKIVPROC __glewGetActiveUniformBlockiv = stubGetActiveUniformBlockiv;
+PFNGLGETUNIFORMBLOCKINDEXPROC __glewGetUniformBlockIndex = stubGetUniformBlockIndex;
+PFNGLGETUNIFORMINDICESPROC __glewGetUniformIndices = stubGetUniformIndices;
+PFNGLGETUNIFORMFVPROC __glewGetUniformfv = stubGetUniformfv;
+PFNGLGETUNIFORMIVPROC __glewGetUniformiv = stubGetUniformiv;
+PFNGLGETUNIFORMLOCATIONPROC __glewGetUniformLocation = stubGetUniformLocation;
+PFNGLLINKPROGRAMPROC __glewLinkProgram = stubUint;
+PFNGLPROGRAMBINARYPROC __glewProgramBinary = stubProgramBinary;
+PFNGLPROGRAMPARAMETERIPROC __glewProgramParameteri = stubProgramParameteri;
+PFNGLRENDERBUFFERSTORAGEPROC __glewRenderbufferStorage = stubRenderbufferStorage;
+PFNGLSHADERSOURCEPROC __glewShaderSource = stubShaderSource;
+PFNGLTEXBUFFERPROC __glewTexBuffer = stubTexBuffer;
+PFNGLUNIFORM1FPROC __glewUniform1f = stubUniform1f;
+PFNGLUNIFORM1FVPROC __glewUniform1fv = stubUniformfv;
+PFNGLUNIFORM1IPROC __glewUniform1i = stubUniform1i;
+PFNGLUNIFORM1IVPROC __glewUniform1iv = stubUniformiv;
+PFNGLUNIFORM2FVPROC __glewUniform2fv = stubUniformfv;
+PFNGLUNIFORM2IVPROC __glewUniform2iv = stubUniformiv;
+PFNGLUNIFORM3FVPROC __glewUniform3fv = stubUniformfv;
+PFNGLUNIFORM3IVPROC __glewUniform3iv = stubUniformiv;
+PFNGLUNIFORM4FVPROC __glewUniform4fv = stubUniformfv;
+PFNGLUNIFORM4IVPROC __glewUniform4iv = stubUniformiv;
+PFNGLUNIFORMMATRIX2FVPROC __glewUniformMatrix2fv = stubUniformMatrixfv;
+PFNGLUNIFORMMATRIX3FVPROC __glewUniformMatrix3fv = stubUniformMatrixfv;
+PFNGLUNIFORMBLOCKBINDINGPROC __glewUniformBlockBinding = stubUniformBlockBinding;
+PFNGLUNIFORMMATRIX4FVPROC __glewUniformMatrix4fv = stubUniformMatrixfv;
+PFNGLUSEPROGRAMPROC __glewUseProgram = stubUint;
+PFNGLVERTEXATTRIBIPOINTERPROC __glewVertexAttribIPointer = stubVertexAttribIPointer;
+PFNGLVERTEXATTRIBPOINTERPROC __glewVertexAttribPointer = stubVertexAttribPointer;
+
+#ifdef GL_KHR_parallel_shader_compile
+static void GLAPIENTRY stubMaxShaderCompilerThreads(GLuint) {}
+PFNGLMAXSHADERCOMPILERTHREADSKHRPROC __glewMaxShaderCompilerThreadsKHR = stubMaxShaderCompilerThreads;
+GLboolean __GLEW_KHR_parallel_shader_compile = GL_FALSE;
+#endif // GL_KHR_parallel_shader_compile
+
+extern "C"
+{
+
+void GLAPIENTRY glBindTexture(GLenum, GLuint) {}
+void GLAPIENTRY glBlendFunc(GLenum, GLenum) {}
+void GLAPIENTRY glClear(GLbitfield) {}
+void GLAPIENTRY glDeleteTextures(GLsizei, const GLuint*) {}
+void GLAPIENTRY glDepthMask(GLboolean) {}
+void GLAPIENTRY glDisable(GLenum) {}
+void GLAPIENTRY glDrawArrays(GLenum, GLint, GLsizei) {}
+void GLAPIENTRY glDrawBuffer(GLenum) {}
+void GLAPIENTRY glDrawElements(GLenum, GLsizei, GLenum, const void*) {}
+void GLAPIENTRY glEnable(GLenum) {}
+GLenum GLAPIENTRY glGetError() { return GL_NO_ERROR; }
+void GLAPIENTRY glGenTextures(GLsizei n, GLuint* textures) { stubGenNames(n, textures); }
+void GLAPIENTRY glGetIntegerv(GLenum, GLint* data) { *data = 0; }
+const GLubyte* GLAPIENTRY glGetString(GLenum) { return (const GLubyte*)"stub"; }
+void GLAPIENTRY glLineWidth(GLfloat) {}
+void GLAPIENTRY glPixelStorei(GLenum, GLint) {}
+void GLAPIENTRY glPolygonMode(GLenum, GLenum) {}
+void GLAPIENTRY glPolygonOffset(GLfloat, GLfloat) {}
+void GLAPIENTRY glReadBuffer(GLenum) {}
+void GLAPIENTRY glScissor(GLint, GLint, GLsizei, GLsizei) {}
+void GLAPIENTRY glTexImage2D(GLenum, GLint, GLint, GLsizei, GLsizei, GLint, GLenum, GLenum, const void*) {}
+void GLAPIENTRY glTexParameterf(GLenum, GLenum, GLfloat) {}
+void GLAPIENTRY glTexParameteri(GLenum, GLenum, GLint) {}
+void GLAPIENTRY glViewport(GLint, GLint, GLsizei, GLsizei) {}
+
+}
@@ -0,0 +1,272 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <string>
+
+#include <SFML/System.hpp>
+
+#include "../FighterCore.h"
+#include "../MatchSim.h"
+#include "../NetPlay.h"
+#include "../ProgramDefines.h"
+
+/**
+\file NetMatch.cpp
+\brief Headless network player for trying netplay on one machine.
+
+Plays one side of a network match with no window, driven by the same scripted player
+as the rollback test, at the real tick rate.  The host goes through the menu into a
+fight and both sides then fight until the time is up.  At the end each side waits for
+the other's last input and prints the state checksum, which must be the same on both,
+along with the rollback and network metrics.  Run two of these, or one against the
+game, through net_relay to add latency, jitter and loss:
+
+    net_match -host -m rollback -d 1
+    net_relay -l 60 -j 20 -d 5
+    net_match -join 127.0.0.1:45001
+
+Usage:
+
+    net_match -host [-p port] [-m delay|rollback] [-d delay] [-t seconds] [-s seed] [-fighters list]
+    net_match -join address[:port] [-t seconds] [-s seed] [-fighters list]
+
+-fighters is the fighter list to load, the game's by default when run from the compile
+directory.  Both sides must load the same fighters.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+static const char* defaultFighterList = "../OpenHouseV2/" FIGHTER_LIST;   ///< The game's fighters, from the compile directory.
+
+/**
+\brief Gives one tick of scripted input.
+
+\param net --- Match to give it to.
+\param f --- The fighters.
+\param seed --- State of the script.
+\param moving --- Direction held, 0 none, 1 forward, 2 back.
+
+*/
+
+static void play(NetPlay& net, FighterCore* f, unsigned int& seed, int& moving)
+{
+    seed = seed * 1664525u + 1013904223u;
+    unsigned int r = (seed >> 16) % 1000;
+    float dist = fabs(f[0].fighterX[0] - f[1].fighterX[1]);
+
+    SimInput in = {SIM_MOVE, 0, 0, 0};
+    int want = (r < 900) ? 1 : (r < 960 ? 2 : 0);
+    if (want != moving && r % 8 == 0)
+    {
+        moving = want;
+        in.a = want == 1;
+        in.b = want == 2;
+        net.addLocalInput(in);
+        in.a = 0;
+        in.b = 0;
+    }
+
+    if (dist < 20 && r < 80)
+    {
+        in.type = r < 40 ? SIM_PUNCH : (r < 65 ? SIM_KICK : (r < 75 ? SIM_TORNADO : SIM_JUMP));
+        net.addLocalInput(in);
+    }
+
+    if (net.getLocalPlayer() == 0 && (f[1].fighterHP[0] <= 0 || f[0].fighterHP[1] <= 0) && r < 100)
+    {
+        in.type = SIM_RESTART;
+        net.addLocalInput(in);
+    }
+}
+
+/**
+\brief Network player entry point.
+
+*/
+
+int main(int argc, char** argv)
+{
+    NetConfig cfg;
+    cfg.host = false;
+    cfg.address = "";
+    cfg.port = NET_PORT;
+    cfg.mode = NET_ROLLBACK;
+    cfg.inputDelay = 1;
+    double seconds = 60;
+    unsigned int seed = 1;
+    bool bad = false;
+    bool portSet = false;
+    std::string fighterList = defaultFighterList;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-host") == 0)
+            cfg.host = true;
+        else if (strcmp(argv[i], "-join") == 0 && i + 1 < argc)
+        {
+            cfg.address = argv[++i];
+            size_t colon = cfg.address.find(':');
+            if (colon != std::string::npos)
+            {
+                cfg.port = (unsigned short)atoi(cfg.address.c_str() + colon + 1);
+                cfg.address = cfg.address.substr(0, colon);
+                portSet = true;
+            }
+        }
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+        {
+            cfg.port = (unsigned short)atoi(argv[++i]);
+            portSet = true;
+        }
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+        {
+            i++;
+            if (strcmp(argv[i], "delay") == 0)
+                cfg.mode = NET_DELAY;
+            else if (strcmp(argv[i], "rollback") == 0)
+                cfg.mode = NET_ROLLBACK;
+            else
+                bad = true;
+        }
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            cfg.inputDelay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-fighters") == 0 && i + 1 < argc)
+            fighterList = argv[++i];
+        else
+            bad = true;
+    }
+
+    if (bad || cfg.host == !cfg.address.empty())
+    {
+        fprintf(stderr, "Usage: %s -host [-p port] [-m delay|rollback] [-d delay] [-t seconds] [-s seed] [-fighters list]\n"
+                        "       %s -join address[:port] [-t seconds] [-s seed] [-fighters list]\n", argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (!cfg.host && !portSet)
+        cfg.port = NET_PORT;
+
+    FighterTable table;
+    if (!table.load(fighterList))
+        return EXIT_FAILURE;
+
+    FighterCore f[2];
+    MatchSim sim(&f[0], &f[1], &table);
+    NetPlay net(&sim);
+    if (!net.open(cfg))
+        return EXIT_FAILURE;
+
+    seed = seed * 2 + (cfg.host ? 1 : 2);
+    int moving = 0;
+    long long endTick = -1;
+
+    // Per frame rollback metrics, one frame per step here.
+    long long frames = 0;
+    long long framesRolledBack = 0;
+    int depthCount[ROLLBACK_WINDOW + 1] = {0};
+    double worstResim = 0;
+
+    sf::Clock clock;
+    double tickMs = 1000.0 / SimTickRate;
+    double nextStep = 0;
+
+    while (net.isOpen())
+    {
+        if (clock.getElapsedTime().asMicroseconds() / 1000.0 < nextStep)
+        {
+            sf::sleep(sf::milliseconds(1));
+            continue;
+        }
+        nextStep += tickMs;
+
+        if (!net.isPlaying())
+        {
+            net.step();
+            continue;
+        }
+
+        RollbackSession* session = net.getSession();
+        if (endTick < 0)
+            endTick = session->getTick() + (long long)(seconds * SimTickRate);
+        if (session->getTick() >= endTick)
+            break;
+
+        // The host takes the menu into the Roman bath house.
+        long long tick = session->getTick();
+        if (sim.arenaNum == 3)
+        {
+            if (net.getLocalPlayer() == 0 && tick % 30 == 29 && tick < 120)
+            {
+                SimInput in = {SIM_MENU_SELECT, 0, 0, 0};
+                net.addLocalInput(in);
+            }
+        }
+        else if (session->canAdvance())
+            play(net, f, seed, moving);
+
+        net.step();
+
+        int depth;
+        double sec;
+        net.takeFrameStats(depth, sec);
+        frames++;
+        if (depth > 0)
+            framesRolledBack++;
+        depthCount[depth < ROLLBACK_WINDOW ? depth : ROLLBACK_WINDOW]++;
+        if (sec > worstResim)
+            worstResim = sec;
+    }
+
+    if (!net.isPlaying())
+    {
+        fprintf(stderr, "The match ended early.\n");
+        return EXIT_FAILURE;
+    }
+
+    // Wait for the other side's last input, then stay a moment so it gets ours.
+    RollbackSession* session = net.getSession();
+    sf::Clock settle;
+    while (!net.isSettled() && settle.getElapsedTime().asSeconds() < 3)
+    {
+        net.poll();
+        sf::sleep(sf::milliseconds(5));
+    }
+    bool settled = net.isSettled();
+    session->catchUp();
+    for (int i = 0; i < 50; i++)
+    {
+        net.poll();
+        sf::sleep(sf::milliseconds(10));
+    }
+
+    long long ticks = session->getTick();
+    printf("Mode:           %s, %d ticks input delay, player %d\n", net.getMode() == NET_DELAY ? "delay" : "rollback",
+           session->getInputDelay(), net.getLocalPlayer() + 1);
+    printf("Ticks:          %lld (%.1f s of play) in %lld frames, %lld stalled, %lld waited\n", ticks, (double)ticks / SimTickRate,
+           frames, session->getStalls(), net.getWaits());
+    printf("Network:        %.1f ms ping, %lld packets sent, %lld received, %.1f bytes per packet\n", net.getPing(),
+           net.getPacketsSent(), net.getPacketsReceived(), net.getPacketsSent() > 0 ? (double)net.getBytesSent() / net.getPacketsSent() : 0.0);
+    printf("Rollbacks:      %lld, %.2f ticks deep on average, %d deepest, %.2f resimulated per tick\n", session->getRollbacks(),
+           session->getRollbacks() > 0 ? (double)session->getResimulated() / session->getRollbacks() : 0.0,
+           session->getMaxRollback(), ticks > 0 ? (double)session->getResimulated() / ticks : 0.0);
+    printf("Per frame:      %.1f%% rolled back, %.1f us resimulating on average, %.1f us worst\n",
+           frames > 0 ? 100.0 * framesRolledBack / frames : 0.0, frames > 0 ? session->getResimSeconds() * 1e6 / frames : 0.0, worstResim * 1e6);
+    printf("Depth:         ");
+    for (int d = 1; d <= ROLLBACK_WINDOW; d++)
+    {
+        if (depthCount[d] > 0)
+            printf(" %d:%d", d, depthCount[d]);
+    }
+    printf("\n");
+    printf("Checksum:       %08x at tick %lld%s\n", sim.checksum(), ticks, settled ? "" : ", NOT SETTLED");
+
+    return settled ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,179 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <SFML/System.hpp>
+#include <SFML/Network.hpp>
+
+#include "../NetPlay.h"
+
+/**
+\file NetRelay.cpp
+\brief Stand in for the internet between two players on one machine.
+
+A UDP relay that sits in front of a host.  The player that joins the relay instead of
+the host has every packet in both directions held back by a fixed latency plus a
+random jitter, which also reorders them, and dropped at random, so network play can be
+tried at any connection quality without a second machine.
+
+Usage:
+
+    net_relay [-p port] [-c address:port] [-l ms] [-j ms] [-d percent] [-s seed]
+
+The relay listens on port (NET_PORT + 1 by default) and forwards to the host at
+address:port (127.0.0.1 and NET_PORT by default).  Latency and jitter are each way.
+Totals are printed every five seconds.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+/**
+\brief A packet waiting to go out.
+
+*/
+
+struct RelayPacket
+{
+    int sendAt;                        ///< Time to send it, ms.
+    sf::IpAddress to;                  ///< Where it goes.
+    unsigned short toPort;             ///< Port it goes to.
+    std::vector<unsigned char> data;   ///< The packet.
+};
+
+/**
+\brief Relay entry point.
+
+*/
+
+int main(int argc, char** argv)
+{
+    unsigned short port = NET_PORT + 1;
+    std::string hostName = "127.0.0.1";
+    unsigned short hostPort = NET_PORT;
+    int latency = 50;
+    int jitter = 10;
+    int loss = 2;
+    unsigned int seed = 1;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+            port = (unsigned short)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-c") == 0 && i + 1 < argc)
+        {
+            hostName = argv[++i];
+            size_t colon = hostName.find(':');
+            if (colon != std::string::npos)
+            {
+                hostPort = (unsigned short)atoi(hostName.c_str() + colon + 1);
+                hostName = hostName.substr(0, colon);
+            }
+        }
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+            latency = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+            jitter = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            loss = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)atoi(argv[++i]);
+        else
+        {
+            fprintf(stderr, "Usage: %s [-p port] [-c address:port] [-l ms] [-j ms] [-d percent] [-s seed]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    sf::IpAddress host(hostName);
+    if (host == sf::IpAddress::None)
+    {
+        fprintf(stderr, "Could not resolve %s\n", hostName.c_str());
+        return EXIT_FAILURE;
+    }
+
+    sf::UdpSocket socket;
+    socket.setBlocking(false);
+    if (socket.bind(port) != sf::Socket::Done)
+    {
+        fprintf(stderr, "Could not open UDP port %d\n", port);
+        return EXIT_FAILURE;
+    }
+
+    printf("Relaying port %d to %s:%d, %d ms latency, %d ms jitter, %d%% loss\n", port, hostName.c_str(), hostPort, latency, jitter, loss);
+
+    sf::IpAddress client = sf::IpAddress::None;
+    unsigned short clientPort = 0;
+    std::vector<RelayPacket> queue;
+    long long forwarded = 0;
+    long long dropped = 0;
+
+    sf::Clock clock;
+    int lastReport = 0;
+    unsigned char data[NET_MAX_PACKET];
+
+    while (true)
+    {
+        int now = clock.getElapsedTime().asMilliseconds();
+
+        size_t size;
+        sf::IpAddress from;
+        unsigned short fromPort;
+        while (socket.receive(data, sizeof(data), size, from, fromPort) == sf::Socket::Done)
+        {
+            // Anything not from the host is the client, the latest one to send wins.
+            bool fromHost = from == host && fromPort == hostPort;
+            if (!fromHost)
+            {
+                client = from;
+                clientPort = fromPort;
+            }
+            else if (clientPort == 0)
+                continue;
+
+            seed = seed * 1664525u + 1013904223u;
+            if ((int)((seed >> 16) % 100) < loss)
+            {
+                dropped++;
+                continue;
+            }
+
+            seed = seed * 1664525u + 1013904223u;
+            RelayPacket p;
+            p.sendAt = now + latency + (jitter > 0 ? (seed >> 16) % (jitter + 1) : 0);
+            p.to = fromHost ? client : host;
+            p.toPort = fromHost ? clientPort : hostPort;
+            p.data.assign(data, data + size);
+            queue.push_back(p);
+        }
+
+        size_t kept = 0;
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            if (queue[i].sendAt <= now)
+            {
+                socket.send(&queue[i].data[0], queue[i].data.size(), queue[i].to, queue[i].toPort);
+                forwarded++;
+                continue;
+            }
+            queue[kept++] = queue[i];
+        }
+        queue.resize(kept);
+
+        if (now - lastReport >= 5000)
+        {
+            printf("%6d s: %lld packets forwarded, %lld dropped, %lu in flight\n", now / 1000, forwarded, dropped, (unsigned long)queue.size());
+            fflush(stdout);
+            lastReport = now;
+        }
+
+        sf::sleep(sf::milliseconds(1));
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,253 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <chrono>
+#include <string>
+
+#include "../FighterCore.h"
+#include "../MatchSim.h"
+#include "../InputLog.h"
+#include "../ProgramDefines.h"
+
+/**
+\file ReplayMatch.cpp
+\brief Headless input log replay.
+
+Plays an input log recorded by the game (F9) through MatchSim as fast as it will go,
+with no window, OpenGL context or audio device, and checks that it ends on the same
+state checksum as the recording.  The exit status is non zero on a mismatch, so a set
+of logs doubles as a regression test for the game logic, and the ticks per second make
+it a repeatable performance workload.
+
+Usage:
+
+    replay_match log [-l loops] [-fighters list]
+    replay_match -g log [-s seed] [-t seconds] [-fighters list]
+
+-g writes a log of a scripted match instead, from the menu into a fight, for when no
+recording from the game is at hand.  -fighters is the fighter list to load, the game's
+by default when run from the compile directory.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+static const char* defaultFighterList = "../OpenHouseV2/" FIGHTER_LIST;   ///< The game's fighters, from the compile directory.
+
+/**
+\brief Applies the inputs of a log for one tick.
+
+\param log --- The log.
+\param sim --- Simulation to apply them to.
+
+*/
+
+static void applyLogInputs(InputReplay& log, MatchSim& sim)
+{
+    SimInput in;
+    while (log.next(sim.tickCount, in))
+        sim.applyInput(in);
+}
+
+/**
+\brief Replays a log from the starting state.
+
+Inputs stamped with the last tick were applied after the last tick ran but before the
+recording stopped, so they are applied too before the checksum is taken.
+
+\param log --- The log.
+\param sim --- Simulation, reset first.
+
+\return The checksum at the end of the log.
+
+*/
+
+static unsigned int replay(InputReplay& log, MatchSim& sim)
+{
+    sim.reset();
+    log.rewind();
+
+    while (!log.isDone(sim.tickCount))
+    {
+        applyLogInputs(log, sim);
+        sim.tick();
+    }
+    applyLogInputs(log, sim);
+
+    return sim.checksum();
+}
+
+/**
+\brief Queues an input through the recorder and the simulation, as the game does.
+
+*/
+
+static void send(InputRecorder& rec, MatchSim& sim, int type, int player, int a = 0, int b = 0)
+{
+    SimInput in;
+    in.type = type;
+    in.player = player;
+    in.a = a;
+    in.b = b;
+
+    rec.record(sim.tickCount, in);
+    sim.applyInput(in);
+}
+
+/**
+\brief Records a scripted match, menu to the Roman bath house and a random fight.
+
+\param fileName --- Log to write.
+\param table --- Fighter definitions.
+\param seed --- Seed of the script.
+\param seconds --- Length of the fight.
+
+\return EXIT_SUCCESS or EXIT_FAILURE.
+
+*/
+
+static int generate(const std::string& fileName, const FighterTable& table, unsigned int seed, double seconds)
+{
+    FighterCore f[2];
+    MatchSim sim(&f[0], &f[1], &table);
+    InputRecorder rec;
+    rec.begin(SimTickRate);
+
+    // Main menu, versus, arena zero, start.
+    for (int i = 0; i < 4; i++)
+    {
+        for (int t = 0; t < 30; t++)
+            sim.tick();
+        send(rec, sim, SIM_MENU_SELECT, 0);
+    }
+
+    int moving[2] = {0, 0};
+    long long endTick = sim.tickCount + (long long)(seconds * SimTickRate);
+    while (sim.tickCount < endTick)
+    {
+        for (int p = 0; p < 2; p++)
+        {
+            seed = seed * 1664525u + 1013904223u;
+            unsigned int r = (seed >> 16) % 1000;
+            float dist = fabs(f[0].fighterX[0] - f[1].fighterX[1]);
+
+            // Held direction changes like a key press and release would.
+            int want = (r < 900) ? 1 : (r < 960 ? 2 : 0);
+            if (want != moving[p] && r % 8 == 0)
+            {
+                moving[p] = want;
+                send(rec, sim, SIM_MOVE, p, want == 1, want == 2);
+            }
+
+            if (dist < 20)
+            {
+                if (r < 40)
+                    send(rec, sim, SIM_PUNCH, p);
+                else if (r < 65)
+                    send(rec, sim, SIM_KICK, p);
+                else if (r < 75)
+                    send(rec, sim, SIM_TORNADO, p);
+                else if (r < 80)
+                    send(rec, sim, SIM_JUMP, p);
+            }
+        }
+
+        // Restart whenever someone is knocked out so the whole run is fighting.
+        if (f[1].fighterHP[0] <= 0 || f[0].fighterHP[1] <= 0)
+            send(rec, sim, SIM_RESTART, 0);
+
+        sim.tick();
+    }
+
+    rec.end(sim.tickCount, sim.checksum());
+    if (!rec.save(fileName))
+        return EXIT_FAILURE;
+
+    printf("Wrote %s, %lld ticks, %lu bytes\n", fileName.c_str(), sim.tickCount, (unsigned long)rec.getSize());
+    return EXIT_SUCCESS;
+}
+
+/**
+\brief Replay entry point.
+
+*/
+
+int main(int argc, char** argv)
+{
+    std::string fileName;
+    std::string fighterList = defaultFighterList;
+    bool gen = false;
+    int loops = 1;
+    unsigned int seed = 1;
+    double seconds = 300;
+    bool bad = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-g") == 0)
+            gen = true;
+        else if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+            loops = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "-fighters") == 0 && i + 1 < argc)
+            fighterList = argv[++i];
+        else if (argv[i][0] != '-' && fileName.empty())
+            fileName = argv[i];
+        else
+            bad = true;
+    }
+
+    if (bad || fileName.empty())
+    {
+        fprintf(stderr, "Usage: %s log [-l loops] [-fighters list]\n       %s -g log [-s seed] [-t seconds] [-fighters list]\n", argv[0], argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    FighterTable table;
+    if (!table.load(fighterList))
+        return EXIT_FAILURE;
+
+    if (gen)
+        return generate(fileName, table, seed, seconds);
+
+    InputReplay log;
+    if (!log.load(fileName))
+        return EXIT_FAILURE;
+
+    if (log.getTickRate() != SimTickRate)
+        fprintf(stderr, "Warning: recorded at %d ticks per second, running at %d.\n", log.getTickRate(), SimTickRate);
+
+    FighterCore f[2];
+    MatchSim sim(&f[0], &f[1], &table);
+
+    bool match = true;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for (int l = 0; l < loops; l++)
+    {
+        unsigned int sum = replay(log, sim);
+        if (sum != log.getChecksum())
+        {
+            fprintf(stderr, "Loop %d: checksum %08x, recorded %08x\n", l, sum, log.getChecksum());
+            match = false;
+        }
+    }
+
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    long long ticks = log.getEndTick() * loops;
+
+    printf("Log:          %s\n", fileName.c_str());
+    printf("Ticks:        %lld x %d (%.1f s of play)\n", log.getEndTick(), loops, (double)log.getEndTick() / SimTickRate);
+    printf("Time:         %.3f s\n", sec);
+    printf("Ticks/sec:    %.0f\n", sec > 0 ? ticks / sec : 0.0);
+    printf("Checksum:     %08x %s\n", log.getChecksum(), match ? "match" : "MISMATCH");
+
+    return match ? EXIT_SUCCESS : EXIT_FAILURE;
+}
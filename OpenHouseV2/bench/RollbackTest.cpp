@@ -0,0 +1,341 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "../FighterCore.h"
+#include "../MatchSim.h"
+#include "../Rollback.h"
+#include "../ProgramDefines.h"
+
+/**
+\file RollbackTest.cpp
+\brief Local rollback test over a loopback link with simulated latency.
+
+Runs both sides of a two player match in one process, each with its own MatchSim and
+RollbackSession, passing each tick's input to the other side over a loopback link
+that holds it back a set number of ticks plus random jitter.  Both sides are driven by
+scripted players.  At the end both sides and a reference run that applies every input
+on time must be in the same state.  Reports the snapshot size and save/restore time,
+the rollbacks and the cost per tick.
+
+Usage:
+
+    rollback_test [-l latency] [-j jitter] [-d delay] [-p prediction] [-t seconds] [-s seed] [-f frames]
+                  [-fighters list]
+
+latency, jitter and the input delay are in ticks.  -p limits how far a side predicts
+ahead of the remote input, -p 0 is delay based lockstep with no rollback.  -f also
+rolls back and simulates again that many ticks after every tick on both sides,
+checking the state comes out the same, which forces the worst case cost.  -fighters is
+the fighter list to load, the game's by default when run from the compile directory.
+
+The exit status is non zero if the sides desync.
+
+\author    Brian Bowers
+\version   1.0
+\date      10/19/2026
+
+*/
+
+static const char* defaultFighterList = "../OpenHouseV2/" FIGHTER_LIST;   ///< The game's fighters, from the compile directory.
+
+/**
+\brief One tick of input in flight.
+
+*/
+
+struct LoopbackPacket
+{
+    long long deliverAt;   ///< Frame the packet arrives on.
+    long long tick;        ///< Tick the input is for.
+    TickInput input;       ///< The input.
+};
+
+/**
+\brief One way link that delivers packets after a delay, possibly out of order.
+
+*/
+
+struct LoopbackLink
+{
+    std::vector<LoopbackPacket> queue;   ///< Packets in flight.
+    int latency;                         ///< Fixed delay, in frames.
+    int jitter;                          ///< Largest random extra delay, in frames.
+    unsigned int seed;                   ///< State of the jitter sequence.
+
+    /**
+    \brief Sends a packet.
+    */
+    void send(long long now, long long tick, const TickInput& in)
+    {
+        seed = seed * 1664525u + 1013904223u;
+
+        LoopbackPacket p;
+        p.deliverAt = now + latency + (jitter > 0 ? (seed >> 16) % (jitter + 1) : 0);
+        p.tick = tick;
+        p.input = in;
+        queue.push_back(p);
+    }
+
+    /**
+    \brief Hands every packet that has arrived by now to a session.
+    */
+    void deliver(long long now, RollbackSession& session)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            if (queue[i].deliverAt <= now && session.addRemoteInput(queue[i].tick, queue[i].input))
+                continue;
+            queue[kept++] = queue[i];
+        }
+        queue.resize(kept);
+    }
+};
+
+/**
+\brief One side of the match.
+
+*/
+
+struct Peer
+{
+    FighterCore f[2];                ///< Fighters.
+    MatchSim sim;                    ///< Game logic.
+    RollbackSession session;         ///< Rollback over sim.
+    int player;                      ///< Player this side controls.
+    unsigned int seed;               ///< State of the script.
+    int moving;                      ///< Direction held, 0 none, 1 forward, 2 back.
+    std::vector<TickInput> sent;     ///< Local input of every tick, for the reference run.
+
+    Peer(int p, unsigned int s, const FighterTable* table) : sim(&f[0], &f[1], table), session(&sim, p)
+    {
+        player = p;
+        seed = s;
+        moving = 0;
+    }
+
+    /**
+    \brief Gives this tick's scripted input, from the predicted state.
+    */
+    void play()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        unsigned int r = (seed >> 16) % 1000;
+        float dist = fabs(f[0].fighterX[0] - f[1].fighterX[1]);
+
+        SimInput in;
+        in.player = player;
+        in.a = 0;
+        in.b = 0;
+
+        int want = (r < 900) ? 1 : (r < 960 ? 2 : 0);
+        if (want != moving && r % 8 == 0)
+        {
+            moving = want;
+            in.type = SIM_MOVE;
+            in.a = want == 1;
+            in.b = want == 2;
+            session.addLocalInput(in);
+            in.a = 0;
+            in.b = 0;
+        }
+
+        if (dist < 20 && r < 80)
+        {
+            in.type = r < 40 ? SIM_PUNCH : (r < 65 ? SIM_KICK : (r < 75 ? SIM_TORNADO : SIM_JUMP));
+            session.addLocalInput(in);
+        }
+
+        // Either side restarting after a knock out, the other side sees it late.
+        if (player == 0 && (f[1].fighterHP[0] <= 0 || f[0].fighterHP[1] <= 0) && r < 100)
+        {
+            in.type = SIM_RESTART;
+            session.addLocalInput(in);
+        }
+    }
+};
+
+/**
+\brief Takes a simulation from the main menu into a fight in the Roman bath house.
+
+*/
+
+static void enterFight(MatchSim& sim)
+{
+    sim.reset();
+    for (int i = 0; i < 4; i++)
+    {
+        for (int t = 0; t < 30; t++)
+            sim.tick();
+
+        SimInput in = {SIM_MENU_SELECT, 0, 0, 0};
+        sim.applyInput(in);
+    }
+}
+
+/**
+\brief Test entry point.
+
+*/
+
+int main(int argc, char** argv)
+{
+    int latency = 4;
+    int jitter = 2;
+    double seconds = 120;
+    unsigned int seed = 1;
+    int syncFrames = 0;
+    int delay = 0;
+    int prediction = ROLLBACK_WINDOW;
+    std::string fighterList = defaultFighterList;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "-l") == 0 && i + 1 < argc)
+            latency = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-j") == 0 && i + 1 < argc)
+            jitter = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-t") == 0 && i + 1 < argc)
+            seconds = atof(argv[++i]);
+        else if (strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            seed = (unsigned int)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc)
+            syncFrames = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            delay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+            prediction = atoi(argv[++i]);
+        else if (strcmp(argv[i], "-fighters") == 0 && i + 1 < argc)
+            fighterList = argv[++i];
+        else
+        {
+            fprintf(stderr, "Usage: %s [-l latency] [-j jitter] [-d delay] [-p prediction] [-t seconds] [-s seed] [-f frames] [-fighters list]\n", argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    FighterTable table;
+    if (!table.load(fighterList))
+        return EXIT_FAILURE;
+
+    // Cost of one snapshot.
+    Peer* peers[2] = {new Peer(0, seed * 2 + 1, &table), new Peer(1, seed * 2 + 2, &table)};
+    enterFight(peers[0]->sim);
+
+    MatchSnapshot snap;
+    const int copies = 1000000;
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int i = 0; i < copies; i++)
+    {
+        peers[0]->sim.save(snap);
+        peers[0]->sim.restore(snap);
+    }
+    double copySec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // The match.
+    long long startTick = 0;
+    for (int p = 0; p < 2; p++)
+    {
+        enterFight(peers[p]->sim);
+        peers[p]->session.setInputDelay(delay);
+        peers[p]->session.setMaxPrediction(prediction);
+        peers[p]->session.start();
+        startTick = peers[p]->sim.tickCount;
+    }
+
+    LoopbackLink links[2];   // links[p] carries player p's input to the other side
+    for (int p = 0; p < 2; p++)
+    {
+        links[p].latency = latency;
+        links[p].jitter = jitter;
+        links[p].seed = seed + 100 + p;
+    }
+
+    long long endTick = startTick + (long long)(seconds * SimTickRate);
+    long long frame = 0;
+    bool synced = true;
+
+    start = std::chrono::steady_clock::now();
+    while (peers[0]->session.getTick() < endTick || peers[1]->session.getTick() < endTick)
+    {
+        for (int p = 0; p < 2; p++)
+        {
+            Peer& peer = *peers[p];
+            links[1 - p].deliver(frame, peer.session);
+
+            if (peer.session.getTick() >= endTick)
+                continue;
+
+            if (peer.session.canAdvance())
+                peer.play();
+
+            long long tick = peer.session.getTick();
+            TickInput in;
+            if (peer.session.advance(tick, in))
+            {
+                links[p].send(frame, tick, in);
+                peer.sent.push_back(in);
+            }
+
+            if (syncFrames > 0 && !peer.session.syncTest(syncFrames))
+            {
+                fprintf(stderr, "Player %d: state changed when simulated again at tick %lld\n", p + 1, tick);
+                synced = false;
+            }
+        }
+        frame++;
+    }
+
+    // Everything still in flight arrives, then both sides settle.
+    for (int p = 0; p < 2; p++)
+    {
+        links[1 - p].deliver(frame + latency + jitter + 1, peers[p]->session);
+        peers[p]->session.catchUp();
+    }
+    double runSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // Reference, every input on time.  The first delay ticks have no input.
+    delay = peers[0]->session.getInputDelay();
+    FighterCore rf[2];
+    MatchSim ref(&rf[0], &rf[1], &table);
+    enterFight(ref);
+    for (long long t = 0; t < endTick - startTick; t++)
+    {
+        for (int p = 0; p < 2 && t >= delay; p++)
+        {
+            const TickInput& in = peers[p]->sent[t - delay];
+            for (int i = 0; i < in.count; i++)
+                ref.applyInput(in.events[i]);
+        }
+        ref.tick();
+    }
+
+    unsigned int sums[3] = {peers[0]->sim.checksum(), peers[1]->sim.checksum(), ref.checksum()};
+    if (sums[0] != sums[2] || sums[1] != sums[2])
+        synced = false;
+
+    long long ticks = endTick - startTick;
+    printf("Snapshot:       %lu bytes, save + restore %.1f ns\n", (unsigned long)sizeof(MatchSnapshot), copySec * 1e9 / copies);
+    printf("Link:           %d ticks latency, %d ticks jitter, %d ticks input delay\n", latency, jitter, delay);
+    printf("Ticks:          %lld per side (%.1f s of play), %lld frames\n", ticks, (double)ticks / SimTickRate, frame);
+    for (int p = 0; p < 2; p++)
+    {
+        RollbackSession& s = peers[p]->session;
+        printf("Player %d:       %lld rollbacks, %.2f ticks deep on average, %d deepest, %.2f resimulated per tick, %lld stalls\n",
+               p + 1, s.getRollbacks(), s.getRollbacks() > 0 ? (double)s.getResimulated() / s.getRollbacks() : 0.0,
+               s.getMaxRollback(), (double)s.getResimulated() / ticks, s.getStalls());
+    }
+    printf("Time:           %.3f s, %.2f us per tick per side, %.3f s of it rolling back\n", runSec, runSec * 1e6 / (2.0 * ticks),
+           peers[0]->session.getResimSeconds() + peers[1]->session.getResimSeconds());
+    printf("Checksums:      %08x %08x reference %08x %s\n", sums[0], sums[1], sums[2], synced ? "in sync" : "DESYNC");
+
+    delete peers[0];
+    delete peers[1];
+    return synced ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -11,8 +11,15 @@
 #include <SFML/Audio.hpp>
 #include <iostream>
 #include <string>
+#include <string.h>
 
+#include "BenchMode.h"
+#include "DrawOrder.h"
 #include "GraphicsEngine.h"
+#include "LightClusters.h"
+#include "OverdrawView.h"
+#include "ShadowMaps.h"
+#include "ShaderCache.h"
 #include "UI.h"
 
 /**
@@ -29,9 +36,19 @@ Two fighters "duke it out" until only one has HitPoints remaining
 
 - Escape:  Ends the program.
 - M: Toggles between fill mode and line mode to draw the triangles.
-- F10: Saves a screen shot of the graphics window to a png file.
+- F10: Saves a screen shot of the graphics window to a png file, without stalling the frame.
+- F2: Starts or stops recording every frame to MatchN.y4m, Shift+F2 to raw RGB24 MatchN.rgb.
+- F9: Starts a recording of the input from the main menu, or stops and saves it
+- F11: Replays the last recording
 - P: Toggles the Game Pause
 - R: Restarts the Game if it is over
+- F1: Toggles the overdraw heat map, Shift+F1 the depth pre-pass, see \ref draworder
+- F3: Toggles the frame time graph, see Profiler
+- F4: Saves the last four seconds of frames timed by the profiler to TraceN.json, open it
+in chrome://tracing or Perfetto
+- F5: Toggles the crowd watching from the back of the bath house
+- F12: Captures the OpenGL calls of the next frame to GLCaptureN.ohgl, replay and time it
+with bench/gl_replay
 
 Fighter One Keyboard Controls
 
@@ -59,6 +76,102 @@ Fighter Gamepad Controls (Gamepad 0 controls fighter 1, gamepad 1 controls fight
 -Button 6 (aka "Left Select"): Resets Game if Gameover
 -Button 7 (aka "Right Select"): Toggles Game Pause
 
+\subsection netplay Network Play
+
+Two players on two machines, each using the player one controls.  One hosts and the
+other joins, the host is player one:
+
+    myprogram -host [-p port] [-m delay|rollback] [-d ticks]
+    myprogram -join address[:port]
+
+The host picks the mode for both.  Delay mode holds every input back the given number
+of ticks (3 by default) and waits for the other player's input before each tick.
+Rollback mode (the default, 1 tick of delay) runs on without waiting and corrects
+itself when the other player's input arrives.  The title bar shows the ping and the
+deepest rollback and time spent re-simulating in the last second.  The port defaults
+to 45000.  Use bench/NetRelay.cpp (make net_relay) between the two to try a bad
+connection on one machine.
+
+\subsection benchmode Benchmark Mode
+
+Plays a scripted match in each arena with no window and writes the frame times to a
+JSON file, for machines with no display:
+
+    myprogram --bench [--frames N] [--warmup N] [--out file] [--size WxH]
+                      [--fighters id id] [--seed n] [--arenas list] [--lights N]
+
+The context is made through EGL, on Mesa's surfaceless platform when it is there, so
+llvmpipe draws it with no GPU or X server (Linux only).  Each arena (--arenas 013 by
+default, 3 is the menu) is drawn for a warm up and then N frames (600 by default) at
+1280x720, the game logic ticking once a frame so every run draws the same frames.
+bench.json gets the frame time percentiles, the GPU time, the draw calls, state
+changes, uniform calls and bytes uploaded a frame, the overdraw, and the memory used.
+--lights scatters N extra point lights over the arenas, lit through the light clusters.
+
+\subsection shadercache Shader Cache
+
+The first run saves the binary of each shader program in ShaderCache/, and later runs
+on the same driver load those instead of compiling the GLSL again.  Changing a shader
+or the driver makes a new binary.  The time spent building the programs is printed at
+start up and written to bench.json.  To time or play without the cache:
+
+    myprogram --no-shader-cache [--bench ...]
+
+The shader files are checked once a second while the game runs, and the programs built
+from a changed file, or a file it includes, are built again with their uniforms as they
+were.  A shader with an error is printed with its file and line and the old program is
+kept.  Shader files may share code with #include "file.glsl" (PhongStructs.glsl holds
+the Light and Material structs), and ObjVertexShader.glsl and ObjFragmentShader.glsl
+are built once for each set of defines they are used with, SKINNED for the animated
+fighters and TEX_A, TEX_D and TEX_S for the Wavefront model textures.  The Phong
+shaders are also built for the number and kinds of the lights (LIGHTS and LIGHT_TYPES,
+see Light::shaderDefines), and switched when a light becomes a spot or directional
+light or the number of lights changes.
+
+\subsection lightclusters Light Clusters
+
+Besides the scene's three lights, the Phong shaders are lit by any number of point and
+spot lights, the car headlights of the alley way for instance, assigned each frame to
+a grid of clusters over the view (see LightClusters).  Each pixel pays only for the
+lights of its cluster.  To build the shaders without them:
+
+    myprogram --no-light-clusters [--bench ...]
+
+\subsection shadows Shadows
+
+The directional and spot lights, the headlights of the alley way's cars for now, cast
+shadows from shadow maps packed into one depth atlas (see ShadowMaps).  The walls and
+the fence are only drawn into a map again when its light moves, the cars and the skinned
+fighters every frame.  Each map is 1024 texels across unless its light asks for its own
+size; --shadow-size sets the default, smaller is faster and blockier.  To build the
+shaders without them:
+
+    myprogram [--shadow-size N] [--no-shadows] [--bench ...]
+
+\subsection draworder Draw Order
+
+The opaque objects of each arena are drawn nearest first (see DrawOrder), so the depth
+test throws away the pixels of what they hide before those are shaded, and the bath
+house's sky is drawn last, only where nothing else was.  With the depth pre-pass on
+the objects are first drawn into the depth buffer alone and then shaded only where
+they are the nearest, which costs their vertices twice and saves shading the hidden
+pixels.  The title bar shows the overdraw, the times the average pixel was shaded, and
+F1 shows it as a heat map, black for none and blue, green, yellow and red up to white
+for eight times or more (see OverdrawView).  To measure them:
+
+    myprogram [--depth-prepass] [--no-sort] [--overdraw] [--bench ...]
+
+\subsection fighters Fighters
+
+Each fighter is a text file in Fighters/, listed in Fighters/fighters.txt in ID order:
+its mesh and how it is drawn, which mesh clip plays for each move, its spacing, hitboxes,
+damage and frame data.  See FighterTable for the settings.  A fighter added to the end
+of the list shows up on the menu without building the game again.  The files are
+checked once a second while the game runs and reloaded if they changed, except during
+a network match, a recording or a replay.  A file with a mistake is reported with its
+line and the fighters stay as they were.  Both players of a network match need the
+same files.
+
 \note Note that if only one "Gamepad" is connected, it controls fighter one
 You need Two connected to fight as fighter two on gamepad. I only had
 one gamepad with me while making the game so we will test during Presentation if two
@@ -106,6 +219,9 @@ the user interface processor.
 /**
 \brief The Main function, program entry point.
 
+\param argc --- Number of command line arguments.
+\param argv --- Command line arguments, see \ref netplay and \ref benchmode.
+
 \return Standard EXIT_SUCCESS return on successful run.
 
 The main function, responsible for initializing OpenGL and setting up
@@ -113,7 +229,7 @@ the SFML interface for OpenGL.
 
 */
 
-int main()
+int main(int argc, char** argv)
 {
     //  Program setup variables.
     std::string programTitle = "OpenHouse:482 Final Project";
@@ -123,12 +239,79 @@ int main()
     GLint WindowHeight = 1000;
     bool DisplayInfo = true;
 
+    //  Network play from the command line.
+    NetConfig netConfig;
+    netConfig.host = false;
+    netConfig.port = NET_PORT;
+    netConfig.mode = NET_ROLLBACK;
+    netConfig.inputDelay = -1;
+    bool netPlay = false;
+
+    //  Offscreen benchmark from the command line.
+    BenchOptions benchOptions;
+    defaultBenchOptions(benchOptions);
+    bool bench = false;
+
+    for (int i = 1; i < argc; i++)
+    {
+        if (strcmp(argv[i], "--bench") == 0)
+            bench = true;
+        else if (parseBenchOption(benchOptions, argc, argv, i))
+            continue;
+        else if (strcmp(argv[i], "-host") == 0)
+        {
+            netConfig.host = true;
+            netPlay = true;
+        }
+        else if (strcmp(argv[i], "-join") == 0 && i + 1 < argc)
+        {
+            netConfig.address = argv[++i];
+            size_t colon = netConfig.address.find(':');
+            if (colon != std::string::npos)
+            {
+                netConfig.port = (unsigned short)atoi(netConfig.address.c_str() + colon + 1);
+                netConfig.address = netConfig.address.substr(0, colon);
+            }
+            netPlay = true;
+        }
+        else if (strcmp(argv[i], "-p") == 0 && i + 1 < argc)
+            netConfig.port = (unsigned short)atoi(argv[++i]);
+        else if (strcmp(argv[i], "-m") == 0 && i + 1 < argc)
+            netConfig.mode = strcmp(argv[++i], "delay") == 0 ? NET_DELAY : NET_ROLLBACK;
+        else if (strcmp(argv[i], "-d") == 0 && i + 1 < argc)
+            netConfig.inputDelay = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--no-shader-cache") == 0)
+            ShaderCache::setEnabled(false);
+        else if (strcmp(argv[i], "--no-light-clusters") == 0)
+            LightClusters::setEnabled(false);
+        else if (strcmp(argv[i], "--no-shadows") == 0)
+            ShadowMaps::setEnabled(false);
+        else if (strcmp(argv[i], "--shadow-size") == 0 && i + 1 < argc)
+            ShadowMaps::setDefaultSize(atoi(argv[++i]));
+        else if (strcmp(argv[i], "--depth-prepass") == 0)
+            DrawOrder::setDepthPrepass(true);
+        else if (strcmp(argv[i], "--no-sort") == 0)
+            DrawOrder::setSorted(false);
+        else if (strcmp(argv[i], "--overdraw") == 0)
+            OverdrawView::setVisible(true);
+        else
+            std::cerr << "Unknown option " << argv[i] << " ignored." << std::endl;
+    }
+
+    if (netConfig.inputDelay < 0)
+        netConfig.inputDelay = netConfig.mode == NET_DELAY ? 3 : 1;
+
+    if (bench)
+        return runBench(benchOptions);
+
     //  Other variables
     GLint major;
     GLint minor;
     sf::Clock clock;
     sf::Time time = clock.restart();
     long framecount = 0;
+    int worstRollback = 0;
+    float worstResim = 0;
 
     // Try core context of 10.10 (too advanced) and see what card will resort to.
     // For setting up OpenGL, GLEW, and check versions.
@@ -181,7 +364,10 @@ int main()
     window.close();
 
     //  Create graphics engine.
-    GraphicsEngine ge(programTitle, major, minor, WindowWidth, WindowHeight);
+    GraphicsEngine ge(programTitle, major, minor, WindowWidth, WindowHeight, netPlay ? &netConfig : NULL);
+    const ShaderCacheStats& shaders = ShaderCache::getStats();
+    printf("Shaders: %d programs in %.1f ms, %d from memory, %d from disk, %d compiled\n",
+           shaders.programs, shaders.ms, shaders.memoryHits, shaders.diskHits, shaders.compiled);
     UI ui(&ge);
 /*
     sf::Music music;
@@ -200,15 +386,28 @@ int main()
     // Start the Game/GUI loop
     while (ge.isOpen())
     {
+        Profiler::get().beginFrame();
+
         // Call the display function to do the OpenGL rendering.
         ge.display();
 
         // Process any events.
         ui.processEvents();
 
+        Profiler::get().endFrame();
+
         //  Increment frame counts
         framecount++;
 
+        //  Worst rollback of the second, network play only.
+        if (ge.isNetPlay())
+        {
+            if (ge.getRollbackDepth() > worstRollback)
+                worstRollback = ge.getRollbackDepth();
+            if (ge.getResimTime() > worstResim)
+                worstResim = ge.getResimTime();
+        }
+
         //  Get Elapsed Time
         float timesec = clock.getElapsedTime().asSeconds();
         char titlebar[1000];
@@ -217,8 +416,17 @@ int main()
         if (timesec > 1.0)
         {
             float fps = framecount / timesec;
-            sprintf(titlebar, "%s     FPS: %.2f", programTitle.c_str(), fps);
+            sprintf(titlebar, "%s     FPS: %.2f     Scale: %.3f     GPU: %.2f ms     Drawn: %d  Culled: %d", programTitle.c_str(), fps,
+                    ge.getRenderScale(), ge.getGPUFrameTime(), ge.getDrawnCount(), ge.getCulledCount());
+            sprintf(titlebar + strlen(titlebar), "     Frame p50/p95/p99: %.1f/%.1f/%.1f ms", Profiler::get().frameTimePercentile(50),
+                    Profiler::get().frameTimePercentile(95), Profiler::get().frameTimePercentile(99));
+            if (ge.getOverdraw() >= 0)
+                sprintf(titlebar + strlen(titlebar), "     Overdraw: %.2f%s", ge.getOverdraw(), DrawOrder::isDepthPrepass() ? " (pre-pass)" : "");
+            if (ge.isNetPlay())
+                sprintf(titlebar + strlen(titlebar), "     Ping: %.0f ms  Rollback: %d ticks %.2f ms", ge.getPing(), worstRollback, worstResim);
             ge.setTitle(titlebar);
+            worstRollback = 0;
+            worstResim = 0;
             time = clock.restart();
             framecount = 0;
         }
@@ -134,7 +134,9 @@ bool SkinnedMesh::InitFromScene(const aiScene* pScene, const string& Filename)
 
     ReserveSpace(NumVertices, NumIndices);
 
+    m_Bounds.reset();
     InitAllMeshes(pScene);
+    m_Bounds.finish(1.5f);
 
     if (!InitMaterials(pScene, Filename)) {
         return false;
@@ -208,6 +210,7 @@ void SkinnedMesh::InitSingleMesh(uint MeshIndex, const aiMesh* paiMesh)
 
         const aiVector3D& pPos      = paiMesh->mVertices[i];
         m_Positions.push_back(Vector3f(pPos.x, pPos.y, pPos.z));
+        m_Bounds.add(pPos.x, pPos.y, pPos.z);
 
         if (paiMesh->mNormals) {
             const aiVector3D& pNormal   = paiMesh->mNormals[i];
@@ -515,6 +518,25 @@ void SkinnedMesh::Render()
     //glBindVertexArray(0);
 }
 
+/**
+\brief RenderDepth
+
+Draws the meshes with the program in use and no textures, for the shadow map pass
+
+*/
+void SkinnedMesh::RenderDepth()
+{
+    glBindVertexArray(m_VAO);
+
+    for (unsigned int i = 0 ; i < m_Meshes.size() ; i++) {
+        glDrawElementsBaseVertex(GL_TRIANGLES,
+                                 m_Meshes[i].NumIndices,
+                                 GL_UNSIGNED_INT,
+                                 (void*)(sizeof(unsigned int) * m_Meshes[i].BaseIndex),
+                                 m_Meshes[i].BaseVertex);
+    }
+}
+
 /**
 \brief GetMaterial
 
@@ -776,3 +798,9 @@ int SkinnedMesh::getAnimationIndex()
 {
     return animationIndex;
 }
+
+//Bounds of the bind pose, padded in InitFromScene to cover the animations
+const BoundingVolume& SkinnedMesh::getBounds()
+{
+    return m_Bounds;
+}
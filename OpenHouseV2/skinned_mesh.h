@@ -14,6 +14,7 @@
 #include "ogldev_world_transform.h"
 #include "ogldev_material.h"
 #include "Material.h"
+#include "ViewFrustum.h"
 
 /**
 \file skinned_mesh.h
@@ -61,6 +62,8 @@ public:
 
     void Render();
 
+    void RenderDepth();
+
     uint NumBones() const
     {
         return (uint)m_BoneNameToIndexMap.size();
@@ -80,6 +83,9 @@ public:
     //Returns the index value of the current animation so that it can be compared against other values, might end up not needing this but gonna implement just in case
     int getAnimationIndex();
 
+    //Bind pose bounds, padded since animations move the limbs outside of it
+    const BoundingVolume& getBounds();
+
 private:
     #define MAX_NUM_BONES_PER_VERTEX 4
 
@@ -197,6 +203,8 @@ private:
 
     map<string,uint> m_BoneNameToIndexMap;
 
+    BoundingVolume m_Bounds;
+
     //Last update from previous version that dude made (might mess around with making them all glm::mat4's)
     //Future note, was able to get them to play nice with glm::mat4's so no problem
     struct BoneInfo
@@ -68,18 +68,22 @@ bool SkinningTechnique::Init()
     }
 */
 //*
-    if (!AddShader(GL_VERTEX_SHADER, "ObjVertexShader.glsl")) {
-        return false;
-    }
-
-    if (!AddShader(GL_FRAGMENT_SHADER, "ObjFragmentShader.glsl")) {
+    if (!BuildPermutation("ObjVertexShader.glsl", "ObjFragmentShader.glsl", "SKINNED")) {
         return false;
     }
 //*/
-    if (!Finalize()) {
-        return false;
-    }
+    FindUniforms();
+
+    return true;
+}
+
+/**
+\brief Looks up the uniform locations, again after the shaders are reloaded.
+
+*/
 
+void SkinningTechnique::FindUniforms()
+{
     //WVPLoc = GetUniformLocation("gWVP");
     WVPLoc = GetUniformLocation("PVM");
     //materialLoc = GetUniformLocation("Mat");
@@ -201,8 +205,6 @@ bool SkinningTechnique::Init()
         SNPRINTF(Name, sizeof(Name), "gBones[%d]", i);
         m_boneLocation[i] = GetUniformLocation(Name);
     }
-
-    return true;
 }
 
 //void SkinningTechnique::SetWVP(const Matrix4f& WVP){
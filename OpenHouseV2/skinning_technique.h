@@ -114,6 +114,8 @@ public:
 
     virtual bool Init();
 
+    void FindUniforms();
+
     //void SetWVP(const Matrix4f& WVP);
     void SetWVP(glm::mat4& WVP);//Now takes in what I have been using for greater compatibility, once loaded with openGL no conflicts between the matrix forms pop up
     void SetTextureUnit(unsigned int TextureUnit);
@@ -30,16 +30,9 @@ Technique::Technique()
 
 Technique::~Technique()
 {
-    // Delete the intermediate shader objects that have been added to the program
-    // The list will only contain something if shaders were compiled but the object itself
-    // was destroyed prior to linking.
-    for (ShaderObjList::iterator it = m_shaderObjList.begin() ; it != m_shaderObjList.end() ; it++)
-    {
-        glDeleteShader(*it);
-    }
-
     if (m_shaderProg != 0)
     {
+        ShaderLibrary::release(m_shaderProg);
         glDeleteProgram(m_shaderProg);
         m_shaderProg = 0;
     }
@@ -67,71 +60,62 @@ bool Technique::AddShader(GLenum ShaderType, const char* pFilename)
         return false;
     }
 
-    GLuint ShaderObj = glCreateShader(ShaderType);
-
-    if (ShaderObj == 0) {
-        fprintf(stderr, "Error creating shader type %d\n", ShaderType);
-        return false;
-    }
+    // Save the code - the program is built from it by Finalize()
+    ShaderSource Source = { ShaderType, pFilename, s };
+    m_sources.push_back(Source);
 
-    // Save the shader object - will be deleted in the destructor
-    m_shaderObjList.push_back(ShaderObj);
+    return true;
+}
 
-    const GLchar* p[1];
-    p[0] = s.c_str();
-    GLint Lengths[1] = { (GLint)s.size() };
 
-    glShaderSource(ShaderObj, 1, p, Lengths);
+// After all the shaders have been added to the program call this function
+// to build and validate the program.
+bool Technique::Finalize()
+{
+    GLint Success = 0;
+    GLchar ErrorLog[1024] = { 0 };
 
-    glCompileShader(ShaderObj);
+    // Compile and link, or load the binary an earlier run saved
+    bool Built = ShaderCache::build(m_shaderProg, m_sources);
 
-    GLint success;
-    glGetShaderiv(ShaderObj, GL_COMPILE_STATUS, &success);
+    m_sources.clear();
 
-    if (!success) {
-        GLchar InfoLog[1024];
-        glGetShaderInfoLog(ShaderObj, 1024, NULL, InfoLog);
-        fprintf(stderr, "Error compiling '%s': '%s'\n", pFilename, InfoLog);
+    if (!Built) {
+        fprintf(stderr, "Error building shader program\n");
         return false;
     }
 
-    glAttachShader(m_shaderProg, ShaderObj);
+    glValidateProgram(m_shaderProg);
+    glGetProgramiv(m_shaderProg, GL_VALIDATE_STATUS, &Success);
+    if (!Success) {
+        glGetProgramInfoLog(m_shaderProg, sizeof(ErrorLog), NULL, ErrorLog);
+        fprintf(stderr, "Invalid shader program: '%s'\n", ErrorLog);
+     //   return false;
+    }
 
-    return true;
+    return GLCheckError();
 }
 
 
-// After all the shaders have been added to the program call this function
-// to link and validate the program.
-bool Technique::Finalize()
+// Use this method instead of AddShader/Finalize to build the program from a shader
+// library permutation, which is built again when its files change
+bool Technique::BuildPermutation(const char* pVSFilename, const char* pFSFilename, const char* pDefines)
 {
     GLint Success = 0;
     GLchar ErrorLog[1024] = { 0 };
 
-    glLinkProgram(m_shaderProg);
-
-    glGetProgramiv(m_shaderProg, GL_LINK_STATUS, &Success);
-        if (Success == 0) {
-                glGetProgramInfoLog(m_shaderProg, sizeof(ErrorLog), NULL, ErrorLog);
-                fprintf(stderr, "Error linking shader program: '%s'\n", ErrorLog);
+    if (!ShaderLibrary::build(m_shaderProg, pVSFilename, pFSFilename, pDefines)) {
+        fprintf(stderr, "Error building shader program\n");
         return false;
-        }
+    }
 
     glValidateProgram(m_shaderProg);
     glGetProgramiv(m_shaderProg, GL_VALIDATE_STATUS, &Success);
     if (!Success) {
         glGetProgramInfoLog(m_shaderProg, sizeof(ErrorLog), NULL, ErrorLog);
         fprintf(stderr, "Invalid shader program: '%s'\n", ErrorLog);
-     //   return false;
     }
 
-    // Delete the intermediate shader objects that have been added to the program
-    for (ShaderObjList::iterator it = m_shaderObjList.begin() ; it != m_shaderObjList.end() ; it++) {
-        glDeleteShader(*it);
-    }
-
-    m_shaderObjList.clear();
-
     return GLCheckError();
 }
 
@@ -19,9 +19,11 @@
 #ifndef TECHNIQUE_H
 #define TECHNIQUE_H
 
-#include <list>
+#include <vector>
 #include <GL/glew.h>
 
+#include "ShaderLibrary.h"
+
 class Technique
 {
 public:
@@ -42,14 +44,16 @@ protected:
 
     bool Finalize();
 
+    bool BuildPermutation(const char* pVSFilename, const char* pFSFilename, const char* pDefines);
+
     GLint GetUniformLocation(const char* pUniformName);
 
     GLuint m_shaderProg = 0;
 
 private:
 
-    typedef std::list<GLuint> ShaderObjList;
-    ShaderObjList m_shaderObjList;
+    // Stages added since Init, built into the program by Finalize
+    std::vector<ShaderSource> m_sources;
 };
 
 #endif  /* TECHNIQUE_H */